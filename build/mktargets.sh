@@ -6,6 +6,7 @@ python build/mktargets.py --directory codec/common --library common --exclude as
 python build/mktargets.py --directory codec/processing --library processing
 
 python build/mktargets.py --directory codec/console/dec --binary h264dec
+python build/mktargets.py --directory codec/console/decbench --binary decbench
 python build/mktargets.py --directory codec/console/enc --binary h264enc
 python build/mktargets.py --directory codec/console/common --library console_common
 python build/mktargets.py --directory test/encoder --prefix encoder_unittest
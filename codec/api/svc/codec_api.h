@@ -334,6 +334,26 @@ class ISVCEncoder {
   * @return  CM_RETURN: 0 - success; otherwise - failed;
   */
   virtual int EXTAPI GetOption (ENCODER_OPTION eOptionId, void* pOption) = 0;
+
+  /**
+  * @brief   Pipelined encoding: the source picture is copied, denoised and downsampled on a thread of the pool
+  *          while the frame given to the previous call is coded, so the output lags the input by one frame.
+  *          The call returns once that previous frame is coded, kpSrcPic is not used any more then.
+  *          The frame is coded with the settings in effect when the next call is made. Setting
+  *          ENCODER_OPTION_SVC_ENCODE_PARAM_BASE/EXT, ENCODER_OPTION_LTR or ENCODER_OPTION_SPS_PPS_ID_STRATEGY,
+  *          or calling EncodeFrame() fails with cmInitExpected until the pending frame is flushed.
+  * @param   kpSrcPic the source picture, NULL flushes the pending frame
+  * @return  0 - success; otherwise - failed;
+  */
+  virtual int EXTAPI EncodeFrameAsync (const SSourcePicture* kpSrcPic) = 0;
+
+  /**
+  * @brief   Get the output of the frame coded by the last EncodeFrameAsync() call, never blocks
+  * @param   pBsInfo output bit stream, valid until the next encoding call; eFrameType is videoFrameTypeInvalid
+  *          when no frame was coded (first call, flush without pending frame) or the output was already fetched
+  * @return  0 - success; otherwise - failed;
+  */
+  virtual int EXTAPI GetEncodedFrame (SFrameBSInfo* pBsInfo) = 0;
   virtual ~ISVCEncoder() {}
 };
 
@@ -477,6 +497,9 @@ int (*ForceIntraFrame) (ISVCEncoder*, bool bIDR);
 
 int (*SetOption) (ISVCEncoder*, ENCODER_OPTION eOptionId, void* pOption);
 int (*GetOption) (ISVCEncoder*, ENCODER_OPTION eOptionId, void* pOption);
+
+int (*EncodeFrameAsync) (ISVCEncoder*, const SSourcePicture* kpSrcPic);
+int (*GetEncodedFrame) (ISVCEncoder*, SFrameBSInfo* pBsInfo);
 };
 
 typedef struct ISVCDecoderVtbl ISVCDecoderVtbl;
@@ -543,6 +566,41 @@ void WelsDestroySVCEncoder (ISVCEncoder* pEncoder);
 int WelsGetDecoderCapability (SDecoderCapability* pDecCapability);
 
 
+/** @brief   Index the access units of an Annex B bitstream, e.g. a memory mapped file, for seeking.
+ *           Only NAL unit headers, parameter sets and the first syntax elements of the slice headers are read,
+ *           the slice data is not parsed and no decoder is needed.
+ *  @param   pSrc  the bitstream
+ *  @param   iSrcLen  size of the bitstream in bytes
+ *  @param   pIndex  the first iMaxEntries access units are written to, in bitstream order; NULL to count them only
+ *  @param   iMaxEntries  entries of pIndex
+ *  @return  count of access units in the bitstream, which may be larger than iMaxEntries; negative if a parameter is invalid
+*/
+int WelsIndexAccessUnits (const unsigned char* pSrc, long long iSrcLen, SAccessUnitIndex* pIndex, int iMaxEntries);
+
+
+/** @brief   Create a picture pool, to be set to decoders with DECODER_OPTION_PICTURE_POOL
+ *  @param   pParam  largest resolution and number of the buffers allocated up front
+ *  @param   ppPool  pool
+ *  @return  0 - success; otherwise - failed;
+*/
+int WelsCreatePicturePool (const SPicturePoolParam* pParam, SPicturePool** ppPool);
+
+
+/** @brief   Drop the reference of the creator of a picture pool. The memory is freed once no decoder uses it
+ *  @param   pPool  pool
+ *  @return  void
+*/
+void WelsDestroyPicturePool (SPicturePool* pPool);
+
+
+/** @brief   Get the statistics of a picture pool, which may be used by decoders on other threads
+ *  @param   pPool  pool
+ *  @param   pStats  statistics
+ *  @return  0 - success; otherwise - failed;
+*/
+int WelsGetPicturePoolStatistics (SPicturePool* pPool, SPicturePoolStatistics* pStats);
+
+
 /** @brief   Create decoder
  *  @param   ppDecoder decoder
  *  @return  0 - success; otherwise - failed;
@@ -556,6 +614,30 @@ long WelsCreateDecoder (ISVCDecoder** ppDecoder);
 */
 void WelsDestroyDecoder (ISVCDecoder* pDecoder);
 
+
+/** @brief   An access unit to decode with WelsDecodeBatch()
+*/
+typedef struct TagDecodeBatchItem {
+  ISVCDecoder* pDecoder;        ///< decoder of the access unit, a decoder may be given several of them
+  const unsigned char* pSrc;    ///< access unit, NULL to flush the decoder
+  int iSrcLen;                  ///< size of the access unit in bytes
+  unsigned char* pDst[3];       ///< output picture as of DecodeFrameNoDelay(), valid until the decoder decodes again
+  SBufferInfo sDstInfo;         ///< uiInBsTimeStamp of the access unit in, output information out
+  DECODING_STATE eState;        ///< return value of DecodeFrameNoDelay()
+} SDecodeBatchItem;
+
+
+/** @brief   Decode many access units, typically of many decoders, in one call. Each of them is decoded as with
+ *           DecodeFrameNoDelay(); the ones of the same decoder in the order of pItems, the ones of different decoders
+ *           on up to iThreadNum threads, the calling thread included. Decoders with frame or slice threading are
+ *           decoded on the calling thread. A decoder must not be used elsewhere during the call.
+ *  @param   pItems  access units in, results out
+ *  @param   iItemNum  entries of pItems
+ *  @param   iThreadNum  threads decoding in parallel, 1 or less to decode on the calling thread only
+ *  @return  0 - success, see SDecodeBatchItem::eState for the result of each access unit; otherwise - failed;
+*/
+int WelsDecodeBatch (SDecodeBatchItem* pItems, int iItemNum, int iThreadNum);
+
 /** @brief   Get codec version
  *           Note, old versions of Mingw (GCC < 4.7) are buggy and use an
  *           incorrect/different ABI for calling this function, making it
@@ -166,9 +166,31 @@ typedef enum {
   DECODER_OPTION_LEVEL,                 ///< get current AU level info,only is used in GetOption
   DECODER_OPTION_STATISTICS_LOG_INTERVAL,///< set log output interval
   DECODER_OPTION_IS_REF_PIC,             ///< feedback current frame is ref pic or not
+  DECODER_OPTION_NUM_OF_THREADS,         ///< number of decoding threads, frame threading when > 1 (output then delayed by up to this number of frames)
+  DECODER_OPTION_NUM_OF_FRAMES_REMAINING_IN_BUFFER, ///< number of decoded frames not output yet, only is used in GetOption
+  DECODER_OPTION_SLICE_THREADING,        ///< when set, the decoding threads share the slices of a picture instead of frames, output is not delayed
+  DECODER_OPTION_FRAME_ALLOCATOR,        ///< SFrameAllocator* receiving the pictures, NULL callbacks to decode into internal memory again
+  DECODER_OPTION_HOLD_OUTPUT,            ///< when set, output pictures stay valid until released with DECODER_OPTION_RELEASE_OUTPUT, not with a frame allocator
+  DECODER_OPTION_RELEASE_OUTPUT,         ///< void* handle (SBufferInfo::pFrameBuffer) of a held output picture to release, only is used in SetOption
+  DECODER_OPTION_CPU_FLAGS,              ///< unsigned int mask of the cpu features (WELS_CPU_* in cpu_core.h) the optimized functions may use, all detected ones by default, set before decoding
+  DECODER_OPTION_STAGE_TIMING,           ///< when set, the cost of each decoding stage is accumulated into SDecoderStageStatistics, setting it resets them
+  DECODER_OPTION_GET_STAGE_STATISTICS,   ///< feedback SDecoderStageStatistics, cycles and nanoseconds of each decoding stage, only is used in GetOption
+  DECODER_OPTION_SKIP_FRAMES,            ///< DECODER_SKIP_MODE, the pictures left out are neither reconstructed nor output
+  DECODER_OPTION_PICTURE_POOL,           ///< SPicturePool* the pictures are carved from, NULL for memory of the decoder; unused with a frame allocator or held output
+  DECODER_OPTION_SCHEDULING,             ///< SDecoderScheduling, decode on the workers shared by the decoders of the process; setting it waits for the access units queued
+  DECODER_OPTION_GET_SCHEDULING_STATISTICS, ///< feedback SDecoderSchedulingStatistics, only is used in GetOption
 
 } DECODER_OPTION;
 
+/**
+* @brief Enumerate the pictures skipped with DECODER_OPTION_SKIP_FRAMES
+*/
+typedef enum {
+  DECODER_SKIP_NONE = 0,                ///< decode all the pictures
+  DECODER_SKIP_NON_REF,                 ///< skip the pictures no other one refers to (nal_ref_idc equal to 0)
+  DECODER_SKIP_NON_IDR                  ///< decode the IDR pictures only
+} DECODER_SKIP_MODE;
+
 /**
 * @brief Enumerate the type of error concealment methods
 */
@@ -180,7 +202,8 @@ typedef enum {
   ERROR_CON_SLICE_COPY_CROSS_IDR,
   ERROR_CON_SLICE_COPY_CROSS_IDR_FREEZE_RES_CHANGE,
   ERROR_CON_SLICE_MV_COPY_CROSS_IDR,
-  ERROR_CON_SLICE_MV_COPY_CROSS_IDR_FREEZE_RES_CHANGE
+  ERROR_CON_SLICE_MV_COPY_CROSS_IDR_FREEZE_RES_CHANGE,
+  ERROR_CON_FRAME_COPY_CROSS_IDR_ALIAS  ///< as ERROR_CON_FRAME_COPY_CROSS_IDR, the concealed frame shares the planes of the previous one instead of copying them
 } ERROR_CON_IDC;
 /**
 * @brief Feedback that whether or not have VCL NAL in current AU
@@ -582,6 +605,13 @@ typedef struct TagEncParamExt {
   bool    bEnableSceneChangeDetect;
 
   bool    bIsLosslessLink;            ///<  LTR advanced setting
+
+  /* wavefront coding: with one slice per layer, the iMultipleThreadIdc threads decide the modes of the MB rows of the
+   * slice while the entropy coding stays in raster order, so the output is the same as with one thread. Only used with
+   * RC_OFF_MODE and RC_BUFFERBASED_MODE, the other rate control modes code the rows one after the other */
+  bool    bUseWavefront;              ///< wavefront mode decision of the MB rows of a slice
+
+  int     iHierarchicalMeLevels;      ///< coarse ME levels: 0: off, 1: 1/2 resolution, 2: 1/2 and 1/4 resolution
 } SEncParamExt;
 
 /**
@@ -605,8 +635,55 @@ typedef struct TagSVCDecodingParam {
   bool bParseOnly;                     ///< decoder for parse only, no reconstruction. When it is true, SPS/PPS size should not exceed SPS_PPS_BS_SIZE (128). Otherwise, it will return error info
 
   SVideoProperty   sVideoProperty;    ///< video stream property
+
+  /**
+  * Low cost preview, for callers that trade exactness for speed. The loop filter is skipped and chroma
+  * motion is rounded to whole pels, so the output drifts from the exact decoding until the next IDR
+  * picture: do not use it when the pictures must be exact. References are padded only as far as the
+  * motion vectors read outside them, which does not change the output.
+  */
+  bool bFastPreview;
 } SDecodingParam, *PDecodingParam;
 
+/**
+* @brief Caller-supplied picture memory of the decoder, set with DECODER_OPTION_FRAME_ALLOCATOR
+*
+* Every picture the decoder reconstructs is then held in a buffer obtained from pfGetBuffer, and the
+* output reports it in SBufferInfo::pFrameBuffer. The decoder gives its reference on a buffer back with
+* pfReleaseBuffer before it decodes a new picture into that picture memory, or when the memory is freed.
+* Output pictures thus stay valid as long as the application keeps its own reference on their buffer.
+* The callbacks are called on the thread calling the decoder.
+*/
+typedef struct TagFrameAllocator {
+  void* pUserContext;                                             ///< passed to the callbacks
+  void* (*pfGetBuffer) (void* pUserContext, int iSize);           ///< return a buffer of iSize bytes at least, NULL on failure, the decoder initializes it
+  void (*pfReleaseBuffer) (void* pUserContext, void* pBuffer);    ///< drop the reference taken by pfGetBuffer
+} SFrameAllocator;
+
+/**
+* @brief Picture memory shared by the decoders of a process, see WelsCreatePicturePool() and DECODER_OPTION_PICTURE_POOL
+*
+* The pool keeps buffers sized for a picture of iMaxWidth x iMaxHeight. A decoder using it carves its pictures
+* out of these buffers and gives them back to the pool when the resolution or the number of reference pictures
+* changes, so that a resolution switch takes buffers from the pool instead of freeing and allocating all pictures.
+*/
+typedef struct TagPicturePool SPicturePool;
+
+typedef struct TagPicturePoolParam {
+  int iMaxWidth;                ///< largest picture width in pixels the buffers are sized for
+  int iMaxHeight;               ///< largest picture height in pixels the buffers are sized for
+  int iNumPictures;             ///< buffers allocated when the pool is created
+} SPicturePoolParam;
+
+typedef struct TagPicturePoolStatistics {
+  unsigned int uiHits;          ///< pictures carved out of a free buffer of the pool
+  unsigned int uiMisses;        ///< pictures which needed a new buffer: no free one, or larger than iMaxWidth x iMaxHeight
+  int iNumBuffers;              ///< buffers kept by the pool, in use or free
+  int iNumFreeBuffers;          ///< buffers kept by the pool and not in use
+  int iPeakBuffersInUse;        ///< largest number of buffers in use at the same time
+  unsigned long long uiMemoryBytes; ///< memory of the buffers kept by the pool
+} SPicturePoolStatistics;
+
 /**
 * @brief Bitstream inforamtion of a layer being encoded
 */
@@ -708,6 +785,20 @@ typedef struct TagDecoderCapability {
   bool bRedPicCap;     ///< redundant-pic-cap
 } SDecoderCapability;
 
+/**
+* @brief Access unit of the index WelsIndexAccessUnits() makes, a plain struct which can be stored as it is
+*/
+typedef struct TagAccessUnitIndex {
+  long long     iOffset;       ///< byte offset of the access unit in the bitstream, its parameter sets and start codes included
+  int           iSize;         ///< bytes of the access unit, up to the next one
+  int           iFrameNum;     ///< frame_num of the picture, -1 if its parameter sets were not found before it
+  int           iPoc;          ///< picture order count of the picture, 0 at IDR pictures
+  unsigned char uiSpsId;       ///< seq_parameter_set_id of the picture
+  unsigned char uiPpsId;       ///< pic_parameter_set_id of the picture
+  bool          bIdr;          ///< IDR picture, decoding can start at this access unit
+  bool          bRef;          ///< reference picture, nal_ref_idc is not 0
+} SAccessUnitIndex;
+
 /**
 * @brief Structure for parse only output
 */
@@ -787,8 +878,72 @@ typedef struct TagVideoDecoderStatistics {
   int iCurrentActivePpsId;                     ///< current active PPS id
 
   unsigned int iStatisticsLogInterval;                  ///< frame interval of statistics log
+
+  unsigned long long uiEcAliasedBytes;         ///< with ERROR_CON_FRAME_COPY_CROSS_IDR_ALIAS, bytes of planes shared instead of copied by frame copy
+  unsigned long long uiEcMaterializedBytes;    ///< bytes copied afterwards because shared planes were about to be overwritten
+  unsigned int uiSkippedFrameNum;              ///< number of pictures left out because of DECODER_OPTION_SKIP_FRAMES
 } SDecoderStatistics; // in building, coming soon
 
+/**
+* @brief Enumerate the decoding stages of SDecoderStageStatistics
+*/
+typedef enum {
+  DECODER_STAGE_NAL_UNESCAPE = 0,       ///< start code search and emulation prevention byte removal
+  DECODER_STAGE_HEADER_PARSE,           ///< NAL unit, parameter set and slice header parsing
+  DECODER_STAGE_MB_PARSE,               ///< slice data parsing
+  DECODER_STAGE_RECONSTRUCTION,         ///< MB reconstruction (prediction and residual)
+  DECODER_STAGE_DEBLOCKING,             ///< deblocking filter
+  DECODER_STAGE_EXPANSION,              ///< padding of the reference pictures
+  DECODER_STAGE_ERROR_CONCEALMENT,      ///< concealment of the pictures with lost or broken slices
+  DECODER_STAGE_NUM
+} DECODER_STAGE;
+
+/**
+* @brief  Structure for the cost of the decoding stages, see DECODER_OPTION_STAGE_TIMING and DECODER_OPTION_GET_STAGE_STATISTICS
+*         nanoseconds are derived from the time stamp counter on x86, cycles are only counted there;
+*         the work done by decoding threads is not included
+*/
+typedef struct TagDecoderStageCost {
+  unsigned long long uiCycles;                 ///< cpu cycles spent in the stage, 0 when not available
+  unsigned long long uiNanoseconds;            ///< time spent in the stage
+  unsigned long long uiCount;                  ///< number of times the stage was run
+} SDecoderStageCost;
+
+typedef struct TagDecoderStageStatistics {
+  SDecoderStageCost sStage[DECODER_STAGE_NUM]; ///< indexed by DECODER_STAGE
+  unsigned long long uiParsedMbCount;          ///< number of MBs parsed
+  unsigned long long uiElapsedNanoseconds;     ///< wall clock time since the stage timing was enabled
+} SDecoderStageStatistics;
+
+/**
+* @brief Decoding on the workers shared by the decoders of a process, see DECODER_OPTION_SCHEDULING
+*
+* DecodeFrame2(), DecodeFrameNoDelay() and DecodeFrame() of a scheduled decoder only queue a copy of the access
+* unit (or the flush request of a NULL one) and return dsErrorFree with no picture. The access units of a decoder
+* are decoded in order, as by DecodeFrameNoDelay(), one at a time on a worker of the process wide thread pool,
+* and pfDecoded is called on that worker with the result of each of them. The workers go to the decoder which
+* used the least decoding time relative to its iWeight, so a decoder needing long for each access unit gets
+* fewer turns than the ones decoding small pictures. Any other call to the decoder first waits for the access
+* units queued, pfDecoded may only queue more of them. Frame and slice threading cannot be used together with it.
+*/
+typedef void (*PDecodedCallback) (void* pUserContext, unsigned char** ppDst, SBufferInfo* pDstInfo,
+                                  DECODING_STATE eState);
+
+typedef struct TagDecoderScheduling {
+  PDecodedCallback pfDecoded;                  ///< receives the output of the access units, NULL to decode on the calling thread again
+  void* pUserContext;                          ///< passed to pfDecoded
+  int iWeight;                                 ///< share of the workers relative to the other decoders, 1 when not positive
+} SDecoderScheduling;
+
+typedef struct TagDecoderSchedulingStatistics {
+  unsigned int uiDecodedNum;                   ///< access units decoded on the workers
+  unsigned int uiQueuedNum;                    ///< access units queued and not decoded yet
+  unsigned long long uiTotalWaitUs;            ///< time in microseconds the access units waited for a worker
+  unsigned long long uiMaxWaitUs;              ///< longest wait for a worker
+  unsigned long long uiTotalDecodeUs;          ///< time in microseconds spent decoding them, pfDecoded included
+  unsigned long long uiMaxDecodeUs;            ///< longest time spent decoding one of them
+} SDecoderSchedulingStatistics;
+
 /**
 * @brief Structure for sample aspect ratio (SAR) info in VUI
 */
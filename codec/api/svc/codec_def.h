@@ -201,6 +201,8 @@ typedef struct TagBufferInfo {
   union {
     SSysMEMBuffer sSystemBuffer; ///<  memory info for one picture
   } UsrData;                     ///<  output buffer info
+  void* pFrameBuffer;            ///< buffer from SFrameAllocator::pfGetBuffer holding the output picture, or handle of the picture held
+                                 ///< with DECODER_OPTION_HOLD_OUTPUT, NULL otherwise (picture valid until the next decoding call)
 } SBufferInfo;
 
 
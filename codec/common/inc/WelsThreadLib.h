@@ -56,6 +56,7 @@ typedef    LPTHREAD_START_ROUTINE    LPWELS_THREAD_ROUTINE;
 
 typedef    CRITICAL_SECTION          WELS_MUTEX;
 typedef    HANDLE                    WELS_EVENT;
+typedef    CONDITION_VARIABLE        WELS_COND;
 
 #define    WELS_THREAD_ROUTINE_TYPE         DWORD  WINAPI
 #define    WELS_THREAD_ROUTINE_RETURN(rc)   return (DWORD)rc;
@@ -79,6 +80,7 @@ typedef   pthread_t    WELS_THREAD_HANDLE;
 typedef  void* (*LPWELS_THREAD_ROUTINE) (void*);
 
 typedef   pthread_mutex_t           WELS_MUTEX;
+typedef   pthread_cond_t            WELS_COND;
 
 #ifdef __APPLE__
 typedef   pthread_cond_t            WELS_EVENT;
@@ -109,6 +111,14 @@ WELS_THREAD_ERROR_CODE    WelsMutexLock (WELS_MUTEX*    mutex);
 WELS_THREAD_ERROR_CODE    WelsMutexUnlock (WELS_MUTEX* mutex);
 WELS_THREAD_ERROR_CODE    WelsMutexDestroy (WELS_MUTEX* mutex);
 
+/*
+ * condition variable, always used together with a WELS_MUTEX held by the caller
+ */
+WELS_THREAD_ERROR_CODE    WelsCondInit (WELS_COND* pCond);
+WELS_THREAD_ERROR_CODE    WelsCondDestroy (WELS_COND* pCond);
+WELS_THREAD_ERROR_CODE    WelsCondWait (WELS_COND* pCond, WELS_MUTEX* pMutex);
+WELS_THREAD_ERROR_CODE    WelsCondBroadcast (WELS_COND* pCond);
+
 WELS_THREAD_ERROR_CODE    WelsEventOpen (WELS_EVENT* p_event, const char* event_name = NULL);
 WELS_THREAD_ERROR_CODE    WelsEventClose (WELS_EVENT* event, const char* event_name = NULL);
 
@@ -43,6 +43,12 @@ void DeblockChromaEq4H_ssse3 (uint8_t* pPixCb, uint8_t* pPixCr, int32_t iStride,
 void DeblockChromaLt4H_ssse3 (uint8_t* pPixCb, uint8_t* pPixCr, int32_t iStride, int32_t iAlpha, int32_t iBeta,
                               int8_t* pTC);
 void WelsNonZeroCount_sse2 (int8_t* pNonZeroCount);
+#if defined(HAVE_AVX2)
+void DeblockLumaLt4V_avx2 (uint8_t* pPixY, int32_t iStride, int32_t iAlpha, int32_t iBeta, int8_t* pTc);
+void DeblockLumaEq4V_avx2 (uint8_t* pPixY, int32_t iStride, int32_t iAlpha, int32_t iBeta);
+void DeblockLumaLt4H_avx2 (uint8_t* pPixY, int32_t iStride, int32_t iAlpha, int32_t iBeta, int8_t* pTc);
+void DeblockLumaEq4H_avx2 (uint8_t* pPixY, int32_t iStride, int32_t iAlpha, int32_t iBeta);
+#endif
 #endif
 
 #if defined(HAVE_NEON)
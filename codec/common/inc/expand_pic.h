@@ -61,6 +61,11 @@ void ExpandPictureChromaUnalign_sse2 (uint8_t* pDst,
                                       const int32_t kiStride,
                                       const int32_t kiPicW,
                                       const int32_t kiPicH);
+void ExpandPictureLinesLeftRight_sse2 (uint8_t* pDst,
+                                       const int32_t kiStride,
+                                       const int32_t kiPicW,
+                                       const int32_t kiLines,
+                                       const int32_t kiPaddingLen);
 #endif//X86_ASM
 
 #if defined(HAVE_NEON)
@@ -74,16 +79,31 @@ void ExpandPictureChroma_AArch64_neon (uint8_t* pDst, const int32_t kiStride, co
 #endif
 
 typedef void (*PExpandPictureFunc) (uint8_t* pDst, const int32_t kiStride, const int32_t kiPicW, const int32_t kiPicH);
+// pad the left and right border of kiLines lines by kiPaddingLen, a multiple of 8
+typedef void (*PExpandPictureLinesFunc) (uint8_t* pDst, const int32_t kiStride, const int32_t kiPicW,
+    const int32_t kiLines, const int32_t kiPaddingLen);
 
 typedef struct TagExpandPicFunc {
   PExpandPictureFunc pfExpandLumaPicture;
   PExpandPictureFunc pfExpandChromaPicture[2];
+  PExpandPictureLinesFunc pfExpandPictureLines;
 } SExpandPicFunc;
 
 
 void ExpandReferencingPicture (uint8_t* pData[3], int32_t iWidth, int32_t iHeight, int32_t iStride[3],
                                PExpandPictureFunc pExpLuma, PExpandPictureFunc pExpChrom[2]);
 
+/*!
+ * \brief  pad MB rows [iFirstMbRow, iEndMbRow) of a picture, so that rows can be released to
+ *         motion compensation while the rest of the picture is still being reconstructed.
+ *         Padding the rows in any order until all are covered gives ExpandReferencingPicture's result.
+ *         iPaddingLen is the luma margin, a multiple of 16 up to PADDING_LENGTH, chroma is padded by half of it.
+ *         pExpLines is SExpandPicFunc::pfExpandPictureLines.
+ */
+void ExpandReferencingPictureRows (uint8_t* pData[3], int32_t iWidth, int32_t iHeight, int32_t iStride[3],
+                                   int32_t iFirstMbRow, int32_t iEndMbRow, int32_t iPaddingLen,
+                                   PExpandPictureLinesFunc pExpLines);
+
 void InitExpandPictureFunc (SExpandPicFunc* pExpandPicFunc, const uint32_t kuiCPUFlags);
 
 #if defined(__cplusplus)
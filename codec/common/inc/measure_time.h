@@ -49,6 +49,13 @@
 #include <windows.h>
 #endif
 #include <time.h>
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#define WELS_TICKS_CPU_CYCLES
+#elif defined(__i386__) || defined(__x86_64__)
+#include <x86intrin.h>
+#define WELS_TICKS_CPU_CYCLES
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -81,6 +88,25 @@ static inline int64_t WelsTime (void) {
 #endif//_WIN32
 }
 
+/*!
+ * \brief   fine grained counter for profiling short code sections
+ * \param   void
+ * \return  time stamp counter on x86 (unit: cpu cycle), elapsed time elsewhere (unit: nanosecond)
+ */
+
+static inline int64_t WelsTicks (void) {
+#if defined(WELS_TICKS_CPU_CYCLES)
+  return (int64_t)__rdtsc();
+#elif !defined(_WIN32)
+  struct timespec sTs;
+
+  clock_gettime (CLOCK_MONOTONIC, &sTs);
+  return ((int64_t) sTs.tv_sec * 1000000000 + (int64_t) sTs.tv_nsec);
+#else
+  return WelsTime() * 1000;
+#endif
+}
+
 #ifdef __cplusplus
 }
 #endif
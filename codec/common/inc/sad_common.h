@@ -55,6 +55,15 @@ void WelsSampleSadFour4x4_c (uint8_t* iSample1, int32_t iStride1, uint8_t* iSamp
 void WelsSampleSadFour8x4_c (uint8_t* iSample1, int32_t iStride1, uint8_t* iSample2, int32_t iStride2, int32_t* pSad);
 void WelsSampleSadFour4x8_c (uint8_t* iSample1, int32_t iStride1, uint8_t* iSample2, int32_t iStride2, int32_t* pSad);
 
+/* SAD of the block against four arbitrary reference blocks ppSample2[0..3] */
+void WelsSampleSadFourRef16x16_c (uint8_t* pSample1, int32_t iStride1, uint8_t** ppSample2, int32_t iStride2, int32_t* pSad);
+void WelsSampleSadFourRef16x8_c (uint8_t* pSample1, int32_t iStride1, uint8_t** ppSample2, int32_t iStride2, int32_t* pSad);
+void WelsSampleSadFourRef8x16_c (uint8_t* pSample1, int32_t iStride1, uint8_t** ppSample2, int32_t iStride2, int32_t* pSad);
+void WelsSampleSadFourRef8x8_c (uint8_t* pSample1, int32_t iStride1, uint8_t** ppSample2, int32_t iStride2, int32_t* pSad);
+void WelsSampleSadFourRef4x4_c (uint8_t* pSample1, int32_t iStride1, uint8_t** ppSample2, int32_t iStride2, int32_t* pSad);
+void WelsSampleSadFourRef8x4_c (uint8_t* pSample1, int32_t iStride1, uint8_t** ppSample2, int32_t iStride2, int32_t* pSad);
+void WelsSampleSadFourRef4x8_c (uint8_t* pSample1, int32_t iStride1, uint8_t** ppSample2, int32_t iStride2, int32_t* pSad);
+
 #if defined(__cplusplus)
 extern "C" {
 #endif//__cplusplus
@@ -73,6 +82,19 @@ void WelsSampleSadFour8x16_sse2 (uint8_t*, int32_t, uint8_t*, int32_t, int32_t*)
 void WelsSampleSadFour8x8_sse2 (uint8_t*, int32_t, uint8_t*, int32_t, int32_t*);
 void WelsSampleSadFour4x4_sse2 (uint8_t*, int32_t, uint8_t*, int32_t, int32_t*);
 
+void WelsSampleSadFourRef16x16_sse2 (uint8_t*, int32_t, uint8_t**, int32_t, int32_t*);
+void WelsSampleSadFourRef16x8_sse2 (uint8_t*, int32_t, uint8_t**, int32_t, int32_t*);
+void WelsSampleSadFourRef8x16_sse2 (uint8_t*, int32_t, uint8_t**, int32_t, int32_t*);
+void WelsSampleSadFourRef8x8_sse2 (uint8_t*, int32_t, uint8_t**, int32_t, int32_t*);
+
+#ifdef HAVE_AVX2
+void WelsSampleSadFour16x16_avx2 (uint8_t*, int32_t, uint8_t*, int32_t, int32_t*);
+void WelsSampleSadFour16x8_avx2 (uint8_t*, int32_t, uint8_t*, int32_t, int32_t*);
+
+void WelsSampleSadFourRef16x16_avx2 (uint8_t*, int32_t, uint8_t**, int32_t, int32_t*);
+void WelsSampleSadFourRef16x8_avx2 (uint8_t*, int32_t, uint8_t**, int32_t, int32_t*);
+#endif //HAVE_AVX2
+
 #endif//X86_ASM
 
 #if defined (HAVE_NEON)
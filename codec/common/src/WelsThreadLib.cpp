@@ -111,6 +111,30 @@ WELS_THREAD_ERROR_CODE    WelsMutexDestroy (WELS_MUTEX* mutex) {
   return WELS_THREAD_ERROR_OK;
 }
 
+WELS_THREAD_ERROR_CODE    WelsCondInit (WELS_COND* pCond) {
+  InitializeConditionVariable (pCond);
+
+  return WELS_THREAD_ERROR_OK;
+}
+
+WELS_THREAD_ERROR_CODE    WelsCondDestroy (WELS_COND* pCond) {
+  // nothing to release for a windows condition variable
+  return WELS_THREAD_ERROR_OK;
+}
+
+WELS_THREAD_ERROR_CODE    WelsCondWait (WELS_COND* pCond, WELS_MUTEX* pMutex) {
+  if (SleepConditionVariableCS (pCond, pMutex, INFINITE))
+    return WELS_THREAD_ERROR_OK;
+
+  return WELS_THREAD_ERROR_GENERAL;
+}
+
+WELS_THREAD_ERROR_CODE    WelsCondBroadcast (WELS_COND* pCond) {
+  WakeAllConditionVariable (pCond);
+
+  return WELS_THREAD_ERROR_OK;
+}
+
 #else /* _WIN32 */
 
 WELS_THREAD_ERROR_CODE    WelsMutexInit (WELS_MUTEX*    mutex) {
@@ -129,6 +153,22 @@ WELS_THREAD_ERROR_CODE    WelsMutexDestroy (WELS_MUTEX* mutex) {
   return pthread_mutex_destroy (mutex);
 }
 
+WELS_THREAD_ERROR_CODE    WelsCondInit (WELS_COND* pCond) {
+  return pthread_cond_init (pCond, NULL);
+}
+
+WELS_THREAD_ERROR_CODE    WelsCondDestroy (WELS_COND* pCond) {
+  return pthread_cond_destroy (pCond);
+}
+
+WELS_THREAD_ERROR_CODE    WelsCondWait (WELS_COND* pCond, WELS_MUTEX* pMutex) {
+  return pthread_cond_wait (pCond, pMutex);
+}
+
+WELS_THREAD_ERROR_CODE    WelsCondBroadcast (WELS_COND* pCond) {
+  return pthread_cond_broadcast (pCond);
+}
+
 #endif /* !_WIN32 */
 
 #if defined(_WIN32) || defined(__CYGWIN__)
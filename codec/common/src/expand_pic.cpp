@@ -32,6 +32,7 @@
 #include <string.h>
 #include "expand_pic.h"
 #include "cpu_core.h"
+#include "macros.h"
 
 // rewrite it (split into luma & chroma) that is helpful for mmx/sse2 optimization perform, 9/27/2009
 static inline void ExpandPictureLuma_c (uint8_t* pDst, const int32_t kiStride, const int32_t kiPicW,
@@ -114,16 +115,29 @@ static inline void ExpandPictureChroma_c (uint8_t* pDst, const int32_t kiStride,
   } while (i < kiPicH);
 }
 
+static void ExpandPictureLinesLeftRight_c (uint8_t* pDst, const int32_t kiStride, const int32_t kiPicW,
+    const int32_t kiLines, const int32_t kiPaddingLen) {
+  uint8_t* pTmp = pDst;
+  for (int32_t i = 0; i < kiLines; ++ i) {
+    memset (pTmp - kiPaddingLen, pTmp[0], kiPaddingLen);
+    memset (pTmp + kiPicW, pTmp[kiPicW - 1], kiPaddingLen);
+
+    pTmp += kiStride;
+  }
+}
+
 void InitExpandPictureFunc (SExpandPicFunc* pExpandPicFunc, const uint32_t kuiCPUFlag) {
   pExpandPicFunc->pfExpandLumaPicture        = ExpandPictureLuma_c;
   pExpandPicFunc->pfExpandChromaPicture[0]   = ExpandPictureChroma_c;
   pExpandPicFunc->pfExpandChromaPicture[1]   = ExpandPictureChroma_c;
+  pExpandPicFunc->pfExpandPictureLines       = ExpandPictureLinesLeftRight_c;
 
 #if defined(X86_ASM)
   if ((kuiCPUFlag & WELS_CPU_SSE2) == WELS_CPU_SSE2) {
     pExpandPicFunc->pfExpandLumaPicture      = ExpandPictureLuma_sse2;
     pExpandPicFunc->pfExpandChromaPicture[0] = ExpandPictureChromaUnalign_sse2;
     pExpandPicFunc->pfExpandChromaPicture[1] = ExpandPictureChromaAlign_sse2;
+    pExpandPicFunc->pfExpandPictureLines     = ExpandPictureLinesLeftRight_sse2;
   }
 #endif//X86_ASM
 #if defined(HAVE_NEON)
@@ -172,3 +186,43 @@ void ExpandReferencingPicture (uint8_t* pData[3], int32_t iWidth, int32_t iHeigh
 
 
 }
+
+// pad lines [kiFirstLine, kiEndLine) of one plane, plus the top/bottom border once the first/last line is covered
+static void ExpandPlaneLines (uint8_t* pDst, const int32_t kiStride, const int32_t kiPicW, const int32_t kiPicH,
+                              const int32_t kiFirstLine, const int32_t kiEndLine, const int32_t kiPaddingLen,
+                              PExpandPictureLinesFunc pExpLines) {
+  int32_t i;
+
+  // pad left and right
+  pExpLines (pDst + kiFirstLine * kiStride, kiStride, kiPicW, kiEndLine - kiFirstLine, kiPaddingLen);
+
+  // pad pTop and pBottom with the already padded first/last line, corners included
+  if (kiFirstLine == 0) {
+    for (i = 1; i <= kiPaddingLen; ++ i)
+      memcpy (pDst - i * kiStride - kiPaddingLen, pDst - kiPaddingLen, kiPicW + (kiPaddingLen << 1));
+  }
+  if (kiEndLine == kiPicH) {
+    uint8_t* pDstLastLine = pDst + (kiPicH - 1) * kiStride;
+    for (i = 1; i <= kiPaddingLen; ++ i)
+      memcpy (pDstLastLine + i * kiStride - kiPaddingLen, pDstLastLine - kiPaddingLen, kiPicW + (kiPaddingLen << 1));
+  }
+}
+
+void ExpandReferencingPictureRows (uint8_t* pData[3], int32_t iWidth, int32_t iHeight, int32_t iStride[3],
+                                   int32_t iFirstMbRow, int32_t iEndMbRow, int32_t iPaddingLen,
+                                   PExpandPictureLinesFunc pExpLines) {
+  const int32_t kiHeightUV    = iHeight >> 1;
+  const int32_t kiFirstLineY  = iFirstMbRow << 4;
+  const int32_t kiEndLineY    = WELS_MIN (iEndMbRow << 4, iHeight);
+  const int32_t kiFirstLineUV = iFirstMbRow << 3;
+  const int32_t kiEndLineUV   = WELS_MIN (iEndMbRow << 3, kiHeightUV);
+
+  if (kiFirstLineY >= kiEndLineY)
+    return;
+
+  ExpandPlaneLines (pData[0], iStride[0], iWidth, iHeight, kiFirstLineY, kiEndLineY, iPaddingLen, pExpLines);
+  ExpandPlaneLines (pData[1], iStride[1], iWidth >> 1, kiHeightUV, kiFirstLineUV, kiEndLineUV, iPaddingLen >> 1,
+                    pExpLines);
+  ExpandPlaneLines (pData[2], iStride[2], iWidth >> 1, kiHeightUV, kiFirstLineUV, kiEndLineUV, iPaddingLen >> 1,
+                    pExpLines);
+}
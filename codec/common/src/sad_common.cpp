@@ -163,3 +163,53 @@ void WelsSampleSadFour4x8_c (uint8_t* iSample1, int32_t iStride1, uint8_t* iSamp
   * (pSad + 2) = WelsSampleSad4x8_c (iSample1, iStride1, (iSample2 - 1), iStride2);
   * (pSad + 3) = WelsSampleSad4x8_c (iSample1, iStride1, (iSample2 + 1), iStride2);
 }
+
+void WelsSampleSadFourRef16x16_c (uint8_t* pSample1, int32_t iStride1, uint8_t** ppSample2, int32_t iStride2,
+                                  int32_t* pSad) {
+  * (pSad)     = WelsSampleSad16x16_c (pSample1, iStride1, ppSample2[0], iStride2);
+  * (pSad + 1) = WelsSampleSad16x16_c (pSample1, iStride1, ppSample2[1], iStride2);
+  * (pSad + 2) = WelsSampleSad16x16_c (pSample1, iStride1, ppSample2[2], iStride2);
+  * (pSad + 3) = WelsSampleSad16x16_c (pSample1, iStride1, ppSample2[3], iStride2);
+}
+void WelsSampleSadFourRef16x8_c (uint8_t* pSample1, int32_t iStride1, uint8_t** ppSample2, int32_t iStride2,
+                                 int32_t* pSad) {
+  * (pSad)     = WelsSampleSad16x8_c (pSample1, iStride1, ppSample2[0], iStride2);
+  * (pSad + 1) = WelsSampleSad16x8_c (pSample1, iStride1, ppSample2[1], iStride2);
+  * (pSad + 2) = WelsSampleSad16x8_c (pSample1, iStride1, ppSample2[2], iStride2);
+  * (pSad + 3) = WelsSampleSad16x8_c (pSample1, iStride1, ppSample2[3], iStride2);
+}
+void WelsSampleSadFourRef8x16_c (uint8_t* pSample1, int32_t iStride1, uint8_t** ppSample2, int32_t iStride2,
+                                 int32_t* pSad) {
+  * (pSad)     = WelsSampleSad8x16_c (pSample1, iStride1, ppSample2[0], iStride2);
+  * (pSad + 1) = WelsSampleSad8x16_c (pSample1, iStride1, ppSample2[1], iStride2);
+  * (pSad + 2) = WelsSampleSad8x16_c (pSample1, iStride1, ppSample2[2], iStride2);
+  * (pSad + 3) = WelsSampleSad8x16_c (pSample1, iStride1, ppSample2[3], iStride2);
+}
+void WelsSampleSadFourRef8x8_c (uint8_t* pSample1, int32_t iStride1, uint8_t** ppSample2, int32_t iStride2,
+                                int32_t* pSad) {
+  * (pSad)     = WelsSampleSad8x8_c (pSample1, iStride1, ppSample2[0], iStride2);
+  * (pSad + 1) = WelsSampleSad8x8_c (pSample1, iStride1, ppSample2[1], iStride2);
+  * (pSad + 2) = WelsSampleSad8x8_c (pSample1, iStride1, ppSample2[2], iStride2);
+  * (pSad + 3) = WelsSampleSad8x8_c (pSample1, iStride1, ppSample2[3], iStride2);
+}
+void WelsSampleSadFourRef4x4_c (uint8_t* pSample1, int32_t iStride1, uint8_t** ppSample2, int32_t iStride2,
+                                int32_t* pSad) {
+  * (pSad)     = WelsSampleSad4x4_c (pSample1, iStride1, ppSample2[0], iStride2);
+  * (pSad + 1) = WelsSampleSad4x4_c (pSample1, iStride1, ppSample2[1], iStride2);
+  * (pSad + 2) = WelsSampleSad4x4_c (pSample1, iStride1, ppSample2[2], iStride2);
+  * (pSad + 3) = WelsSampleSad4x4_c (pSample1, iStride1, ppSample2[3], iStride2);
+}
+void WelsSampleSadFourRef8x4_c (uint8_t* pSample1, int32_t iStride1, uint8_t** ppSample2, int32_t iStride2,
+                                int32_t* pSad) {
+  * (pSad)     = WelsSampleSad8x4_c (pSample1, iStride1, ppSample2[0], iStride2);
+  * (pSad + 1) = WelsSampleSad8x4_c (pSample1, iStride1, ppSample2[1], iStride2);
+  * (pSad + 2) = WelsSampleSad8x4_c (pSample1, iStride1, ppSample2[2], iStride2);
+  * (pSad + 3) = WelsSampleSad8x4_c (pSample1, iStride1, ppSample2[3], iStride2);
+}
+void WelsSampleSadFourRef4x8_c (uint8_t* pSample1, int32_t iStride1, uint8_t** ppSample2, int32_t iStride2,
+                                int32_t* pSad) {
+  * (pSad)     = WelsSampleSad4x8_c (pSample1, iStride1, ppSample2[0], iStride2);
+  * (pSad + 1) = WelsSampleSad4x8_c (pSample1, iStride1, ppSample2[1], iStride2);
+  * (pSad + 2) = WelsSampleSad4x8_c (pSample1, iStride1, ppSample2[2], iStride2);
+  * (pSad + 3) = WelsSampleSad4x8_c (pSample1, iStride1, ppSample2[3], iStride2);
+}
@@ -846,3 +846,244 @@ WELS_EXTERN WelsNonZeroCount_sse2
     movdqu  [r0], xmm0
     movq    [r0+16], xmm1
     ret
+
+
+;***********************************************************************
+; AVX2 functions
+;***********************************************************************
+
+%ifdef HAVE_AVX2
+; The p side rows of an edge are kept in the low and the q side rows in the
+; high 128-bit lane of ymm registers, so that the filter arithmetic, which is
+; symmetric in p and q, processes all 32 pixels next to a 16-pixel edge at once.
+
+; Unsigned byte absolute difference.
+; out=%1 a=%2 b=%3 clobber=%4
+%macro AVX2_AbsDiffUB 4
+    vpsubusb %4, %3, %2
+    vpsubusb %1, %2, %3
+    vpor     %1, %1, %4
+%endmacro
+
+; Unsigned byte compare less than, see SSE2_CmpltUB.
+; lhs=%1 rhs^0x7f=%2 0x7f=%3
+%macro AVX2_CmpltUB 3
+    vpxor    %1, %1, %3
+    vpcmpgtb %1, %1, %2
+%endmacro
+
+; max of the two lanes in both lanes.
+; a=%1 clobber=%2
+%macro AVX2_MaxLanesUB 2
+    vpermq   %2, %1, 4eh
+    vpmaxub  %1, %1, %2
+%endmacro
+
+; (a + b + 1 - c) >> 1
+; out=%1 a=%2 b=%3 c=%4 [out:a^b&c]=%5
+%macro AVX2_AvgbFloor1 5
+    vpxor    %5, %2, %3
+    vpavgb   %1, %2, %3
+    vpand    %5, %5, %4
+    vpsubb   %1, %1, %5
+%endmacro
+
+; Same as SSE2_DeblockP0Q0_Lt4 on VEX encoded registers.
+;
+; p1=%1 p0=%2 q0=%3 q1=%4 iTc=%5 FFh=%6 96=%7 clobber=%8,%9
+%macro AVX2_DeblockP0Q0_Lt4 9
+    vpsubusb %8, %2, %3  ; clip(p0 - q0, 0, 255)
+    vpxor    %4, %4, %6  ; q1 ^ 0xff
+    vpavgb   %1, %1, %4  ; (((p1 - q1 + 0x100) >> 1)
+    vpavgb   %1, %1, %6  ;  + 0x100) >> 1
+    vpsubusb %1, %1, %8  ; -= clip(p0 - q0, 0, 255) saturate.
+    vpsubusb %9, %3, %2  ; (clip(q0 - p0, 0, 255)
+    vpavgb   %9, %9, %1  ;  + clip(((p1 - q1 + 0x300) >> 2) - clip(p0 - q0, 0, 255), 0, 255) + 1) >> 1
+    vpsubusb %8, %7, %9
+    vpsubusb %9, %9, %7
+    vpminub  %8, %8, %5
+    vpminub  %9, %9, %5
+    vpsubusb %2, %2, %8
+    vpaddusb %2, %2, %9  ; p0
+    vpaddusb %3, %3, %8
+    vpsubusb %3, %3, %9  ; q0
+%endmacro
+
+; [p%1|q%1] row pair of the edge at pPix - iStride=r3, -iStride=r1, pPix=r0, iStride=r2.
+; out=%1 row=%2
+%macro AVX2_LoadPQRow 2
+    vmovdqu      x%1, [r3 + %2 * r1]
+    vinserti128  y%1, y%1, [r0 + %2 * r2], 1
+%endmacro
+
+; in=%1 row=%2
+%macro AVX2_StorePQRow 2
+    vmovdqu      [r3 + %2 * r1], x%1
+    vextracti128 [r0 + %2 * r2], y%1, 1
+%endmacro
+
+
+;*******************************************************************************
+;    void DeblockLumaLt4V_avx2(uint8_t * pPix, int32_t iStride, int32_t iAlpha,
+;                                 int32_t iBeta, int8_t * pTC)
+;*******************************************************************************
+
+WELS_EXTERN DeblockLumaLt4V_avx2
+%ifdef X86_32
+    ; The p|q lanes need more than 8 registers.
+    jmp      DeblockLumaLt4V_ssse3
+%else
+    %assign push_num 0
+    LOAD_5_PARA
+    PUSH_XMM 16
+    SIGN_EXTENSION r1, r1d
+    vbroadcasti128 ymm15, [WELS_DB127_16]
+    vmovd    xmm13, arg3d
+    vmovd    xmm14, arg4d
+    vpbroadcastb ymm13, xmm13
+    vpbroadcastb ymm14, xmm14
+    vpxor    ymm13, ymm13, ymm15              ; iAlpha ^ 0x7f
+    vpxor    ymm14, ymm14, ymm15              ; iBeta  ^ 0x7f
+    mov      r2, r1                           ; iStride
+    neg      r1                               ; -iStride
+    lea      r3, [r0 + r1]                    ; pPix - iStride
+
+    ; Compute masks to enable/disable deblocking.
+    AVX2_LoadPQRow mm0, 0                     ; [p0|q0]
+    AVX2_LoadPQRow mm1, 1                     ; [p1|q1]
+    AVX2_LoadPQRow mm2, 2                     ; [p2|q2]
+    vpermq   ymm3, ymm0, 4eh                  ; [q0|p0]
+    AVX2_AbsDiffUB ymm4, ymm0, ymm3, ymm12    ; |p0 - q0|
+    AVX2_CmpltUB ymm4, ymm13, ymm15           ; bDeltaP0Q0 = |p0 - q0| < iAlpha
+    AVX2_AbsDiffUB ymm5, ymm1, ymm0, ymm12    ; [|p1 - p0||q1 - q0|]
+    AVX2_MaxLanesUB ymm5, ymm12               ; max(|p1 - p0|, |q1 - q0|)
+    AVX2_CmpltUB ymm5, ymm14, ymm15           ; bDeltaP1P0 & bDeltaQ1Q0 = max(|p1 - p0|, |q1 - q0|) < iBeta
+    vpand    ymm4, ymm4, ymm5                 ; bDeltaP0Q0P1P0Q1Q0 = bDeltaP0Q0 & bDeltaP1P0 & bDeltaQ1Q0
+    AVX2_AbsDiffUB ymm5, ymm2, ymm0, ymm12    ; [|p2 - p0||q2 - q0|]
+    AVX2_CmpltUB ymm5, ymm14, ymm15           ; [bDeltaP2P0|bDeltaQ2Q0] = |p2 - p0| < iBeta, |q2 - q0| < iBeta
+
+    ; [(p2 + ((p0 + q0 + 1) >> 1)) >> 1|(q2 + ((p0 + q0 + 1) >> 1)) >> 1]
+    vpcmpeqw ymm15, ymm15, ymm15              ; FFh
+    vpavgb   ymm6, ymm0, ymm3
+    vpxor    ymm6, ymm6, ymm15
+    vpxor    ymm7, ymm2, ymm15
+    vpavgb   ymm7, ymm7, ymm6
+    vpxor    ymm7, ymm7, ymm15
+
+    vbroadcasti128 ymm8, [WELS_SHUFB0000111122223333]
+    vpbroadcastd ymm9, [r4]
+    vpshufb  ymm9, ymm9, ymm8                 ; iTc0
+    vpcmpgtb ymm8, ymm9, ymm15                ; iTc > -1 ? 0xff : 0x00
+    vpand    ymm4, ymm4, ymm8                 ; bDeltaP0Q0P1P0Q1Q0 &= iTc > -1
+    vpermq   ymm8, ymm5, 4eh                  ; [bDeltaQ2Q0|bDeltaP2P0]
+    vpsubb   ymm10, ymm9, ymm5                ; iTc = iTc0 - (bDeltaP2P0 ? -1 : 0)
+    vpsubb   ymm10, ymm10, ymm8               ;           - (bDeltaQ2Q0 ? -1 : 0)
+    vpand    ymm10, ymm10, ymm4               ; iTc &= bDeltaP0Q0P1P0Q1Q0 ? 0xff : 0
+    vpand    ymm5, ymm5, ymm4                 ; [bDeltaP2P0|bDeltaQ2Q0] &= bDeltaP0Q0P1P0Q1Q0
+    vpand    ymm5, ymm5, ymm9                 ; iTc0 & ([bDeltaP2P0|bDeltaQ2Q0] ? 0xff : 0)
+
+    ; clip p1 and q1.
+    vpsubusb ymm8, ymm1, ymm5
+    vpaddusb ymm5, ymm5, ymm1
+    vpmaxub  ymm7, ymm7, ymm8
+    vpminub  ymm7, ymm7, ymm5
+    AVX2_StorePQRow mm7, 1                    ; store p1 and q1.
+
+    vextracti128 xmm11, ymm1, 1               ; q1
+    vmovdqa  xmm12, [WELS_DB96_16]
+    AVX2_DeblockP0Q0_Lt4 xmm1, xmm0, xmm3, xmm11, xmm10, xmm15, xmm12, xmm5, xmm6
+    vmovdqu  [r3 + 0 * r1], xmm0              ; store p0.
+    vmovdqu  [r0 + 0 * r2], xmm3              ; store q0.
+
+    vzeroupper
+    POP_XMM
+    LOAD_5_PARA_POP
+    ret
+%endif
+
+
+;*******************************************************************************
+;    void DeblockLumaEq4V_avx2(uint8_t * pPix, int32_t iStride, int32_t iAlpha,
+;                                 int32_t iBeta)
+;*******************************************************************************
+
+WELS_EXTERN DeblockLumaEq4V_avx2
+%ifdef X86_32
+    ; The p|q lanes need more than 8 registers.
+    jmp      DeblockLumaEq4V_ssse3
+%else
+    %assign push_num 0
+    LOAD_4_PARA
+    PUSH_XMM 16
+    SIGN_EXTENSION r1, r1d
+    vbroadcasti128 ymm15, [WELS_DB127_16]
+    vmovd    xmm13, arg3d
+    vmovd    xmm14, arg4d
+    shr      r2, 2
+    add      r2, 1
+    vmovd    xmm12, r2d
+    vpbroadcastb ymm13, xmm13
+    vpbroadcastb ymm14, xmm14
+    vpbroadcastb ymm12, xmm12                 ; (iAlpha >> 2) + 1
+    vpxor    ymm13, ymm13, ymm15              ; iAlpha ^ 0x7f
+    vpxor    ymm14, ymm14, ymm15              ; iBeta  ^ 0x7f
+    mov      r2, r1                           ; iStride
+    neg      r1                               ; -iStride
+    lea      r3, [r0 + r1]                    ; pPix - iStride
+
+    ; Compute masks to enable/disable filtering.
+    AVX2_LoadPQRow mm0, 0                     ; [p0|q0]
+    AVX2_LoadPQRow mm1, 1                     ; [p1|q1]
+    AVX2_LoadPQRow mm2, 2                     ; [p2|q2]
+    lea      r4, [r2 + 2 * r2]                ; 3 * iStride
+    vmovdqu  xmm3, [r0 + 4 * r1]
+    vinserti128 ymm3, ymm3, [r0 + r4], 1      ; [p3|q3]
+    vpermq   ymm4, ymm0, 4eh                  ; [q0|p0]
+    vpermq   ymm5, ymm1, 4eh                  ; [q1|p1]
+    AVX2_AbsDiffUB ymm6, ymm0, ymm4, ymm11    ; |p0 - q0|
+    vpminub  ymm12, ymm12, ymm6
+    vpcmpeqb ymm12, ymm12, ymm6               ; |p0 - q0| < (iAlpha >> 2) + 2
+    AVX2_CmpltUB ymm6, ymm13, ymm15           ; bDeltaP0Q0 = |p0 - q0| < iAlpha
+    AVX2_AbsDiffUB ymm7, ymm1, ymm0, ymm11    ; [|p1 - p0||q1 - q0|]
+    AVX2_MaxLanesUB ymm7, ymm11               ; max(|p1 - p0|, |q1 - q0|)
+    AVX2_CmpltUB ymm7, ymm14, ymm15           ; bDeltaP1P0 & bDeltaQ1Q0 = max(|p1 - p0|, |q1 - q0|) < iBeta
+    vpand    ymm6, ymm6, ymm7                 ; & bDeltaP0Q0
+    AVX2_AbsDiffUB ymm7, ymm2, ymm0, ymm11    ; [|p2 - p0||q2 - q0|]
+    AVX2_CmpltUB ymm7, ymm14, ymm15           ; [bDeltaP2P0|bDeltaQ2Q0] = |p2 - p0| < iBeta, |q2 - q0| < iBeta
+    vpand    ymm7, ymm7, ymm12                ; &= |p0 - q0| < (iAlpha >> 2) + 2
+
+    ; Same as SSE2_DeblockLumaEq4_3x16P with the q side in the high lane.
+    vbroadcasti128 ymm15, [WELS_DB1_16]
+    vpblendvb ymm8, ymm1, ymm4, ymm7          ; t0 = bDeltaP2P0 ? q0 : p1
+    vpblendvb ymm9, ymm5, ymm2, ymm7          ; t1 = bDeltaP2P0 ? p2 : q1
+    AVX2_AvgbFloor1 ymm5, ymm5, ymm9, ymm15, ymm10   ; t1 = (t1 + q1) >> 1
+    AVX2_AvgbFloor1 ymm11, ymm1, ymm0, ymm15, ymm10  ; (p0 + p1) >> 1, p0 ^ p1
+    vpxor    ymm10, ymm10, ymm15
+    AVX2_AvgbFloor1 ymm8, ymm8, ymm5, ymm10, ymm9    ; (t0 + t1 + (p0 ^ p1 & 1)) >> 1
+    AVX2_AvgbFloor1 ymm4, ymm4, ymm2, ymm10, ymm5    ; (p2 + q0 + (p0 ^ p1 & 1)) >> 1
+    vpavgb   ymm8, ymm8, ymm11                ; p0' = (p0 + p1 + t0 + t1 + 2) >> 2
+    vpxor    ymm10, ymm11, ymm4               ; (p0 + p1) >> 1 ^ (p2 + q0 + (p0 ^ p1 & 1)) >> 1
+    vpand    ymm10, ymm10, ymm15              ; & 1
+    vpavgb   ymm11, ymm11, ymm4               ; p1' = (p0 + p1 + p2 + q0 + 2) >> 2
+    vpand    ymm7, ymm7, ymm6                 ; bDeltaP2P0 &= bDeltaP0Q0P1P0Q1Q0
+    vpblendvb ymm8, ymm0, ymm8, ymm6          ; p0out = bDeltaP0Q0P1P0Q1Q0 ? p0' : p0
+    AVX2_StorePQRow mm8, 0                    ; store p0 and q0
+    vpsubb   ymm9, ymm11, ymm10               ; (p0 + p1 + p2 + q0) >> 2
+    vpsubb   ymm10, ymm10, ymm15
+    vpxor    ymm3, ymm3, ymm10
+    vpxor    ymm4, ymm2, ymm10
+    vpavgb   ymm3, ymm3, ymm4
+    vpxor    ymm3, ymm3, ymm10                ; (p2 + p3 + ((p0 + p1) >> 1 ^ (p2 + q0 + (p0 ^ p1 & 1)) >> 1 & 1)) >> 1
+    vpavgb   ymm9, ymm9, ymm3                 ; p2' = (((p0 + p1 + p2 + q0) >> 1) + p2 + p3 + 2) >> 2
+    vpblendvb ymm9, ymm2, ymm9, ymm7          ; p2out = bDeltaP2P0 ? p2' : p2
+    AVX2_StorePQRow mm9, 2                    ; store p2 and q2
+    vpblendvb ymm11, ymm1, ymm11, ymm7        ; p1out = bDeltaP2P0 ? p1' : p1
+    AVX2_StorePQRow mm11, 1                   ; store p1 and q1
+
+    vzeroupper
+    POP_XMM
+    LOAD_4_PARA_POP
+    ret
+%endif
+
+%endif ; HAVE_AVX2
@@ -725,4 +725,69 @@ WELS_EXTERN ExpandPictureChromaUnalign_sse2
     %assign push_num 0
 
 
+    ret
+
+;***********************************************************************----------------
+; void ExpandPictureLinesLeftRight_sse2( uint8_t *pDst,
+;                                        const int32_t iStride,
+;                                        const int32_t iWidth,
+;                                        const int32_t iLines,
+;                                        const int32_t iPaddingLen );
+; pads the left and right border of iLines lines, iPaddingLen is a multiple of 8
+;***********************************************************************----------------
+WELS_EXTERN ExpandPictureLinesLeftRight_sse2
+    push r5
+    push r6
+
+    %assign push_num 2
+    LOAD_5_PARA
+
+    SIGN_EXTENSION r1,r1d
+    SIGN_EXTENSION r2,r2d
+    SIGN_EXTENSION r3,r3d
+    SIGN_EXTENSION r4,r4d
+
+    test r3,r3
+    jle near .exp_lines_end
+
+    add r2,r4                   ;r2 = width + padding
+    neg r4                      ;r4 = -padding
+
+.exp_lines_loops:
+    ; left
+    movzx r5d,byte [r0]
+    SSE2_Copy16Times xmm0,r5d
+
+    ; right
+    lea r6,[r0+r2]              ;end of the right border
+    movzx r5d,byte [r6+r4-1]
+    SSE2_Copy16Times xmm1,r5d
+
+    mov r5,r4
+    cmp r5,-16
+    jg .exp_lines_tail
+.exp_lines_16:
+    movdqu [r0+r5],xmm0
+    movdqu [r6+r5],xmm1
+    add r5,16
+    cmp r5,-16
+    jle .exp_lines_16
+.exp_lines_tail:
+    test r5,r5
+    jz .exp_lines_next
+    movq [r0+r5],xmm0
+    movq [r6+r5],xmm1
+.exp_lines_next:
+    add r0,r1
+    dec r3
+    jnz near .exp_lines_loops
+
+.exp_lines_end:
+    LOAD_5_PARA_POP
+
+    pop r6
+    pop r5
+
+    %assign push_num 0
+
     ret
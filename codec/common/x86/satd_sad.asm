@@ -2697,6 +2697,160 @@ WELS_EXTERN WelsSampleSadFour4x4_sse2
 ;
 ;***********************************************************************
 
+;***********************************************************************
+;
+;Pixel_sad_4ref_wxh_sse2 BEGIN
+;
+;***********************************************************************
+
+%ifdef X86_32
+%define PTR_SIZE 4
+%else
+%define PTR_SIZE 8
+%endif
+
+; r2 (ppSample2) -> r2, r5, r6, r4 the four reference blocks, pSad (r4) is kept on the stack
+%macro SAD_4REF_LOAD_REFS 0
+    push   r4
+    %assign push_num push_num+1
+    mov    r4,    [r2+3*PTR_SIZE]
+    mov    r6,    [r2+2*PTR_SIZE]
+    mov    r5,    [r2+PTR_SIZE]
+    mov    r2,    [r2]
+%endmacro
+
+%macro SAD_4REF_NEXT_2_LINES 0
+    lea    r0,    [r0+2*r1]
+    lea    r2,    [r2+2*r3]
+    lea    r5,    [r5+2*r3]
+    lea    r6,    [r6+2*r3]
+    lea    r4,    [r4+2*r3]
+%endmacro
+
+%macro SSE2_Sad4Ref16x1 2 ;source offset, reference offset
+    movdqu xmm0,   [r0+%1]
+    movdqu xmm1,   [r2+%2]
+    psadbw xmm1,   xmm0
+    paddd  xmm2,   xmm1
+    movdqu xmm1,   [r5+%2]
+    psadbw xmm1,   xmm0
+    paddd  xmm3,   xmm1
+    movdqu xmm1,   [r6+%2]
+    psadbw xmm1,   xmm0
+    paddd  xmm4,   xmm1
+    movdqu xmm1,   [r4+%2]
+    psadbw xmm1,   xmm0
+    paddd  xmm5,   xmm1
+%endmacro
+
+%macro SSE2_Sad4Ref16x2 0
+    SSE2_Sad4Ref16x1 0, 0
+    SSE2_Sad4Ref16x1 r1, r3
+    SAD_4REF_NEXT_2_LINES
+%endmacro
+
+%macro SSE2_Sad4Ref8x2 0
+    movq   xmm0,   [r0]
+    movhps xmm0,   [r0+r1]
+    movq   xmm1,   [r2]
+    movhps xmm1,   [r2+r3]
+    psadbw xmm1,   xmm0
+    paddd  xmm2,   xmm1
+    movq   xmm1,   [r5]
+    movhps xmm1,   [r5+r3]
+    psadbw xmm1,   xmm0
+    paddd  xmm3,   xmm1
+    movq   xmm1,   [r6]
+    movhps xmm1,   [r6+r3]
+    psadbw xmm1,   xmm0
+    paddd  xmm4,   xmm1
+    movq   xmm1,   [r4]
+    movhps xmm1,   [r4+r3]
+    psadbw xmm1,   xmm0
+    paddd  xmm5,   xmm1
+    SAD_4REF_NEXT_2_LINES
+%endmacro
+
+%macro SSE2_Sad4Ref_Begin 0
+    %assign  push_num 0
+%ifdef X86_32
+    push   r5
+    push   r6
+    %assign  push_num 2
+%endif
+    LOAD_5_PARA
+    SIGN_EXTENSION r1, r1d
+    SIGN_EXTENSION r3, r3d
+    SAD_4REF_LOAD_REFS
+    pxor   xmm2,   xmm2
+    pxor   xmm3,   xmm3
+    pxor   xmm4,   xmm4
+    pxor   xmm5,   xmm5
+%endmacro
+
+%macro SSE2_Sad4Ref_End 0
+    movhlps    xmm0, xmm2
+    paddd      xmm2, xmm0
+    movhlps    xmm0, xmm3
+    paddd      xmm3, xmm0
+    movhlps    xmm0, xmm4
+    paddd      xmm4, xmm0
+    movhlps    xmm0, xmm5
+    paddd      xmm5, xmm0
+    punpckldq  xmm2, xmm3
+    punpckldq  xmm4, xmm5
+    punpcklqdq xmm2, xmm4
+    pop        r4
+    movdqu     [r4], xmm2
+    LOAD_5_PARA_POP
+%ifdef X86_32
+    pop    r6
+    pop    r5
+%endif
+    ret
+%endmacro
+
+;***********************************************************************
+;
+;void WelsSampleSadFourRef16x16_sse2 (uint8_t* pSample1, int32_t iStride1, uint8_t** ppSample2, int32_t iStride2,
+;                                     int32_t* pSad)
+;pSad[i] is the SAD of pSample1 against ppSample2[i], i = 0..3
+;
+;***********************************************************************
+WELS_EXTERN WelsSampleSadFourRef16x16_sse2
+    SSE2_Sad4Ref_Begin
+%rep 8
+    SSE2_Sad4Ref16x2
+%endrep
+    SSE2_Sad4Ref_End
+
+WELS_EXTERN WelsSampleSadFourRef16x8_sse2
+    SSE2_Sad4Ref_Begin
+%rep 4
+    SSE2_Sad4Ref16x2
+%endrep
+    SSE2_Sad4Ref_End
+
+WELS_EXTERN WelsSampleSadFourRef8x16_sse2
+    SSE2_Sad4Ref_Begin
+%rep 8
+    SSE2_Sad4Ref8x2
+%endrep
+    SSE2_Sad4Ref_End
+
+WELS_EXTERN WelsSampleSadFourRef8x8_sse2
+    SSE2_Sad4Ref_Begin
+%rep 4
+    SSE2_Sad4Ref8x2
+%endrep
+    SSE2_Sad4Ref_End
+
+;***********************************************************************
+;
+;Pixel_sad_4ref_wxh_sse2 END
+;
+;***********************************************************************
+
 ;***********************************************************************
 ;   int32_t WelsSampleSad4x4_mmx (uint8_t *, int32_t, uint8_t *, int32_t )
 ;***********************************************************************
@@ -2732,3 +2886,167 @@ WELS_EXTERN WelsSampleSad4x4_mmx
     WELSEMMS
     LOAD_4_PARA_POP
     ret
+
+
+;***********************************************************************
+;
+;Pixel_sad_4_wxh_avx2 BEGIN
+;
+;***********************************************************************
+
+%ifdef HAVE_AVX2
+
+; %1..%4 hold the four qword partial sums of the SADs 0..3 in their lanes -> pSad[0..3] (r4)
+%macro AVX2_Sad4_Store 4
+    vpunpcklqdq  ymm0, y%1, y%2
+    vpunpckhqdq  y%1,  y%1, y%2
+    vpaddd       y%1,  y%1, ymm0
+    vpunpcklqdq  ymm0, y%3, y%4
+    vpunpckhqdq  y%3,  y%3, y%4
+    vpaddd       y%3,  y%3, ymm0
+    vpshufd      y%1,  y%1, 10001000b
+    vpshufd      y%3,  y%3, 10001000b
+    vpunpcklqdq  y%1,  y%1, y%3
+    vextracti128 xmm0, y%1, 1
+    vpaddd       xmm0, xmm0, x%1
+    vmovdqu      [r4], xmm0
+    vzeroupper
+%endmacro
+
+;***********************************************************************
+;
+;void WelsSampleSadFour16x16_avx2 (uint8_t*, int32_t, uint8_t*, int32_t, int32_t*)
+;pSad: pRef - iStride, pRef + iStride, pRef - 1, pRef + 1
+;Two lines are handled per 256-bit register, the reference lines below a pair of lines are
+;the ones above the next pair.
+;
+;***********************************************************************
+
+%macro AVX2_SadFour16x2 0
+    vmovdqu      xmm0, [r0]
+    vinserti128  ymm0, ymm0, [r0+r1], 1
+    vmovdqu      xmm3, [r2+r3]
+    vinserti128  ymm3, ymm3, [r2+2*r3], 1
+    vpsadbw      ymm1, ymm2, ymm0
+    vpaddd       ymm4, ymm4, ymm1
+    vpsadbw      ymm1, ymm3, ymm0
+    vpaddd       ymm5, ymm5, ymm1
+    vmovdqu      xmm1, [r2-1]
+    vinserti128  ymm1, ymm1, [r2+r3-1], 1
+    vpsadbw      ymm1, ymm1, ymm0
+    vpaddd       ymm6, ymm6, ymm1
+    vmovdqu      xmm2, [r2+1]
+    vinserti128  ymm2, ymm2, [r2+r3+1], 1
+    vpsadbw      ymm2, ymm2, ymm0
+    vpaddd       ymm7, ymm7, ymm2
+    vmovdqa      ymm2, ymm3
+    lea          r0,   [r0+2*r1]
+    lea          r2,   [r2+2*r3]
+%endmacro
+
+%macro AVX2_SadFour16xN 1 ;rows
+    %assign  push_num 0
+%ifdef X86_32
+    push   r5
+    %assign  push_num 1
+%endif
+    LOAD_5_PARA
+    PUSH_XMM 8
+    SIGN_EXTENSION r1, r1d
+    SIGN_EXTENSION r3, r3d
+    mov          r5,   r2
+    sub          r5,   r3
+    vmovdqu      xmm2, [r5]
+    vinserti128  ymm2, ymm2, [r2], 1
+    vpxor        ymm4, ymm4, ymm4
+    vpxor        ymm5, ymm5, ymm5
+    vpxor        ymm6, ymm6, ymm6
+    vpxor        ymm7, ymm7, ymm7
+%rep %1 / 2
+    AVX2_SadFour16x2
+%endrep
+    AVX2_Sad4_Store mm4, mm5, mm6, mm7
+    POP_XMM
+    LOAD_5_PARA_POP
+%ifdef X86_32
+    pop    r5
+%endif
+    ret
+%endmacro
+
+WELS_EXTERN WelsSampleSadFour16x16_avx2
+    AVX2_SadFour16xN 16
+
+WELS_EXTERN WelsSampleSadFour16x8_avx2
+    AVX2_SadFour16xN 8
+
+;***********************************************************************
+;
+;void WelsSampleSadFourRef16x16_avx2 (uint8_t* pSample1, int32_t iStride1, uint8_t** ppSample2, int32_t iStride2,
+;                                     int32_t* pSad)
+;
+;***********************************************************************
+
+%macro AVX2_SadFourRef16x2 0
+    vmovdqu      xmm0, [r0]
+    vinserti128  ymm0, ymm0, [r0+r1], 1
+    vmovdqu      xmm1, [r2]
+    vinserti128  ymm1, ymm1, [r2+r3], 1
+    vpsadbw      ymm1, ymm1, ymm0
+    vpaddd       ymm2, ymm2, ymm1
+    vmovdqu      xmm1, [r5]
+    vinserti128  ymm1, ymm1, [r5+r3], 1
+    vpsadbw      ymm1, ymm1, ymm0
+    vpaddd       ymm3, ymm3, ymm1
+    vmovdqu      xmm1, [r6]
+    vinserti128  ymm1, ymm1, [r6+r3], 1
+    vpsadbw      ymm1, ymm1, ymm0
+    vpaddd       ymm4, ymm4, ymm1
+    vmovdqu      xmm1, [r4]
+    vinserti128  ymm1, ymm1, [r4+r3], 1
+    vpsadbw      ymm1, ymm1, ymm0
+    vpaddd       ymm5, ymm5, ymm1
+    SAD_4REF_NEXT_2_LINES
+%endmacro
+
+%macro AVX2_SadFourRef16xN 1 ;rows
+    %assign  push_num 0
+%ifdef X86_32
+    push   r5
+    push   r6
+    %assign  push_num 2
+%endif
+    LOAD_5_PARA
+    SIGN_EXTENSION r1, r1d
+    SIGN_EXTENSION r3, r3d
+    SAD_4REF_LOAD_REFS
+    vpxor  ymm2, ymm2, ymm2
+    vpxor  ymm3, ymm3, ymm3
+    vpxor  ymm4, ymm4, ymm4
+    vpxor  ymm5, ymm5, ymm5
+%rep %1 / 2
+    AVX2_SadFourRef16x2
+%endrep
+    pop    r4
+    AVX2_Sad4_Store mm2, mm3, mm4, mm5
+    LOAD_5_PARA_POP
+%ifdef X86_32
+    pop    r6
+    pop    r5
+%endif
+    ret
+%endmacro
+
+WELS_EXTERN WelsSampleSadFourRef16x16_avx2
+    AVX2_SadFourRef16xN 16
+
+WELS_EXTERN WelsSampleSadFourRef16x8_avx2
+    AVX2_SadFourRef16xN 8
+
+%endif
+
+;***********************************************************************
+;
+;Pixel_sad_4_wxh_avx2 END
+;
+;***********************************************************************
@@ -0,0 +1,454 @@
+/*!
+ * \copy
+ *     Copyright (c)  2004-2013, Cisco Systems
+ *     All rights reserved.
+ *
+ *     Redistribution and use in source and binary forms, with or without
+ *     modification, are permitted provided that the following conditions
+ *     are met:
+ *
+ *        * Redistributions of source code must retain the above copyright
+ *          notice, this list of conditions and the following disclaimer.
+ *
+ *        * Redistributions in binary form must reproduce the above copyright
+ *          notice, this list of conditions and the following disclaimer in
+ *          the documentation and/or other materials provided with the
+ *          distribution.
+ *
+ *     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *     "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *     LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *     FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *     COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *     INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *     BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *     LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *     CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *     LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *     ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *     POSSIBILITY OF SUCH DAMAGE.
+ *
+ * decbench.cpp:         Wels Decoder throughput benchmark
+ *
+ *  decodes every bitstream of the given files and directories (res/ by default) several times in process
+ *  and reports frames/s, MB/s, the cost per MB of the decoding stages and the peak memory, as JSON on stdout
+ */
+
+#if defined (_WIN32)
+#define _CRT_SECURE_NO_WARNINGS
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "codec_def.h"
+#include "codec_app_def.h"
+#include "codec_api.h"
+#include "typedefs.h"
+#include "measure_time.h"
+#include "version.h"
+
+using namespace std;
+
+typedef struct TagBenchParam {
+  int32_t iRepeatNum;                 // decoding runs per bitstream, the fastest one is reported
+  int32_t iThreadNum;                 // DECODER_OPTION_NUM_OF_THREADS
+  int32_t iSliceThreading;            // DECODER_OPTION_SLICE_THREADING
+  bool bForceCpuFlags;
+  uint32_t uiCpuFlags;                // DECODER_OPTION_CPU_FLAGS when forced
+  int32_t iSkipMode;                  // DECODER_OPTION_SKIP_FRAMES
+  bool bFastPreview;                  // SDecodingParam::bFastPreview
+  SPicturePool* pPicPool;             // DECODER_OPTION_PICTURE_POOL shared by all the decoding runs, NULL without
+} SBenchParam;
+
+typedef struct TagBenchResult {
+  string strFileName;
+  int32_t iFrameNum;                  // output frames per run
+  int64_t iMbNum;                     // MBs of the output frames per run
+  int32_t iErrorNum;                  // decoding calls not returning dsErrorFree, per run
+  int64_t iBestUs;                    // fastest run
+  int64_t iTotalUs;                   // all runs, then per run
+  int64_t iTotalTicks;                // all runs, then per run
+  SDecoderStageStatistics sStages;    // all runs, then per run
+} SBenchResult;
+
+static bool IsBitstreamFile (const string& kstrName) {
+  static const char* kpSuffix[] = {".264", ".h264", ".jsv", ".avc"};
+  for (size_t i = 0; i < sizeof (kpSuffix) / sizeof (kpSuffix[0]); i++) {
+    const size_t kuiLen = strlen (kpSuffix[i]);
+    if (kstrName.size() > kuiLen && !kstrName.compare (kstrName.size() - kuiLen, kuiLen, kpSuffix[i]))
+      return true;
+  }
+  return false;
+}
+
+static void ListBitstreams (const char* kpPath, vector<string>& vFiles) {
+  vector<string> vFound;
+#if defined (_WIN32)
+  WIN32_FIND_DATAA sFindData;
+  HANDLE hFind = FindFirstFileA ((string (kpPath) + "\\*").c_str(), &sFindData);
+  if (hFind == INVALID_HANDLE_VALUE) {
+    vFiles.push_back (kpPath);
+    return;
+  }
+  do {
+    if (! (sFindData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) && IsBitstreamFile (sFindData.cFileName))
+      vFound.push_back (string (kpPath) + "/" + sFindData.cFileName);
+  } while (FindNextFileA (hFind, &sFindData));
+  FindClose (hFind);
+#else
+  struct stat sStat;
+  DIR* pDir = NULL;
+  if (stat (kpPath, &sStat) != 0 || !S_ISDIR (sStat.st_mode) || (pDir = opendir (kpPath)) == NULL) {
+    vFiles.push_back (kpPath);
+    return;
+  }
+  while (struct dirent* pEntry = readdir (pDir)) {
+    if (IsBitstreamFile (pEntry->d_name))
+      vFound.push_back (string (kpPath) + "/" + pEntry->d_name);
+  }
+  closedir (pDir);
+#endif
+  sort (vFound.begin(), vFound.end());
+  vFiles.insert (vFiles.end(), vFound.begin(), vFound.end());
+}
+
+/*
+ *  split the bitstream before each 4 byte start code, as the decoding tests feed the decoder
+ */
+static void SplitBitstream (const vector<uint8_t>& kvData, vector<size_t>& vOffsets) {
+  const size_t kuiSize = kvData.size();
+  vOffsets.clear();
+  vOffsets.push_back (0);
+  for (size_t i = 4; i + 3 < kuiSize; i++) {
+    if (kvData[i] == 0 && kvData[i + 1] == 0 && kvData[i + 2] == 0 && kvData[i + 3] == 1)
+      vOffsets.push_back (i);
+  }
+  vOffsets.push_back (kuiSize);
+}
+
+// kilobytes, 0 when unknown
+static int64_t PeakMemoryKb() {
+#if defined (_WIN32)
+  return 0;
+#else
+  struct rusage sUsage;
+  if (getrusage (RUSAGE_SELF, &sUsage))
+    return 0;
+#if defined (__APPLE__)
+  return sUsage.ru_maxrss / 1024;
+#else
+  return sUsage.ru_maxrss;
+#endif
+#endif
+}
+
+static void CountOutput (const SBufferInfo& kBufInfo, SBenchResult* pResult) {
+  if (kBufInfo.iBufferStatus != 1)
+    return;
+  pResult->iFrameNum++;
+  pResult->iMbNum += ((kBufInfo.UsrData.sSystemBuffer.iWidth + 15) >> 4) * ((kBufInfo.UsrData.sSystemBuffer.iHeight + 15)
+                     >> 4);
+}
+
+static void AddStageStatistics (SDecoderStageStatistics* pSum, const SDecoderStageStatistics& kStages) {
+  for (int32_t i = 0; i < DECODER_STAGE_NUM; i++) {
+    pSum->sStage[i].uiCycles += kStages.sStage[i].uiCycles;
+    pSum->sStage[i].uiNanoseconds += kStages.sStage[i].uiNanoseconds;
+    pSum->sStage[i].uiCount += kStages.sStage[i].uiCount;
+  }
+  pSum->uiParsedMbCount += kStages.uiParsedMbCount;
+  pSum->uiElapsedNanoseconds += kStages.uiElapsedNanoseconds;
+}
+
+static bool DecodeOnce (const SBenchParam& kParam, const vector<uint8_t>& kvData, const vector<size_t>& kvOffsets,
+                        SBenchResult* pResult) {
+  ISVCDecoder* pDecoder = NULL;
+  SDecodingParam sDecParam;
+  SBufferInfo sBufInfo;
+  uint8_t* pDst[3];
+  int32_t iStageTiming = 1;
+
+  if (WelsCreateDecoder (&pDecoder) || NULL == pDecoder)
+    return false;
+  memset (&sDecParam, 0, sizeof (SDecodingParam));
+  sDecParam.uiTargetDqLayer = (uint8_t) - 1;
+  sDecParam.eEcActiveIdc = ERROR_CON_SLICE_COPY;
+  sDecParam.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
+  sDecParam.bFastPreview = kParam.bFastPreview;
+  if (pDecoder->Initialize (&sDecParam)) {
+    WelsDestroyDecoder (pDecoder);
+    return false;
+  }
+  if (kParam.bForceCpuFlags)
+    pDecoder->SetOption (DECODER_OPTION_CPU_FLAGS, (void*)&kParam.uiCpuFlags);
+  pDecoder->SetOption (DECODER_OPTION_SLICE_THREADING, (void*)&kParam.iSliceThreading);
+  pDecoder->SetOption (DECODER_OPTION_NUM_OF_THREADS, (void*)&kParam.iThreadNum);
+  pDecoder->SetOption (DECODER_OPTION_STAGE_TIMING, &iStageTiming);
+  pDecoder->SetOption (DECODER_OPTION_SKIP_FRAMES, (void*)&kParam.iSkipMode);
+  if (kParam.pPicPool != NULL)
+    pDecoder->SetOption (DECODER_OPTION_PICTURE_POOL, (void*)&kParam.pPicPool);
+
+  pResult->iFrameNum = 0;
+  pResult->iMbNum = 0;
+  pResult->iErrorNum = 0;
+  const int64_t kiStartTicks = WelsTicks();
+  const int64_t kiStartUs = WelsTime();
+  for (size_t i = 0; i + 1 < kvOffsets.size(); i++) {
+    memset (pDst, 0, sizeof (pDst));
+    memset (&sBufInfo, 0, sizeof (SBufferInfo));
+    if (pDecoder->DecodeFrame2 (&kvData[kvOffsets[i]], (int) (kvOffsets[i + 1] - kvOffsets[i]), pDst, &sBufInfo))
+      pResult->iErrorNum++;
+    CountOutput (sBufInfo, pResult);
+  }
+  int32_t iEndOfStream = 1;
+  pDecoder->SetOption (DECODER_OPTION_END_OF_STREAM, &iEndOfStream);
+  int32_t iRemaining = 0;
+  pDecoder->GetOption (DECODER_OPTION_NUM_OF_FRAMES_REMAINING_IN_BUFFER, &iRemaining);
+  for (int32_t i = 0; i <= iRemaining; i++) {
+    memset (&sBufInfo, 0, sizeof (SBufferInfo));
+    pDecoder->DecodeFrame2 (NULL, 0, pDst, &sBufInfo);
+    CountOutput (sBufInfo, pResult);
+  }
+  const int64_t kiUs = WelsTime() - kiStartUs;
+  pResult->iTotalTicks += WelsTicks() - kiStartTicks;
+  pResult->iTotalUs += kiUs;
+  if (pResult->iBestUs < 0 || kiUs < pResult->iBestUs)
+    pResult->iBestUs = kiUs;
+
+  SDecoderStageStatistics sStages;
+  memset (&sStages, 0, sizeof (SDecoderStageStatistics));
+  pDecoder->GetOption (DECODER_OPTION_GET_STAGE_STATISTICS, &sStages);
+  AddStageStatistics (&pResult->sStages, sStages);
+
+  pDecoder->Uninitialize();
+  WelsDestroyDecoder (pDecoder);
+  return true;
+}
+
+static double PerMb (unsigned long long uiTicks, unsigned long long uiMbNum) {
+  return uiMbNum ? (double) uiTicks / (double) uiMbNum : 0.0;
+}
+
+// "key": {"stage": cost per MB, ..., "other": cost of the rest of the run per MB}
+static void PrintJsonStages (FILE* pFile, const char* pKey, const unsigned long long* pCost, unsigned long long uiTotal,
+                             unsigned long long uiMbNum) {
+  static const char* kpStageName[DECODER_STAGE_NUM] = {"unescape", "header", "parse", "recon", "deblock", "expand", "ec"};
+  unsigned long long uiStages = 0;
+  fprintf (pFile, "\"%s\": {", pKey);
+  for (int32_t i = 0; i < DECODER_STAGE_NUM; i++) {
+    fprintf (pFile, "\"%s\": %.1f, ", kpStageName[i], PerMb (pCost[i], uiMbNum));
+    uiStages += pCost[i];
+  }
+  fprintf (pFile, "\"other\": %.1f}", PerMb (uiTotal > uiStages ? uiTotal - uiStages : 0, uiMbNum));
+}
+
+static void PrintJsonString (FILE* pFile, const string& kstr) {
+  fputc ('"', pFile);
+  for (size_t i = 0; i < kstr.size(); i++) {
+    if (kstr[i] == '"' || kstr[i] == '\\')
+      fputc ('\\', pFile);
+    fputc (kstr[i], pFile);
+  }
+  fputc ('"', pFile);
+}
+
+static void PrintJsonResult (FILE* pFile, const SBenchResult& kResult, double dTicksPerUs) {
+  const SDecoderStageStatistics& kStages = kResult.sStages;
+  const double kdSeconds = kResult.iBestUs / 1e6;
+  unsigned long long uiCycles[DECODER_STAGE_NUM], uiNanoseconds[DECODER_STAGE_NUM];
+  for (int32_t i = 0; i < DECODER_STAGE_NUM; i++) {
+    uiCycles[i] = kStages.sStage[i].uiCycles;
+    uiNanoseconds[i] = kStages.sStage[i].uiNanoseconds;
+  }
+#if defined(WELS_TICKS_CPU_CYCLES)
+  const unsigned long long kuiTotalCycles = kResult.iTotalTicks;
+#else
+  const unsigned long long kuiTotalCycles = 0;
+#endif
+
+  fprintf (pFile, "{\"file\": ");
+  PrintJsonString (pFile, kResult.strFileName);
+  fprintf (pFile, ", \"frames\": %d, \"mbs\": %lld, \"errors\": %d,\n", kResult.iFrameNum, (long long)kResult.iMbNum,
+           kResult.iErrorNum);
+  fprintf (pFile, "     \"best_ms\": %.3f, \"mean_ms\": %.3f, \"fps\": %.2f, \"mb_per_s\": %.0f,\n",
+           kResult.iBestUs / 1e3, kResult.iTotalUs / 1e3, kdSeconds > 0 ? kResult.iFrameNum / kdSeconds : 0.0,
+           kdSeconds > 0 ? kResult.iMbNum / kdSeconds : 0.0);
+  fprintf (pFile, "     \"ticks_per_us\": %.1f,\n     ", dTicksPerUs);
+  PrintJsonStages (pFile, "cycles_per_mb", uiCycles, kuiTotalCycles, kStages.uiParsedMbCount);
+  fprintf (pFile, ",\n     ");
+  PrintJsonStages (pFile, "ns_per_mb", uiNanoseconds, (unsigned long long)kResult.iTotalUs * 1000, kStages.uiParsedMbCount);
+  fprintf (pFile, "}");
+}
+
+static void PrintHelp() {
+  printf ("Usage: decbench [options] [bitstream files or directories, res by default]\n");
+  printf ("  -n <num>          decoding runs per bitstream, the fastest is reported (default 3)\n");
+  printf ("  -threads <num>    decoding threads (default 0)\n");
+  printf ("  -slicethreads     the decoding threads share the slices of a picture\n");
+  printf ("  -cpu <mask>       WELS_CPU_* feature mask the decoder functions are selected with, 0 for C only\n");
+  printf ("  -skip <mode>      pictures not decoded, 1 for the non-reference ones, 2 for all but IDR (default 0)\n");
+  printf ("  -preview          fast preview decoding, no deblocking and whole pel chroma motion, the output drifts\n");
+  printf ("  -pool <w>x<h>     carve the pictures of all decoding runs from a picture pool sized for w x h\n");
+  printf ("  -o <file>         write the JSON report to file instead of stdout\n");
+}
+
+int32_t main (int32_t iArgC, char* pArgV[]) {
+  SBenchParam sParam;
+  vector<string> vFiles;
+  const char* pJsonFileName = NULL;
+
+  memset (&sParam, 0, sizeof (SBenchParam));
+  sParam.iRepeatNum = 3;
+  for (int32_t i = 1; i < iArgC; i++) {
+    const char* kpCmd = pArgV[i];
+    if (!strcmp (kpCmd, "-n") && i + 1 < iArgC) {
+      sParam.iRepeatNum = atoi (pArgV[++i]);
+      if (sParam.iRepeatNum < 1)
+        sParam.iRepeatNum = 1;
+    } else if (!strcmp (kpCmd, "-threads") && i + 1 < iArgC) {
+      sParam.iThreadNum = atoi (pArgV[++i]);
+    } else if (!strcmp (kpCmd, "-slicethreads")) {
+      sParam.iSliceThreading = 1;
+    } else if (!strcmp (kpCmd, "-cpu") && i + 1 < iArgC) {
+      sParam.bForceCpuFlags = true;
+      sParam.uiCpuFlags = (uint32_t) strtoul (pArgV[++i], NULL, 0);
+    } else if (!strcmp (kpCmd, "-skip") && i + 1 < iArgC) {
+      sParam.iSkipMode = atoi (pArgV[++i]);
+    } else if (!strcmp (kpCmd, "-preview")) {
+      sParam.bFastPreview = true;
+    } else if (!strcmp (kpCmd, "-pool") && i + 1 < iArgC) {
+      SPicturePoolParam sPoolParam;
+      memset (&sPoolParam, 0, sizeof (SPicturePoolParam));
+      if (sscanf (pArgV[++i], "%dx%d", &sPoolParam.iMaxWidth, &sPoolParam.iMaxHeight) != 2
+          || sParam.pPicPool != NULL || WelsCreatePicturePool (&sPoolParam, &sParam.pPicPool)) {
+        fprintf (stderr, "Invalid picture pool %s.\n", pArgV[i]);
+        return 1;
+      }
+    } else if (!strcmp (kpCmd, "-o") && i + 1 < iArgC) {
+      pJsonFileName = pArgV[++i];
+    } else if (kpCmd[0] == '-') {
+      PrintHelp();
+      return 1;
+    } else {
+      ListBitstreams (kpCmd, vFiles);
+    }
+  }
+  if (vFiles.empty())
+    ListBitstreams ("res", vFiles);
+
+  FILE* pJsonFile = pJsonFileName ? fopen (pJsonFileName, "w") : stdout;
+  if (pJsonFile == NULL) {
+    fprintf (stderr, "Can not open %s.\n", pJsonFileName);
+    return 1;
+  }
+
+  vector<SBenchResult> vResults;
+  SBenchResult sTotal;
+  sTotal.strFileName = "";
+  sTotal.iFrameNum = sTotal.iErrorNum = 0;
+  sTotal.iMbNum = sTotal.iBestUs = sTotal.iTotalUs = sTotal.iTotalTicks = 0;
+  memset (&sTotal.sStages, 0, sizeof (SDecoderStageStatistics));
+  uint32_t uiUsedCpuFlags = 0;
+  for (size_t i = 0; i < vFiles.size(); i++) {
+    FILE* pFile = fopen (vFiles[i].c_str(), "rb");
+    if (pFile == NULL) {
+      fprintf (stderr, "Can not open %s, skipped.\n", vFiles[i].c_str());
+      continue;
+    }
+    vector<uint8_t> vData;
+    uint8_t uiBuf[4096];
+    size_t uiRead;
+    while ((uiRead = fread (uiBuf, 1, sizeof (uiBuf), pFile)) > 0)
+      vData.insert (vData.end(), uiBuf, uiBuf + uiRead);
+    fclose (pFile);
+    if (vData.empty())
+      continue;
+    vector<size_t> vOffsets;
+    SplitBitstream (vData, vOffsets);
+
+    SBenchResult sResult;
+    sResult.strFileName = vFiles[i];
+    sResult.iBestUs = -1;
+    sResult.iTotalUs = sResult.iTotalTicks = 0;
+    memset (&sResult.sStages, 0, sizeof (SDecoderStageStatistics));
+    bool bDecoded = true;
+    for (int32_t j = 0; j < sParam.iRepeatNum && bDecoded; j++)
+      bDecoded = DecodeOnce (sParam, vData, vOffsets, &sResult);
+    if (!bDecoded) {
+      fprintf (stderr, "Can not decode %s, skipped.\n", vFiles[i].c_str());
+      continue;
+    }
+    // the stage costs are reported for a single run
+    for (int32_t j = 0; j < DECODER_STAGE_NUM; j++) {
+      sResult.sStages.sStage[j].uiCycles /= sParam.iRepeatNum;
+      sResult.sStages.sStage[j].uiNanoseconds /= sParam.iRepeatNum;
+      sResult.sStages.sStage[j].uiCount /= sParam.iRepeatNum;
+    }
+    sResult.sStages.uiParsedMbCount /= sParam.iRepeatNum;
+    sResult.sStages.uiElapsedNanoseconds /= sParam.iRepeatNum;
+    sResult.iTotalTicks /= sParam.iRepeatNum;
+    sResult.iTotalUs /= sParam.iRepeatNum;
+    fprintf (stderr, "%-48s %5d frames %9.2f fps %11.0f MB/s\n", vFiles[i].c_str(), sResult.iFrameNum,
+             sResult.iBestUs > 0 ? sResult.iFrameNum * 1e6 / sResult.iBestUs : 0.0,
+             sResult.iBestUs > 0 ? sResult.iMbNum * 1e6 / sResult.iBestUs : 0.0);
+
+    sTotal.iFrameNum += sResult.iFrameNum;
+    sTotal.iMbNum += sResult.iMbNum;
+    sTotal.iErrorNum += sResult.iErrorNum;
+    sTotal.iBestUs += sResult.iBestUs;
+    sTotal.iTotalUs += sResult.iTotalUs;
+    sTotal.iTotalTicks += sResult.iTotalTicks;
+    AddStageStatistics (&sTotal.sStages, sResult.sStages);
+    vResults.push_back (sResult);
+  }
+
+  // cpu flags actually used, i.e. forced ones within the detected ones
+  ISVCDecoder* pDecoder = NULL;
+  if (!WelsCreateDecoder (&pDecoder) && pDecoder != NULL) {
+    SDecodingParam sDecParam;
+    memset (&sDecParam, 0, sizeof (SDecodingParam));
+    sDecParam.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
+    if (!pDecoder->Initialize (&sDecParam)) {
+      if (sParam.bForceCpuFlags)
+        pDecoder->SetOption (DECODER_OPTION_CPU_FLAGS, &sParam.uiCpuFlags);
+      pDecoder->GetOption (DECODER_OPTION_CPU_FLAGS, &uiUsedCpuFlags);
+      pDecoder->Uninitialize();
+    }
+    WelsDestroyDecoder (pDecoder);
+  }
+
+  const double kdTicksPerUs = sTotal.iTotalUs > 0 ? (double) sTotal.iTotalTicks / sTotal.iTotalUs : 0.0;
+  fprintf (pJsonFile, "{\n  \"version\": \"%s\", \"cpu_flags\": \"0x%x\", \"threads\": %d, \"slice_threads\": %d,"
+           " \"skip\": %d, \"preview\": %d, \"runs\": %d, \"peak_memory_kb\": %lld,\n", VERSION_NUMBER, uiUsedCpuFlags,
+           sParam.iThreadNum, sParam.iSliceThreading, sParam.iSkipMode, sParam.bFastPreview ? 1 : 0, sParam.iRepeatNum,
+           (long long)PeakMemoryKb());
+  if (sParam.pPicPool != NULL) {
+    SPicturePoolStatistics sPoolStats;
+    WelsGetPicturePoolStatistics (sParam.pPicPool, &sPoolStats);
+    fprintf (pJsonFile, "  \"pool\": {\"hits\": %u, \"misses\": %u, \"buffers\": %d, \"peak_in_use\": %d, \"bytes\": %llu},\n",
+             sPoolStats.uiHits, sPoolStats.uiMisses, sPoolStats.iNumBuffers, sPoolStats.iPeakBuffersInUse,
+             sPoolStats.uiMemoryBytes);
+    WelsDestroyPicturePool (sParam.pPicPool);
+  }
+  fprintf (pJsonFile, "  \"streams\": [\n");
+  for (size_t i = 0; i < vResults.size(); i++) {
+    fprintf (pJsonFile, "    ");
+    PrintJsonResult (pJsonFile, vResults[i], kdTicksPerUs);
+    fprintf (pJsonFile, i + 1 < vResults.size() ? ",\n" : "\n");
+  }
+  fprintf (pJsonFile, "  ],\n  \"total\": ");
+  PrintJsonResult (pJsonFile, sTotal, kdTicksPerUs);
+  fprintf (pJsonFile, "\n}\n");
+  if (pJsonFile != stdout)
+    fclose (pJsonFile);
+  return 0;
+}
@@ -0,0 +1,16 @@
+DECBENCH_SRCDIR=codec/console/decbench
+DECBENCH_CPP_SRCS=\
+	$(DECBENCH_SRCDIR)/src/decbench.cpp\
+
+DECBENCH_OBJS += $(DECBENCH_CPP_SRCS:.cpp=.$(OBJ))
+
+OBJS += $(DECBENCH_OBJS)
+
+$(DECBENCH_SRCDIR)/%.$(OBJ): $(DECBENCH_SRCDIR)/%.cpp
+	$(QUIET_CXX)$(CXX) $(CFLAGS) $(CXXFLAGS) $(INCLUDES) $(DECBENCH_CFLAGS) $(DECBENCH_INCLUDES) -c $(CXX_O) $<
+
+decbench$(EXEEXT): $(DECBENCH_OBJS) $(DECBENCH_DEPS)
+	$(QUIET_CXX)$(CXX) $(CXX_LINK_O) $(DECBENCH_OBJS) $(DECBENCH_LDFLAGS) $(LDFLAGS)
+
+binaries: decbench$(EXEEXT)
+BINARIES += decbench$(EXEEXT)
@@ -277,6 +277,8 @@ int ParseConfig (CReadConfig& cRdCfg, SSourcePicture* pSrcPic, SEncParamExt& pSv
         pSvcParam.iEntropyCodingModeFlag = (atoi (strTag[1].c_str()) != 0);
       } else if (strTag[0].compare ("ComplexityMode") == 0) {
         pSvcParam.iComplexityMode = (ECOMPLEXITY_MODE) (atoi (strTag[1].c_str()));
+      } else if (strTag[0].compare ("HierarchicalMeLevels") == 0) {
+        pSvcParam.iHierarchicalMeLevels = atoi (strTag[1].c_str());
       } else if (strTag[0].compare ("LoopFilterDisableIDC") == 0) {
         pSvcParam.iLoopFilterDisableIdc = (int8_t)atoi (strTag[1].c_str());
         if (pSvcParam.iLoopFilterDisableIdc > 6 || pSvcParam.iLoopFilterDisableIdc < 0) {
@@ -305,6 +307,8 @@ int ParseConfig (CReadConfig& cRdCfg, SSourcePicture* pSrcPic, SEncParamExt& pSv
           pSvcParam.iMultipleThreadIdc = MAX_THREADS_NUM;
       } else if (strTag[0].compare ("UseLoadBalancing") == 0) {
         pSvcParam.bUseLoadBalancing = (atoi (strTag[1].c_str())) ? true : false;
+      } else if (strTag[0].compare ("UseWavefront") == 0) {
+        pSvcParam.bUseWavefront = (atoi (strTag[1].c_str())) ? true : false;
       } else if (strTag[0].compare ("RCMode") == 0) {
         pSvcParam.iRCMode = (RC_MODES) atoi (strTag[1].c_str());
       } else if (strTag[0].compare ("TargetBitrate") == 0) {
@@ -404,6 +408,7 @@ void PrintHelp() {
   printf ("  -spsid       SPS/PPS id strategy: 0:const, 1: increase, 2: sps list, 3: sps list and pps increase, 4: sps/pps list\n");
   printf ("  -cabac       Entropy coding mode(0:cavlc 1:cabac \n");
   printf ("  -complexity  Complexity mode (default: 0),0: low complexity, 1: medium complexity, 2: high complexity\n");
+  printf ("  -hme         Hierarchical motion estimation levels (default: 0), 0: off, 1: half resolution, 2: half and quarter resolution\n");
   printf ("  -denois      Control denoising  (default: 0)\n");
   printf ("  -scene       Control scene change detection (default: 0)\n");
   printf ("  -bgd         Control background detection (default: 0)\n");
@@ -413,6 +418,7 @@ void PrintHelp() {
   printf ("  -ltrper      Control the long term reference marking period \n");
   printf ("  -threadIdc   0: auto(dynamic imp. internal encoder); 1: multiple threads imp. disabled; > 1: count number of threads \n");
   printf ("  -loadbalancing   0: turn off loadbalancing between slices when multi-threading available; 1: (default value) turn on loadbalancing between slices when multi-threading available\n");
+  printf ("  -wavefront   1: with a single slice, the threads of -threadIdc decide the modes of the MB rows in wavefront order (rc off or buffer based rc only); 0: (default value) off\n");
   printf ("  -deblockIdc  Loop filter idc (0: on, 1: off, \n");
   printf ("  -alphaOffset AlphaOffset(-6..+6): valid range \n");
   printf ("  -betaOffset  BetaOffset (-6..+6): valid range\n");
@@ -509,6 +515,9 @@ int ParseCommandLine (int argc, char** argv, SSourcePicture* pSrcPic, SEncParamE
     else if (!strcmp (pCommand, "-complexity") && (n < argc))
       pSvcParam.iComplexityMode = (ECOMPLEXITY_MODE)atoi (argv[n++]);
 
+    else if (!strcmp (pCommand, "-hme") && (n < argc))
+      pSvcParam.iHierarchicalMeLevels = atoi (argv[n++]);
+
     else if (!strcmp (pCommand, "-denois") && (n < argc))
       pSvcParam.bEnableDenoise = atoi (argv[n++]) ? true : false;
 
@@ -537,6 +546,8 @@ int ParseCommandLine (int argc, char** argv, SSourcePicture* pSrcPic, SEncParamE
       pSvcParam.iMultipleThreadIdc = atoi (argv[n++]);
     else if (!strcmp (pCommand, "-loadbalancing") && (n + 1 < argc)) {
       pSvcParam.bUseLoadBalancing = (atoi (argv[n++])) ? true : false;
+    } else if (!strcmp (pCommand, "-wavefront") && (n < argc)) {
+      pSvcParam.bUseWavefront = (atoi (argv[n++])) ? true : false;
     } else if (!strcmp (pCommand, "-deblockIdc") && (n < argc))
       pSvcParam.iLoopFilterDisableIdc = atoi (argv[n++]);
 
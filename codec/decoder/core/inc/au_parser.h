@@ -64,6 +64,21 @@ namespace WelsDec {
  */
 uint8_t* DetectStartCodePrefix (const uint8_t* kpBuf, int32_t* pOffset, int32_t iBufSize);
 
+/*!
+ *************************************************************************************
+ * \brief   Start code / emulation prevention detection (0x 00 00 0x, x <= 3)
+ *
+ * \param   kpBuf       bitstream payload buffer
+ * \param   iBufSize    count size of buffer
+ *
+ * \return  offset of the first 0x 00 00 0x sequence lying completely in the buffer,
+ *          iBufSize if there is none, so that the bytes before it can be copied as they are
+ *
+ * \note    scans a machine word at a time, words without zero byte are skipped at once
+ *************************************************************************************
+ */
+int32_t DetectStartCodeOrEscape (const uint8_t* kpBuf, int32_t iBufSize);
+
 /*!
  *************************************************************************************
  * \brief   to parse network abstraction layer unit,
@@ -193,6 +208,25 @@ int32_t ParseSei (void* pSei, PBitStringAux pBsAux); // reserved Sei_Msg type
  */
 int32_t ResetFmoList (PWelsDecoderContext pCtx);
 
+/*!
+ *************************************************************************************
+ * \brief   index the access units of an Annex B bitstream from the NAL unit headers, the parameter sets
+ *          and the slice headers up to the picture order count syntax, slice data is not parsed
+ *
+ * \param   kpSrc           bitstream
+ * \param   kiSrcLen        size of the bitstream in bytes
+ * \param   pIndex          first kiMaxEntries access units of the bitstream are output, NULL to count them only
+ * \param   kiMaxEntries    entries of pIndex
+ *
+ * \return  count of access units in the bitstream, negative on invalid parameters
+ *
+ * \note    access unit boundaries follow 7.4.1.2.4 on the base layer slices, the picture order count
+ *          follows 8.2.1 except for memory_management_control_operation 5, which is not parsed
+ *************************************************************************************
+ */
+int32_t IndexAccessUnits (const uint8_t* kpSrc, const int64_t kiSrcLen, SAccessUnitIndex* pIndex,
+                          const int32_t kiMaxEntries);
+
 } // namespace WelsDec
 
 #endif//WELS_ACCESS_UNIT_PARSER_H__
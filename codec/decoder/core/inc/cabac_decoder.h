@@ -78,6 +78,19 @@ static const uint8_t g_kRenormTable256[256] = {
   1, 1, 1, 1, 1, 1, 1, 1
 };
 
+// renormalization shift of any range below 512 indexed by uiRange >> 3, i.e. the leading zero count
+// of the 9 bit range. Ranges below 8 only occur as LPS ranges >= 6, which take the shift of 6.
+static const uint8_t g_kRenormTable512[64] = {
+  6, 5, 4, 4, 3, 3, 3, 3,
+  2, 2, 2, 2, 2, 2, 2, 2,
+  1, 1, 1, 1, 1, 1, 1, 1,
+  1, 1, 1, 1, 1, 1, 1, 1,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0
+};
+
 
 //1. CABAC context initialization
 void WelsCabacGlobalInit(PWelsDecoderContext pCabacCtx);
@@ -101,6 +114,13 @@ int32_t DecodeExpBypassCabac (PWelsCabacDecEngine pDecEngine, int32_t iCount, ui
 uint32_t DecodeUEGLevelCabac (PWelsCabacDecEngine pDecEngine, PWelsCabacCtx pBinCtx, uint32_t& uiBinVal);
 int32_t DecodeUEGMvCabac (PWelsCabacDecEngine pDecEngine, PWelsCabacCtx pBinCtx, uint32_t iMaxC,  uint32_t& uiCode);
 
+//6. residual block parsing: significance map and levels of a block in one go, with the engine state kept in
+//   registers across all of its bins. pCoeff is expected to be zeroed, only the significant positions are written.
+int32_t DecodeResidualCoeffsCabac (PWelsCabacDecEngine pDecEngine, PWelsCabacCtx pMapCtx, PWelsCabacCtx pLastCtx,
+                                   PWelsCabacCtx pOneCtx, PWelsCabacCtx pAbsCtx, const uint8_t* pMapCtxIdx,
+                                   const uint8_t* pLastCtxIdx, int32_t iMaxPos, int32_t iMaxC2, int32_t* pCoeff,
+                                   uint32_t& uiCoeffNum);
+
 #define WELS_CABAC_HALF    0x01FE
 #define WELS_CABAC_QUARTER 0x0100
 #define WELS_CABAC_FALSE_RETURN(iErrorInfo) \
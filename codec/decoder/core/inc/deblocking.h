@@ -66,6 +66,12 @@ void  DeblockingInit (PDeblockingFunc pDeblockingFunc,  int32_t iCpu);
  */
 void WelsDeblockingFilterSlice (PWelsDecoderContext pCtx, PDeblockingFilterMbFunc pDeblockMb);
 
+/*!
+ * \brief   deblocking MBs iFirstMbXy..iLastMbXy of the current slice in raster order (no FMO)
+ */
+void WelsDeblockingFilterMbRange (PWelsDecoderContext pCtx, PDeblockingFilterMbFunc pDeblockMb, int32_t iFirstMbXy,
+                                  int32_t iLastMbXy);
+
 /*!
  * \brief   pixel deblocking filtering
  *
@@ -86,6 +92,30 @@ void DeblockingInterMb (PDqLayer pCurDqLayer, PDeblockingFilter  pFilter, uint8_
 
 void WelsDeblockingMb (PDqLayer pCurDqLayer, PDeblockingFilter  pFilter, int32_t iBoundryFlag);
 
+#define MAX_DEBLOCKING_BS_MB_NUM 64
+
+/*!
+ * \brief   boundary strengths and filter availability of a MB, as WelsDeblockingMb() uses them
+ */
+typedef struct TagDeblockingMbBs {
+  uint8_t nBS[2][4][4];   // not set for intra MBs
+  int32_t iBoundryFlag;
+} SDeblockingMbBs, *PDeblockingMbBs;
+
+/*!
+ * \brief   compute the boundary strengths of iMbNum MBs from iFirstMbXy on, all in one MB row.
+ *          They only depend on parsed syntax, so this is done in one pass before any of the MBs is filtered.
+ */
+void DeblockingBsCalcMbRow (PDqLayer pCurDqLayer, int32_t iFilterIdc, int32_t iFirstMbXy, int32_t iMbNum,
+                            PDeblockingMbBs pMbBs);
+
+/*!
+ * \brief   same as WelsDeblockingMb() on iMbNum MBs from iFirstMbXy on, all in one MB row,
+ *          with the boundary strengths computed by DeblockingBsCalcMbRow() in batches
+ */
+void WelsDeblockingMbRow (PDqLayer pCurDqLayer, PDeblockingFilter pFilter, int32_t iFilterIdc, int32_t iFirstMbXy,
+                          int32_t iMbNum);
+
 } // namespace WelsDec
 
 #endif //WELS_DEBLOCKING_H__
@@ -34,9 +34,24 @@
 #define WELS_DECODE_SLICE_H__
 
 #include "decoder_context.h"
+#include "measure_time.h"
 
 namespace WelsDec {
 
+/*
+ *  stage timing, see DECODER_OPTION_STAGE_TIMING: WelsStageEnd() adds the ticks since WelsStageStart() to keStage
+ */
+static inline int64_t WelsStageStart (PWelsDecoderContext pCtx) {
+  return pCtx->bStageTiming ? WelsTicks() : 0;
+}
+
+static inline void WelsStageEnd (PWelsDecoderContext pCtx, const DECODER_STAGE keStage, int64_t iStart) {
+  if (pCtx->bStageTiming) {
+    pCtx->sStageTiming.uiTicks[keStage] += WelsTicks() - iStart;
+    pCtx->sStageTiming.uiCount[keStage]++;
+  }
+}
+
 int32_t WelsActualDecodeMbCavlcISlice (PWelsDecoderContext pCtx);
 int32_t WelsDecodeMbCavlcISlice (PWelsDecoderContext pCtx, PNalUnit pNalCur, uint32_t& uiEosFlag);
 
@@ -51,6 +66,12 @@ int32_t WelsDecodeMbCabacPSliceBaseMode0(PWelsDecoderContext pCtx, PWelsNeighAva
 
 int32_t WelsTargetSliceConstruction (PWelsDecoderContext pCtx); //construction based on slice
 
+/*!
+ * \brief   pad the borders of the finished pCtx->pDec for reference,
+ *          skipping the MB rows the row pipeline of WelsTargetSliceConstruction() already padded
+ */
+void WelsExpandDecodedPicture (PWelsDecoderContext pCtx);
+
 int32_t WelsDecodeSlice (PWelsDecoderContext pCtx, bool bFirstSliceInLayer, PNalUnit pNalCur);
 
 int32_t WelsTargetMbConstruction (PWelsDecoderContext pCtx);
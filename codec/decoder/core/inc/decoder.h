@@ -149,6 +149,10 @@ void GetVclNalTemporalId (PWelsDecoderContext pCtx); //get the info that whether
 
 //reset decoder number related statistics info
 void ResetDecStatNums (SDecoderStatistics* pDecStat);
+//reset the stage timing, see DECODER_OPTION_STAGE_TIMING
+void ResetDecStageTiming (SDecStageTiming* pTiming);
+//stage timing as returned by DECODER_OPTION_GET_STAGE_STATISTICS
+void GetDecStageStatistics (const SDecStageTiming* kpTiming, SDecoderStageStatistics* pStatistics);
 //update information when freezing occurs, including IDR/non-IDR number
 void UpdateDecStatFreezingInfo (const bool kbIdrFlag, SDecoderStatistics* pDecStat);
 //update information when no freezing occurs, including QP, correct IDR number, ECed IDR number
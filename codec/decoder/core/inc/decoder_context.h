@@ -123,6 +123,15 @@ typedef struct TagPpsBsInfo {
   int32_t iPpsId;
   uint16_t uiPpsBsLen;
 } SPpsBsInfo;
+
+// cost of the decoding stages, see DECODER_OPTION_STAGE_TIMING
+typedef struct TagDecStageTiming {
+  uint64_t uiTicks[DECODER_STAGE_NUM];  // WelsTicks() units
+  uint64_t uiCount[DECODER_STAGE_NUM];
+  uint64_t uiParsedMbCount;
+  int64_t iStartTicks;                  // WelsTicks() and WelsTime() when reset, to convert ticks to nanoseconds
+  int64_t iStartUs;
+} SDecStageTiming;
 //#ifdef __cplusplus
 //extern "C" {
 //#endif//__cplusplus
@@ -137,6 +146,7 @@ typedef struct TagPpsBsInfo {
 typedef void (*PGetIntraPredFunc) (uint8_t* pPred, const int32_t kiLumaStride);
 typedef void (*PIdctResAddPredFunc) (uint8_t* pPred, const int32_t kiStride, int16_t* pRs);
 typedef void (*PIdctFourResAddPredFunc) (uint8_t* pPred, int32_t iStride, int16_t* pRs, const int8_t* pNzc);
+typedef void (*PIdctFourRecFunc) (uint8_t* pRec, int32_t iStride, uint8_t* pPred, int32_t iPredStride, int16_t* pRs);
 typedef void (*PExpandPictureFunc) (uint8_t* pDst, const int32_t kiStride, const int32_t kiPicWidth,
                                     const int32_t kiPicHeight);
 
@@ -227,6 +237,40 @@ enum {
   OVERWRITE_SUBSETSPS = 1 << 2
 };
 
+/*
+ *  SMbBuffer: per-MB syntax elements and residuals of the picture being decoded
+ */
+typedef struct TagMbBuffer {
+  int16_t*  pMbType[LAYER_NUM_EXCHANGEABLE];                      /* mb type */
+  int16_t (*pMv[LAYER_NUM_EXCHANGEABLE][LIST_A])[MB_BLOCK4x4_NUM][MV_A]; //[LAYER_NUM_EXCHANGEABLE   MB_BLOCK4x4_NUM*]
+  int8_t (*pRefIndex[LAYER_NUM_EXCHANGEABLE][LIST_A])[MB_BLOCK4x4_NUM];
+  bool*   pNoSubMbPartSizeLessThan8x8Flag[LAYER_NUM_EXCHANGEABLE];
+  bool*   pTransformSize8x8Flag[LAYER_NUM_EXCHANGEABLE];
+  int8_t* pLumaQp[LAYER_NUM_EXCHANGEABLE];        /*mb luma_qp*/
+  int8_t  (*pChromaQp[LAYER_NUM_EXCHANGEABLE])[2];                                        /*mb chroma_qp*/
+  int16_t (*pMvd[LAYER_NUM_EXCHANGEABLE][LIST_A])[MB_BLOCK4x4_NUM][MV_A]; //[LAYER_NUM_EXCHANGEABLE   MB_BLOCK4x4_NUM*]
+  uint16_t* pCbfDc[LAYER_NUM_EXCHANGEABLE];
+  int8_t  (*pNzc[LAYER_NUM_EXCHANGEABLE])[24];
+  int8_t  (*pNzcRs[LAYER_NUM_EXCHANGEABLE])[24];
+  int16_t (*pScaledTCoeff[LAYER_NUM_EXCHANGEABLE])[MB_COEFF_LIST_SIZE]; /*need be aligned*/
+  int8_t  (*pIntraPredMode[LAYER_NUM_EXCHANGEABLE])[8]; //0~3 top4x4 ; 4~6 left 4x4; 7 intra16x16
+  int8_t (*pIntra4x4FinalMode[LAYER_NUM_EXCHANGEABLE])[MB_BLOCK4x4_NUM];
+  uint8_t* pIntraNxNAvailFlag[LAYER_NUM_EXCHANGEABLE];
+  int8_t*  pChromaPredMode[LAYER_NUM_EXCHANGEABLE];
+  int8_t*  pCbp[LAYER_NUM_EXCHANGEABLE];
+  uint8_t (*pMotionPredFlag[LAYER_NUM_EXCHANGEABLE][LIST_A])[MB_PARTITION_SIZE]; // 8x8
+  int8_t (*pSubMbType[LAYER_NUM_EXCHANGEABLE])[MB_SUB_PARTITION_SIZE];
+  int32_t* pSliceIdc[LAYER_NUM_EXCHANGEABLE];         // using int32_t for slice_idc
+  int8_t*  pResidualPredFlag[LAYER_NUM_EXCHANGEABLE];
+  int8_t*  pInterPredictionDoneFlag[LAYER_NUM_EXCHANGEABLE];
+  bool*    pMbCorrectlyDecodedFlag[LAYER_NUM_EXCHANGEABLE];
+  bool*    pMbRefConcealedFlag[LAYER_NUM_EXCHANGEABLE];
+  uint32_t iMbWidth;
+  uint32_t iMbHeight;
+} SMbBuffer, *PMbBuffer;
+
+struct TagWelsDecThreadCtx;
+
 /*
  *  SWelsDecoderContext: to maintail all modules data over decoder@framework
  */
@@ -268,37 +312,12 @@ typedef struct TagWelsDecoderContext {
   int32_t
   iDecBlockOffsetArray[24];     // address talbe for sub 4x4 block in intra4x4_mb, so no need to caculta the address every time.
 
-  struct {
-    int16_t*  pMbType[LAYER_NUM_EXCHANGEABLE];                      /* mb type */
-    int16_t (*pMv[LAYER_NUM_EXCHANGEABLE][LIST_A])[MB_BLOCK4x4_NUM][MV_A]; //[LAYER_NUM_EXCHANGEABLE   MB_BLOCK4x4_NUM*]
-    int8_t (*pRefIndex[LAYER_NUM_EXCHANGEABLE][LIST_A])[MB_BLOCK4x4_NUM];
-    bool*   pNoSubMbPartSizeLessThan8x8Flag[LAYER_NUM_EXCHANGEABLE];
-    bool*   pTransformSize8x8Flag[LAYER_NUM_EXCHANGEABLE];
-    int8_t* pLumaQp[LAYER_NUM_EXCHANGEABLE];        /*mb luma_qp*/
-    int8_t  (*pChromaQp[LAYER_NUM_EXCHANGEABLE])[2];                                        /*mb chroma_qp*/
-    int16_t (*pMvd[LAYER_NUM_EXCHANGEABLE][LIST_A])[MB_BLOCK4x4_NUM][MV_A]; //[LAYER_NUM_EXCHANGEABLE   MB_BLOCK4x4_NUM*]
-    uint16_t* pCbfDc[LAYER_NUM_EXCHANGEABLE];
-    int8_t  (*pNzc[LAYER_NUM_EXCHANGEABLE])[24];
-    int8_t  (*pNzcRs[LAYER_NUM_EXCHANGEABLE])[24];
-    int16_t (*pScaledTCoeff[LAYER_NUM_EXCHANGEABLE])[MB_COEFF_LIST_SIZE]; /*need be aligned*/
-    int8_t  (*pIntraPredMode[LAYER_NUM_EXCHANGEABLE])[8]; //0~3 top4x4 ; 4~6 left 4x4; 7 intra16x16
-    int8_t (*pIntra4x4FinalMode[LAYER_NUM_EXCHANGEABLE])[MB_BLOCK4x4_NUM];
-    uint8_t* pIntraNxNAvailFlag[LAYER_NUM_EXCHANGEABLE];
-    int8_t*  pChromaPredMode[LAYER_NUM_EXCHANGEABLE];
-    int8_t*  pCbp[LAYER_NUM_EXCHANGEABLE];
-    uint8_t (*pMotionPredFlag[LAYER_NUM_EXCHANGEABLE][LIST_A])[MB_PARTITION_SIZE]; // 8x8
-    int8_t (*pSubMbType[LAYER_NUM_EXCHANGEABLE])[MB_SUB_PARTITION_SIZE];
-    int32_t* pSliceIdc[LAYER_NUM_EXCHANGEABLE];         // using int32_t for slice_idc
-    int8_t*  pResidualPredFlag[LAYER_NUM_EXCHANGEABLE];
-    int8_t*  pInterPredictionDoneFlag[LAYER_NUM_EXCHANGEABLE];
-    bool*    pMbCorrectlyDecodedFlag[LAYER_NUM_EXCHANGEABLE];
-    bool*    pMbRefConcealedFlag[LAYER_NUM_EXCHANGEABLE];
-    uint32_t iMbWidth;
-    uint32_t iMbHeight;
-  } sMb;
+  SMbBuffer                     sMb;
 
 // reconstruction picture
   PPicture                      pDec;                   //pointer to current picture being reconstructed
+  SFrameAllocator               sFrameAllocator;        // caller-supplied picture memory, pfGetBuffer is NULL without
+  SPicturePool*                 pPicPool;               // picture memory shared with other decoders, NULL without
 
 // reference pictures
   SRefPic                       sRefPic;
@@ -390,6 +409,7 @@ typedef struct TagWelsDecoderContext {
   PGetIntraPredFunc pGetIChromaPredFunc[7];             // h264_predict_8x8_t
   PIdctResAddPredFunc pIdctResAddPredFunc;
   PIdctFourResAddPredFunc pIdctFourResAddPredFunc;
+  PIdctFourRecFunc pIdctFourRecFunc;                    // 8x8 reconstruction from a separate prediction, NULL if not worth it
   SMcFunc sMcFunc;
   //Transform8x8
   PGetIntraPred8x8Func pGetI8x8LumaPredFunc[14];
@@ -433,6 +453,9 @@ typedef struct TagWelsDecoderContext {
   PWelsCabacDecEngine   pCabacDecEngine;
   double dDecTime;
   SDecoderStatistics sDecoderStatistics;// For real time debugging
+  bool bStageTiming;                    // accumulate sStageTiming, see DECODER_OPTION_STAGE_TIMING
+  SDecStageTiming sStageTiming;
+  DECODER_SKIP_MODE eSkipMode;          // pictures not decoded, see DECODER_OPTION_SKIP_FRAMES
   int32_t iMbEcedNum;
   int32_t iMbEcedPropNum;
   int32_t iMbNum;
@@ -449,6 +472,17 @@ typedef struct TagWelsDecoderContext {
   int iDequantCoeffPpsid;//When a new pps actived, reinitialised the scaling list value
   bool bDequantCoeff4x4Init;
   bool bUseScalingList;
+// For frame and slice level threading
+  struct TagWelsDecThreadCtx* pThreadCtx; // NULL when every picture is reconstructed on the calling thread
+  bool bDeferSliceRecon; // MB reconstruction and deblocking of current picture left to the frame threads
+  int32_t* pRefReadyMbRows; // frame thread contexts only: ready MB rows seen so far for each sRefPic.pRefList[LIST_0] entry
+  bool bSliceReconDone; // MBs of current slice already reconstructed by a slice thread
+// Row pipeline of serial slice reconstruction
+  int32_t iRowPipeNextMbXy; // MBs of pDec reconstructed and deblocked in raster order so far, -1 when not in raster order
+  int32_t iRowPipeExpandedRows; // MB rows of pDec already padded, valid while iRowPipeNextMbXy >= 0
+// Fast preview, see SDecodingParam::bFastPreview
+  int32_t iPreviewMvReach; // how far motion compensation of the pictures since the last one read outside the references, -1 if none
+  int32_t iPreviewPaddingLen; // margin padded around the next decoded pictures
   CMemoryAlign*     pMemAlign;
 } SWelsDecoderContext, *PWelsDecoderContext;
 
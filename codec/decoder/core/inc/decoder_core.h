@@ -108,6 +108,17 @@ int32_t InitialDqLayersContext (PWelsDecoderContext pCtx, const int32_t kiMaxWid
  */
 void UninitialDqLayersContext (PWelsDecoderContext pCtx);
 
+/*!
+ * \brief   allocate/free the per-MB arrays of layer kiIdx in a MB buffer, sized by its iMbWidth x iMbHeight
+ */
+int32_t InitialMbBuffer (CMemoryAlign* pMa, PMbBuffer pMb, const int32_t kiIdx);
+void UninitialMbBuffer (CMemoryAlign* pMa, PMbBuffer pMb, const int32_t kiIdx);
+
+/*!
+ * \brief   point the per-MB arrays of a dq layer to pCtx->sMb
+ */
+void InitCurDqLayerData (PWelsDecoderContext pCtx, PDqLayer pCurDq);
+
 /*
  *  DecodeNalHeaderExt
  *  Trigger condition: NAL_UNIT_TYPE = NAL_UNIT_PREFIX or NAL_UNIT_CODED_SLICE_EXT
@@ -122,6 +133,12 @@ void DecodeNalHeaderExt (PNalUnit pNal, uint8_t* pSrc);
  *  Parse slice header of bitstream
  */
 int32_t ParseSliceHeaderSyntaxs (PWelsDecoderContext pCtx, PBitStringAux pBs, const bool kbExtensionFlag);
+
+/*
+ *  ParseSliceHeaderPicIdSyntaxs
+ *  Parse slice header from frame_num to redundant_pic_cnt, pSps, pPps, bIdrFlag and bFieldPicFlag of pSliceHead set
+ */
+int32_t ParseSliceHeaderPicIdSyntaxs (PWelsDecoderContext pCtx, PBitStringAux pBs, PSliceHeader pSliceHead);
 /*
  *  Copy relative syntax elements of NALUnitHeaderExt, sRefPicBaseMarking and bStoreRefBasePicFlag in prefix nal unit.
  *  pSrc:   mark as decoded prefix NAL
@@ -151,6 +168,16 @@ int32_t ConstructAccessUnit (PWelsDecoderContext pCtx, uint8_t** ppDst, SBufferI
  */
 int32_t DecodeCurrentAccessUnit (PWelsDecoderContext pCtx, uint8_t** ppDst, SBufferInfo* pDstInfo);
 
+/*
+ * WelsDecodeSliceFinish
+ * Complete decoding of the slice in pCtx->pCurDqLayer, whose MBs were parsed with result iRet:
+ * error handling, reconstruction and check of the reference pictures used.
+ * return:
+ *  0 - success; otherwise the error that stops decoding of current access unit.
+ */
+int32_t WelsDecodeSliceFinish (PWelsDecoderContext pCtx, PNalUnit pNalCur, int32_t iRet, bool bReconstructSlice,
+                               bool* pAllRefComplete);
+
 /*
  * Check if frame is completed and EC is required
  */
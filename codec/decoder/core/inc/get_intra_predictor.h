@@ -91,6 +91,14 @@ void WelsI16x16LumaPredDcTop_c (uint8_t* pPred, const int32_t kiStride);
 void WelsI16x16LumaPredDcLeft_c (uint8_t* pPred, const int32_t kiStride);
 void WelsI16x16LumaPredDcNA_c (uint8_t* pPred, const int32_t kiStride);
 
+/*!
+ * \brief  the row repeated over the 16 rows of the I16x16 prediction in kiMode, so that the
+ *         residual can be added to it without predicting the block first
+ * \return pPred - kiStride for the vertical mode, pRow filled with the mean for the dc modes,
+ *         NULL for the horizontal and plane modes
+ */
+uint8_t* WelsI16x16LumaPredRow (uint8_t* pPred, const int32_t kiStride, const int8_t kiMode, uint8_t* pRow);
+
 #if defined(__cplusplus)
 extern "C" {
 #endif//__cplusplus
@@ -118,6 +126,17 @@ void WelsDecoderI4x4LumaPredHU_mmx (uint8_t* pPred, const int32_t kiStride);
 void WelsDecoderI4x4LumaPredVR_mmx (uint8_t* pPred, const int32_t kiStride);
 void WelsDecoderI4x4LumaPredDDL_mmx (uint8_t* pPred, const int32_t kiStride);
 void WelsDecoderI4x4LumaPredVL_mmx (uint8_t* pPred, const int32_t kiStride);
+
+#if defined(HAVE_AVX2)
+void WelsDecoderI16x16LumaPredPlane_avx2 (uint8_t* pPred, const int32_t kiStride);
+void WelsDecoderI16x16LumaPredH_avx2 (uint8_t* pPred, const int32_t kiStride);
+void WelsDecoderI16x16LumaPredDc_avx2 (uint8_t* pPred, const int32_t kiStride);
+void WelsDecoderI16x16LumaPredDcTop_avx2 (uint8_t* pPred, const int32_t kiStride);
+
+void WelsDecoderIChromaPredPlane_avx2 (uint8_t* pPred, const int32_t kiStride);
+void WelsDecoderIChromaPredH_avx2 (uint8_t* pPred, const int32_t kiStride);
+void WelsDecoderIChromaPredDc_avx2 (uint8_t* pPred, const int32_t kiStride);
+#endif//HAVE_AVX2
 #endif//X86_ASM
 
 #if defined(HAVE_NEON)
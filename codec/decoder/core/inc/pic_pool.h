@@ -0,0 +1,70 @@
+/*!
+ * \copy
+ *     Copyright (c)  2013, Cisco Systems
+ *     All rights reserved.
+ *
+ *     Redistribution and use in source and binary forms, with or without
+ *     modification, are permitted provided that the following conditions
+ *     are met:
+ *
+ *        * Redistributions of source code must retain the above copyright
+ *          notice, this list of conditions and the following disclaimer.
+ *
+ *        * Redistributions in binary form must reproduce the above copyright
+ *          notice, this list of conditions and the following disclaimer in
+ *          the documentation and/or other materials provided with the
+ *          distribution.
+ *
+ *     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *     "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *     LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *     FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *     COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *     INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *     BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *     LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *     CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *     LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *     ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *     POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \file    pic_pool.h
+ *
+ * \brief   picture memory shared by decoders, re-carved when the resolution changes
+ *
+ *************************************************************************************
+ */
+
+#ifndef WELS_PICTURE_POOL_H__
+#define WELS_PICTURE_POOL_H__
+
+#include "typedefs.h"
+#include "codec_app_def.h"
+
+namespace WelsDec {
+
+/*
+ *  size of the buffer holding a picture of kiWidth x kiHeight, as carved by AllocPicture()
+ */
+int32_t GetPicPoolBufferSize (const int32_t kiWidth, const int32_t kiHeight);
+
+/*
+ *  the pool is reference counted: by its creator, by every decoder using it and by every buffer in use,
+ *  it is freed when the last reference is released, on any thread
+ */
+SPicturePool* CreatePicPool (const SPicturePoolParam* pParam);
+void AddRefPicPool (SPicturePool* pPool);
+void ReleasePicPool (SPicturePool* pPool);
+
+/*
+ *  a free buffer of the pool, or a new one when there is none or kiSize is larger than the buffers of the pool
+ *  return NULL when out of memory
+ */
+uint8_t* GetPicPoolBuffer (SPicturePool* pPool, const int32_t kiSize);
+void ReleasePicPoolBuffer (SPicturePool* pPool, uint8_t* pBuf);
+
+void GetPicPoolStatistics (SPicturePool* pPool, SPicturePoolStatistics* pStats);
+
+} // namespace WelsDec
+
+#endif//WELS_PICTURE_POOL_H__
@@ -54,6 +54,32 @@ int32_t        iCurrentIdx;
 
 PPicture PrefetchPic (PPicBuff pPicBuff);  // To get current node applicable
 
+/*
+ *  before a picture from PrefetchPic() is decoded: with a frame allocator, release its buffer
+ *  which the application may still hold, and get a new one from the allocator
+ */
+int32_t RenewPicBuffer (struct TagWelsDecoderContext* pCtx, PPicture pPic);
+
+/*
+ *  ERROR_CON_FRAME_COPY_CROSS_IDR_ALIAS: let pPic, just renewed, share the planes of pSrc instead of
+ *  copying them. The planes are copied only once either picture is renewed. Return false when they
+ *  cannot be shared: frame threads, frame allocator or different sizes.
+ */
+bool AliasPicture (struct TagWelsDecoderContext* pCtx, PPicture pPic, PPicture pSrc);
+
+/*
+ *  copy the shared planes into every aliasing picture, before the picture queue changes
+ */
+void MaterializeAliasedPics (struct TagWelsDecoderContext* pCtx);
+
+/*
+ *  reference counted picture memory behind DECODER_OPTION_HOLD_OUTPUT. The buffers do not depend on
+ *  the decoder context, every holder drops its reference with ReleaseHeldPicBuffer(), on any thread.
+ */
+void InitHeldPicAllocator (SFrameAllocator* pAllocator);
+void AddRefHeldPicBuffer (void* pBuffer);
+void ReleaseHeldPicBuffer (void* pBuffer);
+
 } // namespace WelsDec
 
 #endif//WELS_PICTURE_QUEUE_H__
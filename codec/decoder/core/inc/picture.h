@@ -35,9 +35,13 @@
 #define WELS_PICTURE_H__
 
 #include "typedefs.h"
+#include "codec_app_def.h"
+#include "WelsThreadLib.h"
 
 namespace WelsDec {
 
+#define PIC_READY_ALL   0x7fffffff
+
 /*
  *  Reconstructed Picture definition
  *  It is used to express reference picture, also consequent reconstruction picture for output
@@ -48,6 +52,11 @@ uint8_t*        pBuffer[4];             // pointer to the first allocated byte,
 uint8_t*        pData[4];               // pointer to picture planes respectively
 int32_t         iLinesize[4];// linesize of picture planes respectively used currently
 int32_t         iPlanes;                        // How many planes are introduced due to color space format?
+void*           pUserBuffer;            // buffer from sAllocator pBuffer[0] lies in, NULL when allocated by the decoder
+SFrameAllocator sAllocator;             // frame allocator pUserBuffer is to be released to
+SPicturePool*   pPicPool;               // picture pool pBuffer[0] is to be released to, NULL when allocated by the decoder
+struct TagPicture* pAliasSrc;           // picture whose planes pData points to instead of pBuffer, from frame copy EC
+int32_t         iAliasNum;              // number of pictures with pAliasSrc pointing to this one
 // picture information
 
 /*******************************from EC mv copy****************************/
@@ -57,6 +66,7 @@ bool bIdrFlag;
 /*from sps*/
 int32_t         iWidthInPixel;  // picture width in pixel
 int32_t         iHeightInPixel;// picture height in pixel
+int32_t         iPaddingLen;    // luma margin padded around the picture, PADDING_LENGTH but in fast preview
 /*from slice header*/
 int32_t         iFramePoc;              // frame POC
 
@@ -82,6 +92,11 @@ bool bNewSeqBegin;
 int32_t iMbEcedNum;
 int32_t iMbEcedPropNum;
 int32_t iMbNum;
+
+/*******************************for frame level threading****************************/
+int32_t         iReadyMbRows;   // MB rows already reconstructed, deblocked and padded, PIC_READY_ALL once finished
+WELS_MUTEX      hReadyMutex;
+WELS_COND       hReadyCond;     // signalled whenever iReadyMbRows grows
 } SPicture, *PPicture; // "Picture" declaration is comflict with Mac system
 
 } // namespace WelsDec
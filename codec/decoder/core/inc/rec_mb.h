@@ -65,11 +65,24 @@ typedef struct TagMCRefMember {
 
   int32_t iPicWidth;
   int32_t iPicHeight;
+
+  PPicture pRefPic;
+  int32_t* pRefReadyRows; // MB rows of pRefPic known to be ready, NULL if the reference is always complete
+  int32_t* pMvReach;      // fast preview: how far blocks read outside the reference, which is padded that far on
+                          // demand. NULL if the references are fully padded
+  PExpandPictureLinesFunc pfExpandPreviewLines; // pads the widened margin, set with pMvReach
 } sMCRefMember;
 
 void BaseMC (sMCRefMember* pMCRefMem, int32_t iXOffset, int32_t iYOffset, SMcFunc* pMCFunc,
                            int32_t iBlkWidth, int32_t iBlkHeight, int16_t iMVs[2]);
 
+/*!
+ * \brief  chroma motion compensation of the fast preview: the eighth pel vector is rounded to the
+ *         nearest whole pel and the block is copied, not interpolated
+ */
+void McChromaFullPel (const uint8_t* pSrc, int32_t iSrcStride, uint8_t* pDst, int32_t iDstStride,
+                      int16_t iMvX, int16_t iMvY, int32_t iWidth, int32_t iHeight);
+
 void WelsFillRecNeededMbInfo (PWelsDecoderContext pCtx, bool bOutput, PDqLayer pCurLayer);
 
 int32_t RecI4x4Mb (int32_t iMBXY, PWelsDecoderContext pCtx, int16_t* pScoeffLevel, PDqLayer pDqLayer);
@@ -101,6 +101,9 @@ extern const uint8_t g_kuiZeroLeftTable4[8][2];
 extern const uint8_t g_kuiZeroLeftTable5[8][2];
 extern const uint8_t g_kuiZeroLeftTable6[8][2];
 extern const uint8_t g_kuiZeroLeftBitNumMap[16];
+extern const int8_t g_kiCavlcLevelTable[7][256][2];
+extern const int8_t g_kiCavlcFirstLevelTable[2][256][2];
+extern const uint32_t g_kuiCavlcRunBeforeTable[6][256];
 
 #if defined(_MSC_VER) && defined(_M_IX86)
 //TODO need linux version
@@ -0,0 +1,84 @@
+/*!
+ * \copy
+ *     Copyright (c)  2013, Cisco Systems
+ *     All rights reserved.
+ *
+ *     Redistribution and use in source and binary forms, with or without
+ *     modification, are permitted provided that the following conditions
+ *     are met:
+ *
+ *        * Redistributions of source code must retain the above copyright
+ *          notice, this list of conditions and the following disclaimer.
+ *
+ *        * Redistributions in binary form must reproduce the above copyright
+ *          notice, this list of conditions and the following disclaimer in
+ *          the documentation and/or other materials provided with the
+ *          distribution.
+ *
+ *     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *     "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *     LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *     FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *     COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *     INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *     BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *     LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *     CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *     LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *     ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *     POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \file    wels_decoder_scheduler.h
+ *
+ * \brief   access units of many decoders decoded on the workers of the shared thread pool,
+ *          with a fair share of the workers for each decoder
+ *
+ * \date    10/18/2026 Created
+ *
+ *************************************************************************************
+ */
+
+#ifndef WELS_DECODER_SCHEDULER_H__
+#define WELS_DECODER_SCHEDULER_H__
+
+#include "typedefs.h"
+#include "codec_app_def.h"
+
+namespace WelsDec {
+
+#define MAX_DEC_SCHED_WORKER_NUM   64
+
+typedef struct TagDecSchedClient SDecSchedClient;
+
+/*
+ *  decodes one access unit of the client on a worker, kpSrc is NULL for a flush request
+ */
+typedef void (*PDecSchedRunFunc) (void* pArg, const uint8_t* kpSrc, const int32_t kiSrcLen, uint64_t uiTimeStamp);
+
+/*
+ *  the first client takes a reference on the thread pool, sized to the number of logical processors when
+ *  nobody else uses it yet, the last one to leave gives it back
+ *  return NULL when out of memory
+ */
+SDecSchedClient* WelsDecSchedJoin (PDecSchedRunFunc pfRun, void* pArg, int32_t iWeight);
+void WelsDecSchedLeave (SDecSchedClient* pClient);
+
+void WelsDecSchedSetWeight (SDecSchedClient* pClient, int32_t iWeight);
+
+/*
+ *  queue a copy of the access unit, it is run after the ones queued before
+ *  return ERR_NONE, or ERR_INFO_OUT_OF_MEMORY
+ */
+int32_t WelsDecSchedSubmit (SDecSchedClient* pClient, const uint8_t* kpSrc, const int32_t kiSrcLen,
+                            uint64_t uiTimeStamp);
+
+/*
+ *  wait until the access units queued have been run, must not be called from the run function
+ */
+void WelsDecSchedWait (SDecSchedClient* pClient);
+
+void WelsDecSchedGetStatistics (SDecSchedClient* pClient, SDecoderSchedulingStatistics* pStats);
+
+} // namespace WelsDec
+
+#endif//WELS_DECODER_SCHEDULER_H__
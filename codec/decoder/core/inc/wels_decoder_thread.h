@@ -0,0 +1,150 @@
+/*!
+ * \copy
+ *     Copyright (c)  2009-2013, Cisco Systems
+ *     All rights reserved.
+ *
+ *     Redistribution and use in source and binary forms, with or without
+ *     modification, are permitted provided that the following conditions
+ *     are met:
+ *
+ *        * Redistributions of source code must retain the above copyright
+ *          notice, this list of conditions and the following disclaimer.
+ *
+ *        * Redistributions in binary form must reproduce the above copyright
+ *          notice, this list of conditions and the following disclaimer in
+ *          the documentation and/or other materials provided with the
+ *          distribution.
+ *
+ *     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *     "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *     LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *     FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *     COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *     INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *     BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *     LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *     CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *     LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *     ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *     POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * \file    wels_decoder_thread.h
+ *
+ * \brief   frame and slice level threading of the decoder.
+ *          Frame threading: slices are parsed on the calling thread, while MB reconstruction,
+ *          deblocking and padding of whole pictures run on the shared thread pool. A picture being
+ *          reconstructed publishes its finished MB rows, so that a later picture referencing it can
+ *          start motion compensation as soon as the rows it needs are done.
+ *          Slice threading: the slices of a picture are parsed and reconstructed concurrently,
+ *          the calling thread deblocks them in slice order as they complete.
+ *
+ * \date    10/18/2026 Created
+ *
+ *************************************************************************************
+ */
+
+#ifndef WELS_DECODER_THREAD_H__
+#define WELS_DECODER_THREAD_H__
+
+#include "typedefs.h"
+#include "codec_def.h"
+#include "decoder_context.h"
+#include "picture.h"
+
+namespace WelsDec {
+
+#define MAX_DEC_FRAME_THREAD_NUM   16
+
+/*!
+ * \brief   enable (iThreadNum > 1) or disable frame or slice threading of a decoder context.
+ *          Pictures still waiting for output when the threading changes are dropped.
+ * \return  ERR_NONE on success, ERR_INFO_OUT_OF_MEMORY otherwise (the decoder then stays single threaded)
+ */
+int32_t WelsDecThreadInit (PWelsDecoderContext pCtx, int32_t iThreadNum, bool bSliceThreading);
+void WelsDecThreadUninit (PWelsDecoderContext pCtx);
+
+/*!
+ * \brief   slice threading: take the slice just set up in pCtx->pCurDqLayer (reference lists included)
+ *          instead of decoding it, it is decoded by the next WelsDecThreadDecodeSlices()
+ * \return  false if the slice cannot be decoded in parallel with the slices queued, decode it serially then
+ */
+bool WelsDecThreadQueueSlice (PWelsDecoderContext pCtx, PNalUnit pNalCur, bool bFreshSlice);
+
+/*!
+ * \brief   slice threading: decode the queued slices, must be called before any other slice is decoded,
+ *          at the end of the dq layer and before leaving DecodeCurrentAccessUnit()
+ * \return  ERR_NONE, or the error which stops decoding of the access unit as WelsDecodeSliceFinish() does
+ */
+int32_t WelsDecThreadDecodeSlices (PWelsDecoderContext pCtx, bool* pAllRefComplete);
+
+/*!
+ * \brief   called when the first slice of a picture is about to be decoded,
+ *          decides whether its reconstruction is left to the frame threads
+ */
+void WelsDecThreadStartPicture (PWelsDecoderContext pCtx);
+
+/*!
+ * \brief   record the slice just parsed into pCtx->pCurDqLayer for deferred reconstruction
+ * \param   bSliceComplete  false when parsing of the slice stopped on an error, then it is not deblocked
+ */
+int32_t WelsDecThreadAddSlice (PWelsDecoderContext pCtx, bool bSliceComplete);
+
+/*!
+ * \brief   reconstruct the slices deferred so far on the calling thread and decode the rest of the picture
+ *          without deferring, used before error concealment or whenever the serial path needs the pixels
+ */
+void WelsDecThreadSyncPicture (PWelsDecoderContext pCtx);
+
+/*!
+ * \brief   hand the current picture over to a frame thread. An output picture reported by
+ *          DecodeFrameConstruction() in ppDst/pDstInfo is queued and taken back from them.
+ */
+int32_t WelsDecThreadFinishPicture (PWelsDecoderContext pCtx, bool bRefPic, uint8_t** ppDst, SBufferInfo* pDstInfo);
+
+/*!
+ * \brief   PrefetchPic() fallback, frees pictures held by finished threads or queued output
+ */
+PPicture WelsDecThreadPrefetchPic (PWelsDecoderContext pCtx);
+
+/*!
+ * \brief   wait for all pictures in reconstruction.
+ * \param   bReset  also detach queued output from the picture buffers and drop deferred slices,
+ *                  needed before picture memory is reallocated
+ */
+void WelsDecThreadDrain (PWelsDecoderContext pCtx, bool bReset);
+
+/*!
+ * \brief   report the oldest queued picture in ppDst/pDstInfo once enough pictures are in flight,
+ *          or whenever one is queued when bFlush is set
+ * \return  true if a picture was reported
+ */
+bool WelsDecThreadOutputPicture (PWelsDecoderContext pCtx, uint8_t** ppDst, SBufferInfo* pDstInfo, bool bFlush);
+
+/*!
+ * \brief   number of decoded pictures not yet reported to the application
+ */
+int32_t WelsDecThreadGetPendingNum (PWelsDecoderContext pCtx);
+
+/*!
+ * \brief   number of pictures the frame threads may keep out of the picture buffer at a time
+ */
+int32_t WelsDecThreadGetPicHoldNum (PWelsDecoderContext pCtx);
+
+/*!
+ * \brief   block until at least iMbRows MB rows of pPic are final (PIC_READY_ALL: whole padded picture)
+ * \return  the MB rows known to be ready
+ */
+int32_t WelsDecThreadWaitPicRows (PPicture pPic, int32_t iMbRows);
+
+typedef void (*PWelsDecRowsFunc) (PWelsDecoderContext pCtx, int32_t iFirstMbY, int32_t iEndMbY, void* pArg);
+
+/*!
+ * \brief   run pfRows over the MB rows [0, iMbRows) of the current picture, spread over the calling thread
+ *          and the thread pool when threading is on. pfRows is called concurrently on disjoint rows.
+ */
+void WelsDecThreadRunRows (PWelsDecoderContext pCtx, int32_t iMbRows, PWelsDecRowsFunc pfRows, void* pArg);
+
+} // namespace WelsDec
+
+#endif//WELS_DECODER_THREAD_H__
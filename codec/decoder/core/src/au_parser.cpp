@@ -86,6 +86,27 @@ uint8_t* DetectStartCodePrefix (const uint8_t* kpBuf, int32_t* pOffset, int32_t
   return NULL;
 }
 
+int32_t DetectStartCodeOrEscape (const uint8_t* kpBuf, int32_t iBufSize) {
+  int32_t iIdx = 0;
+
+  // a sequence starting within kpBuf[iIdx..iIdx+7] needs a zero byte there
+  for (; iIdx + 10 <= iBufSize; iIdx += 8) {
+    const uint64_t kuiWord = LD64 (kpBuf + iIdx);
+    if (((kuiWord - 0x0101010101010101ULL) & ~kuiWord & 0x8080808080808080ULL) == 0)
+      continue;
+    for (int32_t i = iIdx; i < iIdx + 8; ++ i) {
+      if ((kpBuf[i] == 0) && (kpBuf[i + 1] == 0) && (kpBuf[i + 2] <= 0x03))
+        return i;
+    }
+  }
+  for (; iIdx + 2 < iBufSize; ++ iIdx) {
+    if ((kpBuf[iIdx] == 0) && (kpBuf[iIdx + 1] == 0) && (kpBuf[iIdx + 2] <= 0x03))
+      return iIdx;
+  }
+
+  return iBufSize;
+}
+
 /*!
  *************************************************************************************
  * \brief   to parse nal unit
@@ -1744,4 +1765,280 @@ int32_t ResetFmoList (PWelsDecoderContext pCtx) {
   return iCountNum;
 }
 
+/*
+ *  access unit index: the parameter sets are parsed by ParseSps() and ParsePps() into a scratch decoder
+ *  context, of the slice headers the syntax up to redundant_pic_cnt the picture boundaries and the
+ *  picture order count depend on
+ */
+#define AU_INDEX_PARAM_SET_SIZE     1024  // RBSP bytes read of a parameter set, scaling lists and VUI included
+#define AU_INDEX_SLICE_HEADER_SIZE  64    // RBSP bytes read of a slice, the syntax up to redundant_pic_cnt fits
+
+typedef struct TagAuIndexSlice {
+  bool              bParsed;    // parameter sets of the slice found, sSliceHeader is valid up to redundant_pic_cnt
+  SNalUnitHeaderExt sNalHeaderExt;
+  SSliceHeader      sSliceHeader;
+} SAuIndexSlice;
+
+typedef struct TagAuIndexCtx {
+  SWelsDecoderContext sDecCtx;  // keeps the parameter sets only
+  SDecodingParam      sDecParam;
+  SAccessUnit         sAccessUnit;
+  SAuIndexSlice       sSlice[2]; // current and last slice
+  int32_t       iPrevPocMsb;
+  int32_t       iPrevPocLsb;
+  int32_t       iPrevFrameNumOffset;
+  int32_t       iPrevFrameNum;
+  uint8_t       uiRbsp[AU_INDEX_PARAM_SET_SIZE + 8]; // zero bytes after the RBSP for the look ahead of the bit reader
+} SAuIndexCtx;
+
+// the index leaves broken parameter sets and slices out, nothing to report
+static void IndexLogQuiet (void* pCtx, const int32_t iLevel, const char* kpFmt, va_list vl) {
+}
+
+// position of the next start code 0x 00 00 01 from iPos on, kiSrcLen if there is none
+static int64_t FindStartCode (const uint8_t* kpSrc, int64_t iPos, const int64_t kiSrcLen) {
+  while (iPos + 3 <= kiSrcLen) {
+    const int32_t kiWindow = (int32_t)WELS_MIN (kiSrcLen - iPos, (int64_t)1 << 30);
+    const int32_t kiIdx = DetectStartCodeOrEscape (kpSrc + iPos, kiWindow);
+    if (kiIdx + 2 >= kiWindow) { // none in the window, its last two bytes may begin one
+      iPos += kiWindow - 2;
+      continue;
+    }
+    if (kpSrc[iPos + kiIdx + 2] == 0x01)
+      return iPos + kiIdx;
+    iPos += kiIdx + 1;
+  }
+  return kiSrcLen;
+}
+
+// RBSP of the first bytes of a NAL unit payload, emulation prevention bytes removed
+static int32_t GetIndexRbsp (SAuIndexCtx* pCtx, const uint8_t* kpPayload, const int64_t kiPayloadLen,
+                             const int32_t kiMaxLen) {
+  int32_t iLen = 0;
+  int32_t iZeroCount = 0;
+
+  for (int64_t i = 0; i < kiPayloadLen && iLen < kiMaxLen; ++ i) {
+    if (iZeroCount >= 2 && kpPayload[i] == 0x03) {
+      iZeroCount = 0;
+      continue;
+    }
+    iZeroCount = (kpPayload[i] == 0) ? iZeroCount + 1 : 0;
+    pCtx->uiRbsp[iLen++] = kpPayload[i];
+  }
+  memset (pCtx->uiRbsp + iLen, 0, 8);
+  return iLen;
+}
+
+// SPS or PPS into the scratch decoder context, as ParseNonVclNal() does
+static int32_t IndexParamSet (SAuIndexCtx* pCtx, const EWelsNalUnitType keNalType, int32_t iRbspLen) {
+  PWelsDecoderContext pDecCtx = &pCtx->sDecCtx;
+  int32_t iPicWidth, iPicHeight;
+
+  while (iRbspLen > 0 && pCtx->uiRbsp[iRbspLen - 1] == 0) // trailing_zero_8bits
+    -- iRbspLen;
+  if (iRbspLen == 0)
+    return ERR_INFO_READ_OVERFLOW;
+  WELS_READ_VERIFY (DecInitBits (&pDecCtx->sBs, pCtx->uiRbsp,
+                                 (iRbspLen << 3) - BsGetTrailingBits (pCtx->uiRbsp + iRbspLen - 1)));
+  pDecCtx->sCurNalHead.eNalUnitType = keNalType;
+  if (keNalType == NAL_UNIT_SPS)
+    return ParseSps (pDecCtx, &pDecCtx->sBs, &iPicWidth, &iPicHeight, NULL, 0);
+  return ParsePps (pDecCtx, &pDecCtx->sPpsBuffer[0], &pDecCtx->sBs, NULL, 0);
+}
+
+static int32_t IndexSliceHeader (SAuIndexCtx* pCtx, PBitStringAux pBs, SAuIndexSlice* pSlice) {
+  PWelsDecoderContext pDecCtx = &pCtx->sDecCtx;
+  PSliceHeader pSliceHead = &pSlice->sSliceHeader;
+  uint32_t uiCode;
+
+  WELS_READ_VERIFY (BsGetUe (pBs, &uiCode)); //first_mb_in_slice
+  pSliceHead->iFirstMbInSlice = uiCode;
+  WELS_READ_VERIFY (BsGetUe (pBs, &uiCode)); //slice_type
+  WELS_READ_VERIFY (BsGetUe (pBs, &uiCode)); //pic_parameter_set_id
+  if (uiCode >= MAX_PPS_COUNT || !pDecCtx->bPpsAvailFlags[uiCode])
+    return ERR_INFO_INVALID_PPS_ID;
+  pSliceHead->iPpsId = uiCode;
+  pSliceHead->pPps   = &pDecCtx->sPpsBuffer[uiCode];
+  pSliceHead->iSpsId = pSliceHead->pPps->iSpsId;
+  if (!pDecCtx->bSpsAvailFlags[pSliceHead->iSpsId])
+    return ERR_INFO_INVALID_SPS_ID;
+  pSliceHead->pSps   = &pDecCtx->sSpsBuffer[pSliceHead->iSpsId];
+  pSliceHead->bFieldPicFlag    = false; // ParseSps() takes frame_mbs_only_flag = 1 only
+  pSliceHead->bBottomFiledFlag = false;
+  WELS_READ_VERIFY (ParseSliceHeaderPicIdSyntaxs (pDecCtx, pBs, pSliceHead));
+
+  pSlice->bParsed = true;
+  return ERR_NONE;
+}
+
+// first slice of a primary coded picture, 7.4.1.2.4
+static bool IsNewIndexPicture (SAuIndexSlice* pLast, SAuIndexSlice* pCur) {
+  if (!pLast->bParsed || !pCur->bParsed)
+    return pCur->sSliceHeader.iFirstMbInSlice == 0;
+  return CheckAccessUnitBoundaryExt (&pLast->sNalHeaderExt, &pCur->sNalHeaderExt, &pLast->sSliceHeader,
+                                     &pCur->sSliceHeader);
+}
+
+// picture order count of the first slice of a frame, 8.2.1
+static int32_t IndexPoc (SAuIndexCtx* pCtx, const SAuIndexSlice* kpSlice) {
+  const SSliceHeader* kpSliceHead = &kpSlice->sSliceHeader;
+  const PSps kpSps = kpSliceHead->pSps;
+  const bool kbIdr = kpSliceHead->bIdrFlag;
+  const bool kbRef = kpSlice->sNalHeaderExt.sNalUnitHeader.uiNalRefIdc != 0;
+
+  if (kpSps->uiPocType == 0) {
+    const int32_t kiMaxPocLsb = 1 << kpSps->iLog2MaxPocLsb;
+    if (kbIdr)
+      pCtx->iPrevPocMsb = pCtx->iPrevPocLsb = 0;
+    int32_t iPocMsb = pCtx->iPrevPocMsb;
+    if (kpSliceHead->iPicOrderCntLsb < pCtx->iPrevPocLsb
+        && pCtx->iPrevPocLsb - kpSliceHead->iPicOrderCntLsb >= kiMaxPocLsb / 2)
+      iPocMsb += kiMaxPocLsb;
+    else if (kpSliceHead->iPicOrderCntLsb > pCtx->iPrevPocLsb
+             && kpSliceHead->iPicOrderCntLsb - pCtx->iPrevPocLsb > kiMaxPocLsb / 2)
+      iPocMsb -= kiMaxPocLsb;
+    if (kbRef) {
+      pCtx->iPrevPocMsb = iPocMsb;
+      pCtx->iPrevPocLsb = kpSliceHead->iPicOrderCntLsb;
+    }
+    const int32_t kiTopPoc = iPocMsb + kpSliceHead->iPicOrderCntLsb;
+    return WELS_MIN (kiTopPoc, kiTopPoc + kpSliceHead->iDeltaPicOrderCntBottom);
+  }
+
+  const int32_t kiMaxFrameNum = 1 << kpSps->uiLog2MaxFrameNum;
+  int32_t iFrameNumOffset = pCtx->iPrevFrameNumOffset;
+  if (kbIdr)
+    iFrameNumOffset = 0;
+  else if (pCtx->iPrevFrameNum > kpSliceHead->iFrameNum)
+    iFrameNumOffset += kiMaxFrameNum;
+  pCtx->iPrevFrameNumOffset = iFrameNumOffset;
+  pCtx->iPrevFrameNum = kpSliceHead->iFrameNum;
+
+  if (kpSps->uiPocType == 2) {
+    if (kbIdr)
+      return 0;
+    return 2 * (iFrameNumOffset + kpSliceHead->iFrameNum) - (kbRef ? 0 : 1);
+  }
+
+  const int32_t kiCycleLen = kpSps->iNumRefFramesInPocCycle;
+  int32_t iAbsFrameNum = (kiCycleLen != 0) ? iFrameNumOffset + kpSliceHead->iFrameNum : 0;
+  int32_t iExpectedPoc = 0;
+  if (!kbRef && iAbsFrameNum > 0)
+    -- iAbsFrameNum;
+  if (iAbsFrameNum > 0) {
+    int32_t iExpectedDeltaPerCycle = 0;
+    for (int32_t i = 0; i < kiCycleLen; ++ i)
+      iExpectedDeltaPerCycle += kpSps->iOffsetForRefFrame[i];
+    iExpectedPoc = ((iAbsFrameNum - 1) / kiCycleLen) * iExpectedDeltaPerCycle;
+    for (int32_t i = 0; i <= (iAbsFrameNum - 1) % kiCycleLen; ++ i)
+      iExpectedPoc += kpSps->iOffsetForRefFrame[i];
+  }
+  if (!kbRef)
+    iExpectedPoc += kpSps->iOffsetForNonRefPic;
+  const int32_t kiTopPoc = iExpectedPoc + kpSliceHead->iDeltaPicOrderCnt[0];
+  return WELS_MIN (kiTopPoc, kiTopPoc + kpSps->iOffsetForTopToBottomField + kpSliceHead->iDeltaPicOrderCnt[1]);
+}
+
+int32_t IndexAccessUnits (const uint8_t* kpSrc, const int64_t kiSrcLen, SAccessUnitIndex* pIndex,
+                          const int32_t kiMaxEntries) {
+  if (NULL == kpSrc || kiSrcLen < 0 || kiMaxEntries < 0)
+    return -1;
+  SAuIndexCtx* pCtx = (SAuIndexCtx*)WelsMallocz (sizeof (SAuIndexCtx), "SAuIndexCtx");
+  if (NULL == pCtx)
+    return -1;
+  pCtx->sDecCtx.sLogCtx.pfLog      = IndexLogQuiet;
+  pCtx->sDecCtx.pParam             = &pCtx->sDecParam;
+  pCtx->sDecCtx.pAccessUnitList    = &pCtx->sAccessUnit;
+
+  int32_t iAuNum = 0;
+  int64_t iAuOffset = 0;
+  int64_t iPendingOffset = -1; // first NAL unit after the last slice, the next access unit starts there
+  bool bAuDelimited = false;
+  SAccessUnitIndex* pEntry = NULL; // current access unit, NULL if not output
+  SAuIndexSlice* pLastSlice = &pCtx->sSlice[0];
+  SBitStringAux sBs;
+  int64_t iStartCode = FindStartCode (kpSrc, 0, kiSrcLen);
+
+  while (iStartCode < kiSrcLen) {
+    const int64_t kiNalOffset = (iStartCode > 0 && kpSrc[iStartCode - 1] == 0) ? iStartCode - 1 : iStartCode;
+    const int64_t kiNalStart = iStartCode + 3;
+    iStartCode = FindStartCode (kpSrc, kiNalStart, kiSrcLen);
+    if (kiNalStart >= iStartCode)
+      continue;
+    const EWelsNalUnitType keNalType = (EWelsNalUnitType) (kpSrc[kiNalStart] & 0x1f);
+    const uint8_t* kpPayload = kpSrc + kiNalStart + 1;
+    const int64_t kiPayloadLen = iStartCode - kiNalStart - 1;
+    int32_t iRbspLen;
+
+    switch (keNalType) {
+    case NAL_UNIT_AU_DELIMITER:
+      bAuDelimited = true;
+    // fall through
+    case NAL_UNIT_SEI:
+    case NAL_UNIT_SPS_EXT:
+    case NAL_UNIT_PREFIX:
+    case NAL_UNIT_SUBSET_SPS:
+    case NAL_UNIT_DEPTH_PARAM:
+    case NAL_UNIT_RESV_17:
+    case NAL_UNIT_RESV_18:
+      if (iPendingOffset < 0)
+        iPendingOffset = kiNalOffset;
+      break;
+    case NAL_UNIT_SPS:
+    case NAL_UNIT_PPS:
+      if (iPendingOffset < 0)
+        iPendingOffset = kiNalOffset;
+      iRbspLen = GetIndexRbsp (pCtx, kpPayload, kiPayloadLen, AU_INDEX_PARAM_SET_SIZE);
+      IndexParamSet (pCtx, keNalType, iRbspLen); // a broken one is left out, so are the pictures using it
+      break;
+    case NAL_UNIT_CODED_SLICE:
+    case NAL_UNIT_CODED_SLICE_IDR: {
+      SAuIndexSlice* pSlice = (pLastSlice == &pCtx->sSlice[0]) ? &pCtx->sSlice[1] : &pCtx->sSlice[0];
+      SSliceHeader* pSliceHead = &pSlice->sSliceHeader;
+      memset (&pSlice->sNalHeaderExt, 0, sizeof (SNalUnitHeaderExt));
+      pSlice->bParsed = false;
+      pSlice->sNalHeaderExt.sNalUnitHeader.eNalUnitType = keNalType;
+      pSlice->sNalHeaderExt.sNalUnitHeader.uiNalRefIdc  = (kpSrc[kiNalStart] >> 5) & 0x03;
+      pSlice->sNalHeaderExt.bIdrFlag = (keNalType == NAL_UNIT_CODED_SLICE_IDR);
+      pSliceHead->bIdrFlag        = pSlice->sNalHeaderExt.bIdrFlag;
+      pSliceHead->iFirstMbInSlice = 0;
+      iRbspLen = GetIndexRbsp (pCtx, kpPayload, kiPayloadLen, AU_INDEX_SLICE_HEADER_SIZE);
+      if (iRbspLen > 0 && ERR_NONE == DecInitBits (&sBs, pCtx->uiRbsp, iRbspLen << 3))
+        IndexSliceHeader (pCtx, &sBs, pSlice);
+      if (iAuNum == 0 || bAuDelimited || IsNewIndexPicture (pLastSlice, pSlice)) {
+        const int64_t kiAuOffset = (iPendingOffset >= 0) ? iPendingOffset : kiNalOffset;
+        if (pEntry != NULL)
+          pEntry->iSize = (int32_t) (kiAuOffset - iAuOffset);
+        const int32_t kiPoc = pSlice->bParsed ? IndexPoc (pCtx, pSlice) : 0;
+        pEntry = (pIndex != NULL && iAuNum < kiMaxEntries) ? &pIndex[iAuNum] : NULL;
+        if (pEntry != NULL) {
+          pEntry->iOffset   = kiAuOffset;
+          pEntry->iSize     = 0;
+          pEntry->iFrameNum = pSlice->bParsed ? pSliceHead->iFrameNum : -1;
+          pEntry->iPoc      = kiPoc;
+          pEntry->uiSpsId   = pSlice->bParsed ? (unsigned char)pSliceHead->iSpsId : 0;
+          pEntry->uiPpsId   = pSlice->bParsed ? (unsigned char)pSliceHead->iPpsId : 0;
+          pEntry->bIdr      = pSliceHead->bIdrFlag;
+          pEntry->bRef      = pSlice->sNalHeaderExt.sNalUnitHeader.uiNalRefIdc != 0;
+        }
+        iAuOffset = kiAuOffset;
+        bAuDelimited = false;
+        ++ iAuNum;
+      }
+      pLastSlice = pSlice;
+      iPendingOffset = -1;
+      break;
+    }
+    default: // slice data partitions, enhancement layer slices, end of sequence and the like go with the current picture
+      iPendingOffset = -1;
+      break;
+    }
+  }
+  if (pEntry != NULL)
+    pEntry->iSize = (int32_t) (kiSrcLen - iAuOffset);
+
+  WelsFree (pCtx, "SAuIndexCtx");
+  return iAuNum;
+}
+
 } // namespace WelsDec
@@ -135,80 +135,167 @@ int32_t Read32BitsCabac (PWelsCabacDecEngine pDecEngine, uint32_t& uiValue, int3
   return ERR_NONE;
 }
 
-int32_t DecodeBinCabac (PWelsCabacDecEngine pDecEngine, PWelsCabacCtx pBinCtx, uint32_t& uiBinVal) {
-  int32_t iErrorInfo = ERR_NONE;
-  uint32_t uiState = pBinCtx->uiState;
-  uiBinVal = pBinCtx->uiMPS;
-  uint64_t uiOffset = pDecEngine->uiOffset;
-  uint64_t uiRange = pDecEngine->uiRange;
+// refill the offset window, 6 bytes at once while they are available: the offset then holds
+// at most 9 + 48 bits, the byte wise Read32BitsCabac() is left for the end of the buffer
+static inline int32_t RefillCabacOffset (PWelsCabacDecEngine pDecEngine, uint64_t& uiOffset, int32_t& iBitsLeft) {
+  const uint8_t* pCurr = pDecEngine->pBuffCurr;
+  if (pDecEngine->pBuffEnd - pCurr >= 6) {
+    uiOffset = (uiOffset << 48) | ((uint64_t)pCurr[0] << 40) | ((uint64_t)pCurr[1] << 32) | ((uint64_t)pCurr[2] << 24) |
+               ((uint64_t)pCurr[3] << 16) | ((uint64_t)pCurr[4] << 8) | (uint64_t)pCurr[5];
+    pDecEngine->pBuffCurr += 6;
+    iBitsLeft += 48;
+    return ERR_NONE;
+  }
+  uint32_t uiVal = 0;
+  int32_t iNumBitsRead = 0;
+  int32_t iErrorInfo = Read32BitsCabac (pDecEngine, uiVal, iNumBitsRead);
+  uiOffset = (uiOffset << iNumBitsRead) | uiVal;
+  iBitsLeft += iNumBitsRead;
+  return iErrorInfo;
+}
+
+// context coded bin on engine state held by the caller. The MPS path stays a branch: it is well predicted
+// and keeps the offset compare off the range dependency chain, the LPS path renormalizes by table at once.
+static inline int32_t DecodeBinLocal (PWelsCabacDecEngine pDecEngine, PWelsCabacCtx pBinCtx, uint64_t& uiRange,
+                                      uint64_t& uiOffset, int32_t& iBitsLeft, uint32_t& uiBinVal) {
+  const uint32_t uiState = pBinCtx->uiState;
+  const uint32_t uiRangeLPS = g_kuiCabacRangeLps[uiState][ (uiRange >> 6) & 0x03];
+  int32_t iRenorm;
 
-  int32_t iRenorm = 1;
-  uint32_t uiRangeLPS = g_kuiCabacRangeLps[uiState][ (uiRange >> 6) & 0x03];
   uiRange -= uiRangeLPS;
-  if (uiOffset >= (uiRange << pDecEngine->iBitsLeft)) { //LPS
-    uiOffset -= (uiRange << pDecEngine->iBitsLeft);
-    uiBinVal ^= 0x0001;
-    if (!uiState)
-      pBinCtx->uiMPS ^= 0x01;
-    pBinCtx->uiState = g_kuiStateTransTable[uiState][0];
-    iRenorm = g_kRenormTable256[uiRangeLPS];
-    uiRange = (uiRangeLPS << iRenorm);
-  } else {  //MPS
+  const uint64_t uiScaledRange = uiRange << iBitsLeft;
+  if (uiOffset < uiScaledRange) { //MPS
+    uiBinVal = pBinCtx->uiMPS;
     pBinCtx->uiState = g_kuiStateTransTable[uiState][1];
-    if (uiRange >= WELS_CABAC_QUARTER) {
-      pDecEngine->uiRange = uiRange;
+    if (uiRange >= WELS_CABAC_QUARTER)
       return ERR_NONE;
-    } else {
-      uiRange <<= 1;
-    }
+    iRenorm = 1;
+  } else { //LPS
+    uiOffset -= uiScaledRange;
+    uiBinVal = pBinCtx->uiMPS ^ 0x01;
+    pBinCtx->uiMPS ^= (uint8_t) (uiState == 0);
+    pBinCtx->uiState = g_kuiStateTransTable[uiState][0];
+    uiRange = uiRangeLPS;
+    iRenorm = g_kRenormTable256[uiRangeLPS];
   }
-  //Renorm
-  pDecEngine->uiRange = uiRange;
-  pDecEngine->iBitsLeft -= iRenorm;
-  if (pDecEngine->iBitsLeft > 0) {
-    pDecEngine->uiOffset = uiOffset;
+  uiRange <<= iRenorm;
+  iBitsLeft -= iRenorm;
+  if (iBitsLeft > 0)
     return ERR_NONE;
-  }
-  uint32_t uiVal = 0;
-  int32_t iNumBitsRead = 0;
-  iErrorInfo = Read32BitsCabac (pDecEngine, uiVal, iNumBitsRead);
-  pDecEngine->uiOffset = (uiOffset << iNumBitsRead) | uiVal;
-  pDecEngine->iBitsLeft += iNumBitsRead;
-  if (iErrorInfo && pDecEngine->iBitsLeft < 0) {
+  int32_t iErrorInfo = RefillCabacOffset (pDecEngine, uiOffset, iBitsLeft);
+  if (iErrorInfo && iBitsLeft < 0) {
     return iErrorInfo;
   }
   return ERR_NONE;
 }
 
-int32_t DecodeBypassCabac (PWelsCabacDecEngine pDecEngine, uint32_t& uiBinVal) {
-  int32_t iErrorInfo = ERR_NONE;
-  int32_t iBitsLeft = pDecEngine->iBitsLeft;
-  uint64_t uiOffset = pDecEngine->uiOffset;
-  uint64_t uiRangeValue;
+// the same bin without a branch on the MPS/LPS decision, for residual bins which are close to equiprobable
+// in high bit rate streams and would mispredict often
+static inline int32_t DecodeBinLocalSel (PWelsCabacDecEngine pDecEngine, PWelsCabacCtx pBinCtx, uint64_t& uiRange,
+    uint64_t& uiOffset, int32_t& iBitsLeft, uint32_t& uiBinVal) {
+  const uint32_t uiState = pBinCtx->uiState;
+  const uint32_t uiRangeLPS = g_kuiCabacRangeLps[uiState][ (uiRange >> 6) & 0x03];
+  const uint64_t uiRangeMPS = uiRange - uiRangeLPS;
+  const uint64_t uiScaledRange = uiRangeMPS << iBitsLeft;
+  const uint32_t uiLps = uiOffset >= uiScaledRange;
 
+  uiOffset -= uiScaledRange & (0 - (uint64_t)uiLps);
+  uiRange = uiLps ? uiRangeLPS : uiRangeMPS;
+  uiBinVal = pBinCtx->uiMPS ^ uiLps;
+  pBinCtx->uiMPS ^= (uint8_t) (uiLps & (uiState == 0));
+  pBinCtx->uiState = g_kuiStateTransTable[uiState][uiLps ^ 1];
 
+  const int32_t iRenorm = g_kRenormTable512[uiRange >> 3];
+  uiRange <<= iRenorm;
+  iBitsLeft -= iRenorm;
+  if (iBitsLeft > 0)
+    return ERR_NONE;
+  int32_t iErrorInfo = RefillCabacOffset (pDecEngine, uiOffset, iBitsLeft);
+  if (iErrorInfo && iBitsLeft < 0) {
+    return iErrorInfo;
+  }
+  return ERR_NONE;
+}
+
+static inline int32_t DecodeBypassLocal (PWelsCabacDecEngine pDecEngine, uint64_t uiRange, uint64_t& uiOffset,
+    int32_t& iBitsLeft, uint32_t& uiBinVal) {
   if (iBitsLeft <= 0) {
-    uint32_t uiVal = 0;
-    int32_t iNumBitsRead = 0;
-    iErrorInfo = Read32BitsCabac (pDecEngine, uiVal, iNumBitsRead);
-    uiOffset = (uiOffset << iNumBitsRead) | uiVal;
-    iBitsLeft = iNumBitsRead;
-    if (iErrorInfo && iBitsLeft == 0) {
+    int32_t iErrorInfo = RefillCabacOffset (pDecEngine, uiOffset, iBitsLeft);
+    if (iErrorInfo && iBitsLeft <= 0) {
       return iErrorInfo;
     }
   }
   iBitsLeft--;
-  uiRangeValue = (pDecEngine->uiRange << iBitsLeft);
-  if (uiOffset >= uiRangeValue) {
-    pDecEngine->iBitsLeft = iBitsLeft;
-    pDecEngine->uiOffset = uiOffset - uiRangeValue;
-    uiBinVal = 1;
+  const uint64_t uiScaledRange = uiRange << iBitsLeft;
+  uiBinVal = uiOffset >= uiScaledRange;
+  uiOffset -= uiScaledRange & (0 - (uint64_t)uiBinVal);
+  return ERR_NONE;
+}
+
+// k-th order Exp-Golomb suffix of bypass bins, see DecodeExpBypassCabac()
+static inline int32_t DecodeExpBypassLocal (PWelsCabacDecEngine pDecEngine, uint64_t uiRange, uint64_t& uiOffset,
+    int32_t& iBitsLeft, int32_t iCount, uint32_t& uiSymVal) {
+  uint32_t uiCode;
+  int32_t iSymTmp = 0;
+  int32_t iSymTmp2 = 0;
+  do {
+    WELS_READ_VERIFY (DecodeBypassLocal (pDecEngine, uiRange, uiOffset, iBitsLeft, uiCode));
+    if (uiCode == 1) {
+      iSymTmp += (1 << iCount);
+      ++iCount;
+    }
+  } while (uiCode != 0 && iCount != 16);
+  if (iCount == 16) {
+    return GENERATE_ERROR_NO (ERR_LEVEL_MB_DATA, ERR_CABAC_UNEXPECTED_VALUE);
+  }
+  while (iCount--) {
+    WELS_READ_VERIFY (DecodeBypassLocal (pDecEngine, uiRange, uiOffset, iBitsLeft, uiCode));
+    iSymTmp2 |= (uiCode << iCount);
+  }
+  uiSymVal = (uint32_t) (iSymTmp + iSymTmp2);
+  return ERR_NONE;
+}
+
+// UEG0 binarization of coeff_abs_level_minus1 with all prefix bins in one context, see DecodeUEGLevelCabac()
+static inline int32_t DecodeUEGLevelLocal (PWelsCabacDecEngine pDecEngine, PWelsCabacCtx pBinCtx, uint64_t& uiRange,
+    uint64_t& uiOffset, int32_t& iBitsLeft, uint32_t& uiCode) {
+  uiCode = 0;
+  WELS_READ_VERIFY (DecodeBinLocal (pDecEngine, pBinCtx, uiRange, uiOffset, iBitsLeft, uiCode));
+  if (uiCode == 0)
     return ERR_NONE;
+  uint32_t uiTmp, uiCount = 1;
+  uiCode = 0;
+  do {
+    WELS_READ_VERIFY (DecodeBinLocal (pDecEngine, pBinCtx, uiRange, uiOffset, iBitsLeft, uiTmp));
+    ++uiCode;
+    ++uiCount;
+  } while (uiTmp != 0 && uiCount != 13);
+
+  if (uiTmp != 0) {
+    WELS_READ_VERIFY (DecodeExpBypassLocal (pDecEngine, uiRange, uiOffset, iBitsLeft, 0, uiTmp));
+    uiCode += uiTmp + 1;
   }
+  return ERR_NONE;
+}
+
+int32_t DecodeBinCabac (PWelsCabacDecEngine pDecEngine, PWelsCabacCtx pBinCtx, uint32_t& uiBinVal) {
+  uint64_t uiRange = pDecEngine->uiRange;
+  uint64_t uiOffset = pDecEngine->uiOffset;
+  int32_t iBitsLeft = pDecEngine->iBitsLeft;
+  int32_t iErrorInfo = DecodeBinLocal (pDecEngine, pBinCtx, uiRange, uiOffset, iBitsLeft, uiBinVal);
+  pDecEngine->uiRange = uiRange;
+  pDecEngine->uiOffset = uiOffset;
   pDecEngine->iBitsLeft = iBitsLeft;
+  return iErrorInfo;
+}
+
+int32_t DecodeBypassCabac (PWelsCabacDecEngine pDecEngine, uint32_t& uiBinVal) {
+  uint64_t uiOffset = pDecEngine->uiOffset;
+  int32_t iBitsLeft = pDecEngine->iBitsLeft;
+  int32_t iErrorInfo = DecodeBypassLocal (pDecEngine, pDecEngine->uiRange, uiOffset, iBitsLeft, uiBinVal);
   pDecEngine->uiOffset = uiOffset;
-  uiBinVal = 0;
-  return ERR_NONE;
+  pDecEngine->iBitsLeft = iBitsLeft;
+  return iErrorInfo;
 }
 
 int32_t DecodeTerminateCabac (PWelsCabacDecEngine pDecEngine, uint32_t& uiBinVal) {
@@ -263,52 +350,24 @@ int32_t DecodeUnaryBinCabac (PWelsCabacDecEngine pDecEngine, PWelsCabacCtx pBinC
 }
 
 int32_t DecodeExpBypassCabac (PWelsCabacDecEngine pDecEngine, int32_t iCount, uint32_t& uiSymVal) {
-  uint32_t uiCode;
-  int32_t iSymTmp = 0;
-  int32_t iSymTmp2 = 0;
+  uint64_t uiOffset = pDecEngine->uiOffset;
+  int32_t iBitsLeft = pDecEngine->iBitsLeft;
   uiSymVal = 0;
-  do {
-    WELS_READ_VERIFY (DecodeBypassCabac (pDecEngine, uiCode));
-    if (uiCode == 1) {
-      iSymTmp += (1 << iCount);
-      ++iCount;
-    }
-  } while (uiCode != 0 && iCount != 16);
-  if (iCount == 16) {
-    return GENERATE_ERROR_NO (ERR_LEVEL_MB_DATA, ERR_CABAC_UNEXPECTED_VALUE);
-  }
-
-  while (iCount--) {
-    WELS_READ_VERIFY (DecodeBypassCabac (pDecEngine, uiCode));
-    if (uiCode == 1) {
-      iSymTmp2 |= (1 << iCount);
-    }
-  }
-  uiSymVal = (uint32_t) (iSymTmp + iSymTmp2);
-  return ERR_NONE;
+  int32_t iErrorInfo = DecodeExpBypassLocal (pDecEngine, pDecEngine->uiRange, uiOffset, iBitsLeft, iCount, uiSymVal);
+  pDecEngine->uiOffset = uiOffset;
+  pDecEngine->iBitsLeft = iBitsLeft;
+  return iErrorInfo;
 }
 
 uint32_t DecodeUEGLevelCabac (PWelsCabacDecEngine pDecEngine, PWelsCabacCtx pBinCtx, uint32_t& uiCode) {
-  uiCode = 0;
-  WELS_READ_VERIFY (DecodeBinCabac (pDecEngine, pBinCtx, uiCode));
-  if (uiCode == 0)
-    return ERR_NONE;
-  else {
-    uint32_t uiTmp, uiCount = 1;
-    uiCode = 0;
-    do {
-      WELS_READ_VERIFY (DecodeBinCabac (pDecEngine, pBinCtx, uiTmp));
-      ++uiCode;
-      ++uiCount;
-    } while (uiTmp != 0 && uiCount != 13);
-
-    if (uiTmp != 0) {
-      WELS_READ_VERIFY (DecodeExpBypassCabac (pDecEngine, 0, uiTmp));
-      uiCode += uiTmp + 1;
-    }
-    return ERR_NONE;
-  }
-  return ERR_NONE;
+  uint64_t uiRange = pDecEngine->uiRange;
+  uint64_t uiOffset = pDecEngine->uiOffset;
+  int32_t iBitsLeft = pDecEngine->iBitsLeft;
+  int32_t iErrorInfo = DecodeUEGLevelLocal (pDecEngine, pBinCtx, uiRange, uiOffset, iBitsLeft, uiCode);
+  pDecEngine->uiRange = uiRange;
+  pDecEngine->uiOffset = uiOffset;
+  pDecEngine->iBitsLeft = iBitsLeft;
+  return iErrorInfo;
 }
 
 int32_t DecodeUEGMvCabac (PWelsCabacDecEngine pDecEngine, PWelsCabacCtx pBinCtx, uint32_t iMaxBin,  uint32_t& uiCode) {
@@ -330,4 +389,62 @@ int32_t DecodeUEGMvCabac (PWelsCabacDecEngine pDecEngine, PWelsCabacCtx pBinCtx,
     return ERR_NONE;
   }
 }
+
+// ------------------- 6. residual blocks
+int32_t DecodeResidualCoeffsCabac (PWelsCabacDecEngine pDecEngine, PWelsCabacCtx pMapCtx, PWelsCabacCtx pLastCtx,
+                                   PWelsCabacCtx pOneCtx, PWelsCabacCtx pAbsCtx, const uint8_t* pMapCtxIdx,
+                                   const uint8_t* pLastCtxIdx, int32_t iMaxPos, int32_t iMaxC2, int32_t* pCoeff,
+                                   uint32_t& uiCoeffNum) {
+  uint64_t uiRange = pDecEngine->uiRange;
+  uint64_t uiOffset = pDecEngine->uiOffset;
+  int32_t iBitsLeft = pDecEngine->iBitsLeft;
+  int32_t iErrorInfo = ERR_NONE;
+  uint8_t uiSigPos[64];
+  uint32_t uiCode;
+  int32_t iSigNum = 0;
+  int32_t i;
+
+  //significance map, the positions are kept so the levels are decoded without scanning the block again
+  for (i = 0; i < iMaxPos; ++i) {
+    iErrorInfo = DecodeBinLocalSel (pDecEngine, pMapCtx + pMapCtxIdx[i], uiRange, uiOffset, iBitsLeft, uiCode);
+    if (iErrorInfo)
+      break;
+    if (uiCode) {
+      uiSigPos[iSigNum++] = (uint8_t)i;
+      iErrorInfo = DecodeBinLocalSel (pDecEngine, pLastCtx + pLastCtxIdx[i], uiRange, uiOffset, iBitsLeft, uiCode);
+      if (iErrorInfo || uiCode)
+        break;
+    }
+  }
+  //the last coefficient is significant when no last flag was set before
+  if (i == iMaxPos)
+    uiSigPos[iSigNum++] = (uint8_t)iMaxPos;
+  uiCoeffNum = iSigNum;
+
+  //levels in reverse scanning order
+  int32_t c1 = 1;
+  int32_t c2 = 0;
+  while (!iErrorInfo && iSigNum > 0) {
+    int32_t iLevel = 1;
+    iErrorInfo = DecodeBinLocalSel (pDecEngine, pOneCtx + c1, uiRange, uiOffset, iBitsLeft, uiCode);
+    if (iErrorInfo)
+      break;
+    if (uiCode) {
+      iErrorInfo = DecodeUEGLevelLocal (pDecEngine, pAbsCtx + c2, uiRange, uiOffset, iBitsLeft, uiCode);
+      if (iErrorInfo)
+        break;
+      iLevel += 1 + uiCode;
+      c2 = WELS_MIN (c2 + 1, iMaxC2);
+      c1 = 0;
+    } else if (c1) {
+      c1 = WELS_MIN (c1 + 1, 4);
+    }
+    iErrorInfo = DecodeBypassLocal (pDecEngine, uiRange, uiOffset, iBitsLeft, uiCode);
+    pCoeff[uiSigPos[--iSigNum]] = uiCode ? -iLevel : iLevel;
+  }
+  pDecEngine->uiRange = uiRange;
+  pDecEngine->uiOffset = uiOffset;
+  pDecEngine->iBitsLeft = iBitsLeft;
+  return iErrorInfo;
+}
 }
@@ -814,12 +814,47 @@ void DeblockingIntraMb (PDqLayer pCurDqLayer, PDeblockingFilter  pFilter, int32_
   FilteringEdgeChromaHV (pCurDqLayer, pFilter, iBoundryFlag);
 }
 
+// boundary strengths of an inter MB
+static inline void DeblockingBsCalcInterMb (PDqLayer pCurDqLayer, int32_t iMbXyIndex, int32_t iCurMbType,
+    int32_t iBoundryFlag, uint8_t nBS[2][4][4]) {
+  int32_t iMbNb;
+
+  if (iBoundryFlag & LEFT_FLAG_MASK) {
+    iMbNb = iMbXyIndex - 1;
+    * (uint32_t*)nBS[0][0] = IS_INTRA (pCurDqLayer->pMbType[iMbNb]) ? 0x04040404 : DeblockingBsMarginalMBAvcbase (
+                               pCurDqLayer, 0, iMbNb, iMbXyIndex);
+  } else {
+    * (uint32_t*)nBS[0][0] = 0;
+  }
+  if (iBoundryFlag & TOP_FLAG_MASK) {
+    iMbNb = iMbXyIndex - pCurDqLayer->iMbWidth;
+    * (uint32_t*)nBS[1][0] = IS_INTRA (pCurDqLayer->pMbType[iMbNb]) ? 0x04040404 : DeblockingBsMarginalMBAvcbase (
+                               pCurDqLayer, 1, iMbNb, iMbXyIndex);
+  } else {
+    * (uint32_t*)nBS[1][0] = 0;
+  }
+  //SKIP MB_16x16 or others
+  if (iCurMbType != MB_TYPE_SKIP) {
+    if (iCurMbType == MB_TYPE_16x16) {
+      if (!pCurDqLayer->pTransformSize8x8Flag[iMbXyIndex]) {
+        DeblockingBSInsideMBAvsbase (pCurDqLayer->pNzc[iMbXyIndex], nBS, 1);
+      } else {
+        DeblockingBSInsideMBAvsbase8x8 (pCurDqLayer->pNzc[iMbXyIndex], nBS, 1);
+      }
+    } else {
+      DeblockingBSInsideMBNormal (pCurDqLayer, nBS, pCurDqLayer->pNzc[iMbXyIndex], iMbXyIndex);
+    }
+  } else {
+    * (uint32_t*)nBS[0][1] = * (uint32_t*)nBS[0][2] = * (uint32_t*)nBS[0][3] =
+                               * (uint32_t*)nBS[1][1] = * (uint32_t*)nBS[1][2] = * (uint32_t*)nBS[1][3] = 0;
+  }
+}
+
 void WelsDeblockingMb (PDqLayer pCurDqLayer, PDeblockingFilter  pFilter, int32_t iBoundryFlag) {
   uint8_t nBS[2][4][4] = {{{ 0 }}};
 
   int32_t iMbXyIndex  = pCurDqLayer->iMbXyIndex;
   int32_t iCurMbType  = pCurDqLayer->pMbType[iMbXyIndex];
-  int32_t iMbNb;
 
   switch (iCurMbType) {
   case MB_TYPE_INTRA4x4:
@@ -829,41 +864,70 @@ void WelsDeblockingMb (PDqLayer pCurDqLayer, PDeblockingFilter  pFilter, int32_t
     DeblockingIntraMb (pCurDqLayer, pFilter, iBoundryFlag);
     break;
   default:
-
-    if (iBoundryFlag & LEFT_FLAG_MASK) {
-      iMbNb = iMbXyIndex - 1;
-      * (uint32_t*)nBS[0][0] = IS_INTRA (pCurDqLayer->pMbType[iMbNb]) ? 0x04040404 : DeblockingBsMarginalMBAvcbase (
-                                 pCurDqLayer, 0, iMbNb, iMbXyIndex);
-    } else {
-      * (uint32_t*)nBS[0][0] = 0;
-    }
-    if (iBoundryFlag & TOP_FLAG_MASK) {
-      iMbNb = iMbXyIndex - pCurDqLayer->iMbWidth;
-      * (uint32_t*)nBS[1][0] = IS_INTRA (pCurDqLayer->pMbType[iMbNb]) ? 0x04040404 : DeblockingBsMarginalMBAvcbase (
-                                 pCurDqLayer, 1, iMbNb, iMbXyIndex);
-    } else {
-      * (uint32_t*)nBS[1][0] = 0;
-    }
-    //SKIP MB_16x16 or others
-    if (iCurMbType != MB_TYPE_SKIP) {
-      if (iCurMbType == MB_TYPE_16x16) {
-        if (!pCurDqLayer->pTransformSize8x8Flag[pCurDqLayer->iMbXyIndex]) {
-          DeblockingBSInsideMBAvsbase (pCurDqLayer->pNzc[iMbXyIndex], nBS, 1);
-        } else {
-          DeblockingBSInsideMBAvsbase8x8 (pCurDqLayer->pNzc[iMbXyIndex], nBS, 1);
-        }
-      } else {
-        DeblockingBSInsideMBNormal (pCurDqLayer, nBS, pCurDqLayer->pNzc[iMbXyIndex], iMbXyIndex);
-      }
-    } else {
-      * (uint32_t*)nBS[0][1] = * (uint32_t*)nBS[0][2] = * (uint32_t*)nBS[0][3] =
-                                 * (uint32_t*)nBS[1][1] = * (uint32_t*)nBS[1][2] = * (uint32_t*)nBS[1][3] = 0;
-    }
+    DeblockingBsCalcInterMb (pCurDqLayer, iMbXyIndex, iCurMbType, iBoundryFlag, nBS);
     DeblockingInterMb (pCurDqLayer, pFilter, nBS, iBoundryFlag);
     break;
   }
 }
 
+void DeblockingBsCalcMbRow (PDqLayer pCurDqLayer, int32_t iFilterIdc, int32_t iFirstMbXy, int32_t iMbNum,
+                            PDeblockingMbBs pMbBs) {
+  const int32_t kiMbWidth = pCurDqLayer->iMbWidth;
+
+  pCurDqLayer->iMbY = iFirstMbXy / kiMbWidth;
+  for (int32_t i = 0; i < iMbNum; ++i) {
+    const int32_t kiMbXy = iFirstMbXy + i;
+    const int32_t kiMbType = pCurDqLayer->pMbType[kiMbXy];
+    pCurDqLayer->iMbX = kiMbXy % kiMbWidth;
+    pCurDqLayer->iMbXyIndex = kiMbXy;
+
+    pMbBs[i].iBoundryFlag = DeblockingAvailableNoInterlayer (pCurDqLayer, iFilterIdc);
+    if (!IS_INTRA (kiMbType))
+      DeblockingBsCalcInterMb (pCurDqLayer, kiMbXy, kiMbType, pMbBs[i].iBoundryFlag, pMbBs[i].nBS);
+  }
+}
+
+void WelsDeblockingMbRow (PDqLayer pCurDqLayer, PDeblockingFilter pFilter, int32_t iFilterIdc, int32_t iFirstMbXy,
+                          int32_t iMbNum) {
+  SDeblockingMbBs sMbBs[MAX_DEBLOCKING_BS_MB_NUM];
+
+  while (iMbNum > 0) {
+    const int32_t kiBatchNum = WELS_MIN (iMbNum, MAX_DEBLOCKING_BS_MB_NUM);
+    DeblockingBsCalcMbRow (pCurDqLayer, iFilterIdc, iFirstMbXy, kiBatchNum, sMbBs);
+
+    for (int32_t i = 0; i < kiBatchNum; ++i) {
+      const int32_t kiMbXy = iFirstMbXy + i;
+      pCurDqLayer->iMbX = kiMbXy % pCurDqLayer->iMbWidth;
+      pCurDqLayer->iMbXyIndex = kiMbXy;
+      if (IS_INTRA (pCurDqLayer->pMbType[kiMbXy]))
+        DeblockingIntraMb (pCurDqLayer, pFilter, sMbBs[i].iBoundryFlag);
+      else
+        DeblockingInterMb (pCurDqLayer, pFilter, sMbBs[i].nBS, sMbBs[i].iBoundryFlag);
+    }
+    iFirstMbXy += kiBatchNum;
+    iMbNum -= kiBatchNum;
+  }
+}
+
+static inline void SetDeblockingFilterParam (PWelsDecoderContext pCtx, PDeblockingFilter pFilter) {
+  PDqLayer pCurDqLayer = pCtx->pCurDqLayer;
+  PSliceHeader pSliceHeader = &pCurDqLayer->sLayerInfo.sSliceInLayer.sSliceHeaderExt.sSliceHeader;
+
+  pFilter->pCsData[0] = pCtx->pDec->pData[0];
+  pFilter->pCsData[1] = pCtx->pDec->pData[1];
+  pFilter->pCsData[2] = pCtx->pDec->pData[2];
+
+  pFilter->iCsStride[0] = pCtx->pDec->iLinesize[0];
+  pFilter->iCsStride[1] = pCtx->pDec->iLinesize[1];
+
+  pFilter->eSliceType = (EWelsSliceType) pCurDqLayer->sLayerInfo.sSliceInLayer.eSliceType;
+
+  pFilter->iSliceAlphaC0Offset = pSliceHeader->iSliceAlphaC0Offset;
+  pFilter->iSliceBetaOffset     = pSliceHeader->iSliceBetaOffset;
+
+  pFilter->pLoopf = &pCtx->sDeblockingFunc;
+}
+
 /*!
  * \brief   AVC slice deblocking filtering target layer
  *
@@ -887,23 +951,21 @@ void WelsDeblockingFilterSlice (PWelsDecoderContext pCtx, PDeblockingFilterMbFun
   int32_t iFilterIdc = pCurDqLayer->sLayerInfo.sSliceInLayer.sSliceHeaderExt.sSliceHeader.uiDisableDeblockingFilterIdc;
 
   /* Step1: parameters set */
-  pFilter.pCsData[0] = pCtx->pDec->pData[0];
-  pFilter.pCsData[1] = pCtx->pDec->pData[1];
-  pFilter.pCsData[2] = pCtx->pDec->pData[2];
-
-  pFilter.iCsStride[0] = pCtx->pDec->iLinesize[0];
-  pFilter.iCsStride[1] = pCtx->pDec->iLinesize[1];
-
-  pFilter.eSliceType = (EWelsSliceType) pCurDqLayer->sLayerInfo.sSliceInLayer.eSliceType;
-
-  pFilter.iSliceAlphaC0Offset = pSliceHeaderExt->sSliceHeader.iSliceAlphaC0Offset;
-  pFilter.iSliceBetaOffset     = pSliceHeaderExt->sSliceHeader.iSliceBetaOffset;
-
-  pFilter.pLoopf = &pCtx->sDeblockingFunc;
+  SetDeblockingFilterParam (pCtx, &pFilter);
 
   /* Step2: macroblock deblocking */
   if (0 == iFilterIdc || 2 == iFilterIdc) {
     iNextMbXyIndex = pSliceHeaderExt->sSliceHeader.iFirstMbInSlice;
+    if (pDeblockMb == WelsDeblockingMb && pSliceHeaderExt->sSliceHeader.pPps->uiNumSliceGroups <= 1) {
+      // raster order: boundary strengths of each MB row are computed before the row is filtered
+      int32_t iLastMbXy = WELS_MIN (iNextMbXyIndex + iTotalNumMb, iTotalMbCount) - 1;
+      while (iNextMbXyIndex <= iLastMbXy) {
+        int32_t iMbNum = WELS_MIN (iLastMbXy + 1, (iNextMbXyIndex / iMbWidth + 1) * iMbWidth) - iNextMbXyIndex;
+        WelsDeblockingMbRow (pCurDqLayer, &pFilter, iFilterIdc, iNextMbXyIndex, iMbNum);
+        iNextMbXyIndex += iMbNum;
+      }
+      return;
+    }
     pCurDqLayer->iMbX  = iNextMbXyIndex % iMbWidth;
     pCurDqLayer->iMbY  = iNextMbXyIndex / iMbWidth;
     pCurDqLayer->iMbXyIndex = iNextMbXyIndex;
@@ -933,6 +995,44 @@ void WelsDeblockingFilterSlice (PWelsDecoderContext pCtx, PDeblockingFilterMbFun
     } while (1);
   }
 }
+
+/*!
+ * \brief   deblock MBs iFirstMbXy..iLastMbXy (raster order) with the parameters of the current slice,
+ *          which must cover them all. Used when a picture is deblocked apart from its parsing.
+ *
+ * \return  NONE
+ */
+void WelsDeblockingFilterMbRange (PWelsDecoderContext pCtx, PDeblockingFilterMbFunc pDeblockMb, int32_t iFirstMbXy,
+                                  int32_t iLastMbXy) {
+  PDqLayer pCurDqLayer = pCtx->pCurDqLayer;
+  int32_t iMbWidth  = pCurDqLayer->iMbWidth;
+  int32_t iFilterIdc = pCurDqLayer->sLayerInfo.sSliceInLayer.sSliceHeaderExt.sSliceHeader.uiDisableDeblockingFilterIdc;
+  SDeblockingFilter pFilter;
+
+  if (0 != iFilterIdc && 2 != iFilterIdc)
+    return;
+
+  memset (&pFilter, 0, sizeof (pFilter));
+  SetDeblockingFilterParam (pCtx, &pFilter);
+
+  if (pDeblockMb == WelsDeblockingMb) {
+    while (iFirstMbXy <= iLastMbXy) {
+      int32_t iMbNum = WELS_MIN (iLastMbXy + 1, (iFirstMbXy / iMbWidth + 1) * iMbWidth) - iFirstMbXy;
+      WelsDeblockingMbRow (pCurDqLayer, &pFilter, iFilterIdc, iFirstMbXy, iMbNum);
+      iFirstMbXy += iMbNum;
+    }
+    return;
+  }
+
+  for (int32_t iMbXy = iFirstMbXy; iMbXy <= iLastMbXy; ++iMbXy) {
+    pCurDqLayer->iMbX  = iMbXy % iMbWidth;
+    pCurDqLayer->iMbY  = iMbXy / iMbWidth;
+    pCurDqLayer->iMbXyIndex = iMbXy;
+
+    pDeblockMb (pCurDqLayer, &pFilter, DeblockingAvailableNoInterlayer (pCurDqLayer, iFilterIdc));
+  }
+}
+
 /*!
  * \brief   deblocking module initialize
  *
@@ -969,6 +1069,14 @@ void  DeblockingInit (SDeblockingFunc*  pFunc,  int32_t iCpu) {
     pFunc->pfChromaDeblockingLT4Hor = DeblockChromaLt4H_ssse3;
     pFunc->pfChromaDeblockingEQ4Hor = DeblockChromaEq4H_ssse3;
   }
+#if defined(HAVE_AVX2)
+  if (iCpu & WELS_CPU_AVX2) {
+    pFunc->pfLumaDeblockingLT4Ver   = DeblockLumaLt4V_avx2;
+    pFunc->pfLumaDeblockingEQ4Ver   = DeblockLumaEq4V_avx2;
+    pFunc->pfLumaDeblockingLT4Hor   = DeblockLumaLt4H_avx2;
+    pFunc->pfLumaDeblockingEQ4Hor   = DeblockLumaEq4H_avx2;
+  }
+#endif
 #endif
 
 #if defined(HAVE_NEON)
@@ -52,6 +52,62 @@
 
 namespace WelsDec {
 
+/*
+ *  row pipeline: deblock the MBs of the current slice from *pDeblockMbXy up to iEndMbXy (excluded), all reconstructed.
+ *  While the picture is processed in raster order, pad the MB rows no later deblocking can change:
+ *  deblocking MB row r is the last change to row r - 1.
+ */
+static void RowPipelineDeblock (PWelsDecoderContext pCtx, int32_t* pDeblockMbXy, int32_t iEndMbXy) {
+  PDqLayer pCurLayer = pCtx->pCurDqLayer;
+  PSliceHeader pSliceHeader = &pCurLayer->sLayerInfo.sSliceInLayer.sSliceHeaderExt.sSliceHeader;
+  const int32_t kiMbWidth = pCurLayer->iMbWidth;
+  const int32_t kiMbHeight = pCurLayer->iMbHeight;
+
+  if (*pDeblockMbXy >= iEndMbXy)
+    return;
+  if (1 != pSliceHeader->uiDisableDeblockingFilterIdc) {
+    const int64_t kiStart = WelsStageStart (pCtx);
+    WelsDeblockingFilterMbRange (pCtx, WelsDeblockingMb, *pDeblockMbXy, iEndMbXy - 1);
+    WelsStageEnd (pCtx, DECODER_STAGE_DEBLOCKING, kiStart);
+  }
+  *pDeblockMbXy = iEndMbXy;
+
+  if (pCtx->iRowPipeNextMbXy < 0)
+    return;
+  pCtx->iRowPipeNextMbXy = iEndMbXy;
+  if (0 == pCurLayer->sLayerInfo.sNalHeaderExt.sNalUnitHeader.uiNalRefIdc) // no reference, not padded
+    return;
+
+  const int32_t kiFinalRows = (iEndMbXy == kiMbWidth * kiMbHeight) ? kiMbHeight : WELS_MAX (iEndMbXy / kiMbWidth - 1, 0);
+  if (kiFinalRows > pCtx->iRowPipeExpandedRows) {
+    const int64_t kiStart = WelsStageStart (pCtx);
+    ExpandReferencingPictureRows (pCtx->pDec->pData, kiMbWidth << 4, kiMbHeight << 4, pCtx->pDec->iLinesize,
+                                  pCtx->iRowPipeExpandedRows, kiFinalRows, pCtx->pDec->iPaddingLen,
+                                  pCtx->sExpandPicFunc.pfExpandPictureLines);
+    WelsStageEnd (pCtx, DECODER_STAGE_EXPANSION, kiStart);
+    pCtx->iRowPipeExpandedRows = kiFinalRows;
+  }
+}
+
+void WelsExpandDecodedPicture (PWelsDecoderContext pCtx) {
+  PPicture pPic = pCtx->pDec;
+  const int64_t kiStart = WelsStageStart (pCtx);
+
+  if (pPic->iPaddingLen < PADDING_LENGTH) { // fast preview, pad the margin motion vectors reach only
+    ExpandReferencingPictureRows (pPic->pData, pPic->iWidthInPixel, pPic->iHeightInPixel, pPic->iLinesize,
+                                  (pCtx->iRowPipeNextMbXy < 0) ? 0 : pCtx->iRowPipeExpandedRows, (pPic->iHeightInPixel + 15) >> 4,
+                                  pPic->iPaddingLen, pCtx->sExpandPicFunc.pfExpandPictureLines);
+  } else if (pCtx->iRowPipeNextMbXy < 0 || pCtx->iRowPipeExpandedRows == 0) {
+    ExpandReferencingPicture (pPic->pData, pPic->iWidthInPixel, pPic->iHeightInPixel, pPic->iLinesize,
+                              pCtx->sExpandPicFunc.pfExpandLumaPicture, pCtx->sExpandPicFunc.pfExpandChromaPicture);
+  } else {
+    ExpandReferencingPictureRows (pPic->pData, pPic->iWidthInPixel, pPic->iHeightInPixel, pPic->iLinesize,
+                                  pCtx->iRowPipeExpandedRows, (pPic->iHeightInPixel + 15) >> 4, PADDING_LENGTH,
+                                  pCtx->sExpandPicFunc.pfExpandPictureLines);
+  }
+  WelsStageEnd (pCtx, DECODER_STAGE_EXPANSION, kiStart);
+}
+
 int32_t WelsTargetSliceConstruction (PWelsDecoderContext pCtx) {
   PDqLayer pCurLayer = pCtx->pCurDqLayer;
   PSlice pCurSlice = &pCurLayer->sLayerInfo.sSliceInLayer;
@@ -68,11 +124,24 @@ int32_t WelsTargetSliceConstruction (PWelsDecoderContext pCtx) {
   int32_t iTotalNumMb = pCurSlice->iTotalMbInCurSlice;
   int32_t iCountNumMb = 0;
   PDeblockingFilterMbFunc pDeblockMb;
+  // serial reconstruction in raster order: deblock MB row r - 1 as soon as row r is reconstructed,
+  // while its pixels are still in cache
+  const bool kbRowPipeline = !pCtx->bDeferSliceRecon && !pCtx->bSliceReconDone && !pCtx->pParam->bParseOnly
+                             && 1 == pSliceHeader->pPps->uiNumSliceGroups
+                             && (I_SLICE == pCurSlice->eSliceType || P_SLICE == pCurSlice->eSliceType);
+  int32_t iDeblockMbXy = pSliceHeader->iFirstMbInSlice;
 
   if (!pCtx->bAvcBasedFlag && iCurLayerWidth != pCtx->iCurSeqIntervalMaxPicWidth) {
     return ERR_INFO_WIDTH_MISMATCH;
   }
 
+  if (0 == pCtx->iTotalNumMbRec) { // first slice of the picture
+    pCtx->iRowPipeNextMbXy = 0;
+    pCtx->iRowPipeExpandedRows = 0;
+  }
+  if (!kbRowPipeline || pCtx->iRowPipeNextMbXy != pSliceHeader->iFirstMbInSlice)
+    pCtx->iRowPipeNextMbXy = -1;
+
   iNextMbXyIndex   = pSliceHeader->iFirstMbInSlice;
   pCurLayer->iMbX  = iNextMbXyIndex % pCurLayer->iMbWidth;
   pCurLayer->iMbY  = iNextMbXyIndex / pCurLayer->iMbWidth;
@@ -90,7 +159,15 @@ int32_t WelsTargetSliceConstruction (PWelsDecoderContext pCtx) {
       break;
     }
 
-    if (!pCtx->pParam->bParseOnly) { //for parse only, actual recon MB unnecessary
+    if (pCtx->bDeferSliceRecon || pCtx->bSliceReconDone) { //recon left to the frame threads or done by a slice thread, only make sure it cannot fail there
+      if (!IS_INTRA (pCurLayer->pMbType[iNextMbXyIndex]) && !IS_INTER (pCurLayer->pMbType[iNextMbXyIndex])) {
+        WelsLog (& (pCtx->sLogCtx), WELS_LOG_WARNING,
+                 "WelsTargetSliceConstruction():::MB(%d, %d) unknown MB type: %d", pCurLayer->iMbX, pCurLayer->iMbY,
+                 pCurLayer->pMbType[iNextMbXyIndex]);
+        pCurSlice->iTotalMbInCurSlice = iCountNumMb; // frame threads reconstruct only what the serial path would have
+        return ERR_INFO_MB_RECON_FAIL;
+      }
+    } else if (!pCtx->pParam->bParseOnly) { //for parse only, actual recon MB unnecessary
       if (WelsTargetMbConstruction (pCtx)) {
         WelsLog (& (pCtx->sLogCtx), WELS_LOG_WARNING,
                  "WelsTargetSliceConstruction():::MB(%d, %d) construction error. pCurSlice_type:%d",
@@ -111,10 +188,14 @@ int32_t WelsTargetSliceConstruction (PWelsDecoderContext pCtx) {
       WelsLog (& (pCtx->sLogCtx), WELS_LOG_WARNING,
                "WelsTargetSliceConstruction():::pCtx->iTotalNumMbRec:%d, iTotalMbTargetLayer:%d",
                pCtx->iTotalNumMbRec, iTotalMbTargetLayer);
-
+      if (pCtx->bDeferSliceRecon)
+        pCurSlice->iTotalMbInCurSlice = iCountNumMb;
       return ERR_INFO_MB_NUM_EXCEED_FAIL;
     }
 
+    if (kbRowPipeline && pCurLayer->iMbX == pCurLayer->iMbWidth - 1)
+      RowPipelineDeblock (pCtx, &iDeblockMbXy, pCurLayer->iMbY * pCurLayer->iMbWidth);
+
     if (pSliceHeader->pPps->uiNumSliceGroups > 1) {
       iNextMbXyIndex = FmoNextMb (pFmo, iNextMbXyIndex);
     } else {
@@ -134,8 +215,13 @@ int32_t WelsTargetSliceConstruction (PWelsDecoderContext pCtx) {
   if ((pCurSlice->eSliceType != I_SLICE) && (pCurSlice->eSliceType != P_SLICE))
     return ERR_NONE; //no error but just ignore the type unsupported
 
-  if (pCtx->pParam->bParseOnly) //for parse only, deblocking should not go on
+  if (pCtx->pParam->bParseOnly || pCtx->bDeferSliceRecon) //for parse only or deferred recon, deblocking should not go on
+    return ERR_NONE;
+
+  if (kbRowPipeline) {
+    RowPipelineDeblock (pCtx, &iDeblockMbXy, pSliceHeader->iFirstMbInSlice + iCountNumMb);
     return ERR_NONE;
+  }
 
   pDeblockMb = WelsDeblockingMb;
 
@@ -143,7 +229,9 @@ int32_t WelsTargetSliceConstruction (PWelsDecoderContext pCtx) {
       || pCtx->pCurDqLayer->sLayerInfo.sSliceInLayer.iTotalMbInCurSlice <= 0) {
     return ERR_NONE;//NO_SUPPORTED_FILTER_IDX
   } else {
+    const int64_t kiStart = WelsStageStart (pCtx);
     WelsDeblockingFilterSlice (pCtx, pDeblockMb);
+    WelsStageEnd (pCtx, DECODER_STAGE_DEBLOCKING, kiStart);
   }
   // any other filter_idc not supported here, 7/22/2010
 
@@ -1201,7 +1289,8 @@ int32_t WelsDecodeSlice (PWelsDecoderContext pCtx, bool bFirstSliceInLayer, PNal
       break;
     }
 
-    pCurLayer->pSliceIdc[iNextMbXyIndex] = iSliceIdc;
+    if (pCurLayer->pSliceIdc[iNextMbXyIndex] != iSliceIdc) // preset when slices are decoded in parallel
+      pCurLayer->pSliceIdc[iNextMbXyIndex] = iSliceIdc;
     pCtx->bMbRefConcealed = false;
     iRet = pDecMbFunc (pCtx,  pNalCur, uiEosFlag);
     pCurLayer->pMbRefConcealedFlag[iNextMbXyIndex] = pCtx->bMbRefConcealed;
@@ -43,6 +43,7 @@
 #include "au_parser.h"
 #include "get_intra_predictor.h"
 #include "rec_mb.h"
+#include "wels_decoder_thread.h"
 #include "mc.h"
 #include "decode_mb_aux.h"
 #include "manage_dec_ref.h"
@@ -324,7 +325,12 @@ void WelsDecoderDefaults (PWelsDecoderContext pCtx, SLogContext* pLogCtx) {
   pCtx->iSubSPSInvalidNum = 0;
   pCtx->iSubSPSLastInvalidId = -1;
   pCtx->iFeedbackNalRefIdc = -1; //initialize
-
+  pCtx->pThreadCtx = NULL;
+  pCtx->bDeferSliceRecon = false;
+  pCtx->bSliceReconDone = false;
+  pCtx->pRefReadyMbRows = NULL;
+  pCtx->iPreviewMvReach = -1;
+  pCtx->iPreviewPaddingLen = PADDING_LENGTH;
 }
 
 /*
@@ -343,6 +349,9 @@ static inline int32_t GetTargetRefListSize (PWelsDecoderContext pCtx) {
   } else {
     iNumRefFrames = pCtx->pSps->iNumRefFrames + 2;
   }
+  // pictures in reconstruction or waiting for output with frame threading
+  if (pCtx != NULL)
+    iNumRefFrames += WelsDecThreadGetPicHoldNum (pCtx);
 
 #ifdef LONG_TERM_REF
   //pic_queue size minimum set 2
@@ -383,6 +392,10 @@ int32_t WelsRequestMem (PWelsDecoderContext pCtx, const int32_t kiMbWidth, const
   WELS_VERIFY_RETURN_IF (ERR_NONE, pCtx->bHaveGotMemory && (kiPicWidth == pCtx->iImgWidthInPixel
                          && kiPicHeight == pCtx->iImgHeightInPixel) && (!bNeedChangePicQueue)) // have same scaled buffer
 
+  // no picture may be in use by frame threads while the buffers change
+  if (pCtx->pThreadCtx != NULL)
+    WelsDecThreadDrain (pCtx, true);
+
   // sync update pRefList
   WelsResetRefPic (pCtx); // added to sync update ref list due to pictures are free
 
@@ -392,6 +405,7 @@ int32_t WelsRequestMem (PWelsDecoderContext pCtx, const int32_t kiMbWidth, const
     WelsLog (& (pCtx->sLogCtx), WELS_LOG_INFO,
              "WelsRequestMem(): memory re-alloc for no resolution change (size = %d * %d), ref list size change from %d to %d",
              kiPicWidth, kiPicHeight, pCtx->pPicBuff[LIST_0]->iCapacity, iPicQueueSize);
+    MaterializeAliasedPics (pCtx); // pictures may be freed below
     if (pCtx->pPicBuff[LIST_0]->iCapacity < iPicQueueSize) {
       iErr = IncreasePicBuff (pCtx, &pCtx->pPicBuff[LIST_0], pCtx->pPicBuff[LIST_0]->iCapacity, kiPicWidth, kiPicHeight,
                               iPicQueueSize);
@@ -509,6 +523,8 @@ int32_t WelsOpenDecoder (PWelsDecoderContext pCtx, SLogContext* pLogCtx) {
  * \brief   Close decoder
  */
 void WelsCloseDecoder (PWelsDecoderContext pCtx) {
+  WelsDecThreadUninit (pCtx);
+
   WelsFreeDynamicMemory (pCtx);
 
   WelsFreeStaticMemory (pCtx);
@@ -530,11 +546,11 @@ int32_t DecoderConfigParam (PWelsDecoderContext pCtx, const SDecodingParam* kpPa
     return ERR_INFO_INVALID_PARAM;
 
   memcpy (pCtx->pParam, kpParam, sizeof (SDecodingParam));
-  if ((pCtx->pParam->eEcActiveIdc > ERROR_CON_SLICE_MV_COPY_CROSS_IDR_FREEZE_RES_CHANGE)
+  if ((pCtx->pParam->eEcActiveIdc > ERROR_CON_FRAME_COPY_CROSS_IDR_ALIAS)
       || (pCtx->pParam->eEcActiveIdc < ERROR_CON_DISABLE)) {
     WelsLog (& (pCtx->sLogCtx), WELS_LOG_WARNING,
              "eErrorConMethod (%d) not in range: (%d - %d). Set as default value: (%d).", pCtx->pParam->eEcActiveIdc,
-             ERROR_CON_DISABLE, ERROR_CON_SLICE_MV_COPY_CROSS_IDR_FREEZE_RES_CHANGE,
+             ERROR_CON_DISABLE, ERROR_CON_FRAME_COPY_CROSS_IDR_ALIAS,
              ERROR_CON_SLICE_MV_COPY_CROSS_IDR_FREEZE_RES_CHANGE);
     pCtx->pParam->eEcActiveIdc = ERROR_CON_SLICE_MV_COPY_CROSS_IDR_FREEZE_RES_CHANGE;
   }
@@ -660,6 +676,7 @@ int32_t WelsDecodeBs (PWelsDecoderContext pCtx, const uint8_t* kpBsBuf, const in
     pDstNal = pRawData->pCurPos;
 
     bool bNalStartBytes = false;
+    int64_t iUnescapeStart = WelsStageStart (pCtx);
 
     while (iSrcConsumed < iSrcLength) {
       if ((2 + iSrcConsumed < iSrcLength) && (0 == LD16 (pSrcNal + iSrcIdx)) && (pSrcNal[2 + iSrcIdx] <= 0x03)) {
@@ -691,11 +708,14 @@ int32_t WelsDecodeBs (PWelsDecoderContext pCtx, const uint8_t* kpBsBuf, const in
           iConsumedBytes = 0;
           pDstNal[iDstIdx] = pDstNal[iDstIdx + 1] = pDstNal[iDstIdx + 2] = pDstNal[iDstIdx + 3] =
                                0; // set 4 reserved bytes to zero
+          WelsStageEnd (pCtx, DECODER_STAGE_NAL_UNESCAPE, iUnescapeStart);
+          const int64_t kiHeaderStart = WelsStageStart (pCtx);
           pNalPayload = ParseNalHeader (pCtx, &pCtx->sCurNalHead, pDstNal, iDstIdx, pSrcNal - 3, iSrcIdx + 3, &iConsumedBytes);
+          if (pNalPayload && IS_PARAM_SETS_NALS (pCtx->sCurNalHead.eNalUnitType)) {
+            iRet = ParseNonVclNal (pCtx, pNalPayload, iDstIdx - iConsumedBytes, pSrcNal - 3, iSrcIdx + 3);
+          }
+          WelsStageEnd (pCtx, DECODER_STAGE_HEADER_PARSE, kiHeaderStart);
           if (pNalPayload) { //parse correct
-            if (IS_PARAM_SETS_NALS (pCtx->sCurNalHead.eNalUnitType)) {
-              iRet = ParseNonVclNal (pCtx, pNalPayload, iDstIdx - iConsumedBytes, pSrcNal - 3, iSrcIdx + 3);
-            }
             CheckAndFinishLastPic (pCtx, ppDst, pDstBufInfo);
             if (pCtx->bAuReadyFlag && pCtx->pAccessUnitList->uiAvailUnitsNum != 0) {
               ConstructAccessUnit (pCtx, ppDst, pDstBufInfo);
@@ -736,11 +756,16 @@ int32_t WelsDecodeBs (PWelsDecoderContext pCtx, const uint8_t* kpBsBuf, const in
           iSrcConsumed += 3;
           iSrcIdx = 0;
           iDstIdx  = 0; //reset 0, used to statistic the length of next NAL
+          iUnescapeStart = WelsStageStart (pCtx);
         }
         continue;
       }
-      pDstNal[iDstIdx++] = pSrcNal[iSrcIdx++];
-      iSrcConsumed++;
+      // copy the run up to the next start code or emulation prevention byte at once
+      const int32_t kiRunLen = 1 + DetectStartCodeOrEscape (pSrcNal + iSrcIdx + 1, iSrcLength - iSrcConsumed - 1);
+      memcpy (pDstNal + iDstIdx, pSrcNal + iSrcIdx, kiRunLen);
+      iDstIdx      += kiRunLen;
+      iSrcIdx      += kiRunLen;
+      iSrcConsumed += kiRunLen;
     }
 
     //last NAL decoding
@@ -749,11 +774,14 @@ int32_t WelsDecodeBs (PWelsDecoderContext pCtx, const uint8_t* kpBsBuf, const in
     pDstNal[iDstIdx] = pDstNal[iDstIdx + 1] = pDstNal[iDstIdx + 2] = pDstNal[iDstIdx + 3] =
                          0; // set 4 reserved bytes to zero
     pRawData->pCurPos = pDstNal + iDstIdx + 4; //init, increase 4 reserved zero bytes, used to store the next NAL
+    WelsStageEnd (pCtx, DECODER_STAGE_NAL_UNESCAPE, iUnescapeStart);
+    const int64_t kiHeaderStart = WelsStageStart (pCtx);
     pNalPayload = ParseNalHeader (pCtx, &pCtx->sCurNalHead, pDstNal, iDstIdx, pSrcNal - 3, iSrcIdx + 3, &iConsumedBytes);
+    if (pNalPayload && IS_PARAM_SETS_NALS (pCtx->sCurNalHead.eNalUnitType)) {
+      iRet = ParseNonVclNal (pCtx, pNalPayload, iDstIdx - iConsumedBytes, pSrcNal - 3, iSrcIdx + 3);
+    }
+    WelsStageEnd (pCtx, DECODER_STAGE_HEADER_PARSE, kiHeaderStart);
     if (pNalPayload) { //parse correct
-      if (IS_PARAM_SETS_NALS (pCtx->sCurNalHead.eNalUnitType)) {
-        iRet = ParseNonVclNal (pCtx, pNalPayload, iDstIdx - iConsumedBytes, pSrcNal - 3, iSrcIdx + 3);
-      }
       CheckAndFinishLastPic (pCtx, ppDst, pDstBufInfo);
       if (pCtx->bAuReadyFlag && pCtx->pAccessUnitList->uiAvailUnitsNum != 0) {
         ConstructAccessUnit (pCtx, ppDst, pDstBufInfo);
@@ -848,6 +876,8 @@ void InitDecFuncs (PWelsDecoderContext pCtx, uint32_t uiCpuFlag) {
   WelsBlockFuncInit (&pCtx->sBlockFunc, uiCpuFlag);
   InitPredFunc (pCtx, uiCpuFlag);
   InitMcFunc (& (pCtx->sMcFunc), uiCpuFlag);
+  if (pCtx->pParam != NULL && pCtx->pParam->bFastPreview)
+    pCtx->sMcFunc.pMcChromaFunc = McChromaFullPel;
   InitExpandPictureFunc (& (pCtx->sExpandPicFunc), uiCpuFlag);
   DeblockingInit (&pCtx->sDeblockingFunc, uiCpuFlag);
 }
@@ -917,6 +947,7 @@ void InitPredFunc (PWelsDecoderContext pCtx, uint32_t uiCpuFlag) {
 
   pCtx->pIdctResAddPredFunc     = IdctResAddPred_c;
   pCtx->pIdctFourResAddPredFunc = IdctFourResAddPred_<IdctResAddPred_c>;
+  pCtx->pIdctFourRecFunc        = NULL;
 
   pCtx->pIdctResAddPredFunc8x8  = IdctResAddPred8x8_c;
 
@@ -997,6 +1028,7 @@ void InitPredFunc (PWelsDecoderContext pCtx, uint32_t uiCpuFlag) {
   if (uiCpuFlag & WELS_CPU_SSE2) {
     pCtx->pIdctResAddPredFunc     = IdctResAddPred_sse2;
     pCtx->pIdctFourResAddPredFunc = IdctFourResAddPred_<IdctResAddPred_sse2>;
+    pCtx->pIdctFourRecFunc        = WelsIDctFourT4Rec_sse2;
 
     pCtx->pGetI16x16LumaPredFunc[I16_PRED_DC] = WelsDecoderI16x16LumaPredDc_sse2;
     pCtx->pGetI16x16LumaPredFunc[I16_PRED_P]  = WelsDecoderI16x16LumaPredPlane_sse2;
@@ -1013,6 +1045,15 @@ void InitPredFunc (PWelsDecoderContext pCtx, uint32_t uiCpuFlag) {
   if (uiCpuFlag & WELS_CPU_AVX2) {
     pCtx->pIdctResAddPredFunc     = IdctResAddPred_avx2;
     pCtx->pIdctFourResAddPredFunc = IdctFourResAddPred_avx2;
+    pCtx->pIdctFourRecFunc        = WelsIDctFourT4Rec_avx2;
+
+    pCtx->pGetI16x16LumaPredFunc[I16_PRED_DC]   = WelsDecoderI16x16LumaPredDc_avx2;
+    pCtx->pGetI16x16LumaPredFunc[I16_PRED_P]    = WelsDecoderI16x16LumaPredPlane_avx2;
+    pCtx->pGetI16x16LumaPredFunc[I16_PRED_H]    = WelsDecoderI16x16LumaPredH_avx2;
+    pCtx->pGetI16x16LumaPredFunc[I16_PRED_DC_T] = WelsDecoderI16x16LumaPredDcTop_avx2;
+    pCtx->pGetIChromaPredFunc[C_PRED_P ]        = WelsDecoderIChromaPredPlane_avx2;
+    pCtx->pGetIChromaPredFunc[C_PRED_DC]        = WelsDecoderIChromaPredDc_avx2;
+    pCtx->pGetIChromaPredFunc[C_PRED_H ]        = WelsDecoderIChromaPredH_avx2;
   }
 #endif
 
@@ -1036,6 +1077,33 @@ void ResetDecStatNums (SDecoderStatistics* pDecStat) {
   pDecStat->uiLevel = uiLevel;
 }
 
+void ResetDecStageTiming (SDecStageTiming* pTiming) {
+  memset (pTiming, 0, sizeof (SDecStageTiming));
+  pTiming->iStartTicks = WelsTicks();
+  pTiming->iStartUs = WelsTime();
+}
+
+void GetDecStageStatistics (const SDecStageTiming* kpTiming, SDecoderStageStatistics* pStatistics) {
+  const int64_t kiElapsedUs = WELS_MAX (WelsTime() - kpTiming->iStartUs, 0);
+#if defined(WELS_TICKS_CPU_CYCLES)
+  // the time stamp counter runs at a constant rate, measured over the whole timing period
+  const int64_t kiElapsedTicks = WelsTicks() - kpTiming->iStartTicks;
+  const double kdNsPerTick = (kiElapsedTicks > 0) ? kiElapsedUs * 1000.0 / kiElapsedTicks : 0.0;
+#endif
+  memset (pStatistics, 0, sizeof (SDecoderStageStatistics));
+  for (int32_t i = 0; i < DECODER_STAGE_NUM; i++) {
+#if defined(WELS_TICKS_CPU_CYCLES)
+    pStatistics->sStage[i].uiCycles = kpTiming->uiTicks[i];
+    pStatistics->sStage[i].uiNanoseconds = (unsigned long long) (kpTiming->uiTicks[i] * kdNsPerTick + 0.5);
+#else
+    pStatistics->sStage[i].uiNanoseconds = kpTiming->uiTicks[i];
+#endif
+    pStatistics->sStage[i].uiCount = kpTiming->uiCount[i];
+  }
+  pStatistics->uiParsedMbCount = kpTiming->uiParsedMbCount;
+  pStatistics->uiElapsedNanoseconds = (unsigned long long)kiElapsedUs * 1000;
+}
+
 //update information when freezing occurs, including IDR/non-IDR number
 void UpdateDecStatFreezingInfo (const bool kbIdrFlag, SDecoderStatistics* pDecStat) {
   if (kbIdrFlag)
@@ -42,6 +42,7 @@
 #include "decode_mb_aux.h"
 #include "memory_align.h"
 #include "error_concealment.h"
+#include "wels_decoder_thread.h"
 
 namespace WelsDec {
 static inline int32_t DecodeFrameConstruction (PWelsDecoderContext pCtx, uint8_t** ppDst, SBufferInfo* pDstInfo) {
@@ -216,6 +217,7 @@ static inline int32_t DecodeFrameConstruction (PWelsDecoderContext pCtx, uint8_t
   pDstInfo->UsrData.sSystemBuffer.iHeight = kiActualHeight;
   pDstInfo->UsrData.sSystemBuffer.iStride[0] = pPic->iLinesize[0];
   pDstInfo->UsrData.sSystemBuffer.iStride[1] = pPic->iLinesize[1];
+  pDstInfo->pFrameBuffer = pPic->pUserBuffer;
   ppDst[0] = ppDst[0] + pCtx->sFrameCrop.iTopOffset * 2 * pPic->iLinesize[0] + pCtx->sFrameCrop.iLeftOffset * 2;
   ppDst[1] = ppDst[1] + pCtx->sFrameCrop.iTopOffset  * pPic->iLinesize[1] + pCtx->sFrameCrop.iLeftOffset;
   ppDst[2] = ppDst[2] + pCtx->sFrameCrop.iTopOffset  * pPic->iLinesize[1] + pCtx->sFrameCrop.iLeftOffset;
@@ -287,7 +289,23 @@ inline void    HandleReferenceLost (PWelsDecoderContext pCtx, PNalUnit pCurNal)
 }
 
 inline int32_t  WelsDecodeConstructSlice (PWelsDecoderContext pCtx, PNalUnit pCurNal) {
-  int32_t  iRet = WelsTargetSliceConstruction (pCtx);
+  int32_t  iRet;
+
+  if (pCtx->bDeferSliceRecon && pCtx->pCurDqLayer->sLayerInfo.pPps->uiNumSliceGroups > 1)
+    WelsDecThreadSyncPicture (pCtx); // FMO slices are reconstructed in place
+  // the deblocking and padding interleaved with the reconstruction are accounted for on their own
+  uint64_t* pStageTicks = pCtx->sStageTiming.uiTicks;
+  const uint64_t kuiInnerTicks = pStageTicks[DECODER_STAGE_DEBLOCKING] + pStageTicks[DECODER_STAGE_EXPANSION];
+  const int64_t kiStart = WelsStageStart (pCtx);
+  iRet = WelsTargetSliceConstruction (pCtx);
+  if (pCtx->bDeferSliceRecon && iRet != ERR_INFO_WIDTH_MISMATCH
+      && WelsDecThreadAddSlice (pCtx, iRet == ERR_NONE) != ERR_NONE) {
+    WelsDecThreadSyncPicture (pCtx);
+    iRet = WelsTargetSliceConstruction (pCtx);
+  }
+  WelsStageEnd (pCtx, DECODER_STAGE_RECONSTRUCTION, kiStart);
+  pStageTicks[DECODER_STAGE_RECONSTRUCTION] -= pStageTicks[DECODER_STAGE_DEBLOCKING] + pStageTicks[DECODER_STAGE_EXPANSION] -
+      kuiInnerTicks;
 
   if (iRet) {
     HandleReferenceLostL0 (pCtx, pCurNal);
@@ -296,6 +314,40 @@ inline int32_t  WelsDecodeConstructSlice (PWelsDecoderContext pCtx, PNalUnit pCu
   return iRet;
 }
 
+int32_t WelsDecodeSliceFinish (PWelsDecoderContext pCtx, PNalUnit pNalCur, int32_t iRet, bool bReconstructSlice,
+                               bool* pAllRefComplete) {
+  //Output good store_base reconstruction when enhancement quality layer occurred error for MGS key picture case
+  if (iRet != ERR_NONE) {
+    WelsLog (& (pCtx->sLogCtx), WELS_LOG_WARNING,
+             "DecodeCurrentAccessUnit() failed (%d) in frame: %d uiDId: %d uiQId: %d",
+             iRet, pNalCur->sNalData.sVclNal.sSliceHeaderExt.sSliceHeader.iFrameNum,
+             pNalCur->sNalHeaderExt.uiDependencyId, pNalCur->sNalHeaderExt.uiQualityId);
+    *pAllRefComplete = false;
+    HandleReferenceLostL0 (pCtx, pNalCur);
+    if (pCtx->pParam->eEcActiveIdc == ERROR_CON_DISABLE) {
+      if (pCtx->iTotalNumMbRec == 0)
+        pCtx->pDec = NULL;
+      return iRet;
+    }
+  }
+
+  if (bReconstructSlice) {
+    if ((iRet = WelsDecodeConstructSlice (pCtx, pNalCur)) != ERR_NONE) {
+      pCtx->pDec->bIsComplete = false; // reconstruction error, directly set the flag false
+      return iRet;
+    }
+  }
+  if (*pAllRefComplete && pCtx->eSliceType != I_SLICE) {
+    if (pCtx->sRefPic.uiRefCount[LIST_0] > 0) {
+      *pAllRefComplete &= CheckRefPicturesComplete (pCtx);
+    } else {
+      *pAllRefComplete = false;
+    }
+  }
+
+  return ERR_NONE;
+}
+
 int32_t ParsePredWeightedTable (PBitStringAux pBs, PSliceHeader pSh) {
   uint32_t uiCode;
   int32_t iList = 0;
@@ -782,6 +834,64 @@ void UpdateDecoderStatisticsForActiveParaset (SDecoderStatistics* pDecoderStatis
 #define SLICE_HEADER_INTER_LAYER_ALPHAC0_BETA_OFFSET_MAX 12
 #define MAX_NUM_REF_IDX_L0_ACTIVE_MINUS1 15
 #define SLICE_HEADER_CABAC_INIT_IDC_MAX 2
+/*
+ *  ParseSliceHeaderPicIdSyntaxs
+ *  Parse slice header from frame_num to redundant_pic_cnt, the syntax telling the picture a slice belongs to
+ */
+int32_t ParseSliceHeaderPicIdSyntaxs (PWelsDecoderContext pCtx, PBitStringAux pBs, PSliceHeader pSliceHead) {
+  const PSps kpSps = pSliceHead->pSps;
+  const PPps kpPps = pSliceHead->pPps;
+  SLogContext* pLogCtx = & (pCtx->sLogCtx);
+  uint32_t uiCode;
+  int32_t iCode;
+
+  WELS_READ_VERIFY (BsGetBits (pBs, kpSps->uiLog2MaxFrameNum, &uiCode)); //frame_num
+  pSliceHead->iFrameNum = uiCode;
+
+  if (pSliceHead->bIdrFlag) {
+    if (pSliceHead->iFrameNum != 0) {
+      WelsLog (pLogCtx, WELS_LOG_WARNING,
+               "ParseSliceHeaderSyntaxs(), invaild frame number: %d due to IDR frame introduced!",
+               pSliceHead->iFrameNum);
+      return GENERATE_ERROR_NO (ERR_LEVEL_SLICE_HEADER, ERR_INFO_INVALID_FRAME_NUM);
+    }
+    WELS_READ_VERIFY (BsGetUe (pBs, &uiCode)); //idr_pic_id
+    // standard 7.4.3 idr_pic_id should be in range 0 to 65535, inclusive.
+    WELS_CHECK_SE_UPPER_ERROR (uiCode, SLICE_HEADER_IDR_PIC_ID_MAX, "idr_pic_id", GENERATE_ERROR_NO (ERR_LEVEL_SLICE_HEADER,
+                               ERR_INFO_INVALID_IDR_PIC_ID));
+    pSliceHead->uiIdrPicId = uiCode; /* uiIdrPicId */
+  }
+
+  pSliceHead->iDeltaPicOrderCntBottom = 0;
+  pSliceHead->iDeltaPicOrderCnt[0] =
+    pSliceHead->iDeltaPicOrderCnt[1] = 0;
+  if (kpSps->uiPocType == 0) {
+    WELS_READ_VERIFY (BsGetBits (pBs, kpSps->iLog2MaxPocLsb, &uiCode)); //pic_order_cnt_lsb
+    pSliceHead->iPicOrderCntLsb = uiCode;
+    if (kpPps->bPicOrderPresentFlag && !pSliceHead->bFieldPicFlag) {
+      WELS_READ_VERIFY (BsGetSe (pBs, &iCode)); //delta_pic_order_cnt_bottom
+      pSliceHead->iDeltaPicOrderCntBottom = iCode;
+    }
+  } else if (kpSps->uiPocType == 1 && !kpSps->bDeltaPicOrderAlwaysZeroFlag) {
+    WELS_READ_VERIFY (BsGetSe (pBs, &iCode)); //delta_pic_order_cnt[ 0 ]
+    pSliceHead->iDeltaPicOrderCnt[0] = iCode;
+    if (kpPps->bPicOrderPresentFlag && !pSliceHead->bFieldPicFlag) {
+      WELS_READ_VERIFY (BsGetSe (pBs, &iCode)); //delta_pic_order_cnt[ 1 ]
+      pSliceHead->iDeltaPicOrderCnt[1] = iCode;
+    }
+  }
+
+  pSliceHead->iRedundantPicCnt = 0;
+  if (kpPps->bRedundantPicCntPresentFlag) {
+    WELS_READ_VERIFY (BsGetUe (pBs, &uiCode)); //redundant_pic_cnt
+    // standard section 7.4.3, redundant_pic_cnt should be in range 0 to 127, inclusive.
+    WELS_CHECK_SE_UPPER_ERROR (uiCode, SLICE_HEADER_REDUNDANT_PIC_CNT_MAX, "redundant_pic_cnt",
+                               GENERATE_ERROR_NO (ERR_LEVEL_SLICE_HEADER, ERR_INFO_INVALID_REDUNDANT_PIC_CNT));
+    pSliceHead->iRedundantPicCnt = uiCode;
+  }
+  return ERR_NONE;
+}
+
 /*
  *  decode_slice_header_avc
  *  Parse slice header of bitstream in avc for storing data structure
@@ -950,8 +1060,6 @@ int32_t ParseSliceHeaderSyntaxs (PWelsDecoderContext pCtx, PBitStringAux pBs, co
   // check first_mb_in_slice
   WELS_CHECK_SE_UPPER_ERROR ((uint32_t) (pSliceHead->iFirstMbInSlice), (pSps->uiTotalMbCount - 1), "first_mb_in_slice",
                              GENERATE_ERROR_NO (ERR_LEVEL_SLICE_HEADER, ERR_INFO_INVALID_FIRST_MB_IN_SLICE));
-  WELS_READ_VERIFY (BsGetBits (pBs, pSps->uiLog2MaxFrameNum, &uiCode)); //frame_num
-  pSliceHead->iFrameNum = uiCode;
 
   pSliceHead->bFieldPicFlag    = false;
   pSliceHead->bBottomFiledFlag = false;
@@ -963,53 +1071,16 @@ int32_t ParseSliceHeaderSyntaxs (PWelsDecoderContext pCtx, PBitStringAux pBs, co
   pSliceHead->iMbWidth  = pSps->iMbWidth;
   pSliceHead->iMbHeight = pSps->iMbHeight / (1 + pSliceHead->bFieldPicFlag);
 
-  if (bIdrFlag) {
-    if (pSliceHead->iFrameNum != 0) {
-      WelsLog (pLogCtx, WELS_LOG_WARNING,
-               "ParseSliceHeaderSyntaxs(), invaild frame number: %d due to IDR frame introduced!",
-               pSliceHead->iFrameNum);
-      return GENERATE_ERROR_NO (ERR_LEVEL_SLICE_HEADER, ERR_INFO_INVALID_FRAME_NUM);
-    }
-    WELS_READ_VERIFY (BsGetUe (pBs, &uiCode)); //idr_pic_id
-    // standard 7.4.3 idr_pic_id should be in range 0 to 65535, inclusive.
-    WELS_CHECK_SE_UPPER_ERROR (uiCode, SLICE_HEADER_IDR_PIC_ID_MAX, "idr_pic_id", GENERATE_ERROR_NO (ERR_LEVEL_SLICE_HEADER,
-                               ERR_INFO_INVALID_IDR_PIC_ID));
-    pSliceHead->uiIdrPicId = uiCode; /* uiIdrPicId */
+  iRet = ParseSliceHeaderPicIdSyntaxs (pCtx, pBs, pSliceHead);
+  if (iRet != ERR_NONE)
+    return iRet;
 #ifdef LONG_TERM_REF
+  if (bIdrFlag)
     pCtx->uiCurIdrPicId = pSliceHead->uiIdrPicId;
 #endif
-  }
-
-  pSliceHead->iDeltaPicOrderCntBottom = 0;
-  pSliceHead->iDeltaPicOrderCnt[0] =
-    pSliceHead->iDeltaPicOrderCnt[1] = 0;
-  if (pSps->uiPocType == 0) {
-    WELS_READ_VERIFY (BsGetBits (pBs, pSps->iLog2MaxPocLsb, &uiCode)); //pic_order_cnt_lsb
-    pSliceHead->iPicOrderCntLsb = uiCode;
-    if (pPps->bPicOrderPresentFlag && !pSliceHead->bFieldPicFlag) {
-      WELS_READ_VERIFY (BsGetSe (pBs, &iCode)); //delta_pic_order_cnt_bottom
-      pSliceHead->iDeltaPicOrderCntBottom = iCode;
-    }
-  } else if (pSps->uiPocType == 1 && !pSps->bDeltaPicOrderAlwaysZeroFlag) {
-    WELS_READ_VERIFY (BsGetSe (pBs, &iCode)); //delta_pic_order_cnt[ 0 ]
-    pSliceHead->iDeltaPicOrderCnt[0] = iCode;
-    if (pPps->bPicOrderPresentFlag && !pSliceHead->bFieldPicFlag) {
-      WELS_READ_VERIFY (BsGetSe (pBs, &iCode)); //delta_pic_order_cnt[ 1 ]
-      pSliceHead->iDeltaPicOrderCnt[1] = iCode;
-    }
-  }
-
-  pSliceHead->iRedundantPicCnt = 0;
-  if (pPps->bRedundantPicCntPresentFlag) {
-    WELS_READ_VERIFY (BsGetUe (pBs, &uiCode)); //redundant_pic_cnt
-    // standard section 7.4.3, redundant_pic_cnt should be in range 0 to 127, inclusive.
-    WELS_CHECK_SE_UPPER_ERROR (uiCode, SLICE_HEADER_REDUNDANT_PIC_CNT_MAX, "redundant_pic_cnt",
-                               GENERATE_ERROR_NO (ERR_LEVEL_SLICE_HEADER, ERR_INFO_INVALID_REDUNDANT_PIC_CNT));
-    pSliceHead->iRedundantPicCnt = uiCode;
-    if (pSliceHead->iRedundantPicCnt > 0) {
-      WelsLog (pLogCtx, WELS_LOG_WARNING, "Redundant picture not supported!");
-      return GENERATE_ERROR_NO (ERR_LEVEL_SLICE_HEADER, ERR_INFO_INVALID_REDUNDANT_PIC_CNT);
-    }
+  if (pSliceHead->iRedundantPicCnt > 0) {
+    WelsLog (pLogCtx, WELS_LOG_WARNING, "Redundant picture not supported!");
+    return GENERATE_ERROR_NO (ERR_LEVEL_SLICE_HEADER, ERR_INFO_INVALID_REDUNDANT_PIC_CNT);
   }
 
   //set defaults, might be overriden a few line later
@@ -1126,6 +1197,8 @@ int32_t ParseSliceHeaderSyntaxs (PWelsDecoderContext pCtx, PBitStringAux pBs, co
                                     ERR_INFO_INVALID_SLICE_BETA_OFFSET_DIV2));
     }
   }
+  if (pCtx->pParam->bFastPreview) // the preview gives up the loop filter, see SDecodingParam::bFastPreview
+    pSliceHead->uiDisableDeblockingFilterIdc = 1;
 
   bSgChangeCycleInvolved = (pPps->uiNumSliceGroups > 1 && pPps->uiSliceGroupMapType >= 3
                             && pPps->uiSliceGroupMapType <= 5);
@@ -1367,279 +1440,293 @@ int32_t UpdateAccessUnit (PWelsDecoderContext pCtx) {
   return ERR_NONE;
 }
 
-int32_t InitialDqLayersContext (PWelsDecoderContext pCtx, const int32_t kiMaxWidth, const int32_t kiMaxHeight) {
-  int32_t i = 0;
+/*
+ *  allocate the per-MB syntax/residual arrays of one exchangeable layer of a MB buffer,
+ *  sized by pMb->iMbWidth x pMb->iMbHeight
+ */
+int32_t InitialMbBuffer (CMemoryAlign* pMa, PMbBuffer pMb, const int32_t kiIdx) {
+  const int32_t kiMbCount = pMb->iMbWidth * pMb->iMbHeight;
+
+  pMb->pMbType[kiIdx] = (int16_t*)pMa->WelsMallocz (kiMbCount * sizeof (int16_t),
+                         "pCtx->sMb.pMbType[]");
+  pMb->pMv[kiIdx][0] = (int16_t (*)[16][2])pMa->WelsMallocz (kiMbCount * sizeof (
+                          int16_t) * MV_A * MB_BLOCK4x4_NUM, "pCtx->sMb.pMv[][]");
+  pMb->pRefIndex[kiIdx][0] = (int8_t (*)[MB_BLOCK4x4_NUM])pMa->WelsMallocz (kiMbCount *
+                              sizeof (
+                                int8_t) * MB_BLOCK4x4_NUM, "pCtx->sMb.pRefIndex[][]");
+  pMb->pLumaQp[kiIdx] = (int8_t*)pMa->WelsMallocz (kiMbCount * sizeof (int8_t),
+                         "pCtx->sMb.pLumaQp[]");
+  pMb->pNoSubMbPartSizeLessThan8x8Flag[kiIdx] = (bool*)pMa->WelsMallocz (kiMbCount *
+      sizeof (
+        bool),
+      "pCtx->sMb.pNoSubMbPartSizeLessThan8x8Flag[]");
+  pMb->pTransformSize8x8Flag[kiIdx] = (bool*)pMa->WelsMallocz (kiMbCount * sizeof (bool),
+                                       "pCtx->sMb.pTransformSize8x8Flag[]");
+  pMb->pChromaQp[kiIdx] = (int8_t (*)[2])pMa->WelsMallocz (kiMbCount * sizeof (
+                             int8_t) * 2,
+                           "pCtx->sMb.pChromaQp[]");
+  pMb->pMvd[kiIdx][0] = (int16_t (*)[16][2])pMa->WelsMallocz (kiMbCount * sizeof (
+                           int16_t) * MV_A * MB_BLOCK4x4_NUM, "pCtx->sMb.pMvd[][]");
+  pMb->pCbfDc[kiIdx] = (uint16_t*)pMa->WelsMallocz (kiMbCount * sizeof (uint16_t),
+                        "pCtx->sMb.pCbfDc[]");
+  pMb->pNzc[kiIdx] = (int8_t (*)[24])pMa->WelsMallocz (kiMbCount * sizeof (int8_t) * 24,
+                      "pCtx->sMb.pNzc[]");
+  pMb->pNzcRs[kiIdx] = (int8_t (*)[24])pMa->WelsMallocz (kiMbCount * sizeof (int8_t) * 24,
+                        "pCtx->sMb.pNzcRs[]");
+  pMb->pScaledTCoeff[kiIdx] = (int16_t (*)[MB_COEFF_LIST_SIZE])pMa->WelsMallocz (kiMbCount *
+                               sizeof (int16_t) * MB_COEFF_LIST_SIZE, "pCtx->sMb.pScaledTCoeff[]");
+  pMb->pIntraPredMode[kiIdx] = (int8_t (*)[8])pMa->WelsMallocz (kiMbCount * sizeof (
+                                  int8_t) * 8,
+                                "pCtx->sMb.pIntraPredMode[]");
+  pMb->pIntra4x4FinalMode[kiIdx] = (int8_t (*)[MB_BLOCK4x4_NUM])pMa->WelsMallocz (kiMbCount *
+                                    sizeof (int8_t) * MB_BLOCK4x4_NUM, "pCtx->sMb.pIntra4x4FinalMode[]");
+  pMb->pIntraNxNAvailFlag[kiIdx] = (uint8_t (*))pMa->WelsMallocz (kiMbCount * sizeof (
+                                      int8_t),
+                                    "pCtx->sMb.pIntraNxNAvailFlag");
+  pMb->pChromaPredMode[kiIdx] = (int8_t*)pMa->WelsMallocz (kiMbCount * sizeof (int8_t),
+                                 "pCtx->sMb.pChromaPredMode[]");
+  pMb->pCbp[kiIdx] = (int8_t*)pMa->WelsMallocz (kiMbCount * sizeof (int8_t),
+                      "pCtx->sMb.pCbp[]");
+  pMb->pSubMbType[kiIdx] = (int8_t (*)[MB_PARTITION_SIZE])pMa->WelsMallocz (kiMbCount *
+                            sizeof (
+                              int8_t) * MB_PARTITION_SIZE, "pCtx->sMb.pSubMbType[]");
+  pMb->pSliceIdc[kiIdx] = (int32_t*) pMa->WelsMallocz (kiMbCount * sizeof (int32_t),
+                           "pCtx->sMb.pSliceIdc[]"); // using int32_t for slice_idc, 4/21/2010
+  pMb->pResidualPredFlag[kiIdx] = (int8_t*) pMa->WelsMallocz (kiMbCount * sizeof (int8_t),
+                                   "pCtx->sMb.pResidualPredFlag[]");
+  pMb->pInterPredictionDoneFlag[kiIdx] = (int8_t*) pMa->WelsMallocz (kiMbCount * sizeof (
+      int8_t), "pCtx->sMb.pInterPredictionDoneFlag[]");
+
+  pMb->pMbCorrectlyDecodedFlag[kiIdx] = (bool*) pMa->WelsMallocz (kiMbCount * sizeof (
+      bool),
+                                         "pCtx->sMb.pMbCorrectlyDecodedFlag[]");
+  pMb->pMbRefConcealedFlag[kiIdx] = (bool*) pMa->WelsMallocz (kiMbCount * sizeof (bool),
+                                     "pCtx->pMbRefConcealedFlag[]");
+
+  // check memory block valid due above allocated..
+  WELS_VERIFY_RETURN_IF (ERR_INFO_OUT_OF_MEMORY,
+                         ((NULL == pMb->pMbType[kiIdx]) ||
+                          (NULL == pMb->pMv[kiIdx][0]) ||
+                          (NULL == pMb->pRefIndex[kiIdx][0]) ||
+                          (NULL == pMb->pLumaQp[kiIdx]) ||
+                          (NULL == pMb->pNoSubMbPartSizeLessThan8x8Flag[kiIdx]) ||
+                          (NULL == pMb->pTransformSize8x8Flag[kiIdx]) ||
+                          (NULL == pMb->pChromaQp[kiIdx]) ||
+                          (NULL == pMb->pMvd[kiIdx][0]) ||
+                          (NULL == pMb->pCbfDc[kiIdx]) ||
+                          (NULL == pMb->pNzc[kiIdx]) ||
+                          (NULL == pMb->pNzcRs[kiIdx]) ||
+                          (NULL == pMb->pScaledTCoeff[kiIdx]) ||
+                          (NULL == pMb->pIntraPredMode[kiIdx]) ||
+                          (NULL == pMb->pIntra4x4FinalMode[kiIdx]) ||
+                          (NULL == pMb->pIntraNxNAvailFlag[kiIdx]) ||
+                          (NULL == pMb->pChromaPredMode[kiIdx]) ||
+                          (NULL == pMb->pCbp[kiIdx]) ||
+                          (NULL == pMb->pSubMbType[kiIdx]) ||
+                          (NULL == pMb->pSliceIdc[kiIdx]) ||
+                          (NULL == pMb->pResidualPredFlag[kiIdx]) ||
+                          (NULL == pMb->pInterPredictionDoneFlag[kiIdx]) ||
+                          (NULL == pMb->pMbRefConcealedFlag[kiIdx]) ||
+                          (NULL == pMb->pMbCorrectlyDecodedFlag[kiIdx])
+                         )
+                        )
+
+  memset (pMb->pSliceIdc[kiIdx], 0xff, (kiMbCount * sizeof (int32_t)));
 
-  WELS_VERIFY_RETURN_IF (ERR_INFO_INVALID_PARAM, (NULL == pCtx || kiMaxWidth <= 0 || kiMaxHeight <= 0))
-  pCtx->sMb.iMbWidth  = (kiMaxWidth + 15) >> 4;
-  pCtx->sMb.iMbHeight = (kiMaxHeight + 15) >> 4;
+  return ERR_NONE;
+}
 
-  if (pCtx->bInitialDqLayersMem && kiMaxWidth <= pCtx->iPicWidthReq
-      && kiMaxHeight <= pCtx->iPicHeightReq) // have same dimension memory, skipped
-    return ERR_NONE;
+void UninitialMbBuffer (CMemoryAlign* pMa, PMbBuffer pMb, const int32_t kiIdx) {
+  if (pMb->pMbType[kiIdx]) {
+    pMa->WelsFree (pMb->pMbType[kiIdx], "pCtx->sMb.pMbType[]");
 
-  CMemoryAlign* pMa = pCtx->pMemAlign;
+    pMb->pMbType[kiIdx] = NULL;
+  }
 
-  UninitialDqLayersContext (pCtx);
+  if (pMb->pMv[kiIdx][0]) {
+    pMa->WelsFree (pMb->pMv[kiIdx][0], "pCtx->sMb.pMv[][]");
 
-  do {
-    PDqLayer pDq = (PDqLayer)pMa->WelsMallocz (sizeof (SDqLayer), "PDqLayer");
+    pMb->pMv[kiIdx][0] = NULL;
+  }
 
-    if (pDq == NULL)
-      return ERR_INFO_OUT_OF_MEMORY;
+  if (pMb->pRefIndex[kiIdx][0]) {
+    pMa->WelsFree (pMb->pRefIndex[kiIdx][0], "pCtx->sMb.pRefIndex[][]");
 
-    pCtx->pDqLayersList[i] = pDq; //to keep consistence with in UninitialDqLayersContext()
-    memset (pDq, 0, sizeof (SDqLayer));
+    pMb->pRefIndex[kiIdx][0] = NULL;
+  }
 
-    pCtx->sMb.pMbType[i] = (int16_t*)pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (int16_t),
-                           "pCtx->sMb.pMbType[]");
-    pCtx->sMb.pMv[i][0] = (int16_t (*)[16][2])pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (
-                            int16_t) * MV_A * MB_BLOCK4x4_NUM, "pCtx->sMb.pMv[][]");
-    pCtx->sMb.pRefIndex[i][0] = (int8_t (*)[MB_BLOCK4x4_NUM])pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight *
-                                sizeof (
-                                  int8_t) * MB_BLOCK4x4_NUM, "pCtx->sMb.pRefIndex[][]");
-    pCtx->sMb.pLumaQp[i] = (int8_t*)pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (int8_t),
-                           "pCtx->sMb.pLumaQp[]");
-    pCtx->sMb.pNoSubMbPartSizeLessThan8x8Flag[i] = (bool*)pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight *
-        sizeof (
-          bool),
-        "pCtx->sMb.pNoSubMbPartSizeLessThan8x8Flag[]");
-    pCtx->sMb.pTransformSize8x8Flag[i] = (bool*)pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (bool),
-                                         "pCtx->sMb.pTransformSize8x8Flag[]");
-    pCtx->sMb.pChromaQp[i] = (int8_t (*)[2])pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (
-                               int8_t) * 2,
-                             "pCtx->sMb.pChromaQp[]");
-    pCtx->sMb.pMvd[i][0] = (int16_t (*)[16][2])pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (
-                             int16_t) * MV_A * MB_BLOCK4x4_NUM, "pCtx->sMb.pMvd[][]");
-    pCtx->sMb.pCbfDc[i] = (uint16_t*)pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (uint16_t),
-                          "pCtx->sMb.pCbfDc[]");
-    pCtx->sMb.pNzc[i] = (int8_t (*)[24])pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (int8_t) * 24,
-                        "pCtx->sMb.pNzc[]");
-    pCtx->sMb.pNzcRs[i] = (int8_t (*)[24])pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (int8_t) * 24,
-                          "pCtx->sMb.pNzcRs[]");
-    pCtx->sMb.pScaledTCoeff[i] = (int16_t (*)[MB_COEFF_LIST_SIZE])pMa->WelsMallocz (pCtx->sMb.iMbWidth *
-                                 pCtx->sMb.iMbHeight *
-                                 sizeof (int16_t) * MB_COEFF_LIST_SIZE, "pCtx->sMb.pScaledTCoeff[]");
-    pCtx->sMb.pIntraPredMode[i] = (int8_t (*)[8])pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (
-                                    int8_t) * 8,
-                                  "pCtx->sMb.pIntraPredMode[]");
-    pCtx->sMb.pIntra4x4FinalMode[i] = (int8_t (*)[MB_BLOCK4x4_NUM])pMa->WelsMallocz (pCtx->sMb.iMbWidth *
-                                      pCtx->sMb.iMbHeight *
-                                      sizeof (int8_t) * MB_BLOCK4x4_NUM, "pCtx->sMb.pIntra4x4FinalMode[]");
-    pCtx->sMb.pIntraNxNAvailFlag[i] = (uint8_t (*))pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (
-                                        int8_t),
-                                      "pCtx->sMb.pIntraNxNAvailFlag");
-    pCtx->sMb.pChromaPredMode[i] = (int8_t*)pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (int8_t),
-                                   "pCtx->sMb.pChromaPredMode[]");
-    pCtx->sMb.pCbp[i] = (int8_t*)pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (int8_t),
-                        "pCtx->sMb.pCbp[]");
-    pCtx->sMb.pSubMbType[i] = (int8_t (*)[MB_PARTITION_SIZE])pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight *
-                              sizeof (
-                                int8_t) * MB_PARTITION_SIZE, "pCtx->sMb.pSubMbType[]");
-    pCtx->sMb.pSliceIdc[i] = (int32_t*) pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (int32_t),
-                             "pCtx->sMb.pSliceIdc[]"); // using int32_t for slice_idc, 4/21/2010
-    pCtx->sMb.pResidualPredFlag[i] = (int8_t*) pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (int8_t),
-                                     "pCtx->sMb.pResidualPredFlag[]");
-    pCtx->sMb.pInterPredictionDoneFlag[i] = (int8_t*) pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (
-        int8_t), "pCtx->sMb.pInterPredictionDoneFlag[]");
-
-    pCtx->sMb.pMbCorrectlyDecodedFlag[i] = (bool*) pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (
-        bool),
-                                           "pCtx->sMb.pMbCorrectlyDecodedFlag[]");
-    pCtx->sMb.pMbRefConcealedFlag[i] = (bool*) pMa->WelsMallocz (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (bool),
-                                       "pCtx->pMbRefConcealedFlag[]");
-
-    // check memory block valid due above allocated..
-    WELS_VERIFY_RETURN_IF (ERR_INFO_OUT_OF_MEMORY,
-                           ((NULL == pCtx->sMb.pMbType[i]) ||
-                            (NULL == pCtx->sMb.pMv[i][0]) ||
-                            (NULL == pCtx->sMb.pRefIndex[i][0]) ||
-                            (NULL == pCtx->sMb.pLumaQp[i]) ||
-                            (NULL == pCtx->sMb.pNoSubMbPartSizeLessThan8x8Flag[i]) ||
-                            (NULL == pCtx->sMb.pTransformSize8x8Flag[i]) ||
-                            (NULL == pCtx->sMb.pChromaQp[i]) ||
-                            (NULL == pCtx->sMb.pMvd[i][0]) ||
-                            (NULL == pCtx->sMb.pCbfDc[i]) ||
-                            (NULL == pCtx->sMb.pNzc[i]) ||
-                            (NULL == pCtx->sMb.pNzcRs[i]) ||
-                            (NULL == pCtx->sMb.pScaledTCoeff[i]) ||
-                            (NULL == pCtx->sMb.pIntraPredMode[i]) ||
-                            (NULL == pCtx->sMb.pIntra4x4FinalMode[i]) ||
-                            (NULL == pCtx->sMb.pIntraNxNAvailFlag[i]) ||
-                            (NULL == pCtx->sMb.pChromaPredMode[i]) ||
-                            (NULL == pCtx->sMb.pCbp[i]) ||
-                            (NULL == pCtx->sMb.pSubMbType[i]) ||
-                            (NULL == pCtx->sMb.pSliceIdc[i]) ||
-                            (NULL == pCtx->sMb.pResidualPredFlag[i]) ||
-                            (NULL == pCtx->sMb.pInterPredictionDoneFlag[i]) ||
-                            (NULL == pCtx->sMb.pMbRefConcealedFlag[i]) ||
-                            (NULL == pCtx->sMb.pMbCorrectlyDecodedFlag[i])
-                           )
-                          )
-
-    memset (pCtx->sMb.pSliceIdc[i], 0xff, (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (int32_t)));
+  if (pMb->pNoSubMbPartSizeLessThan8x8Flag[kiIdx]) {
+    pMa->WelsFree (pMb->pNoSubMbPartSizeLessThan8x8Flag[kiIdx], "pCtx->sMb.pNoSubMbPartSizeLessThan8x8Flag[]");
 
-    ++ i;
-  } while (i < LAYER_NUM_EXCHANGEABLE);
+    pMb->pNoSubMbPartSizeLessThan8x8Flag[kiIdx] = NULL;
+  }
 
-  pCtx->bInitialDqLayersMem     = true;
-  pCtx->iPicWidthReq            = kiMaxWidth;
-  pCtx->iPicHeightReq           = kiMaxHeight;
+  if (pMb->pTransformSize8x8Flag[kiIdx]) {
+    pMa->WelsFree (pMb->pTransformSize8x8Flag[kiIdx], "pCtx->sMb.pTransformSize8x8Flag[]");
 
-  return ERR_NONE;
-}
+    pMb->pTransformSize8x8Flag[kiIdx] = NULL;
+  }
 
-void UninitialDqLayersContext (PWelsDecoderContext pCtx) {
-  int32_t i = 0;
-  CMemoryAlign* pMa = pCtx->pMemAlign;
+  if (pMb->pLumaQp[kiIdx]) {
+    pMa->WelsFree (pMb->pLumaQp[kiIdx], "pCtx->sMb.pLumaQp[]");
 
-  do {
-    PDqLayer pDq = pCtx->pDqLayersList[i];
-    if (pDq == NULL) {
-      ++ i;
-      continue;
-    }
+    pMb->pLumaQp[kiIdx] = NULL;
+  }
 
-    if (pCtx->sMb.pMbType[i]) {
-      pMa->WelsFree (pCtx->sMb.pMbType[i], "pCtx->sMb.pMbType[]");
+  if (pMb->pChromaQp[kiIdx]) {
+    pMa->WelsFree (pMb->pChromaQp[kiIdx], "pCtx->sMb.pChromaQp[]");
 
-      pCtx->sMb.pMbType[i] = NULL;
-    }
+    pMb->pChromaQp[kiIdx] = NULL;
+  }
 
-    if (pCtx->sMb.pMv[i][0]) {
-      pMa->WelsFree (pCtx->sMb.pMv[i][0], "pCtx->sMb.pMv[][]");
+  if (pMb->pMvd[kiIdx][0]) {
+    pMa->WelsFree (pMb->pMvd[kiIdx][0], "pCtx->sMb.pMvd[][]");
+    pMb->pMvd[kiIdx][0] = NULL;
+  }
 
-      pCtx->sMb.pMv[i][0] = NULL;
-    }
+  if (pMb->pCbfDc[kiIdx]) {
+    pMa->WelsFree (pMb->pCbfDc[kiIdx], "pCtx->sMb.pCbfDc[]");
+    pMb->pCbfDc[kiIdx] = NULL;
+  }
 
-    if (pCtx->sMb.pRefIndex[i][0]) {
-      pMa->WelsFree (pCtx->sMb.pRefIndex[i][0], "pCtx->sMb.pRefIndex[][]");
+  if (pMb->pNzc[kiIdx]) {
+    pMa->WelsFree (pMb->pNzc[kiIdx], "pCtx->sMb.pNzc[]");
 
-      pCtx->sMb.pRefIndex[i][0] = NULL;
-    }
+    pMb->pNzc[kiIdx] = NULL;
+  }
 
-    if (pCtx->sMb.pNoSubMbPartSizeLessThan8x8Flag[i]) {
-      pMa->WelsFree (pCtx->sMb.pNoSubMbPartSizeLessThan8x8Flag[i], "pCtx->sMb.pNoSubMbPartSizeLessThan8x8Flag[]");
+  if (pMb->pNzcRs[kiIdx]) {
+    pMa->WelsFree (pMb->pNzcRs[kiIdx], "pCtx->sMb.pNzcRs[]");
 
-      pCtx->sMb.pNoSubMbPartSizeLessThan8x8Flag[i] = NULL;
-    }
+    pMb->pNzcRs[kiIdx] = NULL;
+  }
 
-    if (pCtx->sMb.pTransformSize8x8Flag[i]) {
-      pMa->WelsFree (pCtx->sMb.pTransformSize8x8Flag[i], "pCtx->sMb.pTransformSize8x8Flag[]");
+  if (pMb->pScaledTCoeff[kiIdx]) {
+    pMa->WelsFree (pMb->pScaledTCoeff[kiIdx], "pCtx->sMb.pScaledTCoeff[]");
 
-      pCtx->sMb.pTransformSize8x8Flag[i] = NULL;
-    }
+    pMb->pScaledTCoeff[kiIdx] = NULL;
+  }
 
-    if (pCtx->sMb.pLumaQp[i]) {
-      pMa->WelsFree (pCtx->sMb.pLumaQp[i], "pCtx->sMb.pLumaQp[]");
+  if (pMb->pIntraPredMode[kiIdx]) {
+    pMa->WelsFree (pMb->pIntraPredMode[kiIdx], "pCtx->sMb.pIntraPredMode[]");
 
-      pCtx->sMb.pLumaQp[i] = NULL;
-    }
+    pMb->pIntraPredMode[kiIdx] = NULL;
+  }
 
-    if (pCtx->sMb.pChromaQp[i]) {
-      pMa->WelsFree (pCtx->sMb.pChromaQp[i], "pCtx->sMb.pChromaQp[]");
+  if (pMb->pIntra4x4FinalMode[kiIdx]) {
+    pMa->WelsFree (pMb->pIntra4x4FinalMode[kiIdx], "pCtx->sMb.pIntra4x4FinalMode[]");
 
-      pCtx->sMb.pChromaQp[i] = NULL;
-    }
+    pMb->pIntra4x4FinalMode[kiIdx] = NULL;
+  }
 
-    if (pCtx->sMb.pMvd[i][0]) {
-      pMa->WelsFree (pCtx->sMb.pMvd[i][0], "pCtx->sMb.pMvd[][]");
-      pCtx->sMb.pMvd[i][0] = NULL;
-    }
+  if (pMb->pIntraNxNAvailFlag[kiIdx]) {
+    pMa->WelsFree (pMb->pIntraNxNAvailFlag[kiIdx], "pCtx->sMb.pIntraNxNAvailFlag");
 
-    if (pCtx->sMb.pCbfDc[i]) {
-      pMa->WelsFree (pCtx->sMb.pCbfDc[i], "pCtx->sMb.pCbfDc[]");
-      pCtx->sMb.pCbfDc[i] = NULL;
-    }
+    pMb->pIntraNxNAvailFlag[kiIdx] = NULL;
+  }
 
-    if (pCtx->sMb.pNzc[i]) {
-      pMa->WelsFree (pCtx->sMb.pNzc[i], "pCtx->sMb.pNzc[]");
+  if (pMb->pChromaPredMode[kiIdx]) {
+    pMa->WelsFree (pMb->pChromaPredMode[kiIdx], "pCtx->sMb.pChromaPredMode[]");
 
-      pCtx->sMb.pNzc[i] = NULL;
-    }
+    pMb->pChromaPredMode[kiIdx] = NULL;
+  }
 
-    if (pCtx->sMb.pNzcRs[i]) {
-      pMa->WelsFree (pCtx->sMb.pNzcRs[i], "pCtx->sMb.pNzcRs[]");
+  if (pMb->pCbp[kiIdx]) {
+    pMa->WelsFree (pMb->pCbp[kiIdx], "pCtx->sMb.pCbp[]");
 
-      pCtx->sMb.pNzcRs[i] = NULL;
-    }
+    pMb->pCbp[kiIdx] = NULL;
+  }
 
-    if (pCtx->sMb.pScaledTCoeff[i]) {
-      pMa->WelsFree (pCtx->sMb.pScaledTCoeff[i], "pCtx->sMb.pScaledTCoeff[]");
+  //      if (pMb->pMotionPredFlag[kiIdx])
+  //{
+  //  pMa->WelsFree( pMb->pMotionPredFlag[kiIdx], "pCtx->sMb.pMotionPredFlag[]" );
 
-      pCtx->sMb.pScaledTCoeff[i] = NULL;
-    }
+  //  pMb->pMotionPredFlag[kiIdx] = NULL;
+  //}
 
-    if (pCtx->sMb.pIntraPredMode[i]) {
-      pMa->WelsFree (pCtx->sMb.pIntraPredMode[i], "pCtx->sMb.pIntraPredMode[]");
+  if (pMb->pSubMbType[kiIdx]) {
+    pMa->WelsFree (pMb->pSubMbType[kiIdx], "pCtx->sMb.pSubMbType[]");
 
-      pCtx->sMb.pIntraPredMode[i] = NULL;
-    }
+    pMb->pSubMbType[kiIdx] = NULL;
+  }
 
-    if (pCtx->sMb.pIntra4x4FinalMode[i]) {
-      pMa->WelsFree (pCtx->sMb.pIntra4x4FinalMode[i], "pCtx->sMb.pIntra4x4FinalMode[]");
+  if (pMb->pSliceIdc[kiIdx]) {
+    pMa->WelsFree (pMb->pSliceIdc[kiIdx], "pCtx->sMb.pSliceIdc[]");
 
-      pCtx->sMb.pIntra4x4FinalMode[i] = NULL;
-    }
+    pMb->pSliceIdc[kiIdx] = NULL;
+  }
 
-    if (pCtx->sMb.pIntraNxNAvailFlag[i]) {
-      pMa->WelsFree (pCtx->sMb.pIntraNxNAvailFlag[i], "pCtx->sMb.pIntraNxNAvailFlag");
+  if (pMb->pResidualPredFlag[kiIdx]) {
+    pMa->WelsFree (pMb->pResidualPredFlag[kiIdx], "pCtx->sMb.pResidualPredFlag[]");
 
-      pCtx->sMb.pIntraNxNAvailFlag[i] = NULL;
-    }
+    pMb->pResidualPredFlag[kiIdx] = NULL;
+  }
 
-    if (pCtx->sMb.pChromaPredMode[i]) {
-      pMa->WelsFree (pCtx->sMb.pChromaPredMode[i], "pCtx->sMb.pChromaPredMode[]");
+  if (pMb->pInterPredictionDoneFlag[kiIdx]) {
+    pMa->WelsFree (pMb->pInterPredictionDoneFlag[kiIdx], "pCtx->sMb.pInterPredictionDoneFlag[]");
 
-      pCtx->sMb.pChromaPredMode[i] = NULL;
-    }
+    pMb->pInterPredictionDoneFlag[kiIdx] = NULL;
+  }
 
-    if (pCtx->sMb.pCbp[i]) {
-      pMa->WelsFree (pCtx->sMb.pCbp[i], "pCtx->sMb.pCbp[]");
+  if (pMb->pMbCorrectlyDecodedFlag[kiIdx]) {
+    pMa->WelsFree (pMb->pMbCorrectlyDecodedFlag[kiIdx], "pCtx->sMb.pMbCorrectlyDecodedFlag[]");
+    pMb->pMbCorrectlyDecodedFlag[kiIdx] = NULL;
+  }
 
-      pCtx->sMb.pCbp[i] = NULL;
-    }
+  if (pMb->pMbRefConcealedFlag[kiIdx]) {
+    pMa->WelsFree (pMb->pMbRefConcealedFlag[kiIdx], "pCtx->sMb.pMbRefConcealedFlag[]");
+    pMb->pMbRefConcealedFlag[kiIdx] = NULL;
+  }
+}
 
-    //      if (pCtx->sMb.pMotionPredFlag[i])
-    //{
-    //  pMa->WelsFree( pCtx->sMb.pMotionPredFlag[i], "pCtx->sMb.pMotionPredFlag[]" );
+int32_t InitialDqLayersContext (PWelsDecoderContext pCtx, const int32_t kiMaxWidth, const int32_t kiMaxHeight) {
+  int32_t i = 0;
 
-    //  pCtx->sMb.pMotionPredFlag[i] = NULL;
-    //}
+  WELS_VERIFY_RETURN_IF (ERR_INFO_INVALID_PARAM, (NULL == pCtx || kiMaxWidth <= 0 || kiMaxHeight <= 0))
+  pCtx->sMb.iMbWidth  = (kiMaxWidth + 15) >> 4;
+  pCtx->sMb.iMbHeight = (kiMaxHeight + 15) >> 4;
 
-    if (pCtx->sMb.pSubMbType[i]) {
-      pMa->WelsFree (pCtx->sMb.pSubMbType[i], "pCtx->sMb.pSubMbType[]");
+  if (pCtx->bInitialDqLayersMem && kiMaxWidth <= pCtx->iPicWidthReq
+      && kiMaxHeight <= pCtx->iPicHeightReq) // have same dimension memory, skipped
+    return ERR_NONE;
 
-      pCtx->sMb.pSubMbType[i] = NULL;
-    }
+  CMemoryAlign* pMa = pCtx->pMemAlign;
 
-    if (pCtx->sMb.pSliceIdc[i]) {
-      pMa->WelsFree (pCtx->sMb.pSliceIdc[i], "pCtx->sMb.pSliceIdc[]");
+  UninitialDqLayersContext (pCtx);
 
-      pCtx->sMb.pSliceIdc[i] = NULL;
-    }
+  do {
+    PDqLayer pDq = (PDqLayer)pMa->WelsMallocz (sizeof (SDqLayer), "PDqLayer");
 
-    if (pCtx->sMb.pResidualPredFlag[i]) {
-      pMa->WelsFree (pCtx->sMb.pResidualPredFlag[i], "pCtx->sMb.pResidualPredFlag[]");
+    if (pDq == NULL)
+      return ERR_INFO_OUT_OF_MEMORY;
 
-      pCtx->sMb.pResidualPredFlag[i] = NULL;
-    }
+    pCtx->pDqLayersList[i] = pDq; //to keep consistence with in UninitialDqLayersContext()
+    memset (pDq, 0, sizeof (SDqLayer));
 
-    if (pCtx->sMb.pInterPredictionDoneFlag[i]) {
-      pMa->WelsFree (pCtx->sMb.pInterPredictionDoneFlag[i], "pCtx->sMb.pInterPredictionDoneFlag[]");
+    WELS_VERIFY_RETURN_IF (ERR_INFO_OUT_OF_MEMORY, InitialMbBuffer (pMa, &pCtx->sMb, i))
 
-      pCtx->sMb.pInterPredictionDoneFlag[i] = NULL;
-    }
+    ++ i;
+  } while (i < LAYER_NUM_EXCHANGEABLE);
 
-    if (pCtx->sMb.pMbCorrectlyDecodedFlag[i]) {
-      pMa->WelsFree (pCtx->sMb.pMbCorrectlyDecodedFlag[i], "pCtx->sMb.pMbCorrectlyDecodedFlag[]");
-      pCtx->sMb.pMbCorrectlyDecodedFlag[i] = NULL;
-    }
+  pCtx->bInitialDqLayersMem     = true;
+  pCtx->iPicWidthReq            = kiMaxWidth;
+  pCtx->iPicHeightReq           = kiMaxHeight;
 
-    if (pCtx->sMb.pMbRefConcealedFlag[i]) {
-      pMa->WelsFree (pCtx->sMb.pMbRefConcealedFlag[i], "pCtx->sMb.pMbRefConcealedFlag[]");
-      pCtx->sMb.pMbRefConcealedFlag[i] = NULL;
+  return ERR_NONE;
+}
+
+void UninitialDqLayersContext (PWelsDecoderContext pCtx) {
+  int32_t i = 0;
+  CMemoryAlign* pMa = pCtx->pMemAlign;
+
+  do {
+    PDqLayer pDq = pCtx->pDqLayersList[i];
+    if (pDq == NULL) {
+      ++ i;
+      continue;
     }
+
+    UninitialMbBuffer (pMa, &pCtx->sMb, i);
     pMa->WelsFree (pDq, "pDq");
 
     pDq = NULL;
@@ -2094,6 +2181,27 @@ void DecodeFinishUpdate (PWelsDecoderContext pCtx) {
     ResetActiveSPSForEachLayer (pCtx);
 }
 
+/*
+ * IsAccessUnitSkipped
+ * whether the access unit is left out because of DECODER_OPTION_SKIP_FRAMES; nothing decoded afterwards
+ * refers to it: a non-reference picture by definition, any picture up to the next IDR otherwise.
+ * frame_num is only tracked for the reference pictures and an IDR starts over, so the gap check still holds.
+ */
+static bool IsAccessUnitSkipped (PWelsDecoderContext pCtx) {
+  PAccessUnit pCurAu = pCtx->pAccessUnitList;
+  PNalUnitHeaderExt pNalHdrExt = &pCurAu->pNalUnitsList[pCurAu->uiStartPos]->sNalHeaderExt;
+  if (pCtx->pParam->bParseOnly)
+    return false;
+  switch (pCtx->eSkipMode) {
+  case DECODER_SKIP_NON_REF:
+    return pNalHdrExt->sNalUnitHeader.uiNalRefIdc == 0;
+  case DECODER_SKIP_NON_IDR:
+    return !pNalHdrExt->bIdrFlag && pNalHdrExt->sNalUnitHeader.eNalUnitType != NAL_UNIT_CODED_SLICE_IDR;
+  default:
+    return false;
+  }
+}
+
 /*
  * ConstructAccessUnit
  * construct an access unit for given input bitstream, maybe partial NAL Unit, one or more Units are involved to
@@ -2127,6 +2235,13 @@ int32_t ConstructAccessUnit (PWelsDecoderContext pCtx, uint8_t** ppDst, SBufferI
     return iErr;
   }
 
+  if (IsAccessUnitSkipped (pCtx)) {
+    // a new sequence is kept pending for the next picture decoded
+    pCtx->sDecoderStatistics.uiSkippedFrameNum++;
+    WelsDecodeAccessUnitEnd (pCtx);
+    return ERR_NONE;
+  }
+
   pCtx->pSps = pCurAu->pNalUnitsList[pCurAu->uiStartPos]->sNalData.sVclNal.sSliceHeaderExt.sSliceHeader.pSps;
   pCtx->pPps = pCurAu->pNalUnitsList[pCurAu->uiStartPos]->sNalData.sVclNal.sSliceHeaderExt.sSliceHeader.pPps;
 
@@ -2290,6 +2405,10 @@ int32_t DecodeCurrentAccessUnit (PWelsDecoderContext pCtx, uint8_t** ppDst, SBuf
 
     if (pCtx->pDec == NULL) {
       pCtx->pDec = PrefetchPic (pCtx->pPicBuff[0]);
+      if (NULL == pCtx->pDec && NULL != pCtx->pThreadCtx)
+        pCtx->pDec = WelsDecThreadPrefetchPic (pCtx);
+      if (NULL != pCtx->pDec && ERR_NONE != RenewPicBuffer (pCtx, pCtx->pDec))
+        pCtx->pDec = NULL;
       if (pCtx->iTotalNumMbRec != 0)
         pCtx->iTotalNumMbRec = 0;
 
@@ -2308,6 +2427,15 @@ int32_t DecodeCurrentAccessUnit (PWelsDecoderContext pCtx, uint8_t** ppDst, SBuf
     pCtx->pDec->uiTimeStamp = pNalCur->uiTimeStamp;
 
     if (pCtx->iTotalNumMbRec == 0) { //Picture start to decode
+      if (pCtx->pThreadCtx)
+        WelsDecThreadStartPicture (pCtx);
+      else if (pCtx->pParam->bFastPreview) {
+        // pad as far as the motion of the last inter picture reached, BaseMC widens the margin of a reference on demand
+        if (pCtx->iPreviewMvReach >= 0)
+          pCtx->iPreviewPaddingLen = WELS_CLIP3 (WELS_ALIGN (pCtx->iPreviewMvReach, 16), 16, PADDING_LENGTH);
+        pCtx->iPreviewMvReach = -1;
+        pCtx->pDec->iPaddingLen = pCtx->iPreviewPaddingLen;
+      }
       for (int32_t i = 0; i < LAYER_NUM_EXCHANGEABLE; ++ i)
         memset (pCtx->sMb.pSliceIdc[i], 0xff, (pCtx->sMb.iMbWidth * pCtx->sMb.iMbHeight * sizeof (int32_t)));
       memset (pCtx->pCurDqLayer->pMbCorrectlyDecodedFlag, 0, pCtx->pSps->iMbWidth * pCtx->pSps->iMbHeight * sizeof (bool));
@@ -2360,6 +2488,8 @@ int32_t DecodeCurrentAccessUnit (PWelsDecoderContext pCtx, uint8_t** ppDst, SBuf
       pCtx->pFmo = &pCtx->sFmoList[iPpsId];
       iRet = FmoParamUpdate (pCtx->pFmo, pLayerInfo.pSps, pLayerInfo.pPps, &pCtx->iActiveFmoNum, pCtx->pMemAlign);
       if (ERR_NONE != iRet) {
+        if (pCtx->pThreadCtx != NULL)
+          WelsDecThreadDecodeSlices (pCtx, &bAllRefComplete);
         if (iRet == ERR_INFO_OUT_OF_MEMORY) {
           pCtx->iErrorCode |= dsOutOfMemory;
           WelsLog (& (pCtx->sLogCtx), WELS_LOG_ERROR, "DecodeCurrentAccessUnit(), Fmo param alloc failed");
@@ -2398,6 +2528,8 @@ int32_t DecodeCurrentAccessUnit (PWelsDecoderContext pCtx, uint8_t** ppDst, SBuf
             bAllRefComplete = false;
             pCtx->iErrorCode |= dsRefLost;
             if (pCtx->pParam->eEcActiveIdc == ERROR_CON_DISABLE) {
+              if (pCtx->pThreadCtx != NULL)
+                WelsDecThreadDecodeSlices (pCtx, &bAllRefComplete);
 #ifdef LONG_TERM_REF
               pCtx->bParamSetsLostFlag = true;
 #else
@@ -2418,6 +2550,8 @@ int32_t DecodeCurrentAccessUnit (PWelsDecoderContext pCtx, uint8_t** ppDst, SBuf
                      "reference picture introduced by this frame is lost during transmission! uiTId: %d",
                      pNalCur->sNalHeaderExt.uiTemporalId);
             if (pCtx->pParam->eEcActiveIdc == ERROR_CON_DISABLE) {
+              if (pCtx->pThreadCtx != NULL)
+                WelsDecThreadDecodeSlices (pCtx, &bAllRefComplete);
               if (pCtx->iTotalNumMbRec == 0)
                 pCtx->pDec = NULL;
               return iRet;
@@ -2425,34 +2559,19 @@ int32_t DecodeCurrentAccessUnit (PWelsDecoderContext pCtx, uint8_t** ppDst, SBuf
           }
         }
 
-        iRet = WelsDecodeSlice (pCtx, bFreshSliceAvailable, pNalCur);
-
-        //Output good store_base reconstruction when enhancement quality layer occurred error for MGS key picture case
-        if (iRet != ERR_NONE) {
-          WelsLog (& (pCtx->sLogCtx), WELS_LOG_WARNING,
-                   "DecodeCurrentAccessUnit() failed (%d) in frame: %d uiDId: %d uiQId: %d",
-                   iRet, pSh->iFrameNum, iCurrIdD, iCurrIdQ);
-          bAllRefComplete = false;
-          HandleReferenceLostL0 (pCtx, pNalCur);
-          if (pCtx->pParam->eEcActiveIdc == ERROR_CON_DISABLE) {
-            if (pCtx->iTotalNumMbRec == 0)
-              pCtx->pDec = NULL;
+        if (bReconstructSlice && pCtx->pThreadCtx != NULL
+            && WelsDecThreadQueueSlice (pCtx, pNalCur, bFreshSliceAvailable)) {
+          // parsed and reconstructed by the slice threads, see WelsDecThreadDecodeSlices()
+        } else {
+          if (pCtx->pThreadCtx != NULL && (iRet = WelsDecThreadDecodeSlices (pCtx, &bAllRefComplete)) != ERR_NONE)
             return iRet;
-          }
-        }
-
-        if (bReconstructSlice) {
-          if ((iRet = WelsDecodeConstructSlice (pCtx, pNalCur)) != ERR_NONE) {
-            pCtx->pDec->bIsComplete = false; // reconstruction error, directly set the flag false
+          const int64_t kiParseStart = WelsStageStart (pCtx);
+          iRet = WelsDecodeSlice (pCtx, bFreshSliceAvailable, pNalCur);
+          WelsStageEnd (pCtx, DECODER_STAGE_MB_PARSE, kiParseStart);
+          pCtx->sStageTiming.uiParsedMbCount += dq_cur->sLayerInfo.sSliceInLayer.iTotalMbInCurSlice;
+          iRet = WelsDecodeSliceFinish (pCtx, pNalCur, iRet, bReconstructSlice, &bAllRefComplete);
+          if (iRet != ERR_NONE)
             return iRet;
-          }
-        }
-        if (bAllRefComplete && pCtx->eSliceType != I_SLICE) {
-          if (pCtx->sRefPic.uiRefCount[LIST_0] > 0) {
-            bAllRefComplete &= CheckRefPicturesComplete (pCtx);
-          } else {
-            bAllRefComplete = false;
-          }
         }
       }
 #if defined (_DEBUG) &&  !defined (CODEC_FOR_TESTBED)
@@ -2476,6 +2595,9 @@ int32_t DecodeCurrentAccessUnit (PWelsDecoderContext pCtx, uint8_t** ppDst, SBuf
         break;
     }
 
+    if (pCtx->pThreadCtx != NULL && (iRet = WelsDecThreadDecodeSlices (pCtx, &bAllRefComplete)) != ERR_NONE)
+      return iRet;
+
     // Set the current dec picture complete flag. The flag will be reset when current picture need do ErrorCon.
     pCtx->pDec->bIsComplete = bAllRefComplete;
     if (!pCtx->pDec->bIsComplete) {  // Ref pictures ECed, result in ECed
@@ -2495,6 +2617,8 @@ int32_t DecodeCurrentAccessUnit (PWelsDecoderContext pCtx, uint8_t** ppDst, SBuf
         if (!pCtx->pParam->bParseOnly) {
           //Do error concealment here
           if ((NeedErrorCon (pCtx)) && (pCtx->pParam->eEcActiveIdc != ERROR_CON_DISABLE)) {
+            if (pCtx->pThreadCtx)
+              WelsDecThreadSyncPicture (pCtx);
             ImplementErrorCon (pCtx);
             pCtx->iTotalNumMbRec = pCtx->pSps->iMbWidth * pCtx->pSps->iMbHeight;
             pCtx->pDec->iSpsId = pCtx->pSps->iSpsId;
@@ -2507,6 +2631,9 @@ int32_t DecodeCurrentAccessUnit (PWelsDecoderContext pCtx, uint8_t** ppDst, SBuf
       if (iRet)
         return iRet;
 
+      const bool kbDeferredRecon = pCtx->bDeferSliceRecon; // padding is then done by the frame thread
+      if (pCtx->pThreadCtx)
+        WelsDecThreadFinishPicture (pCtx, uiNalRefIdc > 0, ppDst, pDstInfo);
       pCtx->pPreviousDecodedPictureInDpb = pCtx->pDec; //store latest decoded picture for EC
       if (uiNalRefIdc > 0) {
         iRet = WelsMarkAsRef (pCtx);
@@ -2518,10 +2645,8 @@ int32_t DecodeCurrentAccessUnit (PWelsDecoderContext pCtx, uint8_t** ppDst, SBuf
             return iRet;
           }
         }
-        if (!pCtx->pParam->bParseOnly)
-          ExpandReferencingPicture (pCtx->pDec->pData, pCtx->pDec->iWidthInPixel, pCtx->pDec->iHeightInPixel,
-                                    pCtx->pDec->iLinesize,
-                                    pCtx->sExpandPicFunc.pfExpandLumaPicture, pCtx->sExpandPicFunc.pfExpandChromaPicture);
+        if (!pCtx->pParam->bParseOnly && !kbDeferredRecon)
+          WelsExpandDecodedPicture (pCtx);
       }
       pCtx->pDec = NULL; //after frame decoding, always set to NULL
     }
@@ -2564,12 +2689,16 @@ bool CheckAndFinishLastPic (PWelsDecoderContext pCtx, uint8_t** ppDst, SBufferIn
   //Do Error Concealment here
   if (bAuBoundaryFlag && (pCtx->iTotalNumMbRec != 0) && NeedErrorCon (pCtx)) { //AU ready but frame not completely reconed
     if (pCtx->pParam->eEcActiveIdc != ERROR_CON_DISABLE) {
+      if (pCtx->pThreadCtx)
+        WelsDecThreadSyncPicture (pCtx);
       ImplementErrorCon (pCtx);
       pCtx->iTotalNumMbRec = pCtx->pSps->iMbWidth * pCtx->pSps->iMbHeight;
       pCtx->pDec->iSpsId = pCtx->pSps->iSpsId;
       pCtx->pDec->iPpsId = pCtx->pPps->iPpsId;
 
       DecodeFrameConstruction (pCtx, ppDst, pDstInfo);
+      if (pCtx->pThreadCtx)
+        WelsDecThreadFinishPicture (pCtx, false, ppDst, pDstInfo);
       pCtx->pPreviousDecodedPictureInDpb = pCtx->pDec; //save ECed pic for future use
       if (pCtx->sLastNalHdrExt.sNalUnitHeader.uiNalRefIdc > 0) {
         MarkECFrameAsRef (pCtx);
@@ -2586,6 +2715,8 @@ bool CheckAndFinishLastPic (PWelsDecoderContext pCtx, uint8_t** ppDst, SBufferIn
         pCtx->pDec = NULL;
         return false;
       }
+      if (pCtx->pThreadCtx)
+        WelsDecThreadFinishPicture (pCtx, false, ppDst, pDstInfo);
     }
     pCtx->pDec = NULL;
     if (pAu->pNalUnitsList[pAu->uiStartPos]->sNalHeaderExt.sNalUnitHeader.uiNalRefIdc > 0)
@@ -565,4 +565,381 @@ const uint8_t g_kuiZeroLeftBitNumMap[16] = {
   0, 1, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3
 };
 
+// CAVLC residual fast path, generated from the level_prefix/level_suffix rules of 9.2.2.1 and g_kuiZeroLeftTable*
+const int8_t g_kiCavlcLevelTable[7][256][2] = { // read 8 bits, {level, length | (next suffixLength << 4)}, length 0: escape
+  { // suffixLength 0
+    {0, 0x00}, {-4, 0x28}, {4, 0x27}, {4, 0x27}, {-3, 0x16}, {-3, 0x16}, {-3, 0x16}, {-3, 0x16}, {3, 0x15}, {3, 0x15}, {3, 0x15}, {3, 0x15}, {3, 0x15}, {3, 0x15}, {3, 0x15}, {3, 0x15},
+    {-2, 0x14}, {-2, 0x14}, {-2, 0x14}, {-2, 0x14}, {-2, 0x14}, {-2, 0x14}, {-2, 0x14}, {-2, 0x14}, {-2, 0x14}, {-2, 0x14}, {-2, 0x14}, {-2, 0x14}, {-2, 0x14}, {-2, 0x14}, {-2, 0x14}, {-2, 0x14},
+    {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13},
+    {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13},
+    {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12},
+    {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12},
+    {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12},
+    {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12},
+    {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11},
+    {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11},
+    {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11},
+    {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11},
+    {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11},
+    {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11},
+    {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11},
+    {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}, {1, 0x11}
+  },
+  { // suffixLength 1
+    {0, 0x00}, {0, 0x00}, {7, 0x28}, {-7, 0x28}, {6, 0x27}, {6, 0x27}, {-6, 0x27}, {-6, 0x27}, {5, 0x26}, {5, 0x26}, {5, 0x26}, {5, 0x26}, {-5, 0x26}, {-5, 0x26}, {-5, 0x26}, {-5, 0x26},
+    {4, 0x25}, {4, 0x25}, {4, 0x25}, {4, 0x25}, {4, 0x25}, {4, 0x25}, {4, 0x25}, {4, 0x25}, {-4, 0x25}, {-4, 0x25}, {-4, 0x25}, {-4, 0x25}, {-4, 0x25}, {-4, 0x25}, {-4, 0x25}, {-4, 0x25},
+    {3, 0x14}, {3, 0x14}, {3, 0x14}, {3, 0x14}, {3, 0x14}, {3, 0x14}, {3, 0x14}, {3, 0x14}, {3, 0x14}, {3, 0x14}, {3, 0x14}, {3, 0x14}, {3, 0x14}, {3, 0x14}, {3, 0x14}, {3, 0x14},
+    {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14},
+    {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13},
+    {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13}, {2, 0x13},
+    {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13},
+    {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13}, {-2, 0x13},
+    {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12},
+    {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12},
+    {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12},
+    {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12}, {1, 0x12},
+    {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12},
+    {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12},
+    {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12},
+    {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}, {-1, 0x12}
+  },
+  { // suffixLength 2
+    {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {11, 0x38}, {-11, 0x38}, {12, 0x38}, {-12, 0x38}, {9, 0x37}, {9, 0x37}, {-9, 0x37}, {-9, 0x37}, {10, 0x37}, {10, 0x37}, {-10, 0x37}, {-10, 0x37},
+    {7, 0x36}, {7, 0x36}, {7, 0x36}, {7, 0x36}, {-7, 0x36}, {-7, 0x36}, {-7, 0x36}, {-7, 0x36}, {8, 0x36}, {8, 0x36}, {8, 0x36}, {8, 0x36}, {-8, 0x36}, {-8, 0x36}, {-8, 0x36}, {-8, 0x36},
+    {5, 0x25}, {5, 0x25}, {5, 0x25}, {5, 0x25}, {5, 0x25}, {5, 0x25}, {5, 0x25}, {5, 0x25}, {-5, 0x25}, {-5, 0x25}, {-5, 0x25}, {-5, 0x25}, {-5, 0x25}, {-5, 0x25}, {-5, 0x25}, {-5, 0x25},
+    {6, 0x25}, {6, 0x25}, {6, 0x25}, {6, 0x25}, {6, 0x25}, {6, 0x25}, {6, 0x25}, {6, 0x25}, {-6, 0x25}, {-6, 0x25}, {-6, 0x25}, {-6, 0x25}, {-6, 0x25}, {-6, 0x25}, {-6, 0x25}, {-6, 0x25},
+    {3, 0x24}, {3, 0x24}, {3, 0x24}, {3, 0x24}, {3, 0x24}, {3, 0x24}, {3, 0x24}, {3, 0x24}, {3, 0x24}, {3, 0x24}, {3, 0x24}, {3, 0x24}, {3, 0x24}, {3, 0x24}, {3, 0x24}, {3, 0x24},
+    {-3, 0x24}, {-3, 0x24}, {-3, 0x24}, {-3, 0x24}, {-3, 0x24}, {-3, 0x24}, {-3, 0x24}, {-3, 0x24}, {-3, 0x24}, {-3, 0x24}, {-3, 0x24}, {-3, 0x24}, {-3, 0x24}, {-3, 0x24}, {-3, 0x24}, {-3, 0x24},
+    {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24},
+    {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24},
+    {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23},
+    {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23}, {1, 0x23},
+    {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23},
+    {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23}, {-1, 0x23},
+    {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23},
+    {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23}, {2, 0x23},
+    {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23},
+    {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}, {-2, 0x23}
+  },
+  { // suffixLength 3
+    {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {17, 0x48}, {-17, 0x48}, {18, 0x48}, {-18, 0x48}, {19, 0x48}, {-19, 0x48}, {20, 0x48}, {-20, 0x48},
+    {13, 0x47}, {13, 0x47}, {-13, 0x47}, {-13, 0x47}, {14, 0x47}, {14, 0x47}, {-14, 0x47}, {-14, 0x47}, {15, 0x47}, {15, 0x47}, {-15, 0x47}, {-15, 0x47}, {16, 0x47}, {16, 0x47}, {-16, 0x47}, {-16, 0x47},
+    {9, 0x36}, {9, 0x36}, {9, 0x36}, {9, 0x36}, {-9, 0x36}, {-9, 0x36}, {-9, 0x36}, {-9, 0x36}, {10, 0x36}, {10, 0x36}, {10, 0x36}, {10, 0x36}, {-10, 0x36}, {-10, 0x36}, {-10, 0x36}, {-10, 0x36},
+    {11, 0x36}, {11, 0x36}, {11, 0x36}, {11, 0x36}, {-11, 0x36}, {-11, 0x36}, {-11, 0x36}, {-11, 0x36}, {12, 0x36}, {12, 0x36}, {12, 0x36}, {12, 0x36}, {-12, 0x36}, {-12, 0x36}, {-12, 0x36}, {-12, 0x36},
+    {5, 0x35}, {5, 0x35}, {5, 0x35}, {5, 0x35}, {5, 0x35}, {5, 0x35}, {5, 0x35}, {5, 0x35}, {-5, 0x35}, {-5, 0x35}, {-5, 0x35}, {-5, 0x35}, {-5, 0x35}, {-5, 0x35}, {-5, 0x35}, {-5, 0x35},
+    {6, 0x35}, {6, 0x35}, {6, 0x35}, {6, 0x35}, {6, 0x35}, {6, 0x35}, {6, 0x35}, {6, 0x35}, {-6, 0x35}, {-6, 0x35}, {-6, 0x35}, {-6, 0x35}, {-6, 0x35}, {-6, 0x35}, {-6, 0x35}, {-6, 0x35},
+    {7, 0x35}, {7, 0x35}, {7, 0x35}, {7, 0x35}, {7, 0x35}, {7, 0x35}, {7, 0x35}, {7, 0x35}, {-7, 0x35}, {-7, 0x35}, {-7, 0x35}, {-7, 0x35}, {-7, 0x35}, {-7, 0x35}, {-7, 0x35}, {-7, 0x35},
+    {8, 0x35}, {8, 0x35}, {8, 0x35}, {8, 0x35}, {8, 0x35}, {8, 0x35}, {8, 0x35}, {8, 0x35}, {-8, 0x35}, {-8, 0x35}, {-8, 0x35}, {-8, 0x35}, {-8, 0x35}, {-8, 0x35}, {-8, 0x35}, {-8, 0x35},
+    {1, 0x34}, {1, 0x34}, {1, 0x34}, {1, 0x34}, {1, 0x34}, {1, 0x34}, {1, 0x34}, {1, 0x34}, {1, 0x34}, {1, 0x34}, {1, 0x34}, {1, 0x34}, {1, 0x34}, {1, 0x34}, {1, 0x34}, {1, 0x34},
+    {-1, 0x34}, {-1, 0x34}, {-1, 0x34}, {-1, 0x34}, {-1, 0x34}, {-1, 0x34}, {-1, 0x34}, {-1, 0x34}, {-1, 0x34}, {-1, 0x34}, {-1, 0x34}, {-1, 0x34}, {-1, 0x34}, {-1, 0x34}, {-1, 0x34}, {-1, 0x34},
+    {2, 0x34}, {2, 0x34}, {2, 0x34}, {2, 0x34}, {2, 0x34}, {2, 0x34}, {2, 0x34}, {2, 0x34}, {2, 0x34}, {2, 0x34}, {2, 0x34}, {2, 0x34}, {2, 0x34}, {2, 0x34}, {2, 0x34}, {2, 0x34},
+    {-2, 0x34}, {-2, 0x34}, {-2, 0x34}, {-2, 0x34}, {-2, 0x34}, {-2, 0x34}, {-2, 0x34}, {-2, 0x34}, {-2, 0x34}, {-2, 0x34}, {-2, 0x34}, {-2, 0x34}, {-2, 0x34}, {-2, 0x34}, {-2, 0x34}, {-2, 0x34},
+    {3, 0x34}, {3, 0x34}, {3, 0x34}, {3, 0x34}, {3, 0x34}, {3, 0x34}, {3, 0x34}, {3, 0x34}, {3, 0x34}, {3, 0x34}, {3, 0x34}, {3, 0x34}, {3, 0x34}, {3, 0x34}, {3, 0x34}, {3, 0x34},
+    {-3, 0x34}, {-3, 0x34}, {-3, 0x34}, {-3, 0x34}, {-3, 0x34}, {-3, 0x34}, {-3, 0x34}, {-3, 0x34}, {-3, 0x34}, {-3, 0x34}, {-3, 0x34}, {-3, 0x34}, {-3, 0x34}, {-3, 0x34}, {-3, 0x34}, {-3, 0x34},
+    {4, 0x34}, {4, 0x34}, {4, 0x34}, {4, 0x34}, {4, 0x34}, {4, 0x34}, {4, 0x34}, {4, 0x34}, {4, 0x34}, {4, 0x34}, {4, 0x34}, {4, 0x34}, {4, 0x34}, {4, 0x34}, {4, 0x34}, {4, 0x34},
+    {-4, 0x34}, {-4, 0x34}, {-4, 0x34}, {-4, 0x34}, {-4, 0x34}, {-4, 0x34}, {-4, 0x34}, {-4, 0x34}, {-4, 0x34}, {-4, 0x34}, {-4, 0x34}, {-4, 0x34}, {-4, 0x34}, {-4, 0x34}, {-4, 0x34}, {-4, 0x34}
+  },
+  { // suffixLength 4
+    {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00},
+    {25, 0x58}, {-25, 0x58}, {26, 0x58}, {-26, 0x58}, {27, 0x58}, {-27, 0x58}, {28, 0x58}, {-28, 0x58}, {29, 0x58}, {-29, 0x58}, {30, 0x58}, {-30, 0x58}, {31, 0x58}, {-31, 0x58}, {32, 0x58}, {-32, 0x58},
+    {17, 0x47}, {17, 0x47}, {-17, 0x47}, {-17, 0x47}, {18, 0x47}, {18, 0x47}, {-18, 0x47}, {-18, 0x47}, {19, 0x47}, {19, 0x47}, {-19, 0x47}, {-19, 0x47}, {20, 0x47}, {20, 0x47}, {-20, 0x47}, {-20, 0x47},
+    {21, 0x47}, {21, 0x47}, {-21, 0x47}, {-21, 0x47}, {22, 0x47}, {22, 0x47}, {-22, 0x47}, {-22, 0x47}, {23, 0x47}, {23, 0x47}, {-23, 0x47}, {-23, 0x47}, {24, 0x47}, {24, 0x47}, {-24, 0x47}, {-24, 0x47},
+    {9, 0x46}, {9, 0x46}, {9, 0x46}, {9, 0x46}, {-9, 0x46}, {-9, 0x46}, {-9, 0x46}, {-9, 0x46}, {10, 0x46}, {10, 0x46}, {10, 0x46}, {10, 0x46}, {-10, 0x46}, {-10, 0x46}, {-10, 0x46}, {-10, 0x46},
+    {11, 0x46}, {11, 0x46}, {11, 0x46}, {11, 0x46}, {-11, 0x46}, {-11, 0x46}, {-11, 0x46}, {-11, 0x46}, {12, 0x46}, {12, 0x46}, {12, 0x46}, {12, 0x46}, {-12, 0x46}, {-12, 0x46}, {-12, 0x46}, {-12, 0x46},
+    {13, 0x46}, {13, 0x46}, {13, 0x46}, {13, 0x46}, {-13, 0x46}, {-13, 0x46}, {-13, 0x46}, {-13, 0x46}, {14, 0x46}, {14, 0x46}, {14, 0x46}, {14, 0x46}, {-14, 0x46}, {-14, 0x46}, {-14, 0x46}, {-14, 0x46},
+    {15, 0x46}, {15, 0x46}, {15, 0x46}, {15, 0x46}, {-15, 0x46}, {-15, 0x46}, {-15, 0x46}, {-15, 0x46}, {16, 0x46}, {16, 0x46}, {16, 0x46}, {16, 0x46}, {-16, 0x46}, {-16, 0x46}, {-16, 0x46}, {-16, 0x46},
+    {1, 0x45}, {1, 0x45}, {1, 0x45}, {1, 0x45}, {1, 0x45}, {1, 0x45}, {1, 0x45}, {1, 0x45}, {-1, 0x45}, {-1, 0x45}, {-1, 0x45}, {-1, 0x45}, {-1, 0x45}, {-1, 0x45}, {-1, 0x45}, {-1, 0x45},
+    {2, 0x45}, {2, 0x45}, {2, 0x45}, {2, 0x45}, {2, 0x45}, {2, 0x45}, {2, 0x45}, {2, 0x45}, {-2, 0x45}, {-2, 0x45}, {-2, 0x45}, {-2, 0x45}, {-2, 0x45}, {-2, 0x45}, {-2, 0x45}, {-2, 0x45},
+    {3, 0x45}, {3, 0x45}, {3, 0x45}, {3, 0x45}, {3, 0x45}, {3, 0x45}, {3, 0x45}, {3, 0x45}, {-3, 0x45}, {-3, 0x45}, {-3, 0x45}, {-3, 0x45}, {-3, 0x45}, {-3, 0x45}, {-3, 0x45}, {-3, 0x45},
+    {4, 0x45}, {4, 0x45}, {4, 0x45}, {4, 0x45}, {4, 0x45}, {4, 0x45}, {4, 0x45}, {4, 0x45}, {-4, 0x45}, {-4, 0x45}, {-4, 0x45}, {-4, 0x45}, {-4, 0x45}, {-4, 0x45}, {-4, 0x45}, {-4, 0x45},
+    {5, 0x45}, {5, 0x45}, {5, 0x45}, {5, 0x45}, {5, 0x45}, {5, 0x45}, {5, 0x45}, {5, 0x45}, {-5, 0x45}, {-5, 0x45}, {-5, 0x45}, {-5, 0x45}, {-5, 0x45}, {-5, 0x45}, {-5, 0x45}, {-5, 0x45},
+    {6, 0x45}, {6, 0x45}, {6, 0x45}, {6, 0x45}, {6, 0x45}, {6, 0x45}, {6, 0x45}, {6, 0x45}, {-6, 0x45}, {-6, 0x45}, {-6, 0x45}, {-6, 0x45}, {-6, 0x45}, {-6, 0x45}, {-6, 0x45}, {-6, 0x45},
+    {7, 0x45}, {7, 0x45}, {7, 0x45}, {7, 0x45}, {7, 0x45}, {7, 0x45}, {7, 0x45}, {7, 0x45}, {-7, 0x45}, {-7, 0x45}, {-7, 0x45}, {-7, 0x45}, {-7, 0x45}, {-7, 0x45}, {-7, 0x45}, {-7, 0x45},
+    {8, 0x45}, {8, 0x45}, {8, 0x45}, {8, 0x45}, {8, 0x45}, {8, 0x45}, {8, 0x45}, {8, 0x45}, {-8, 0x45}, {-8, 0x45}, {-8, 0x45}, {-8, 0x45}, {-8, 0x45}, {-8, 0x45}, {-8, 0x45}, {-8, 0x45}
+  },
+  { // suffixLength 5
+    {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00},
+    {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00},
+    {33, 0x58}, {-33, 0x58}, {34, 0x58}, {-34, 0x58}, {35, 0x58}, {-35, 0x58}, {36, 0x58}, {-36, 0x58}, {37, 0x58}, {-37, 0x58}, {38, 0x58}, {-38, 0x58}, {39, 0x58}, {-39, 0x58}, {40, 0x58}, {-40, 0x58},
+    {41, 0x58}, {-41, 0x58}, {42, 0x58}, {-42, 0x58}, {43, 0x58}, {-43, 0x58}, {44, 0x58}, {-44, 0x58}, {45, 0x58}, {-45, 0x58}, {46, 0x58}, {-46, 0x58}, {47, 0x58}, {-47, 0x58}, {48, 0x58}, {-48, 0x58},
+    {17, 0x57}, {17, 0x57}, {-17, 0x57}, {-17, 0x57}, {18, 0x57}, {18, 0x57}, {-18, 0x57}, {-18, 0x57}, {19, 0x57}, {19, 0x57}, {-19, 0x57}, {-19, 0x57}, {20, 0x57}, {20, 0x57}, {-20, 0x57}, {-20, 0x57},
+    {21, 0x57}, {21, 0x57}, {-21, 0x57}, {-21, 0x57}, {22, 0x57}, {22, 0x57}, {-22, 0x57}, {-22, 0x57}, {23, 0x57}, {23, 0x57}, {-23, 0x57}, {-23, 0x57}, {24, 0x57}, {24, 0x57}, {-24, 0x57}, {-24, 0x57},
+    {25, 0x57}, {25, 0x57}, {-25, 0x57}, {-25, 0x57}, {26, 0x57}, {26, 0x57}, {-26, 0x57}, {-26, 0x57}, {27, 0x57}, {27, 0x57}, {-27, 0x57}, {-27, 0x57}, {28, 0x57}, {28, 0x57}, {-28, 0x57}, {-28, 0x57},
+    {29, 0x57}, {29, 0x57}, {-29, 0x57}, {-29, 0x57}, {30, 0x57}, {30, 0x57}, {-30, 0x57}, {-30, 0x57}, {31, 0x57}, {31, 0x57}, {-31, 0x57}, {-31, 0x57}, {32, 0x57}, {32, 0x57}, {-32, 0x57}, {-32, 0x57},
+    {1, 0x56}, {1, 0x56}, {1, 0x56}, {1, 0x56}, {-1, 0x56}, {-1, 0x56}, {-1, 0x56}, {-1, 0x56}, {2, 0x56}, {2, 0x56}, {2, 0x56}, {2, 0x56}, {-2, 0x56}, {-2, 0x56}, {-2, 0x56}, {-2, 0x56},
+    {3, 0x56}, {3, 0x56}, {3, 0x56}, {3, 0x56}, {-3, 0x56}, {-3, 0x56}, {-3, 0x56}, {-3, 0x56}, {4, 0x56}, {4, 0x56}, {4, 0x56}, {4, 0x56}, {-4, 0x56}, {-4, 0x56}, {-4, 0x56}, {-4, 0x56},
+    {5, 0x56}, {5, 0x56}, {5, 0x56}, {5, 0x56}, {-5, 0x56}, {-5, 0x56}, {-5, 0x56}, {-5, 0x56}, {6, 0x56}, {6, 0x56}, {6, 0x56}, {6, 0x56}, {-6, 0x56}, {-6, 0x56}, {-6, 0x56}, {-6, 0x56},
+    {7, 0x56}, {7, 0x56}, {7, 0x56}, {7, 0x56}, {-7, 0x56}, {-7, 0x56}, {-7, 0x56}, {-7, 0x56}, {8, 0x56}, {8, 0x56}, {8, 0x56}, {8, 0x56}, {-8, 0x56}, {-8, 0x56}, {-8, 0x56}, {-8, 0x56},
+    {9, 0x56}, {9, 0x56}, {9, 0x56}, {9, 0x56}, {-9, 0x56}, {-9, 0x56}, {-9, 0x56}, {-9, 0x56}, {10, 0x56}, {10, 0x56}, {10, 0x56}, {10, 0x56}, {-10, 0x56}, {-10, 0x56}, {-10, 0x56}, {-10, 0x56},
+    {11, 0x56}, {11, 0x56}, {11, 0x56}, {11, 0x56}, {-11, 0x56}, {-11, 0x56}, {-11, 0x56}, {-11, 0x56}, {12, 0x56}, {12, 0x56}, {12, 0x56}, {12, 0x56}, {-12, 0x56}, {-12, 0x56}, {-12, 0x56}, {-12, 0x56},
+    {13, 0x56}, {13, 0x56}, {13, 0x56}, {13, 0x56}, {-13, 0x56}, {-13, 0x56}, {-13, 0x56}, {-13, 0x56}, {14, 0x56}, {14, 0x56}, {14, 0x56}, {14, 0x56}, {-14, 0x56}, {-14, 0x56}, {-14, 0x56}, {-14, 0x56},
+    {15, 0x56}, {15, 0x56}, {15, 0x56}, {15, 0x56}, {-15, 0x56}, {-15, 0x56}, {-15, 0x56}, {-15, 0x56}, {16, 0x56}, {16, 0x56}, {16, 0x56}, {16, 0x56}, {-16, 0x56}, {-16, 0x56}, {-16, 0x56}, {-16, 0x56}
+  },
+  { // suffixLength 6
+    {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00},
+    {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00},
+    {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00},
+    {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00}, {0, 0x00},
+    {33, 0x68}, {-33, 0x68}, {34, 0x68}, {-34, 0x68}, {35, 0x68}, {-35, 0x68}, {36, 0x68}, {-36, 0x68}, {37, 0x68}, {-37, 0x68}, {38, 0x68}, {-38, 0x68}, {39, 0x68}, {-39, 0x68}, {40, 0x68}, {-40, 0x68},
+    {41, 0x68}, {-41, 0x68}, {42, 0x68}, {-42, 0x68}, {43, 0x68}, {-43, 0x68}, {44, 0x68}, {-44, 0x68}, {45, 0x68}, {-45, 0x68}, {46, 0x68}, {-46, 0x68}, {47, 0x68}, {-47, 0x68}, {48, 0x68}, {-48, 0x68},
+    {49, 0x68}, {-49, 0x68}, {50, 0x68}, {-50, 0x68}, {51, 0x68}, {-51, 0x68}, {52, 0x68}, {-52, 0x68}, {53, 0x68}, {-53, 0x68}, {54, 0x68}, {-54, 0x68}, {55, 0x68}, {-55, 0x68}, {56, 0x68}, {-56, 0x68},
+    {57, 0x68}, {-57, 0x68}, {58, 0x68}, {-58, 0x68}, {59, 0x68}, {-59, 0x68}, {60, 0x68}, {-60, 0x68}, {61, 0x68}, {-61, 0x68}, {62, 0x68}, {-62, 0x68}, {63, 0x68}, {-63, 0x68}, {64, 0x68}, {-64, 0x68},
+    {1, 0x67}, {1, 0x67}, {-1, 0x67}, {-1, 0x67}, {2, 0x67}, {2, 0x67}, {-2, 0x67}, {-2, 0x67}, {3, 0x67}, {3, 0x67}, {-3, 0x67}, {-3, 0x67}, {4, 0x67}, {4, 0x67}, {-4, 0x67}, {-4, 0x67},
+    {5, 0x67}, {5, 0x67}, {-5, 0x67}, {-5, 0x67}, {6, 0x67}, {6, 0x67}, {-6, 0x67}, {-6, 0x67}, {7, 0x67}, {7, 0x67}, {-7, 0x67}, {-7, 0x67}, {8, 0x67}, {8, 0x67}, {-8, 0x67}, {-8, 0x67},
+    {9, 0x67}, {9, 0x67}, {-9, 0x67}, {-9, 0x67}, {10, 0x67}, {10, 0x67}, {-10, 0x67}, {-10, 0x67}, {11, 0x67}, {11, 0x67}, {-11, 0x67}, {-11, 0x67}, {12, 0x67}, {12, 0x67}, {-12, 0x67}, {-12, 0x67},
+    {13, 0x67}, {13, 0x67}, {-13, 0x67}, {-13, 0x67}, {14, 0x67}, {14, 0x67}, {-14, 0x67}, {-14, 0x67}, {15, 0x67}, {15, 0x67}, {-15, 0x67}, {-15, 0x67}, {16, 0x67}, {16, 0x67}, {-16, 0x67}, {-16, 0x67},
+    {17, 0x67}, {17, 0x67}, {-17, 0x67}, {-17, 0x67}, {18, 0x67}, {18, 0x67}, {-18, 0x67}, {-18, 0x67}, {19, 0x67}, {19, 0x67}, {-19, 0x67}, {-19, 0x67}, {20, 0x67}, {20, 0x67}, {-20, 0x67}, {-20, 0x67},
+    {21, 0x67}, {21, 0x67}, {-21, 0x67}, {-21, 0x67}, {22, 0x67}, {22, 0x67}, {-22, 0x67}, {-22, 0x67}, {23, 0x67}, {23, 0x67}, {-23, 0x67}, {-23, 0x67}, {24, 0x67}, {24, 0x67}, {-24, 0x67}, {-24, 0x67},
+    {25, 0x67}, {25, 0x67}, {-25, 0x67}, {-25, 0x67}, {26, 0x67}, {26, 0x67}, {-26, 0x67}, {-26, 0x67}, {27, 0x67}, {27, 0x67}, {-27, 0x67}, {-27, 0x67}, {28, 0x67}, {28, 0x67}, {-28, 0x67}, {-28, 0x67},
+    {29, 0x67}, {29, 0x67}, {-29, 0x67}, {-29, 0x67}, {30, 0x67}, {30, 0x67}, {-30, 0x67}, {-30, 0x67}, {31, 0x67}, {31, 0x67}, {-31, 0x67}, {-31, 0x67}, {32, 0x67}, {32, 0x67}, {-32, 0x67}, {-32, 0x67}
+  }
+};
+
+const int8_t g_kiCavlcFirstLevelTable[2][256][2] = { // as above, for the first level after less than 3 trailing ones
+  { // suffixLength 0
+    {0, 0x00}, {-5, 0x28}, {5, 0x27}, {5, 0x27}, {-4, 0x26}, {-4, 0x26}, {-4, 0x26}, {-4, 0x26}, {4, 0x25}, {4, 0x25}, {4, 0x25}, {4, 0x25}, {4, 0x25}, {4, 0x25}, {4, 0x25}, {4, 0x25},
+    {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14}, {-3, 0x14},
+    {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13},
+    {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13},
+    {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12},
+    {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12},
+    {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12},
+    {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12},
+    {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11},
+    {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11},
+    {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11},
+    {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11},
+    {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11},
+    {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11},
+    {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11},
+    {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}, {2, 0x11}
+  },
+  { // suffixLength 1
+    {0, 0x00}, {0, 0x00}, {8, 0x28}, {-8, 0x28}, {7, 0x27}, {7, 0x27}, {-7, 0x27}, {-7, 0x27}, {6, 0x26}, {6, 0x26}, {6, 0x26}, {6, 0x26}, {-6, 0x26}, {-6, 0x26}, {-6, 0x26}, {-6, 0x26},
+    {5, 0x25}, {5, 0x25}, {5, 0x25}, {5, 0x25}, {5, 0x25}, {5, 0x25}, {5, 0x25}, {5, 0x25}, {-5, 0x25}, {-5, 0x25}, {-5, 0x25}, {-5, 0x25}, {-5, 0x25}, {-5, 0x25}, {-5, 0x25}, {-5, 0x25},
+    {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24}, {4, 0x24},
+    {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24}, {-4, 0x24},
+    {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13},
+    {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13}, {3, 0x13},
+    {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13},
+    {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13}, {-3, 0x13},
+    {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12},
+    {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12},
+    {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12},
+    {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12}, {2, 0x12},
+    {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12},
+    {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12},
+    {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12},
+    {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}, {-2, 0x12}
+  }
+};
+
+const uint32_t g_kuiCavlcRunBeforeTable[6][256] = { // read 8 bits, run_before of zerosLeft 1..6 and the runs following it,
+  // bits 0..2: runs decoded (1..4), bits 4 + 3 * i: run i, bits 16 + 4 * i: bits used up to run i
+  { // zerosLeft 1
+    0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011,
+    0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011,
+    0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011,
+    0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011,
+    0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011,
+    0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011,
+    0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011,
+    0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011,
+    0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011,
+    0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011,
+    0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011,
+    0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011,
+    0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011,
+    0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011,
+    0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011,
+    0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011, 0x00010011,
+    0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082,
+    0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082,
+    0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082,
+    0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082,
+    0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082,
+    0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082,
+    0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082,
+    0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082, 0x00210082,
+    0x03210403, 0x03210403, 0x03210403, 0x03210403, 0x03210403, 0x03210403, 0x03210403, 0x03210403,
+    0x03210403, 0x03210403, 0x03210403, 0x03210403, 0x03210403, 0x03210403, 0x03210403, 0x03210403,
+    0x03210403, 0x03210403, 0x03210403, 0x03210403, 0x03210403, 0x03210403, 0x03210403, 0x03210403,
+    0x03210403, 0x03210403, 0x03210403, 0x03210403, 0x03210403, 0x03210403, 0x03210403, 0x03210403,
+    0x43212004, 0x43212004, 0x43212004, 0x43212004, 0x43212004, 0x43212004, 0x43212004, 0x43212004,
+    0x43212004, 0x43212004, 0x43212004, 0x43212004, 0x43212004, 0x43212004, 0x43212004, 0x43212004,
+    0x43210004, 0x43210004, 0x43210004, 0x43210004, 0x43210004, 0x43210004, 0x43210004, 0x43210004,
+    0x43210004, 0x43210004, 0x43210004, 0x43210004, 0x43210004, 0x43210004, 0x43210004, 0x43210004
+  },
+  { // zerosLeft 2
+    0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021,
+    0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021,
+    0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021,
+    0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021,
+    0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021,
+    0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021,
+    0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021,
+    0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021, 0x00020021,
+    0x00320092, 0x00320092, 0x00320092, 0x00320092, 0x00320092, 0x00320092, 0x00320092, 0x00320092,
+    0x00320092, 0x00320092, 0x00320092, 0x00320092, 0x00320092, 0x00320092, 0x00320092, 0x00320092,
+    0x00320092, 0x00320092, 0x00320092, 0x00320092, 0x00320092, 0x00320092, 0x00320092, 0x00320092,
+    0x00320092, 0x00320092, 0x00320092, 0x00320092, 0x00320092, 0x00320092, 0x00320092, 0x00320092,
+    0x04320413, 0x04320413, 0x04320413, 0x04320413, 0x04320413, 0x04320413, 0x04320413, 0x04320413,
+    0x04320413, 0x04320413, 0x04320413, 0x04320413, 0x04320413, 0x04320413, 0x04320413, 0x04320413,
+    0x54322014, 0x54322014, 0x54322014, 0x54322014, 0x54322014, 0x54322014, 0x54322014, 0x54322014,
+    0x54320014, 0x54320014, 0x54320014, 0x54320014, 0x54320014, 0x54320014, 0x54320014, 0x54320014,
+    0x00310102, 0x00310102, 0x00310102, 0x00310102, 0x00310102, 0x00310102, 0x00310102, 0x00310102,
+    0x00310102, 0x00310102, 0x00310102, 0x00310102, 0x00310102, 0x00310102, 0x00310102, 0x00310102,
+    0x00310102, 0x00310102, 0x00310102, 0x00310102, 0x00310102, 0x00310102, 0x00310102, 0x00310102,
+    0x00310102, 0x00310102, 0x00310102, 0x00310102, 0x00310102, 0x00310102, 0x00310102, 0x00310102,
+    0x04310483, 0x04310483, 0x04310483, 0x04310483, 0x04310483, 0x04310483, 0x04310483, 0x04310483,
+    0x04310483, 0x04310483, 0x04310483, 0x04310483, 0x04310483, 0x04310483, 0x04310483, 0x04310483,
+    0x54312084, 0x54312084, 0x54312084, 0x54312084, 0x54312084, 0x54312084, 0x54312084, 0x54312084,
+    0x54310084, 0x54310084, 0x54310084, 0x54310084, 0x54310084, 0x54310084, 0x54310084, 0x54310084,
+    0x04210803, 0x04210803, 0x04210803, 0x04210803, 0x04210803, 0x04210803, 0x04210803, 0x04210803,
+    0x04210803, 0x04210803, 0x04210803, 0x04210803, 0x04210803, 0x04210803, 0x04210803, 0x04210803,
+    0x54212404, 0x54212404, 0x54212404, 0x54212404, 0x54212404, 0x54212404, 0x54212404, 0x54212404,
+    0x54210404, 0x54210404, 0x54210404, 0x54210404, 0x54210404, 0x54210404, 0x54210404, 0x54210404,
+    0x53214004, 0x53214004, 0x53214004, 0x53214004, 0x53214004, 0x53214004, 0x53214004, 0x53214004,
+    0x53212004, 0x53212004, 0x53212004, 0x53212004, 0x53212004, 0x53212004, 0x53212004, 0x53212004,
+    0x43210004, 0x43210004, 0x43210004, 0x43210004, 0x43210004, 0x43210004, 0x43210004, 0x43210004,
+    0x43210004, 0x43210004, 0x43210004, 0x43210004, 0x43210004, 0x43210004, 0x43210004, 0x43210004
+  },
+  { // zerosLeft 3
+    0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031,
+    0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031,
+    0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031,
+    0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031,
+    0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031,
+    0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031,
+    0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031,
+    0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031, 0x00020031,
+    0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2,
+    0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2,
+    0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2,
+    0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2, 0x003200a2,
+    0x04320423, 0x04320423, 0x04320423, 0x04320423, 0x04320423, 0x04320423, 0x04320423, 0x04320423,
+    0x04320423, 0x04320423, 0x04320423, 0x04320423, 0x04320423, 0x04320423, 0x04320423, 0x04320423,
+    0x54322024, 0x54322024, 0x54322024, 0x54322024, 0x54322024, 0x54322024, 0x54322024, 0x54322024,
+    0x54320024, 0x54320024, 0x54320024, 0x54320024, 0x54320024, 0x54320024, 0x54320024, 0x54320024,
+    0x00420112, 0x00420112, 0x00420112, 0x00420112, 0x00420112, 0x00420112, 0x00420112, 0x00420112,
+    0x00420112, 0x00420112, 0x00420112, 0x00420112, 0x00420112, 0x00420112, 0x00420112, 0x00420112,
+    0x05420493, 0x05420493, 0x05420493, 0x05420493, 0x05420493, 0x05420493, 0x05420493, 0x05420493,
+    0x65422094, 0x65422094, 0x65422094, 0x65422094, 0x65420094, 0x65420094, 0x65420094, 0x65420094,
+    0x05320813, 0x05320813, 0x05320813, 0x05320813, 0x05320813, 0x05320813, 0x05320813, 0x05320813,
+    0x65322414, 0x65322414, 0x65322414, 0x65322414, 0x65320414, 0x65320414, 0x65320414, 0x65320414,
+    0x64324014, 0x64324014, 0x64324014, 0x64324014, 0x64322014, 0x64322014, 0x64322014, 0x64322014,
+    0x54320014, 0x54320014, 0x54320014, 0x54320014, 0x54320014, 0x54320014, 0x54320014, 0x54320014,
+    0x00420182, 0x00420182, 0x00420182, 0x00420182, 0x00420182, 0x00420182, 0x00420182, 0x00420182,
+    0x00420182, 0x00420182, 0x00420182, 0x00420182, 0x00420182, 0x00420182, 0x00420182, 0x00420182,
+    0x05420503, 0x05420503, 0x05420503, 0x05420503, 0x05420503, 0x05420503, 0x05420503, 0x05420503,
+    0x65422104, 0x65422104, 0x65422104, 0x65422104, 0x65420104, 0x65420104, 0x65420104, 0x65420104,
+    0x06420883, 0x06420883, 0x06420883, 0x06420883, 0x76422484, 0x76422484, 0x76420484, 0x76420484,
+    0x75424084, 0x75424084, 0x75422084, 0x75422084, 0x65420084, 0x65420084, 0x65420084, 0x65420084,
+    0x06420c03, 0x06420c03, 0x06420c03, 0x06420c03, 0x76422804, 0x76422804, 0x76420804, 0x76420804,
+    0x86424404, 0x86422404, 0x76420404, 0x76420404, 0x86426004, 0x86424004, 0x86422004, 0x86420004
+  },
+  { // zerosLeft 4
+    0x00030041, 0x00030041, 0x00030041, 0x00030041, 0x00030041, 0x00030041, 0x00030041, 0x00030041,
+    0x00030041, 0x00030041, 0x00030041, 0x00030041, 0x00030041, 0x00030041, 0x00030041, 0x00030041,
+    0x00030041, 0x00030041, 0x00030041, 0x00030041, 0x00030041, 0x00030041, 0x00030041, 0x00030041,
+    0x00030041, 0x00030041, 0x00030041, 0x00030041, 0x00030041, 0x00030041, 0x00030041, 0x00030041,
+    0x004300b2, 0x004300b2, 0x004300b2, 0x004300b2, 0x004300b2, 0x004300b2, 0x004300b2, 0x004300b2,
+    0x004300b2, 0x004300b2, 0x004300b2, 0x004300b2, 0x004300b2, 0x004300b2, 0x004300b2, 0x004300b2,
+    0x05430433, 0x05430433, 0x05430433, 0x05430433, 0x05430433, 0x05430433, 0x05430433, 0x05430433,
+    0x65432034, 0x65432034, 0x65432034, 0x65432034, 0x65430034, 0x65430034, 0x65430034, 0x65430034,
+    0x00420122, 0x00420122, 0x00420122, 0x00420122, 0x00420122, 0x00420122, 0x00420122, 0x00420122,
+    0x00420122, 0x00420122, 0x00420122, 0x00420122, 0x00420122, 0x00420122, 0x00420122, 0x00420122,
+    0x054204a3, 0x054204a3, 0x054204a3, 0x054204a3, 0x054204a3, 0x054204a3, 0x054204a3, 0x054204a3,
+    0x654220a4, 0x654220a4, 0x654220a4, 0x654220a4, 0x654200a4, 0x654200a4, 0x654200a4, 0x654200a4,
+    0x05320823, 0x05320823, 0x05320823, 0x05320823, 0x05320823, 0x05320823, 0x05320823, 0x05320823,
+    0x65322424, 0x65322424, 0x65322424, 0x65322424, 0x65320424, 0x65320424, 0x65320424, 0x65320424,
+    0x64324024, 0x64324024, 0x64324024, 0x64324024, 0x64322024, 0x64322024, 0x64322024, 0x64322024,
+    0x54320024, 0x54320024, 0x54320024, 0x54320024, 0x54320024, 0x54320024, 0x54320024, 0x54320024,
+    0x00420192, 0x00420192, 0x00420192, 0x00420192, 0x00420192, 0x00420192, 0x00420192, 0x00420192,
+    0x00420192, 0x00420192, 0x00420192, 0x00420192, 0x00420192, 0x00420192, 0x00420192, 0x00420192,
+    0x05420513, 0x05420513, 0x05420513, 0x05420513, 0x05420513, 0x05420513, 0x05420513, 0x05420513,
+    0x65422114, 0x65422114, 0x65422114, 0x65422114, 0x65420114, 0x65420114, 0x65420114, 0x65420114,
+    0x06420893, 0x06420893, 0x06420893, 0x06420893, 0x76422494, 0x76422494, 0x76420494, 0x76420494,
+    0x75424094, 0x75424094, 0x75422094, 0x75422094, 0x65420094, 0x65420094, 0x65420094, 0x65420094,
+    0x06420c13, 0x06420c13, 0x06420c13, 0x06420c13, 0x76422814, 0x76422814, 0x76420814, 0x76420814,
+    0x86424414, 0x86422414, 0x76420414, 0x76420414, 0x86426014, 0x86424014, 0x86422014, 0x86420014,
+    0x00520202, 0x00520202, 0x00520202, 0x00520202, 0x00520202, 0x00520202, 0x00520202, 0x00520202,
+    0x06520583, 0x06520583, 0x06520583, 0x06520583, 0x76522184, 0x76522184, 0x76520184, 0x76520184,
+    0x06420903, 0x06420903, 0x06420903, 0x06420903, 0x76422504, 0x76422504, 0x76420504, 0x76420504,
+    0x75424104, 0x75424104, 0x75422104, 0x75422104, 0x65420104, 0x65420104, 0x65420104, 0x65420104,
+    0x06420c83, 0x06420c83, 0x06420c83, 0x06420c83, 0x76422884, 0x76422884, 0x76420884, 0x76420884,
+    0x86424484, 0x86422484, 0x76420484, 0x76420484, 0x86426084, 0x86424084, 0x86422084, 0x86420084,
+    0x07421003, 0x07421003, 0x87422c04, 0x87420c04, 0x86424804, 0x86422804, 0x76420804, 0x76420804,
+    0x86426404, 0x86424404, 0x86422404, 0x86420404, 0x06420003, 0x06420003, 0x06420003, 0x06420003
+  },
+  { // zerosLeft 5
+    0x00030051, 0x00030051, 0x00030051, 0x00030051, 0x00030051, 0x00030051, 0x00030051, 0x00030051,
+    0x00030051, 0x00030051, 0x00030051, 0x00030051, 0x00030051, 0x00030051, 0x00030051, 0x00030051,
+    0x00030051, 0x00030051, 0x00030051, 0x00030051, 0x00030051, 0x00030051, 0x00030051, 0x00030051,
+    0x00030051, 0x00030051, 0x00030051, 0x00030051, 0x00030051, 0x00030051, 0x00030051, 0x00030051,
+    0x004300c2, 0x004300c2, 0x004300c2, 0x004300c2, 0x004300c2, 0x004300c2, 0x004300c2, 0x004300c2,
+    0x004300c2, 0x004300c2, 0x004300c2, 0x004300c2, 0x004300c2, 0x004300c2, 0x004300c2, 0x004300c2,
+    0x05430443, 0x05430443, 0x05430443, 0x05430443, 0x05430443, 0x05430443, 0x05430443, 0x05430443,
+    0x65432044, 0x65432044, 0x65432044, 0x65432044, 0x65430044, 0x65430044, 0x65430044, 0x65430044,
+    0x00530132, 0x00530132, 0x00530132, 0x00530132, 0x00530132, 0x00530132, 0x00530132, 0x00530132,
+    0x065304b3, 0x065304b3, 0x065304b3, 0x065304b3, 0x765320b4, 0x765320b4, 0x765300b4, 0x765300b4,
+    0x06430833, 0x06430833, 0x06430833, 0x06430833, 0x76432434, 0x76432434, 0x76430434, 0x76430434,
+    0x75434034, 0x75434034, 0x75432034, 0x75432034, 0x65430034, 0x65430034, 0x65430034, 0x65430034,
+    0x005301a2, 0x005301a2, 0x005301a2, 0x005301a2, 0x005301a2, 0x005301a2, 0x005301a2, 0x005301a2,
+    0x06530523, 0x06530523, 0x06530523, 0x06530523, 0x76532124, 0x76532124, 0x76530124, 0x76530124,
+    0x075308a3, 0x075308a3, 0x875324a4, 0x875304a4, 0x865340a4, 0x865320a4, 0x765300a4, 0x765300a4,
+    0x07530c23, 0x07530c23, 0x87532824, 0x87530824, 0x07530423, 0x07530423, 0x07530023, 0x07530023,
+    0x00520212, 0x00520212, 0x00520212, 0x00520212, 0x00520212, 0x00520212, 0x00520212, 0x00520212,
+    0x06520593, 0x06520593, 0x06520593, 0x06520593, 0x76522194, 0x76522194, 0x76520194, 0x76520194,
+    0x06420913, 0x06420913, 0x06420913, 0x06420913, 0x76422514, 0x76422514, 0x76420514, 0x76420514,
+    0x75424114, 0x75424114, 0x75422114, 0x75422114, 0x65420114, 0x65420114, 0x65420114, 0x65420114,
+    0x06420c93, 0x06420c93, 0x06420c93, 0x06420c93, 0x76422894, 0x76422894, 0x76420894, 0x76420894,
+    0x86424494, 0x86422494, 0x76420494, 0x76420494, 0x86426094, 0x86424094, 0x86422094, 0x86420094,
+    0x07421013, 0x07421013, 0x87422c14, 0x87420c14, 0x86424814, 0x86422814, 0x76420814, 0x76420814,
+    0x86426414, 0x86424414, 0x86422414, 0x86420414, 0x06420013, 0x06420013, 0x06420013, 0x06420013,
+    0x00520282, 0x00520282, 0x00520282, 0x00520282, 0x00520282, 0x00520282, 0x00520282, 0x00520282,
+    0x06520603, 0x06520603, 0x06520603, 0x06520603, 0x76522204, 0x76522204, 0x76520204, 0x76520204,
+    0x07520983, 0x07520983, 0x87522584, 0x87520584, 0x86524184, 0x86522184, 0x76520184, 0x76520184,
+    0x07520d03, 0x07520d03, 0x87522904, 0x87520904, 0x07520503, 0x07520503, 0x07520103, 0x07520103,
+    0x07421083, 0x07421083, 0x87422c84, 0x87420c84, 0x86424884, 0x86422884, 0x76420884, 0x76420884,
+    0x86426484, 0x86424484, 0x86422484, 0x86420484, 0x06420083, 0x06420083, 0x06420083, 0x06420083,
+    0x07421403, 0x07421403, 0x87423004, 0x87421004, 0x07420c03, 0x07420c03, 0x07420803, 0x07420803,
+    0x06420403, 0x06420403, 0x06420403, 0x06420403, 0x06420003, 0x06420003, 0x06420003, 0x06420003
+  },
+  { // zerosLeft 6
+    0x00630292, 0x00630292, 0x00630292, 0x00630292, 0x07630613, 0x07630613, 0x87632214, 0x87630214,
+    0x08630993, 0x08630593, 0x07630193, 0x07630193, 0x08630d13, 0x08630913, 0x08630513, 0x08630113,
+    0x08531093, 0x08530c93, 0x07530893, 0x07530893, 0x07530493, 0x07530493, 0x07530093, 0x07530093,
+    0x08531413, 0x08531013, 0x08530c13, 0x08530813, 0x07530413, 0x07530413, 0x07530013, 0x07530013,
+    0x00630222, 0x00630222, 0x00630222, 0x00630222, 0x076305a3, 0x076305a3, 0x876321a4, 0x876301a4,
+    0x07530923, 0x07530923, 0x87532524, 0x87530524, 0x86534124, 0x86532124, 0x76530124, 0x76530124,
+    0x07530ca3, 0x07530ca3, 0x875328a4, 0x875308a4, 0x075304a3, 0x075304a3, 0x075300a3, 0x075300a3,
+    0x08531023, 0x08530c23, 0x07530823, 0x07530823, 0x07530423, 0x07530423, 0x07530023, 0x07530023,
+    0x00530142, 0x00530142, 0x00530142, 0x00530142, 0x00530142, 0x00530142, 0x00530142, 0x00530142,
+    0x065304c3, 0x065304c3, 0x065304c3, 0x065304c3, 0x765320c4, 0x765320c4, 0x765300c4, 0x765300c4,
+    0x06430843, 0x06430843, 0x06430843, 0x06430843, 0x76432444, 0x76432444, 0x76430444, 0x76430444,
+    0x75434044, 0x75434044, 0x75432044, 0x75432044, 0x65430044, 0x65430044, 0x65430044, 0x65430044,
+    0x005301b2, 0x005301b2, 0x005301b2, 0x005301b2, 0x005301b2, 0x005301b2, 0x005301b2, 0x005301b2,
+    0x06530533, 0x06530533, 0x06530533, 0x06530533, 0x76532134, 0x76532134, 0x76530134, 0x76530134,
+    0x075308b3, 0x075308b3, 0x875324b4, 0x875304b4, 0x865340b4, 0x865320b4, 0x765300b4, 0x765300b4,
+    0x07530c33, 0x07530c33, 0x87532834, 0x87530834, 0x07530433, 0x07530433, 0x07530033, 0x07530033,
+    0x00030061, 0x00030061, 0x00030061, 0x00030061, 0x00030061, 0x00030061, 0x00030061, 0x00030061,
+    0x00030061, 0x00030061, 0x00030061, 0x00030061, 0x00030061, 0x00030061, 0x00030061, 0x00030061,
+    0x00030061, 0x00030061, 0x00030061, 0x00030061, 0x00030061, 0x00030061, 0x00030061, 0x00030061,
+    0x00030061, 0x00030061, 0x00030061, 0x00030061, 0x00030061, 0x00030061, 0x00030061, 0x00030061,
+    0x004300d2, 0x004300d2, 0x004300d2, 0x004300d2, 0x004300d2, 0x004300d2, 0x004300d2, 0x004300d2,
+    0x004300d2, 0x004300d2, 0x004300d2, 0x004300d2, 0x004300d2, 0x004300d2, 0x004300d2, 0x004300d2,
+    0x05430453, 0x05430453, 0x05430453, 0x05430453, 0x05430453, 0x05430453, 0x05430453, 0x05430453,
+    0x65432054, 0x65432054, 0x65432054, 0x65432054, 0x65430054, 0x65430054, 0x65430054, 0x65430054,
+    0x08521483, 0x08521083, 0x08520c83, 0x08520883, 0x07520483, 0x07520483, 0x07520083, 0x07520083,
+    0x08521103, 0x08520d03, 0x07520903, 0x07520903, 0x07520503, 0x07520503, 0x07520103, 0x07520103,
+    0x07520a03, 0x07520a03, 0x87522604, 0x87520604, 0x86524204, 0x86522204, 0x76520204, 0x76520204,
+    0x07520d83, 0x07520d83, 0x87522984, 0x87520984, 0x07520583, 0x07520583, 0x07520183, 0x07520183,
+    0x00520302, 0x00520302, 0x00520302, 0x00520302, 0x00520302, 0x00520302, 0x00520302, 0x00520302,
+    0x06520683, 0x06520683, 0x06520683, 0x06520683, 0x76522284, 0x76522284, 0x76520284, 0x76520284,
+    0x07420403, 0x07420403, 0x07420803, 0x07420803, 0x07421003, 0x07421003, 0x07420c03, 0x07420c03,
+    0x07421803, 0x07421803, 0x87423404, 0x87421404, 0x06420003, 0x06420003, 0x06420003, 0x06420003
+  }
+};
+
 } // namespace WelsDec
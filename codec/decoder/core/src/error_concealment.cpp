@@ -37,6 +37,8 @@
 #include "copy_mb.h"
 #include "error_concealment.h"
 #include "cpu_core.h"
+#include "wels_decoder_thread.h"
+#include "decode_slice.h"
 
 namespace WelsDec {
 //Init
@@ -96,7 +98,8 @@ void DoErrorConFrameCopy (PWelsDecoderContext pCtx) {
     memset (pDstPic->pData[2], 128, (uiHeightInPixelY >> 1) * iStrideUV);
   } else if (pSrcPic == pDstPic) {
     WelsLog (& (pCtx->sLogCtx), WELS_LOG_WARNING, "DoErrorConFrameCopy()::EC memcpy overlap.");
-  } else { //has ref pic here
+  } else if ((pCtx->pParam->eEcActiveIdc != ERROR_CON_FRAME_COPY_CROSS_IDR_ALIAS)
+             || !AliasPicture (pCtx, pDstPic, pSrcPic)) { //has ref pic here, copy it unless its planes can be shared
     memcpy (pDstPic->pData[0], pSrcPic->pData[0], uiHeightInPixelY * iStrideY);
     memcpy (pDstPic->pData[1], pSrcPic->pData[1], (uiHeightInPixelY >> 1) * iStrideUV);
     memcpy (pDstPic->pData[2], pSrcPic->pData[2], (uiHeightInPixelY >> 1) * iStrideUV);
@@ -168,6 +171,60 @@ void DoErrorConSliceCopy (PWelsDecoderContext pCtx) {
   } //iMbY
 }
 
+// motion vector DoMbECMvCopy() uses for MB (iMbX, iMbY), kept inside the picture (cropping window) so that
+// no padding is output
+static void GetMbECMv (PWelsDecoderContext pCtx, PPicture pDec, PPicture pRef, int32_t iMbX, int32_t iMbY,
+                       sMCRefMember* pMCRefMem, int16_t iMVs[2]) {
+  int32_t iMbXInPix = iMbX << 4;
+  int32_t iMbYInPix = iMbY << 4;
+  int32_t iScale0;
+  int32_t iScale1;
+  int32_t iCurrPoc = pDec->iFramePoc;
+  if (pCtx->pECRefPic[0] == pRef) {
+    iMVs[0] = pCtx->iECMVs[0][0];
+    iMVs[1] = pCtx->iECMVs[0][1];
+  } else {
+    iScale0 = pCtx->pECRefPic[0]->iFramePoc - iCurrPoc;
+    iScale1 = pRef->iFramePoc - iCurrPoc;
+    iMVs[0] = iScale0 == 0 ? 0 : pCtx->iECMVs[0][0] * iScale1 / iScale0;
+    iMVs[1] = iScale0 == 0 ? 0 : pCtx->iECMVs[0][1] * iScale1 / iScale0;
+  }
+  int32_t iFullMVx = (iMbXInPix << 2) + iMVs[0]; //quarter pixel
+  int32_t iFullMVy = (iMbYInPix << 2) + iMVs[1];
+  // only use to be output pixels to EC;
+  int32_t iPicWidthLeftLimit = 0;
+  int32_t iPicHeightTopLimit = 0;
+  int32_t iPicWidthRightLimit = pMCRefMem->iPicWidth;
+  int32_t iPicHeightBottomLimit = pMCRefMem->iPicHeight;
+  if (pCtx->pSps->bFrameCroppingFlag) {
+    iPicWidthLeftLimit = 0 + pCtx->sFrameCrop.iLeftOffset * 2;
+    iPicWidthRightLimit = (pMCRefMem->iPicWidth - pCtx->sFrameCrop.iRightOffset * 2);
+    iPicHeightTopLimit = 0 + pCtx->sFrameCrop.iTopOffset * 2;
+    iPicHeightBottomLimit = (pMCRefMem->iPicHeight - pCtx->sFrameCrop.iTopOffset * 2);
+  }
+  // further make sure no need to expand picture
+  int32_t iMinLeftOffset = (iPicWidthLeftLimit + 2) * (1 << 2);
+  int32_t iMaxRightOffset = ((iPicWidthRightLimit - 18) * (1 << 2));
+  int32_t iMinTopOffset = (iPicHeightTopLimit + 2) * (1 << 2);
+  int32_t iMaxBottomOffset = ((iPicHeightBottomLimit - 18) * (1 << 2));
+  if (iFullMVx < iMinLeftOffset) {
+    iFullMVx = (iFullMVx >> 2) * (1 << 2);
+    iFullMVx = WELS_MAX (iPicWidthLeftLimit, iFullMVx);
+  } else if (iFullMVx > iMaxRightOffset) {
+    iFullMVx = (iFullMVx >> 2) * (1 << 2);
+    iFullMVx = WELS_MIN (((iPicWidthRightLimit - 16) * (1 << 2)), iFullMVx);
+  }
+  if (iFullMVy < iMinTopOffset) {
+    iFullMVy = (iFullMVy >> 2) * (1 << 2);
+    iFullMVy = WELS_MAX (iPicHeightTopLimit, iFullMVy);
+  } else if (iFullMVy > iMaxBottomOffset) {
+    iFullMVy = (iFullMVy >> 2) * (1 << 2);
+    iFullMVy = WELS_MIN (((iPicHeightBottomLimit - 16) * (1 << 2)), iFullMVy);
+  }
+  iMVs[0] = iFullMVx - (iMbXInPix << 2);
+  iMVs[1] = iFullMVy - (iMbYInPix << 2);
+}
+
 //Do error concealment using slice MV copy method
 void DoMbECMvCopy (PWelsDecoderContext pCtx, PPicture pDec, PPicture pRef, int32_t iMbXy, int32_t iMbX, int32_t iMbY,
                    sMCRefMember* pMCRefMem) {
@@ -177,10 +234,7 @@ void DoMbECMvCopy (PWelsDecoderContext pCtx, PPicture pDec, PPicture pRef, int32
   int16_t iMVs[2];
   int32_t iMbXInPix = iMbX << 4;
   int32_t iMbYInPix = iMbY << 4;
-  int32_t iScale0;
-  int32_t iScale1;
   uint8_t* pDst[3];
-  int32_t iCurrPoc = pDec->iFramePoc;
   pDst[0] = pDec->pData[0] + iMbXInPix + iMbYInPix * pMCRefMem->iDstLineLuma;
   pDst[1] = pDec->pData[1] + (iMbXInPix >> 1) + (iMbYInPix >> 1) * pMCRefMem->iDstLineChroma;
   pDst[2] = pDec->pData[2] + (iMbXInPix >> 1) + (iMbYInPix >> 1) * pMCRefMem->iDstLineChroma;
@@ -198,56 +252,57 @@ void DoMbECMvCopy (PWelsDecoderContext pCtx, PPicture pDec, PPicture pRef, int32
     return;
   }
 
-  if (pCtx->pECRefPic[0]) {
-    if (pCtx->pECRefPic[0] == pRef) {
-      iMVs[0] = pCtx->iECMVs[0][0];
-      iMVs[1] = pCtx->iECMVs[0][1];
-    } else {
-      iScale0 = pCtx->pECRefPic[0]->iFramePoc - iCurrPoc;
-      iScale1 = pRef->iFramePoc - iCurrPoc;
-      iMVs[0] = iScale0 == 0 ? 0 : pCtx->iECMVs[0][0] * iScale1 / iScale0;
-      iMVs[1] = iScale0 == 0 ? 0 : pCtx->iECMVs[0][1] * iScale1 / iScale0;
-    }
-    pMCRefMem->pDstY = pDst[0];
-    pMCRefMem->pDstU = pDst[1];
-    pMCRefMem->pDstV = pDst[2];
-    int32_t iFullMVx = (iMbXInPix << 2) + iMVs[0]; //quarter pixel
-    int32_t iFullMVy = (iMbYInPix << 2) + iMVs[1];
-    // only use to be output pixels to EC;
-    int32_t iPicWidthLeftLimit = 0;
-    int32_t iPicHeightTopLimit = 0;
-    int32_t iPicWidthRightLimit = pMCRefMem->iPicWidth;
-    int32_t iPicHeightBottomLimit = pMCRefMem->iPicHeight;
-    if (pCtx->pSps->bFrameCroppingFlag) {
-      iPicWidthLeftLimit = 0 + pCtx->sFrameCrop.iLeftOffset * 2;
-      iPicWidthRightLimit = (pMCRefMem->iPicWidth - pCtx->sFrameCrop.iRightOffset * 2);
-      iPicHeightTopLimit = 0 + pCtx->sFrameCrop.iTopOffset * 2;
-      iPicHeightBottomLimit = (pMCRefMem->iPicHeight - pCtx->sFrameCrop.iTopOffset * 2);
-    }
-    // further make sure no need to expand picture
-    int32_t iMinLeftOffset = (iPicWidthLeftLimit + 2) * (1 << 2);
-    int32_t iMaxRightOffset = ((iPicWidthRightLimit - 18) * (1 << 2));
-    int32_t iMinTopOffset = (iPicHeightTopLimit + 2) * (1 << 2);
-    int32_t iMaxBottomOffset = ((iPicHeightBottomLimit - 18) * (1 << 2));
-    if (iFullMVx < iMinLeftOffset) {
-      iFullMVx = (iFullMVx >> 2) * (1 << 2);
-      iFullMVx = WELS_MAX (iPicWidthLeftLimit, iFullMVx);
-    } else if (iFullMVx > iMaxRightOffset) {
-      iFullMVx = (iFullMVx >> 2) * (1 << 2);
-      iFullMVx = WELS_MIN (((iPicWidthRightLimit - 16) * (1 << 2)), iFullMVx);
-    }
-    if (iFullMVy < iMinTopOffset) {
-      iFullMVy = (iFullMVy >> 2) * (1 << 2);
-      iFullMVy = WELS_MAX (iPicHeightTopLimit, iFullMVy);
-    } else if (iFullMVy > iMaxBottomOffset) {
-      iFullMVy = (iFullMVy >> 2) * (1 << 2);
-      iFullMVy = WELS_MIN (((iPicHeightBottomLimit - 16) * (1 << 2)), iFullMVy);
+  GetMbECMv (pCtx, pDec, pRef, iMbX, iMbY, pMCRefMem, iMVs);
+  pMCRefMem->pDstY = pDst[0];
+  pMCRefMem->pDstU = pDst[1];
+  pMCRefMem->pDstV = pDst[2];
+  BaseMC (pMCRefMem, iMbXInPix, iMbYInPix, &pCtx->sMcFunc, 16, 16, iMVs);
+  return;
+}
+
+static inline void CopyRows (uint8_t* pDst, int32_t iDstStride, const uint8_t* pSrc, int32_t iSrcStride,
+                             int32_t iWidth, int32_t iHeight) {
+  for (int32_t i = 0; i < iHeight; ++i) {
+    memcpy (pDst, pSrc, iWidth);
+    pDst += iDstStride;
+    pSrc += iSrcStride;
+  }
+}
+
+// conceal the iMbNum lost MBs from (iMbX, iMbY) on, which all move by iMVs. Whole pel motion is a copy
+// of rows iMbNum MBs wide, only sub pel motion needs interpolation MB by MB.
+static void DoMbRunECMvCopy (PWelsDecoderContext pCtx, PPicture pDec, int32_t iMbX, int32_t iMbY, int32_t iMbNum,
+                             const int16_t iMVs[2], sMCRefMember* pMCRefMem) {
+  const int32_t kiFullMVx = (iMbX << 6) + iMVs[0]; //quarter pixel
+  const int32_t kiFullMVy = (iMbY << 6) + iMVs[1];
+  const int32_t kiSrcOffsetLuma = (kiFullMVx >> 2) + (kiFullMVy >> 2) * pMCRefMem->iSrcLineLuma;
+  const int32_t kiSrcOffsetChroma = (kiFullMVx >> 3) + (kiFullMVy >> 3) * pMCRefMem->iSrcLineChroma;
+  uint8_t* pDstY = pDec->pData[0] + (iMbX << 4) + (iMbY << 4) * pMCRefMem->iDstLineLuma;
+  uint8_t* pDstU = pDec->pData[1] + (iMbX << 3) + (iMbY << 3) * pMCRefMem->iDstLineChroma;
+  uint8_t* pDstV = pDec->pData[2] + (iMbX << 3) + (iMbY << 3) * pMCRefMem->iDstLineChroma;
+  int32_t i;
+
+  if ((iMVs[0] & 3) == 0 && (iMVs[1] & 3) == 0) {
+    CopyRows (pDstY, pMCRefMem->iDstLineLuma, pMCRefMem->pSrcY + kiSrcOffsetLuma, pMCRefMem->iSrcLineLuma,
+              iMbNum << 4, 16);
+  } else {
+    for (i = 0; i < iMbNum; ++i)
+      pCtx->sMcFunc.pMcLumaFunc (pMCRefMem->pSrcY + kiSrcOffsetLuma + (i << 4), pMCRefMem->iSrcLineLuma,
+                                 pDstY + (i << 4), pMCRefMem->iDstLineLuma, kiFullMVx, kiFullMVy, 16, 16);
+  }
+  if ((iMVs[0] & 7) == 0 && (iMVs[1] & 7) == 0) {
+    CopyRows (pDstU, pMCRefMem->iDstLineChroma, pMCRefMem->pSrcU + kiSrcOffsetChroma, pMCRefMem->iSrcLineChroma,
+              iMbNum << 3, 8);
+    CopyRows (pDstV, pMCRefMem->iDstLineChroma, pMCRefMem->pSrcV + kiSrcOffsetChroma, pMCRefMem->iSrcLineChroma,
+              iMbNum << 3, 8);
+  } else {
+    for (i = 0; i < iMbNum; ++i) {
+      pCtx->sMcFunc.pMcChromaFunc (pMCRefMem->pSrcU + kiSrcOffsetChroma + (i << 3), pMCRefMem->iSrcLineChroma,
+                                   pDstU + (i << 3), pMCRefMem->iDstLineChroma, kiFullMVx, kiFullMVy, 8, 8);
+      pCtx->sMcFunc.pMcChromaFunc (pMCRefMem->pSrcV + kiSrcOffsetChroma + (i << 3), pMCRefMem->iSrcLineChroma,
+                                   pDstV + (i << 3), pMCRefMem->iDstLineChroma, kiFullMVx, kiFullMVy, 8, 8);
     }
-    iMVs[0] = iFullMVx - (iMbXInPix << 2);
-    iMVs[1] = iFullMVy - (iMbYInPix << 2);
-    BaseMC (pMCRefMem, iMbXInPix, iMbYInPix, &pCtx->sMcFunc, 16, 16, iMVs);
   }
-  return;
 }
 
 void GetAvilInfoFromCorrectMb (PWelsDecoderContext pCtx) {
@@ -368,6 +423,77 @@ void GetAvilInfoFromCorrectMb (PWelsDecoderContext pCtx) {
   }
 }
 
+typedef struct TagECMvCopyRows {
+  PPicture      pSrcPic;
+  sMCRefMember  sMCRefMem;
+} SECMvCopyRows;
+
+// conceal the lost MBs of rows [iFirstMbY, iEndMbY), runs of them sharing a motion vector at once
+static void DoErrorConMVCopyRows (PWelsDecoderContext pCtx, int32_t iFirstMbY, int32_t iEndMbY, void* pArg) {
+  SECMvCopyRows* pRows = (SECMvCopyRows*)pArg;
+  int32_t iMbWidth = (int32_t) pCtx->pSps->iMbWidth;
+  PPicture pDstPic = pCtx->pDec;
+  PPicture pSrcPic = pRows->pSrcPic;
+  sMCRefMember sMCRefMem = pRows->sMCRefMem; // private copy of the thread
+  bool* pMbCorrectlyDecodedFlag = pCtx->pCurDqLayer->pMbCorrectlyDecodedFlag;
+  const bool kbCopy = (pDstPic->bIdrFlag == true || pCtx->pECRefPic[0] == NULL);
+  uint8_t* pDstData;
+  uint32_t iDstStride = pDstPic->iLinesize[0];
+  int16_t iMVs[2] = {0, 0};
+  int16_t iRunMVs[2];
+
+  for (int32_t iMbY = iFirstMbY; iMbY < iEndMbY; ++iMbY) {
+    bool* pRowFlag = pMbCorrectlyDecodedFlag + iMbY * iMbWidth;
+    int32_t iMbX = 0;
+    while (iMbX < iMbWidth) {
+      if (pRowFlag[iMbX]) {
+        ++iMbX;
+        continue;
+      }
+      int32_t iRunEnd = iMbX + 1;
+      if (pSrcPic == NULL) { //assign specific data to the run
+        while (iRunEnd < iMbWidth && !pRowFlag[iRunEnd])
+          ++iRunEnd;
+        const int32_t kiRunWidth = (iRunEnd - iMbX) << 4;
+        //Y component
+        pDstData = pDstPic->pData[0] + iMbY * 16 * iDstStride + iMbX * 16;
+        for (int32_t i = 0; i < 16; ++i) {
+          memset (pDstData, 128, kiRunWidth);
+          pDstData += iDstStride;
+        }
+        //U component
+        pDstData = pDstPic->pData[1] + iMbY * 8 * iDstStride / 2 + iMbX * 8;
+        for (int32_t i = 0; i < 8; ++i) {
+          memset (pDstData, 128, kiRunWidth >> 1);
+          pDstData += iDstStride / 2;
+        }
+        //V component
+        pDstData = pDstPic->pData[2] + iMbY * 8 * iDstStride / 2 + iMbX * 8;
+        for (int32_t i = 0; i < 8; ++i) {
+          memset (pDstData, 128, kiRunWidth >> 1);
+          pDstData += iDstStride / 2;
+        }
+        iMbX = iRunEnd;
+        continue;
+      }
+      if (!kbCopy)
+        GetMbECMv (pCtx, pDstPic, pSrcPic, iMbX, iMbY, &sMCRefMem, iRunMVs);
+      else
+        iRunMVs[0] = iRunMVs[1] = 0;
+      while (iRunEnd < iMbWidth && !pRowFlag[iRunEnd]) {
+        if (!kbCopy) {
+          GetMbECMv (pCtx, pDstPic, pSrcPic, iRunEnd, iMbY, &sMCRefMem, iMVs);
+          if (iMVs[0] != iRunMVs[0] || iMVs[1] != iRunMVs[1])
+            break;
+        }
+        ++iRunEnd;
+      }
+      DoMbRunECMvCopy (pCtx, pDstPic, iMbX, iMbY, iRunEnd - iMbX, iRunMVs, &sMCRefMem);
+      iMbX = iRunEnd;
+    } //iMbX
+  } //iMbY
+}
+
 void DoErrorConSliceMVCopy (PWelsDecoderContext pCtx) {
   int32_t iMbWidth = (int32_t) pCtx->pSps->iMbWidth;
   int32_t iMbHeight = (int32_t) pCtx->pSps->iMbHeight;
@@ -375,10 +501,8 @@ void DoErrorConSliceMVCopy (PWelsDecoderContext pCtx) {
   PPicture pSrcPic = pCtx->pPreviousDecodedPictureInDpb;
 
   bool* pMbCorrectlyDecodedFlag = pCtx->pCurDqLayer->pMbCorrectlyDecodedFlag;
-  int32_t iMbXyIndex;
-  uint8_t* pDstData;
-  uint32_t iDstStride = pDstPic->iLinesize[0];
-  sMCRefMember sMCRefMem;
+  SECMvCopyRows sRows;
+  sMCRefMember& sMCRefMem = sRows.sMCRefMem;
   if (pSrcPic != NULL) {
     sMCRefMem.iSrcLineLuma   = pSrcPic->iLinesize[0];
     sMCRefMem.iSrcLineChroma = pSrcPic->iLinesize[1];
@@ -389,44 +513,24 @@ void DoErrorConSliceMVCopy (PWelsDecoderContext pCtx) {
     sMCRefMem.iDstLineChroma = pDstPic->iLinesize[1];
     sMCRefMem.iPicWidth = pDstPic->iWidthInPixel;
     sMCRefMem.iPicHeight = pDstPic->iHeightInPixel;
+    sMCRefMem.pRefPic = NULL;
+    sMCRefMem.pRefReadyRows = NULL;
+    sMCRefMem.pMvReach = NULL;
+    sMCRefMem.pfExpandPreviewLines = NULL;
     if (pDstPic == pSrcPic) {
       // output error info, EC will be ignored in DoMbECMvCopy
       WelsLog (& (pCtx->sLogCtx), WELS_LOG_WARNING, "DoErrorConSliceMVCopy()::EC memcpy overlap.");
       return;
     }
   }
+  sRows.pSrcPic = pSrcPic;
 
-  for (int32_t iMbY = 0; iMbY < iMbHeight; ++iMbY) {
-    for (int32_t iMbX = 0; iMbX < iMbWidth; ++iMbX) {
-      iMbXyIndex = iMbY * iMbWidth + iMbX;
-      if (!pMbCorrectlyDecodedFlag[iMbXyIndex]) {
-        pCtx->pDec->iMbEcedNum++;
-        if (pSrcPic != NULL) {
-          DoMbECMvCopy (pCtx, pDstPic, pSrcPic, iMbXyIndex, iMbX, iMbY, &sMCRefMem);
-        } else { //pSrcPic == NULL
-          //Y component
-          pDstData = pDstPic->pData[0] + iMbY * 16 * iDstStride + iMbX * 16;
-          for (int32_t i = 0; i < 16; ++i) {
-            memset (pDstData, 128, 16);
-            pDstData += iDstStride;
-          }
-          //U component
-          pDstData = pDstPic->pData[1] + iMbY * 8 * iDstStride / 2 + iMbX * 8;
-          for (int32_t i = 0; i < 8; ++i) {
-            memset (pDstData, 128, 8);
-            pDstData += iDstStride / 2;
-          }
-          //V component
-          pDstData = pDstPic->pData[2] + iMbY * 8 * iDstStride / 2 + iMbX * 8;
-          for (int32_t i = 0; i < 8; ++i) {
-            memset (pDstData, 128, 8);
-            pDstData += iDstStride / 2;
-          }
-        } //
-
-      } //!pMbCorrectlyDecodedFlag[iMbXyIndex]
-    } //iMbX
-  } //iMbY
+  for (int32_t iMbXy = 0; iMbXy < iMbWidth * iMbHeight; ++iMbXy) {
+    if (!pMbCorrectlyDecodedFlag[iMbXy])
+      pCtx->pDec->iMbEcedNum++;
+  }
+  // MB rows are concealed independently, on the frame or slice threads if any
+  WelsDecThreadRunRows (pCtx, iMbHeight, DoErrorConMVCopyRows, &sRows);
 }
 
 //Mark erroneous frame as Ref Pic into DPB
@@ -439,6 +543,7 @@ int32_t MarkECFrameAsRef (PWelsDecoderContext pCtx) {
   ExpandReferencingPicture (pCtx->pDec->pData, pCtx->pDec->iWidthInPixel, pCtx->pDec->iHeightInPixel,
                             pCtx->pDec->iLinesize,
                             pCtx->sExpandPicFunc.pfExpandLumaPicture, pCtx->sExpandPicFunc.pfExpandChromaPicture);
+  pCtx->pDec->iPaddingLen = PADDING_LENGTH;
 
   return ERR_NONE;
 }
@@ -461,8 +566,11 @@ void ImplementErrorCon (PWelsDecoderContext pCtx) {
   if (ERROR_CON_DISABLE == pCtx->pParam->eEcActiveIdc) {
     pCtx->iErrorCode |= dsBitstreamError;
     return;
-  } else if ((ERROR_CON_FRAME_COPY == pCtx->pParam->eEcActiveIdc)
-             || (ERROR_CON_FRAME_COPY_CROSS_IDR == pCtx->pParam->eEcActiveIdc)) {
+  }
+  const int64_t kiStart = WelsStageStart (pCtx);
+  if ((ERROR_CON_FRAME_COPY == pCtx->pParam->eEcActiveIdc)
+      || (ERROR_CON_FRAME_COPY_CROSS_IDR == pCtx->pParam->eEcActiveIdc)
+      || (ERROR_CON_FRAME_COPY_CROSS_IDR_ALIAS == pCtx->pParam->eEcActiveIdc)) {
     DoErrorConFrameCopy (pCtx);
   } else if ((ERROR_CON_SLICE_COPY == pCtx->pParam->eEcActiveIdc)
              || (ERROR_CON_SLICE_COPY_CROSS_IDR == pCtx->pParam->eEcActiveIdc)
@@ -473,8 +581,10 @@ void ImplementErrorCon (PWelsDecoderContext pCtx) {
     GetAvilInfoFromCorrectMb (pCtx);
     DoErrorConSliceMVCopy (pCtx);
   } //TODO add other EC methods here in the future
+  WelsStageEnd (pCtx, DECODER_STAGE_ERROR_CONCEALMENT, kiStart);
   pCtx->iErrorCode |= dsDataErrorConcealed;
   pCtx->pDec->bIsComplete = false; // Set complete flag to false after do EC.
+  pCtx->iRowPipeNextMbXy = -1; // concealment may change rows already padded, pad the whole picture again
 }
 
 } // namespace WelsDec
@@ -44,6 +44,7 @@
 #include "macros.h"
 #include "ls_defines.h"
 #include "get_intra_predictor.h"
+#include "wels_common_defs.h"
 
 namespace WelsDec {
 
@@ -1154,4 +1155,43 @@ void WelsI16x16LumaPredDcNA_c (uint8_t* pPred, const int32_t kiStride) {
   } while (i-- > 0);
 }
 
+uint8_t* WelsI16x16LumaPredRow (uint8_t* pPred, const int32_t kiStride, const int8_t kiMode, uint8_t* pRow) {
+  int32_t iTmp = (kiStride << 4) - kiStride;
+  int32_t iSum = 0;
+  uint8_t i = 15;
+  uint8_t uiMean = 0;
+
+  switch (kiMode) {
+  case I16_PRED_V:
+    return pPred - kiStride;
+  case I16_PRED_DC:
+    do {
+      iSum += pPred[-1 + iTmp] + pPred[-kiStride + i];
+      iTmp -= kiStride;
+    } while (i-- > 0);
+    uiMean = (16 + iSum) >> 5;
+    break;
+  case I16_PRED_DC_L:
+    do {
+      iSum += pPred[-1 + iTmp];
+      iTmp -= kiStride;
+    } while (i-- > 0);
+    uiMean = (8 + iSum) >> 4;
+    break;
+  case I16_PRED_DC_T:
+    do {
+      iSum += pPred[-kiStride + i];
+    } while (i-- > 0);
+    uiMean = (8 + iSum) >> 4;
+    break;
+  case I16_PRED_DC_128:
+    uiMean = 0x80;
+    break;
+  default:
+    return NULL;
+  }
+  memset (pRow, uiMean, I16x16_COUNT);
+  return pRow;
+}
+
 } // namespace WelsDec
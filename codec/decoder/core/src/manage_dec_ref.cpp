@@ -42,6 +42,7 @@
 #include "manage_dec_ref.h"
 #include "error_concealment.h"
 #include "error_code.h"
+#include "wels_decoder_thread.h"
 
 namespace WelsDec {
 
@@ -116,7 +117,13 @@ int32_t WelsInitRefList (PWelsDecoderContext pCtx, int32_t iPoc) {
       && pCtx->eSliceType != SI_SLICE)) {
     if (pCtx->pParam->eEcActiveIdc !=
         ERROR_CON_DISABLE) { //IDR lost!, recover it for future decoding with data all set to 0
+      if (pCtx->pThreadCtx != NULL) // previous picture is read below
+        WelsDecThreadDrain (pCtx, false);
       PPicture pRef = PrefetchPic (pCtx->pPicBuff[0]);
+      if (pRef == NULL && pCtx->pThreadCtx != NULL)
+        pRef = WelsDecThreadPrefetchPic (pCtx);
+      if (pRef != NULL && RenewPicBuffer (pCtx, pRef) != ERR_NONE)
+        pRef = NULL;
       if (pRef != NULL) {
         // IDR lost, set new
         pRef->bIsComplete = false; // Set complete flag to false for lost IDR ref picture
@@ -124,6 +131,7 @@ int32_t WelsInitRefList (PWelsDecoderContext pCtx, int32_t iPoc) {
         pRef->iPpsId = pCtx->pPps->iPpsId;
         pCtx->iErrorCode |= dsDataErrorConcealed;
         bool bCopyPrevious = ((ERROR_CON_FRAME_COPY_CROSS_IDR == pCtx->pParam->eEcActiveIdc)
+                              || (ERROR_CON_FRAME_COPY_CROSS_IDR_ALIAS == pCtx->pParam->eEcActiveIdc)
                               || (ERROR_CON_SLICE_COPY_CROSS_IDR == pCtx->pParam->eEcActiveIdc)
                               || (ERROR_CON_SLICE_COPY_CROSS_IDR_FREEZE_RES_CHANGE == pCtx->pParam->eEcActiveIdc)
                               || (ERROR_CON_SLICE_MV_COPY_CROSS_IDR == pCtx->pParam->eEcActiveIdc)
@@ -138,7 +146,8 @@ int32_t WelsInitRefList (PWelsDecoderContext pCtx, int32_t iPoc) {
           memset (pRef->pData[2], 128, pRef->iLinesize[2] * pRef->iHeightInPixel / 2);
         } else if (pRef == pCtx->pPreviousDecodedPictureInDpb) {
           WelsLog (& (pCtx->sLogCtx), WELS_LOG_WARNING, "WelsInitRefList()::EC memcpy overlap.");
-        } else {
+        } else if ((ERROR_CON_FRAME_COPY_CROSS_IDR_ALIAS != pCtx->pParam->eEcActiveIdc)
+                   || !AliasPicture (pCtx, pRef, pCtx->pPreviousDecodedPictureInDpb)) {
           memcpy (pRef->pData[0], pCtx->pPreviousDecodedPictureInDpb->pData[0], pRef->iLinesize[0] * pRef->iHeightInPixel);
           memcpy (pRef->pData[1], pCtx->pPreviousDecodedPictureInDpb->pData[1], pRef->iLinesize[1] * pRef->iHeightInPixel / 2);
           memcpy (pRef->pData[2], pCtx->pPreviousDecodedPictureInDpb->pData[2], pRef->iLinesize[2] * pRef->iHeightInPixel / 2);
@@ -148,6 +157,7 @@ int32_t WelsInitRefList (PWelsDecoderContext pCtx, int32_t iPoc) {
         pRef->uiTemporalId = pRef->uiQualityId = 0;
         ExpandReferencingPicture (pRef->pData, pRef->iWidthInPixel, pRef->iHeightInPixel, pRef->iLinesize,
                                   pCtx->sExpandPicFunc.pfExpandLumaPicture, pCtx->sExpandPicFunc.pfExpandChromaPicture);
+        pRef->iPaddingLen = PADDING_LENGTH;
         AddShortTermToList (&pCtx->sRefPic, pRef);
       } else {
         WelsLog (& (pCtx->sLogCtx), WELS_LOG_ERROR, "WelsInitRefList()::PrefetchPic for EC errors.");
@@ -44,6 +44,8 @@ static const int16_t g_kBlockCat2CtxOffsetMap [] = {IDX_UNUSED, 0, 15, 29, 44, 4
 static const int16_t g_kBlockCat2CtxOffsetLast[] = {IDX_UNUSED, 0, 15, 29, 44, 47, 0, 44, 44, 47, 47};
 static const int16_t g_kBlockCat2CtxOffsetOne [] = {IDX_UNUSED, 0 , 10, 20, 30, 39, 0, 30, 30, 39, 39};
 static const int16_t g_kBlockCat2CtxOffsetAbs [] = {IDX_UNUSED, 0 , 10, 20, 30, 39, 0, 30, 30, 39, 39};
+//ctxIdxInc of significant_coeff_flag and last_significant_coeff_flag of blocks other than 8x8: the scanning position
+static const uint8_t g_kuiIdx2CtxSignificantCoeffFlag4x4[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
 
 const uint8_t g_kTopBlkInsideMb[24] = { //for index with z-order 0~23
   //  0   1 | 4  5      luma 8*8 block           pNonZeroCount[16+8]
@@ -780,84 +782,22 @@ int32_t ParseCbfInfoCabac (PWelsNeighAvail pNeighAvail, uint8_t* pNzcCache, int3
   return ERR_NONE;
 }
 
-int32_t ParseSignificantMapCabac (int32_t* pSignificantMap, int32_t iResProperty, PWelsDecoderContext pCtx,
-                                  uint32_t& uiCoeffNum) {
-  uint32_t uiCode;
-
-  PWelsCabacCtx pMapCtx  = pCtx->pCabacCtx + (iResProperty == LUMA_DC_AC_8 ? NEW_CTX_OFFSET_MAP_8x8 : NEW_CTX_OFFSET_MAP)
-                           + g_kBlockCat2CtxOffsetMap [iResProperty];
-  PWelsCabacCtx pLastCtx = pCtx->pCabacCtx + (iResProperty == LUMA_DC_AC_8 ? NEW_CTX_OFFSET_LAST_8x8 :
-                           NEW_CTX_OFFSET_LAST) + g_kBlockCat2CtxOffsetLast[iResProperty];
-
-
-  int32_t i;
-  uiCoeffNum = 0;
-  int32_t i0 = 0;
-  int32_t i1 = g_kMaxPos[iResProperty];
-
-  int32_t iCtx;
-
-  for (i = i0; i < i1; ++i) {
-    iCtx = (iResProperty == LUMA_DC_AC_8 ? g_kuiIdx2CtxSignificantCoeffFlag8x8[i] : i);
-    //read significant
-    WELS_READ_VERIFY (DecodeBinCabac (pCtx->pCabacDecEngine, pMapCtx + iCtx, uiCode));
-    if (uiCode) {
-      * (pSignificantMap++) = 1;
-      ++ uiCoeffNum;
-      //read last significant
-      iCtx = (iResProperty == LUMA_DC_AC_8 ? g_kuiIdx2CtxLastSignificantCoeffFlag8x8[i] : i);
-      WELS_READ_VERIFY (DecodeBinCabac (pCtx->pCabacDecEngine, pLastCtx + iCtx, uiCode));
-      if (uiCode) {
-        memset (pSignificantMap, 0, (i1 - i) * sizeof (int32_t));
-        return ERR_NONE;
-      }
-    } else
-      * (pSignificantMap++) = 0;
-  }
-
-  //deal with last pSignificantMap if no data
-  //if(i < i1+1)
-  {
-    *pSignificantMap = 1;
-    ++uiCoeffNum;
-  }
-
-  return ERR_NONE;
-}
-
-int32_t ParseSignificantCoeffCabac (int32_t* pSignificant, int32_t iResProperty, PWelsDecoderContext pCtx) {
-  uint32_t uiCode;
-  PWelsCabacCtx pOneCtx = pCtx->pCabacCtx + (iResProperty == LUMA_DC_AC_8 ? NEW_CTX_OFFSET_ONE_8x8 : NEW_CTX_OFFSET_ONE) +
-                          g_kBlockCat2CtxOffsetOne[iResProperty];
-  PWelsCabacCtx pAbsCtx = pCtx->pCabacCtx + (iResProperty == LUMA_DC_AC_8 ? NEW_CTX_OFFSET_ABS_8x8 : NEW_CTX_OFFSET_ABS) +
-                          g_kBlockCat2CtxOffsetAbs[iResProperty];
-
-  const int16_t iMaxType = g_kMaxC2[iResProperty];
-  int32_t i = g_kMaxPos[iResProperty];
-  int32_t* pCoff = pSignificant + i;
-  int32_t c1 = 1;
-  int32_t c2 = 0;
-  for (; i >= 0; --i) {
-    if (*pCoff != 0) {
-      WELS_READ_VERIFY (DecodeBinCabac (pCtx->pCabacDecEngine, pOneCtx + c1, uiCode));
-      *pCoff += uiCode;
-      if (*pCoff == 2) {
-        WELS_READ_VERIFY (DecodeUEGLevelCabac (pCtx->pCabacDecEngine, pAbsCtx + c2, uiCode));
-        *pCoff += uiCode;
-        ++c2;
-        c2 = WELS_MIN (c2, iMaxType);
-        c1 = 0;
-      } else if (c1) {
-        ++c1;
-        c1 = WELS_MIN (c1, 4);
-      }
-      WELS_READ_VERIFY (DecodeBypassCabac (pCtx->pCabacDecEngine, uiCode));
-      if (uiCode)
-        *pCoff = - *pCoff;
-    }
-    pCoff--;
-  }
-  return ERR_NONE;
+int32_t ParseSignificantCoeffsCabac (int32_t* pSignificant, int32_t iResProperty, PWelsDecoderContext pCtx,
+                                     uint32_t& uiCoeffNum) {
+  const bool kb8x8 = (iResProperty == LUMA_DC_AC_8);
+  PWelsCabacCtx pMapCtx  = pCtx->pCabacCtx + (kb8x8 ? NEW_CTX_OFFSET_MAP_8x8 : NEW_CTX_OFFSET_MAP) +
+                           g_kBlockCat2CtxOffsetMap [iResProperty];
+  PWelsCabacCtx pLastCtx = pCtx->pCabacCtx + (kb8x8 ? NEW_CTX_OFFSET_LAST_8x8 : NEW_CTX_OFFSET_LAST) +
+                           g_kBlockCat2CtxOffsetLast[iResProperty];
+  PWelsCabacCtx pOneCtx  = pCtx->pCabacCtx + (kb8x8 ? NEW_CTX_OFFSET_ONE_8x8 : NEW_CTX_OFFSET_ONE) +
+                           g_kBlockCat2CtxOffsetOne[iResProperty];
+  PWelsCabacCtx pAbsCtx  = pCtx->pCabacCtx + (kb8x8 ? NEW_CTX_OFFSET_ABS_8x8 : NEW_CTX_OFFSET_ABS) +
+                           g_kBlockCat2CtxOffsetAbs[iResProperty];
+
+  return DecodeResidualCoeffsCabac (pCtx->pCabacDecEngine, pMapCtx, pLastCtx, pOneCtx, pAbsCtx,
+                                    kb8x8 ? g_kuiIdx2CtxSignificantCoeffFlag8x8 : g_kuiIdx2CtxSignificantCoeffFlag4x4,
+                                    kb8x8 ? g_kuiIdx2CtxLastSignificantCoeffFlag8x8 : g_kuiIdx2CtxSignificantCoeffFlag4x4,
+                                    g_kMaxPos[iResProperty], g_kMaxC2[iResProperty], pSignificant, uiCoeffNum);
 }
 
 int32_t ParseResidualBlockCabac8x8 (PWelsNeighAvail pNeighAvail, uint8_t* pNonZeroCountCache, SBitStringAux* pBsAux,
@@ -874,8 +814,7 @@ int32_t ParseResidualBlockCabac8x8 (PWelsNeighAvail pNeighAvail, uint8_t* pNonZe
 
   uiCbpBit = 1; // for 8x8, MaxNumCoeff == 64 && uiCbpBit == 1
   if (uiCbpBit) { //has coeff
-    WELS_READ_VERIFY (ParseSignificantMapCabac (pSignificantMap, iResProperty, pCtx, uiTotalCoeffNum));
-    WELS_READ_VERIFY (ParseSignificantCoeffCabac (pSignificantMap, iResProperty, pCtx));
+    WELS_READ_VERIFY (ParseSignificantCoeffsCabac (pSignificantMap, iResProperty, pCtx, uiTotalCoeffNum));
   }
 
   pNonZeroCountCache[g_kCacheNzcScanIdx[iIndex]] =
@@ -916,8 +855,7 @@ int32_t ParseResidualBlockCabac (PWelsNeighAvail pNeighAvail, uint8_t* pNonZeroC
 
   WELS_READ_VERIFY (ParseCbfInfoCabac (pNeighAvail, pNonZeroCountCache, iIndex, iResProperty, pCtx, uiCbpBit));
   if (uiCbpBit) { //has coeff
-    WELS_READ_VERIFY (ParseSignificantMapCabac (pSignificantMap, iResProperty, pCtx, uiTotalCoeffNum));
-    WELS_READ_VERIFY (ParseSignificantCoeffCabac (pSignificantMap, iResProperty, pCtx));
+    WELS_READ_VERIFY (ParseSignificantCoeffsCabac (pSignificantMap, iResProperty, pCtx, uiTotalCoeffNum));
   }
 
   iCurNzCacheIdx = g_kCacheNzcScanIdx[iIndex];
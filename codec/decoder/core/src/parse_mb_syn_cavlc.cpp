@@ -48,11 +48,54 @@ namespace WelsDec {
 #define MAX_LEVEL_PREFIX 15
 
 typedef struct TagReadBitsCache {
-  uint32_t uiCache32Bit;
-  uint8_t  uiRemainBits;
-  uint8_t*  pBuf;
+  uint64_t uiCache64Bit;  // next bits of the residual block, msb first
+  int32_t  iRemainBits;   // valid bits in uiCache64Bit
+  const uint8_t* pBuf;    // next bytes to load
+  const uint8_t* pBufEnd;
 } SReadBitsCache;
 
+// keep at least 32 bits in the cache, the bytes past the end of the slice data read as 0
+static inline void CavlcFillCache (SReadBitsCache* pBitsCache) {
+  if (pBitsCache->iRemainBits <= 32) {
+    const uint8_t* pBuf = pBitsCache->pBuf;
+    uint32_t uiValue = 0;
+    if (pBuf + 4 <= pBitsCache->pBufEnd) {
+      uiValue = (pBuf[0] << 24) | (pBuf[1] << 16) | (pBuf[2] << 8) | pBuf[3];
+    } else {
+      for (int32_t i = 0; i < 4; i++)
+        uiValue = (uiValue << 8) | (pBuf + i < pBitsCache->pBufEnd ? pBuf[i] : 0);
+    }
+    pBitsCache->uiCache64Bit |= ((uint64_t)uiValue) << (32 - pBitsCache->iRemainBits);
+    pBitsCache->pBuf         += 4;
+    pBitsCache->iRemainBits  += 32;
+  }
+}
+
+// the first 25 bits at least are enough for coeff_token and the trailing ones signs
+static inline void CavlcInitCache (SReadBitsCache* pBitsCache, PBitStringAux pBs) {
+  pBitsCache->pBuf         = pBs->pStartBuf + (pBs->iIndex >> 3);
+  pBitsCache->pBufEnd      = pBs->pEndBuf;
+  pBitsCache->uiCache64Bit = 0;
+  pBitsCache->iRemainBits  = 0;
+  CavlcFillCache (pBitsCache);
+  pBitsCache->uiCache64Bit <<= (pBs->iIndex & 0x07);
+  pBitsCache->iRemainBits   -= (pBs->iIndex & 0x07);
+}
+
+static inline void CavlcEndCache (SReadBitsCache* pBitsCache, PBitStringAux pBs) {
+  pBs->iIndex = ((pBitsCache->pBuf - pBs->pStartBuf) << 3) - pBitsCache->iRemainBits;
+}
+
+// iCount in [1, 32]
+static inline uint32_t CavlcShowBits (SReadBitsCache* pBitsCache, int32_t iCount) {
+  return (uint32_t) (pBitsCache->uiCache64Bit >> (64 - iCount));
+}
+
+static inline void CavlcSkipBits (SReadBitsCache* pBitsCache, int32_t iCount) {
+  pBitsCache->uiCache64Bit <<= iCount;
+  pBitsCache->iRemainBits   -= iCount;
+}
+
 void GetNeighborAvailMbType (PWelsNeighAvail pNeighAvail, PDqLayer pCurLayer) {
   int32_t iCurSliceIdc, iTopSliceIdc, iLeftTopSliceIdc, iRightTopSliceIdc, iLeftSliceIdc;
   int32_t iCurXy, iTopXy = 0, iLeftXy = 0, iLeftTopXy = 0, iRightTopXy = 0;
@@ -621,74 +664,74 @@ void BsEndCavlc (PBitStringAux pBs) {
 }
 
 
-// return: used bits
-static int32_t CavlcGetTrailingOnesAndTotalCoeff (uint8_t& uiTotalCoeff, uint8_t& uiTrailingOnes,
+static inline void CavlcGetTrailingOnesAndTotalCoeff (uint8_t& uiTotalCoeff, uint8_t& uiTrailingOnes,
     SReadBitsCache* pBitsCache, SVlcTable* pVlcTable, bool bChromaDc, int8_t nC) {
   const uint8_t* kpVlcTableMoreBitsCountList[3] = {g_kuiVlcTableMoreBitsCount0, g_kuiVlcTableMoreBitsCount1, g_kuiVlcTableMoreBitsCount2};
-  int32_t iUsedBits = 0;
   int32_t iIndexVlc, iIndexValue, iNcMapIdx;
   uint32_t uiCount;
   uint32_t uiValue;
 
   if (bChromaDc) {
-    uiValue        = pBitsCache->uiCache32Bit >> 24;
+    uiValue        = CavlcShowBits (pBitsCache, 8);
     iIndexVlc      = pVlcTable->kpChromaCoeffTokenVlcTable[uiValue][0];
     uiCount        = pVlcTable->kpChromaCoeffTokenVlcTable[uiValue][1];
-    POP_BUFFER (pBitsCache, uiCount);
-    iUsedBits     += uiCount;
+    CavlcSkipBits (pBitsCache, uiCount);
     uiTrailingOnes = g_kuiVlcTrailingOneTotalCoeffTable[iIndexVlc][0];
     uiTotalCoeff   = g_kuiVlcTrailingOneTotalCoeffTable[iIndexVlc][1];
   } else { //luma
     iNcMapIdx = g_kuiNcMapTable[nC];
     if (iNcMapIdx <= 2) {
-      uiValue = pBitsCache->uiCache32Bit >> 24;
+      uiValue = CavlcShowBits (pBitsCache, 8);
       if (uiValue < g_kuiVlcTableNeedMoreBitsThread[iNcMapIdx]) {
-        POP_BUFFER (pBitsCache, 8);
-        iUsedBits  += 8;
-        iIndexValue = pBitsCache->uiCache32Bit >> (32 - kpVlcTableMoreBitsCountList[iNcMapIdx][uiValue]);
+        CavlcSkipBits (pBitsCache, 8);
+        iIndexValue = CavlcShowBits (pBitsCache, kpVlcTableMoreBitsCountList[iNcMapIdx][uiValue]);
         iIndexVlc   = pVlcTable->kpCoeffTokenVlcTable[iNcMapIdx + 1][uiValue][iIndexValue][0];
         uiCount     = pVlcTable->kpCoeffTokenVlcTable[iNcMapIdx + 1][uiValue][iIndexValue][1];
-        POP_BUFFER (pBitsCache, uiCount);
-        iUsedBits  += uiCount;
+        CavlcSkipBits (pBitsCache, uiCount);
       } else {
         iIndexVlc  = pVlcTable->kpCoeffTokenVlcTable[0][iNcMapIdx][uiValue][0];
         uiCount    = pVlcTable->kpCoeffTokenVlcTable[0][iNcMapIdx][uiValue][1];
-        uiValue    = pBitsCache->uiCache32Bit >> (32 - uiCount);
-        POP_BUFFER (pBitsCache, uiCount);
-        iUsedBits += uiCount;
+        CavlcSkipBits (pBitsCache, uiCount);
       }
     } else {
-      uiValue    = pBitsCache->uiCache32Bit >> (32 - 6);
-      POP_BUFFER (pBitsCache, 6);
-      iUsedBits += 6;
+      uiValue    = CavlcShowBits (pBitsCache, 6);
+      CavlcSkipBits (pBitsCache, 6);
       iIndexVlc  = pVlcTable->kpCoeffTokenVlcTable[0][3][uiValue][0];  //differ
     }
     uiTrailingOnes = g_kuiVlcTrailingOneTotalCoeffTable[iIndexVlc][0];
     uiTotalCoeff  = g_kuiVlcTrailingOneTotalCoeffTable[iIndexVlc][1];
   }
-
-  return iUsedBits;
 }
 
-static int32_t CavlcGetLevelVal (int32_t iLevel[16], SReadBitsCache* pBitsCache, uint8_t uiTotalCoeff,
-                                 uint8_t uiTrailingOnes) {
-  int32_t i, iUsedBits = 0;
+// return: 0, -1 on invalid level_prefix
+static inline int32_t CavlcGetLevelVal (int32_t iLevel[16], SReadBitsCache* pBitsCache, uint8_t uiTotalCoeff,
+                                        uint8_t uiTrailingOnes) {
+  int32_t i;
   int32_t iSuffixLength, iSuffixLengthSize, iLevelPrefix, iPrefixBits, iLevelCode, iThreshold;
   for (i = 0; i < uiTrailingOnes; i++) {
-    iLevel[i] = 1 - ((pBitsCache->uiCache32Bit >> (30 - i)) & 0x02);
+    iLevel[i] = 1 - ((CavlcShowBits (pBitsCache, i + 1) << 1) & 0x02);
   }
-  POP_BUFFER (pBitsCache, uiTrailingOnes);
-  iUsedBits += uiTrailingOnes;
+  CavlcSkipBits (pBitsCache, uiTrailingOnes);
 
   iSuffixLength = (uiTotalCoeff > 10 && uiTrailingOnes < 3);
 
   for (; i < uiTotalCoeff; i++) {
-    if (pBitsCache->uiRemainBits <= 16) SHIFT_BUFFER (pBitsCache);
-    WELS_GET_PREFIX_BITS (pBitsCache->uiCache32Bit, iPrefixBits);
+    CavlcFillCache (pBitsCache);
+    // level_prefix and level_suffix of up to 8 bits in one lookup, which also gives the next suffixLength
+    const bool bFirstLevel = (i == uiTrailingOnes) && (uiTrailingOnes < 3);
+    const int8_t* kpLevel = bFirstLevel ? g_kiCavlcFirstLevelTable[iSuffixLength][CavlcShowBits (pBitsCache, 8)]
+                            : g_kiCavlcLevelTable[iSuffixLength][CavlcShowBits (pBitsCache, 8)];
+    if (kpLevel[1]) {
+      iLevel[i] = kpLevel[0];
+      CavlcSkipBits (pBitsCache, kpLevel[1] & 0x0f);
+      iSuffixLength = kpLevel[1] >> 4;
+      continue;
+    }
+
+    WELS_GET_PREFIX_BITS (CavlcShowBits (pBitsCache, 32), iPrefixBits);
     if (iPrefixBits > MAX_LEVEL_PREFIX + 1) //iPrefixBits includes leading "0"s and first "1", should +1
       return -1;
-    POP_BUFFER (pBitsCache, iPrefixBits);
-    iUsedBits   += iPrefixBits;
+    CavlcSkipBits (pBitsCache, iPrefixBits);
     iLevelPrefix = iPrefixBits - 1;
 
     iLevelCode = iLevelPrefix << iSuffixLength; //differ
@@ -705,13 +748,11 @@ static int32_t CavlcGetLevelVal (int32_t iLevel[16], SReadBitsCache* pBitsCache,
     }
 
     if (iSuffixLengthSize > 0) {
-      if (pBitsCache->uiRemainBits <= iSuffixLengthSize) SHIFT_BUFFER (pBitsCache);
-      iLevelCode += (pBitsCache->uiCache32Bit >> (32 - iSuffixLengthSize));
-      POP_BUFFER (pBitsCache, iSuffixLengthSize);
-      iUsedBits  += iSuffixLengthSize;
+      iLevelCode += CavlcShowBits (pBitsCache, iSuffixLengthSize);
+      CavlcSkipBits (pBitsCache, iSuffixLengthSize);
     }
 
-    iLevelCode += ((i == uiTrailingOnes) && (uiTrailingOnes < 3)) << 1;
+    iLevelCode += bFirstLevel << 1;
     iLevel[i]   = ((iLevelCode + 2) >> 1);
     iLevel[i]  -= (iLevel[i] << 1) & (- (iLevelCode & 0x01));
 
@@ -720,12 +761,12 @@ static int32_t CavlcGetLevelVal (int32_t iLevel[16], SReadBitsCache* pBitsCache,
     iSuffixLength += ((iLevel[i] > iThreshold) || (iLevel[i] < -iThreshold)) && (iSuffixLength < 6);
   }
 
-  return iUsedBits;
+  return 0;
 }
 
-static int32_t CavlcGetTotalZeros (int32_t& iZerosLeft, SReadBitsCache* pBitsCache, uint8_t uiTotalCoeff,
-                                   SVlcTable* pVlcTable, bool bChromaDc) {
-  int32_t iCount, iUsedBits = 0;
+static inline void CavlcGetTotalZeros (int32_t& iZerosLeft, SReadBitsCache* pBitsCache, uint8_t uiTotalCoeff,
+                                       SVlcTable* pVlcTable, bool bChromaDc) {
+  int32_t iCount;
   const uint8_t* kpBitNumMap;
   uint32_t uiValue;
 
@@ -744,59 +785,51 @@ static int32_t CavlcGetTotalZeros (int32_t& iZerosLeft, SReadBitsCache* pBitsCac
   }
 
   iCount = kpBitNumMap[iTotalZeroVlcIdx - 1];
-  if (pBitsCache->uiRemainBits < iCount) SHIFT_BUFFER (
-      pBitsCache); // if uiRemainBits+16 still smaller than iCount?? potential bug
-  uiValue    = pBitsCache->uiCache32Bit >> (32 - iCount);
+  CavlcFillCache (pBitsCache);
+  uiValue    = CavlcShowBits (pBitsCache, iCount);
   iCount     = pVlcTable->kpTotalZerosTable[uiTableType][iTotalZeroVlcIdx - 1][uiValue][1];
-  POP_BUFFER (pBitsCache, iCount);
-  iUsedBits += iCount;
+  CavlcSkipBits (pBitsCache, iCount);
   iZerosLeft = pVlcTable->kpTotalZerosTable[uiTableType][iTotalZeroVlcIdx - 1][uiValue][0];
-
-  return iUsedBits;
 }
-static int32_t CavlcGetRunBefore (int32_t iRun[16], SReadBitsCache* pBitsCache, uint8_t uiTotalCoeff,
-                                  SVlcTable* pVlcTable, int32_t iZerosLeft) {
-  int32_t i, iUsedBits = 0;
-  uint32_t uiCount, uiValue, iPrefixBits;
-
-  for (i = 0; i < uiTotalCoeff - 1; i++) {
-    if (iZerosLeft > 0) {
-      uiCount = g_kuiZeroLeftBitNumMap[iZerosLeft];
-      if (pBitsCache->uiRemainBits < uiCount) SHIFT_BUFFER (pBitsCache);
-      uiValue = pBitsCache->uiCache32Bit >> (32 - uiCount);
-      if (iZerosLeft < 7) {
-        uiCount = pVlcTable->kpZeroTable[iZerosLeft - 1][uiValue][1];
-        POP_BUFFER (pBitsCache, uiCount);
-        iUsedBits += uiCount;
-        iRun[i] = pVlcTable->kpZeroTable[iZerosLeft - 1][uiValue][0];
-      } else {
-        POP_BUFFER (pBitsCache, uiCount);
-        iUsedBits += uiCount;
-        if (pVlcTable->kpZeroTable[6][uiValue][0] < 7) {
-          iRun[i] = pVlcTable->kpZeroTable[6][uiValue][0];
-        } else {
-          if (pBitsCache->uiRemainBits < 16) SHIFT_BUFFER (pBitsCache);
-          WELS_GET_PREFIX_BITS (pBitsCache->uiCache32Bit, iPrefixBits);
-          iRun[i] = iPrefixBits + 6;
-          if (iRun[i] > iZerosLeft)
-            return -1;
-          POP_BUFFER (pBitsCache, iPrefixBits);
-          iUsedBits += iPrefixBits;
-        }
+
+// return: 0, -1 on invalid run_before
+static inline int32_t CavlcGetRunBefore (int32_t iRun[16], SReadBitsCache* pBitsCache, uint8_t uiTotalCoeff,
+                                         SVlcTable* pVlcTable, int32_t iZerosLeft) {
+  const int32_t kiRunNum = uiTotalCoeff - 1;
+  int32_t i = 0;
+  uint32_t uiValue, iPrefixBits;
+
+  while (i < kiRunNum && iZerosLeft > 0) {
+    CavlcFillCache (pBitsCache);
+    if (iZerosLeft < 7) {
+      // up to 4 run_before in one lookup while zerosLeft stays below 7
+      const uint32_t kuiRuns = g_kuiCavlcRunBeforeTable[iZerosLeft - 1][CavlcShowBits (pBitsCache, 8)];
+      const int32_t kiNum    = WELS_MIN ((int32_t) (kuiRuns & 0x07), kiRunNum - i);
+      for (int32_t j = 0; j < kiNum; j++) {
+        iRun[i]     = (kuiRuns >> (4 + 3 * j)) & 0x07;
+        iZerosLeft -= iRun[i++];
       }
+      CavlcSkipBits (pBitsCache, (kuiRuns >> (12 + 4 * kiNum)) & 0x0f);
     } else {
-      for (int j = i; j < uiTotalCoeff; j++) {
-        iRun[j] = 0;
+      uiValue = CavlcShowBits (pBitsCache, 3);
+      CavlcSkipBits (pBitsCache, 3);
+      if (pVlcTable->kpZeroTable[6][uiValue][0] < 7) {
+        iRun[i] = pVlcTable->kpZeroTable[6][uiValue][0];
+      } else {
+        WELS_GET_PREFIX_BITS (CavlcShowBits (pBitsCache, 32), iPrefixBits);
+        iRun[i] = iPrefixBits + 6;
+        if (iRun[i] > iZerosLeft)
+          return -1;
+        CavlcSkipBits (pBitsCache, iPrefixBits);
       }
-      return iUsedBits;
+      iZerosLeft -= iRun[i++];
     }
-
-    iZerosLeft -= iRun[i];
   }
+  for (; i < kiRunNum; i++)
+    iRun[i] = 0;
+  iRun[kiRunNum] = iZerosLeft;
 
-  iRun[uiTotalCoeff - 1] = iZerosLeft;
-
-  return iUsedBits;
+  return 0;
 }
 
 int32_t WelsResidualBlockCavlc (SVlcTable* pVlcTable, uint8_t* pNonZeroCountCache, PBitStringAux pBs, int32_t iIndex,
@@ -815,17 +848,11 @@ int32_t WelsResidualBlockCavlc (SVlcTable* pVlcTable, uint8_t* pNonZeroCountCach
 
   int8_t nA, nB, nC;
   uint8_t uiTotalCoeff, uiTrailingOnes;
-  int32_t iUsedBits = 0;
-  intX_t iCurIdx   = pBs->iIndex;
-  uint8_t* pBuf     = ((uint8_t*)pBs->pStartBuf) + (iCurIdx >> 3);
   bool  bChromaDc = (CHROMA_DC == iResidualProperty);
   uint8_t bChroma   = (bChromaDc || CHROMA_AC == iResidualProperty);
   SReadBitsCache sReadBitsCache;
 
-  uint32_t uiCache32Bit = (uint32_t) ((((pBuf[0] << 8) | pBuf[1]) << 16) | (pBuf[2] << 8) | pBuf[3]);
-  sReadBitsCache.uiCache32Bit = uiCache32Bit << (iCurIdx & 0x07);
-  sReadBitsCache.uiRemainBits = 32 - (iCurIdx & 0x07);
-  sReadBitsCache.pBuf = pBuf;
+  CavlcInitCache (&sReadBitsCache, pBs);
   //////////////////////////////////////////////////////////////////////////
 
   if (bChroma) {
@@ -840,26 +867,24 @@ int32_t WelsResidualBlockCavlc (SVlcTable* pVlcTable, uint8_t* pNonZeroCountCach
 
   WELS_NON_ZERO_COUNT_AVERAGE (nC, nA, nB);
 
-  iUsedBits += CavlcGetTrailingOnesAndTotalCoeff (uiTotalCoeff, uiTrailingOnes, &sReadBitsCache, pVlcTable, bChromaDc,
-               nC);
+  CavlcGetTrailingOnesAndTotalCoeff (uiTotalCoeff, uiTrailingOnes, &sReadBitsCache, pVlcTable, bChromaDc, nC);
 
   if (iResidualProperty != CHROMA_DC && iResidualProperty != I16_LUMA_DC) {
     pNonZeroCountCache[iCurNonZeroCacheIdx] = uiTotalCoeff;
     //////////////////////////////////////////////////////////////////////////
   }
   if (0 == uiTotalCoeff) {
-    pBs->iIndex += iUsedBits;
+    CavlcEndCache (&sReadBitsCache, pBs);
     return ERR_NONE;
   }
   if ((uiTrailingOnes > 3) || (uiTotalCoeff > 16)) { /////////////////check uiTrailingOnes and uiTotalCoeff
     return GENERATE_ERROR_NO (ERR_LEVEL_MB_DATA, ERR_INFO_CAVLC_INVALID_TOTAL_COEFF_OR_TRAILING_ONES);
   }
-  if ((i = CavlcGetLevelVal (iLevel, &sReadBitsCache, uiTotalCoeff, uiTrailingOnes)) == -1) {
+  if (CavlcGetLevelVal (iLevel, &sReadBitsCache, uiTotalCoeff, uiTrailingOnes) == -1) {
     return GENERATE_ERROR_NO (ERR_LEVEL_MB_DATA, ERR_INFO_CAVLC_INVALID_LEVEL);
   }
-  iUsedBits += i;
   if (uiTotalCoeff < iMaxNumCoeff) {
-    iUsedBits += CavlcGetTotalZeros (iZerosLeft, &sReadBitsCache, uiTotalCoeff, pVlcTable, bChromaDc);
+    CavlcGetTotalZeros (iZerosLeft, &sReadBitsCache, uiTotalCoeff, pVlcTable, bChromaDc);
   } else {
     iZerosLeft = 0;
   }
@@ -867,11 +892,10 @@ int32_t WelsResidualBlockCavlc (SVlcTable* pVlcTable, uint8_t* pNonZeroCountCach
   if ((iZerosLeft < 0) || ((iZerosLeft + uiTotalCoeff) > iMaxNumCoeff)) {
     return GENERATE_ERROR_NO (ERR_LEVEL_MB_DATA, ERR_INFO_CAVLC_INVALID_ZERO_LEFT);
   }
-  if ((i = CavlcGetRunBefore (iRun, &sReadBitsCache, uiTotalCoeff, pVlcTable, iZerosLeft)) == -1) {
+  if (CavlcGetRunBefore (iRun, &sReadBitsCache, uiTotalCoeff, pVlcTable, iZerosLeft) == -1) {
     return GENERATE_ERROR_NO (ERR_LEVEL_MB_DATA, ERR_INFO_CAVLC_INVALID_RUN_BEFORE);
   }
-  iUsedBits += i;
-  pBs->iIndex += iUsedBits;
+  CavlcEndCache (&sReadBitsCache, pBs);
   iCoeffNum = -1;
 
   if (iResidualProperty == CHROMA_DC) {
@@ -934,17 +958,11 @@ int32_t WelsResidualBlockCavlc8x8 (SVlcTable* pVlcTable, uint8_t* pNonZeroCountC
 
   int8_t nA, nB, nC;
   uint8_t uiTotalCoeff, uiTrailingOnes;
-  int32_t iUsedBits = 0;
-  intX_t iCurIdx   = pBs->iIndex;
-  uint8_t* pBuf     = ((uint8_t*)pBs->pStartBuf) + (iCurIdx >> 3);
   bool  bChromaDc = (CHROMA_DC == iResidualProperty);
   uint8_t bChroma   = (bChromaDc || CHROMA_AC == iResidualProperty);
   SReadBitsCache sReadBitsCache;
 
-  uint32_t uiCache32Bit = (uint32_t) ((((pBuf[0] << 8) | pBuf[1]) << 16) | (pBuf[2] << 8) | pBuf[3]);
-  sReadBitsCache.uiCache32Bit = uiCache32Bit << (iCurIdx & 0x07);
-  sReadBitsCache.uiRemainBits = 32 - (iCurIdx & 0x07);
-  sReadBitsCache.pBuf = pBuf;
+  CavlcInitCache (&sReadBitsCache, pBs);
   //////////////////////////////////////////////////////////////////////////
 
   if (bChroma) {
@@ -959,26 +977,24 @@ int32_t WelsResidualBlockCavlc8x8 (SVlcTable* pVlcTable, uint8_t* pNonZeroCountC
 
   WELS_NON_ZERO_COUNT_AVERAGE (nC, nA, nB);
 
-  iUsedBits += CavlcGetTrailingOnesAndTotalCoeff (uiTotalCoeff, uiTrailingOnes, &sReadBitsCache, pVlcTable, bChromaDc,
-               nC);
+  CavlcGetTrailingOnesAndTotalCoeff (uiTotalCoeff, uiTrailingOnes, &sReadBitsCache, pVlcTable, bChromaDc, nC);
 
   if (iResidualProperty != CHROMA_DC && iResidualProperty != I16_LUMA_DC) {
     pNonZeroCountCache[iCurNonZeroCacheIdx] = uiTotalCoeff;
     //////////////////////////////////////////////////////////////////////////
   }
   if (0 == uiTotalCoeff) {
-    pBs->iIndex += iUsedBits;
+    CavlcEndCache (&sReadBitsCache, pBs);
     return ERR_NONE;
   }
   if ((uiTrailingOnes > 3) || (uiTotalCoeff > 16)) { /////////////////check uiTrailingOnes and uiTotalCoeff
     return GENERATE_ERROR_NO (ERR_LEVEL_MB_DATA, ERR_INFO_CAVLC_INVALID_TOTAL_COEFF_OR_TRAILING_ONES);
   }
-  if ((i = CavlcGetLevelVal (iLevel, &sReadBitsCache, uiTotalCoeff, uiTrailingOnes)) == -1) {
+  if (CavlcGetLevelVal (iLevel, &sReadBitsCache, uiTotalCoeff, uiTrailingOnes) == -1) {
     return GENERATE_ERROR_NO (ERR_LEVEL_MB_DATA, ERR_INFO_CAVLC_INVALID_LEVEL);
   }
-  iUsedBits += i;
   if (uiTotalCoeff < iMaxNumCoeff) {
-    iUsedBits += CavlcGetTotalZeros (iZerosLeft, &sReadBitsCache, uiTotalCoeff, pVlcTable, bChromaDc);
+    CavlcGetTotalZeros (iZerosLeft, &sReadBitsCache, uiTotalCoeff, pVlcTable, bChromaDc);
   } else {
     iZerosLeft = 0;
   }
@@ -986,11 +1002,10 @@ int32_t WelsResidualBlockCavlc8x8 (SVlcTable* pVlcTable, uint8_t* pNonZeroCountC
   if ((iZerosLeft < 0) || ((iZerosLeft + uiTotalCoeff) > iMaxNumCoeff)) {
     return GENERATE_ERROR_NO (ERR_LEVEL_MB_DATA, ERR_INFO_CAVLC_INVALID_ZERO_LEFT);
   }
-  if ((i = CavlcGetRunBefore (iRun, &sReadBitsCache, uiTotalCoeff, pVlcTable, iZerosLeft)) == -1) {
+  if (CavlcGetRunBefore (iRun, &sReadBitsCache, uiTotalCoeff, pVlcTable, iZerosLeft) == -1) {
     return GENERATE_ERROR_NO (ERR_LEVEL_MB_DATA, ERR_INFO_CAVLC_INVALID_RUN_BEFORE);
   }
-  iUsedBits += i;
-  pBs->iIndex += iUsedBits;
+  CavlcEndCache (&sReadBitsCache, pBs);
   iCoeffNum = -1;
 
   for (i = uiTotalCoeff - 1; i >= 0; --i) { //FIXME merge into  rundecode?
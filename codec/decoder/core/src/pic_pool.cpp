@@ -0,0 +1,190 @@
+/*!
+ * \copy
+ *     Copyright (c)  2009-2013, Cisco Systems
+ *     All rights reserved.
+ *
+ *     Redistribution and use in source and binary forms, with or without
+ *     modification, are permitted provided that the following conditions
+ *     are met:
+ *
+ *        * Redistributions of source code must retain the above copyright
+ *          notice, this list of conditions and the following disclaimer.
+ *
+ *        * Redistributions in binary form must reproduce the above copyright
+ *          notice, this list of conditions and the following disclaimer in
+ *          the documentation and/or other materials provided with the
+ *          distribution.
+ *
+ *     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *     "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *     LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *     FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *     COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *     INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *     BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *     LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *     CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *     LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *     ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *     POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \file    pic_pool.cpp
+ *
+ * \brief   picture memory shared by decoders, re-carved when the resolution changes
+ *
+ *************************************************************************************
+ */
+#include "pic_pool.h"
+#include "pic_queue.h"
+#include "expand_pic.h"
+#include "macros.h"
+#include "memory_align.h"
+#include "WelsThreadLib.h"
+
+using namespace WelsCommon;
+
+typedef struct TagPicPoolBuffer {
+  struct TagPicPoolBuffer* pNext;       // next free buffer
+  int32_t         iSize;
+} SPicPoolBuffer;
+
+#define PIC_POOL_HEADER_SIZE  WELS_ALIGN (sizeof (SPicPoolBuffer), 16)
+
+struct TagPicturePool {
+  WELS_MUTEX      hMutex;
+  int32_t         iRefCount;
+  int32_t         iBufferSize;          // size of the buffers kept, larger ones are freed once released
+  SPicPoolBuffer* pFreeList;
+  int32_t         iInUseNum;
+  CMemoryAlign*   pMa;
+  SPicturePoolStatistics sStats;
+};
+
+namespace WelsDec {
+
+static inline SPicPoolBuffer* GetPicPoolHeader (uint8_t* pBuf) {
+  return (SPicPoolBuffer*) (pBuf - PIC_POOL_HEADER_SIZE);
+}
+
+// call with the mutex held
+static SPicPoolBuffer* NewPicPoolBuffer (SPicturePool* pPool, const int32_t kiSize) {
+  SPicPoolBuffer* pHeader = (SPicPoolBuffer*)pPool->pMa->WelsMalloc (PIC_POOL_HEADER_SIZE + kiSize, "pic pool buffer");
+  WELS_VERIFY_RETURN_IF (NULL, NULL == pHeader);
+
+  pHeader->pNext = NULL;
+  pHeader->iSize = kiSize;
+  if (kiSize == pPool->iBufferSize) {
+    ++ pPool->sStats.iNumBuffers;
+    pPool->sStats.uiMemoryBytes += kiSize;
+  }
+  return pHeader;
+}
+
+static void FreePicPool (SPicturePool* pPool) {
+  while (pPool->pFreeList != NULL) {
+    SPicPoolBuffer* pHeader = pPool->pFreeList;
+    pPool->pFreeList = pHeader->pNext;
+    pPool->pMa->WelsFree (pHeader, "pic pool buffer");
+  }
+  delete pPool->pMa;
+  WelsMutexDestroy (&pPool->hMutex);
+  WelsFree (pPool, "SPicturePool");
+}
+
+int32_t GetPicPoolBufferSize (const int32_t kiWidth, const int32_t kiHeight) {
+  const int64_t kiLumaSize = (int64_t)WELS_ALIGN (WELS_ALIGN (kiWidth, 16) + (PADDING_LENGTH << 1),
+                             PICTURE_RESOLUTION_ALIGNMENT)
+                             * WELS_ALIGN (WELS_ALIGN (kiHeight, 16) + (PADDING_LENGTH << 1), PICTURE_RESOLUTION_ALIGNMENT);
+  return kiLumaSize * 3 / 2 > 0x7fffffff ? -1 : (int32_t) (kiLumaSize * 3 / 2);
+}
+
+SPicturePool* CreatePicPool (const SPicturePoolParam* pParam) {
+  SPicturePool* pPool = NULL;
+  int32_t iBufferSize;
+
+  WELS_VERIFY_RETURN_IF (NULL, NULL == pParam || pParam->iMaxWidth <= 0 || pParam->iMaxHeight <= 0
+                         || pParam->iNumPictures < 0);
+  iBufferSize = GetPicPoolBufferSize (pParam->iMaxWidth, pParam->iMaxHeight);
+  WELS_VERIFY_RETURN_IF (NULL, iBufferSize < 0);
+
+  pPool = (SPicturePool*)WelsMallocz (sizeof (SPicturePool), "SPicturePool");
+  WELS_VERIFY_RETURN_IF (NULL, NULL == pPool);
+  WelsMutexInit (&pPool->hMutex);
+  pPool->iRefCount   = 1;
+  pPool->iBufferSize = iBufferSize;
+  pPool->pMa         = new CMemoryAlign (16);
+  WELS_VERIFY_RETURN_PROC_IF (NULL, NULL == pPool->pMa, FreePicPool (pPool));
+
+  for (int32_t i = 0; i < pParam->iNumPictures; ++ i) {
+    SPicPoolBuffer* pHeader = NewPicPoolBuffer (pPool, iBufferSize);
+    WELS_VERIFY_RETURN_PROC_IF (NULL, NULL == pHeader, FreePicPool (pPool));
+    pHeader->pNext = pPool->pFreeList;
+    pPool->pFreeList = pHeader;
+    ++ pPool->sStats.iNumFreeBuffers;
+  }
+  return pPool;
+}
+
+void AddRefPicPool (SPicturePool* pPool) {
+  WelsMutexLock (&pPool->hMutex);
+  ++ pPool->iRefCount;
+  WelsMutexUnlock (&pPool->hMutex);
+}
+
+void ReleasePicPool (SPicturePool* pPool) {
+  int32_t iRefCount;
+
+  WelsMutexLock (&pPool->hMutex);
+  iRefCount = -- pPool->iRefCount;
+  WelsMutexUnlock (&pPool->hMutex);
+  if (iRefCount == 0)
+    FreePicPool (pPool);
+}
+
+uint8_t* GetPicPoolBuffer (SPicturePool* pPool, const int32_t kiSize) {
+  SPicPoolBuffer* pHeader = NULL;
+
+  WelsMutexLock (&pPool->hMutex);
+  if (kiSize <= pPool->iBufferSize && pPool->pFreeList != NULL) {
+    pHeader = pPool->pFreeList;
+    pPool->pFreeList = pHeader->pNext;
+    -- pPool->sStats.iNumFreeBuffers;
+    ++ pPool->sStats.uiHits;
+  } else {
+    pHeader = NewPicPoolBuffer (pPool, WELS_MAX (kiSize, pPool->iBufferSize));
+    if (pHeader != NULL)
+      ++ pPool->sStats.uiMisses;
+  }
+  if (pHeader != NULL) {
+    ++ pPool->iRefCount; // the pool lives as long as its buffers are in use
+    ++ pPool->iInUseNum;
+    pPool->sStats.iPeakBuffersInUse = WELS_MAX (pPool->sStats.iPeakBuffersInUse, pPool->iInUseNum);
+  }
+  WelsMutexUnlock (&pPool->hMutex);
+
+  return pHeader != NULL ? (uint8_t*)pHeader + PIC_POOL_HEADER_SIZE : NULL;
+}
+
+void ReleasePicPoolBuffer (SPicturePool* pPool, uint8_t* pBuf) {
+  SPicPoolBuffer* pHeader = GetPicPoolHeader (pBuf);
+
+  WelsMutexLock (&pPool->hMutex);
+  -- pPool->iInUseNum;
+  if (pHeader->iSize == pPool->iBufferSize) {
+    pHeader->pNext = pPool->pFreeList;
+    pPool->pFreeList = pHeader;
+    ++ pPool->sStats.iNumFreeBuffers;
+  } else {
+    pPool->pMa->WelsFree (pHeader, "pic pool buffer");
+  }
+  WelsMutexUnlock (&pPool->hMutex);
+  ReleasePicPool (pPool);
+}
+
+void GetPicPoolStatistics (SPicturePool* pPool, SPicturePoolStatistics* pStats) {
+  WelsMutexLock (&pPool->hMutex);
+  *pStats = pPool->sStats;
+  WelsMutexUnlock (&pPool->hMutex);
+}
+
+} // namespace WelsDec
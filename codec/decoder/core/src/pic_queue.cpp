@@ -37,10 +37,13 @@
  *
  *************************************************************************************
  */
+#include <stdlib.h>
 #include "pic_queue.h"
+#include "pic_pool.h"
 #include "decoder_context.h"
 #include "codec_def.h"
 #include "memory_align.h"
+#include "error_code.h"
 
 namespace WelsDec {
 
@@ -59,54 +62,102 @@ void FreePicture (PPicture pPic, CMemoryAlign* pMa);
 
 
 
+// size of the padded luma plane of a picture allocated by AllocPicture(), each chroma plane is a quarter of it
+static inline int32_t GetPicLumaSize (PPicture pPic) {
+  return pPic->iLinesize[0] * WELS_ALIGN (pPic->iHeightInPixel + (PADDING_LENGTH << 1), PICTURE_RESOLUTION_ALIGNMENT);
+}
+
+/*
+ *  get the memory of the planes of pPic, from the frame allocator of pCtx if there is one, filled with 128 whatever
+ *  its origin so that concealed or missing references read the same pixels
+ *  return the memory aligned for the planes, *ppUserBuffer is the buffer to release to the allocator
+ */
+static uint8_t* GetPicBuffer (PWelsDecoderContext pCtx, PPicture pPic, void** ppUserBuffer) {
+  const int32_t kiSize = GetPicLumaSize (pPic) * 3 / 2;
+  SFrameAllocator* pAllocator = &pCtx->sFrameAllocator;
+  uint8_t* pBuf = NULL;
+
+  *ppUserBuffer = NULL;
+  if (pAllocator->pfGetBuffer != NULL) {
+    *ppUserBuffer = pAllocator->pfGetBuffer (pAllocator->pUserContext, kiSize + 15);
+    if (*ppUserBuffer != NULL)
+      pBuf = (uint8_t*)WELS_ALIGN ((uintptr_t) (*ppUserBuffer), 16);
+  } else if (pCtx->pPicPool != NULL) {
+    pBuf = GetPicPoolBuffer (pCtx->pPicPool, kiSize);
+  } else {
+    pBuf = static_cast<uint8_t*> (pCtx->pMemAlign->WelsMallocz (kiSize, "_pic->buffer[0]"));
+  }
+  if (pBuf != NULL)
+    memset (pBuf, 128, kiSize);
+  return pBuf;
+}
+
+// point the planes of pPic into its own buffer
+static inline void SetPicPlanes (PPicture pPic) {
+  pPic->pData[0]     = pPic->pBuffer[0] + (1 + pPic->iLinesize[0]) * PADDING_LENGTH;
+  pPic->pData[1]     = pPic->pBuffer[1] + /*WELS_ALIGN*/ (((1 + pPic->iLinesize[1]) * PADDING_LENGTH) >> 1);
+  pPic->pData[2]     = pPic->pBuffer[2] + /*WELS_ALIGN*/ (((1 + pPic->iLinesize[2]) * PADDING_LENGTH) >> 1);
+}
+
+static void SetPicBuffer (PWelsDecoderContext pCtx, PPicture pPic, uint8_t* pBuf, void* pUserBuffer) {
+  const int32_t kiLumaSize = GetPicLumaSize (pPic);
+
+  pPic->pUserBuffer  = pUserBuffer;
+  if (pUserBuffer != NULL)
+    pPic->sAllocator = pCtx->sFrameAllocator;
+  pPic->pPicPool     = pUserBuffer == NULL ? pCtx->pPicPool : NULL;
+  pPic->pBuffer[0]   = pBuf;
+  pPic->pBuffer[1]   = pPic->pBuffer[0] + kiLumaSize;
+  pPic->pBuffer[2]   = pPic->pBuffer[1] + (kiLumaSize >> 2);
+  SetPicPlanes (pPic);
+}
+
+static void FreePicBuffer (PPicture pPic, CMemoryAlign* pMa) {
+  if (pPic->pUserBuffer != NULL) {
+    pPic->sAllocator.pfReleaseBuffer (pPic->sAllocator.pUserContext, pPic->pUserBuffer);
+    pPic->pUserBuffer = NULL;
+  } else if (pPic->pPicPool != NULL) {
+    ReleasePicPoolBuffer (pPic->pPicPool, pPic->pBuffer[0]);
+    pPic->pPicPool = NULL;
+  } else if (pPic->pBuffer[0] != NULL) {
+    pMa->WelsFree (pPic->pBuffer[0], "pPic->pBuffer[0]");
+  }
+  pPic->pBuffer[0] = pPic->pBuffer[1] = pPic->pBuffer[2] = NULL;
+  pPic->pData[0] = pPic->pData[1] = pPic->pData[2] = NULL;
+}
+
 PPicture AllocPicture (PWelsDecoderContext pCtx, const int32_t kiPicWidth, const int32_t kiPicHeight) {
   PPicture pPic = NULL;
   int32_t iPicWidth = 0;
-  int32_t iPicHeight = 0;
-
   int32_t iPicChromaWidth   = 0;
-  int32_t iPicChromaHeight  = 0;
-  int32_t iLumaSize         = 0;
-  int32_t iChromaSize       = 0;
   CMemoryAlign* pMa = pCtx->pMemAlign;
 
   pPic = (PPicture) pMa->WelsMallocz (sizeof (SPicture), "PPicture");
   WELS_VERIFY_RETURN_IF (NULL, NULL == pPic);
 
   memset (pPic, 0, sizeof (SPicture));
+  WelsMutexInit (&pPic->hReadyMutex);
+  WelsCondInit (&pPic->hReadyCond);
 
   iPicWidth = WELS_ALIGN (kiPicWidth + (PADDING_LENGTH << 1), PICTURE_RESOLUTION_ALIGNMENT);
-  iPicHeight = WELS_ALIGN (kiPicHeight + (PADDING_LENGTH << 1), PICTURE_RESOLUTION_ALIGNMENT);
   iPicChromaWidth   = iPicWidth >> 1;
-  iPicChromaHeight  = iPicHeight >> 1;
 
-  iLumaSize     = iPicWidth * iPicHeight;
-  iChromaSize   = iPicChromaWidth * iPicChromaHeight;
-
-  if (pCtx->pParam->bParseOnly) {
-    pPic->pBuffer[0] = pPic->pBuffer[1] = pPic->pBuffer[2] = NULL;
-    pPic->pData[0] = pPic->pData[1] = pPic->pData[2] = NULL;
-    pPic->iLinesize[0] = iPicWidth;
-    pPic->iLinesize[1] = pPic->iLinesize[2] = iPicChromaWidth;
-  } else {
-    pPic->pBuffer[0] = static_cast<uint8_t*> (pMa->WelsMallocz (iLumaSize /* luma */
-                       + (iChromaSize << 1) /* Cb,Cr */, "_pic->buffer[0]"));
-    WELS_VERIFY_RETURN_PROC_IF (NULL, NULL == pPic->pBuffer[0], FreePicture (pPic, pMa));
-
-    memset (pPic->pBuffer[0], 128, (iLumaSize + (iChromaSize << 1)));
-    pPic->iLinesize[0] = iPicWidth;
-    pPic->iLinesize[1] = pPic->iLinesize[2] = iPicChromaWidth;
-    pPic->pBuffer[1]   = pPic->pBuffer[0] + iLumaSize;
-    pPic->pBuffer[2]   = pPic->pBuffer[1] + iChromaSize;
-    pPic->pData[0]     = pPic->pBuffer[0] + (1 + pPic->iLinesize[0]) * PADDING_LENGTH;
-    pPic->pData[1]     = pPic->pBuffer[1] + /*WELS_ALIGN*/ (((1 + pPic->iLinesize[1]) * PADDING_LENGTH) >> 1);
-    pPic->pData[2]     = pPic->pBuffer[2] + /*WELS_ALIGN*/ (((1 + pPic->iLinesize[2]) * PADDING_LENGTH) >> 1);
-  }
+  pPic->iLinesize[0] = iPicWidth;
+  pPic->iLinesize[1] = pPic->iLinesize[2] = iPicChromaWidth;
   pPic->iPlanes        = 3;    // yv12 in default
   pPic->iWidthInPixel  = kiPicWidth;
   pPic->iHeightInPixel = kiPicHeight;
+  pPic->iPaddingLen    = PADDING_LENGTH;
   pPic->iFrameNum      = -1;
   pPic->bAvailableFlag = true;
+  pPic->iReadyMbRows   = PIC_READY_ALL;
+
+  if (!pCtx->pParam->bParseOnly) {
+    void* pUserBuffer = NULL;
+    uint8_t* pBuf = GetPicBuffer (pCtx, pPic, &pUserBuffer);
+    WELS_VERIFY_RETURN_PROC_IF (NULL, NULL == pBuf, FreePicture (pPic, pMa));
+    SetPicBuffer (pCtx, pPic, pBuf, pUserBuffer);
+  }
 
   return pPic;
 }
@@ -114,26 +165,186 @@ PPicture AllocPicture (PWelsDecoderContext pCtx, const int32_t kiPicWidth, const
 void FreePicture (PPicture pPic, CMemoryAlign* pMa) {
   if (NULL != pPic) {
 
-    if (pPic->pBuffer[0]) {
-      pMa->WelsFree (pPic->pBuffer[0], "pPic->pBuffer[0]");
-    }
+    FreePicBuffer (pPic, pMa);
 
+    WelsCondDestroy (&pPic->hReadyCond);
+    WelsMutexDestroy (&pPic->hReadyMutex);
     pMa->WelsFree (pPic, "pPic");
 
     pPic = NULL;
   }
 }
-PPicture PrefetchPic (PPicBuff pPicBuf) {
-  int32_t iPicIdx = 0;
-  PPicture pPic  = NULL;
 
-  if (pPicBuf->iCapacity == 0) {
-    return NULL;
+/*
+ *  give pPic its own planes back, with a copy of the shared ones when bCopy
+ */
+static void UnaliasPicture (PWelsDecoderContext pCtx, PPicture pPic, const bool kbCopy) {
+  PPicture pSrc = pPic->pAliasSrc;
+
+  if (kbCopy) {
+    const int32_t kiSize = GetPicLumaSize (pPic) * 3 / 2;
+    memcpy (pPic->pBuffer[0], pSrc->pBuffer[0], kiSize);
+    pCtx->sDecoderStatistics.uiEcMaterializedBytes += kiSize;
+  }
+  SetPicPlanes (pPic);
+  pPic->pAliasSrc = NULL;
+  -- pSrc->iAliasNum;
+}
+
+/*
+ *  before the planes of pSrc are overwritten: the first picture aliasing them takes them over,
+ *  the others alias that picture from now on
+ */
+static void MaterializeAliases (PWelsDecoderContext pCtx, PPicture pSrc) {
+  PPicBuff pPicBuf = pCtx->pPicBuff[LIST_0];
+  PPicture pNewSrc = NULL;
+
+  for (int32_t iPicIdx = 0; iPicIdx < pPicBuf->iCapacity && pSrc->iAliasNum > 0; ++ iPicIdx) {
+    PPicture pPic = pPicBuf->ppPic[iPicIdx];
+    if (pPic == NULL || pPic->pAliasSrc != pSrc)
+      continue;
+    if (pNewSrc != NULL) {
+      -- pSrc->iAliasNum;
+      for (int32_t i = 0; i < 3; ++ i)
+        pPic->pData[i] = pNewSrc->pData[i];
+      pPic->pAliasSrc = pNewSrc;
+      ++ pNewSrc->iAliasNum;
+      continue;
+    }
+    pNewSrc = pPic;
+    if (pSrc == pCtx->pPreviousDecodedPictureInDpb) { // error concealment may still copy from it
+      UnaliasPicture (pCtx, pPic, true);
+      continue;
+    }
+    // both buffers come from the decoder with the same size, the pixels of pSrc are not needed any more
+    for (int32_t i = 0; i < 3; ++ i) {
+      uint8_t* pBuf = pPic->pBuffer[i];
+      pPic->pBuffer[i] = pSrc->pBuffer[i];
+      pSrc->pBuffer[i] = pBuf;
+    }
+    SPicturePool* pPicPool = pPic->pPicPool;
+    pPic->pPicPool = pSrc->pPicPool;
+    pSrc->pPicPool = pPicPool;
+    SetPicPlanes (pSrc);
+    UnaliasPicture (pCtx, pPic, false);
+  }
+}
+
+bool AliasPicture (PWelsDecoderContext pCtx, PPicture pPic, PPicture pSrc) {
+  if (pSrc->pAliasSrc != NULL)
+    pSrc = pSrc->pAliasSrc;
+  if (pCtx->pThreadCtx != NULL || pCtx->sFrameAllocator.pfGetBuffer != NULL
+      || pPic->pUserBuffer != NULL || pSrc->pUserBuffer != NULL
+      || pPic->pAliasSrc != NULL || pPic->iAliasNum > 0 || pPic == pSrc
+      || pPic->iLinesize[0] != pSrc->iLinesize[0] || pPic->iHeightInPixel != pSrc->iHeightInPixel)
+    return false;
+
+  for (int32_t i = 0; i < 3; ++ i)
+    pPic->pData[i] = pSrc->pData[i];
+  pPic->pAliasSrc = pSrc;
+  pPic->iPaddingLen = pSrc->iPaddingLen;
+  ++ pSrc->iAliasNum;
+  pCtx->sDecoderStatistics.uiEcAliasedBytes += pPic->iLinesize[0] * pPic->iHeightInPixel * 3 / 2;
+  return true;
+}
+
+void MaterializeAliasedPics (PWelsDecoderContext pCtx) {
+  PPicBuff pPicBuf = pCtx->pPicBuff[LIST_0];
+
+  if (pPicBuf == NULL)
+    return;
+  for (int32_t iPicIdx = 0; iPicIdx < pPicBuf->iCapacity; ++ iPicIdx) {
+    PPicture pPic = pPicBuf->ppPic[iPicIdx];
+    if (pPic != NULL && pPic->pAliasSrc != NULL)
+      UnaliasPicture (pCtx, pPic, true);
   }
+}
+
+int32_t RenewPicBuffer (PWelsDecoderContext pCtx, PPicture pPic) {
+  void* pUserBuffer = NULL;
+  uint8_t* pBuf = NULL;
+
+  if (pPic->pAliasSrc != NULL) // error concealment may still copy from the previous picture
+    UnaliasPicture (pCtx, pPic, pPic == pCtx->pPreviousDecodedPictureInDpb);
+  if (pPic->iAliasNum > 0)
+    MaterializeAliases (pCtx, pPic);
+
+  if (pCtx->pParam->bParseOnly || (pPic->pUserBuffer == NULL && pCtx->sFrameAllocator.pfGetBuffer == NULL))
+    return ERR_NONE; // keep the memory of the decoder
+
+  pBuf = GetPicBuffer (pCtx, pPic, &pUserBuffer);
+  WELS_VERIFY_RETURN_IF (ERR_INFO_OUT_OF_MEMORY, NULL == pBuf);
+  if (pPic == pCtx->pPreviousDecodedPictureInDpb) // error concealment may still copy from it
+    memcpy (pBuf, pPic->pBuffer[0], GetPicLumaSize (pPic) * 3 / 2);
+  FreePicBuffer (pPic, pCtx->pMemAlign);
+  SetPicBuffer (pCtx, pPic, pBuf, pUserBuffer);
+
+  return ERR_NONE;
+}
+
+typedef struct TagHeldPicBuffer {
+  WELS_MUTEX      hMutex;
+  int32_t         iRefCount;
+} SHeldPicBuffer;
+
+#define HELD_PIC_HEADER_SIZE  WELS_ALIGN (sizeof (SHeldPicBuffer), 16)
+
+static inline SHeldPicBuffer* GetHeldPicHeader (void* pBuffer) {
+  return (SHeldPicBuffer*) ((uint8_t*)pBuffer - HELD_PIC_HEADER_SIZE);
+}
+
+static void* GetHeldPicBuffer (void* pUserContext, int iSize) {
+  // plain malloc: no need to clear the memory, and it may outlive the memory accounting of the decoder
+  SHeldPicBuffer* pHeader = (SHeldPicBuffer*)malloc (HELD_PIC_HEADER_SIZE + iSize);
+  WELS_VERIFY_RETURN_IF (NULL, NULL == pHeader);
+
+  WelsMutexInit (&pHeader->hMutex);
+  pHeader->iRefCount = 1;
+  return (uint8_t*)pHeader + HELD_PIC_HEADER_SIZE;
+}
+
+static void ReleaseHeldPicBufferCallback (void* pUserContext, void* pBuffer) {
+  ReleaseHeldPicBuffer (pBuffer);
+}
+
+void InitHeldPicAllocator (SFrameAllocator* pAllocator) {
+  pAllocator->pUserContext    = NULL;
+  pAllocator->pfGetBuffer     = GetHeldPicBuffer;
+  pAllocator->pfReleaseBuffer = ReleaseHeldPicBufferCallback;
+}
+
+void AddRefHeldPicBuffer (void* pBuffer) {
+  SHeldPicBuffer* pHeader = GetHeldPicHeader (pBuffer);
+
+  WelsMutexLock (&pHeader->hMutex);
+  ++ pHeader->iRefCount;
+  WelsMutexUnlock (&pHeader->hMutex);
+}
+
+void ReleaseHeldPicBuffer (void* pBuffer) {
+  SHeldPicBuffer* pHeader = GetHeldPicHeader (pBuffer);
+  int32_t iRefCount;
+
+  WelsMutexLock (&pHeader->hMutex);
+  iRefCount = -- pHeader->iRefCount;
+  WelsMutexUnlock (&pHeader->hMutex);
+  if (iRefCount == 0) {
+    WelsMutexDestroy (&pHeader->hMutex);
+    free (pHeader);
+  }
+}
+
+static inline bool IsPicFree (PPicture pPic, const bool kbSkipAliased) {
+  return pPic != NULL && pPic->bAvailableFlag && !pPic->bUsedAsRef && pPic->uiRefCount == 0
+         && ! (kbSkipAliased && pPic->iAliasNum > 0);
+}
+
+static PPicture PrefetchPicFrom (PPicBuff pPicBuf, const bool kbSkipAliased) {
+  int32_t iPicIdx = 0;
+  PPicture pPic  = NULL;
 
   for (iPicIdx = pPicBuf->iCurrentIdx + 1; iPicIdx < pPicBuf->iCapacity ; ++iPicIdx) {
-    if (pPicBuf->ppPic[iPicIdx] != NULL && pPicBuf->ppPic[iPicIdx]->bAvailableFlag
-        && !pPicBuf->ppPic[iPicIdx]->bUsedAsRef) {
+    if (IsPicFree (pPicBuf->ppPic[iPicIdx], kbSkipAliased)) {
       pPic = pPicBuf->ppPic[iPicIdx];
       break;
     }
@@ -143,8 +354,7 @@ PPicture PrefetchPic (PPicBuff pPicBuf) {
     return pPic;
   }
   for (iPicIdx = 0 ; iPicIdx <= pPicBuf->iCurrentIdx ; ++iPicIdx) {
-    if (pPicBuf->ppPic[iPicIdx] != NULL && pPicBuf->ppPic[iPicIdx]->bAvailableFlag
-        && !pPicBuf->ppPic[iPicIdx]->bUsedAsRef) {
+    if (IsPicFree (pPicBuf->ppPic[iPicIdx], kbSkipAliased)) {
       pPic = pPicBuf->ppPic[iPicIdx];
       break;
     }
@@ -154,4 +364,23 @@ PPicture PrefetchPic (PPicBuff pPicBuf) {
   return pPic;
 }
 
+PPicture PrefetchPic (PPicBuff pPicBuf) {
+  const int32_t kiCurrentIdx = pPicBuf->iCurrentIdx;
+  PPicture pPic  = NULL;
+
+  if (pPicBuf->iCapacity == 0) {
+    return NULL;
+  }
+
+  // recycling a picture whose planes are shared by concealed ones costs a copy, take another one first
+  pPic = PrefetchPicFrom (pPicBuf, true);
+  if (pPic == NULL) {
+    pPicBuf->iCurrentIdx = kiCurrentIdx;
+    pPic = PrefetchPicFrom (pPicBuf, false);
+  }
+  if (pPic != NULL)
+    pPic->iPaddingLen = PADDING_LENGTH; // fully padded unless decoded in fast preview
+  return pPic;
+}
+
 } // namespace WelsDec
@@ -41,6 +41,9 @@
 
 #include "rec_mb.h"
 #include "decode_slice.h"
+#include "wels_decoder_thread.h"
+#include "ls_defines.h"
+#include "get_intra_predictor.h"
 
 namespace WelsDec {
 
@@ -191,16 +194,30 @@ int32_t RecI16x16Mb (int32_t iMBXY, PWelsDecoderContext pCtx, int16_t* pScoeffLe
   uint8_t* pPred = pDqLayer->pPred[0];
 
   PIdctFourResAddPredFunc pIdctFourResAddPredFunc = pCtx->pIdctFourResAddPredFunc;
-
-  /*decode i16x16 y*/
-  pGetI16x16LumaPredFunc[iI16x16PredMode] (pPred, iYStride);
-
-  /*1 mb is divided 16 4x4_block to idct*/
-  const int8_t* pNzc = pDqLayer->pNzc[iMBXY];
-  pIdctFourResAddPredFunc (pPred + 0 * iYStride + 0, iYStride, pRS + 0 * 64, pNzc +  0);
-  pIdctFourResAddPredFunc (pPred + 0 * iYStride + 8, iYStride, pRS + 1 * 64, pNzc +  2);
-  pIdctFourResAddPredFunc (pPred + 8 * iYStride + 0, iYStride, pRS + 2 * 64, pNzc +  8);
-  pIdctFourResAddPredFunc (pPred + 8 * iYStride + 8, iYStride, pRS + 3 * 64, pNzc + 10);
+  PIdctFourRecFunc pIdctFourRecFunc = pCtx->pIdctFourRecFunc;
+  ENFORCE_STACK_ALIGN_1D (uint8_t, uiPredRow, 16, 16);
+  uint8_t* pPredRow = NULL;
+
+  if (pIdctFourRecFunc != NULL)
+    pPredRow = WelsI16x16LumaPredRow (pPred, iYStride, iI16x16PredMode, uiPredRow);
+
+  if (pPredRow != NULL) {
+    /*the prediction is one row, the idct adds the residual to it and writes each sample once*/
+    pIdctFourRecFunc (pPred + 0 * iYStride + 0, iYStride, pPredRow + 0, 0, pRS + 0 * 64);
+    pIdctFourRecFunc (pPred + 0 * iYStride + 8, iYStride, pPredRow + 8, 0, pRS + 1 * 64);
+    pIdctFourRecFunc (pPred + 8 * iYStride + 0, iYStride, pPredRow + 0, 0, pRS + 2 * 64);
+    pIdctFourRecFunc (pPred + 8 * iYStride + 8, iYStride, pPredRow + 8, 0, pRS + 3 * 64);
+  } else {
+    /*decode i16x16 y*/
+    pGetI16x16LumaPredFunc[iI16x16PredMode] (pPred, iYStride);
+
+    /*1 mb is divided 16 4x4_block to idct*/
+    const int8_t* pNzc = pDqLayer->pNzc[iMBXY];
+    pIdctFourResAddPredFunc (pPred + 0 * iYStride + 0, iYStride, pRS + 0 * 64, pNzc +  0);
+    pIdctFourResAddPredFunc (pPred + 0 * iYStride + 8, iYStride, pRS + 1 * 64, pNzc +  2);
+    pIdctFourResAddPredFunc (pPred + 8 * iYStride + 0, iYStride, pRS + 2 * 64, pNzc +  8);
+    pIdctFourResAddPredFunc (pPred + 8 * iYStride + 8, iYStride, pRS + 3 * 64, pNzc + 10);
+  }
 
   /*decode intra mb cb&cr*/
   pPred = pDqLayer->pPred[1];
@@ -227,9 +244,35 @@ static inline void GetRefPic (sMCRefMember* pMCRefMem, PWelsDecoderContext pCtx,
   pMCRefMem->pSrcY = pRefPic->pData[0];
   pMCRefMem->pSrcU = pRefPic->pData[1];
   pMCRefMem->pSrcV = pRefPic->pData[2];
+
+  pMCRefMem->pRefPic = pRefPic;
+  pMCRefMem->pRefReadyRows = (pCtx->pRefReadyMbRows != NULL) ? &pCtx->pRefReadyMbRows[iRefIdx] : NULL;
 }
 
 
+void McChromaFullPel (const uint8_t* pSrc, int32_t iSrcStride, uint8_t* pDst, int32_t iDstStride,
+                      int16_t iMvX, int16_t iMvY, int32_t iWidth, int32_t iHeight) {
+  pSrc += ((iMvX & 0x07) >> 2) + ((iMvY & 0x07) >> 2) * iSrcStride;
+  for (int32_t i = 0; i < iHeight; i++) {
+    if (iWidth == 8)
+      ST64 (pDst, LD64 (pSrc));
+    else if (iWidth == 4)
+      ST32 (pDst, LD32 (pSrc));
+    else
+      ST16 (pDst, LD16 (pSrc));
+    pSrc += iSrcStride;
+    pDst += iDstStride;
+  }
+}
+
+// fast preview: widen the margin padded around a reference before a block reads beyond it, chroma
+// reads at most half as far and gets half the margin
+static void ExpandPreviewMargin (PPicture pPic, int32_t iReach, PExpandPictureLinesFunc pExpLines) {
+  pPic->iPaddingLen = WELS_MIN (WELS_ALIGN (iReach, 16), PADDING_LENGTH);
+  ExpandReferencingPictureRows (pPic->pData, pPic->iWidthInPixel, pPic->iHeightInPixel, pPic->iLinesize, 0,
+                                (pPic->iHeightInPixel + 15) >> 4, pPic->iPaddingLen, pExpLines);
+}
+
 #ifndef MC_FLOW_SIMPLE_JUDGE
 #define MC_FLOW_SIMPLE_JUDGE 1
 #endif //MC_FLOW_SIMPLE_JUDGE
@@ -242,6 +285,22 @@ void BaseMC (sMCRefMember* pMCRefMem, int32_t iXOffset, int32_t iYOffset, SMcFun
   iFullMVy = WELS_CLIP3 (iFullMVy, ((-PADDING_LENGTH + 2) * (1 << 2)),
                          ((pMCRefMem->iPicHeight + PADDING_LENGTH - 19) * (1 << 2)));
 
+  if (pMCRefMem->pMvReach != NULL) { // 6-tap interpolation reads 2 pixels before and 3 after the block
+    const int32_t kiReachX = WELS_MAX (2 - (iFullMVx >> 2), (iFullMVx >> 2) + iBlkWidth + 3 - pMCRefMem->iPicWidth);
+    const int32_t kiReachY = WELS_MAX (2 - (iFullMVy >> 2), (iFullMVy >> 2) + iBlkHeight + 3 - pMCRefMem->iPicHeight);
+    const int32_t kiReach = WELS_MAX (WELS_MAX (kiReachX, kiReachY), 0);
+    *pMCRefMem->pMvReach = WELS_MAX (*pMCRefMem->pMvReach, kiReach);
+    if (kiReach > pMCRefMem->pRefPic->iPaddingLen)
+      ExpandPreviewMargin (pMCRefMem->pRefPic, kiReach, pMCRefMem->pfExpandPreviewLines);
+  }
+
+  if (pMCRefMem->pRefReadyRows != NULL) { // reference may still be in reconstruction on another frame thread
+    const int32_t kiLastRow = (iFullMVy >> 2) + iBlkHeight + 2; // 6-tap interpolation reads 3 rows below the block
+    const int32_t kiNeedRows = (kiLastRow >= pMCRefMem->iPicHeight) ? PIC_READY_ALL : ((WELS_MAX (kiLastRow, 0) >> 4) + 1);
+    if (*pMCRefMem->pRefReadyRows < kiNeedRows)
+      *pMCRefMem->pRefReadyRows = WelsDecThreadWaitPicRows (pMCRefMem->pRefPic, kiNeedRows);
+  }
+
   int32_t iSrcPixOffsetLuma = (iFullMVx >> 2) + (iFullMVy >> 2) * pMCRefMem->iSrcLineLuma;
   int32_t iSrcPixOffsetChroma = (iFullMVx >> 3) + (iFullMVy >> 3) * pMCRefMem->iSrcLineChroma;
 
@@ -360,6 +419,8 @@ void GetInterPred (uint8_t* pPredY, uint8_t* pPredCb, uint8_t* pPredCr, PWelsDec
 
   pMCRefMem.iDstLineLuma   = iDstLineLuma;
   pMCRefMem.iDstLineChroma = iDstLineChroma;
+  pMCRefMem.pMvReach = (pCtx->pParam->bFastPreview && pCtx->pThreadCtx == NULL) ? &pCtx->iPreviewMvReach : NULL;
+  pMCRefMem.pfExpandPreviewLines = pCtx->sExpandPicFunc.pfExpandPictureLines;
 
   int32_t iRefIndex = 0;
 
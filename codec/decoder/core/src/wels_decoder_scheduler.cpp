@@ -0,0 +1,369 @@
+/*!
+ * \copy
+ *     Copyright (c)  2013, Cisco Systems
+ *     All rights reserved.
+ *
+ *     Redistribution and use in source and binary forms, with or without
+ *     modification, are permitted provided that the following conditions
+ *     are met:
+ *
+ *        * Redistributions of source code must retain the above copyright
+ *          notice, this list of conditions and the following disclaimer.
+ *
+ *        * Redistributions in binary form must reproduce the above copyright
+ *          notice, this list of conditions and the following disclaimer in
+ *          the documentation and/or other materials provided with the
+ *          distribution.
+ *
+ *     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *     "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *     LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *     FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *     COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *     INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *     BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *     LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *     CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *     LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *     ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *     POSSIBILITY OF SUCH DAMAGE.
+ *
+ * \file    wels_decoder_scheduler.cpp
+ *
+ * \brief   access units of many decoders decoded on the workers of the shared thread pool
+ *
+ *          Each decoder (client) queues copies of its access units, they are run in order and one at a
+ *          time. Up to iWorkerNum tasks of the thread pool pick the runnable client with the smallest
+ *          virtual time, the decoding time it used so far divided by its weight, and keep running the
+ *          clients until none is left runnable. A client becoming runnable after being idle starts from
+ *          the virtual time of the client picked last, so idling earns it no credit over the busy ones.
+ *
+ * \date    10/18/2026 Created
+ *
+ *************************************************************************************
+ */
+
+#include "wels_decoder_scheduler.h"
+#include "WelsThreadPool.h"
+#include "memory_align.h"
+#include "measure_time.h"
+#include "macros.h"
+#include "cpu.h"
+#include "error_code.h"
+
+using namespace WelsCommon;
+
+namespace WelsDec {
+
+class CWelsDecSchedTask;
+
+typedef struct TagDecSchedJob {
+  struct TagDecSchedJob* pNext;
+  bool            bFlush;               // DecodeFrame2 (NULL, 0)
+  int32_t         iSrcLen;
+  uint64_t        uiTimeStamp;
+  int64_t         iQueueTime;
+} SDecSchedJob;                         // followed by the access unit
+
+#define DEC_SCHED_JOB_HEADER_SIZE  WELS_ALIGN (sizeof (SDecSchedJob), 16)
+
+struct TagDecSchedClient {
+  PDecSchedRunFunc pfRun;
+  void*           pArg;
+  int32_t         iWeight;
+  SDecSchedJob*   pJobHead;
+  SDecSchedJob*   pJobTail;
+  int32_t         iJobNum;              // queued or running
+  bool            bRunning;             // one of its jobs is run by a worker
+  bool            bRunnable;            // in the runnable list
+  uint64_t        uiVirtualTime;
+  struct TagDecSchedClient* pNextRunnable;
+  SDecoderSchedulingStatistics sStats;
+};
+
+typedef struct TagDecScheduler {
+  bool            bInitialized;         // the mutex and the condition are kept once created
+  WELS_MUTEX      hMutex;
+  WELS_COND       hCond;                // signalled when a job is done or a task is back
+  int32_t         iClientNum;
+  CWelsThreadPool* pThreadPool;
+  int32_t         iWorkerNum;
+  int32_t         iActiveNum;           // tasks queued or looking for jobs
+  CWelsDecSchedTask** ppTask;           // free tasks in [0, iFreeTaskNum)
+  int32_t         iTaskNum;
+  int32_t         iFreeTaskNum;
+  SDecSchedClient* pRunnable;
+  uint64_t        uiVirtualTime;
+} SDecScheduler;
+
+static CWelsLock s_cDecSchedLock;       // serializes joining and leaving
+static SDecScheduler s_sDecScheduler;
+
+static void RunDecSchedWorker (SDecScheduler* pSched);
+static void ReleaseDecSchedTask (SDecScheduler* pSched, CWelsDecSchedTask* pTask);
+
+class CWelsDecSchedTask : public IWelsTask, public IWelsTaskSink {
+ public:
+  CWelsDecSchedTask() : IWelsTask (this) {
+  }
+  virtual ~CWelsDecSchedTask() {
+  }
+
+  virtual int Execute() {
+    RunDecSchedWorker (&s_sDecScheduler);
+    return 0;
+  }
+  // the pool is done with the task only now, it cannot be queued again from here as the thread may be picked
+  virtual int OnTaskExecuted() {
+    ReleaseDecSchedTask (&s_sDecScheduler, this);
+    return 0;
+  }
+  virtual int OnTaskCancelled() {
+    ReleaseDecSchedTask (&s_sDecScheduler, this);
+    return 0;
+  }
+};
+
+static void ReleaseDecSchedTask (SDecScheduler* pSched, CWelsDecSchedTask* pTask) {
+  WelsMutexLock (&pSched->hMutex);
+  pSched->ppTask[pSched->iFreeTaskNum ++] = pTask;
+  WelsCondBroadcast (&pSched->hCond);
+  WelsMutexUnlock (&pSched->hMutex);
+}
+
+/*
+ *  call with the mutex held, a task to queue once the mutex is released: QueueTask() may wait for a thread
+ *  leaving OnTaskExecuted(), which takes the mutex. A task left the loop of RunDecSchedWorker() before going
+ *  back to the free ones, but there are as many tasks as workers plus threads in the pool: with less than
+ *  iWorkerNum active workers, one is always free.
+ */
+static CWelsDecSchedTask* TakeDecSchedTask (SDecScheduler* pSched) {
+  if (pSched->pRunnable == NULL || pSched->iActiveNum >= pSched->iWorkerNum || pSched->iFreeTaskNum == 0)
+    return NULL;
+
+  ++ pSched->iActiveNum;
+  return pSched->ppTask[-- pSched->iFreeTaskNum];
+}
+
+static void QueueDecSchedTask (SDecScheduler* pSched, CWelsDecSchedTask* pTask) {
+  if (WELS_THREAD_ERROR_OK == pSched->pThreadPool->QueueTask (pTask))
+    return;
+
+  WelsMutexLock (&pSched->hMutex); // retried by the next submission
+  pSched->ppTask[pSched->iFreeTaskNum ++] = pTask;
+  -- pSched->iActiveNum;
+  WelsCondBroadcast (&pSched->hCond);
+  WelsMutexUnlock (&pSched->hMutex);
+}
+
+// call with the mutex held
+static void AddDecSchedRunnable (SDecScheduler* pSched, SDecSchedClient* pClient) {
+  pClient->bRunnable = true;
+  pClient->pNextRunnable = pSched->pRunnable;
+  pSched->pRunnable = pClient;
+}
+
+// call with the mutex held, the runnable client with the smallest virtual time
+static SDecSchedClient* PickDecSchedClient (SDecScheduler* pSched) {
+  SDecSchedClient** ppBest = NULL;
+  for (SDecSchedClient** ppClient = &pSched->pRunnable; *ppClient != NULL; ppClient = & (*ppClient)->pNextRunnable) {
+    if (ppBest == NULL || (*ppClient)->uiVirtualTime < (*ppBest)->uiVirtualTime)
+      ppBest = ppClient;
+  }
+  if (ppBest == NULL)
+    return NULL;
+
+  SDecSchedClient* pClient = *ppBest;
+  *ppBest = pClient->pNextRunnable;
+  pClient->pNextRunnable = NULL;
+  pClient->bRunnable = false;
+  pSched->uiVirtualTime = WELS_MAX (pSched->uiVirtualTime, pClient->uiVirtualTime);
+  return pClient;
+}
+
+static void RunDecSchedWorker (SDecScheduler* pSched) {
+  WelsMutexLock (&pSched->hMutex);
+  for (;;) {
+    SDecSchedClient* pClient = PickDecSchedClient (pSched);
+    if (pClient == NULL)
+      break;
+
+    SDecSchedJob* pJob = pClient->pJobHead;
+    pClient->pJobHead = pJob->pNext;
+    if (pClient->pJobHead == NULL)
+      pClient->pJobTail = NULL;
+    pClient->bRunning = true;
+    WelsMutexUnlock (&pSched->hMutex);
+
+    const int64_t kiStartTime = WelsTime();
+    pClient->pfRun (pClient->pArg, pJob->bFlush ? NULL : (uint8_t*)pJob + DEC_SCHED_JOB_HEADER_SIZE, pJob->iSrcLen,
+                    pJob->uiTimeStamp);
+    const int64_t kiEndTime = WelsTime();
+    const uint64_t kuiWaitUs = (uint64_t)WELS_MAX (kiStartTime - pJob->iQueueTime, 0);
+    const uint64_t kuiDecodeUs = (uint64_t)WELS_MAX (kiEndTime - kiStartTime, 0);
+    WelsFree (pJob, "SDecSchedJob");
+
+    WelsMutexLock (&pSched->hMutex);
+    SDecoderSchedulingStatistics* pStats = &pClient->sStats;
+    ++ pStats->uiDecodedNum;
+    pStats->uiTotalWaitUs += kuiWaitUs;
+    pStats->uiMaxWaitUs = WELS_MAX (pStats->uiMaxWaitUs, kuiWaitUs);
+    pStats->uiTotalDecodeUs += kuiDecodeUs;
+    pStats->uiMaxDecodeUs = WELS_MAX (pStats->uiMaxDecodeUs, kuiDecodeUs);
+    pClient->uiVirtualTime += (kuiDecodeUs + 1) / pClient->iWeight;
+    pClient->bRunning = false;
+    -- pClient->iJobNum;
+    if (pClient->pJobHead != NULL)
+      AddDecSchedRunnable (pSched, pClient);
+    WelsCondBroadcast (&pSched->hCond);
+  }
+  -- pSched->iActiveNum;
+  WelsMutexUnlock (&pSched->hMutex);
+}
+
+// call with s_cDecSchedLock held
+static int32_t InitDecScheduler (SDecScheduler* pSched) {
+  int32_t iCpuCores = 1;
+
+  if (!CWelsThreadPool::IsReferenced()) {
+    WelsCPUFeatureDetect (&iCpuCores);
+    CWelsThreadPool::SetThreadNum (WELS_MAX (iCpuCores, 1));
+  }
+  pSched->pThreadPool = CWelsThreadPool::AddReference();
+  WELS_VERIFY_RETURN_IF (ERR_INFO_OUT_OF_MEMORY, NULL == pSched->pThreadPool);
+
+  pSched->iWorkerNum = WELS_CLIP3 (pSched->pThreadPool->GetThreadNum(), 1, MAX_DEC_SCHED_WORKER_NUM);
+  pSched->iTaskNum = pSched->iWorkerNum + pSched->pThreadPool->GetThreadNum();
+  pSched->ppTask = (CWelsDecSchedTask**)WelsMallocz (pSched->iTaskNum * sizeof (CWelsDecSchedTask*), "ppTask");
+  WELS_VERIFY_RETURN_PROC_IF (ERR_INFO_OUT_OF_MEMORY, NULL == pSched->ppTask, pSched->iTaskNum = 0)
+  for (pSched->iFreeTaskNum = 0; pSched->iFreeTaskNum < pSched->iTaskNum; ++ pSched->iFreeTaskNum) {
+    pSched->ppTask[pSched->iFreeTaskNum] = WELS_NEW_OP (CWelsDecSchedTask(), CWelsDecSchedTask);
+    WELS_VERIFY_RETURN_IF (ERR_INFO_OUT_OF_MEMORY, NULL == pSched->ppTask[pSched->iFreeTaskNum]);
+  }
+  return ERR_NONE;
+}
+
+// call with s_cDecSchedLock held, once the tasks are all back
+static void UninitDecScheduler (SDecScheduler* pSched) {
+  for (int32_t i = 0; i < pSched->iFreeTaskNum; ++ i) {
+    WELS_DELETE_OP (pSched->ppTask[i]);
+  }
+  if (pSched->ppTask != NULL)
+    WelsFree (pSched->ppTask, "ppTask");
+  pSched->ppTask = NULL;
+  pSched->iTaskNum = pSched->iFreeTaskNum = 0;
+  if (pSched->pThreadPool != NULL)
+    pSched->pThreadPool->RemoveInstance();
+  pSched->pThreadPool = NULL;
+  pSched->uiVirtualTime = 0;
+}
+
+SDecSchedClient* WelsDecSchedJoin (PDecSchedRunFunc pfRun, void* pArg, int32_t iWeight) {
+  SDecScheduler* pSched = &s_sDecScheduler;
+  CWelsAutoLock cLock (s_cDecSchedLock);
+
+  if (!pSched->bInitialized) {
+    WelsMutexInit (&pSched->hMutex);
+    WelsCondInit (&pSched->hCond);
+    pSched->bInitialized = true;
+  }
+  if (pSched->iClientNum == 0 && ERR_NONE != InitDecScheduler (pSched)) {
+    UninitDecScheduler (pSched);
+    return NULL;
+  }
+
+  SDecSchedClient* pClient = (SDecSchedClient*)WelsMallocz (sizeof (SDecSchedClient), "SDecSchedClient");
+  if (pClient == NULL) {
+    if (pSched->iClientNum == 0)
+      UninitDecScheduler (pSched);
+    return NULL;
+  }
+  pClient->pfRun = pfRun;
+  pClient->pArg = pArg;
+  pClient->iWeight = WELS_MAX (iWeight, 1);
+  WelsMutexLock (&pSched->hMutex);
+  pClient->uiVirtualTime = pSched->uiVirtualTime;
+  WelsMutexUnlock (&pSched->hMutex);
+  ++ pSched->iClientNum;
+  return pClient;
+}
+
+void WelsDecSchedLeave (SDecSchedClient* pClient) {
+  SDecScheduler* pSched = &s_sDecScheduler;
+
+  WelsDecSchedWait (pClient);
+  WelsFree (pClient, "SDecSchedClient");
+
+  CWelsAutoLock cLock (s_cDecSchedLock);
+  if (-- pSched->iClientNum > 0)
+    return;
+
+  WelsMutexLock (&pSched->hMutex);
+  while (pSched->iActiveNum > 0 || pSched->iFreeTaskNum < pSched->iTaskNum)
+    WelsCondWait (&pSched->hCond, &pSched->hMutex);
+  WelsMutexUnlock (&pSched->hMutex);
+  UninitDecScheduler (pSched);
+}
+
+void WelsDecSchedSetWeight (SDecSchedClient* pClient, int32_t iWeight) {
+  SDecScheduler* pSched = &s_sDecScheduler;
+
+  WelsMutexLock (&pSched->hMutex);
+  pClient->iWeight = WELS_MAX (iWeight, 1);
+  WelsMutexUnlock (&pSched->hMutex);
+}
+
+int32_t WelsDecSchedSubmit (SDecSchedClient* pClient, const uint8_t* kpSrc, const int32_t kiSrcLen,
+                            uint64_t uiTimeStamp) {
+  SDecScheduler* pSched = &s_sDecScheduler;
+  const bool kbFlush = (kpSrc == NULL || kiSrcLen <= 0);
+  const int32_t kiSrcLenCopied = kbFlush ? 0 : kiSrcLen;
+  CWelsDecSchedTask* pTask = NULL;
+
+  SDecSchedJob* pJob = (SDecSchedJob*)WelsMallocz (DEC_SCHED_JOB_HEADER_SIZE + kiSrcLenCopied, "SDecSchedJob");
+  WELS_VERIFY_RETURN_IF (ERR_INFO_OUT_OF_MEMORY, NULL == pJob);
+  pJob->pNext = NULL;
+  pJob->bFlush = kbFlush;
+  pJob->iSrcLen = kiSrcLenCopied;
+  pJob->uiTimeStamp = uiTimeStamp;
+  if (!kbFlush)
+    memcpy ((uint8_t*)pJob + DEC_SCHED_JOB_HEADER_SIZE, kpSrc, kiSrcLenCopied);
+
+  WelsMutexLock (&pSched->hMutex);
+  pJob->iQueueTime = WelsTime();
+  if (pClient->pJobTail != NULL)
+    pClient->pJobTail->pNext = pJob;
+  else
+    pClient->pJobHead = pJob;
+  pClient->pJobTail = pJob;
+  ++ pClient->iJobNum;
+  if (!pClient->bRunning && !pClient->bRunnable) {
+    pClient->uiVirtualTime = WELS_MAX (pClient->uiVirtualTime, pSched->uiVirtualTime);
+    AddDecSchedRunnable (pSched, pClient);
+    pTask = TakeDecSchedTask (pSched);
+  }
+  WelsMutexUnlock (&pSched->hMutex);
+  if (pTask != NULL)
+    QueueDecSchedTask (pSched, pTask);
+  return ERR_NONE;
+}
+
+void WelsDecSchedWait (SDecSchedClient* pClient) {
+  SDecScheduler* pSched = &s_sDecScheduler;
+
+  WelsMutexLock (&pSched->hMutex);
+  while (pClient->iJobNum > 0)
+    WelsCondWait (&pSched->hCond, &pSched->hMutex);
+  WelsMutexUnlock (&pSched->hMutex);
+}
+
+void WelsDecSchedGetStatistics (SDecSchedClient* pClient, SDecoderSchedulingStatistics* pStats) {
+  SDecScheduler* pSched = &s_sDecScheduler;
+
+  WelsMutexLock (&pSched->hMutex);
+  *pStats = pClient->sStats;
+  pStats->uiQueuedNum = pClient->iJobNum;
+  WelsMutexUnlock (&pSched->hMutex);
+}
+
+} // namespace WelsDec
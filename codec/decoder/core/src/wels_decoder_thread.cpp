@@ -0,0 +1,1275 @@
+/*!
+ * \copy
+ *     Copyright (c)  2009-2013, Cisco Systems
+ *     All rights reserved.
+ *
+ *     Redistribution and use in source and binary forms, with or without
+ *     modification, are permitted provided that the following conditions
+ *     are met:
+ *
+ *        * Redistributions of source code must retain the above copyright
+ *          notice, this list of conditions and the following disclaimer.
+ *
+ *        * Redistributions in binary form must reproduce the above copyright
+ *          notice, this list of conditions and the following disclaimer in
+ *          the documentation and/or other materials provided with the
+ *          distribution.
+ *
+ *     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *     "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *     LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *     FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *     COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *     INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *     BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *     LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *     CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *     LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *     ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *     POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * \file    wels_decoder_thread.cpp
+ *
+ * \brief   frame level threading of the decoder
+ *
+ *          The calling thread keeps parsing slices and managing the reference lists. When a
+ *          picture has been parsed, its slices (a copy of the dq layer of each) and its MB buffer
+ *          are handed over to a frame slot, and the picture is reconstructed, deblocked and padded
+ *          MB row by MB row on the thread pool. Pictures held by a slot (its target and references)
+ *          or waiting for output are kept out of PrefetchPic() with SPicture::uiRefCount.
+ *
+ * \date    10/18/2026 Created
+ *
+ *************************************************************************************
+ */
+
+#include "wels_decoder_thread.h"
+#include "WelsThreadPool.h"
+#include "memory_align.h"
+#include "decoder_core.h"
+#include "decode_slice.h"
+#include "decode_mb_aux.h"
+#include "deblocking.h"
+#include "expand_pic.h"
+#include "pic_queue.h"
+#include "error_code.h"
+
+namespace WelsDec {
+
+class CWelsDecFrameTask;
+class CWelsDecSliceTask;
+class CWelsDecRowTask;
+
+/*
+ *  one slice of a picture, as left by the parser
+ */
+typedef struct TagDecSliceJob {
+  SDqLayer      sLayer;                          // snapshot of pCtx->pCurDqLayer, slice header included
+  PPicture      pRefList[MAX_DPB_COUNT];         // sRefPic.pRefList[LIST_0] when the slice was parsed
+  int32_t       iRefReadyMbRows[MAX_DPB_COUNT];  // ready MB rows seen so far for each reference
+  bool          bDeblock;
+} SDecSliceJob;
+
+/*
+ *  a picture in reconstruction on the thread pool
+ */
+typedef struct TagDecFrameSlot {
+  CWelsDecFrameTask*    pTask;
+  PWelsDecoderContext   pWorkCtx;                // private copy of the decoder context for reconstruction
+  SMbBuffer             sMb;                     // MB buffer of the picture, iMbWidth/iMbHeight hold its capacity
+
+  SDecSliceJob*         pJobs;
+  int32_t               iJobNum;
+  int32_t               iJobCapacity;
+
+  PPicture              pPic;
+  bool                  bExpand;                 // reference picture, pad it once reconstructed
+  int32_t               iDecBlockOffsetArray[24];
+
+  PPicture              pHeldPic[MAX_DPB_COUNT + 1];
+  int32_t               iHeldNum;
+
+  bool                  bRunning;                // launched and not reaped yet, calling thread only
+  bool                  bDone;                   // protected by hMutex
+  WELS_MUTEX            hMutex;
+  WELS_COND             hCond;
+} SDecFrameSlot;
+
+/*
+ *  a decoded picture not reported to the application yet
+ */
+typedef struct TagDecOutputRecord {
+  PPicture      pPic;                            // NULL once detached from the picture buffers
+  uint8_t*      pDst[3];
+  SBufferInfo   sDstInfo;
+  uint8_t*      pCopyBuf;                        // packed copy of the picture when detached
+} SDecOutputRecord;
+
+/*
+ *  a slice queued for slice threading
+ */
+typedef struct TagDecSliceUnit {
+  SDqLayer      sLayer;                          // pCtx->pCurDqLayer when the slice was queued
+  SDqLayer      sDoneLayer;                      // sLayer as left by decoding of the slice
+  SRefPic       sRefPic;
+  PNalUnit      pNal;
+  SBitStringAux sBsStart;                        // bitstream reader of pNal at the start of the slice data
+  PFmo          pFmo;
+  bool          bFreshSlice;
+  bool          bRPLRError;
+  int32_t       iRet;                            // returned by WelsDecodeSlice()
+  int32_t       iErrorCode;                      // raised while decoding, to be merged into pCtx->iErrorCode
+  bool          bDone;                           // protected by hSliceMutex
+} SDecSliceUnit;
+
+/*
+ *  a thread decoding queued slices, the first one is the calling thread
+ */
+typedef struct TagDecSliceThread {
+  CWelsDecSliceTask*    pTask;
+  PWelsDecoderContext   pWorkCtx;                // private copy of the decoder context
+} SDecSliceThread;
+
+struct TagWelsDecThreadCtx {
+  WelsCommon::CWelsThreadPool*  pThreadPool;
+  int32_t               iThreadNum;
+  bool                  bSliceThreading;
+
+  SDecFrameSlot         sSlot[MAX_DEC_FRAME_THREAD_NUM];
+  int32_t               iBuildSlot;              // slot collecting the slices of the picture being parsed
+
+  SDecOutputRecord      sOutput[MAX_DEC_FRAME_THREAD_NUM + 1];
+  int32_t               iOutputHead;
+  int32_t               iOutputNum;
+  bool                  bOutputPushed;           // a picture was queued since the last output call
+  uint8_t*              pReportedCopyBuf;        // copy last reported to the application, freed on next call
+
+  SDecSliceThread       sSliceThread[MAX_DEC_FRAME_THREAD_NUM];
+  SDecSliceUnit*        pSliceUnits;
+  int32_t               iSliceUnitNum;
+  int32_t               iSliceUnitCapacity;
+  int32_t               iNextSliceUnit;          // first unit no thread took yet, protected by hSliceMutex
+  int32_t               iRunningSliceTasks;      // protected by hSliceMutex
+  WELS_MUTEX            hSliceMutex;
+  WELS_COND             hSliceCond;
+
+  CWelsDecRowTask*      pRowTask[MAX_DEC_FRAME_THREAD_NUM];
+  bool                  bRowTaskQueued[MAX_DEC_FRAME_THREAD_NUM]; // protected by hRowMutex
+  PWelsDecoderContext   pRowCtx;                 // job of WelsDecThreadRunRows(), protected by hRowMutex
+  PWelsDecRowsFunc      pfRows;
+  void*                 pRowsArg;
+  int32_t               iRowNum;
+  int32_t               iNextRow;
+  int32_t               iBusyRowNum;             // rows taken and not done yet
+  WELS_MUTEX            hRowMutex;
+  WELS_COND             hRowCond;
+};
+typedef struct TagWelsDecThreadCtx SWelsDecThreadCtx;
+
+static void ReconstructPicture (SDecFrameSlot* pSlot);
+
+static void PublishReadyRows (PPicture pPic, int32_t iMbRows) {
+  WelsMutexLock (&pPic->hReadyMutex);
+  pPic->iReadyMbRows = iMbRows;
+  WelsCondBroadcast (&pPic->hReadyCond);
+  WelsMutexUnlock (&pPic->hReadyMutex);
+}
+
+static void SetSlotDone (SDecFrameSlot* pSlot) {
+  WelsMutexLock (&pSlot->hMutex);
+  pSlot->bDone = true;
+  WelsCondBroadcast (&pSlot->hCond);
+  WelsMutexUnlock (&pSlot->hMutex);
+}
+
+static void WaitSlotDone (SDecFrameSlot* pSlot) {
+  WelsMutexLock (&pSlot->hMutex);
+  while (!pSlot->bDone)
+    WelsCondWait (&pSlot->hCond, &pSlot->hMutex);
+  WelsMutexUnlock (&pSlot->hMutex);
+}
+
+class CWelsDecFrameTask : public WelsCommon::IWelsTask, public WelsCommon::IWelsTaskSink {
+ public:
+  CWelsDecFrameTask (SDecFrameSlot* pSlot) : IWelsTask (this), m_pSlot (pSlot) {
+  }
+  virtual ~CWelsDecFrameTask() {
+  }
+
+  virtual int Execute() {
+    ReconstructPicture (m_pSlot);
+    return 0;
+  }
+  virtual int OnTaskExecuted() {
+    SetSlotDone (m_pSlot);
+    return 0;
+  }
+  virtual int OnTaskCancelled() {
+    PublishReadyRows (m_pSlot->pPic, PIC_READY_ALL); // do not leave later pictures waiting for it
+    SetSlotDone (m_pSlot);
+    return 0;
+  }
+
+ private:
+  SDecFrameSlot* m_pSlot;
+};
+
+int32_t WelsDecThreadWaitPicRows (PPicture pPic, int32_t iMbRows) {
+  int32_t iReadyMbRows;
+
+  WelsMutexLock (&pPic->hReadyMutex);
+  while (pPic->iReadyMbRows < iMbRows)
+    WelsCondWait (&pPic->hReadyCond, &pPic->hReadyMutex);
+  iReadyMbRows = pPic->iReadyMbRows;
+  WelsMutexUnlock (&pPic->hReadyMutex);
+
+  return iReadyMbRows;
+}
+
+static inline int32_t GetJobFirstMb (SDecSliceJob* pJob) {
+  return pJob->sLayer.sLayerInfo.sSliceInLayer.sSliceHeaderExt.sSliceHeader.iFirstMbInSlice;
+}
+
+static inline int32_t GetJobMbNum (SDecSliceJob* pJob) {
+  return pJob->sLayer.sLayerInfo.sSliceInLayer.iTotalMbInCurSlice;
+}
+
+static inline void SwitchSliceJob (PWelsDecoderContext pCtx, SDecSliceJob* pJob) {
+  pCtx->pCurDqLayer = &pJob->sLayer;
+  memcpy (pCtx->sRefPic.pRefList[LIST_0], pJob->pRefList, sizeof (pJob->pRefList));
+  pCtx->pRefReadyMbRows = pJob->iRefReadyMbRows;
+}
+
+static void ReconstructMbRange (PWelsDecoderContext pCtx, int32_t iFirstMbXy, int32_t iLastMbXy) {
+  PDqLayer pCurLayer = pCtx->pCurDqLayer;
+
+  for (int32_t iMbXy = iFirstMbXy; iMbXy <= iLastMbXy; ++ iMbXy) {
+    pCurLayer->iMbX = iMbXy % pCurLayer->iMbWidth;
+    pCurLayer->iMbY = iMbXy / pCurLayer->iMbWidth;
+    pCurLayer->iMbXyIndex = iMbXy;
+    WelsTargetMbConstruction (pCtx); // MB types were checked when parsing, cannot fail here
+  }
+}
+
+/*
+ *  reconstruct (or deblock) MBs iFirstMbXy..iLastMbXy of raster ordered jobs, starting from job *pJobIdx
+ */
+static void ProcessMbRange (PWelsDecoderContext pCtx, SDecFrameSlot* pSlot, int32_t* pJobIdx, int32_t iFirstMbXy,
+                            int32_t iLastMbXy, bool bDeblock) {
+  while (*pJobIdx < pSlot->iJobNum) {
+    SDecSliceJob* pJob = &pSlot->pJobs[*pJobIdx];
+    const int32_t kiJobFirst = GetJobFirstMb (pJob);
+    const int32_t kiJobLast  = kiJobFirst + GetJobMbNum (pJob) - 1;
+    const int32_t kiFirst    = WELS_MAX (iFirstMbXy, kiJobFirst);
+    const int32_t kiLast     = WELS_MIN (iLastMbXy, kiJobLast);
+
+    if (kiFirst <= kiLast) {
+      SwitchSliceJob (pCtx, pJob);
+      if (!bDeblock)
+        ReconstructMbRange (pCtx, kiFirst, kiLast);
+      else if (pJob->bDeblock)
+        WelsDeblockingFilterMbRange (pCtx, WelsDeblockingMb, kiFirst, kiLast);
+    }
+    if (kiJobLast > iLastMbXy) // job goes on in next range
+      break;
+    ++ (*pJobIdx);
+  }
+}
+
+/*
+ *  reconstruct, deblock and pad the picture of a slot.
+ *  When its slices cover the picture in raster order, MB row r is reconstructed before row r-1
+ *  is deblocked, which is the last change to row r-2: it is padded and published then.
+ *  Slices never predict across their boundaries, so the result equals the slice by slice order.
+ */
+static void ReconstructPicture (SDecFrameSlot* pSlot) {
+  PWelsDecoderContext pCtx = pSlot->pWorkCtx;
+  PPicture pPic = pSlot->pPic;
+  const int32_t kiMbWidth  = pSlot->pJobs[0].sLayer.iMbWidth;
+  const int32_t kiMbHeight = pSlot->pJobs[0].sLayer.iMbHeight;
+  int32_t iNextMbXy = 0;
+  bool bRasterOrder = true;
+  int32_t i;
+
+  pCtx->pDec = pPic;
+  memcpy (pCtx->iDecBlockOffsetArray, pSlot->iDecBlockOffsetArray, sizeof (pCtx->iDecBlockOffsetArray));
+
+  for (i = 0; i < pSlot->iJobNum && bRasterOrder; ++ i) {
+    bRasterOrder = (GetJobFirstMb (&pSlot->pJobs[i]) == iNextMbXy);
+    iNextMbXy += GetJobMbNum (&pSlot->pJobs[i]);
+  }
+  bRasterOrder = bRasterOrder && (iNextMbXy == kiMbWidth * kiMbHeight);
+
+  if (bRasterOrder) {
+    int32_t iReconJob = 0, iDeblockJob = 0;
+    for (int32_t iMbY = 0; iMbY < kiMbHeight; ++ iMbY) {
+      ProcessMbRange (pCtx, pSlot, &iReconJob, iMbY * kiMbWidth, (iMbY + 1) * kiMbWidth - 1, false);
+      if (iMbY > 0)
+        ProcessMbRange (pCtx, pSlot, &iDeblockJob, (iMbY - 1) * kiMbWidth, iMbY * kiMbWidth - 1, true);
+      if (iMbY > 1) {
+        if (pSlot->bExpand)
+          ExpandReferencingPictureRows (pPic->pData, pPic->iWidthInPixel, pPic->iHeightInPixel, pPic->iLinesize, iMbY - 2,
+                                        iMbY - 1, pPic->iPaddingLen, pCtx->sExpandPicFunc.pfExpandPictureLines);
+        PublishReadyRows (pPic, iMbY - 1);
+      }
+    }
+    ProcessMbRange (pCtx, pSlot, &iDeblockJob, (kiMbHeight - 1) * kiMbWidth, kiMbHeight * kiMbWidth - 1, true);
+    if (pSlot->bExpand)
+      ExpandReferencingPictureRows (pPic->pData, pPic->iWidthInPixel, pPic->iHeightInPixel, pPic->iLinesize,
+                                    WELS_MAX (kiMbHeight - 2, 0), kiMbHeight, pPic->iPaddingLen,
+                                    pCtx->sExpandPicFunc.pfExpandPictureLines);
+  } else {
+    for (i = 0; i < pSlot->iJobNum; ++ i) {
+      SDecSliceJob* pJob = &pSlot->pJobs[i];
+      const int32_t kiFirst = GetJobFirstMb (pJob);
+      const int32_t kiLast  = kiFirst + GetJobMbNum (pJob) - 1;
+      SwitchSliceJob (pCtx, pJob);
+      ReconstructMbRange (pCtx, kiFirst, kiLast);
+      if (pJob->bDeblock)
+        WelsDeblockingFilterMbRange (pCtx, WelsDeblockingMb, kiFirst, kiLast);
+    }
+    if (pSlot->bExpand)
+      ExpandReferencingPictureRows (pPic->pData, pPic->iWidthInPixel, pPic->iHeightInPixel, pPic->iLinesize, 0,
+                                    kiMbHeight, pPic->iPaddingLen, pCtx->sExpandPicFunc.pfExpandPictureLines);
+  }
+
+  PublishReadyRows (pPic, PIC_READY_ALL);
+}
+
+/*
+ *  reconstruct the jobs of a slot with the decoder context itself, all pictures they use must be finished
+ */
+static void ReconstructOnCallingThread (PWelsDecoderContext pCtx, SDecFrameSlot* pSlot, bool bExpand) {
+  PDqLayer pSavedDqLayer = pCtx->pCurDqLayer;
+  PPicture pSavedDec = pCtx->pDec;
+  PPicture pSavedRefList[MAX_DPB_COUNT];
+  int32_t iSavedBlockOffset[24];
+  PWelsDecoderContext pSavedWorkCtx = pSlot->pWorkCtx;
+
+  memcpy (pSavedRefList, pCtx->sRefPic.pRefList[LIST_0], sizeof (pSavedRefList));
+  memcpy (iSavedBlockOffset, pCtx->iDecBlockOffsetArray, sizeof (iSavedBlockOffset));
+
+  pSlot->pWorkCtx = pCtx;
+  pSlot->pPic = pSlot->pJobs[0].sLayer.pDec;
+  pSlot->bExpand = bExpand;
+  GetI4LumaIChromaAddrTable (pSlot->iDecBlockOffsetArray, pSlot->pPic->iLinesize[0], pSlot->pPic->iLinesize[1]);
+  for (int32_t i = 0; i < pSlot->iJobNum; ++ i) { // nothing in flight any more
+    for (int32_t j = 0; j < MAX_DPB_COUNT; ++ j)
+      pSlot->pJobs[i].iRefReadyMbRows[j] = PIC_READY_ALL;
+  }
+  ReconstructPicture (pSlot);
+
+  pSlot->pWorkCtx = pSavedWorkCtx;
+  pSlot->pPic = NULL;
+  pSlot->iJobNum = 0;
+  pCtx->pCurDqLayer = pSavedDqLayer;
+  pCtx->pDec = pSavedDec;
+  pCtx->pRefReadyMbRows = NULL;
+  memcpy (pCtx->sRefPic.pRefList[LIST_0], pSavedRefList, sizeof (pSavedRefList));
+  memcpy (pCtx->iDecBlockOffsetArray, iSavedBlockOffset, sizeof (iSavedBlockOffset));
+}
+
+static void ReapSlot (SDecFrameSlot* pSlot) {
+  if (!pSlot->bRunning)
+    return;
+
+  WaitSlotDone (pSlot);
+  for (int32_t i = 0; i < pSlot->iHeldNum; ++ i)
+    -- pSlot->pHeldPic[i]->uiRefCount;
+  pSlot->iHeldNum = 0;
+  pSlot->iJobNum = 0;
+  pSlot->pPic = NULL;
+  pSlot->bRunning = false;
+}
+
+static void ReleaseOutput (PWelsDecoderContext pCtx, SDecOutputRecord* pOutput) {
+  if (pOutput->pPic != NULL) {
+    -- pOutput->pPic->uiRefCount;
+    pOutput->pPic = NULL;
+  }
+  if (pOutput->pCopyBuf != NULL) {
+    pCtx->pMemAlign->WelsFree (pOutput->pCopyBuf, "pOutput->pCopyBuf");
+    pOutput->pCopyBuf = NULL;
+  }
+}
+
+/*
+ *  copy a queued picture out of the picture buffers, so that the picture can be reused or freed
+ */
+static void DetachOutput (PWelsDecoderContext pCtx, SDecOutputRecord* pOutput) {
+  const int32_t kiWidth  = pOutput->sDstInfo.UsrData.sSystemBuffer.iWidth;
+  const int32_t kiHeight = pOutput->sDstInfo.UsrData.sSystemBuffer.iHeight;
+  const int32_t kiStride[2] = {pOutput->sDstInfo.UsrData.sSystemBuffer.iStride[0], pOutput->sDstInfo.UsrData.sSystemBuffer.iStride[1]};
+  uint8_t* pBuf;
+  int32_t i;
+
+  if (pOutput->pPic == NULL)
+    return;
+
+  WelsDecThreadWaitPicRows (pOutput->pPic, PIC_READY_ALL);
+  pBuf = (uint8_t*)pCtx->pMemAlign->WelsMalloc (kiWidth * kiHeight * 3 / 2, "pOutput->pCopyBuf");
+  if (pBuf == NULL) { // picture is lost
+    pOutput->sDstInfo.iBufferStatus = 0;
+    ReleaseOutput (pCtx, pOutput);
+    return;
+  }
+
+  for (i = 0; i < kiHeight; ++ i)
+    memcpy (pBuf + i * kiWidth, pOutput->pDst[0] + i * kiStride[0], kiWidth);
+  uint8_t* pBufU = pBuf + kiWidth * kiHeight;
+  uint8_t* pBufV = pBufU + (kiWidth >> 1) * (kiHeight >> 1);
+  for (i = 0; i < (kiHeight >> 1); ++ i) {
+    memcpy (pBufU + i * (kiWidth >> 1), pOutput->pDst[1] + i * kiStride[1], kiWidth >> 1);
+    memcpy (pBufV + i * (kiWidth >> 1), pOutput->pDst[2] + i * kiStride[1], kiWidth >> 1);
+  }
+
+  ReleaseOutput (pCtx, pOutput);
+  pOutput->pCopyBuf = pBuf;
+  pOutput->pDst[0] = pBuf;
+  pOutput->pDst[1] = pBufU;
+  pOutput->pDst[2] = pBufV;
+  pOutput->sDstInfo.UsrData.sSystemBuffer.iStride[0] = kiWidth;
+  pOutput->sDstInfo.UsrData.sSystemBuffer.iStride[1] = kiWidth >> 1;
+  pOutput->sDstInfo.pFrameBuffer = NULL;
+}
+
+static inline SDecOutputRecord* GetOutput (SWelsDecThreadCtx* pThreadCtx, int32_t iIdx) {
+  return &pThreadCtx->sOutput[ (pThreadCtx->iOutputHead + iIdx) % (MAX_DEC_FRAME_THREAD_NUM + 1)];
+}
+
+static void PopOutput (PWelsDecoderContext pCtx) {
+  SWelsDecThreadCtx* pThreadCtx = pCtx->pThreadCtx;
+
+  ReleaseOutput (pCtx, GetOutput (pThreadCtx, 0));
+  pThreadCtx->iOutputHead = (pThreadCtx->iOutputHead + 1) % (MAX_DEC_FRAME_THREAD_NUM + 1);
+  -- pThreadCtx->iOutputNum;
+}
+
+static inline int32_t GetUnitFirstMb (SDecSliceUnit* pUnit) {
+  return pUnit->sLayer.sLayerInfo.sSliceInLayer.sSliceHeaderExt.sSliceHeader.iFirstMbInSlice;
+}
+
+static inline int32_t GetUnitSliceIdc (SDecSliceUnit* pUnit) {
+  return (GetUnitFirstMb (pUnit) << 7) + pUnit->sLayer.uiLayerDqId; // as set by WelsDecodeSlice()
+}
+
+/*
+ *  reconstruct the MBs of the slice just parsed, as WelsTargetSliceConstruction() would
+ */
+static void ReconstructSliceMbs (PWelsDecoderContext pCtx) {
+  PDqLayer pCurLayer = pCtx->pCurDqLayer;
+  PSlice pCurSlice = &pCurLayer->sLayerInfo.sSliceInLayer;
+  PSliceHeader pSliceHeader = &pCurSlice->sSliceHeaderExt.sSliceHeader;
+  const int32_t kiFirstMbXy = pSliceHeader->iFirstMbInSlice;
+  const int32_t kiEndMbXy = WELS_MIN (kiFirstMbXy + pCurSlice->iTotalMbInCurSlice,
+                                      (int32_t)pSliceHeader->pSps->uiTotalMbCount);
+
+  if (!pCtx->bAvcBasedFlag && (pCurLayer->iMbWidth << 4) != pCtx->iCurSeqIntervalMaxPicWidth)
+    return; // reported by the calling thread
+
+  for (int32_t iMbXy = kiFirstMbXy; iMbXy < kiEndMbXy; ++ iMbXy) {
+    if (!IS_INTRA (pCurLayer->pMbType[iMbXy]) && !IS_INTER (pCurLayer->pMbType[iMbXy]))
+      return; // reported by the calling thread
+    pCurLayer->iMbX = iMbXy % pCurLayer->iMbWidth;
+    pCurLayer->iMbY = iMbXy / pCurLayer->iMbWidth;
+    pCurLayer->iMbXyIndex = iMbXy;
+    WelsTargetMbConstruction (pCtx);
+  }
+}
+
+static inline void SwitchSliceUnit (PWelsDecoderContext pCtx, SDecSliceUnit* pUnit) {
+  pCtx->pCurDqLayer = &pUnit->sDoneLayer;
+  memcpy (&pCtx->sRefPic, &pUnit->sRefPic, sizeof (SRefPic));
+  pCtx->pFmo = pUnit->pFmo;
+  pCtx->bRPLRError = pUnit->bRPLRError;
+  pCtx->eSliceType = pUnit->sLayer.sLayerInfo.sSliceInLayer.sSliceHeaderExt.sSliceHeader.eSliceType;
+}
+
+static void DecodeSliceUnit (PWelsDecoderContext pWorkCtx, SDecSliceUnit* pUnit) {
+  memcpy (&pUnit->sDoneLayer, &pUnit->sLayer, sizeof (SDqLayer));
+  SwitchSliceUnit (pWorkCtx, pUnit);
+  pWorkCtx->iErrorCode = 0;
+
+  pUnit->iRet = WelsDecodeSlice (pWorkCtx, pUnit->bFreshSlice, pUnit->pNal);
+  if (pUnit->iRet == ERR_NONE || pWorkCtx->pParam->eEcActiveIdc != ERROR_CON_DISABLE)
+    ReconstructSliceMbs (pWorkCtx);
+  pUnit->iErrorCode = pWorkCtx->iErrorCode;
+}
+
+/*
+ *  take the next queued slice and decode it, called with hSliceMutex locked, which is released meanwhile
+ *  return: false if all slices are taken
+ */
+static bool DecodeNextSliceUnit (SWelsDecThreadCtx* pThreadCtx, PWelsDecoderContext pWorkCtx) {
+  SDecSliceUnit* pUnit;
+
+  if (pThreadCtx->iNextSliceUnit >= pThreadCtx->iSliceUnitNum)
+    return false;
+  pUnit = &pThreadCtx->pSliceUnits[pThreadCtx->iNextSliceUnit ++];
+
+  WelsMutexUnlock (&pThreadCtx->hSliceMutex);
+  DecodeSliceUnit (pWorkCtx, pUnit);
+  WelsMutexLock (&pThreadCtx->hSliceMutex);
+
+  pUnit->bDone = true;
+  WelsCondBroadcast (&pThreadCtx->hSliceCond);
+  return true;
+}
+
+class CWelsDecSliceTask : public WelsCommon::IWelsTask, public WelsCommon::IWelsTaskSink {
+ public:
+  CWelsDecSliceTask (SWelsDecThreadCtx* pThreadCtx, SDecSliceThread* pSliceThread)
+    : IWelsTask (this), m_pThreadCtx (pThreadCtx), m_pSliceThread (pSliceThread) {
+  }
+  virtual ~CWelsDecSliceTask() {
+  }
+
+  virtual int Execute() {
+    WelsMutexLock (&m_pThreadCtx->hSliceMutex);
+    while (DecodeNextSliceUnit (m_pThreadCtx, m_pSliceThread->pWorkCtx))
+      ;
+    WelsMutexUnlock (&m_pThreadCtx->hSliceMutex);
+    return 0;
+  }
+  virtual int OnTaskExecuted() {
+    SetTaskEnded();
+    return 0;
+  }
+  virtual int OnTaskCancelled() {
+    SetTaskEnded();
+    return 0;
+  }
+
+ private:
+  void SetTaskEnded() {
+    WelsMutexLock (&m_pThreadCtx->hSliceMutex);
+    -- m_pThreadCtx->iRunningSliceTasks;
+    WelsCondBroadcast (&m_pThreadCtx->hSliceCond);
+    WelsMutexUnlock (&m_pThreadCtx->hSliceMutex);
+  }
+
+  SWelsDecThreadCtx* m_pThreadCtx;
+  SDecSliceThread* m_pSliceThread;
+};
+
+/*
+ *  wait for a queued slice, decoding the slices no thread took yet meanwhile
+ */
+static void WaitSliceUnit (SWelsDecThreadCtx* pThreadCtx, SDecSliceUnit* pUnit) {
+  WelsMutexLock (&pThreadCtx->hSliceMutex);
+  while (!pUnit->bDone) {
+    if (!DecodeNextSliceUnit (pThreadCtx, pThreadCtx->sSliceThread[0].pWorkCtx))
+      WelsCondWait (&pThreadCtx->hSliceCond, &pThreadCtx->hSliceMutex);
+  }
+  WelsMutexUnlock (&pThreadCtx->hSliceMutex);
+}
+
+/*
+ *  wait for the slice tasks to end, the slices they did not take yet are dropped
+ */
+static void JoinSliceTasks (SWelsDecThreadCtx* pThreadCtx) {
+  WelsMutexLock (&pThreadCtx->hSliceMutex);
+  pThreadCtx->iNextSliceUnit = pThreadCtx->iSliceUnitNum;
+  while (pThreadCtx->iRunningSliceTasks > 0)
+    WelsCondWait (&pThreadCtx->hSliceCond, &pThreadCtx->hSliceMutex);
+  WelsMutexUnlock (&pThreadCtx->hSliceMutex);
+}
+
+static int32_t PrepareSliceWorkCtx (PWelsDecoderContext pCtx, SDecSliceThread* pSliceThread) {
+  CMemoryAlign* pMa = pCtx->pMemAlign;
+  PWelsDecoderContext pWorkCtx = pSliceThread->pWorkCtx;
+
+  if (pWorkCtx == NULL) {
+    pWorkCtx = (PWelsDecoderContext)pMa->WelsMalloc (sizeof (SWelsDecoderContext), "pSliceThread->pWorkCtx");
+    WELS_VERIFY_RETURN_IF (ERR_INFO_OUT_OF_MEMORY, NULL == pWorkCtx)
+    memcpy (pWorkCtx, pCtx, sizeof (SWelsDecoderContext));
+    pWorkCtx->pCabacDecEngine = (PWelsCabacDecEngine)pMa->WelsMallocz (sizeof (SWelsCabacDecEngine),
+                                "pWorkCtx->pCabacDecEngine");
+    WELS_VERIFY_RETURN_PROC_IF (ERR_INFO_OUT_OF_MEMORY, NULL == pWorkCtx->pCabacDecEngine,
+                                pMa->WelsFree (pWorkCtx, "pSliceThread->pWorkCtx"))
+    pWorkCtx->bDequantCoeff4x4Init = false; // scaling lists go to its own buffers
+    pWorkCtx->pThreadCtx = NULL;
+    pWorkCtx->bDeferSliceRecon = false;
+    pWorkCtx->bSliceReconDone = false;
+    pWorkCtx->pRefReadyMbRows = NULL;
+    pSliceThread->pWorkCtx = pWorkCtx;
+  }
+
+  // set up by the calling thread for the access unit
+  pWorkCtx->pParam = pCtx->pParam;
+  pWorkCtx->pSps = pCtx->pSps;
+  pWorkCtx->pPps = pCtx->pPps;
+  pWorkCtx->pDec = pCtx->pDec;
+  pWorkCtx->bAvcBasedFlag = pCtx->bAvcBasedFlag;
+  pWorkCtx->iCurSeqIntervalMaxPicWidth = pCtx->iCurSeqIntervalMaxPicWidth;
+  pWorkCtx->sLogCtx = pCtx->sLogCtx;
+  memcpy (pWorkCtx->iDecBlockOffsetArray, pCtx->iDecBlockOffsetArray, sizeof (pCtx->iDecBlockOffsetArray));
+
+  return ERR_NONE;
+}
+
+/*
+ *  label the MBs from the first MB of each slice to the first MB of the next one with the slice,
+ *  so that a slice thread reading the label of a neighbour in a slice not decoded yet does not find
+ *  its own label there (unlabeled MBs may be neighbours but never belong to the current slice)
+ */
+static void PresetSliceIdc (PWelsDecoderContext pCtx) {
+  SWelsDecThreadCtx* pThreadCtx = pCtx->pThreadCtx;
+  int32_t* pSliceIdc = pCtx->pCurDqLayer->pSliceIdc;
+  const int32_t kiTotalMb =
+    pThreadCtx->pSliceUnits[0].sLayer.sLayerInfo.sSliceInLayer.sSliceHeaderExt.sSliceHeader.pSps->uiTotalMbCount;
+
+  for (int32_t i = 0; i < pThreadCtx->iSliceUnitNum; ++ i) {
+    SDecSliceUnit* pUnit = &pThreadCtx->pSliceUnits[i];
+    const int32_t kiEndMbXy = (i + 1 < pThreadCtx->iSliceUnitNum) ? GetUnitFirstMb (pUnit + 1) : kiTotalMb;
+    const int32_t kiSliceIdc = GetUnitSliceIdc (pUnit);
+    for (int32_t iMbXy = GetUnitFirstMb (pUnit); iMbXy < kiEndMbXy; ++ iMbXy) {
+      if (pSliceIdc[iMbXy] == -1)
+        pSliceIdc[iMbXy] = kiSliceIdc;
+    }
+  }
+}
+
+bool WelsDecThreadQueueSlice (PWelsDecoderContext pCtx, PNalUnit pNalCur, bool bFreshSlice) {
+  SWelsDecThreadCtx* pThreadCtx = pCtx->pThreadCtx;
+  PDqLayer pCurDq = pCtx->pCurDqLayer;
+  PSliceHeader pSliceHeader = &pCurDq->sLayerInfo.sSliceInLayer.sSliceHeaderExt.sSliceHeader;
+  SDecSliceUnit* pUnit;
+
+  if (!pThreadCtx->bSliceThreading || pCurDq->sLayerInfo.pPps->uiNumSliceGroups > 1
+      || pSliceHeader->iFirstMbInSlice >= (int32_t)pSliceHeader->pSps->uiTotalMbCount)
+    return false;
+  if (pThreadCtx->iSliceUnitNum > 0 // slices must come in raster order
+      && pSliceHeader->iFirstMbInSlice <= GetUnitFirstMb (&pThreadCtx->pSliceUnits[pThreadCtx->iSliceUnitNum - 1]))
+    return false;
+
+  if (pThreadCtx->iSliceUnitNum == pThreadCtx->iSliceUnitCapacity) {
+    const int32_t kiCapacity = WELS_MAX (pThreadCtx->iSliceUnitCapacity << 1, 4);
+    SDecSliceUnit* pUnits = (SDecSliceUnit*)pCtx->pMemAlign->WelsMalloc (kiCapacity * sizeof (SDecSliceUnit),
+                            "pThreadCtx->pSliceUnits");
+    if (NULL == pUnits)
+      return false;
+    if (pThreadCtx->pSliceUnits != NULL) {
+      memcpy (pUnits, pThreadCtx->pSliceUnits, pThreadCtx->iSliceUnitNum * sizeof (SDecSliceUnit));
+      pCtx->pMemAlign->WelsFree (pThreadCtx->pSliceUnits, "pThreadCtx->pSliceUnits");
+    }
+    pThreadCtx->pSliceUnits = pUnits;
+    pThreadCtx->iSliceUnitCapacity = kiCapacity;
+  }
+
+  pUnit = &pThreadCtx->pSliceUnits[pThreadCtx->iSliceUnitNum ++];
+  memcpy (&pUnit->sLayer, pCurDq, sizeof (SDqLayer));
+  memcpy (&pUnit->sRefPic, &pCtx->sRefPic, sizeof (SRefPic));
+  pUnit->pNal = pNalCur;
+  pUnit->sBsStart = *pCurDq->pBitStringAux;
+  pUnit->pFmo = pCtx->pFmo;
+  pUnit->bFreshSlice = bFreshSlice;
+  pUnit->bRPLRError = pCtx->bRPLRError;
+  pUnit->bDone = false;
+
+  return true;
+}
+
+/*
+ *  complete a decoded slice on the calling thread: validation, bookkeeping and deblocking
+ */
+static int32_t FinishSliceUnit (PWelsDecoderContext pCtx, SDecSliceUnit* pUnit, bool* pAllRefComplete) {
+  int32_t iRet;
+
+  SwitchSliceUnit (pCtx, pUnit);
+  pCtx->iErrorCode |= pUnit->iErrorCode;
+  pCtx->bSliceReconDone = true;
+  iRet = WelsDecodeSliceFinish (pCtx, pUnit->pNal, pUnit->iRet, true, pAllRefComplete);
+  pCtx->bSliceReconDone = false;
+
+  return iRet;
+}
+
+/*
+ *  decode queued slices from iFirstUnit on with the decoder context itself
+ */
+static int32_t DecodeSliceUnitsSerially (PWelsDecoderContext pCtx, int32_t iFirstUnit, bool* pAllRefComplete) {
+  SWelsDecThreadCtx* pThreadCtx = pCtx->pThreadCtx;
+  int32_t iRet = ERR_NONE;
+
+  for (int32_t i = iFirstUnit; i < pThreadCtx->iSliceUnitNum && iRet == ERR_NONE; ++ i) {
+    SDecSliceUnit* pUnit = &pThreadCtx->pSliceUnits[i];
+    *pUnit->sLayer.pBitStringAux = pUnit->sBsStart; // may have been parsed already
+    memcpy (&pUnit->sDoneLayer, &pUnit->sLayer, sizeof (SDqLayer));
+    SwitchSliceUnit (pCtx, pUnit);
+    iRet = WelsDecodeSlice (pCtx, pUnit->bFreshSlice, pUnit->pNal);
+    iRet = WelsDecodeSliceFinish (pCtx, pUnit->pNal, iRet, true, pAllRefComplete);
+  }
+
+  return iRet;
+}
+
+int32_t WelsDecThreadDecodeSlices (PWelsDecoderContext pCtx, bool* pAllRefComplete) {
+  SWelsDecThreadCtx* pThreadCtx = pCtx->pThreadCtx;
+  const int32_t kiUnitNum = pThreadCtx->iSliceUnitNum;
+  PDqLayer pSavedDqLayer = pCtx->pCurDqLayer;
+  PFmo pSavedFmo = pCtx->pFmo;
+  const bool kbSavedRPLRError = pCtx->bRPLRError;
+  const EWelsSliceType keSavedSliceType = pCtx->eSliceType;
+  SRefPic sSavedRefPic;
+  int32_t iThreadNum = WELS_MIN (kiUnitNum, pThreadCtx->iThreadNum);
+  int32_t iRet = ERR_NONE;
+  int32_t i = 0;
+
+  if (kiUnitNum == 0)
+    return ERR_NONE;
+  memcpy (&sSavedRefPic, &pCtx->sRefPic, sizeof (SRefPic));
+
+  while (i < iThreadNum && PrepareSliceWorkCtx (pCtx, &pThreadCtx->sSliceThread[i]) == ERR_NONE)
+    ++ i;
+  iThreadNum = i;
+  i = 0;
+
+  if (iThreadNum > 0) {
+    PresetSliceIdc (pCtx);
+    pThreadCtx->iNextSliceUnit = 0;
+    for (int32_t j = 1; j < iThreadNum; ++ j) {
+      WelsMutexLock (&pThreadCtx->hSliceMutex);
+      ++ pThreadCtx->iRunningSliceTasks;
+      WelsMutexUnlock (&pThreadCtx->hSliceMutex);
+      if (WELS_THREAD_ERROR_OK != pThreadCtx->pThreadPool->QueueTask (pThreadCtx->sSliceThread[j].pTask)) {
+        WelsMutexLock (&pThreadCtx->hSliceMutex);
+        -- pThreadCtx->iRunningSliceTasks;
+        WelsMutexUnlock (&pThreadCtx->hSliceMutex);
+      }
+    }
+
+    for (; i < kiUnitNum && iRet == ERR_NONE; ++ i) {
+      SDecSliceUnit* pUnit = &pThreadCtx->pSliceUnits[i];
+      WaitSliceUnit (pThreadCtx, pUnit);
+      // a slice running into the next one leaves MBs of it to be decoded in slice order
+      if (i + 1 < kiUnitNum && GetUnitFirstMb (pUnit) + pUnit->sDoneLayer.sLayerInfo.sSliceInLayer.iTotalMbInCurSlice
+          > GetUnitFirstMb (pUnit + 1))
+        break;
+      iRet = FinishSliceUnit (pCtx, pUnit, pAllRefComplete);
+    }
+    JoinSliceTasks (pThreadCtx);
+  }
+  if (iRet == ERR_NONE && i < kiUnitNum) {
+    WelsLog (& (pCtx->sLogCtx), WELS_LOG_DEBUG, "WelsDecThreadDecodeSlices(), slices decoded serially from %d of %d", i,
+             kiUnitNum);
+    iRet = DecodeSliceUnitsSerially (pCtx, i, pAllRefComplete);
+  }
+
+  // the dq layer is left as by the last slice, unless a slice is being set up in it
+  if (iRet == ERR_NONE && pSavedDqLayer->pBitStringAux == pThreadCtx->pSliceUnits[kiUnitNum - 1].sLayer.pBitStringAux)
+    memcpy (pSavedDqLayer, &pThreadCtx->pSliceUnits[kiUnitNum - 1].sDoneLayer, sizeof (SDqLayer));
+  pCtx->pCurDqLayer = pSavedDqLayer;
+  pCtx->pFmo = pSavedFmo;
+  pCtx->bRPLRError = kbSavedRPLRError;
+  pCtx->eSliceType = keSavedSliceType;
+  memcpy (&pCtx->sRefPic, &sSavedRefPic, sizeof (SRefPic));
+  pThreadCtx->iSliceUnitNum = 0;
+
+  return iRet;
+}
+
+/*
+ *  take the next row of the job of WelsDecThreadRunRows() and run it, called with hRowMutex locked,
+ *  which is released meanwhile
+ *  return: false if all rows are taken
+ */
+static bool RunNextRow (SWelsDecThreadCtx* pThreadCtx) {
+  const int32_t kiMbY = pThreadCtx->iNextRow;
+  PWelsDecoderContext pCtx = pThreadCtx->pRowCtx;
+  PWelsDecRowsFunc pfRows = pThreadCtx->pfRows;
+  void* pArg = pThreadCtx->pRowsArg;
+
+  if (kiMbY >= pThreadCtx->iRowNum)
+    return false;
+  ++ pThreadCtx->iNextRow;
+  ++ pThreadCtx->iBusyRowNum;
+
+  WelsMutexUnlock (&pThreadCtx->hRowMutex);
+  pfRows (pCtx, kiMbY, kiMbY + 1, pArg);
+  WelsMutexLock (&pThreadCtx->hRowMutex);
+
+  if (-- pThreadCtx->iBusyRowNum == 0)
+    WelsCondBroadcast (&pThreadCtx->hRowCond);
+  return true;
+}
+
+/*
+ *  helps with the rows of WelsDecThreadRunRows(). The calling thread does not wait for a task which did not start,
+ *  it takes whatever job is running when it does.
+ */
+class CWelsDecRowTask : public WelsCommon::IWelsTask, public WelsCommon::IWelsTaskSink {
+ public:
+  CWelsDecRowTask (SWelsDecThreadCtx* pThreadCtx, int32_t iIdx)
+    : IWelsTask (this), m_pThreadCtx (pThreadCtx), m_iIdx (iIdx) {
+  }
+  virtual ~CWelsDecRowTask() {
+  }
+
+  virtual int Execute() {
+    WelsMutexLock (&m_pThreadCtx->hRowMutex);
+    while (RunNextRow (m_pThreadCtx))
+      ;
+    WelsMutexUnlock (&m_pThreadCtx->hRowMutex);
+    return 0;
+  }
+  virtual int OnTaskExecuted() {
+    SetTaskEnded();
+    return 0;
+  }
+  virtual int OnTaskCancelled() {
+    SetTaskEnded();
+    return 0;
+  }
+
+ private:
+  void SetTaskEnded() {
+    WelsMutexLock (&m_pThreadCtx->hRowMutex);
+    m_pThreadCtx->bRowTaskQueued[m_iIdx] = false;
+    WelsCondBroadcast (&m_pThreadCtx->hRowCond);
+    WelsMutexUnlock (&m_pThreadCtx->hRowMutex);
+  }
+
+  SWelsDecThreadCtx* m_pThreadCtx;
+  int32_t m_iIdx;
+};
+
+void WelsDecThreadRunRows (PWelsDecoderContext pCtx, int32_t iMbRows, PWelsDecRowsFunc pfRows, void* pArg) {
+  SWelsDecThreadCtx* pThreadCtx = pCtx->pThreadCtx;
+
+  if (pThreadCtx == NULL || iMbRows <= 1) {
+    pfRows (pCtx, 0, iMbRows, pArg);
+    return;
+  }
+
+  WelsMutexLock (&pThreadCtx->hRowMutex);
+  pThreadCtx->pRowCtx = pCtx;
+  pThreadCtx->pfRows = pfRows;
+  pThreadCtx->pRowsArg = pArg;
+  pThreadCtx->iRowNum = iMbRows;
+  pThreadCtx->iNextRow = 0;
+  for (int32_t i = 1; i < WELS_MIN (pThreadCtx->iThreadNum, iMbRows); ++ i) {
+    if (pThreadCtx->pRowTask[i] == NULL || pThreadCtx->bRowTaskQueued[i]) // still queued from an earlier job
+      continue;
+    pThreadCtx->bRowTaskQueued[i] = true;
+    if (WELS_THREAD_ERROR_OK != pThreadCtx->pThreadPool->QueueTask (pThreadCtx->pRowTask[i]))
+      pThreadCtx->bRowTaskQueued[i] = false;
+  }
+
+  while (RunNextRow (pThreadCtx))
+    ;
+  while (pThreadCtx->iBusyRowNum > 0)
+    WelsCondWait (&pThreadCtx->hRowCond, &pThreadCtx->hRowMutex);
+  WelsMutexUnlock (&pThreadCtx->hRowMutex);
+}
+
+int32_t WelsDecThreadInit (PWelsDecoderContext pCtx, int32_t iThreadNum, bool bSliceThreading) {
+  CMemoryAlign* pMa = pCtx->pMemAlign;
+  SWelsDecThreadCtx* pThreadCtx;
+
+  iThreadNum = WELS_CLIP3 (iThreadNum, 0, MAX_DEC_FRAME_THREAD_NUM);
+  if (pCtx->pThreadCtx != NULL) {
+    if (pCtx->pThreadCtx->iThreadNum == iThreadNum && pCtx->pThreadCtx->bSliceThreading == bSliceThreading)
+      return ERR_NONE;
+    WelsDecThreadUninit (pCtx);
+  }
+  if (iThreadNum <= 1 || pCtx->pParam->bParseOnly)
+    return ERR_NONE;
+  MaterializeAliasedPics (pCtx); // threads recycle pictures concurrently, no planes may be shared
+
+  pThreadCtx = (SWelsDecThreadCtx*)pMa->WelsMallocz (sizeof (SWelsDecThreadCtx), "pCtx->pThreadCtx");
+  WELS_VERIFY_RETURN_IF (ERR_INFO_OUT_OF_MEMORY, NULL == pThreadCtx)
+
+  if (WELS_THREAD_ERROR_OK != WelsCommon::CWelsThreadPool::SetThreadNum (iThreadNum))
+    WelsLog (& (pCtx->sLogCtx), WELS_LOG_WARNING, "WelsDecThreadInit(), set thread num to %d did not succeed",
+             iThreadNum);
+  pThreadCtx->pThreadPool = WelsCommon::CWelsThreadPool::AddReference();
+  pThreadCtx->iThreadNum = iThreadNum;
+  pThreadCtx->bSliceThreading = bSliceThreading;
+  WelsMutexInit (&pThreadCtx->hSliceMutex);
+  WelsCondInit (&pThreadCtx->hSliceCond);
+  WelsMutexInit (&pThreadCtx->hRowMutex);
+  WelsCondInit (&pThreadCtx->hRowCond);
+  pCtx->pThreadCtx = pThreadCtx;
+  WELS_VERIFY_RETURN_PROC_IF (ERR_INFO_OUT_OF_MEMORY, NULL == pThreadCtx->pThreadPool, WelsDecThreadUninit (pCtx))
+
+  if (bSliceThreading) {
+    for (int32_t i = 1; i < iThreadNum; ++ i) { // the calling thread is slice thread 0
+      SDecSliceThread* pSliceThread = &pThreadCtx->sSliceThread[i];
+      pSliceThread->pTask = WELS_NEW_OP (CWelsDecSliceTask (pThreadCtx, pSliceThread), CWelsDecSliceTask);
+      WELS_VERIFY_RETURN_PROC_IF (ERR_INFO_OUT_OF_MEMORY, NULL == pSliceThread->pTask, WelsDecThreadUninit (pCtx))
+    }
+  } else {
+    for (int32_t i = 0; i < iThreadNum; ++ i) {
+      SDecFrameSlot* pSlot = &pThreadCtx->sSlot[i];
+      WelsMutexInit (&pSlot->hMutex);
+      WelsCondInit (&pSlot->hCond);
+      pSlot->bDone = true;
+      pSlot->pTask = WELS_NEW_OP (CWelsDecFrameTask (pSlot), CWelsDecFrameTask);
+      WELS_VERIFY_RETURN_PROC_IF (ERR_INFO_OUT_OF_MEMORY, NULL == pSlot->pTask, WelsDecThreadUninit (pCtx))
+    }
+  }
+  for (int32_t i = 1; i < iThreadNum; ++ i) { // the calling thread takes rows too
+    pThreadCtx->pRowTask[i] = WELS_NEW_OP (CWelsDecRowTask (pThreadCtx, i), CWelsDecRowTask);
+    WELS_VERIFY_RETURN_PROC_IF (ERR_INFO_OUT_OF_MEMORY, NULL == pThreadCtx->pRowTask[i], WelsDecThreadUninit (pCtx))
+  }
+
+  WelsLog (& (pCtx->sLogCtx), WELS_LOG_INFO, "WelsDecThreadInit(), %d %s threads, thread pool size %d", iThreadNum,
+           bSliceThreading ? "slice" : "frame", pThreadCtx->pThreadPool->GetThreadNum());
+  return ERR_NONE;
+}
+
+void WelsDecThreadUninit (PWelsDecoderContext pCtx) {
+  SWelsDecThreadCtx* pThreadCtx = pCtx->pThreadCtx;
+  CMemoryAlign* pMa = pCtx->pMemAlign;
+
+  if (pThreadCtx == NULL)
+    return;
+
+  if (pThreadCtx->pThreadPool != NULL) {
+    WelsDecThreadSyncPicture (pCtx);
+    WelsDecThreadDrain (pCtx, false);
+  }
+  while (pThreadCtx->iOutputNum > 0)
+    PopOutput (pCtx);
+  WELS_SAFE_FREE (pThreadCtx->pReportedCopyBuf, "pThreadCtx->pReportedCopyBuf");
+
+  for (int32_t i = 0; i < pThreadCtx->iThreadNum; ++ i) {
+    SDecFrameSlot* pSlot = &pThreadCtx->sSlot[i];
+    if (pSlot->pTask == NULL) // not initialized
+      break;
+    WELS_DELETE_OP (pSlot->pTask);
+    WelsMutexDestroy (&pSlot->hMutex);
+    WelsCondDestroy (&pSlot->hCond);
+    UninitialMbBuffer (pMa, &pSlot->sMb, 0);
+    if (pSlot->pJobs != NULL) {
+      pMa->WelsFree (pSlot->pJobs, "pSlot->pJobs");
+      pSlot->pJobs = NULL;
+    }
+    if (pSlot->pWorkCtx != NULL) {
+      pMa->WelsFree (pSlot->pWorkCtx, "pSlot->pWorkCtx");
+      pSlot->pWorkCtx = NULL;
+    }
+  }
+
+  for (int32_t i = 0; i < pThreadCtx->iThreadNum; ++ i) {
+    SDecSliceThread* pSliceThread = &pThreadCtx->sSliceThread[i];
+    if (pSliceThread->pTask != NULL)
+      WELS_DELETE_OP (pSliceThread->pTask);
+    if (pSliceThread->pWorkCtx != NULL) {
+      pMa->WelsFree (pSliceThread->pWorkCtx->pCabacDecEngine, "pWorkCtx->pCabacDecEngine");
+      pMa->WelsFree (pSliceThread->pWorkCtx, "pSliceThread->pWorkCtx");
+      pSliceThread->pWorkCtx = NULL;
+    }
+  }
+  if (pThreadCtx->pSliceUnits != NULL)
+    pMa->WelsFree (pThreadCtx->pSliceUnits, "pThreadCtx->pSliceUnits");
+  WelsMutexDestroy (&pThreadCtx->hSliceMutex);
+  WelsCondDestroy (&pThreadCtx->hSliceCond);
+
+  for (int32_t i = 1; i < pThreadCtx->iThreadNum; ++ i) {
+    if (pThreadCtx->pRowTask[i] == NULL)
+      continue;
+    WelsMutexLock (&pThreadCtx->hRowMutex);
+    while (pThreadCtx->bRowTaskQueued[i])
+      WelsCondWait (&pThreadCtx->hRowCond, &pThreadCtx->hRowMutex);
+    WelsMutexUnlock (&pThreadCtx->hRowMutex);
+    WELS_DELETE_OP (pThreadCtx->pRowTask[i]);
+  }
+  WelsMutexDestroy (&pThreadCtx->hRowMutex);
+  WelsCondDestroy (&pThreadCtx->hRowCond);
+
+  if (pThreadCtx->pThreadPool != NULL)
+    pThreadCtx->pThreadPool->RemoveInstance();
+  pMa->WelsFree (pThreadCtx, "pCtx->pThreadCtx");
+  pCtx->pThreadCtx = NULL;
+  pCtx->bDeferSliceRecon = false;
+}
+
+void WelsDecThreadStartPicture (PWelsDecoderContext pCtx) {
+  SWelsDecThreadCtx* pThreadCtx = pCtx->pThreadCtx;
+  SDecFrameSlot* pSlot = &pThreadCtx->sSlot[pThreadCtx->iBuildSlot];
+
+  if (pThreadCtx->bSliceThreading)
+    return;
+
+  if (pSlot->bRunning)
+    ReapSlot (pSlot);
+  else if (pSlot->iJobNum > 0) // left by an unfinished picture
+    WelsDecThreadSyncPicture (pCtx);
+
+  pCtx->bDeferSliceRecon = true;
+}
+
+int32_t WelsDecThreadAddSlice (PWelsDecoderContext pCtx, bool bSliceComplete) {
+  SWelsDecThreadCtx* pThreadCtx = pCtx->pThreadCtx;
+  SDecFrameSlot* pSlot = &pThreadCtx->sSlot[pThreadCtx->iBuildSlot];
+  PDqLayer pCurDq = pCtx->pCurDqLayer;
+  PSlice pCurSlice = &pCurDq->sLayerInfo.sSliceInLayer;
+  PSliceHeader pSliceHeader = &pCurSlice->sSliceHeaderExt.sSliceHeader;
+  const int32_t kiTotalMb = pSliceHeader->pSps->uiTotalMbCount;
+  SDecSliceJob* pJob;
+
+  if (pCurSlice->iTotalMbInCurSlice <= 0 || pSliceHeader->iFirstMbInSlice >= kiTotalMb)
+    return ERR_NONE;
+
+  if (pSlot->iJobNum == pSlot->iJobCapacity) {
+    const int32_t kiCapacity = WELS_MAX (pSlot->iJobCapacity << 1, 4);
+    SDecSliceJob* pJobs = (SDecSliceJob*)pCtx->pMemAlign->WelsMalloc (kiCapacity * sizeof (SDecSliceJob), "pSlot->pJobs");
+    WELS_VERIFY_RETURN_IF (ERR_INFO_OUT_OF_MEMORY, NULL == pJobs)
+    if (pSlot->pJobs != NULL) {
+      memcpy (pJobs, pSlot->pJobs, pSlot->iJobNum * sizeof (SDecSliceJob));
+      pCtx->pMemAlign->WelsFree (pSlot->pJobs, "pSlot->pJobs");
+    }
+    pSlot->pJobs = pJobs;
+    pSlot->iJobCapacity = kiCapacity;
+  }
+
+  pJob = &pSlot->pJobs[pSlot->iJobNum];
+  memcpy (&pJob->sLayer, pCurDq, sizeof (SDqLayer));
+  pJob->sLayer.pPredWeightTable = &pJob->sLayer.sLayerInfo.sSliceInLayer.sSliceHeaderExt.sSliceHeader.sPredWeightTable;
+  pJob->sLayer.sLayerInfo.sSliceInLayer.iTotalMbInCurSlice = WELS_MIN (pCurSlice->iTotalMbInCurSlice,
+      kiTotalMb - pSliceHeader->iFirstMbInSlice);
+  memcpy (pJob->pRefList, pCtx->sRefPic.pRefList[LIST_0], sizeof (pJob->pRefList));
+  pJob->bDeblock = bSliceComplete && (pCurSlice->eSliceType == I_SLICE || pCurSlice->eSliceType == P_SLICE)
+                   && (pSliceHeader->uiDisableDeblockingFilterIdc != 1);
+  ++ pSlot->iJobNum;
+
+  return ERR_NONE;
+}
+
+void WelsDecThreadSyncPicture (PWelsDecoderContext pCtx) {
+  SWelsDecThreadCtx* pThreadCtx = pCtx->pThreadCtx;
+  SDecFrameSlot* pSlot = &pThreadCtx->sSlot[pThreadCtx->iBuildSlot];
+
+  WelsDecThreadDrain (pCtx, false);
+  if (pSlot->iJobNum > 0)
+    ReconstructOnCallingThread (pCtx, pSlot, false);
+  pCtx->bDeferSliceRecon = false;
+}
+
+static bool HoldPic (SDecFrameSlot* pSlot, PPicture pPic) {
+  int32_t i;
+
+  if (pPic == NULL)
+    return true;
+  for (i = 0; i < pSlot->iHeldNum; ++ i) {
+    if (pSlot->pHeldPic[i] == pPic)
+      return true;
+  }
+  if (pSlot->iHeldNum == MAX_DPB_COUNT + 1)
+    return false;
+  pSlot->pHeldPic[pSlot->iHeldNum ++] = pPic;
+  ++ pPic->uiRefCount;
+  return true;
+}
+
+static bool IsPicInReconstruction (SWelsDecThreadCtx* pThreadCtx, PPicture pPic) {
+  for (int32_t i = 0; i < pThreadCtx->iThreadNum; ++ i) {
+    if (pThreadCtx->sSlot[i].bRunning && pThreadCtx->sSlot[i].pPic == pPic)
+      return true;
+  }
+  return false;
+}
+
+static int32_t LaunchPicture (PWelsDecoderContext pCtx, SDecFrameSlot* pSlot, bool bRefPic) {
+  SWelsDecThreadCtx* pThreadCtx = pCtx->pThreadCtx;
+  CMemoryAlign* pMa = pCtx->pMemAlign;
+  const uint32_t kuiMbWidth  = (pCtx->iPicWidthReq + 15) >> 4;
+  const uint32_t kuiMbHeight = (pCtx->iPicHeightReq + 15) >> 4;
+  PPicture pPic = pCtx->pDec;
+  SMbBuffer sMb;
+  int32_t i, j;
+
+  if (pSlot->pWorkCtx == NULL) {
+    pSlot->pWorkCtx = (PWelsDecoderContext)pMa->WelsMalloc (sizeof (SWelsDecoderContext), "pSlot->pWorkCtx");
+    WELS_VERIFY_RETURN_IF (ERR_INFO_OUT_OF_MEMORY, NULL == pSlot->pWorkCtx)
+    memcpy (pSlot->pWorkCtx, pCtx, sizeof (SWelsDecoderContext));
+    pSlot->pWorkCtx->pThreadCtx = NULL;
+    pSlot->pWorkCtx->bDeferSliceRecon = false;
+  }
+  pSlot->pWorkCtx->sLogCtx = pCtx->sLogCtx;
+
+  if (pSlot->sMb.pMbType[0] == NULL || pSlot->sMb.iMbWidth != kuiMbWidth || pSlot->sMb.iMbHeight != kuiMbHeight) {
+    UninitialMbBuffer (pMa, &pSlot->sMb, 0);
+    pSlot->sMb.iMbWidth  = kuiMbWidth;
+    pSlot->sMb.iMbHeight = kuiMbHeight;
+    if (ERR_NONE != InitialMbBuffer (pMa, &pSlot->sMb, 0)) {
+      UninitialMbBuffer (pMa, &pSlot->sMb, 0);
+      return ERR_INFO_OUT_OF_MEMORY;
+    }
+  }
+
+  bool bHeld = HoldPic (pSlot, pPic);
+  for (i = 0; i < pSlot->iJobNum && bHeld; ++ i) {
+    SDecSliceJob* pJob = &pSlot->pJobs[i];
+    for (j = 0; j < MAX_DPB_COUNT && bHeld; ++ j) {
+      bHeld = HoldPic (pSlot, pJob->pRefList[j]);
+      pJob->iRefReadyMbRows[j] = IsPicInReconstruction (pThreadCtx, pJob->pRefList[j]) ? 0 : PIC_READY_ALL;
+    }
+  }
+  if (!bHeld) {
+    for (i = 0; i < pSlot->iHeldNum; ++ i)
+      -- pSlot->pHeldPic[i]->uiRefCount;
+    pSlot->iHeldNum = 0;
+    return ERR_INFO_REF_COUNT_OVERFLOW;
+  }
+
+  // the MB data parsed goes with the slot, the parser continues with the spare buffer of the slot
+  sMb = pCtx->sMb;
+  pCtx->sMb = pSlot->sMb;
+  pCtx->sMb.iMbWidth  = sMb.iMbWidth;
+  pCtx->sMb.iMbHeight = sMb.iMbHeight;
+  pSlot->sMb = sMb;
+  pSlot->sMb.iMbWidth  = kuiMbWidth;
+  pSlot->sMb.iMbHeight = kuiMbHeight;
+  InitCurDqLayerData (pCtx, pCtx->pCurDqLayer);
+
+  memcpy (pSlot->iDecBlockOffsetArray, pCtx->iDecBlockOffsetArray, sizeof (pSlot->iDecBlockOffsetArray));
+  pSlot->pPic = pPic;
+  pSlot->bExpand = bRefPic;
+  PublishReadyRows (pPic, 0);
+  pSlot->bDone = false;
+  pSlot->bRunning = true;
+  if (WELS_THREAD_ERROR_OK != pThreadCtx->pThreadPool->QueueTask (pSlot->pTask)) {
+    ReconstructPicture (pSlot);
+    SetSlotDone (pSlot);
+  }
+  pThreadCtx->iBuildSlot = (pThreadCtx->iBuildSlot + 1) % pThreadCtx->iThreadNum;
+
+  return ERR_NONE;
+}
+
+int32_t WelsDecThreadFinishPicture (PWelsDecoderContext pCtx, bool bRefPic, uint8_t** ppDst, SBufferInfo* pDstInfo) {
+  SWelsDecThreadCtx* pThreadCtx = pCtx->pThreadCtx;
+  SDecFrameSlot* pSlot = &pThreadCtx->sSlot[pThreadCtx->iBuildSlot];
+  int32_t iRet = ERR_NONE;
+
+  if (pThreadCtx->bSliceThreading) // pictures are complete and output as without threads
+    return ERR_NONE;
+
+  if (pCtx->bDeferSliceRecon && pSlot->iJobNum > 0) {
+    iRet = LaunchPicture (pCtx, pSlot, bRefPic);
+    if (iRet != ERR_NONE) {
+      WelsLog (& (pCtx->sLogCtx), WELS_LOG_WARNING,
+               "WelsDecThreadFinishPicture(), reconstruct on calling thread as launch failed (%d)", iRet);
+      WelsDecThreadDrain (pCtx, false);
+      ReconstructOnCallingThread (pCtx, pSlot, bRefPic);
+    }
+  }
+  pCtx->bDeferSliceRecon = false;
+
+  if (pDstInfo->iBufferStatus == 1) {
+    SDecOutputRecord* pOutput;
+    if (pThreadCtx->bOutputPushed && pThreadCtx->iOutputNum > 0) { // replaces the picture queued before, as in ppDst
+      ReleaseOutput (pCtx, GetOutput (pThreadCtx, pThreadCtx->iOutputNum - 1));
+      -- pThreadCtx->iOutputNum;
+    }
+    if (pThreadCtx->iOutputNum == MAX_DEC_FRAME_THREAD_NUM + 1)
+      PopOutput (pCtx);
+    pOutput = GetOutput (pThreadCtx, pThreadCtx->iOutputNum ++);
+    pOutput->pPic = pCtx->pDec;
+    ++ pOutput->pPic->uiRefCount;
+    pOutput->pDst[0] = ppDst[0];
+    pOutput->pDst[1] = ppDst[1];
+    pOutput->pDst[2] = ppDst[2];
+    memcpy (&pOutput->sDstInfo, pDstInfo, sizeof (SBufferInfo));
+    pOutput->pCopyBuf = NULL;
+    pThreadCtx->bOutputPushed = true;
+
+    pDstInfo->iBufferStatus = 0;
+    ppDst[0] = ppDst[1] = ppDst[2] = NULL;
+  }
+
+  return iRet;
+}
+
+PPicture WelsDecThreadPrefetchPic (PWelsDecoderContext pCtx) {
+  SWelsDecThreadCtx* pThreadCtx = pCtx->pThreadCtx;
+  PPicture pPic = NULL;
+  int32_t i;
+
+  for (i = 0; i < pThreadCtx->iThreadNum && pPic == NULL; ++ i) { // oldest first
+    SDecFrameSlot* pSlot = &pThreadCtx->sSlot[ (pThreadCtx->iBuildSlot + i) % pThreadCtx->iThreadNum];
+    if (pSlot->bRunning) {
+      ReapSlot (pSlot);
+      pPic = PrefetchPic (pCtx->pPicBuff[LIST_0]);
+    }
+  }
+  for (i = 0; i < pThreadCtx->iOutputNum && pPic == NULL; ++ i) {
+    SDecOutputRecord* pOutput = GetOutput (pThreadCtx, i);
+    if (pOutput->pPic != NULL) {
+      DetachOutput (pCtx, pOutput);
+      pPic = PrefetchPic (pCtx->pPicBuff[LIST_0]);
+    }
+  }
+
+  return pPic;
+}
+
+void WelsDecThreadDrain (PWelsDecoderContext pCtx, bool bReset) {
+  SWelsDecThreadCtx* pThreadCtx = pCtx->pThreadCtx;
+  int32_t i;
+
+  for (i = 0; i < pThreadCtx->iThreadNum; ++ i)
+    ReapSlot (&pThreadCtx->sSlot[ (pThreadCtx->iBuildSlot + i) % pThreadCtx->iThreadNum]);
+
+  if (bReset) {
+    for (i = 0; i < pThreadCtx->iOutputNum; ++ i)
+      DetachOutput (pCtx, GetOutput (pThreadCtx, i));
+    pThreadCtx->sSlot[pThreadCtx->iBuildSlot].iJobNum = 0;
+    pThreadCtx->iSliceUnitNum = 0;
+    pCtx->bDeferSliceRecon = false;
+  }
+}
+
+bool WelsDecThreadOutputPicture (PWelsDecoderContext pCtx, uint8_t** ppDst, SBufferInfo* pDstInfo, bool bFlush) {
+  SWelsDecThreadCtx* pThreadCtx = pCtx->pThreadCtx;
+  SDecOutputRecord* pOutput;
+
+  pThreadCtx->bOutputPushed = false;
+  WELS_SAFE_FREE (pThreadCtx->pReportedCopyBuf, "pThreadCtx->pReportedCopyBuf");
+
+  // skip pictures dropped while detached
+  while (pThreadCtx->iOutputNum > 0 && GetOutput (pThreadCtx, 0)->sDstInfo.iBufferStatus == 0)
+    PopOutput (pCtx);
+  if (pThreadCtx->iOutputNum == 0 || (!bFlush && pThreadCtx->iOutputNum < pThreadCtx->iThreadNum))
+    return false;
+
+  pOutput = GetOutput (pThreadCtx, 0);
+  if (pOutput->pPic != NULL)
+    WelsDecThreadWaitPicRows (pOutput->pPic, PIC_READY_ALL);
+
+  unsigned long long uiInBsTimeStamp = pDstInfo->uiInBsTimeStamp;
+  memcpy (pDstInfo, &pOutput->sDstInfo, sizeof (SBufferInfo));
+  pDstInfo->uiInBsTimeStamp = uiInBsTimeStamp;
+  ppDst[0] = pOutput->pDst[0];
+  ppDst[1] = pOutput->pDst[1];
+  ppDst[2] = pOutput->pDst[2];
+
+  pThreadCtx->pReportedCopyBuf = pOutput->pCopyBuf; // valid until the next call
+  pOutput->pCopyBuf = NULL;
+  PopOutput (pCtx);
+
+  return true;
+}
+
+int32_t WelsDecThreadGetPendingNum (PWelsDecoderContext pCtx) {
+  SWelsDecThreadCtx* pThreadCtx = pCtx->pThreadCtx;
+  int32_t iPendingNum = 0;
+
+  if (pThreadCtx == NULL)
+    return 0;
+  for (int32_t i = 0; i < pThreadCtx->iOutputNum; ++ i)
+    iPendingNum += GetOutput (pThreadCtx, i)->sDstInfo.iBufferStatus;
+  return iPendingNum;
+}
+
+int32_t WelsDecThreadGetPicHoldNum (PWelsDecoderContext pCtx) {
+  if (pCtx->pThreadCtx == NULL || pCtx->pThreadCtx->bSliceThreading)
+    return 0;
+  return pCtx->pThreadCtx->iThreadNum << 1;
+}
+
+} // namespace WelsDec
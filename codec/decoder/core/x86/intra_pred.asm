@@ -32,7 +32,7 @@
 ;*  intra_pred.asm
 ;*
 ;*  Abstract
-;*      sse2 and mmx function for intra predict operations(decoder)
+;*      sse2, mmx and avx2 function for intra predict operations(decoder)
 ;*
 ;*  History
 ;*      18/09/2009 Created
@@ -50,9 +50,9 @@
 ;*******************************************************************************
 
 %ifdef X86_32_PICASM
-SECTION .text align=16
+SECTION .text align=32
 %else
-SECTION .rodata align=16
+SECTION .rodata align=32
 %endif
 
 align 16
@@ -79,6 +79,15 @@ sse2_dc_0x80: times 16 db 0x80
 align 16
 sse2_wd_0x02: times 8 dw 0x02
 
+%ifdef HAVE_AVX2
+align 32
+avx2_plane_inc_minus dw -7, -6, -5, -4, -3, -2, -1, 0, 1, 2, 3, 4, 5, 6, 7, 8
+
+; chroma dc [d00, d01, d10, d11] at bytes 0, 1, 5, 4 to the top and the bottom 8x4
+align 16
+avx2_chroma_dc_shufb: db 0, 0, 0, 0, 1, 1, 1, 1, 5, 5, 5, 5, 4, 4, 4, 4
+%endif
+
 ;*******************************************************************************
 ; macros
 ;*******************************************************************************
@@ -1454,3 +1463,382 @@ WELS_EXTERN WelsDecoderIChromaPredDcNA_mmx
     emms
     ret
 
+;*******************************************************************************
+; AVX2 functions
+;*******************************************************************************
+
+%ifdef HAVE_AVX2
+
+; Load the column of 4 pixels left of a block into the low bytes of %1, %2 is
+; advanced by 4 rows. Only the left pixels are read, a wider load would have to
+; wait for the stores of the previous prediction in the block.
+; xmm=%1 pPred-1=%2 kiStride=%3 3*kiStride=%4 zero=%5
+%macro AVX2_LoadLeft4 5
+    vpinsrb     %1, %5, byte [%2],          0
+    vpinsrb     %1, %1, byte [%2 + %3],     1
+    vpinsrb     %1, %1, byte [%2 + 2 * %3], 2
+    vpinsrb     %1, %1, byte [%2 + %4],     3
+    lea         %2, [%2 + 4 * %3]
+%endmacro
+
+; Columns of 8 and 16 pixels are gathered 4 rows at a time into separate
+; registers, which keeps the chains of dependent inserts short.
+; xmm=%1 pPred-1=%2 kiStride=%3 3*kiStride=%4 zero=%5 clobber=%6
+%macro AVX2_LoadLeft8 6
+    AVX2_LoadLeft4 %1, %2, %3, %4, %5
+    AVX2_LoadLeft4 %6, %2, %3, %4, %5
+    vpunpckldq  %1, %1, %6
+%endmacro
+
+; xmm=%1 pPred-1=%2 kiStride=%3 3*kiStride=%4 zero=%5 clobber=%6,%7
+%macro AVX2_LoadLeft16 7
+    AVX2_LoadLeft4 %1, %2, %3, %4, %5
+    AVX2_LoadLeft4 %6, %2, %3, %4, %5
+    vpunpckldq  %1, %1, %6
+    AVX2_LoadLeft4 %6, %2, %3, %4, %5
+    AVX2_LoadLeft4 %7, %2, %3, %4, %5
+    vpunpckldq  %6, %6, %7
+    vpunpcklqdq %1, %1, %6
+%endmacro
+
+; Store %1 to the 4 rows from %2, %2 is advanced by 4 rows.
+; xmm=%1 pPred=%2 kiStride=%3 3*kiStride=%4
+%macro AVX2_Store16x4 4
+    vmovdqa     [%2],          %1
+    vmovdqa     [%2 + %3],     %1
+    vmovdqa     [%2 + 2 * %3], %1
+    vmovdqa     [%2 + %4],     %1
+    lea         %2, [%2 + 4 * %3]
+%endmacro
+
+; Horizontal prediction of 4 rows from %1, %1 is advanced by 4 rows.
+; pPred=%1 kiStride=%2 3*kiStride=%3 width=%4
+%macro AVX2_PRED_H_FOUR_LINE 4
+    vpbroadcastb xmm0, [%1 - 1]
+    vpbroadcastb xmm1, [%1 + %2 - 1]
+    vpbroadcastb xmm2, [%1 + 2 * %2 - 1]
+    vpbroadcastb xmm3, [%1 + %3 - 1]
+%if %4 == 16
+    vmovdqa     [%1],          xmm0
+    vmovdqa     [%1 + %2],     xmm1
+    vmovdqa     [%1 + 2 * %2], xmm2
+    vmovdqa     [%1 + %3],     xmm3
+%else
+    vmovq       [%1],          xmm0
+    vmovq       [%1 + %2],     xmm1
+    vmovq       [%1 + 2 * %2], xmm2
+    vmovq       [%1 + %3],     xmm3
+%endif
+    lea         %1, [%1 + 4 * %2]
+%endmacro
+
+;*******************************************************************************
+; void WelsDecoderI16x16LumaPredPlane_avx2(uint8_t *pPred, const int32_t kiStride);
+;
+; The 16 words of a row fill a ymm register, the loop predicts two rows
+; per iteration without any multiplication.
+;*******************************************************************************
+WELS_EXTERN WelsDecoderI16x16LumaPredPlane_avx2
+    push r3
+    push r4
+    %assign push_num 2
+    INIT_X86_32_PIC r5
+    LOAD_2_PARA
+    PUSH_XMM 6
+    SIGN_EXTENSION r1, r1d
+    mov         r4, r0
+    lea         r3, [2 * r1 + r1]
+    lea         r2, [r0 - 1]
+    sub         r0, r1
+    vpxor       xmm3, xmm3, xmm3
+    AVX2_LoadLeft16 xmm2, r2, r1, r3, xmm3, xmm0, xmm1  ; left[0..15]
+    vmovdqa     xmm1, [r0]                      ; top[0..15]
+    vmovq       xmm0, [r0 - 1]                  ; top[-1..6]
+    vpslldq     xmm3, xmm2, 1
+    vpinsrb     xmm3, xmm3, byte [r0 - 1], 0    ; left[-1..14]
+    vpunpcklqdq xmm0, xmm0, xmm3                ; top[-1..6], left[-1..6]
+    vpunpckhqdq xmm1, xmm1, xmm2                ; top[8..15], left[8..15]
+
+    vpextrb     r2d, xmm1, 7
+    vpextrb     r3d, xmm1, 15
+    add         r3, r2
+    shl         r3, 4                           ; a = (left[15*kiStride] + top[15]) << 4;
+
+    vpmovzxbw   ymm0, xmm0
+    vpmovzxbw   ymm1, xmm1
+    vbroadcasti128 ymm2, [pic(sse2_plane_dec)]
+    vbroadcasti128 ymm3, [pic(sse2_plane_inc)]
+    vpmullw     ymm0, ymm0, ymm2
+    vpmullw     ymm1, ymm1, ymm3
+    vpsubw      ymm1, ymm1, ymm0
+    vextracti128 xmm0, ymm1, 1
+    vphaddw     xmm1, xmm1, xmm0
+    vphaddw     xmm1, xmm1, xmm1
+    vphaddw     xmm1, xmm1, xmm1                ; H, V
+    vmovd       r2d, xmm1
+    movsx       r0, r2w
+    vpextrw     r2d, xmm1, 1
+    movsx       r2, r2w
+    imul        r0, 5
+    add         r0, 32
+    sar         r0, 6                           ; b = (5 * H + 32) >> 6;
+    imul        r2, 5
+    add         r2, 32
+    sar         r2, 6                           ; c = (5 * V + 32) >> 6;
+
+    vmovd       xmm5, r0d
+    vpbroadcastw ymm5, xmm5
+    vpmullw     ymm5, ymm5, [pic(avx2_plane_inc_minus)]    ; b * (j - 7)
+    vmovd       xmm4, r2d
+    vpbroadcastw ymm4, xmm4                     ; c
+    add         r3, 16
+    imul        r2, -7
+    add         r3, r2                          ; s = a + 16 + (-7)*c
+    vmovd       xmm0, r3d
+    vpbroadcastw ymm0, xmm0
+    vpaddw      ymm0, ymm0, ymm5                ; row 0
+    vpaddw      ymm1, ymm0, ymm4                ; row 1
+    vpaddw      ymm4, ymm4, ymm4                ; 2 * c
+
+    mov         r2, 8
+.loop:
+    vpsraw      ymm2, ymm0, 5
+    vpsraw      ymm3, ymm1, 5
+    vpackuswb   ymm2, ymm2, ymm3
+    vpermq      ymm2, ymm2, 0d8h
+    vmovdqa     [r4], xmm2
+    vextracti128 [r4 + r1], ymm2, 1
+    vpaddw      ymm0, ymm0, ymm4
+    vpaddw      ymm1, ymm1, ymm4
+    lea         r4, [r4 + 2 * r1]
+    dec         r2
+    jnz         .loop
+    vzeroupper
+
+    POP_XMM
+    DEINIT_X86_32_PIC
+    pop r4
+    pop r3
+    ret
+
+;*******************************************************************************
+; void WelsDecoderI16x16LumaPredH_avx2(uint8_t *pPred, const int32_t kiStride);
+;*******************************************************************************
+WELS_EXTERN WelsDecoderI16x16LumaPredH_avx2
+    %assign push_num 0
+    LOAD_2_PARA
+    SIGN_EXTENSION r1, r1d
+    lea         r2, [2 * r1 + r1]
+    AVX2_PRED_H_FOUR_LINE r0, r1, r2, 16
+    AVX2_PRED_H_FOUR_LINE r0, r1, r2, 16
+    AVX2_PRED_H_FOUR_LINE r0, r1, r2, 16
+    AVX2_PRED_H_FOUR_LINE r0, r1, r2, 16
+    ret
+
+;*******************************************************************************
+; void WelsDecoderI16x16LumaPredDc_avx2(uint8_t *pPred, const int32_t kiStride);
+;*******************************************************************************
+WELS_EXTERN WelsDecoderI16x16LumaPredDc_avx2
+    push r3
+    %assign push_num 1
+    LOAD_2_PARA
+    SIGN_EXTENSION r1, r1d
+    lea         r3, [2 * r1 + r1]
+    lea         r2, [r0 - 1]
+    vpxor       xmm2, xmm2, xmm2
+    AVX2_LoadLeft16 xmm1, r2, r1, r3, xmm2, xmm0, xmm3
+    mov         r2, r0
+    sub         r2, r1
+    vmovdqa     xmm0, [r2]
+    vpsadbw     xmm0, xmm0, xmm2
+    vpsadbw     xmm1, xmm1, xmm2
+    vpaddw      xmm0, xmm0, xmm1
+    vpunpckhqdq xmm1, xmm0, xmm0
+    vpaddw      xmm0, xmm0, xmm1
+    vpsrlw      xmm0, xmm0, 4
+    vpavgw      xmm0, xmm0, xmm2                ; (16 + sum) >> 5
+    vpbroadcastb xmm0, xmm0
+    AVX2_Store16x4 xmm0, r0, r1, r3
+    AVX2_Store16x4 xmm0, r0, r1, r3
+    AVX2_Store16x4 xmm0, r0, r1, r3
+    AVX2_Store16x4 xmm0, r0, r1, r3
+    pop r3
+    ret
+
+;*******************************************************************************
+; void WelsDecoderI16x16LumaPredDcTop_avx2(uint8_t *pPred, const int32_t kiStride);
+;*******************************************************************************
+WELS_EXTERN WelsDecoderI16x16LumaPredDcTop_avx2
+    %assign push_num 0
+    LOAD_2_PARA
+    SIGN_EXTENSION r1, r1d
+    mov         r2, r0
+    sub         r2, r1
+    vmovdqa     xmm0, [r2]
+    vpxor       xmm2, xmm2, xmm2
+    vpsadbw     xmm0, xmm0, xmm2
+    vpunpckhqdq xmm1, xmm0, xmm0
+    vpaddw      xmm0, xmm0, xmm1
+    vpsrlw      xmm0, xmm0, 3
+    vpavgw      xmm0, xmm0, xmm2                ; (8 + sum) >> 4
+    vpbroadcastb xmm0, xmm0
+    lea         r2, [2 * r1 + r1]
+    AVX2_Store16x4 xmm0, r0, r1, r2
+    AVX2_Store16x4 xmm0, r0, r1, r2
+    AVX2_Store16x4 xmm0, r0, r1, r2
+    AVX2_Store16x4 xmm0, r0, r1, r2
+    ret
+
+;*******************************************************************************
+; void WelsDecoderIChromaPredPlane_avx2(uint8_t *pPred, const int32_t kiStride);
+;
+; Two rows of 8 words are predicted in the lanes of a ymm register.
+;*******************************************************************************
+WELS_EXTERN WelsDecoderIChromaPredPlane_avx2
+    push r3
+    push r4
+    %assign push_num 2
+    INIT_X86_32_PIC r5
+    LOAD_2_PARA
+    PUSH_XMM 6
+    SIGN_EXTENSION r1, r1d
+    mov         r4, r0
+    lea         r3, [2 * r1 + r1]
+    lea         r2, [r0 - 1]
+    sub         r0, r1
+    vpxor       xmm3, xmm3, xmm3
+    AVX2_LoadLeft8 xmm2, r2, r1, r3, xmm3, xmm0    ; left[0..7]
+    vmovd       xmm0, [r0 - 1]                  ; top[-1..2]
+    vmovd       xmm1, [r0 + 4]                  ; top[4..7]
+    vpslldq     xmm3, xmm2, 1
+    vpinsrb     xmm3, xmm3, byte [r0 - 1], 0    ; left[-1..6]
+    vpunpckldq  xmm0, xmm0, xmm3                ; top[-1..2], left[-1..2]
+    vpsrldq     xmm3, xmm2, 4
+    vpunpckldq  xmm1, xmm1, xmm3                ; top[4..7], left[4..7]
+
+    vpextrb     r2d, xmm1, 3
+    vpextrb     r3d, xmm1, 7
+    add         r3, r2
+    shl         r3, 4                           ; a = (left[7*kiStride] + top[7]) << 4;
+
+    vpmovzxbw   xmm0, xmm0
+    vpmovzxbw   xmm1, xmm1
+    vpbroadcastq xmm2, [pic(sse2_plane_dec_c)]
+    vpbroadcastq xmm3, [pic(sse2_plane_inc_c)]
+    vpmullw     xmm0, xmm0, xmm2
+    vpmullw     xmm1, xmm1, xmm3
+    vpsubw      xmm1, xmm1, xmm0
+    vphaddw     xmm1, xmm1, xmm1
+    vphaddw     xmm1, xmm1, xmm1                ; H, V
+    vmovd       r2d, xmm1
+    movsx       r0, r2w
+    vpextrw     r2d, xmm1, 1
+    movsx       r2, r2w
+    imul        r0, 17
+    add         r0, 16
+    sar         r0, 5                           ; b = (17 * H + 16) >> 5;
+    imul        r2, 17
+    add         r2, 16
+    sar         r2, 5                           ; c = (17 * V + 16) >> 5;
+
+    vmovd       xmm5, r0d
+    vpbroadcastw ymm5, xmm5
+    vbroadcasti128 ymm0, [pic(sse2_plane_mul_b_c)]
+    vpmullw     ymm5, ymm5, ymm0                ; b * (j - 3)
+    vmovd       xmm4, r2d
+    vpbroadcastw ymm4, xmm4                     ; c
+    add         r3, 16
+    imul        r2, -3
+    add         r3, r2                          ; s = a + 16 + (-3)*c
+    vmovd       xmm0, r3d
+    vpbroadcastw ymm0, xmm0
+    vpaddw      ymm0, ymm0, ymm5
+    vperm2i128  ymm5, ymm4, ymm4, 08h           ; 0, c
+    vpaddw      ymm0, ymm0, ymm5                ; rows 0, 1
+    vpaddw      ymm4, ymm4, ymm4                ; 2 * c
+    vpaddw      ymm1, ymm0, ymm4                ; rows 2, 3
+    vpaddw      ymm4, ymm4, ymm4                ; 4 * c
+    lea         r3, [2 * r1 + r1]
+
+    mov         r2, 2
+.loop:
+    vpsraw      ymm2, ymm0, 5
+    vpsraw      ymm3, ymm1, 5
+    vpackuswb   ymm2, ymm2, ymm3                ; rows 0, 2 | rows 1, 3
+    vextracti128 xmm3, ymm2, 1
+    vmovq       [r4],          xmm2
+    vmovq       [r4 + r1],     xmm3
+    vmovhps     [r4 + 2 * r1], xmm2
+    vmovhps     [r4 + r3],     xmm3
+    vpaddw      ymm0, ymm0, ymm4
+    vpaddw      ymm1, ymm1, ymm4
+    lea         r4, [r4 + 4 * r1]
+    dec         r2
+    jnz         .loop
+    vzeroupper
+
+    POP_XMM
+    DEINIT_X86_32_PIC
+    pop r4
+    pop r3
+    ret
+
+;*******************************************************************************
+; void WelsDecoderIChromaPredH_avx2(uint8_t *pPred, const int32_t kiStride);
+;*******************************************************************************
+WELS_EXTERN WelsDecoderIChromaPredH_avx2
+    %assign push_num 0
+    LOAD_2_PARA
+    SIGN_EXTENSION r1, r1d
+    lea         r2, [2 * r1 + r1]
+    AVX2_PRED_H_FOUR_LINE r0, r1, r2, 8
+    AVX2_PRED_H_FOUR_LINE r0, r1, r2, 8
+    ret
+
+;*******************************************************************************
+; void WelsDecoderIChromaPredDc_avx2(uint8_t *pPred, const int32_t kiStride);
+;*******************************************************************************
+WELS_EXTERN WelsDecoderIChromaPredDc_avx2
+    push r3
+    %assign push_num 1
+    INIT_X86_32_PIC r4
+    LOAD_2_PARA
+    PUSH_XMM 6
+    SIGN_EXTENSION r1, r1d
+    lea         r3, [2 * r1 + r1]
+    lea         r2, [r0 - 1]
+    vpxor       xmm5, xmm5, xmm5
+    AVX2_LoadLeft8 xmm1, r2, r1, r3, xmm5, xmm0    ; left[0..7]
+    mov         r2, r0
+    sub         r2, r1
+    vmovq       xmm0, [r2]                      ; top[0..7]
+    vpunpckldq  xmm2, xmm0, xmm1                ; top[0..3], left[0..3], top[4..7], left[4..7]
+    vpsrlq      xmm0, xmm0, 32
+    vpsrlq      xmm1, xmm1, 32
+    vpunpcklqdq xmm3, xmm0, xmm1                ; top[4..7], 0, left[4..7], 0
+    vpsadbw     xmm2, xmm2, xmm5
+    vpsadbw     xmm3, xmm3, xmm5
+    vpsrlw      xmm2, xmm2, 2
+    vpavgw      xmm2, xmm2, xmm5                ; (4 + sum) >> 3
+    vpsrlw      xmm3, xmm3, 1
+    vpavgw      xmm3, xmm3, xmm5                ; (2 + sum) >> 2
+    vpslldq     xmm3, xmm3, 2
+    vpor        xmm2, xmm2, xmm3
+    vpackuswb   xmm2, xmm2, xmm2
+    vpshufb     xmm2, xmm2, [pic(avx2_chroma_dc_shufb)]
+    vmovq       [r0],          xmm2
+    vmovq       [r0 + r1],     xmm2
+    vmovq       [r0 + 2 * r1], xmm2
+    vmovq       [r0 + r3],     xmm2
+    lea         r0, [r0 + 4 * r1]
+    vmovhps     [r0],          xmm2
+    vmovhps     [r0 + r1],     xmm2
+    vmovhps     [r0 + 2 * r1], xmm2
+    vmovhps     [r0 + r3],     xmm2
+
+    POP_XMM
+    DEINIT_X86_32_PIC
+    pop r3
+    ret
+
+%endif ; HAVE_AVX2
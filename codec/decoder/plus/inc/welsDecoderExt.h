@@ -46,6 +46,7 @@
 #include "codec_app_def.h"
 #include "decoder_context.h"
 #include "welsCodecTrace.h"
+#include "wels_decoder_scheduler.h"
 #include "cpu.h"
 
 class ISVCDecoder;
@@ -105,13 +106,42 @@ virtual DECODING_STATE EXTAPI DecodeFrameEx (const unsigned char* kpSrc,
 virtual long EXTAPI SetOption (DECODER_OPTION eOptID, void* pOption);
 virtual long EXTAPI GetOption (DECODER_OPTION eOptID, void* pOption);
 
+/*
+ *  WelsDecodeBatch(), the access units of decoders without threading of their own on the thread pool
+ */
+static int32_t DecodeBatch (SDecodeBatchItem* pItems, int32_t iItemNum, int32_t iThreadNum);
+void DecodeBatchItems (SDecodeBatchItem* pItems, const int32_t* pNextItem, int32_t iItem);
+
  private:
 PWelsDecoderContext     m_pDecContext;
 welsCodecTrace*         m_pWelsTrace;
+int32_t                 m_iThreadCount;         // DECODER_OPTION_NUM_OF_THREADS, kept over decoder resets
+bool                    m_bSliceThreading;      // DECODER_OPTION_SLICE_THREADING, kept over decoder resets
+SFrameAllocator         m_sFrameAllocator;      // DECODER_OPTION_FRAME_ALLOCATOR, kept over decoder resets
+bool                    m_bHoldOutput;          // DECODER_OPTION_HOLD_OUTPUT, kept over decoder resets
+uint32_t                m_uiCpuFlagsMask;       // DECODER_OPTION_CPU_FLAGS, kept over decoder resets
+bool                    m_bStageTiming;         // DECODER_OPTION_STAGE_TIMING, kept with the statistics over decoder resets
+DECODER_SKIP_MODE       m_eSkipMode;            // DECODER_OPTION_SKIP_FRAMES, kept over decoder resets
+SPicturePool*           m_pPicPool;             // DECODER_OPTION_PICTURE_POOL with a reference, kept over decoder resets
+SDecoderScheduling      m_sScheduling;          // DECODER_OPTION_SCHEDULING, kept over decoder resets
+SDecSchedClient*        m_pDecSched;            // non NULL while access units are decoded on the shared workers
+int32_t                 m_iNoDelayPass;         // 1/2 while in the first/second pass of DecodeFrameNoDelay()
 
 int32_t InitDecoder (const SDecodingParam* pParam);
 void UninitDecoder (void);
 int32_t ResetDecoder();
+void UpdateFrameAllocator();
+void WaitScheduled();
+DECODING_STATE QueueScheduled (const unsigned char* kpSrc, const int kiSrcLen, unsigned char** ppDst,
+                               SBufferInfo* pDstInfo);
+static void DecodeScheduled (void* pArg, const uint8_t* kpSrc, const int32_t kiSrcLen, uint64_t uiTimeStamp);
+DECODING_STATE DecodeFrameNoDelayInternal (const unsigned char* kpSrc, const int kiSrcLen, unsigned char** ppDst,
+    SBufferInfo* pDstInfo);
+DECODING_STATE DecodeFrame2Internal (const unsigned char* kpSrc, const int kiSrcLen, unsigned char** ppDst,
+                                     SBufferInfo* pDstInfo);
+bool CheckDecodeCall (const int kiSrcLen, DECODING_STATE* pState);
+DECODING_STATE DecodeAccessUnit (const unsigned char* kpSrc, const int kiSrcLen, unsigned char** ppDst,
+                                 SBufferInfo* pDstInfo);
 
 void OutputStatisticsLog (SDecoderStatistics& sDecoderStatistics);
 
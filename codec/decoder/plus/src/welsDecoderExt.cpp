@@ -51,16 +51,22 @@
 //#include "macros.h"
 #include "decoder.h"
 #include "decoder_core.h"
+#include "au_parser.h"
+#include "pic_pool.h"
 #include "error_concealment.h"
 
 #include "measure_time.h"
+#include "cpu.h"
 extern "C" {
 #include "decoder_core.h"
 #include "manage_dec_ref.h"
 }
+#include "wels_decoder_thread.h"
+#include "WelsThreadPool.h"
 #include "error_code.h"
 #include "crt_util_safe_x.h" // Safe CRT routines like util for cross platforms
 #include <time.h>
+#include <new>
 #if defined(_WIN32) /*&& defined(_DEBUG)*/
 
 #include <windows.h>
@@ -88,7 +94,18 @@ namespace WelsDec {
 ***************************************************************************/
 CWelsDecoder::CWelsDecoder (void)
   : m_pDecContext (NULL),
-    m_pWelsTrace (NULL) {
+    m_pWelsTrace (NULL),
+    m_iThreadCount (0),
+    m_bSliceThreading (false),
+    m_bHoldOutput (false),
+    m_uiCpuFlagsMask (0xffffffff),
+    m_bStageTiming (false),
+    m_eSkipMode (DECODER_SKIP_NONE),
+    m_pPicPool (NULL),
+    m_pDecSched (NULL),
+    m_iNoDelayPass (0) {
+  memset (&m_sFrameAllocator, 0, sizeof (SFrameAllocator));
+  memset (&m_sScheduling, 0, sizeof (SDecoderScheduling));
 #ifdef OUTPUT_BIT_STREAM
   char chFileName[1024] = { 0 };  //for .264
   int iBufUsed = 0;
@@ -167,7 +184,12 @@ CWelsDecoder::~CWelsDecoder() {
     WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_INFO, "CWelsDecoder::~CWelsDecoder()");
   }
 
+  if (m_pDecSched != NULL)
+    WelsDecSchedLeave (m_pDecSched); // once the access units queued are decoded
+  m_pDecSched = NULL;
   UninitDecoder();
+  if (m_pPicPool != NULL)
+    ReleasePicPool (m_pPicPool); // after the pictures went back to it
 
 #ifdef OUTPUT_BIT_STREAM
   if (m_pFBS) {
@@ -197,6 +219,7 @@ long CWelsDecoder::Initialize (const SDecodingParam* pParam) {
     return cmInitParaError;
   }
 
+  WaitScheduled();
   // H.264 decoder initialization,including memory allocation,then open it ready to decode
   iRet = InitDecoder (pParam);
   if (iRet)
@@ -206,6 +229,7 @@ long CWelsDecoder::Initialize (const SDecodingParam* pParam) {
 }
 
 long CWelsDecoder::Uninitialize() {
+  WaitScheduled();
   UninitDecoder();
 
   return ERR_NONE;
@@ -244,8 +268,12 @@ int32_t CWelsDecoder::InitDecoder (const SDecodingParam* pParam) {
            VERSION_NUMBER, (int32_t)pParam->bParseOnly);
 
   //reset decoder context
-  if (m_pDecContext) //free
+  SDecStageTiming sStageTiming;
+  ResetDecStageTiming (&sStageTiming);
+  if (m_pDecContext) { //free
+    sStageTiming = m_pDecContext->sStageTiming;
     UninitDecoder();
+  }
   m_pDecContext = (PWelsDecoderContext)WelsMallocz (sizeof (SWelsDecoderContext), "m_pDecContext");
   if (NULL == m_pDecContext)
     return cmMallocMemeError;
@@ -255,6 +283,12 @@ int32_t CWelsDecoder::InitDecoder (const SDecodingParam* pParam) {
 
   //fill in default value into context
   WelsDecoderDefaults (m_pDecContext, &m_pWelsTrace->m_sLogCtx);
+  m_pDecContext->uiCpuFlag &= m_uiCpuFlagsMask;
+  m_pDecContext->bStageTiming = m_bStageTiming;
+  m_pDecContext->sStageTiming = sStageTiming;
+  m_pDecContext->eSkipMode = m_eSkipMode;
+  m_pDecContext->pPicPool = m_pPicPool;
+  UpdateFrameAllocator();
 
   //check param and update decoder context
   m_pDecContext->pParam = (SDecodingParam*) m_pDecContext->pMemAlign->WelsMallocz (sizeof (SDecodingParam),
@@ -266,10 +300,20 @@ int32_t CWelsDecoder::InitDecoder (const SDecodingParam* pParam) {
   //init decoder
   WELS_VERIFY_RETURN_PROC_IF (cmMallocMemeError, WelsInitDecoder (m_pDecContext, &m_pWelsTrace->m_sLogCtx),
                               UninitDecoder())
+  if (WelsDecThreadInit (m_pDecContext, m_iThreadCount, m_bSliceThreading))
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_WARNING, "CWelsDecoder::InitDecoder(), threading disabled.");
 
   return cmResultSuccess;
 }
 
+// pictures decoded so far keep their memory until they are decoded to again
+void CWelsDecoder::UpdateFrameAllocator() {
+  if (m_bHoldOutput)
+    InitHeldPicAllocator (&m_pDecContext->sFrameAllocator);
+  else
+    m_pDecContext->sFrameAllocator = m_sFrameAllocator;
+}
+
 int32_t CWelsDecoder::ResetDecoder() {
   // TBC: need to be modified when context and trace point are null
   if (m_pDecContext != NULL && m_pWelsTrace != NULL) {
@@ -285,15 +329,54 @@ int32_t CWelsDecoder::ResetDecoder() {
   return ERR_INFO_UNINIT;
 }
 
+void CWelsDecoder::WaitScheduled() {
+  if (m_pDecSched != NULL)
+    WelsDecSchedWait (m_pDecSched);
+}
+
+// the output of the access unit goes to SDecoderScheduling::pfDecoded
+DECODING_STATE CWelsDecoder::QueueScheduled (const unsigned char* kpSrc, const int kiSrcLen, unsigned char** ppDst,
+    SBufferInfo* pDstInfo) {
+  ppDst[0] = ppDst[1] = ppDst[2] = NULL;
+  pDstInfo->iBufferStatus = 0;
+  if (WelsDecSchedSubmit (m_pDecSched, kpSrc, kiSrcLen, pDstInfo->uiInBsTimeStamp))
+    return dsOutOfMemory;
+  return dsErrorFree;
+}
+
+// on a worker of the thread pool, the access units of the decoder one at a time
+void CWelsDecoder::DecodeScheduled (void* pArg, const uint8_t* kpSrc, const int32_t kiSrcLen, uint64_t uiTimeStamp) {
+  CWelsDecoder* pThis = (CWelsDecoder*)pArg;
+  unsigned char* pDst[3] = { NULL, NULL, NULL };
+  SBufferInfo sDstInfo;
+  DECODING_STATE eState;
+
+  memset (&sDstInfo, 0, sizeof (SBufferInfo));
+  sDstInfo.uiInBsTimeStamp = uiTimeStamp;
+  if (kpSrc != NULL)
+    eState = pThis->DecodeFrameNoDelayInternal (kpSrc, kiSrcLen, pDst, &sDstInfo);
+  else
+    eState = pThis->DecodeFrame2Internal (NULL, 0, pDst, &sDstInfo);
+  pThis->m_sScheduling.pfDecoded (pThis->m_sScheduling.pUserContext, pDst, &sDstInfo, eState);
+}
+
 /*
  * Set Option
  */
 long CWelsDecoder::SetOption (DECODER_OPTION eOptID, void* pOption) {
   int iVal = 0;
 
+  if (eOptID == DECODER_OPTION_RELEASE_OUTPUT) { // held pictures outlive the decoder context, any thread may release them
+    if (pOption == NULL || * ((void**)pOption) == NULL)
+      return cmInitParaError;
+
+    ReleaseHeldPicBuffer (* ((void**)pOption));
+    return cmResultSuccess;
+  }
   if (m_pDecContext == NULL && eOptID != DECODER_OPTION_TRACE_LEVEL &&
       eOptID != DECODER_OPTION_TRACE_CALLBACK && eOptID != DECODER_OPTION_TRACE_CALLBACK_CONTEXT)
     return dsInitialOptExpected;
+  WaitScheduled();
   if (eOptID == DECODER_OPTION_END_OF_STREAM) { // Indicate bit-stream of the final frame to be decoded
     if (pOption == NULL)
       return cmInitParaError;
@@ -308,7 +391,7 @@ long CWelsDecoder::SetOption (DECODER_OPTION eOptID, void* pOption) {
       return cmInitParaError;
 
     iVal = * ((int*)pOption); // int value for error concealment idc
-    iVal = WELS_CLIP3 (iVal, (int32_t) ERROR_CON_DISABLE, (int32_t) ERROR_CON_SLICE_MV_COPY_CROSS_IDR_FREEZE_RES_CHANGE);
+    iVal = WELS_CLIP3 (iVal, (int32_t) ERROR_CON_DISABLE, (int32_t) ERROR_CON_FRAME_COPY_CROSS_IDR_ALIAS);
     if ((m_pDecContext->pParam->bParseOnly) && (iVal != (int32_t) ERROR_CON_DISABLE)) {
       WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_INFO,
                "CWelsDecoder::SetOption for ERROR_CON_IDC = %d not allowd for parse only!.", iVal);
@@ -355,6 +438,157 @@ long CWelsDecoder::SetOption (DECODER_OPTION eOptID, void* pOption) {
     WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_WARNING,
              "CWelsDecoder::SetOption():DECODER_OPTION_GET_SAR_INFO: this option is get-only!");
     return cmInitParaError;
+  } else if (eOptID == DECODER_OPTION_NUM_OF_THREADS) {
+    if (pOption == NULL)
+      return cmInitParaError;
+
+    iVal = * ((int*)pOption);
+    iVal = WELS_CLIP3 (iVal, 0, MAX_DEC_FRAME_THREAD_NUM);
+    if (iVal > 1 && m_pDecSched != NULL) {
+      WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_WARNING,
+               "CWelsDecoder::SetOption():NUM_OF_THREADS: not available together with SCHEDULING!");
+      return cmInitParaError;
+    }
+    m_iThreadCount = iVal;
+    if (WelsDecThreadInit (m_pDecContext, iVal, m_bSliceThreading)) {
+      m_iThreadCount = 0;
+      return cmMallocMemeError;
+    }
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_INFO,
+             "CWelsDecoder::SetOption for NUM_OF_THREADS = %d.", iVal);
+    return cmResultSuccess;
+  } else if (eOptID == DECODER_OPTION_SLICE_THREADING) {
+    if (pOption == NULL)
+      return cmInitParaError;
+
+    iVal = * ((int*)pOption);
+    m_bSliceThreading = (iVal != 0);
+    if (WelsDecThreadInit (m_pDecContext, m_iThreadCount, m_bSliceThreading)) {
+      m_iThreadCount = 0;
+      return cmMallocMemeError;
+    }
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_INFO,
+             "CWelsDecoder::SetOption for SLICE_THREADING = %d.", iVal);
+    return cmResultSuccess;
+  } else if (eOptID == DECODER_OPTION_FRAME_ALLOCATOR) {
+    if (pOption == NULL)
+      return cmInitParaError;
+
+    SFrameAllocator sAllocator = * ((SFrameAllocator*)pOption);
+    if (sAllocator.pfGetBuffer == NULL || sAllocator.pfReleaseBuffer == NULL)
+      memset (&sAllocator, 0, sizeof (SFrameAllocator));
+    else if (m_bHoldOutput)
+      return cmInitParaError;
+    m_sFrameAllocator = sAllocator;
+    UpdateFrameAllocator();
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_INFO,
+             "CWelsDecoder::SetOption for FRAME_ALLOCATOR, enabled = %d.", m_sFrameAllocator.pfGetBuffer != NULL);
+    return cmResultSuccess;
+  } else if (eOptID == DECODER_OPTION_HOLD_OUTPUT) {
+    if (pOption == NULL)
+      return cmInitParaError;
+
+    iVal = * ((int*)pOption);
+    if (iVal != 0 && m_sFrameAllocator.pfGetBuffer != NULL)
+      return cmInitParaError;
+    m_bHoldOutput = (iVal != 0);
+    UpdateFrameAllocator();
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_INFO,
+             "CWelsDecoder::SetOption for HOLD_OUTPUT = %d.", iVal);
+    return cmResultSuccess;
+  } else if (eOptID == DECODER_OPTION_NUM_OF_FRAMES_REMAINING_IN_BUFFER) {
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_WARNING,
+             "CWelsDecoder::SetOption():DECODER_OPTION_NUM_OF_FRAMES_REMAINING_IN_BUFFER: this option is get-only!");
+    return cmInitParaError;
+  } else if (eOptID == DECODER_OPTION_CPU_FLAGS) {
+    if (pOption == NULL)
+      return cmInitParaError;
+
+    m_uiCpuFlagsMask = * ((unsigned int*)pOption);
+    m_pDecContext->uiCpuFlag = WelsCPUFeatureDetect (NULL) & m_uiCpuFlagsMask;
+    InitDecFuncs (m_pDecContext, m_pDecContext->uiCpuFlag);
+    InitErrorCon (m_pDecContext);
+    // the decoding threads keep copies of the function pointers
+    WelsDecThreadUninit (m_pDecContext);
+    if (WelsDecThreadInit (m_pDecContext, m_iThreadCount, m_bSliceThreading)) {
+      m_iThreadCount = 0;
+      return cmMallocMemeError;
+    }
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_INFO,
+             "CWelsDecoder::SetOption for CPU_FLAGS = 0x%x, used 0x%x.", m_uiCpuFlagsMask, m_pDecContext->uiCpuFlag);
+    return cmResultSuccess;
+  } else if (eOptID == DECODER_OPTION_STAGE_TIMING) {
+    if (pOption == NULL)
+      return cmInitParaError;
+
+    iVal = * ((int*)pOption);
+    m_bStageTiming = (iVal != 0);
+    m_pDecContext->bStageTiming = m_bStageTiming;
+    ResetDecStageTiming (&m_pDecContext->sStageTiming);
+    return cmResultSuccess;
+  } else if (eOptID == DECODER_OPTION_GET_STAGE_STATISTICS) {
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_WARNING,
+             "CWelsDecoder::SetOption():DECODER_OPTION_GET_STAGE_STATISTICS: this option is get-only!");
+    return cmInitParaError;
+  } else if (eOptID == DECODER_OPTION_SKIP_FRAMES) {
+    if (pOption == NULL)
+      return cmInitParaError;
+
+    iVal = * ((int*)pOption);
+    if (iVal < DECODER_SKIP_NONE || iVal > DECODER_SKIP_NON_IDR) {
+      WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_WARNING,
+               "CWelsDecoder::SetOption():DECODER_OPTION_SKIP_FRAMES: unsupported mode %d!", iVal);
+      return cmInitParaError;
+    }
+    m_eSkipMode = (DECODER_SKIP_MODE) iVal;
+    m_pDecContext->eSkipMode = m_eSkipMode;
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_INFO,
+             "CWelsDecoder::SetOption for SKIP_FRAMES = %d.", iVal);
+    return cmResultSuccess;
+  } else if (eOptID == DECODER_OPTION_PICTURE_POOL) {
+    if (pOption == NULL)
+      return cmInitParaError;
+
+    // pictures allocated so far give their memory back where it comes from
+    SPicturePool* pPicPool = * ((SPicturePool**)pOption);
+    if (pPicPool != NULL)
+      AddRefPicPool (pPicPool);
+    if (m_pPicPool != NULL)
+      ReleasePicPool (m_pPicPool);
+    m_pPicPool = pPicPool;
+    m_pDecContext->pPicPool = m_pPicPool;
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_INFO,
+             "CWelsDecoder::SetOption for PICTURE_POOL, enabled = %d.", m_pPicPool != NULL);
+    return cmResultSuccess;
+  } else if (eOptID == DECODER_OPTION_SCHEDULING) {
+    if (pOption == NULL)
+      return cmInitParaError;
+
+    SDecoderScheduling sScheduling = * ((SDecoderScheduling*)pOption);
+    if (sScheduling.pfDecoded == NULL) {
+      if (m_pDecSched != NULL)
+        WelsDecSchedLeave (m_pDecSched);
+      m_pDecSched = NULL;
+    } else {
+      // the workers of the pool cannot wait for the frame or slice tasks of the decoder
+      if (m_iThreadCount > 1 || m_pDecContext->pParam->bParseOnly)
+        return cmInitParaError;
+      if (m_pDecSched == NULL)
+        m_pDecSched = WelsDecSchedJoin (DecodeScheduled, this, sScheduling.iWeight);
+      else
+        WelsDecSchedSetWeight (m_pDecSched, sScheduling.iWeight);
+      if (m_pDecSched == NULL)
+        return cmMallocMemeError;
+    }
+    m_sScheduling = sScheduling;
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_INFO,
+             "CWelsDecoder::SetOption for SCHEDULING, enabled = %d, weight = %d.", m_pDecSched != NULL,
+             sScheduling.iWeight);
+    return cmResultSuccess;
+  } else if (eOptID == DECODER_OPTION_GET_SCHEDULING_STATISTICS) {
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_WARNING,
+             "CWelsDecoder::SetOption():DECODER_OPTION_GET_SCHEDULING_STATISTICS: this option is get-only!");
+    return cmInitParaError;
   }
   return cmInitParaError;
 }
@@ -371,6 +605,13 @@ long CWelsDecoder::GetOption (DECODER_OPTION eOptID, void* pOption) {
   if (pOption == NULL)
     return cmInitParaError;
 
+  if (DECODER_OPTION_GET_SCHEDULING_STATISTICS == eOptID) { // while access units are being decoded
+    memset (pOption, 0, sizeof (SDecoderSchedulingStatistics));
+    if (m_pDecSched != NULL)
+      WelsDecSchedGetStatistics (m_pDecSched, (SDecoderSchedulingStatistics*)pOption);
+    return cmResultSuccess;
+  }
+  WaitScheduled();
   if (DECODER_OPTION_END_OF_STREAM == eOptID) {
     iVal = m_pDecContext->bEndOfStreamFlag;
     * ((int*)pOption) = iVal;
@@ -457,6 +698,45 @@ long CWelsDecoder::GetOption (DECODER_OPTION eOptID, void* pOption) {
     iVal = (int) m_pDecContext->pSps->uiLevelIdc;
     * ((int*)pOption) = iVal;
     return cmResultSuccess;
+  } else if (DECODER_OPTION_NUM_OF_THREADS == eOptID) {
+    iVal = m_iThreadCount;
+    * ((int*)pOption) = iVal;
+    return cmResultSuccess;
+  } else if (DECODER_OPTION_SLICE_THREADING == eOptID) {
+    iVal = m_bSliceThreading ? 1 : 0;
+    * ((int*)pOption) = iVal;
+    return cmResultSuccess;
+  } else if (DECODER_OPTION_FRAME_ALLOCATOR == eOptID) {
+    * ((SFrameAllocator*)pOption) = m_sFrameAllocator;
+    return cmResultSuccess;
+  } else if (DECODER_OPTION_HOLD_OUTPUT == eOptID) {
+    iVal = m_bHoldOutput ? 1 : 0;
+    * ((int*)pOption) = iVal;
+    return cmResultSuccess;
+  } else if (DECODER_OPTION_NUM_OF_FRAMES_REMAINING_IN_BUFFER == eOptID) {
+    iVal = WelsDecThreadGetPendingNum (m_pDecContext);
+    * ((int*)pOption) = iVal;
+    return cmResultSuccess;
+  } else if (DECODER_OPTION_CPU_FLAGS == eOptID) {
+    * ((unsigned int*)pOption) = m_pDecContext->uiCpuFlag;
+    return cmResultSuccess;
+  } else if (DECODER_OPTION_STAGE_TIMING == eOptID) {
+    iVal = m_bStageTiming ? 1 : 0;
+    * ((int*)pOption) = iVal;
+    return cmResultSuccess;
+  } else if (DECODER_OPTION_GET_STAGE_STATISTICS == eOptID) {
+    GetDecStageStatistics (&m_pDecContext->sStageTiming, (SDecoderStageStatistics*)pOption);
+    return cmResultSuccess;
+  } else if (DECODER_OPTION_SKIP_FRAMES == eOptID) {
+    iVal = (int) m_eSkipMode;
+    * ((int*)pOption) = iVal;
+    return cmResultSuccess;
+  } else if (DECODER_OPTION_PICTURE_POOL == eOptID) {
+    * ((SPicturePool**)pOption) = m_pPicPool;
+    return cmResultSuccess;
+  } else if (DECODER_OPTION_SCHEDULING == eOptID) {
+    * ((SDecoderScheduling*)pOption) = m_sScheduling;
+    return cmResultSuccess;
   }
 
   return cmInitParaError;
@@ -466,16 +746,28 @@ DECODING_STATE CWelsDecoder::DecodeFrameNoDelay (const unsigned char* kpSrc,
     const int kiSrcLen,
     unsigned char** ppDst,
     SBufferInfo* pDstInfo) {
+  if (m_pDecSched != NULL)
+    return QueueScheduled (kpSrc, kiSrcLen, ppDst, pDstInfo);
+  return DecodeFrameNoDelayInternal (kpSrc, kiSrcLen, ppDst, pDstInfo);
+}
+
+DECODING_STATE CWelsDecoder::DecodeFrameNoDelayInternal (const unsigned char* kpSrc,
+    const int kiSrcLen,
+    unsigned char** ppDst,
+    SBufferInfo* pDstInfo) {
   int iRet;
   //SBufferInfo sTmpBufferInfo;
   //unsigned char* ppTmpDst[3] = {NULL, NULL, NULL};
 
-  iRet = (int) DecodeFrame2 (kpSrc, kiSrcLen, ppDst, pDstInfo);
+  m_iNoDelayPass = 1; // frame threads report output in the second pass only
+  iRet = (int) DecodeFrame2Internal (kpSrc, kiSrcLen, ppDst, pDstInfo);
+  m_iNoDelayPass = 2;
   //memcpy (&sTmpBufferInfo, pDstInfo, sizeof (SBufferInfo));
   //ppTmpDst[0] = ppDst[0];
   //ppTmpDst[1] = ppDst[1];
   //ppTmpDst[2] = ppDst[2];
-  iRet |= DecodeFrame2 (NULL, 0, ppDst, pDstInfo);
+  iRet |= DecodeFrame2Internal (NULL, 0, ppDst, pDstInfo);
+  m_iNoDelayPass = 0;
   //if ((pDstInfo->iBufferStatus == 0) && (sTmpBufferInfo.iBufferStatus == 1)) {
   //memcpy (pDstInfo, &sTmpBufferInfo, sizeof (SBufferInfo));
   //ppDst[0] = ppTmpDst[0];
@@ -490,24 +782,66 @@ DECODING_STATE CWelsDecoder::DecodeFrame2 (const unsigned char* kpSrc,
     const int kiSrcLen,
     unsigned char** ppDst,
     SBufferInfo* pDstInfo) {
+  if (m_pDecSched != NULL)
+    return QueueScheduled (kpSrc, kiSrcLen, ppDst, pDstInfo);
+  return DecodeFrame2Internal (kpSrc, kiSrcLen, ppDst, pDstInfo);
+}
+
+DECODING_STATE CWelsDecoder::DecodeFrame2Internal (const unsigned char* kpSrc,
+    const int kiSrcLen,
+    unsigned char** ppDst,
+    SBufferInfo* pDstInfo) {
+  DECODING_STATE eState;
+  if (!CheckDecodeCall (kiSrcLen, &eState))
+    return eState;
+
+  const int64_t kiStart = WelsTime();
+  eState = DecodeAccessUnit (kpSrc, kiSrcLen, ppDst, pDstInfo);
+  if (eState == dsOutOfMemory) // the decoder was reset
+    return eState;
+  m_pDecContext->dDecTime += (WelsTime() - kiStart) / 1e3;
+  if (eState != dsErrorFree || pDstInfo->iBufferStatus == 1)
+    OutputStatisticsLog (m_pDecContext->sDecoderStatistics);
+
+  return eState;
+}
+
+/*
+ *  the checks of a decoding call, kiSrcLen being the size of the largest access unit to decode
+ *  @return: false when the call is to return *pState without decoding
+ */
+bool CWelsDecoder::CheckDecodeCall (const int kiSrcLen, DECODING_STATE* pState) {
+  *pState = dsErrorFree;
   if (m_pDecContext == NULL || m_pDecContext->pParam == NULL) {
     if (m_pWelsTrace != NULL) {
       WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_ERROR, "Call DecodeFrame2 without Initialize.\n");
     }
-    return dsInitialOptExpected;
+    *pState = dsInitialOptExpected;
+    return false;
   }
 
   if (m_pDecContext->pParam->bParseOnly) {
     WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_ERROR, "bParseOnly should be false for this API calling! \n");
     m_pDecContext->iErrorCode |= dsInvalidArgument;
-    return dsInvalidArgument;
+    *pState = dsInvalidArgument;
+    return false;
   }
   if (CheckBsBuffer (m_pDecContext, kiSrcLen)) {
     if (ResetDecoder())
-      return dsOutOfMemory;
-
-    return dsErrorFree;
+      *pState = dsOutOfMemory;
+    return false;
   }
+  return true;
+}
+
+/*
+ *  decodes kpSrc, NULL to finish the pending picture, once the call is checked. The decoding time and the statistics
+ *  log are left to the caller; dsOutOfMemory means the decoder was reset
+ */
+DECODING_STATE CWelsDecoder::DecodeAccessUnit (const unsigned char* kpSrc,
+    const int kiSrcLen,
+    unsigned char** ppDst,
+    SBufferInfo* pDstInfo) {
   if (kiSrcLen > 0 && kpSrc != NULL) {
 #ifdef OUTPUT_BIT_STREAM
     if (m_pFBS) {
@@ -527,8 +861,6 @@ DECODING_STATE CWelsDecoder::DecodeFrame2 (const unsigned char* kpSrc,
     m_pDecContext->bInstantDecFlag = true;
   }
 
-  int64_t iStart, iEnd;
-  iStart = WelsTime();
   ppDst[0] = ppDst[1] = ppDst[2] = NULL;
   m_pDecContext->iErrorCode             = dsErrorFree; //initialize at the starting of AU decoding.
   m_pDecContext->iFeedbackVclNalInAu = FEEDBACK_UNKNOWN_NAL; //initialize
@@ -553,6 +885,12 @@ DECODING_STATE CWelsDecoder::DecodeFrame2 (const unsigned char* kpSrc,
   WelsDecodeBs (m_pDecContext, kpSrc, kiSrcLen, ppDst,
                 pDstInfo, NULL); //iErrorCode has been modified in this function
   m_pDecContext->bInstantDecFlag = false; //reset no-delay flag
+  if (m_pDecContext->pThreadCtx != NULL && m_iNoDelayPass != 1 && ! (m_pDecContext->iErrorCode & dsOutOfMemory)) {
+    // with frame threading, report the oldest picture decoded, all of them at the end of stream
+    WelsDecThreadOutputPicture (m_pDecContext, ppDst, pDstInfo, (kpSrc == NULL || kiSrcLen <= 0) && m_iNoDelayPass == 0);
+  }
+  if (m_bHoldOutput && m_iNoDelayPass != 1 && pDstInfo->iBufferStatus == 1 && pDstInfo->pFrameBuffer != NULL)
+    AddRefHeldPicBuffer (pDstInfo->pFrameBuffer); // reference of the application
   if (m_pDecContext->iErrorCode) {
     EWelsNalUnitType eNalType =
       NAL_UNIT_UNSPEC_0; //for NBR, IDR frames are expected to decode as followed if error decoding an IDR currently
@@ -612,10 +950,6 @@ DECODING_STATE CWelsDecoder::DecodeFrame2 (const unsigned char* kpSrc,
       m_pDecContext->sDecoderStatistics.uiAvgEcPropRatio = m_pDecContext->sDecoderStatistics.uiEcFrameNum == 0 ? 0 :
           m_pDecContext->sDecoderStatistics.uiAvgEcPropRatio / m_pDecContext->sDecoderStatistics.uiEcFrameNum;
     }
-    iEnd = WelsTime();
-    m_pDecContext->dDecTime += (iEnd - iStart) / 1e3;
-
-    OutputStatisticsLog (m_pDecContext->sDecoderStatistics);
 
     return (DECODING_STATE) m_pDecContext->iErrorCode;
   }
@@ -628,13 +962,7 @@ DECODING_STATE CWelsDecoder::DecodeFrame2 (const unsigned char* kpSrc,
       ResetDecStatNums (&m_pDecContext->sDecoderStatistics);
       m_pDecContext->sDecoderStatistics.uiDecodedFrameCount++;
     }
-
-    OutputStatisticsLog (m_pDecContext->sDecoderStatistics);
   }
-  iEnd = WelsTime();
-  m_pDecContext->dDecTime += (iEnd - iStart) / 1e3;
-
-
 
   return dsErrorFree;
 }
@@ -687,6 +1015,7 @@ void CWelsDecoder::OutputStatisticsLog (SDecoderStatistics& sDecoderStatistics)
 DECODING_STATE CWelsDecoder::DecodeParser (const unsigned char* kpSrc,
     const int kiSrcLen,
     SParserBsInfo* pDstInfo) {
+  WaitScheduled();
   if (m_pDecContext == NULL || m_pDecContext->pParam == NULL) {
     if (m_pWelsTrace != NULL) {
       WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_ERROR, "Call DecodeParser without Initialize.\n");
@@ -807,6 +1136,188 @@ DECODING_STATE CWelsDecoder::DecodeFrameEx (const unsigned char* kpSrc,
 }
 
 
+
+/*
+ *  the access units of a decoder in a WelsDecodeBatch() call, each of them as with DecodeFrameNoDelay(). The call is
+ *  checked and its decoding time taken once for all of them
+ */
+void CWelsDecoder::DecodeBatchItems (SDecodeBatchItem* pItems, const int32_t* pNextItem, int32_t iItem) {
+  DECODING_STATE eState;
+  int32_t iMaxSrcLen = 0;
+  bool bReset = false;
+
+  for (int32_t i = iItem; i >= 0; i = pNextItem[i])
+    iMaxSrcLen = WELS_MAX (iMaxSrcLen, pItems[i].iSrcLen);
+  if (m_pDecSched == NULL && CheckDecodeCall (iMaxSrcLen, &eState)) {
+    const int64_t kiStart = WelsTime();
+    for (; iItem >= 0 && !bReset; iItem = pNextItem[iItem]) {
+      SDecodeBatchItem* pItem = &pItems[iItem];
+      const uint32_t kuiFrameCount = m_pDecContext->sDecoderStatistics.uiDecodedFrameCount;
+      m_iNoDelayPass = 1;
+      eState = DecodeAccessUnit (pItem->pSrc, pItem->iSrcLen, pItem->pDst, &pItem->sDstInfo);
+      bReset = (eState == dsOutOfMemory);
+      if (!bReset) {
+        m_iNoDelayPass = 2;
+        const DECODING_STATE keFlushState = DecodeAccessUnit (NULL, 0, pItem->pDst, &pItem->sDstInfo);
+        bReset = (keFlushState == dsOutOfMemory);
+        eState = (DECODING_STATE) (eState | keFlushState);
+      }
+      m_iNoDelayPass = 0;
+      pItem->eState = eState;
+      if (!bReset && (eState != dsErrorFree || kuiFrameCount != m_pDecContext->sDecoderStatistics.uiDecodedFrameCount))
+        OutputStatisticsLog (m_pDecContext->sDecoderStatistics);
+    }
+    if (!bReset)
+      m_pDecContext->dDecTime += (WelsTime() - kiStart) / 1e3;
+  }
+  // scheduled decoders, failed checks and the access units following a reset of the decoder
+  for (; iItem >= 0; iItem = pNextItem[iItem])
+    pItems[iItem].eState = DecodeFrameNoDelay (pItems[iItem].pSrc, pItems[iItem].iSrcLen, pItems[iItem].pDst,
+                           &pItems[iItem].sDstInfo);
+}
+
+/*
+ *  access units of a WelsDecodeBatch() call, the ones of a decoder are chained in order
+ */
+typedef struct TagDecBatch {
+  SDecodeBatchItem*     pItems;
+  int32_t*              pNextItem;      // next item of the same decoder, -1 after the last one
+  int32_t*              pChain;         // first item of each decoder, the ones for the thread pool first, the ones
+                                        // of decoders with threads of their own from the end
+  int32_t               iChainNum;      // chains for the thread pool
+  int32_t               iNextChain;     // next chain for a thread to take
+  int32_t               iRunningTaskNum;
+  WELS_MUTEX            hMutex;
+  WELS_COND             hCond;          // signalled when a task is back from the thread pool
+} SDecBatch;
+
+static void DecodeBatchChain (SDecBatch* pBatch, int32_t iItem) {
+  ((CWelsDecoder*)pBatch->pItems[iItem].pDecoder)->DecodeBatchItems (pBatch->pItems, pBatch->pNextItem, iItem);
+}
+
+static void RunDecBatch (SDecBatch* pBatch) {
+  for (;;) {
+    WelsMutexLock (&pBatch->hMutex);
+    const int32_t kiChain = pBatch->iNextChain < pBatch->iChainNum ? pBatch->iNextChain ++ : -1;
+    WelsMutexUnlock (&pBatch->hMutex);
+    if (kiChain < 0)
+      break;
+    DecodeBatchChain (pBatch, pBatch->pChain[kiChain]);
+  }
+}
+
+class CWelsDecBatchTask : public WelsCommon::IWelsTask, public WelsCommon::IWelsTaskSink {
+ public:
+  CWelsDecBatchTask() : IWelsTask (this), m_pBatch (NULL) {
+  }
+  virtual ~CWelsDecBatchTask() {
+  }
+
+  void SetBatch (SDecBatch* pBatch) {
+    m_pBatch = pBatch;
+  }
+  virtual int Execute() {
+    RunDecBatch (m_pBatch);
+    return 0;
+  }
+  virtual int OnTaskExecuted() {
+    WelsMutexLock (&m_pBatch->hMutex);
+    -- m_pBatch->iRunningTaskNum;
+    WelsCondBroadcast (&m_pBatch->hCond);
+    WelsMutexUnlock (&m_pBatch->hMutex);
+    return 0;
+  }
+  virtual int OnTaskCancelled() {
+    return OnTaskExecuted();
+  }
+
+ private:
+  SDecBatch*  m_pBatch;
+};
+
+int32_t CWelsDecoder::DecodeBatch (SDecodeBatchItem* pItems, int32_t iItemNum, int32_t iThreadNum) {
+  SDecBatch sBatch;
+  int32_t iHashSize = 1;
+  int32_t* pHash;                       // open addressing, the last item of each decoder
+  int32_t iSerialChainNum = 0;          // chains of decoders with threads of their own, for the calling thread
+
+  for (int32_t i = 0; i < iItemNum; ++ i) {
+    if (pItems[i].pDecoder == NULL)
+      return ERR_INVALID_PARAMETERS;
+  }
+  if (iItemNum <= 0)
+    return ERR_NONE;
+
+  while (iHashSize < (iItemNum << 1))
+    iHashSize <<= 1;
+  memset (&sBatch, 0, sizeof (SDecBatch));
+  sBatch.pItems = pItems;
+  sBatch.pNextItem = (int32_t*)WelsMallocz ((iItemNum * 2 + iHashSize) * sizeof (int32_t), "SDecBatch");
+  WELS_VERIFY_RETURN_IF (ERR_MALLOC_FAILED, NULL == sBatch.pNextItem);
+  sBatch.pChain = sBatch.pNextItem + iItemNum;
+  pHash = sBatch.pChain + iItemNum;
+  memset (pHash, -1, iHashSize * sizeof (int32_t));
+
+  // chain the items of each decoder
+  for (int32_t i = 0; i < iItemNum; ++ i) {
+    CWelsDecoder* pDecoder = (CWelsDecoder*)pItems[i].pDecoder;
+    sBatch.pNextItem[i] = -1;
+    int32_t iSlot = (int32_t) (((uintptr_t)pDecoder >> 4) * 2654435761u) & (iHashSize - 1);
+    while (pHash[iSlot] >= 0 && pItems[pHash[iSlot]].pDecoder != pItems[i].pDecoder)
+      iSlot = (iSlot + 1) & (iHashSize - 1);
+    if (pHash[iSlot] >= 0)
+      sBatch.pNextItem[pHash[iSlot]] = i;
+    else if (pDecoder->m_iThreadCount > 1)
+      sBatch.pChain[iItemNum - 1 - iSerialChainNum ++] = i;
+    else
+      sBatch.pChain[sBatch.iChainNum ++] = i;
+    pHash[iSlot] = i;
+  }
+
+  // the pool keeps the size it has, it is shared with the threads of the decoders and encoders of the process
+  WelsCommon::CWelsThreadPool* pThreadPool = NULL;
+  CWelsDecBatchTask* pTasks = NULL;
+  int32_t iTaskNum = 0;
+  if (iThreadNum > 1 && sBatch.iChainNum > 1)
+    pThreadPool = WelsCommon::CWelsThreadPool::AddReference();
+  if (pThreadPool != NULL) {
+    iTaskNum = WELS_MIN (WELS_MIN (iThreadNum - 1, pThreadPool->GetThreadNum()), sBatch.iChainNum - 1);
+    pTasks = new (std::nothrow) CWelsDecBatchTask[iTaskNum];
+    if (pTasks == NULL)
+      iTaskNum = 0;
+  }
+  WelsMutexInit (&sBatch.hMutex);
+  WelsCondInit (&sBatch.hCond);
+  for (int32_t i = 0; i < iTaskNum; ++ i) {
+    pTasks[i].SetBatch (&sBatch);
+    WelsMutexLock (&sBatch.hMutex);
+    ++ sBatch.iRunningTaskNum;
+    WelsMutexUnlock (&sBatch.hMutex);
+    if (WELS_THREAD_ERROR_OK != pThreadPool->QueueTask (&pTasks[i])) {
+      WelsMutexLock (&sBatch.hMutex);
+      -- sBatch.iRunningTaskNum;
+      WelsMutexUnlock (&sBatch.hMutex);
+      break;
+    }
+  }
+
+  for (int32_t i = 0; i < iSerialChainNum; ++ i)
+    DecodeBatchChain (&sBatch, sBatch.pChain[iItemNum - 1 - i]);
+  RunDecBatch (&sBatch);
+  WelsMutexLock (&sBatch.hMutex);
+  while (sBatch.iRunningTaskNum > 0)
+    WelsCondWait (&sBatch.hCond, &sBatch.hMutex);
+  WelsMutexUnlock (&sBatch.hMutex);
+
+  WelsCondDestroy (&sBatch.hCond);
+  WelsMutexDestroy (&sBatch.hMutex);
+  delete [] pTasks;
+  if (pThreadPool != NULL)
+    pThreadPool->RemoveInstance();
+  WelsFree (sBatch.pNextItem, "SDecBatch");
+  return ERR_NONE;
+}
+
 } // namespace WelsDec
 
 
@@ -829,6 +1340,39 @@ int WelsGetDecoderCapability (SDecoderCapability* pDecCapability) {
 
   return ERR_NONE;
 }
+
+/*
+*       WelsIndexAccessUnits
+*       @return: count of access units in the bitstream, negative on invalid parameters
+*/
+int WelsIndexAccessUnits (const unsigned char* pSrc, long long iSrcLen, SAccessUnitIndex* pIndex, int iMaxEntries) {
+  return IndexAccessUnits (pSrc, iSrcLen, pIndex, iMaxEntries);
+}
+
+/*
+*       WelsCreatePicturePool
+*       @return: 0 - success; otherwise - failed
+*/
+int WelsCreatePicturePool (const SPicturePoolParam* pParam, SPicturePool** ppPool) {
+  if (NULL == ppPool || NULL == pParam || pParam->iMaxWidth <= 0 || pParam->iMaxHeight <= 0 || pParam->iNumPictures < 0)
+    return ERR_INVALID_PARAMETERS;
+
+  *ppPool = CreatePicPool (pParam);
+  return *ppPool != NULL ? ERR_NONE : ERR_MALLOC_FAILED;
+}
+
+void WelsDestroyPicturePool (SPicturePool* pPool) {
+  if (pPool != NULL)
+    ReleasePicPool (pPool);
+}
+
+int WelsGetPicturePoolStatistics (SPicturePool* pPool, SPicturePoolStatistics* pStats) {
+  if (NULL == pPool || NULL == pStats)
+    return ERR_INVALID_PARAMETERS;
+
+  GetPicPoolStatistics (pPool, pStats);
+  return ERR_NONE;
+}
 /* WINAPI is indeed in prefix due to sync to application layer callings!! */
 
 /*
@@ -858,3 +1402,14 @@ void WelsDestroyDecoder (ISVCDecoder* pDecoder) {
     delete (CWelsDecoder*)pDecoder;
   }
 }
+
+/*
+*   WelsDecodeBatch
+*   @return:    0 - success, the result of each access unit is in its item; otherwise failed.
+*/
+int WelsDecodeBatch (SDecodeBatchItem* pItems, int iItemNum, int iThreadNum) {
+  if ((NULL == pItems && iItemNum > 0) || iItemNum < 0)
+    return ERR_INVALID_PARAMETERS;
+
+  return CWelsDecoder::DecodeBatch (pItems, iItemNum, iThreadNum);
+}
@@ -17,8 +17,11 @@ DECODER_CPP_SRCS=\
 	$(DECODER_SRCDIR)/core/src/mv_pred.cpp\
 	$(DECODER_SRCDIR)/core/src/parse_mb_syn_cabac.cpp\
 	$(DECODER_SRCDIR)/core/src/parse_mb_syn_cavlc.cpp\
+	$(DECODER_SRCDIR)/core/src/pic_pool.cpp\
 	$(DECODER_SRCDIR)/core/src/pic_queue.cpp\
 	$(DECODER_SRCDIR)/core/src/rec_mb.cpp\
+	$(DECODER_SRCDIR)/core/src/wels_decoder_scheduler.cpp\
+	$(DECODER_SRCDIR)/core/src/wels_decoder_thread.cpp\
 	$(DECODER_SRCDIR)/plus/src/welsDecoderExt.cpp\
 
 DECODER_OBJS += $(DECODER_CPP_SRCS:.cpp=.$(OBJ))
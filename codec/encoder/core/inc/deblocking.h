@@ -77,6 +77,21 @@ void DeblockingBSCalcEnc_AArch64_neon (int8_t* pNzc, SMVUnitXY* pMv, int32_t iBo
 #endif//__cplusplus
 void DeblockingInit (DeblockingFunc*   pFunc,  int32_t iCpu);
 
+#define MAX_DEBLOCKING_BS_MB_NUM 64
+
+/*!
+ * \brief   compute the boundary strengths of the iMbNum inter MBs from pFirstMb on, all in one MB row.
+ *          They only depend on the coded MB data, so this is done in one pass before any of the MBs is filtered.
+ */
+void DeblockingBsCalcMbRow (SWelsFuncPtrList* pFunc, SMB* pFirstMb, SDeblockingFilter* pFilter, int32_t iMbNum,
+                            uint8_t uiBS[][2][4][4]);
+
+/*!
+ * \brief   deblock the iMbNum MBs from pFirstMb on, all in one MB row, with the boundary strengths computed by
+ *          DeblockingBsCalcMbRow() in batches. pFilter->pCsData[] point to the first MB and are moved behind the last one.
+ */
+void DeblockingMbRowAvcbase (SWelsFuncPtrList* pFunc, SMB* pFirstMb, SDeblockingFilter* pFilter, int32_t iMbNum);
+
 void WelsBlockFuncInit (PSetNoneZeroCountZeroFunc* pfSetNZCZero,  int32_t iCpu);
 
 void PerformDeblockingFilter (sWelsEncCtx* pEnc);
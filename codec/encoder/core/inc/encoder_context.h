@@ -63,6 +63,7 @@
 namespace WelsEnc {
 
 class IWelsTaskManage;
+class CWelsSliceWavefront;
 class IWelsReferenceStrategy;
 
 /*
@@ -138,6 +139,7 @@ typedef struct TagWelsEncCtx {
 
   SSliceThreading*  pSliceThreading;
   IWelsTaskManage*  pTaskManage; //was planning to put it under CWelsH264SVCEncoder but it may be updated (lock/no lock) when param is changed
+  CWelsSliceWavefront* pWavefront; // MB rows of a single slice decided by several threads, NULL unless iWavefrontThreadNum > 1
   IWelsReferenceStrategy* pReferenceStrategy;
 
   // pointers
@@ -95,6 +95,17 @@ void WelsUninitEncoderExt (sWelsEncCtx** ppCtx);
  */
 int32_t WelsEncoderEncodeExt (sWelsEncCtx*, SFrameBSInfo* pFbi, const SSourcePicture* kpSrcPic);
 
+/*!
+ * \brief   pipelined svc encoding: code the frame given to the former call while kpSrcPic is prepared
+ *
+ * \param   pCtx        sWelsEncCtx*, encoder context
+ * \param   pFbi        FrameBSInfo*, eFrameType is videoFrameTypeInvalid when no frame was pending
+ * \param   kpSrcPic    Source picture, NULL to code the pending frame only
+ * \return  as WelsEncoderEncodeExt()
+ */
+int32_t WelsEncoderEncodeAsync (sWelsEncCtx* pCtx, SFrameBSInfo* pFbi, const SSourcePicture* kpSrcPic);
+bool WelsEncoderHasPendingFrame (sWelsEncCtx* pCtx);
+
 int32_t WelsEncoderEncodeParameterSets (sWelsEncCtx* pCtx, void* pDst);
 
 /*
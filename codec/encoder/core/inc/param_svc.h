@@ -122,6 +122,7 @@ typedef struct TagWelsSvcCodingParam: SEncParamExt {
 
   int8_t   iDecompStages;          // GOP size dependency
   int32_t  iMaxNumRefFrame;
+  int32_t  iWavefrontThreadNum;    // threads deciding the modes of the MB rows of a slice, 1 unless bUseWavefront applies
 
  public:
   TagWelsSvcCodingParam() {
@@ -178,6 +179,8 @@ typedef struct TagWelsSvcCodingParam: SEncParamExt {
     param.iUsageType = CAMERA_VIDEO_REAL_TIME;
     param.uiMaxNalSize = 0;
     param.bIsLosslessLink = false;
+    param.bUseWavefront = false;
+    param.iHierarchicalMeLevels = 0;
     for (int32_t iLayer = 0; iLayer < MAX_SPATIAL_LAYER_NUM; iLayer++) {
       param.sSpatialLayers[iLayer].uiProfileIdc = PRO_UNKNOWN;
       param.sSpatialLayers[iLayer].uiLevelIdc = LEVEL_UNKNOWN;
@@ -225,6 +228,7 @@ typedef struct TagWelsSvcCodingParam: SEncParamExt {
     bDeblockingParallelFlag     = false;// deblocking filter parallelization control flag
 
     iDecompStages               = 0;    // GOP size dependency, unknown here and be revised later
+    iWavefrontThreadNum         = 1;
     iBitsVaryPercentage = 10;
   }
 
@@ -302,6 +306,8 @@ typedef struct TagWelsSvcCodingParam: SEncParamExt {
 
     iMultipleThreadIdc = pCodingParam.iMultipleThreadIdc;
     bUseLoadBalancing = pCodingParam.bUseLoadBalancing;
+    bUseWavefront = pCodingParam.bUseWavefront;
+    iHierarchicalMeLevels = pCodingParam.iHierarchicalMeLevels;
 
     /* Deblocking loop filter */
     iLoopFilterDisableIdc       = pCodingParam.iLoopFilterDisableIdc;      // 0: on, 1: off, 2: on except for slice boundaries,
@@ -0,0 +1,158 @@
+/*!
+ * \copy
+ *     Copyright (c)  2009-2015, Cisco Systems
+ *     All rights reserved.
+ *
+ *     Redistribution and use in source and binary forms, with or without
+ *     modification, are permitted provided that the following conditions
+ *     are met:
+ *
+ *        * Redistributions of source code must retain the above copyright
+ *          notice, this list of conditions and the following disclaimer.
+ *
+ *        * Redistributions in binary form must reproduce the above copyright
+ *          notice, this list of conditions and the following disclaimer in
+ *          the documentation and/or other materials provided with the
+ *          distribution.
+ *
+ *     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *     "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *     LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *     FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *     COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *     INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *     BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *     LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *     CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *     LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *     ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *     POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * \file    slice_wavefront.h
+ *
+ * \brief   wavefront coding of a single slice: the MB rows are mode decided and reconstructed
+ *          by several threads, each MB two MBs behind the row above it, while the entropy
+ *          coding follows in raster order
+ *
+ * \date    10/18/2026 Created
+ *
+ *************************************************************************************
+ */
+
+#ifndef WELS_SLICE_WAVEFRONT_H__
+#define WELS_SLICE_WAVEFRONT_H__
+
+#include "encoder_context.h"
+#include "md.h"
+#include "svc_enc_slice_segment.h"
+#include "WelsThreadLib.h"
+#include "WelsThreadPool.h"
+
+namespace WelsEnc {
+
+class CWelsWavefrontTask;
+
+/*
+ *  MB decided by a thread and not entropy coded yet
+ */
+typedef struct TagWavefrontMbSlot {
+  SMbCache      sMbCache;       // MB cache the MB was decided in, the entropy coding reads it afterwards
+  SMVUnitXY     sMvStartMin;    // search window of the MB, for a decision made again after a VLC overflow
+  SMVUnitXY     sMvStartMax;
+  int32_t       iCostLuma;
+  uint32_t      uiFMECostDown;  // change of uiSliceFMECostDown made by the MB
+  int32_t       iMbXY;          // MB decided in the slot, -1 for none
+  bool          bSrcSaved;
+  uint8_t*      pSrcMb;         // source of the MB before a background MB replaced it by its reference
+} SWavefrontMbSlot;
+
+/*
+ *  state of a thread deciding MB rows
+ */
+typedef struct TagWavefrontWorker {
+  SSlice        sSlice;         // copy of the slice, its MB cache is the one of the slot being decided
+  SWelsMD       sMd;
+} SWavefrontWorker;
+
+class CWelsSliceWavefront {
+ public:
+  CWelsSliceWavefront (sWelsEncCtx* pEncCtx);
+  ~CWelsSliceWavefront();
+
+  /*
+   *  kiMaxMbWidth/kiMaxMbHeight: MB size of the largest layer
+   */
+  int32_t Init (const int32_t kiThreadNum, const int32_t kiMaxMbWidth, const int32_t kiMaxMbHeight);
+
+  /*
+   *  whether the slice can be coded with CodeSlice(): one slice in the layer and a rate control
+   *  not feeding the bits of the MBs back to the QP of the next ones
+   */
+  bool IsApplicable (SSlice* pSlice);
+
+  /*
+   *  same as the MB loop of the serial slice coding, the slice header written before and the
+   *  slice end written after are left to the caller
+   */
+  int32_t CodeSlice (SSlice* pSlice, const bool kbIntraSlice);
+
+  void HelperExecute (const int32_t kiWorkerIdx);
+  void HelperEnded (CWelsWavefrontTask* pHelper);
+
+ private:
+  int32_t RunPass (const int32_t kiFirstMbXY);
+  void Work (const int32_t kiWorkerIdx);
+  void Wait();
+  void Signal();
+  bool IsMbDecided (const int32_t kiMbXY) const {
+    return m_pRowProgress[kiMbXY / m_iMbWidth] > (kiMbXY % m_iMbWidth);
+  }
+
+  void DecideMb (SWavefrontWorker* pWorker, const int32_t kiMbXY);
+  int32_t CodeMb (const int32_t kiMbXY, bool& bReencode);
+  int32_t WriteMb (SMB* pCurMb, const int32_t kiCostLuma, bool& bReencode);
+  int32_t ReencodeMb (const int32_t kiMbXY);
+  void SaveSrcMb (SWavefrontMbSlot* pSlot, const SMB* kpCurMb);
+  void RestoreSrcMb (SWavefrontMbSlot* pSlot, const SMB* kpCurMb);
+
+  sWelsEncCtx*                  m_pEncCtx;
+  WelsCommon::CWelsThreadPool*  m_pThreadPool;
+  CWelsWavefrontTask**          m_ppHelpers;
+  SWavefrontWorker*             m_pWorkers;
+  SWavefrontMbSlot*             m_pSlots;
+  int32_t*                      m_pRowProgress;         // MBs of each row decided
+  int32_t                       m_iThreadNum;
+  int32_t                       m_iSlotNum;
+  int32_t                       m_iMaxMbWidth;
+  int32_t                       m_iMaxMbHeight;
+
+  WELS_MUTEX                    m_hMutex;
+  WELS_COND                     m_hCond;
+  int32_t                       m_iWaiting;             // threads waiting for m_hCond
+  int32_t                       m_iRunning;             // threads in Work()
+
+  // slice being coded
+  SSlice*                       m_pSlice;
+  SSlice*                       m_pSliceCopy;           // the workers start from it
+  SWelsMD                       m_sMd;
+  SDynamicSlicingStack          m_sDss;
+  bool                          m_bIntraSlice;
+  bool                          m_bSaveSrc;
+  int32_t                       m_iMbWidth;
+  int32_t                       m_iMbHeight;
+  int32_t                       m_iTotalMbNum;
+
+  // pass from a first MB to the end of the slice or to the first VLC overflow
+  bool                          m_bPassOpen;
+  bool                          m_bStop;
+  bool                          m_bEntropyBusy;
+  int32_t                       m_iNextRow;             // next row for a thread to take
+  int32_t                       m_iEntropyMbXY;         // next MB to entropy code
+  int32_t                       m_iOverflowMbXY;        // MB to code again with a higher QP, -1 for none
+  int32_t                       m_iEncReturn;
+};
+
+}
+
+#endif//WELS_SLICE_WAVEFRONT_H__
@@ -68,6 +68,20 @@ uint8_t uiFMEGoodFrameCount;
 int32_t iHighFreMbCount;
 } SFeatureSearchPreparation; //maintain only one
 
+#define MAX_HME_LEVELS (2)
+
+/*
+ *  hierarchical ME: the source and the reference are downsampled by 2 at each level and searched from the
+ *  coarsest level to the finest, the motion found seeds the 16x16 search of each MB
+ */
+typedef struct TagHierarchicalMe {
+SPicture*       pEncLevel[MAX_HME_LEVELS];      // source at 1/2 and 1/4 of the layer size
+SPicture*       pRefLevel[MAX_HME_LEVELS];      // reference at 1/2 and 1/4 of the layer size
+SMVUnitXY*      pMbMv;                          // motion of each MB, in quarter pels of the layer size
+int32_t         iLevels;
+bool            bMbMvAvail;                     // pMbMv found for the layer being coded
+} SHierarchicalMe;
+
 typedef struct TagSliceBufferInfo {
 SSlice*                 pSliceBuffer;  // slice buffer for multi thread,
 int32_t                 iMaxSliceNum;
@@ -124,6 +138,7 @@ int32_t*                pCountMbNumInSlice;
 bool                    bNeedAdjustingSlicing;
 
 SFeatureSearchPreparation* pFeatureSearchPreparation;
+SHierarchicalMe*        pHierarchicalMe;
 
 SDqLayer*               pRefLayer;              // pointer to referencing dq_layer of current layer to be decoded
 };
@@ -44,6 +44,7 @@
 #include "as264_common.h"
 #include "svc_enc_macroblock.h"
 #include "mb_cache.h"
+#include "md.h"
 
 namespace WelsEnc {
 #if defined(MB_TYPES_CHECK)
@@ -57,6 +58,11 @@ void UpdateNonZeroCountCache (SMB* pMb, SMbCache* pMbCache);
 //for P SSlice (intra part + inter part, MB level)
 void OutputPMbWithoutConstructCsRsNoCopy (sWelsEncCtx* pEncCtx, SDqLayer* pDq, SSlice* pSlice, SMB* pMb);
 
+//QP raised for coding again a MB whose residual overflowed the CAVLC tables
+void UpdateQpForOverflow (SMB* pCurMb, uint8_t kuiChromaQpIndexOffset);
+void WelsInitInterMDStruc (const SMB* pCurMb, uint16_t* pMvdCostTable, const int32_t kiMvdInterTableStride,
+                           SWelsMD* pMd);
+
 void WelsSliceHeaderScalExtInit (SDqLayer* pCurLayer, SSlice* pSlice);
 void WelsSliceHeaderExtInit (sWelsEncCtx* pEncCtx, SDqLayer* pCurLayer, SSlice* pSlice);
 
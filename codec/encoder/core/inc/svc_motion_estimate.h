@@ -97,7 +97,7 @@ SMVUnitXY          sMv;
 } SWelsME;
 
 typedef struct TagFeatureSearchIn {
-PSampleSadSatdCostFunc pSad;
+PSample4SadRefCostFunc pSad4Ref;
 
 uint32_t* pTimesOfFeature;
 uint16_t** pQpelLocationOfFeature;
@@ -129,6 +129,17 @@ uint32_t uiBestSadCost;
 uint8_t* pBestRef;
 } SFeatureSearchOut;
 
+#define ME_MAX_CANDIDATES (16)
+/*
+ *  integer-pel MVs evaluated together by WelsMeCandidatesSearch()
+ */
+typedef struct TagMeCandidates {
+uint8_t*  pRef[ME_MAX_CANDIDATES];   // reference block of each MV
+SMVUnitXY sMv[ME_MAX_CANDIDATES];
+int32_t   iCost[ME_MAX_CANDIDATES];  // MVD cost when added, SAD + MVD cost once evaluated
+int32_t   iNum;
+} SMeCandidates;
+
 #define  COST_MVD(table, mx, my)  (table[mx] + table[my])
 extern const int32_t QStepx16ByQp[52];
 
@@ -185,8 +196,24 @@ bool WelsMotionEstimateInitialPoint (SWelsFuncPtrList* pFuncList, SWelsME* pMe,
 void WelsDiamondSearch (SWelsFuncPtrList* pFuncList, SWelsME* pMe, SSlice* pSlice, const int32_t kiEncStride,
                         const int32_t kiRefStride);
 
-bool WelsMeSadCostSelect (int32_t* pSadCost, const uint16_t* kpMvdCost, int32_t* pBestCost, const int32_t kiDx,
-                          const int32_t kiDy, int32_t* pIx, int32_t* pIy);
+/*!
+ * \brief  batched evaluation of candidate MVs
+ *
+ * the SADs of the candidates are computed four at a time by pSad4Ref and added to their MVD costs,
+ * the first candidate of the lowest cost is kept if that cost is lower than *pBestCost
+ *
+ * \param  kiStopCost  the scan of the costs stops at the first candidate kept with a cost below it
+ *
+ * \return  index of the candidate kept, -1 for none
+ */
+int32_t WelsMeCandidatesSearch (PSample4SadRefCostFunc pSad4Ref, uint8_t* pEnc, const int32_t kiEncStride,
+                                const int32_t kiRefStride, SMeCandidates* pCands,
+                                int32_t* pBestCost, const int32_t kiStopCost);
+/*!
+ * \brief  same as WelsMeCandidatesSearch() with SADs already computed in kpSad
+ */
+int32_t WelsMeCandidatesSelect (SMeCandidates* pCands, const int32_t* kpSad, int32_t* pBestCost,
+                                const int32_t kiStopCost);
 
 void CalculateSatdCost (PSampleSadSatdCostFunc pSatd, SWelsME* pMe, const int32_t kiEncStride, const int32_t kiRefStride);
 void NotCalculateSatdCost (PSampleSadSatdCostFunc pSatd, SWelsME* pMe, const int32_t kiEncStride,
@@ -227,6 +254,23 @@ void WelsMotionCrossSearch (SWelsFuncPtrList* pFuncList, SWelsME* pMe, SSlice* p
 void WelsDiamondCrossSearch (SWelsFuncPtrList* pFuncList, SWelsME* pMe, SSlice* pSlice,
                              const int32_t kiEncStride, const int32_t kiRefStride);
 
+// Hierarchical Search Basics
+#define HME_SEARCH_RANGE (4)  // exhaustive search around the zero MV at the coarsest level, in its pixels
+
+int32_t RequestHierarchicalMe (CMemoryAlign* pMa, const int32_t kiMbWidth, const int32_t kiMbHeight,
+                               const int32_t kiLevels, SHierarchicalMe* pHme);
+void ReleaseHierarchicalMe (CMemoryAlign* pMa, SHierarchicalMe* pHme);
+/*!
+ * \brief  coarse to fine motion search of the MBs over the downsampled pictures of pHme
+ *
+ * \param  kpMvdCost   MVD cost table of the layer QP, the costs are scaled down to the block size of each level
+ * \param  kiMvRange   integer-pel MV range of the layer
+ *
+ * \return  NONE, the motion of each MB is left in pHme->pMbMv
+ */
+void WelsHierarchicalMeSearch (SWelsFuncPtrList* pFuncList, SHierarchicalMe* pHme, const uint16_t* kpMvdCost,
+                               const int32_t kiMbWidth, const int32_t kiMbHeight, const int32_t kiMvRange);
+
 // Feature Search Basics
 #define LIST_SIZE_SUM_16x16 0x0FF01  //(256*255+1)
 #define LIST_SIZE_SUM_8x8     0x03FC1  //(64*255+1)
@@ -346,6 +390,15 @@ inline bool CheckMvInRange (const SMVUnitXY ksCurrentMv, const SMVUnitXY ksMinMv
 return (CheckInRangeCloseOpen (ksCurrentMv.iMvX, ksMinMv.iMvX, ksMaxMv.iMvX)
         && CheckInRangeCloseOpen (ksCurrentMv.iMvY, ksMinMv.iMvY, ksMaxMv.iMvY));
 }
+
+inline void WelsMeCandidatesAdd (SMeCandidates* pCands, const int32_t kiMvX, const int32_t kiMvY, uint8_t* pRef,
+                                 const int32_t kiMvdCost) {
+const int32_t kiIdx = pCands->iNum++;
+pCands->pRef[kiIdx] = pRef;
+pCands->sMv[kiIdx].iMvX = kiMvX;
+pCands->sMv[kiIdx].iMvY = kiMvY;
+pCands->iCost[kiIdx] = kiMvdCost;
+}
 //FME switch related
 inline bool CalcFMESwitchFlag (const uint8_t uiFMEGoodFrameCount, const int32_t iHighFreMbPrecentage,
                                const int32_t iAvgMbSAD, const bool bScrollingDetected) {
@@ -126,6 +126,7 @@ typedef void (*PInterMdFunc) (sWelsEncCtx* pEncCtx, SWelsMD* pWelsMd, SSlice* sl
 
 typedef int32_t (*PSampleSadSatdCostFunc) (uint8_t*, int32_t, uint8_t*, int32_t);
 typedef void (*PSample4SadCostFunc) (uint8_t*, int32_t, uint8_t*, int32_t, int32_t*);
+typedef void (*PSample4SadRefCostFunc) (uint8_t*, int32_t, uint8_t**, int32_t, int32_t*);
 typedef int32_t (*PIntraPred4x4Combined3Func) (uint8_t*, int32_t, uint8_t*, int32_t, uint8_t*, int32_t*, int32_t,
     int32_t, int32_t);
 typedef int32_t (*PIntraPred16x16Combined3Func) (uint8_t*, int32_t, uint8_t*, int32_t, int32_t*, int32_t, uint8_t*);
@@ -163,6 +164,7 @@ typedef struct TagSampleDealingFunc {
   PSampleSadSatdCostFunc            pfSampleSad[MAX_BLOCK_TYPE];
   PSampleSadSatdCostFunc            pfSampleSatd[MAX_BLOCK_TYPE];
   PSample4SadCostFunc                 pfSample4Sad[MAX_BLOCK_TYPE];
+  PSample4SadRefCostFunc              pfSample4SadRef[MAX_BLOCK_TYPE]; // SADs against four arbitrary positions
   PIntraPred4x4Combined3Func      pfIntra4x4Combined3Satd;
   PIntraPred16x16Combined3Func  pfIntra16x16Combined3Satd;
   PIntraPred16x16Combined3Func  pfIntra16x16Combined3Sad;
@@ -49,10 +49,12 @@
 #include "wels_const.h"
 #include "IWelsVP.h"
 #include "param_svc.h"
+#include "WelsThreadPool.h"
 
 namespace WelsEnc {
 
 typedef struct TagWelsEncCtx sWelsEncCtx;
+class CWelsPrepareTask;
 
 typedef  struct {
   SPicture*     pScaledInputPicture;
@@ -142,6 +144,25 @@ class CWelsPreProcess {
   void UpdateSrcListLosslessScreenRefSelectionWithLtr (SPicture* pCurPicture, const int32_t kiCurDid,
       const int32_t kuiMarkLongTermPicIdx, SPicture** pLongRefList);
 
+  /*
+   *  pipelined encoding, see ISVCEncoder::EncodeFrameAsync(): a frame is copied, denoised and downsampled into
+   *  pictures aside of the spatial lists, ahead on a thread of the pool while the former frame is coded, then its
+   *  planes are exchanged with the current pictures right before it is coded
+   */
+  bool    HasPreparedSpatialPictures() const {
+    return m_bPicPrepared;
+  }
+  int32_t PrepareSpatialPictures (sWelsEncCtx* pCtx, const SSourcePicture* kpSrcPic);
+  bool    PrepareSpatialPicturesAhead (sWelsEncCtx* pCtx, const SSourcePicture* kpSrcPic);
+  bool    WaitPreparedSpatialPictures();
+  void    UsePreparedSpatialPictures (sWelsEncCtx* pCtx, SSourcePicture* pSrcPic);
+  void    DropPreparedSpatialPictures();
+
+  /*
+   *  hierarchical ME: pSrc downsampled by 2 into ppLevel[0], which is downsampled by 2 into ppLevel[1] and so on
+   */
+  void    BuildMePyramid (SPicture* pSrc, SPicture** ppLevel, const int32_t kiLevels);
+
 
  protected:
   bool GetSceneChangeFlag (ESceneChangeIdc eSceneChangeIdc);
@@ -158,12 +179,16 @@ class CWelsPreProcess {
 
  private:
   int32_t SingleLayerPreprocess (sWelsEncCtx* pEncCtx, const SSourcePicture* kpSrc, Scaled_Picture* m_sScaledPicture);
+  void    PrepareLayerPictures (IWelsVP* pInterfaceVp, SWelsSvcCodingParam* pSvcParam, const SSourcePicture* kpSrc,
+                                SPicture* pScaledInputPic, SPicture** ppDstPic);
+  int32_t AllocPreparedPictures (sWelsEncCtx* pCtx);
+  void    FreePreparedPictures (CMemoryAlign* pMa);
 
-  void  BilateralDenoising (SPicture* pSrc, const int32_t iWidth, const int32_t iHeight);
+  void  BilateralDenoising (IWelsVP* pInterfaceVp, SPicture* pSrc, const int32_t iWidth, const int32_t iHeight);
 
-  int32_t DownsamplePadding (SPicture* pSrc, SPicture* pDstPic,  int32_t iSrcWidth, int32_t iSrcHeight,
-                             int32_t iShrinkWidth, int32_t iShrinkHeight, int32_t iTargetWidth, int32_t iTargetHeight,
-                             bool bForceCopy);
+  int32_t DownsamplePadding (IWelsVP* pInterfaceVp, SPicture* pSrc, SPicture* pDstPic,  int32_t iSrcWidth,
+                             int32_t iSrcHeight, int32_t iShrinkWidth, int32_t iShrinkHeight, int32_t iTargetWidth,
+                             int32_t iTargetHeight, bool bForceCopy);
 
   void    VaaCalculation (SVAAFrameInfo* pVaaInfo, SPicture* pCurPicture, SPicture* pRefPicture, bool bCalculateSQDiff,
                           bool bCalculateVar, bool bCalculateBGD);
@@ -199,6 +224,17 @@ class CWelsPreProcess {
   SPicture*        m_pLastSpatialPicture[MAX_DEPENDENCY_LAYER][2];
   bool             m_bInitDone;
   uint8_t          m_uiSpatialPicNum[MAX_DEPENDENCY_LAYER];
+
+  /* pipelined encoding: the prepared frame and what prepares it on the thread pool */
+  friend class CWelsPrepareTask;
+  IWelsVP*         m_pPrepareVp;
+  SPicture*        m_pPreparedScaledInput;
+  SPicture*        m_pPreparedPic[MAX_DEPENDENCY_LAYER];
+  SSourcePicture   m_sPreparedSrcPic;   // description of the prepared frame, its planes are not kept
+  bool             m_bPicPrepared;      // m_pPreparedPic hold a frame to code
+  bool             m_bUsePreparedPic;   // the current pictures hold it, BuildSpatialPicList() does not copy the input
+  WelsCommon::CWelsThreadPool* m_pThreadPool;
+  CWelsPrepareTask* m_pPrepareTask;
  protected:
   /* For Downsampling & VAA I420 based source pictures */
   SPicture*        m_pSpatialPic[MAX_DEPENDENCY_LAYER][MAX_REF_PIC_COUNT + 1];
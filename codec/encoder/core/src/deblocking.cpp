@@ -625,10 +625,8 @@ void DeblockingBSCalc_c (SWelsFuncPtrList* pFunc, SMB* pCurMb, uint8_t uiBS[2][4
   }
 }
 
-void DeblockingMbAvcbase (SWelsFuncPtrList* pFunc, SMB* pCurMb, SDeblockingFilter* pFilter) {
-  uint8_t uiBS[2][4][4] = {{{ 0 }}};
-
-  Mb_Type uiCurMbType = pCurMb->uiMbType;
+static inline void DeblockingBsAvailable (SMB* pCurMb, SDeblockingFilter* pFilter, int32_t* pLeftFlag,
+    int32_t* pTopFlag) {
   int32_t iMbStride  = pFilter->iMbStride;
 
   int32_t iMbX = pCurMb->iMbX;
@@ -637,24 +635,49 @@ void DeblockingMbAvcbase (SWelsFuncPtrList* pFunc, SMB* pCurMb, SDeblockingFilte
   bool bLeftBsValid[2] = { (iMbX > 0), ((iMbX > 0)&& (pCurMb->uiSliceIdc == (pCurMb - 1)->uiSliceIdc))};
   bool bTopBsValid[2]  = { (iMbY > 0), ((iMbY > 0)&& (pCurMb->uiSliceIdc == (pCurMb - iMbStride)->uiSliceIdc))};
 
-  int32_t iLeftFlag = bLeftBsValid[pFilter->uiFilterIdc];
-  int32_t iTopFlag  = bTopBsValid[pFilter->uiFilterIdc];
+  *pLeftFlag = bLeftBsValid[pFilter->uiFilterIdc];
+  *pTopFlag  = bTopBsValid[pFilter->uiFilterIdc];
+}
 
-  switch (uiCurMbType) {
-  case MB_TYPE_INTRA4x4:
-  case MB_TYPE_INTRA16x16:
-  case MB_TYPE_INTRA_PCM:
-    DeblockingIntraMb (&pFunc->pfDeblocking, pCurMb, pFilter);
-    break;
-  default:
-    pFunc->pfDeblocking.pfDeblockingBSCalc (pFunc, pCurMb, uiBS, uiCurMbType, iMbStride, iLeftFlag, iTopFlag);
-    DeblockingInterMb (&pFunc->pfDeblocking, pCurMb, pFilter, uiBS);
-    break;
+void DeblockingBsCalcMbRow (SWelsFuncPtrList* pFunc, SMB* pFirstMb, SDeblockingFilter* pFilter, int32_t iMbNum,
+                            uint8_t uiBS[][2][4][4]) {
+  int32_t iLeftFlag, iTopFlag;
+
+  for (int32_t i = 0; i < iMbNum; ++i) {
+    SMB* pCurMb = pFirstMb + i;
+    if (IS_INTRA (pCurMb->uiMbType))
+      continue;
+    DeblockingBsAvailable (pCurMb, pFilter, &iLeftFlag, &iTopFlag);
+    pFunc->pfDeblocking.pfDeblockingBSCalc (pFunc, pCurMb, uiBS[i], pCurMb->uiMbType, pFilter->iMbStride, iLeftFlag,
+                                            iTopFlag);
+  }
+}
+
+void DeblockingMbRowAvcbase (SWelsFuncPtrList* pFunc, SMB* pFirstMb, SDeblockingFilter* pFilter, int32_t iMbNum) {
+  uint8_t uiBS[MAX_DEBLOCKING_BS_MB_NUM][2][4][4];
+
+  while (iMbNum > 0) {
+    const int32_t kiBatchNum = WELS_MIN (iMbNum, MAX_DEBLOCKING_BS_MB_NUM);
+    memset (uiBS, 0, kiBatchNum * sizeof (uiBS[0]));
+    DeblockingBsCalcMbRow (pFunc, pFirstMb, pFilter, kiBatchNum, uiBS);
+
+    for (int32_t i = 0; i < kiBatchNum; ++i) {
+      SMB* pCurMb = pFirstMb + i;
+      if (IS_INTRA (pCurMb->uiMbType))
+        DeblockingIntraMb (&pFunc->pfDeblocking, pCurMb, pFilter);
+      else
+        DeblockingInterMb (&pFunc->pfDeblocking, pCurMb, pFilter, uiBS[i]);
+      pFilter->pCsData[0] += MB_WIDTH_LUMA;
+      pFilter->pCsData[1] += MB_WIDTH_CHROMA;
+      pFilter->pCsData[2] += MB_WIDTH_CHROMA;
+    }
+    pFirstMb += kiBatchNum;
+    iMbNum -= kiBatchNum;
   }
 }
 
 void  DeblockingFilterFrameAvcbase (SDqLayer* pCurDq, SWelsFuncPtrList* pFunc) {
-  int32_t i, j;
+  int32_t j;
   const int32_t kiMbWidth   = pCurDq->iMbWidth;
   const int32_t kiMbHeight  = pCurDq->iMbHeight;
   SMB* pCurrentMbBlock      = pCurDq->sMbDataP;
@@ -680,13 +703,8 @@ void  DeblockingFilterFrameAvcbase (SDqLayer* pCurDq, SWelsFuncPtrList* pFunc) {
     pFilter.pCsData[0] = pCurDq->pDecPic->pData[0] + ((j * pFilter.iCsStride[0]) << 4);
     pFilter.pCsData[1] = pCurDq->pDecPic->pData[1] + ((j * pFilter.iCsStride[1]) << 3);
     pFilter.pCsData[2] = pCurDq->pDecPic->pData[2] + ((j * pFilter.iCsStride[2]) << 3);
-    for (i = 0; i < kiMbWidth; i++) {
-      DeblockingMbAvcbase (pFunc, pCurrentMbBlock, &pFilter);
-      ++pCurrentMbBlock;
-      pFilter.pCsData[0] += MB_WIDTH_LUMA;
-      pFilter.pCsData[1] += MB_WIDTH_CHROMA;
-      pFilter.pCsData[2] += MB_WIDTH_CHROMA;
-    }
+    DeblockingMbRowAvcbase (pFunc, pCurrentMbBlock, &pFilter, kiMbWidth);
+    pCurrentMbBlock += kiMbWidth;
   }
 }
 
@@ -727,10 +745,17 @@ void DeblockingFilterSliceAvcbase (SDqLayer* pCurDq, SWelsFuncPtrList* pFunc, SS
     pFilter.pCsData[2] = pCurDq->pDecPic->pData[2] + ((pCurrentMbBlock->iMbX + pCurrentMbBlock->iMbY * pFilter.iCsStride[2])
                          << 3);
 
-    DeblockingMbAvcbase (pFunc, pCurrentMbBlock, &pFilter);
-
-    ++iNumMbFiltered;
+    // the MBs of a slice follow in raster order, filter them up to the end of the MB row at once
+    int32_t iMbNum = 1;
     iNextMbIdx = WelsGetNextMbOfSlice (pCurDq, iCurMbIdx);
+    while (iNextMbIdx == iCurMbIdx + iMbNum && iNextMbIdx < kiTotalNumMb && (iNextMbIdx % kiMbWidth) != 0
+           && iNumMbFiltered + iMbNum < kiTotalNumMb) {
+      ++iMbNum;
+      iNextMbIdx = WelsGetNextMbOfSlice (pCurDq, iNextMbIdx);
+    }
+    DeblockingMbRowAvcbase (pFunc, pCurrentMbBlock, &pFilter, iMbNum);
+
+    iNumMbFiltered += iMbNum;
     //whether all of MB in current slice filtered or not
     if (iNextMbIdx == -1 || iNextMbIdx >= kiTotalNumMb || iNumMbFiltered >= kiTotalNumMb) {
       break;
@@ -805,6 +830,14 @@ void  DeblockingInit (DeblockingFunc*   pFunc,  int32_t iCpu) {
     pFunc->pfChromaDeblockingLT4Hor = DeblockChromaLt4H_ssse3;
     pFunc->pfChromaDeblockingEQ4Hor = DeblockChromaEq4H_ssse3;
   }
+#if defined(HAVE_AVX2)
+  if (iCpu & WELS_CPU_AVX2) {
+    pFunc->pfLumaDeblockingLT4Ver   = DeblockLumaLt4V_avx2;
+    pFunc->pfLumaDeblockingEQ4Ver   = DeblockLumaEq4V_avx2;
+    pFunc->pfLumaDeblockingLT4Hor   = DeblockLumaLt4H_avx2;
+    pFunc->pfLumaDeblockingEQ4Hor   = DeblockLumaEq4H_avx2;
+  }
+#endif
 #endif
 
 #if defined(HAVE_NEON)
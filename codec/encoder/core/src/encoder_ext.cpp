@@ -53,6 +53,7 @@
 #include "ls_defines.h"
 #include "crt_util_safe_x.h" // Safe CRT routines like utils for cross platforms
 #include "slice_multi_threading.h"
+#include "slice_wavefront.h"
 #include "measure_time.h"
 #include "svc_set_mb_syn.h"
 
@@ -322,6 +323,13 @@ int32_t ParamValidation (SLogContext* pLogCtx, SWelsSvcCodingParam* pCfg) {
     return ENC_RETURN_UNSUPPORTED_PARA;
   }
 
+  if (!CheckInRangeCloseOpen (pCfg->iHierarchicalMeLevels, 0, MAX_HME_LEVELS + 1)) {
+    WelsLog (pLogCtx, WELS_LOG_WARNING,
+             "ParamValidation(), iHierarchicalMeLevels(%d) out of range [0, %d], auto clipped",
+             pCfg->iHierarchicalMeLevels, MAX_HME_LEVELS);
+    pCfg->iHierarchicalMeLevels = WELS_CLIP3 (pCfg->iHierarchicalMeLevels, 0, MAX_HME_LEVELS);
+  }
+
   for (i = 0; i < pCfg->iSpatialLayerNum; ++ i) {
     SSpatialLayerInternal* fDlp = &pCfg->sDependencyLayers[i];
     SSpatialLayerConfig* pConfig = &pCfg->sSpatialLayers[i];
@@ -976,6 +984,12 @@ void FreeDqLayer (SDqLayer*& pDq, CMemoryAlign* pMa) {
     pDq->pFeatureSearchPreparation = NULL;
   }
 
+  if (pDq->pHierarchicalMe) {
+    ReleaseHierarchicalMe (pMa, pDq->pHierarchicalMe);
+    pMa->WelsFree (pDq->pHierarchicalMe, "pHierarchicalMe");
+    pDq->pHierarchicalMe = NULL;
+  }
+
   UninitSlicePEncCtx (pDq, pMa);
   pDq->iMaxSliceNum = 0;
 
@@ -1134,6 +1148,17 @@ static inline int32_t InitDqLayers (sWelsEncCtx** ppCtx, SExistingParasetList* p
       pDqLayer->pFeatureSearchPreparation = NULL;
     }
 
+    if (pParam->iHierarchicalMeLevels > 0) {
+      pDqLayer->pHierarchicalMe = static_cast<SHierarchicalMe*> (pMa->WelsMallocz (sizeof (SHierarchicalMe),
+                                  "pHierarchicalMe"));
+      WELS_VERIFY_RETURN_IF (1, NULL == pDqLayer->pHierarchicalMe)
+      int32_t iReturn = RequestHierarchicalMe (pMa, kiMbW, kiMbH, pParam->iHierarchicalMeLevels,
+                        pDqLayer->pHierarchicalMe);
+      WELS_VERIFY_RETURN_IF (1, ENC_RETURN_SUCCESS != iReturn)
+    } else {
+      pDqLayer->pHierarchicalMe = NULL;
+    }
+
     (*ppCtx)->ppDqLayerList[iDlayerIndex] = pDqLayer;
 
     ++ iDlayerIndex;
@@ -1651,6 +1676,14 @@ int32_t RequestMemorySvc (sWelsEncCtx** ppCtx, SExistingParasetList* pExistingPa
     WelsLog (& (*ppCtx)->sLogCtx, WELS_LOG_WARNING, "RequestMemorySvc(), RequestMtResource failed!");
     return 1;
   }
+  if (pParam->iWavefrontThreadNum > 1) {
+    (*ppCtx)->pWavefront = WELS_NEW_OP (CWelsSliceWavefront ((*ppCtx)), CWelsSliceWavefront);
+    WELS_VERIFY_RETURN_IF (1, (NULL == (*ppCtx)->pWavefront))
+    if ((*ppCtx)->pWavefront->Init (pParam->iWavefrontThreadNum, (15 + iMaxPicWidth) >> 4, (15 + iMaxPicHeight) >> 4)) {
+      WelsLog (& (*ppCtx)->sLogCtx, WELS_LOG_WARNING, "RequestMemorySvc(), CWelsSliceWavefront::Init failed!");
+      return 1;
+    }
+  }
 
   (*ppCtx)->pReferenceStrategy = IWelsReferenceStrategy::CreateReferenceStrategy ((*ppCtx), pParam->iUsageType,
                                  pParam->bEnableLongTermReference);
@@ -1838,6 +1871,7 @@ void FreeMemorySvc (sWelsEncCtx** ppCtx) {
 
     if (pParam != NULL && pParam->iMultipleThreadIdc > 1)
       ReleaseMtResource (ppCtx);
+    WELS_DELETE_OP (pCtx->pWavefront);
 
     if (NULL != pCtx->pReferenceStrategy) {
       WELS_DELETE_OP (pCtx->pReferenceStrategy);
@@ -2228,6 +2262,9 @@ int32_t GetMultipleThreadIdc (SLogContext* pLogCtx, SWelsSvcCodingParam* pCoding
     WelsLog (pLogCtx, WELS_LOG_ERROR, "GetMultipleThreadIdc(), InitSliceSettings failed.");
     return 1;
   }
+  // with a single slice the threads requested are left to the wavefront mode decision of its MB rows
+  pCodingParam->iWavefrontThreadNum = (pCodingParam->bUseWavefront && 1 == pCodingParam->iMultipleThreadIdc) ? uiCpuCores :
+                                      1;
   return 0;
 }
 
@@ -2655,6 +2692,26 @@ bool SetMeMethod (const uint8_t uiMethod, PSearchMethodFunc& pSearchMethodFunc)
 
 
 
+/*!
+ * \brief   coarse motion search of the MBs of a P layer over its downsampled source and reference, the 16x16
+ *          search of each MB is then seeded with the motion found
+ */
+static void HierarchicalMotionEstimate (sWelsEncCtx* pCtx) {
+  SDqLayer* pCurLayer = pCtx->pCurDqLayer;
+  SHierarchicalMe* pHme = pCurLayer->pHierarchicalMe;
+
+  pHme->bMbMvAvail = false;
+  if (P_SLICE != pCtx->eSliceType || NULL == pCurLayer->pRefPic)
+    return;
+
+  pCtx->pVpp->BuildMePyramid (pCtx->pEncPic, pHme->pEncLevel, pHme->iLevels);
+  pCtx->pVpp->BuildMePyramid (pCurLayer->pRefPic, pHme->pRefLevel, pHme->iLevels);
+  WelsHierarchicalMeSearch (pCtx->pFuncList, pHme,
+                            &pCtx->pMvdCostTable[pCtx->iMvdCostTableSize + pCtx->iGlobalQp * pCtx->iMvdCostTableStride],
+                            pCurLayer->iMbWidth, pCurLayer->iMbHeight, pCtx->iMvRange);
+  pHme->bMbMvAvail = true;
+}
+
 void PreprocessSliceCoding (sWelsEncCtx* pCtx) {
   SDqLayer* pCurLayer           = pCtx->pCurDqLayer;
   //const bool kbBaseAvail      = pCurLayer->bBaseLayerAvailableFlag;
@@ -3654,6 +3711,8 @@ int32_t WelsEncoderEncodeExt (sWelsEncCtx* pCtx, SFrameBSInfo* pFbi, const SSour
     PrefetchReferencePicture (pCtx, eFrameType); // update reference picture for current pDq layer
     pCtx->pFuncList->pfRc.pfWelsRcPictureInit (pCtx, pFbi->uiTimeStamp);
     PreprocessSliceCoding (pCtx); // MUST be called after pfWelsRcPictureInit() and WelsInitCurrentLayer()
+    if (pCtx->pCurDqLayer->pHierarchicalMe != NULL)
+      HierarchicalMotionEstimate (pCtx);
 
     //TODO Complexity Calculation here for screen content
     iLayerSize = 0;
@@ -4149,6 +4208,47 @@ int32_t WelsEncoderEncodeExt (sWelsEncCtx* pCtx, SFrameBSInfo* pFbi, const SSour
   return ENC_RETURN_SUCCESS;
 }
 
+/*!
+ * \brief   pipelined svc encoding, see ISVCEncoder::EncodeFrameAsync(): the frame given to the former call is coded
+ *          while kpSrcPic is prepared (copied, denoised, downsampled) on the thread pool
+ *
+ * \pParam  pCtx            sWelsEncCtx*, encoder context
+ * \pParam  pFbi            FrameBSInfo*, eFrameType is videoFrameTypeInvalid when no frame was pending
+ * \pParam  kpSrcPic        Source Picture, NULL to code the pending frame only
+ * \return  as WelsEncoderEncodeExt()
+ */
+int32_t WelsEncoderEncodeAsync (sWelsEncCtx* pCtx, SFrameBSInfo* pFbi, const SSourcePicture* kpSrcPic) {
+  if (pCtx == NULL) {
+    return ENC_RETURN_MEMALLOCERR;
+  }
+  CWelsPreProcess* pVpp = pCtx->pVpp;
+  int32_t iRet          = ENC_RETURN_SUCCESS;
+  bool bAhead           = false;
+
+  pFbi->eFrameType = videoFrameTypeInvalid;
+  pFbi->iLayerNum = 0;
+  if (pVpp->HasPreparedSpatialPictures()) {
+    SSourcePicture sSrcPic;
+    pVpp->UsePreparedSpatialPictures (pCtx, &sSrcPic);
+    if (kpSrcPic != NULL)
+      bAhead = pVpp->PrepareSpatialPicturesAhead (pCtx, kpSrcPic);
+    iRet = WelsEncoderEncodeExt (pCtx, pFbi, &sSrcPic);
+    if (bAhead)
+      bAhead = pVpp->WaitPreparedSpatialPictures();
+    if ((iRet == ENC_RETURN_MEMALLOCERR) || (iRet == ENC_RETURN_MEMOVERFLOWFOUND) || (iRet == ENC_RETURN_VLCOVERFLOWFOUND))
+      return iRet;
+  }
+  if (kpSrcPic != NULL && !bAhead && pVpp->PrepareSpatialPictures (pCtx, kpSrcPic) != 0) {
+    WelsLog (& (pCtx->sLogCtx), WELS_LOG_ERROR, "Failed in allocating memory in PrepareSpatialPictures");
+    return ENC_RETURN_MEMALLOCERR;
+  }
+  return iRet;
+}
+
+bool WelsEncoderHasPendingFrame (sWelsEncCtx* pCtx) {
+  return pCtx != NULL && pCtx->pVpp != NULL && pCtx->pVpp->HasPreparedSpatialPictures();
+}
+
 /*!
  * \brief   Wels SVC encoder parameters adjustment
  *          SVC adjustment results in new requirement in memory blocks adjustment
@@ -4196,8 +4296,10 @@ int32_t WelsEncoderParamAdjust (sWelsEncCtx** ppCtx, SWelsSvcCodingParam* pNewPa
                (pOldParam->bEnableLongTermReference != pNewParam->bEnableLongTermReference) ||
                (pOldParam->iLTRRefNum != pNewParam->iLTRRefNum) ||
                (pOldParam->iMultipleThreadIdc != pNewParam->iMultipleThreadIdc) ||
+               (pOldParam->iWavefrontThreadNum != pNewParam->iWavefrontThreadNum) ||
                (pOldParam->bEnableBackgroundDetection != pNewParam->bEnableBackgroundDetection) ||
                (pOldParam->bEnableAdaptiveQuant != pNewParam->bEnableAdaptiveQuant) ||
+               (pOldParam->iHierarchicalMeLevels != pNewParam->iHierarchicalMeLevels) ||
                (pOldParam->eSpsPpsIdStrategy != pNewParam->eSpsPpsIdStrategy);
   if ((pNewParam->iMaxNumRefFrame > pOldParam->iMaxNumRefFrame) ||
       ((pOldParam->iMaxNumRefFrame == 1) && (pOldParam->iTemporalLayerNum == 1) && (pNewParam->iTemporalLayerNum == 2))) {
@@ -4214,10 +4316,11 @@ int32_t WelsEncoderParamAdjust (sWelsEncCtx** ppCtx, SWelsSvcCodingParam* pNewPa
              pOldParam->SUsedPicRect.iHeight, pNewParam->SUsedPicRect.iHeight);
 
     WelsLog (& (*ppCtx)->sLogCtx, WELS_LOG_INFO,
-             "WelsEncoderParamAdjust(),bEnableLongTermReference(%d,%d),iLTRRefNum(%d,%d),iMultipleThreadIdc(%d,%d),bEnableBackgroundDetection(%d,%d),bEnableAdaptiveQuant(%d,%d),eSpsPpsIdStrategy(%d,%d),iMaxNumRefFrame(%d,%d),iTemporalLayerNum(%d,%d)",
+             "WelsEncoderParamAdjust(),bEnableLongTermReference(%d,%d),iLTRRefNum(%d,%d),iMultipleThreadIdc(%d,%d),iWavefrontThreadNum(%d,%d),bEnableBackgroundDetection(%d,%d),bEnableAdaptiveQuant(%d,%d),eSpsPpsIdStrategy(%d,%d),iMaxNumRefFrame(%d,%d),iTemporalLayerNum(%d,%d)",
              pOldParam->bEnableLongTermReference, pNewParam->bEnableLongTermReference,
              pOldParam->iLTRRefNum, pNewParam->iLTRRefNum,
              pOldParam->iMultipleThreadIdc, pNewParam->iMultipleThreadIdc,
+             pOldParam->iWavefrontThreadNum, pNewParam->iWavefrontThreadNum,
              pOldParam->bEnableBackgroundDetection, pNewParam->bEnableBackgroundDetection,
              pOldParam->bEnableAdaptiveQuant, pNewParam->bEnableAdaptiveQuant,
              pOldParam->eSpsPpsIdStrategy, pNewParam->eSpsPpsIdStrategy,
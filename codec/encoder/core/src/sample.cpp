@@ -360,6 +360,14 @@ void WelsInitSampleSadFunc (SWelsFuncPtrList* pFuncList, uint32_t uiCpuFlag) {
   pFuncList->sSampleDealingFuncs.pfSample4Sad[BLOCK_8x4] = WelsSampleSadFour8x4_c;
   pFuncList->sSampleDealingFuncs.pfSample4Sad[BLOCK_4x8] = WelsSampleSadFour4x8_c;
 
+  pFuncList->sSampleDealingFuncs.pfSample4SadRef[BLOCK_16x16] = WelsSampleSadFourRef16x16_c;
+  pFuncList->sSampleDealingFuncs.pfSample4SadRef[BLOCK_16x8] = WelsSampleSadFourRef16x8_c;
+  pFuncList->sSampleDealingFuncs.pfSample4SadRef[BLOCK_8x16] = WelsSampleSadFourRef8x16_c;
+  pFuncList->sSampleDealingFuncs.pfSample4SadRef[BLOCK_8x8] = WelsSampleSadFourRef8x8_c;
+  pFuncList->sSampleDealingFuncs.pfSample4SadRef[BLOCK_4x4] = WelsSampleSadFourRef4x4_c;
+  pFuncList->sSampleDealingFuncs.pfSample4SadRef[BLOCK_8x4] = WelsSampleSadFourRef8x4_c;
+  pFuncList->sSampleDealingFuncs.pfSample4SadRef[BLOCK_4x8] = WelsSampleSadFourRef4x8_c;
+
   pFuncList->sSampleDealingFuncs.pfIntra4x4Combined3Satd   = NULL;
   pFuncList->sSampleDealingFuncs.pfIntra8x8Combined3Satd   = NULL;
   pFuncList->sSampleDealingFuncs.pfIntra8x8Combined3Sad    = NULL;
@@ -383,6 +391,11 @@ void WelsInitSampleSadFunc (SWelsFuncPtrList* pFuncList, uint32_t uiCpuFlag) {
     pFuncList->sSampleDealingFuncs.pfSample4Sad[BLOCK_8x8] = WelsSampleSadFour8x8_sse2;
     pFuncList->sSampleDealingFuncs.pfSample4Sad[BLOCK_4x4] = WelsSampleSadFour4x4_sse2;
 
+    pFuncList->sSampleDealingFuncs.pfSample4SadRef[BLOCK_16x16] = WelsSampleSadFourRef16x16_sse2;
+    pFuncList->sSampleDealingFuncs.pfSample4SadRef[BLOCK_16x8] = WelsSampleSadFourRef16x8_sse2;
+    pFuncList->sSampleDealingFuncs.pfSample4SadRef[BLOCK_8x16] = WelsSampleSadFourRef8x16_sse2;
+    pFuncList->sSampleDealingFuncs.pfSample4SadRef[BLOCK_8x8] = WelsSampleSadFourRef8x8_sse2;
+
     pFuncList->sSampleDealingFuncs.pfSampleSatd[BLOCK_4x4  ] = WelsSampleSatd4x4_sse2;
     pFuncList->sSampleDealingFuncs.pfSampleSatd[BLOCK_8x8  ] = WelsSampleSatd8x8_sse2;
     pFuncList->sSampleDealingFuncs.pfSampleSatd[BLOCK_8x16 ] = WelsSampleSatd8x16_sse2;
@@ -410,6 +423,11 @@ void WelsInitSampleSadFunc (SWelsFuncPtrList* pFuncList, uint32_t uiCpuFlag) {
     pFuncList->sSampleDealingFuncs.pfSampleSatd[BLOCK_16x8]  = WelsSampleSatd16x8_avx2;
     pFuncList->sSampleDealingFuncs.pfSampleSatd[BLOCK_8x16]  = WelsSampleSatd8x16_avx2;
     pFuncList->sSampleDealingFuncs.pfSampleSatd[BLOCK_8x8]   = WelsSampleSatd8x8_avx2;
+
+    pFuncList->sSampleDealingFuncs.pfSample4Sad[BLOCK_16x16]    = WelsSampleSadFour16x16_avx2;
+    pFuncList->sSampleDealingFuncs.pfSample4Sad[BLOCK_16x8]     = WelsSampleSadFour16x8_avx2;
+    pFuncList->sSampleDealingFuncs.pfSample4SadRef[BLOCK_16x16] = WelsSampleSadFourRef16x16_avx2;
+    pFuncList->sSampleDealingFuncs.pfSample4SadRef[BLOCK_16x8]  = WelsSampleSadFourRef16x8_avx2;
   }
 #endif
 #endif //(X86_ASM)
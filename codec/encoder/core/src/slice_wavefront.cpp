@@ -0,0 +1,614 @@
+/*!
+ * \copy
+ *     Copyright (c)  2009-2015, Cisco Systems
+ *     All rights reserved.
+ *
+ *     Redistribution and use in source and binary forms, with or without
+ *     modification, are permitted provided that the following conditions
+ *     are met:
+ *
+ *        * Redistributions of source code must retain the above copyright
+ *          notice, this list of conditions and the following disclaimer.
+ *
+ *        * Redistributions in binary form must reproduce the above copyright
+ *          notice, this list of conditions and the following disclaimer in
+ *          the documentation and/or other materials provided with the
+ *          distribution.
+ *
+ *     THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *     "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *     LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *     FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *     COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *     INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *     BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *     LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *     CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *     LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *     ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *     POSSIBILITY OF SUCH DAMAGE.
+ *
+ *
+ * \file    slice_wavefront.cpp
+ *
+ * \brief   wavefront coding of a single slice
+ *
+ * \date    10/18/2026 Created
+ *
+ *************************************************************************************
+ */
+
+#include "slice_wavefront.h"
+#include "ls_defines.h"
+#include "svc_encode_slice.h"
+#include "svc_enc_golomb.h"
+#include "svc_base_layer_md.h"
+#include "svc_set_mb_syn.h"
+#include "svc_mode_decision.h"
+
+namespace WelsEnc {
+
+/*
+ *  runs the MB row decisions of CWelsSliceWavefront on a thread of the pool, the queued flag is guarded by the
+ *  mutex of the wavefront
+ */
+class CWelsWavefrontTask : public WelsCommon::IWelsTask, public WelsCommon::IWelsTaskSink {
+ public:
+  CWelsWavefrontTask (CWelsSliceWavefront* pWavefront, const int32_t kiWorkerIdx)
+    : IWelsTask (this), m_pWavefront (pWavefront), m_kiWorkerIdx (kiWorkerIdx), m_bQueued (false) {
+  }
+  virtual ~CWelsWavefrontTask() { }
+
+  virtual int Execute() {
+    m_pWavefront->HelperExecute (m_kiWorkerIdx);
+    return 0;
+  }
+  virtual int OnTaskExecuted() {
+    m_pWavefront->HelperEnded (this);
+    return 0;
+  }
+  virtual int OnTaskCancelled() {
+    m_pWavefront->HelperEnded (this);
+    return 0;
+  }
+
+  bool IsQueued() const {
+    return m_bQueued;
+  }
+  void SetQueued (const bool kbQueued) {
+    m_bQueued = kbQueued;
+  }
+
+ private:
+  CWelsSliceWavefront*  m_pWavefront;
+  const int32_t         m_kiWorkerIdx;
+  bool                  m_bQueued;
+};
+
+CWelsSliceWavefront::CWelsSliceWavefront (sWelsEncCtx* pEncCtx)
+  : m_pEncCtx (pEncCtx),
+    m_pThreadPool (NULL),
+    m_ppHelpers (NULL),
+    m_pWorkers (NULL),
+    m_pSlots (NULL),
+    m_pRowProgress (NULL),
+    m_iThreadNum (0),
+    m_iSlotNum (0),
+    m_iMaxMbWidth (0),
+    m_iMaxMbHeight (0),
+    m_iWaiting (0),
+    m_iRunning (0),
+    m_pSlice (NULL),
+    m_pSliceCopy (NULL),
+    m_bIntraSlice (false),
+    m_bSaveSrc (false),
+    m_iMbWidth (0),
+    m_iMbHeight (0),
+    m_iTotalMbNum (0),
+    m_bPassOpen (false),
+    m_bStop (false),
+    m_bEntropyBusy (false),
+    m_iNextRow (0),
+    m_iEntropyMbXY (0),
+    m_iOverflowMbXY (-1),
+    m_iEncReturn (ENC_RETURN_SUCCESS) {
+  memset (&m_sMd, 0, sizeof (m_sMd));
+  memset (&m_sDss, 0, sizeof (m_sDss));
+  WelsMutexInit (&m_hMutex);
+  WelsCondInit (&m_hCond);
+}
+
+CWelsSliceWavefront::~CWelsSliceWavefront() {
+  CMemoryAlign* pMa = m_pEncCtx->pMemAlign;
+
+  if (NULL != m_ppHelpers) {
+    // a helper queued for a former pass may not have run yet
+    WelsMutexLock (&m_hMutex);
+    for (int32_t i = 1; i < m_iThreadNum; ++ i) {
+      while (NULL != m_ppHelpers[i] && m_ppHelpers[i]->IsQueued())
+        Wait();
+    }
+    WelsMutexUnlock (&m_hMutex);
+    for (int32_t i = 1; i < m_iThreadNum; ++ i) {
+      WELS_DELETE_OP (m_ppHelpers[i]);
+    }
+    pMa->WelsFree (m_ppHelpers, "m_ppHelpers");
+    m_ppHelpers = NULL;
+  }
+  if (NULL != m_pThreadPool) {
+    m_pThreadPool->RemoveInstance();
+    m_pThreadPool = NULL;
+  }
+
+  if (NULL != m_pSlots) {
+    for (int32_t i = 0; i < m_iSlotNum; ++ i) {
+      FreeMbCache (&m_pSlots[i].sMbCache, pMa);
+      if (NULL != m_pSlots[i].pSrcMb)
+        pMa->WelsFree (m_pSlots[i].pSrcMb, "pSrcMb");
+    }
+    pMa->WelsFree (m_pSlots, "m_pSlots");
+    m_pSlots = NULL;
+  }
+  if (NULL != m_pWorkers) {
+    pMa->WelsFree (m_pWorkers, "m_pWorkers");
+    m_pWorkers = NULL;
+  }
+  if (NULL != m_pSliceCopy) {
+    pMa->WelsFree (m_pSliceCopy, "m_pSliceCopy");
+    m_pSliceCopy = NULL;
+  }
+  if (NULL != m_pRowProgress) {
+    pMa->WelsFree (m_pRowProgress, "m_pRowProgress");
+    m_pRowProgress = NULL;
+  }
+
+  WelsCondDestroy (&m_hCond);
+  WelsMutexDestroy (&m_hMutex);
+}
+
+int32_t CWelsSliceWavefront::Init (const int32_t kiThreadNum, const int32_t kiMaxMbWidth,
+                                   const int32_t kiMaxMbHeight) {
+  CMemoryAlign* pMa = m_pEncCtx->pMemAlign;
+
+  m_iThreadNum   = WELS_CLIP3 (kiThreadNum, 1, MAX_THREADS_NUM);
+  m_iMaxMbWidth  = kiMaxMbWidth;
+  m_iMaxMbHeight = kiMaxMbHeight;
+  // each thread works on its own row, so the decided MBs waiting for the entropy coding span one row more
+  m_iSlotNum     = kiMaxMbWidth * (m_iThreadNum + 1);
+
+  m_pRowProgress = (int32_t*)pMa->WelsMallocz (kiMaxMbHeight * sizeof (int32_t), "m_pRowProgress");
+  WELS_VERIFY_RETURN_IF (ENC_RETURN_MEMALLOCERR, NULL == m_pRowProgress)
+  m_pSliceCopy = (SSlice*)pMa->WelsMallocz (sizeof (SSlice), "m_pSliceCopy");
+  WELS_VERIFY_RETURN_IF (ENC_RETURN_MEMALLOCERR, NULL == m_pSliceCopy)
+  m_pWorkers = (SWavefrontWorker*)pMa->WelsMallocz (m_iThreadNum * sizeof (SWavefrontWorker), "m_pWorkers");
+  WELS_VERIFY_RETURN_IF (ENC_RETURN_MEMALLOCERR, NULL == m_pWorkers)
+  m_pSlots = (SWavefrontMbSlot*)pMa->WelsMallocz (m_iSlotNum * sizeof (SWavefrontMbSlot), "m_pSlots");
+  WELS_VERIFY_RETURN_IF (ENC_RETURN_MEMALLOCERR, NULL == m_pSlots)
+  for (int32_t i = 0; i < m_iSlotNum; ++ i) {
+    m_pSlots[i].iMbXY = -1;
+    WELS_VERIFY_RETURN_IF (ENC_RETURN_MEMALLOCERR, AllocMbCacheAligned (&m_pSlots[i].sMbCache, pMa))
+    m_pSlots[i].pSrcMb = (uint8_t*)pMa->WelsMallocz (384 * sizeof (uint8_t), "pSrcMb");
+    WELS_VERIFY_RETURN_IF (ENC_RETURN_MEMALLOCERR, NULL == m_pSlots[i].pSrcMb)
+  }
+
+  if (m_iThreadNum > 1) {
+    // the calling thread decides rows too. The pool is shared with the rest of the process and keeps the size it
+    // has, helpers not started by the end of a pass find it closed and return
+    m_pThreadPool = WelsCommon::CWelsThreadPool::AddReference();
+    WELS_VERIFY_RETURN_IF (ENC_RETURN_MEMALLOCERR, NULL == m_pThreadPool)
+
+    m_ppHelpers = (CWelsWavefrontTask**)pMa->WelsMallocz (m_iThreadNum * sizeof (CWelsWavefrontTask*), "m_ppHelpers");
+    WELS_VERIFY_RETURN_IF (ENC_RETURN_MEMALLOCERR, NULL == m_ppHelpers)
+    for (int32_t i = 1; i < m_iThreadNum; ++ i) {
+      m_ppHelpers[i] = WELS_NEW_OP (CWelsWavefrontTask (this, i), CWelsWavefrontTask);
+      WELS_VERIFY_RETURN_IF (ENC_RETURN_MEMALLOCERR, NULL == m_ppHelpers[i])
+    }
+  }
+  return ENC_RETURN_SUCCESS;
+}
+
+bool CWelsSliceWavefront::IsApplicable (SSlice* pSlice) {
+  const SWelsSvcCodingParam* kpParam = m_pEncCtx->pSvcParam;
+  const SDqLayer* kpCurLayer = m_pEncCtx->pCurDqLayer;
+
+  // the other modes take the QP of a MB from the bits of the MBs coded before it
+  if (RC_OFF_MODE != kpParam->iRCMode && RC_BUFFERBASED_MODE != kpParam->iRCMode)
+    return false;
+
+  return (1 == kpCurLayer->sSliceEncCtx.iSliceNumInFrame)
+         && (0 == pSlice->sSliceHeaderExt.sSliceHeader.iFirstMbInSlice)
+         && (kpCurLayer->iMbHeight > 1)
+         && (kpCurLayer->iMbWidth <= m_iMaxMbWidth)
+         && (kpCurLayer->iMbHeight <= m_iMaxMbHeight);
+}
+
+int32_t CWelsSliceWavefront::CodeSlice (SSlice* pSlice, const bool kbIntraSlice) {
+  sWelsEncCtx* pEncCtx  = m_pEncCtx;
+  SDqLayer* pCurLayer   = pEncCtx->pCurDqLayer;
+  const bool kbCabac    = (0 != pEncCtx->pSvcParam->iEntropyCodingModeFlag);
+  int32_t iFirstMbXY    = 0;
+  int32_t iEncReturn    = ENC_RETURN_SUCCESS;
+  SMbCache sSliceMbCache;
+
+  m_pSlice      = pSlice;
+  m_bIntraSlice = kbIntraSlice;
+  m_iMbWidth    = pCurLayer->iMbWidth;
+  m_iMbHeight   = pCurLayer->iMbHeight;
+  m_iTotalMbNum = m_iMbWidth * m_iMbHeight;
+
+  // same as WelsCodePSlice() and WelsPSliceMdEnc()
+  memset (&m_sMd, 0, sizeof (m_sMd));
+  if (!kbIntraSlice) {
+    const bool kbBaseAvail = pCurLayer->bBaseLayerAvailableFlag;
+    const bool kbHighestSpatial = pEncCtx->pSvcParam->iSpatialLayerNum ==
+                                  (pCurLayer->sLayerInfo.sNalHeaderExt.uiDependencyId + 1);
+    if (kbBaseAvail && kbHighestSpatial) {
+      pEncCtx->pFuncList->pfInterMd = WelsMdInterMbEnhancelayer;
+    } else {
+      pEncCtx->pFuncList->pfInterMd = WelsMdInterMb;
+    }
+    m_sMd.uiRef       = pSlice->sSliceHeaderExt.sSliceHeader.uiRefIndex;
+    m_sMd.bMdUsingSad = (pEncCtx->pSvcParam->iComplexityMode == LOW_COMPLEXITY);
+    pSlice->iMbSkipRun = 0;
+  }
+  if (kbCabac)
+    WelsInitSliceCabac (pEncCtx, pSlice);
+  m_sDss.pRestoreBuffer = NULL;
+  m_sDss.iStartPos = m_sDss.iCurrentPos = 0;
+
+  // a background MB takes the pixels of the reference as its source, these are put back for a MB decided again
+  m_bSaveSrc = !kbIntraSlice && !kbCabac && (NULL != pEncCtx->pVaa->pCurY)
+               && (pEncCtx->pFuncList->pfInterMdBackgroundDecision == WelsMdInterJudgeBGDPskip);
+
+  memcpy (&sSliceMbCache, &pSlice->sMbCacheInfo, sizeof (SMbCache));
+  memcpy (m_pSliceCopy, pSlice, sizeof (SSlice));
+  for (int32_t i = 0; i < m_iSlotNum; ++ i) {
+    m_pSlots[i].iMbXY = -1;
+    m_pSlots[i].bSrcSaved = false;
+  }
+
+  // a MB overflowing the CAVLC tables is coded again with a higher QP, the MBs after it are then decided again
+  while (iFirstMbXY < m_iTotalMbNum) {
+    iEncReturn = RunPass (iFirstMbXY);
+    if (ENC_RETURN_SUCCESS != iEncReturn || m_iOverflowMbXY < 0)
+      break;
+    iEncReturn = ReencodeMb (m_iOverflowMbXY);
+    if (ENC_RETURN_SUCCESS != iEncReturn)
+      break;
+    iFirstMbXY = m_iOverflowMbXY + 1;
+  }
+  memcpy (&pSlice->sMbCacheInfo, &sSliceMbCache, sizeof (SMbCache));
+  if (ENC_RETURN_SUCCESS != iEncReturn)
+    return iEncReturn;
+
+  if (!kbIntraSlice && pSlice->iMbSkipRun) {
+    BsWriteUE (pSlice->pSliceBsa, pSlice->iMbSkipRun);
+  }
+  return ENC_RETURN_SUCCESS;
+}
+
+void CWelsSliceWavefront::HelperExecute (const int32_t kiWorkerIdx) {
+  WelsMutexLock (&m_hMutex);
+  if (m_bPassOpen)
+    Work (kiWorkerIdx);
+  WelsMutexUnlock (&m_hMutex);
+}
+
+void CWelsSliceWavefront::HelperEnded (CWelsWavefrontTask* pHelper) {
+  WelsMutexLock (&m_hMutex);
+  pHelper->SetQueued (false);
+  Signal();
+  WelsMutexUnlock (&m_hMutex);
+}
+
+void CWelsSliceWavefront::Wait() {
+  ++ m_iWaiting;
+  WelsCondWait (&m_hCond, &m_hMutex);
+  -- m_iWaiting;
+}
+
+void CWelsSliceWavefront::Signal() {
+  if (m_iWaiting > 0)
+    WelsCondBroadcast (&m_hCond);
+}
+
+int32_t CWelsSliceWavefront::RunPass (const int32_t kiFirstMbXY) {
+  const int32_t kiFirstRow = kiFirstMbXY / m_iMbWidth;
+  CWelsWavefrontTask* pQueue[MAX_THREADS_NUM];
+  int32_t iQueueNum = 0;
+
+  WelsMutexLock (&m_hMutex);
+  for (int32_t iRow = 0; iRow < m_iMbHeight; ++ iRow) {
+    if (iRow < kiFirstRow)
+      m_pRowProgress[iRow] = m_iMbWidth;
+    else if (iRow == kiFirstRow)
+      m_pRowProgress[iRow] = kiFirstMbXY % m_iMbWidth;
+    else
+      m_pRowProgress[iRow] = 0;
+  }
+  m_iNextRow      = kiFirstRow;
+  m_iEntropyMbXY  = kiFirstMbXY;
+  m_iOverflowMbXY = -1;
+  m_iEncReturn    = ENC_RETURN_SUCCESS;
+  m_bStop         = false;
+  m_bEntropyBusy  = false;
+  m_bPassOpen     = true;
+  for (int32_t i = 1; i < m_iThreadNum; ++ i) {
+    if (!m_ppHelpers[i]->IsQueued()) {
+      m_ppHelpers[i]->SetQueued (true);
+      pQueue[iQueueNum++] = m_ppHelpers[i];
+    }
+  }
+  WelsMutexUnlock (&m_hMutex);
+
+  // not under the lock: queuing may wait for a thread of the pool still leaving HelperEnded()
+  for (int32_t i = 0; i < iQueueNum; ++ i) {
+    if (WELS_THREAD_ERROR_OK != m_pThreadPool->QueueTask (pQueue[i])) {
+      WelsMutexLock (&m_hMutex);
+      pQueue[i]->SetQueued (false);
+      WelsMutexUnlock (&m_hMutex);
+    }
+  }
+
+  WelsMutexLock (&m_hMutex);
+  Work (0);
+  // a helper not started yet finds the pass closed and returns
+  m_bPassOpen = false;
+  while (m_iRunning > 0)
+    Wait();
+  WelsMutexUnlock (&m_hMutex);
+
+  return m_iEncReturn;
+}
+
+/*
+ *  called with m_hMutex locked: codes the decided MBs in raster order when no other thread does, otherwise decides the
+ *  next MB of the row taken, which needs the MB right above and right of it decided
+ */
+void CWelsSliceWavefront::Work (const int32_t kiWorkerIdx) {
+  SWavefrontWorker* pWorker = &m_pWorkers[kiWorkerIdx];
+  int32_t iRow = -1;
+  int32_t iCol = 0;
+
+  ++ m_iRunning;
+  memcpy (&pWorker->sSlice, m_pSliceCopy, sizeof (SSlice));
+  memcpy (&pWorker->sMd, &m_sMd, sizeof (SWelsMD));
+
+  while (!m_bStop && m_iEntropyMbXY < m_iTotalMbNum) {
+    if (!m_bEntropyBusy && IsMbDecided (m_iEntropyMbXY)) {
+      int32_t iMbXY = m_iEntropyMbXY;
+      int32_t iEndMbXY = iMbXY + 1;
+      int32_t iEncReturn = ENC_RETURN_SUCCESS;
+      bool bReencode = false;
+
+      while (iEndMbXY < m_iTotalMbNum && IsMbDecided (iEndMbXY))
+        ++ iEndMbXY;
+      m_bEntropyBusy = true;
+      WelsMutexUnlock (&m_hMutex);
+      for (; iMbXY < iEndMbXY; ++ iMbXY) {
+        iEncReturn = CodeMb (iMbXY, bReencode);
+        if (ENC_RETURN_SUCCESS != iEncReturn || bReencode)
+          break;
+      }
+      WelsMutexLock (&m_hMutex);
+      m_bEntropyBusy = false;
+      if (ENC_RETURN_SUCCESS != iEncReturn) {
+        m_iEncReturn = iEncReturn;
+        m_bStop = true;
+      } else if (bReencode) {
+        m_iOverflowMbXY = iMbXY;
+        m_bStop = true;
+      } else {
+        m_iEntropyMbXY = iEndMbXY;
+      }
+      Signal();
+      continue;
+    }
+
+    if (iRow < 0 && m_iNextRow < m_iMbHeight) {
+      iRow = m_iNextRow ++;
+      iCol = m_pRowProgress[iRow];
+    }
+    if (iRow >= 0
+        && (0 == iRow || m_pRowProgress[iRow - 1] >= WELS_MIN (iCol + 2, m_iMbWidth))
+        && (iRow * m_iMbWidth + iCol < m_iEntropyMbXY + m_iSlotNum)) {
+      WelsMutexUnlock (&m_hMutex);
+      DecideMb (pWorker, iRow * m_iMbWidth + iCol);
+      WelsMutexLock (&m_hMutex);
+      m_pRowProgress[iRow] = ++ iCol;
+      if (iCol == m_iMbWidth)
+        iRow = -1;
+      Signal();
+      continue;
+    }
+
+    Wait();
+  }
+
+  -- m_iRunning;
+  Signal();
+}
+
+void CWelsSliceWavefront::SaveSrcMb (SWavefrontMbSlot* pSlot, const SMB* kpCurMb) {
+  SVAAFrameInfo* pVaa           = m_pEncCtx->pVaa;
+  SWelsFuncPtrList* pFunc       = m_pEncCtx->pFuncList;
+  const int32_t kiPicStride     = pVaa->iPicStride;
+  const int32_t kiPicStrideUV   = pVaa->iPicStrideUV;
+  const int32_t kiOffsetY       = (kpCurMb->iMbY * kiPicStride + kpCurMb->iMbX) << 4;
+  const int32_t kiOffsetUV      = (kpCurMb->iMbY * kiPicStrideUV + kpCurMb->iMbX) << 3;
+
+  pFunc->pfCopy16x16Aligned (pSlot->pSrcMb, 16, pVaa->pCurY + kiOffsetY, kiPicStride);
+  pFunc->pfCopy8x8Aligned (pSlot->pSrcMb + 256, 8, pVaa->pCurU + kiOffsetUV, kiPicStrideUV);
+  pFunc->pfCopy8x8Aligned (pSlot->pSrcMb + 320, 8, pVaa->pCurV + kiOffsetUV, kiPicStrideUV);
+  pSlot->bSrcSaved = true;
+}
+
+void CWelsSliceWavefront::RestoreSrcMb (SWavefrontMbSlot* pSlot, const SMB* kpCurMb) {
+  SVAAFrameInfo* pVaa           = m_pEncCtx->pVaa;
+  SWelsFuncPtrList* pFunc       = m_pEncCtx->pFuncList;
+  const int32_t kiPicStride     = pVaa->iPicStride;
+  const int32_t kiPicStrideUV   = pVaa->iPicStrideUV;
+  const int32_t kiOffsetY       = (kpCurMb->iMbY * kiPicStride + kpCurMb->iMbX) << 4;
+  const int32_t kiOffsetUV      = (kpCurMb->iMbY * kiPicStrideUV + kpCurMb->iMbX) << 3;
+
+  pFunc->pfCopy16x16Aligned (pVaa->pCurY + kiOffsetY, kiPicStride, pSlot->pSrcMb, 16);
+  pFunc->pfCopy8x8Aligned (pVaa->pCurU + kiOffsetUV, kiPicStrideUV, pSlot->pSrcMb + 256, 8);
+  pFunc->pfCopy8x8Aligned (pVaa->pCurV + kiOffsetUV, kiPicStrideUV, pSlot->pSrcMb + 320, 8);
+  pSlot->bSrcSaved = false;
+}
+
+/*
+ *  mode decision and reconstruction of a MB, as in the MB loops of WelsISliceMdEnc() and WelsMdInterMbLoop(), in the
+ *  MB cache of its slot
+ */
+void CWelsSliceWavefront::DecideMb (SWavefrontWorker* pWorker, const int32_t kiMbXY) {
+  sWelsEncCtx* pEncCtx          = m_pEncCtx;
+  SDqLayer* pCurLayer           = pEncCtx->pCurDqLayer;
+  SSlice* pSlice                = &pWorker->sSlice;
+  SMbCache* pMbCache            = &pSlice->sMbCacheInfo;
+  SWelsMD* pMd                  = &pWorker->sMd;
+  SWavefrontMbSlot* pSlot       = &m_pSlots[kiMbXY % m_iSlotNum];
+  SMB* pCurMb                   = &pCurLayer->sMbDataP[kiMbXY];
+  const uint32_t kuiFMECostDown = pSlice->uiSliceFMECostDown;
+
+  memcpy (pMbCache, &pSlot->sMbCache, sizeof (SMbCache));
+  pSlot->iMbXY = kiMbXY;
+  pSlot->bSrcSaved = false;
+  if (m_bSaveSrc)
+    SaveSrcMb (pSlot, pCurMb);
+
+  pEncCtx->pFuncList->pfRc.pfWelsRcMbInit (pEncCtx, pCurMb, pSlice);
+  // the pointers of the cache are located from the MB position, the cache of the slot was not used for the MB left
+  WelsMdIntraInit (pEncCtx, pCurMb, pMbCache, kiMbXY);
+  if (m_bIntraSlice) {
+    pMd->iLambda = g_kiQpCostTable[pCurMb->uiLumaQp];
+    WelsMdIntraMb (pEncCtx, pMd, pCurMb, pMbCache);
+    UpdateNonZeroCountCache (pCurMb, pMbCache);
+  } else {
+    WelsMdInterInit (pEncCtx, pSlice, pCurMb, kiMbXY);
+    WelsInitInterMDStruc (pCurMb, &pEncCtx->pMvdCostTable[pEncCtx->iMvdCostTableSize], pEncCtx->iMvdCostTableStride,
+                          pMd);
+    pEncCtx->pFuncList->pfInterMd (pEncCtx, pMd, pSlice, pCurMb, pMbCache);
+    WelsMdInterSaveSadAndRefMbType ((pCurLayer->pDecPic->uiRefMbType), pMbCache, pCurMb, pMd);
+    pEncCtx->pFuncList->pfMdBackgroundInfoUpdate (pCurLayer, pCurMb, pMbCache->bCollocatedPredFlag,
+        pEncCtx->pRefPic->iPictureType);
+    UpdateNonZeroCountCache (pCurMb, pMbCache);
+    // the rows below predict from the reconstruction, the entropy coding does not change the residual
+    OutputPMbWithoutConstructCsRsNoCopy (pEncCtx, pCurLayer, pSlice, pCurMb);
+  }
+
+  memcpy (&pSlot->sMbCache, pMbCache, sizeof (SMbCache));
+  pSlot->sMvStartMin  = pSlice->sMvStartMin;
+  pSlot->sMvStartMax  = pSlice->sMvStartMax;
+  pSlot->iCostLuma    = pMd->iCostLuma;
+  pSlot->uiFMECostDown = pSlice->uiSliceFMECostDown - kuiFMECostDown;
+}
+
+/*
+ *  entropy coding of a decided MB, in raster order
+ */
+int32_t CWelsSliceWavefront::CodeMb (const int32_t kiMbXY, bool& bReencode) {
+  sWelsEncCtx* pEncCtx          = m_pEncCtx;
+  SDqLayer* pCurLayer           = pEncCtx->pCurDqLayer;
+  SSlice* pSlice                = m_pSlice;
+  SMbCache* pMbCache            = &pSlice->sMbCacheInfo;
+  SWavefrontMbSlot* pSlot       = &m_pSlots[kiMbXY % m_iSlotNum];
+  SMB* pCurMb                   = &pCurLayer->sMbDataP[kiMbXY];
+
+  memcpy (pMbCache, &pSlot->sMbCache, sizeof (SMbCache));
+  pSlice->uiSliceFMECostDown += pSlot->uiFMECostDown;
+  if (!m_bIntraSlice && IS_SKIP (pCurMb->uiMbType)) {
+    // a P skip MB takes the QP of the MB coded before it, unknown when it was decided
+    pCurMb->uiLumaQp   = pSlice->uiLastMbQp;
+    pCurMb->uiChromaQp = g_kuiChromaQpTable[CLIP3_QP_0_51 (pCurMb->uiLumaQp +
+                                                          pCurLayer->sLayerInfo.pPpsP->uiChromaQpIndexOffset)];
+    pEncCtx->pFuncList->pfMdBackgroundInfoUpdate (pCurLayer, pCurMb, pMbCache->bCollocatedPredFlag,
+        pEncCtx->pRefPic->iPictureType);
+  }
+  return WriteMb (pCurMb, pSlot->iCostLuma, bReencode);
+}
+
+int32_t CWelsSliceWavefront::WriteMb (SMB* pCurMb, const int32_t kiCostLuma, bool& bReencode) {
+  sWelsEncCtx* pEncCtx          = m_pEncCtx;
+  SDqLayer* pCurLayer           = pEncCtx->pCurDqLayer;
+  SSlice* pSlice                = m_pSlice;
+  const bool kbCavlc            = (0 == pEncCtx->pSvcParam->iEntropyCodingModeFlag);
+  int32_t iEncReturn            = ENC_RETURN_SUCCESS;
+
+  bReencode = false;
+  if (kbCavlc)
+    pEncCtx->pFuncList->pfStashMBStatus (&m_sDss, pSlice, m_bIntraSlice ? 0 : pSlice->iMbSkipRun);
+  iEncReturn = pEncCtx->pFuncList->pfWelsSpatialWriteMbSyn (pEncCtx, pSlice, pCurMb);
+  if (kbCavlc && (iEncReturn == ENC_RETURN_VLCOVERFLOWFOUND) && (pCurMb->uiLumaQp < 50)) {
+    const int32_t kiMbSkipRun = pEncCtx->pFuncList->pfStashPopMBStatus (&m_sDss, pSlice);
+    if (!m_bIntraSlice)
+      pSlice->iMbSkipRun = kiMbSkipRun;
+    bReencode = true;
+    return ENC_RETURN_SUCCESS;
+  }
+  if (ENC_RETURN_SUCCESS != iEncReturn)
+    return iEncReturn;
+
+  pCurMb->uiSliceIdc = pSlice->iSliceIdx;
+#if defined(MB_TYPES_CHECK)
+  WelsCountMbType (pEncCtx->sPerInfo.iMbCount, m_bIntraSlice ? I_SLICE : P_SLICE, pCurMb);
+#endif//MB_TYPES_CHECK
+  if (m_bIntraSlice)
+    pEncCtx->pFuncList->pfMdBackgroundInfoUpdate (pCurLayer, pCurMb, pSlice->sMbCacheInfo.bCollocatedPredFlag, I_SLICE);
+  pEncCtx->pFuncList->pfRc.pfWelsRcMbInfoUpdate (pEncCtx, pCurMb, kiCostLuma, pSlice);
+  return ENC_RETURN_SUCCESS;
+}
+
+/*
+ *  codes again kiMbXY with a higher QP until its residual fits, as the serial MB loops do, the pass of the MBs after
+ *  it being stopped
+ */
+int32_t CWelsSliceWavefront::ReencodeMb (const int32_t kiMbXY) {
+  sWelsEncCtx* pEncCtx          = m_pEncCtx;
+  SDqLayer* pCurLayer           = pEncCtx->pCurDqLayer;
+  SSlice* pSlice                = m_pSlice;
+  SMbCache* pMbCache            = &pSlice->sMbCacheInfo;
+  SMB* pCurMb                   = &pCurLayer->sMbDataP[kiMbXY];
+  SWavefrontMbSlot* pSlot       = &m_pSlots[kiMbXY % m_iSlotNum];
+  const uint8_t kuiChromaQpIndexOffset = pCurLayer->sLayerInfo.pPpsP->uiChromaQpIndexOffset;
+  int32_t iEncReturn            = ENC_RETURN_SUCCESS;
+  bool bReencode                = true;
+  SWelsMD sMd;
+
+  for (int32_t i = 0; i < m_iSlotNum; ++ i) {
+    if (m_pSlots[i].iMbXY > kiMbXY) {
+      if (m_pSlots[i].bSrcSaved)
+        RestoreSrcMb (&m_pSlots[i], &pCurLayer->sMbDataP[m_pSlots[i].iMbXY]);
+      m_pSlots[i].iMbXY = -1;
+    }
+  }
+
+  // the cache of the MB is the one CodeMb() left in the slice
+  memcpy (&sMd, &m_sMd, sizeof (SWelsMD));
+  pSlice->sMvStartMin = pSlot->sMvStartMin;
+  pSlice->sMvStartMax = pSlot->sMvStartMax;
+  while (bReencode) {
+    UpdateQpForOverflow (pCurMb, kuiChromaQpIndexOffset);
+    if (m_bIntraSlice) {
+      sMd.iLambda = g_kiQpCostTable[pCurMb->uiLumaQp];
+      WelsMdIntraMb (pEncCtx, &sMd, pCurMb, pMbCache);
+    } else {
+      WelsInitInterMDStruc (pCurMb, &pEncCtx->pMvdCostTable[pEncCtx->iMvdCostTableSize], pEncCtx->iMvdCostTableStride,
+                            &sMd);
+      pEncCtx->pFuncList->pfInterMd (pEncCtx, &sMd, pSlice, pCurMb, pMbCache);
+      WelsMdInterSaveSadAndRefMbType ((pCurLayer->pDecPic->uiRefMbType), pMbCache, pCurMb, &sMd);
+      pEncCtx->pFuncList->pfMdBackgroundInfoUpdate (pCurLayer, pCurMb, pMbCache->bCollocatedPredFlag,
+          pEncCtx->pRefPic->iPictureType);
+    }
+    UpdateNonZeroCountCache (pCurMb, pMbCache);
+
+    iEncReturn = WriteMb (pCurMb, sMd.iCostLuma, bReencode);
+    if (ENC_RETURN_SUCCESS != iEncReturn)
+      return iEncReturn;
+  }
+  if (!m_bIntraSlice)
+    OutputPMbWithoutConstructCsRsNoCopy (pEncCtx, pCurLayer, pSlice, pCurMb);
+  return ENC_RETURN_SUCCESS;
+}
+
+}
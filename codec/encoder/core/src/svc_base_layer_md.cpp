@@ -1011,6 +1011,11 @@ int32_t WelsMdP16x16 (SWelsFuncPtrList* pFunc, SDqLayer* pCurLayer, SWelsMD* pWe
       ++ pSlice->uiMvcNum;
     }
   }
+  //coarse motion of the downsampled pictures
+  const SHierarchicalMe* kpHme = pCurLayer->pHierarchicalMe;
+  if (kpHme != NULL && kpHme->bMbMvAvail) {
+    pSlice->sMvc[pSlice->uiMvcNum++] = kpHme->pMbMv[pCurMb->iMbXY];
+  }
 
   PredMv (&pMbCache->sMvComponents, 0, 4, 0, & (pMe16x16->sMvp));
   pFunc->pfMotionSearch[0] (pFunc, pCurLayer, pMe16x16, pSlice);
@@ -46,6 +46,7 @@
 #include "svc_set_mb_syn.h"
 #include "decode_mb_aux.h"
 #include "svc_mode_decision.h"
+#include "slice_wavefront.h"
 
 namespace WelsEnc {
 //#define ENC_TRACE
@@ -1653,7 +1654,11 @@ int32_t WelsCodeOneSlice (sWelsEncCtx* pEncCtx, SSlice* pCurSlice, const int32_t
 
   pCurSlice->uiLastMbQp = pCurLayer->sLayerInfo.pPpsP->iPicInitQp + pCurSlice->sSliceHeaderExt.sSliceHeader.iSliceQpDelta;
 
-  int32_t iEncReturn = g_pWelsSliceCoding[pNalHeadExt->bIdrFlag][kiDynamicSliceFlag] (pEncCtx, pCurSlice);
+  int32_t iEncReturn = ENC_RETURN_SUCCESS;
+  if (NULL != pEncCtx->pWavefront && !kiDynamicSliceFlag && pEncCtx->pWavefront->IsApplicable (pCurSlice))
+    iEncReturn = pEncCtx->pWavefront->CodeSlice (pCurSlice, pNalHeadExt->bIdrFlag);
+  else
+    iEncReturn = g_pWelsSliceCoding[pNalHeadExt->bIdrFlag][kiDynamicSliceFlag] (pEncCtx, pCurSlice);
   if (ENC_RETURN_SUCCESS != iEncReturn)
     return iEncReturn;
 
@@ -1781,8 +1786,8 @@ bool DynSlcJudgeSliceBoundaryStepBack (void* pCtx, void* pSlice, SSliceCtx* pSli
 ///////////////
 //  pMb loop
 ///////////////
-inline void WelsInitInterMDStruc (const SMB* pCurMb, uint16_t* pMvdCostTable, const int32_t kiMvdInterTableStride,
-                                  SWelsMD* pMd) {
+void WelsInitInterMDStruc (const SMB* pCurMb, uint16_t* pMvdCostTable, const int32_t kiMvdInterTableStride,
+                           SWelsMD* pMd) {
   pMd->iLambda = g_kiQpCostTable[pCurMb->uiLumaQp];
   pMd->pMvdCost = &pMvdCostTable[pCurMb->uiLumaQp * kiMvdInterTableStride];
   pMd-> iMbPixX = (pCurMb->iMbX << 4);
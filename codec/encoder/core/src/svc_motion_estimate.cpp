@@ -40,6 +40,7 @@
 
 #include "cpu_core.h"
 #include "ls_defines.h"
+#include "picture_handle.h"
 #include "svc_motion_estimate.h"
 #include "wels_transpose_matrix.h"
 
@@ -215,50 +216,52 @@ bool WelsMotionEstimateInitialPoint (SWelsFuncPtrList* pFuncList, SWelsME* pMe,
                                      int32_t iStrideRef) {
   PSampleSadSatdCostFunc pSad    = pFuncList->sSampleDealingFuncs.pfSampleSad[pMe->uiBlockSize];
   const uint16_t* kpMvdCost  = pMe->pMvdCost;
-  uint8_t* const kpEncMb    = pMe->pEncMb;
   int16_t iMvc0, iMvc1;
   int32_t iSadCost;
   int32_t iBestSadCost;
+  int32_t iBestIdx;
   uint8_t* pRefMb;
-  uint8_t* pFref2;
   uint32_t i;
+  int32_t j;
   const uint32_t kuiMvcNum    = pSlice->uiMvcNum;
   const SMVUnitXY* kpMvcList  = &pSlice->sMvc[0];
   const SMVUnitXY ksMvStartMin    = pSlice->sMvStartMin;
   const SMVUnitXY ksMvStartMax    = pSlice->sMvStartMax;
   const SMVUnitXY ksMvp    = pMe->sMvp;
   SMVUnitXY sMv;
+  SMeCandidates sCands;
 
   //  Step 1: Initial point prediction
   // init with sMvp
   sMv.iMvX  = WELS_CLIP3 ((2 + ksMvp.iMvX) >> 2, ksMvStartMin.iMvX, ksMvStartMax.iMvX);
   sMv.iMvY  = WELS_CLIP3 ((2 + ksMvp.iMvY) >> 2, ksMvStartMin.iMvY, ksMvStartMax.iMvY);
 
-  pRefMb = &pMe->pRefMb[sMv.iMvY * iStrideRef + sMv.iMvX];
-
-  iBestSadCost = pSad (kpEncMb, iStrideEnc, pRefMb, iStrideRef);
-  iBestSadCost += COST_MVD (kpMvdCost, ((sMv.iMvX) * (1 << 2)) - ksMvp.iMvX, ((sMv.iMvY) * (1 << 2)) - ksMvp.iMvY);
+  sCands.iNum = 0;
+  WelsMeCandidatesAdd (&sCands, sMv.iMvX, sMv.iMvY, &pMe->pRefMb[sMv.iMvY * iStrideRef + sMv.iMvX],
+                       COST_MVD (kpMvdCost, ((sMv.iMvX) * (1 << 2)) - ksMvp.iMvX, ((sMv.iMvY) * (1 << 2)) - ksMvp.iMvY));
 
   for (i = 0; i < kuiMvcNum; i++) {
     //clipping here is essential since some pOut-of-range MVC may happen here (i.e., refer to baseMV)
     iMvc0 = WELS_CLIP3 ((2 + kpMvcList[i].iMvX) >> 2, ksMvStartMin.iMvX, ksMvStartMax.iMvX);
     iMvc1 = WELS_CLIP3 ((2 + kpMvcList[i].iMvY) >> 2, ksMvStartMin.iMvY, ksMvStartMax.iMvY);
 
-    if (((iMvc0 - sMv.iMvX) || (iMvc1 - sMv.iMvY))) {
-      pFref2 = &pMe->pRefMb[iMvc1 * iStrideRef + iMvc0];
-
-      iSadCost = pSad (kpEncMb, iStrideEnc, pFref2, iStrideRef) +
-                 COST_MVD (kpMvdCost, (iMvc0 * (1 << 2)) - ksMvp.iMvX, (iMvc1 * (1 << 2)) - ksMvp.iMvY);
-
-      if (iSadCost < iBestSadCost) {
-        sMv.iMvX = iMvc0;
-        sMv.iMvY = iMvc1;
-        pRefMb = pFref2;
-        iBestSadCost = iSadCost;
-      }
+    for (j = 0; j < sCands.iNum; j++) {
+      if (iMvc0 == sCands.sMv[j].iMvX && iMvc1 == sCands.sMv[j].iMvY)
+        break;
+    }
+    if (j == sCands.iNum) {
+      WelsMeCandidatesAdd (&sCands, iMvc0, iMvc1, &pMe->pRefMb[iMvc1 * iStrideRef + iMvc0],
+                           COST_MVD (kpMvdCost, (iMvc0 * (1 << 2)) - ksMvp.iMvX, (iMvc1 * (1 << 2)) - ksMvp.iMvY));
     }
   }
 
+  // sMvp and the MVCs in one batch, the first of the lowest cost is kept
+  iBestSadCost = INT_MAX;
+  iBestIdx = WelsMeCandidatesSearch (pFuncList->sSampleDealingFuncs.pfSample4SadRef[pMe->uiBlockSize], pMe->pEncMb,
+                                     iStrideEnc, iStrideRef, &sCands, &iBestSadCost, 0);
+  sMv = sCands.sMv[iBestIdx];
+  pRefMb = sCands.pRef[iBestIdx];
+
   if (pFuncList->pfCheckDirectionalMv
       (pSad, pMe, ksMvStartMin, ksMvStartMax, iStrideEnc, iStrideRef, iSadCost)) {
     sMv = pMe->sDirectionalMv;
@@ -287,43 +290,80 @@ void NotCalculateSatdCost (PSampleSadSatdCostFunc pSatd, SWelsME* pMe,
 
 
 /////////////////////////
-// Diamond Search Basics
+// Candidates Search Basics
 /////////////////////////
-bool WelsMeSadCostSelect (int32_t* iSadCost, const uint16_t* kpMvdCost, int32_t* pBestCost, const int32_t kiDx,
-                          const int32_t kiDy, int32_t* pIx, int32_t* pIy) {
-  int32_t iTempSadCost[4];
-  int32_t iInputSadCost = *pBestCost;
-  iTempSadCost[0] = iSadCost[0] + COST_MVD (kpMvdCost, kiDx, kiDy - 4);
-  iTempSadCost[1] = iSadCost[1] + COST_MVD (kpMvdCost, kiDx, kiDy + 4);
-  iTempSadCost[2] = iSadCost[2] + COST_MVD (kpMvdCost, kiDx - 4, kiDy);
-  iTempSadCost[3] = iSadCost[3] + COST_MVD (kpMvdCost, kiDx + 4, kiDy);
-
-  if (iTempSadCost[0] < *pBestCost) {
-    *pBestCost = iTempSadCost[0];
-    *pIx = 0;
-    *pIy = 1;
+static inline void MeCandidatesCost (SMeCandidates* pCands, const int32_t* kpSad, const int32_t kiFirst,
+                                     const int32_t kiEnd, int32_t* pBestCost, int32_t* pBestIdx) {
+  int32_t* pCost = pCands->iCost;
+  int32_t iBestCost = *pBestCost;
+  int32_t iBestIdx = *pBestIdx;
+  for (int32_t i = kiFirst; i < kiEnd; i++) {
+    pCost[i] += kpSad[i];
+    if (pCost[i] < iBestCost) {
+      iBestCost = pCost[i];
+      iBestIdx = i;
+    }
   }
+  *pBestCost = iBestCost;
+  *pBestIdx = iBestIdx;
+}
 
-  if (iTempSadCost[1] < *pBestCost) {
-    *pBestCost = iTempSadCost[1];
-    *pIx = 0;
-    *pIy = -1;
+static inline int32_t MeCandidatesKeep (SMeCandidates* pCands, int32_t iBestCost, int32_t iBestIdx,
+                                        int32_t* pBestCost, const int32_t kiStopCost) {
+  if (iBestIdx >= 0 && iBestCost < kiStopCost) {
+    // the first candidate below kiStopCost, where a search of one candidate at a time stops
+    const int32_t* kpCost = pCands->iCost;
+    int32_t i;
+    iBestCost = *pBestCost;
+    for (i = 0; i < iBestIdx; i++) {
+      if (kpCost[i] < iBestCost) {
+        iBestCost = kpCost[i];
+        if (iBestCost < kiStopCost)
+          break;
+      }
+    }
+    iBestIdx = i;
+    iBestCost = kpCost[i];
   }
+  *pBestCost = iBestCost;
+  return iBestIdx;
+}
 
-  if (iTempSadCost[2] < *pBestCost) {
-    *pBestCost = iTempSadCost[2];
-    *pIx = 1;
-    *pIy = 0;
-  }
+int32_t WelsMeCandidatesSelect (SMeCandidates* pCands, const int32_t* kpSad, int32_t* pBestCost,
+                                const int32_t kiStopCost) {
+  int32_t iBestCost = *pBestCost;
+  int32_t iBestIdx = -1;
+  MeCandidatesCost (pCands, kpSad, 0, pCands->iNum, &iBestCost, &iBestIdx);
+  return MeCandidatesKeep (pCands, iBestCost, iBestIdx, pBestCost, kiStopCost);
+}
+
+int32_t WelsMeCandidatesSearch (PSample4SadRefCostFunc pSad4Ref, uint8_t* pEnc, const int32_t kiEncStride,
+                                const int32_t kiRefStride, SMeCandidates* pCands,
+                                int32_t* pBestCost, const int32_t kiStopCost) {
+  ENFORCE_STACK_ALIGN_1D (int32_t, iSads, ME_MAX_CANDIDATES, 16)
+  const int32_t kiNum = pCands->iNum;
+  int32_t iBestCost = *pBestCost;
+  int32_t iBestIdx = -1;
+  int32_t i;
+
+  if (kiNum <= 0)
+    return -1;
 
-  if (iTempSadCost[3] < *pBestCost) {
-    *pBestCost = iTempSadCost[3];
-    *pIx = -1;
-    *pIy = 0;
+  // the last group of four is completed with the last candidate, its copies cannot be kept
+  for (i = kiNum; i & 3; i++)
+    pCands->pRef[i] = pCands->pRef[kiNum - 1];
+  // each group of four SADs is costed right after it is computed
+  for (i = 0; i < kiNum; i += 4) {
+    pSad4Ref (pEnc, kiEncStride, &pCands->pRef[i], kiRefStride, &iSads[i]);
+    MeCandidatesCost (pCands, iSads, i, WELS_MIN (i + 4, kiNum), &iBestCost, &iBestIdx);
   }
-  return (*pBestCost == iInputSadCost);
+
+  return MeCandidatesKeep (pCands, iBestCost, iBestIdx, pBestCost, kiStopCost);
 }
 
+/////////////////////////
+// Diamond Search Basics
+/////////////////////////
 void WelsDiamondSearch (SWelsFuncPtrList* pFuncList, SWelsME* pMe, SSlice* pSlice,
                         const int32_t kiStrideEnc,  const int32_t kiStrideRef) {
   PSample4SadCostFunc      pSad          =  pFuncList->sSampleDealingFuncs.pfSample4Sad[pMe->uiBlockSize];
@@ -343,25 +383,34 @@ void WelsDiamondSearch (SWelsFuncPtrList* pFuncList, SWelsME* pMe, SSlice* pSlic
 
   int32_t iTimeThreshold = ITERATIVE_TIMES;
   ENFORCE_STACK_ALIGN_1D (int32_t, iSadCosts, 4, 16)
+  SMeCandidates sCands;
 
   while (iTimeThreshold--) {
     pMe->sMv.iMvX = (iMvDx + pMe->sMvp.iMvX) >> 2;
     pMe->sMv.iMvY = (iMvDy + pMe->sMvp.iMvY) >> 2;
     if (!CheckMvInRange (pMe->sMv, ksMvStartMin, ksMvStartMax))
       continue;
+    // the neighbours are adjacent, pfSample4Sad shares their rows where pfSample4SadRef could not
     pSad (kpEncMb, kiStrideEnc, pRefMb, kiStrideRef, &iSadCosts[0]);
 
-    int32_t iX, iY;
-
-    const bool kbIsBestCostWorse = WelsMeSadCostSelect (iSadCosts, kpMvdCost, &iBestCost, iMvDx, iMvDy, &iX, &iY);
-    if (kbIsBestCostWorse)
+    // up, down, left and right, in the order of the SADs
+    sCands.iNum = 0;
+    WelsMeCandidatesAdd (&sCands, pMe->sMv.iMvX, pMe->sMv.iMvY - 1, pRefMb - kiStrideRef,
+                         COST_MVD (kpMvdCost, iMvDx, iMvDy - 4));
+    WelsMeCandidatesAdd (&sCands, pMe->sMv.iMvX, pMe->sMv.iMvY + 1, pRefMb + kiStrideRef,
+                         COST_MVD (kpMvdCost, iMvDx, iMvDy + 4));
+    WelsMeCandidatesAdd (&sCands, pMe->sMv.iMvX - 1, pMe->sMv.iMvY, pRefMb - 1,
+                         COST_MVD (kpMvdCost, iMvDx - 4, iMvDy));
+    WelsMeCandidatesAdd (&sCands, pMe->sMv.iMvX + 1, pMe->sMv.iMvY, pRefMb + 1,
+                         COST_MVD (kpMvdCost, iMvDx + 4, iMvDy));
+
+    const int32_t kiBestIdx = WelsMeCandidatesSelect (&sCands, iSadCosts, &iBestCost, 0);
+    if (kiBestIdx < 0)
       break;
 
-    iMvDx -= (iX * (1 << 2)) ;
-    iMvDy -= (iY * (1 << 2)) ;
-
-    pRefMb -= (iX + iY * kiStrideRef);
-
+    iMvDx = (sCands.sMv[kiBestIdx].iMvX * (1 << 2)) - pMe->sMvp.iMvX;
+    iMvDy = (sCands.sMv[kiBestIdx].iMvY * (1 << 2)) - pMe->sMvp.iMvY;
+    pRefMb = sCands.pRef[kiBestIdx];
   }
 
   /* integer-pel mv */
@@ -562,7 +611,7 @@ void LineFullSearch_c (SWelsFuncPtrList* pFuncList, SWelsME* pMe,
                        const int32_t kiEncStride, const int32_t kiRefStride,
                        const int16_t iMinMv, const int16_t iMaxMv,
                        const bool bVerticalSearch) {
-  PSampleSadSatdCostFunc pSad = pFuncList->sSampleDealingFuncs.pfSampleSad[pMe->uiBlockSize];
+  PSample4SadRefCostFunc pSad4Ref = pFuncList->sSampleDealingFuncs.pfSample4SadRef[pMe->uiBlockSize];
   const int32_t kiCurMeBlockPixX = pMe->iCurMeBlockPixX;
   const int32_t kiCurMeBlockPixY = pMe->iCurMeBlockPixY;
   int32_t iMinPos, iMaxPos;
@@ -587,25 +636,31 @@ void LineFullSearch_c (SWelsFuncPtrList* pFuncList, SWelsME* pMe,
     pMvdCost  = & (pMvdTable[ (iMinMv * (1 << 2)) - pMe->sMvp.iMvX]);
   }
   uint8_t* pRef            = &pMe->pColoRefMb[ iMinMv * iStride];
-  uint32_t uiBestCost    = 0xFFFFFFFF;
-  int32_t iBestPos       = 0;
-
-  for (int32_t iTargetPos = iMinPos; iTargetPos < iMaxPos; ++ iTargetPos) {
-    uint8_t* const kpEncMb  = pMe->pEncMb;
-    uint32_t uiSadCost = pSad (kpEncMb, kiEncStride, pRef, kiRefStride) + (iFixedMvd + *pMvdCost);
-    if (uiSadCost < uiBestCost) {
-      uiBestCost  = uiSadCost;
-      iBestPos  = iTargetPos;
+  int32_t iBestCost      = pMe->uiSadCost;
+  int32_t iBestIdx;
+  SMVUnitXY sBestMv      = pMe->sMv;
+  uint8_t* pBestRef      = pMe->pRefMb;
+  SMeCandidates sCands;
+
+  // the line in batches of ME_MAX_CANDIDATES positions
+  int32_t iTargetPos = iMinPos;
+  while (iTargetPos < iMaxPos) {
+    sCands.iNum = 0;
+    for (; iTargetPos < iMaxPos && sCands.iNum < ME_MAX_CANDIDATES; ++ iTargetPos) {
+      const int32_t kiMv = iTargetPos - iCurMeBlockPix;
+      WelsMeCandidatesAdd (&sCands, bVerticalSearch ? 0 : kiMv, bVerticalSearch ? kiMv : 0, pRef, iFixedMvd + *pMvdCost);
+      pRef += iStride;
+      pMvdCost += 4;
+    }
+    iBestIdx = WelsMeCandidatesSearch (pSad4Ref, pMe->pEncMb, kiEncStride, kiRefStride, &sCands, &iBestCost, 0);
+    if (iBestIdx >= 0) {
+      sBestMv = sCands.sMv[iBestIdx];
+      pBestRef = sCands.pRef[iBestIdx];
     }
-    pRef += iStride;
-    pMvdCost += 4;
   }
 
-  if (uiBestCost < pMe->uiSadCost) {
-    SMVUnitXY sBestMv;
-    sBestMv.iMvX = bVerticalSearch ? 0 : (iBestPos - iCurMeBlockPix);
-    sBestMv.iMvY = bVerticalSearch ? (iBestPos - iCurMeBlockPix) : 0;
-    UpdateMeResults (sBestMv, uiBestCost, &pMe->pColoRefMb[sBestMv.iMvY * kiRefStride + sBestMv.iMvX], pMe);
+  if (static_cast<uint32_t> (iBestCost) < pMe->uiSadCost) {
+    UpdateMeResults (sBestMv, iBestCost, pBestRef, pMe);
   }
 }
 
@@ -633,6 +688,179 @@ void WelsMotionCrossSearch (SWelsFuncPtrList* pFuncList, SWelsME* pMe, SSlice* p
 }
 
 
+/////////////////////////
+// Hierarchical Search Basics
+/////////////////////////
+//memory related
+int32_t RequestHierarchicalMe (CMemoryAlign* pMa, const int32_t kiMbWidth, const int32_t kiMbHeight,
+                               const int32_t kiLevels, SHierarchicalMe* pHme) {
+  for (int32_t i = 0; i < kiLevels; i++) {
+    const int32_t kiWidth  = (kiMbWidth << 4) >> (i + 1);
+    const int32_t kiHeight = (kiMbHeight << 4) >> (i + 1);
+    pHme->pEncLevel[i] = AllocPicture (pMa, kiWidth, kiHeight, false, 0);
+    WELS_VERIFY_RETURN_IF (ENC_RETURN_MEMALLOCERR, NULL == pHme->pEncLevel[i])
+    pHme->pRefLevel[i] = AllocPicture (pMa, kiWidth, kiHeight, false, 0);
+    WELS_VERIFY_RETURN_IF (ENC_RETURN_MEMALLOCERR, NULL == pHme->pRefLevel[i])
+  }
+  pHme->pMbMv = (SMVUnitXY*)pMa->WelsMallocz (kiMbWidth * kiMbHeight * sizeof (SMVUnitXY), "pHmeMbMv");
+  WELS_VERIFY_RETURN_IF (ENC_RETURN_MEMALLOCERR, NULL == pHme->pMbMv)
+
+  pHme->iLevels = kiLevels;
+  pHme->bMbMvAvail = false;
+  return ENC_RETURN_SUCCESS;
+}
+void ReleaseHierarchicalMe (CMemoryAlign* pMa, SHierarchicalMe* pHme) {
+  for (int32_t i = 0; i < MAX_HME_LEVELS; i++) {
+    if (pHme->pEncLevel[i])
+      FreePicture (pMa, &pHme->pEncLevel[i]);
+    if (pHme->pRefLevel[i])
+      FreePicture (pMa, &pHme->pRefLevel[i]);
+  }
+  if (pHme->pMbMv) {
+    pMa->WelsFree (pHme->pMbMv, "pHmeMbMv");
+    pHme->pMbMv = NULL;
+  }
+}
+
+/*
+ *  block of a level searched: the candidates are evaluated in batches, the MVD costs are taken at the layer
+ *  size against the motion predicted from the neighbours at the same level
+ */
+typedef struct TagHmeBlock {
+  PSample4SadRefCostFunc  pSad4Ref;
+  uint8_t*                pEnc;
+  uint8_t*                pRef;           // co-located block of the reference
+  int32_t                 iEncStride;
+  int32_t                 iRefStride;
+  const uint16_t*         pMvdCost;
+  int32_t                 iShift;         // level, log2 of the downsampling
+  SMVUnitXY               sMvp;
+  SMVUnitXY               sMvMin;         // the reference block stays in the downsampled picture
+  SMVUnitXY               sMvMax;
+  SMeCandidates           sCands;
+  SMVUnitXY               sBestMv;
+  int32_t                 iBestCost;
+} SHmeBlock;
+
+static void HmeFlush (SHmeBlock* pBlk) {
+  const int32_t kiIdx = WelsMeCandidatesSearch (pBlk->pSad4Ref, pBlk->pEnc, pBlk->iEncStride, pBlk->iRefStride,
+                        &pBlk->sCands, &pBlk->iBestCost, 0);
+  if (kiIdx >= 0)
+    pBlk->sBestMv = pBlk->sCands.sMv[kiIdx];
+  pBlk->sCands.iNum = 0;
+}
+
+static void HmeSearchWindow (SHmeBlock* pBlk, const SMVUnitXY ksCenter, const int32_t kiRange) {
+  const int32_t kiMinX = WELS_MAX (ksCenter.iMvX - kiRange, pBlk->sMvMin.iMvX);
+  const int32_t kiMaxX = WELS_MIN (ksCenter.iMvX + kiRange, pBlk->sMvMax.iMvX);
+  const int32_t kiMinY = WELS_MAX (ksCenter.iMvY - kiRange, pBlk->sMvMin.iMvY);
+  const int32_t kiMaxY = WELS_MIN (ksCenter.iMvY + kiRange, pBlk->sMvMax.iMvY);
+  const int32_t kiMvdShift = pBlk->iShift + 2;
+  const int32_t kiCostShift = pBlk->iShift << 1;
+  for (int32_t iMvY = kiMinY; iMvY <= kiMaxY; iMvY++) {
+    for (int32_t iMvX = kiMinX; iMvX <= kiMaxX; iMvX++) {
+      WelsMeCandidatesAdd (&pBlk->sCands, iMvX, iMvY, &pBlk->pRef[iMvY * pBlk->iRefStride + iMvX],
+                           COST_MVD (pBlk->pMvdCost, (iMvX - pBlk->sMvp.iMvX) * (1 << kiMvdShift),
+                                     (iMvY - pBlk->sMvp.iMvY) * (1 << kiMvdShift)) >> kiCostShift);
+      if (ME_MAX_CANDIDATES == pBlk->sCands.iNum)
+        HmeFlush (pBlk);
+    }
+  }
+}
+
+static inline void HmePredMv (const SMVUnitXY* kpMbMv, const int32_t kiMbX, const int32_t kiMbY,
+                              const int32_t kiMbWidth, SMVUnitXY* pMvp) {
+  const SMVUnitXY* kpCur = &kpMbMv[kiMbY * kiMbWidth + kiMbX];
+  SMVUnitXY sLeft = {0, 0};
+  if (kiMbX > 0)
+    sLeft = kpCur[-1];
+  if (0 == kiMbY) {
+    *pMvp = sLeft;
+    return;
+  }
+  const SMVUnitXY sTop = kpCur[-kiMbWidth];
+  SMVUnitXY sTopRight = sTop;
+  if (kiMbX < kiMbWidth - 1)
+    sTopRight = kpCur[1 - kiMbWidth];
+  else if (kiMbX > 0)
+    sTopRight = kpCur[-1 - kiMbWidth];
+  pMvp->iMvX = WelsMedian (sLeft.iMvX, sTop.iMvX, sTopRight.iMvX);
+  pMvp->iMvY = WelsMedian (sLeft.iMvY, sTop.iMvY, sTopRight.iMvY);
+}
+
+void WelsHierarchicalMeSearch (SWelsFuncPtrList* pFuncList, SHierarchicalMe* pHme, const uint16_t* kpMvdCost,
+                               const int32_t kiMbWidth, const int32_t kiMbHeight, const int32_t kiMvRange) {
+  SMVUnitXY* pMbMv = pHme->pMbMv;
+  const SMVUnitXY ksZeroMv = {0, 0};
+  SHmeBlock sBlk;
+  sBlk.pMvdCost = kpMvdCost;
+
+  // from the coarsest level, where the MVs are searched around zero and around the neighbours, the MVs are
+  // refined at each finer one around twice the coarser MV and around the predictor
+  for (int32_t iLevel = pHme->iLevels - 1; iLevel >= 0; iLevel--) {
+    const SPicture* kpEnc = pHme->pEncLevel[iLevel];
+    const SPicture* kpRef = pHme->pRefLevel[iLevel];
+    const bool kbCoarsest = (iLevel == pHme->iLevels - 1);
+    const int32_t kiShift = iLevel + 1;
+    const int32_t kiBlockSize = 16 >> kiShift;
+    const int32_t kiWidth = kiMbWidth * kiBlockSize;
+    const int32_t kiHeight = kiMbHeight * kiBlockSize;
+    const int32_t kiRange = kiMvRange >> kiShift;
+
+    sBlk.pSad4Ref = pFuncList->sSampleDealingFuncs.pfSample4SadRef[(1 == kiShift) ? BLOCK_8x8 : BLOCK_4x4];
+    sBlk.iEncStride = kpEnc->iLineSize[0];
+    sBlk.iRefStride = kpRef->iLineSize[0];
+    sBlk.iShift = kiShift;
+
+    for (int32_t iMbY = 0; iMbY < kiMbHeight; iMbY++) {
+      const int32_t kiPixY = iMbY * kiBlockSize;
+      for (int32_t iMbX = 0; iMbX < kiMbWidth; iMbX++) {
+        const int32_t kiPixX = iMbX * kiBlockSize;
+        SMVUnitXY* pMv = &pMbMv[iMbY * kiMbWidth + iMbX];
+
+        sBlk.pEnc = kpEnc->pData[0] + kiPixY * sBlk.iEncStride + kiPixX;
+        sBlk.pRef = kpRef->pData[0] + kiPixY * sBlk.iRefStride + kiPixX;
+        sBlk.sMvMin.iMvX = WELS_MAX (-kiPixX, -kiRange);
+        sBlk.sMvMin.iMvY = WELS_MAX (-kiPixY, -kiRange);
+        sBlk.sMvMax.iMvX = WELS_MIN (kiWidth - kiBlockSize - kiPixX, kiRange);
+        sBlk.sMvMax.iMvY = WELS_MIN (kiHeight - kiBlockSize - kiPixY, kiRange);
+        HmePredMv (pMbMv, iMbX, iMbY, kiMbWidth, &sBlk.sMvp);
+        sBlk.sBestMv = ksZeroMv;
+        sBlk.iBestCost = INT_MAX;
+        sBlk.sCands.iNum = 0;
+
+        if (kbCoarsest) {
+          HmeSearchWindow (&sBlk, ksZeroMv, HME_SEARCH_RANGE);
+          if (iMbX > 0)
+            HmeSearchWindow (&sBlk, pMv[-1], 1);
+          if (iMbY > 0) {
+            HmeSearchWindow (&sBlk, pMv[-kiMbWidth], 1);
+            if (iMbX < kiMbWidth - 1)
+              HmeSearchWindow (&sBlk, pMv[1 - kiMbWidth], 1);
+          }
+        } else {
+          SMVUnitXY sCoarseMv;
+          sCoarseMv.iMvX = pMv->iMvX * 2;
+          sCoarseMv.iMvY = pMv->iMvY * 2;
+          HmeSearchWindow (&sBlk, sCoarseMv, 1);
+          HmeSearchWindow (&sBlk, sBlk.sMvp, 1);
+        }
+        if (sBlk.sCands.iNum > 0)
+          HmeFlush (&sBlk);
+
+        *pMv = sBlk.sBestMv;
+      }
+    }
+  }
+
+  // to quarter pels of the layer size
+  const int32_t kiMbCount = kiMbWidth * kiMbHeight;
+  for (int32_t i = 0; i < kiMbCount; i++) {
+    pMbMv[i].iMvX = pMbMv[i].iMvX * (1 << 3);
+    pMbMv[i].iMvY = pMbMv[i].iMvY * (1 << 3);
+  }
+}
+
 /////////////////////////
 // Feature Search Basics
 /////////////////////////
@@ -888,7 +1116,7 @@ bool SetFeatureSearchIn (SWelsFuncPtrList* pFunc,  const SWelsME& sMe,
                          const SSlice* pSlice, SScreenBlockFeatureStorage* pRefFeatureStorage,
                          const int32_t kiEncStride, const int32_t kiRefStride,
                          SFeatureSearchIn* pFeatureSearchIn) {
-  pFeatureSearchIn->pSad = pFunc->sSampleDealingFuncs.pfSampleSad[sMe.uiBlockSize];
+  pFeatureSearchIn->pSad4Ref = pFunc->sSampleDealingFuncs.pfSample4SadRef[sMe.uiBlockSize];
   pFeatureSearchIn->iFeatureOfCurrent = pFunc->pfCalculateSingleBlockFeature[BLOCK_16x16 == sMe.uiBlockSize] (sMe.pEncMb,
                                         kiEncStride);
 
@@ -913,7 +1141,7 @@ bool SetFeatureSearchIn (SWelsFuncPtrList* pFunc,  const SWelsME& sMe,
   pFeatureSearchIn->iMaxQpelX = pFeatureSearchIn->iCurPixXQpel + ((pSlice->sMvStartMax.iMvX) * (1 << 2));
   pFeatureSearchIn->iMaxQpelY = pFeatureSearchIn->iCurPixYQpel + ((pSlice->sMvStartMax.iMvY) * (1 << 2));
 
-  if (NULL == pFeatureSearchIn->pSad || NULL == pFeatureSearchIn->pTimesOfFeature
+  if (NULL == pFeatureSearchIn->pSad4Ref || NULL == pFeatureSearchIn->pTimesOfFeature
       || NULL == pFeatureSearchIn->pQpelLocationOfFeature) {
     return false;
   }
@@ -933,7 +1161,7 @@ bool FeatureSearchOne (SFeatureSearchIn& sFeatureSearchIn, const int32_t iFeatur
   if (iFeatureOfRef < 0 || iFeatureOfRef >= LIST_SIZE)
     return true;
 
-  PSampleSadSatdCostFunc pSad = sFeatureSearchIn.pSad;
+  PSample4SadRefCostFunc pSad4Ref = sFeatureSearchIn.pSad4Ref;
   uint8_t* pEnc =  sFeatureSearchIn.pEnc;
   uint8_t* pColoRef = sFeatureSearchIn.pColoRef;
   const int32_t iEncStride =  sFeatureSearchIn.iEncStride;
@@ -955,46 +1183,51 @@ bool FeatureSearchOne (SFeatureSearchIn& sFeatureSearchIn, const int32_t iFeatur
   const uint16_t* pQpelPosition = sFeatureSearchIn.pQpelLocationOfFeature[iFeatureOfRef];
 
   SMVUnitXY sBestMv;
-  uint32_t uiBestCost, uiTmpCost;
-  uint8_t* pBestRef, *pCurRef;
+  int32_t iBestCost;
+  uint32_t uiTmpCost;
+  uint8_t* pBestRef;
   int32_t iQpelX, iQpelY;
   int32_t iIntepelX, iIntepelY;
-  int32_t i;
+  int32_t i, iBestIdx;
+  bool bEarlyStop = false;
+  SMeCandidates sCands;
 
   sBestMv.iMvX = pFeatureSearchOut->sBestMv.iMvX;
   sBestMv.iMvY = pFeatureSearchOut->sBestMv.iMvY;
-  uiBestCost = pFeatureSearchOut->uiBestSadCost;
+  iBestCost = pFeatureSearchOut->uiBestSadCost;
   pBestRef = pFeatureSearchOut->pBestRef;
 
-  for (i = 0; i < iSearchTimesx2; i += 2) {
-    iQpelX = pQpelPosition[i];
-    iQpelY = pQpelPosition[i + 1];
-
-    if ((iQpelX > iMaxQpelX) || (iQpelX < iMinQpelX)
-        || (iQpelY > iMaxQpelY) || (iQpelY < iMinQpelY)
-        || (iQpelX == iCurPixXQpel) || (iQpelY == iCurPixYQpel))
-      continue;
-
-    uiTmpCost = sFeatureSearchIn.pMvdCostX[ iQpelX ] + sFeatureSearchIn.pMvdCostY[ iQpelY ];
-    if (uiTmpCost + iFeatureDifference >= uiBestCost)
-      continue;
+  i = 0;
+  while (i < iSearchTimesx2 && !bEarlyStop) {
+    // positions of the feature in batches, the ones whose MVD cost alone is too high are left out
+    sCands.iNum = 0;
+    for (; i < iSearchTimesx2 && sCands.iNum < ME_MAX_CANDIDATES; i += 2) {
+      iQpelX = pQpelPosition[i];
+      iQpelY = pQpelPosition[i + 1];
+
+      if ((iQpelX > iMaxQpelX) || (iQpelX < iMinQpelX)
+          || (iQpelY > iMaxQpelY) || (iQpelY < iMinQpelY)
+          || (iQpelX == iCurPixXQpel) || (iQpelY == iCurPixYQpel))
+        continue;
+
+      uiTmpCost = sFeatureSearchIn.pMvdCostX[ iQpelX ] + sFeatureSearchIn.pMvdCostY[ iQpelY ];
+      if (uiTmpCost + iFeatureDifference >= static_cast<uint32_t> (iBestCost))
+        continue;
+
+      iIntepelX = (iQpelX >> 2) - iCurPixX;
+      iIntepelY = (iQpelY >> 2) - iCurPixY;
+      WelsMeCandidatesAdd (&sCands, iIntepelX, iIntepelY, &pColoRef[iIntepelX + iIntepelY * iRefStride], uiTmpCost);
+    }
 
-    iIntepelX = (iQpelX >> 2) - iCurPixX;
-    iIntepelY = (iQpelY >> 2) - iCurPixY;
-    pCurRef = &pColoRef[iIntepelX + iIntepelY * iRefStride];
-    uiTmpCost += pSad (pEnc, iEncStride, pCurRef, iRefStride);
-    if (uiTmpCost < uiBestCost) {
-      sBestMv.iMvX = iIntepelX;
-      sBestMv.iMvY = iIntepelY;
-      uiBestCost = uiTmpCost;
-      pBestRef = pCurRef;
-
-      if (uiBestCost < uiSadCostThresh)
-        break;
+    iBestIdx = WelsMeCandidatesSearch (pSad4Ref, pEnc, iEncStride, iRefStride, &sCands, &iBestCost, uiSadCostThresh);
+    if (iBestIdx >= 0) {
+      sBestMv = sCands.sMv[iBestIdx];
+      pBestRef = sCands.pRef[iBestIdx];
+      bEarlyStop = (iBestCost < uiSadCostThresh);
     }
   }
-  SaveFeatureSearchOut (sBestMv, uiBestCost, pBestRef, pFeatureSearchOut);
-  return (i < iSearchTimesx2);
+  SaveFeatureSearchOut (sBestMv, iBestCost, pBestRef, pFeatureSearchOut);
+  return bEarlyStop;
 }
 
 
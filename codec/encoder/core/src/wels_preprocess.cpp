@@ -54,6 +54,7 @@ namespace WelsEnc {
 //***** entry API declaration ************************************************************************//
 
 int32_t WelsInitScaledPic (SWelsSvcCodingParam* pParam,  Scaled_Picture*  pScaledPic, CMemoryAlign* pMemoryAlign);
+SPicture* AllocScaledInputPicture (CMemoryAlign* pMemoryAlign, const int32_t kiWidth, const int32_t kiHeight);
 bool  JudgeNeedOfScaling (SWelsSvcCodingParam* pParam, Scaled_Picture* pScaledPic);
 void    FreeScaledPic (Scaled_Picture*  pScaledPic, CMemoryAlign* pMemoryAlign);
 void  WelsMoveMemory_c (uint8_t* pDstY, uint8_t* pDstU, uint8_t* pDstV,  int32_t iDstStrideY, int32_t iDstStrideUV,
@@ -78,6 +79,74 @@ inline  void   WelsUpdateSpatialIdxMap (sWelsEncCtx* pEncCtx, const int32_t iPos
 }
 
 
+/*
+ *  prepares a frame on a thread of the pool for CWelsPreProcess::PrepareSpatialPicturesAhead(), Wait() returns once
+ *  the task left OnTaskExecuted() or OnTaskCancelled()
+ */
+class CWelsPrepareTask : public WelsCommon::IWelsTask, public WelsCommon::IWelsTaskSink {
+ public:
+  CWelsPrepareTask (CWelsPreProcess* pPreProcess)
+    : IWelsTask (this), m_pPreProcess (pPreProcess), m_kpSrcPic (NULL), m_bQueued (false), m_bPrepared (false) {
+    WelsMutexInit (&m_hMutex);
+    WelsCondInit (&m_hCond);
+  }
+  virtual ~CWelsPrepareTask() {
+    WelsCondDestroy (&m_hCond);
+    WelsMutexDestroy (&m_hMutex);
+  }
+
+  bool Queue (WelsCommon::CWelsThreadPool* pThreadPool, const SSourcePicture* kpSrcPic) {
+    m_kpSrcPic = kpSrcPic;
+    m_bPrepared = false;
+    m_bQueued = true;
+    // the task may already have ended when QueueTask() returns, so m_bQueued can not be returned here
+    if (WELS_THREAD_ERROR_OK != pThreadPool->QueueTask (this)) {
+      m_bQueued = false;
+      return false;
+    }
+    return true;
+  }
+  bool Wait() {
+    WelsMutexLock (&m_hMutex);
+    while (m_bQueued)
+      WelsCondWait (&m_hCond, &m_hMutex);
+    WelsMutexUnlock (&m_hMutex);
+    return m_bPrepared;
+  }
+
+  virtual int Execute() {
+    CWelsPreProcess* pVpp = m_pPreProcess;
+    pVpp->PrepareLayerPictures (pVpp->m_pPrepareVp, pVpp->m_pEncCtx->pSvcParam, m_kpSrcPic,
+                                pVpp->m_pPreparedScaledInput, pVpp->m_pPreparedPic);
+    m_bPrepared = true;
+    return 0;
+  }
+  virtual int OnTaskExecuted() {
+    SetTaskEnded();
+    return 0;
+  }
+  virtual int OnTaskCancelled() {
+    SetTaskEnded();
+    return 0;
+  }
+
+ private:
+  void SetTaskEnded() {
+    WelsMutexLock (&m_hMutex);
+    m_bQueued = false;
+    WelsCondBroadcast (&m_hCond);
+    WelsMutexUnlock (&m_hMutex);
+  }
+
+  CWelsPreProcess*      m_pPreProcess;
+  const SSourcePicture* m_kpSrcPic;
+  bool                  m_bQueued;
+  bool                  m_bPrepared;
+  WELS_MUTEX            m_hMutex;
+  WELS_COND             m_hCond;
+};
+
+
 /***************************************************************************
 *
 *   implement of the interface
@@ -113,10 +182,21 @@ CWelsPreProcess::CWelsPreProcess (sWelsEncCtx* pEncCtx) {
   memset (m_pSpatialPic, 0, sizeof (m_pSpatialPic));
   memset (m_uiSpatialLayersInTemporal, 0, sizeof (m_uiSpatialLayersInTemporal));
   memset (m_uiSpatialPicNum, 0, sizeof (m_uiSpatialPicNum));
+  m_pPrepareVp = NULL;
+  m_pPreparedScaledInput = NULL;
+  memset (m_pPreparedPic, 0, sizeof (m_pPreparedPic));
+  memset (&m_sPreparedSrcPic, 0, sizeof (m_sPreparedSrcPic));
+  m_bPicPrepared = m_bUsePreparedPic = false;
+  m_pThreadPool = NULL;
+  m_pPrepareTask = NULL;
 }
 
 CWelsPreProcess::~CWelsPreProcess() {
   FreeScaledPic (&m_sScaledPicture,  m_pEncCtx->pMemAlign);
+  FreePreparedPictures (m_pEncCtx->pMemAlign);
+  WELS_DELETE_OP (m_pPrepareTask);
+  if (m_pThreadPool)
+    m_pThreadPool->RemoveInstance();
   WelsPreprocessDestroy();
 }
 
@@ -138,6 +218,10 @@ exit:
 int32_t CWelsPreProcess::WelsPreprocessDestroy() {
   WelsDestroyVpInterface (m_pInterfaceVp, WELSVP_INTERFACE_VERION);
   m_pInterfaceVp = NULL;
+  if (m_pPrepareVp) {
+    WelsDestroyVpInterface (m_pPrepareVp, WELSVP_INTERFACE_VERION);
+    m_pPrepareVp = NULL;
+  }
 
   return 0;
 }
@@ -157,6 +241,8 @@ int32_t CWelsPreProcess::WelsPreprocessReset (sWelsEncCtx* pCtx, int32_t iWidth,
   }
   if (pCtx) {
     FreeScaledPic (&m_sScaledPicture, pCtx->pMemAlign);
+    if (m_pPreparedScaledInput) // sized after the input, allocated again by the next preparation
+      FreePicture (pCtx->pMemAlign, &m_pPreparedScaledInput);
     iRet = InitLastSpatialPictures (pCtx);
     iRet = WelsInitScaledPic (pCtx->pSvcParam, &m_sScaledPicture, pCtx->pMemAlign);
   }
@@ -213,6 +299,7 @@ void CWelsPreProcess::FreeSpatialPictures (sWelsEncCtx* pCtx) {
     m_uiSpatialLayersInTemporal[j] = 0;
     ++ j;
   }
+  FreePreparedPictures (pMa);
 }
 
 int32_t CWelsPreProcess::BuildSpatialPicList (sWelsEncCtx* pCtx, const SSourcePicture* kpSrcPic) {
@@ -243,11 +330,145 @@ int32_t CWelsPreProcess::BuildSpatialPicList (sWelsEncCtx* pCtx, const SSourcePi
 
   pCtx->pVaa->bSceneChangeFlag = pCtx->pVaa->bIdrPeriodFlag = false;
 
-  iSpatialNum = SingleLayerPreprocess (pCtx, kpSrcPic, &m_sScaledPicture);
+  iSpatialNum = SingleLayerPreprocess (pCtx, m_bUsePreparedPic ? NULL : kpSrcPic, &m_sScaledPicture);
+  m_bUsePreparedPic = false;
 
   return iSpatialNum;
 }
 
+int32_t CWelsPreProcess::AllocPreparedPictures (sWelsEncCtx* pCtx) {
+  SWelsSvcCodingParam* pSvcParam = pCtx->pSvcParam;
+  CMemoryAlign* pMa = pCtx->pMemAlign;
+
+  if (m_pPrepareVp == NULL) {
+    WelsCreateVpInterface ((void**) &m_pPrepareVp, WELSVP_INTERFACE_VERION);
+    WELS_VERIFY_RETURN_IF (1, (NULL == m_pPrepareVp))
+  }
+  for (int32_t i = 0; i < pSvcParam->iSpatialLayerNum; i++) {
+    if (m_pPreparedPic[i] == NULL) {
+      m_pPreparedPic[i] = AllocPicture (pMa, pSvcParam->sSpatialLayers[i].iVideoWidth,
+                                        pSvcParam->sSpatialLayers[i].iVideoHeight, false, 0);
+      WELS_VERIFY_RETURN_IF (1, (NULL == m_pPreparedPic[i]))
+    }
+  }
+  if (m_sScaledPicture.pScaledInputPicture != NULL && m_pPreparedScaledInput == NULL) {
+    m_pPreparedScaledInput = AllocScaledInputPicture (pMa, pSvcParam->SUsedPicRect.iWidth,
+                             pSvcParam->SUsedPicRect.iHeight);
+    WELS_VERIFY_RETURN_IF (1, (NULL == m_pPreparedScaledInput))
+  }
+  return 0;
+}
+
+void CWelsPreProcess::FreePreparedPictures (CMemoryAlign* pMa) {
+  for (int32_t i = 0; i < MAX_DEPENDENCY_LAYER; i++) {
+    if (m_pPreparedPic[i] != NULL)
+      FreePicture (pMa, &m_pPreparedPic[i]);
+  }
+  if (m_pPreparedScaledInput != NULL)
+    FreePicture (pMa, &m_pPreparedScaledInput);
+  m_bPicPrepared = m_bUsePreparedPic = false;
+}
+
+/*
+ *  prepare kpSrcPic on the calling thread, initializing the pre-processing for its size first
+ *  @return: 0 - success; -1 - failed
+ */
+int32_t CWelsPreProcess::PrepareSpatialPictures (sWelsEncCtx* pCtx, const SSourcePicture* kpSrcPic) {
+  SWelsSvcCodingParam* pSvcParam = pCtx->pSvcParam;
+  int32_t iWidth = ((kpSrcPic->iPicWidth >> 1) << 1);
+  int32_t iHeight = ((kpSrcPic->iPicHeight >> 1) << 1);
+
+  if (!m_bInitDone) {
+    if (WelsPreprocessCreate() != 0)
+      return -1;
+
+    if (WelsPreprocessReset (pCtx, iWidth, iHeight) != 0)
+      return -1;
+
+    m_iAvaliableRefInSpatialPicList = pSvcParam->iNumRefFrame;
+
+    m_bInitDone = true;
+  } else if ((iWidth != pSvcParam->SUsedPicRect.iWidth) || (iHeight != pSvcParam->SUsedPicRect.iHeight)) {
+    if (WelsPreprocessReset (pCtx, iWidth, iHeight) != 0)
+      return -1;
+  }
+  if (AllocPreparedPictures (pCtx) != 0)
+    return -1;
+
+  PrepareLayerPictures (m_pPrepareVp, pSvcParam, kpSrcPic, m_pPreparedScaledInput, m_pPreparedPic);
+  m_sPreparedSrcPic = *kpSrcPic;
+  memset (m_sPreparedSrcPic.pData, 0, sizeof (m_sPreparedSrcPic.pData));
+  m_bPicPrepared = true;
+  return 0;
+}
+
+/*
+ *  queue the preparation of kpSrcPic on the thread pool, when it needs no re-initialization
+ *  @return: false when not queued, the frame is then prepared by PrepareSpatialPictures() once the former is coded
+ */
+bool CWelsPreProcess::PrepareSpatialPicturesAhead (sWelsEncCtx* pCtx, const SSourcePicture* kpSrcPic) {
+  SWelsSvcCodingParam* pSvcParam = pCtx->pSvcParam;
+  int32_t iWidth = ((kpSrcPic->iPicWidth >> 1) << 1);
+  int32_t iHeight = ((kpSrcPic->iPicHeight >> 1) << 1);
+
+  if (!m_bInitDone || m_bPicPrepared || (iWidth != pSvcParam->SUsedPicRect.iWidth)
+      || (iHeight != pSvcParam->SUsedPicRect.iHeight) || AllocPreparedPictures (pCtx) != 0)
+    return false;
+
+  if (m_pThreadPool == NULL) {
+    m_pThreadPool = WelsCommon::CWelsThreadPool::AddReference();
+    if (m_pThreadPool == NULL)
+      return false;
+  }
+  if (m_pPrepareTask == NULL) {
+    m_pPrepareTask = WELS_NEW_OP (CWelsPrepareTask (this), CWelsPrepareTask);
+    if (m_pPrepareTask == NULL)
+      return false;
+  }
+  if (!m_pPrepareTask->Queue (m_pThreadPool, kpSrcPic))
+    return false;
+
+  m_sPreparedSrcPic = *kpSrcPic;
+  memset (m_sPreparedSrcPic.pData, 0, sizeof (m_sPreparedSrcPic.pData));
+  return true;
+}
+
+/*
+ *  wait for the preparation queued by PrepareSpatialPicturesAhead()
+ *  @return: false when the task was cancelled without preparing the frame
+ */
+bool CWelsPreProcess::WaitPreparedSpatialPictures() {
+  m_bPicPrepared = m_pPrepareTask->Wait();
+  return m_bPicPrepared;
+}
+
+/*
+ *  make the prepared frame the current one of the spatial lists, pSrcPic gets its description for the coding.
+ *  Only the planes are exchanged: the pictures keep their place in the lists and whatever refers to them.
+ */
+void CWelsPreProcess::UsePreparedSpatialPictures (sWelsEncCtx* pCtx, SSourcePicture* pSrcPic) {
+  for (int32_t i = 0; i < pCtx->pSvcParam->iSpatialLayerNum; i++) {
+    SPicture* pCurPic = GetCurrentOrigFrame (i);
+    SPicture* pPreparedPic = m_pPreparedPic[i];
+    uint8_t* pBuffer = pCurPic->pBuffer;
+
+    pCurPic->pBuffer = pPreparedPic->pBuffer;
+    pPreparedPic->pBuffer = pBuffer;
+    for (int32_t j = 0; j < 3; j++) {
+      uint8_t* pData = pCurPic->pData[j];
+      pCurPic->pData[j] = pPreparedPic->pData[j];
+      pPreparedPic->pData[j] = pData;
+    }
+  }
+  *pSrcPic = m_sPreparedSrcPic;
+  m_bPicPrepared = false;
+  m_bUsePreparedPic = true;
+}
+
+void CWelsPreProcess::DropPreparedSpatialPictures() {
+  m_bPicPrepared = false;
+}
+
 SPicture* CWelsPreProcess::GetBestRefPic (EUsageType iUsageType, bool bSceneLtr, EWelsSliceType eSliceType,
     int32_t kiDidx, int32_t iRefTemporalIdx) {
   assert (iUsageType == SCREEN_CONTENT_REAL_TIME);
@@ -348,24 +569,12 @@ int32_t CWelsPreProcess::SingleLayerPreprocess (sWelsEncCtx* pCtx, const SSource
   SWelsSvcCodingParam* pSvcParam    = pCtx->pSvcParam;
   int8_t  iDependencyId             = pSvcParam->iSpatialLayerNum - 1;
 
-  SPicture* pSrcPic                 = NULL; // large
-  SPicture* pDstPic                 = NULL; // small
-  SSpatialLayerConfig* pDlayerParam = NULL;
+  SPicture* pDstPic                 = NULL;
   SSpatialLayerInternal* pDlayerParamInternal = NULL;
   int32_t iSpatialNum               = 0;
-  int32_t iSrcWidth                 = 0;
-  int32_t iSrcHeight                = 0;
-  int32_t iTargetWidth              = 0;
-  int32_t iTargetHeight             = 0;
   int32_t iTemporalId = 0;
-  int32_t iClosestDid =  iDependencyId;
   pDlayerParamInternal = &pSvcParam->sDependencyLayers[iDependencyId];
-  pDlayerParam = &pSvcParam->sSpatialLayers[iDependencyId];
-  iTargetWidth   = pDlayerParam->iVideoWidth;
-  iTargetHeight  = pDlayerParam->iVideoHeight;
 
-  iSrcWidth   = pSvcParam->SUsedPicRect.iWidth;
-  iSrcHeight  = pSvcParam->SUsedPicRect.iHeight;
   if (pSvcParam->uiIntraPeriod) {
     pCtx->pVaa->bIdrPeriodFlag = (1 + pDlayerParamInternal->iFrameIndex >= (int32_t)pSvcParam->uiIntraPeriod) ? true :
                                  false;
@@ -377,26 +586,14 @@ int32_t CWelsPreProcess::SingleLayerPreprocess (sWelsEncCtx* pCtx, const SSource
     }
   }
 
-  pSrcPic = pScaledPicture->pScaledInputPicture ? pScaledPicture->pScaledInputPicture : GetCurrentOrigFrame (
-              iDependencyId);
-
-  WelsMoveMemoryWrapper (pSvcParam, pSrcPic, kpSrc, iSrcWidth, iSrcHeight);
-
-  if (pSvcParam->bEnableDenoise)
-    BilateralDenoising (pSrcPic, iSrcWidth, iSrcHeight);
-
-  // different scaling in between input picture and dst highest spatial picture.
-  int32_t iShrinkWidth  = iSrcWidth;
-  int32_t iShrinkHeight = iSrcHeight;
-  pDstPic = pSrcPic;
-  if (pScaledPicture->pScaledInputPicture) {
-    // for highest downsampling
-    pDstPic = GetCurrentOrigFrame (iDependencyId);
-    iShrinkWidth = pScaledPicture->iScaledWidth[iDependencyId];
-    iShrinkHeight = pScaledPicture->iScaledHeight[iDependencyId];
+  // NULL: the current pictures were filled by PrepareSpatialPictures()
+  if (kpSrc != NULL) {
+    SPicture* pCurPic[MAX_DEPENDENCY_LAYER];
+    for (int32_t i = 0; i < pSvcParam->iSpatialLayerNum; i++)
+      pCurPic[i] = GetCurrentOrigFrame (i);
+    PrepareLayerPictures (m_pInterfaceVp, pSvcParam, kpSrc, pScaledPicture->pScaledInputPicture, pCurPic);
   }
-  DownsamplePadding (pSrcPic, pDstPic, iSrcWidth, iSrcHeight, iShrinkWidth, iShrinkHeight, iTargetWidth, iTargetHeight,
-                     false);
+  pDstPic = GetCurrentOrigFrame (iDependencyId);
 
   if (pSvcParam->bEnableSceneChangeDetect && !pCtx->pVaa->bIdrPeriodFlag) {
     if (pSvcParam->iUsageType == SCREEN_CONTENT_REAL_TIME) {
@@ -435,47 +632,110 @@ int32_t CWelsPreProcess::SingleLayerPreprocess (sWelsEncCtx* pCtx, const SSource
   m_pLastSpatialPicture[iDependencyId][1] = GetCurrentOrigFrame (iDependencyId);
   -- iDependencyId;
 
+  // other spatial layers, downsampled by PrepareLayerPictures()
+  while (iDependencyId >= 0) {
+    pDlayerParamInternal = &pSvcParam->sDependencyLayers[iDependencyId];
+    iTemporalId = pDlayerParamInternal->uiCodingIdx2TemporalId[pDlayerParamInternal->iCodingIndex &
+                  (pSvcParam->uiGopSize - 1)];
+    pDstPic = GetCurrentOrigFrame (iDependencyId);
 
-  // generate other spacial layer
-  // pSrc is
-  //    -- padded input pic, if downsample should be applied to generate highest layer, [if] block above
-  //    -- highest layer, if no downsampling, [else] block above
-  if (pSvcParam->iSpatialLayerNum > 1) {
-    while (iDependencyId >= 0) {
-      pDlayerParamInternal = &pSvcParam->sDependencyLayers[iDependencyId];
-      pDlayerParam = &pSvcParam->sSpatialLayers[iDependencyId];
-      SPicture* pSrcPic  = m_pLastSpatialPicture[iClosestDid][1]; // large
-      iTargetWidth  = pDlayerParam->iVideoWidth;
-      iTargetHeight = pDlayerParam->iVideoHeight;
-      iTemporalId = pDlayerParamInternal->uiCodingIdx2TemporalId[pDlayerParamInternal->iCodingIndex &
-                    (pSvcParam->uiGopSize - 1)];
-
-      // down sampling performed
-      int32_t iSrcWidth                 = pScaledPicture->iScaledWidth[iClosestDid];
-      int32_t iSrcHeight                = pScaledPicture->iScaledHeight[iClosestDid];
-      pDstPic = GetCurrentOrigFrame (iDependencyId); // small
-      iShrinkWidth = pScaledPicture->iScaledWidth[iDependencyId];
-      iShrinkHeight = pScaledPicture->iScaledHeight[iDependencyId];
-      DownsamplePadding (pSrcPic, pDstPic, iSrcWidth, iSrcHeight, iShrinkWidth, iShrinkHeight, iTargetWidth, iTargetHeight,
-                         true);
-
-      if ((iTemporalId != INVALID_TEMPORAL_ID)) {
-        WelsUpdateSpatialIdxMap (pCtx, iActualSpatialNum, pDstPic, iDependencyId);
-        iActualSpatialNum--;
-      }
+    if ((iTemporalId != INVALID_TEMPORAL_ID)) {
+      WelsUpdateSpatialIdxMap (pCtx, iActualSpatialNum, pDstPic, iDependencyId);
+      iActualSpatialNum--;
+    }
 
-      m_pLastSpatialPicture[iDependencyId][1] = pDstPic;
+    m_pLastSpatialPicture[iDependencyId][1] = pDstPic;
+    -- iDependencyId;
+  }
+  return iSpatialNum;
 
-      iClosestDid = iDependencyId;
-      -- iDependencyId;
+}
 
-    }
+/*
+ *  PrepareLayerPictures: copy, denoise and downsample the input into ppDstPic[], one picture per spatial layer.
+ *  Depends on the input and the configuration only, so it may run on another thread than the coding.
+ */
+void CWelsPreProcess::PrepareLayerPictures (IWelsVP* pInterfaceVp, SWelsSvcCodingParam* pSvcParam,
+    const SSourcePicture* kpSrc, SPicture* pScaledInputPic, SPicture** ppDstPic) {
+  int8_t  iDependencyId             = pSvcParam->iSpatialLayerNum - 1;
+  SSpatialLayerConfig* pDlayerParam = &pSvcParam->sSpatialLayers[iDependencyId];
+  SPicture* pSrcPic                 = NULL; // large
+  SPicture* pDstPic                 = NULL; // small
+  int32_t iSrcWidth                 = pSvcParam->SUsedPicRect.iWidth;
+  int32_t iSrcHeight                = pSvcParam->SUsedPicRect.iHeight;
+  int32_t iTargetWidth              = pDlayerParam->iVideoWidth;
+  int32_t iTargetHeight             = pDlayerParam->iVideoHeight;
+  int32_t iClosestDid               = iDependencyId;
+
+  pSrcPic = pScaledInputPic ? pScaledInputPic : ppDstPic[iDependencyId];
+
+  WelsMoveMemoryWrapper (pSvcParam, pSrcPic, kpSrc, iSrcWidth, iSrcHeight);
+
+  if (pSvcParam->bEnableDenoise)
+    BilateralDenoising (pInterfaceVp, pSrcPic, iSrcWidth, iSrcHeight);
+
+  // different scaling in between input picture and dst highest spatial picture.
+  int32_t iShrinkWidth  = iSrcWidth;
+  int32_t iShrinkHeight = iSrcHeight;
+  pDstPic = pSrcPic;
+  if (pScaledInputPic) {
+    // for highest downsampling
+    pDstPic = ppDstPic[iDependencyId];
+    iShrinkWidth = m_sScaledPicture.iScaledWidth[iDependencyId];
+    iShrinkHeight = m_sScaledPicture.iScaledHeight[iDependencyId];
   }
-  return iSpatialNum;
+  DownsamplePadding (pInterfaceVp, pSrcPic, pDstPic, iSrcWidth, iSrcHeight, iShrinkWidth, iShrinkHeight, iTargetWidth,
+                     iTargetHeight, false);
+  -- iDependencyId;
 
+  // generate other spacial layer
+  // pSrc is
+  //    -- padded input pic, if downsample should be applied to generate highest layer, [if] block above
+  //    -- highest layer, if no downsampling, [else] block above
+  while (iDependencyId >= 0) {
+    pDlayerParam = &pSvcParam->sSpatialLayers[iDependencyId];
+    pSrcPic  = ppDstPic[iClosestDid]; // large
+    iTargetWidth  = pDlayerParam->iVideoWidth;
+    iTargetHeight = pDlayerParam->iVideoHeight;
+
+    // down sampling performed
+    iSrcWidth     = m_sScaledPicture.iScaledWidth[iClosestDid];
+    iSrcHeight    = m_sScaledPicture.iScaledHeight[iClosestDid];
+    pDstPic       = ppDstPic[iDependencyId]; // small
+    iShrinkWidth  = m_sScaledPicture.iScaledWidth[iDependencyId];
+    iShrinkHeight = m_sScaledPicture.iScaledHeight[iDependencyId];
+    DownsamplePadding (pInterfaceVp, pSrcPic, pDstPic, iSrcWidth, iSrcHeight, iShrinkWidth, iShrinkHeight, iTargetWidth,
+                       iTargetHeight, true);
+
+    iClosestDid = iDependencyId;
+    -- iDependencyId;
+  }
 }
 
 
+/*!
+ * \brief   picture holding the input before its downsampling
+ */
+SPicture* AllocScaledInputPicture (CMemoryAlign* pMemoryAlign, const int32_t kiWidth, const int32_t kiHeight) {
+  SPicture* pPic = AllocPicture (pMemoryAlign, kiWidth, kiHeight, false, 0);
+  if (pPic == NULL)
+    return NULL;
+
+  // Avoid valgrind false positives.
+  //
+  // X86 SIMD downsampling routines may, for convenience, read slightly beyond
+  // the input data and into the alignment padding area beyond each line. This
+  // causes valgrind to warn about uninitialized values even if these values
+  // only affect lanes of a SIMD vector that are effectively never used.
+  //
+  // Avoid these false positives by zero-initializing the padding area beyond
+  // each line of the source buffer used for downsampling.
+  ClearEndOfLinePadding (pPic->pData[0], pPic->iLineSize[0], pPic->iWidthInPixel, pPic->iHeightInPixel);
+  ClearEndOfLinePadding (pPic->pData[1], pPic->iLineSize[1], pPic->iWidthInPixel >> 1, pPic->iHeightInPixel >> 1);
+  ClearEndOfLinePadding (pPic->pData[2], pPic->iLineSize[2], pPic->iWidthInPixel >> 1, pPic->iHeightInPixel >> 1);
+  return pPic;
+}
+
 /*!
  * \brief   Whether input picture need be scaled?
  */
@@ -514,24 +774,10 @@ bool JudgeNeedOfScaling (SWelsSvcCodingParam* pParam, Scaled_Picture* pScaledPic
 int32_t  WelsInitScaledPic (SWelsSvcCodingParam* pParam,  Scaled_Picture*  pScaledPicture, CMemoryAlign* pMemoryAlign) {
   bool bInputPicNeedScaling = JudgeNeedOfScaling (pParam, pScaledPicture);
   if (bInputPicNeedScaling) {
-    pScaledPicture->pScaledInputPicture = AllocPicture (pMemoryAlign, pParam->SUsedPicRect.iWidth,
-                                          pParam->SUsedPicRect.iHeight, false, 0);
+    pScaledPicture->pScaledInputPicture = AllocScaledInputPicture (pMemoryAlign, pParam->SUsedPicRect.iWidth,
+                                          pParam->SUsedPicRect.iHeight);
     if (pScaledPicture->pScaledInputPicture == NULL)
       return -1;
-
-    // Avoid valgrind false positives.
-    //
-    // X86 SIMD downsampling routines may, for convenience, read slightly beyond
-    // the input data and into the alignment padding area beyond each line. This
-    // causes valgrind to warn about uninitialized values even if these values
-    // only affect lanes of a SIMD vector that are effectively never used.
-    //
-    // Avoid these false positives by zero-initializing the padding area beyond
-    // each line of the source buffer used for downsampling.
-    SPicture* pPic = pScaledPicture->pScaledInputPicture;
-    ClearEndOfLinePadding (pPic->pData[0], pPic->iLineSize[0], pPic->iWidthInPixel, pPic->iHeightInPixel);
-    ClearEndOfLinePadding (pPic->pData[1], pPic->iLineSize[1], pPic->iWidthInPixel >> 1, pPic->iHeightInPixel >> 1);
-    ClearEndOfLinePadding (pPic->pData[2], pPic->iLineSize[2], pPic->iWidthInPixel >> 1, pPic->iHeightInPixel >> 1);
   }
   return 0;
 }
@@ -571,7 +817,8 @@ int32_t CWelsPreProcess::ColorspaceConvert (SWelsSvcCodingParam* pSvcParam, SPic
   //not support yet
 }
 
-void CWelsPreProcess::BilateralDenoising (SPicture* pSrc, const int32_t kiWidth, const int32_t kiHeight) {
+void CWelsPreProcess::BilateralDenoising (IWelsVP* pInterfaceVp, SPicture* pSrc, const int32_t kiWidth,
+    const int32_t kiHeight) {
   int32_t iMethodIdx = METHOD_DENOISE;
   SPixMap sSrcPixMap;
   memset (&sSrcPixMap, 0, sizeof (sSrcPixMap));
@@ -586,7 +833,7 @@ void CWelsPreProcess::BilateralDenoising (SPicture* pSrc, const int32_t kiWidth,
   sSrcPixMap.iStride[2] = pSrc->iLineSize[2];
   sSrcPixMap.eFormat = VIDEO_FORMAT_I420;
 
-  m_pInterfaceVp->Process (iMethodIdx, &sSrcPixMap, NULL);
+  pInterfaceVp->Process (iMethodIdx, &sSrcPixMap, NULL);
 }
 
 ESceneChangeIdc CWelsPreProcessVideo::DetectSceneChange (SPicture* pCurPicture, SPicture* pRefPicture) {
@@ -622,8 +869,20 @@ SPicture* CWelsPreProcessVideo::GetCurrentOrigFrame (int32_t iDIdx) {
   return m_pSpatialPic[iDIdx][GetCurPicPosition (iDIdx)];
 }
 
-int32_t CWelsPreProcess::DownsamplePadding (SPicture* pSrc, SPicture* pDstPic,  int32_t iSrcWidth, int32_t iSrcHeight,
-    int32_t iShrinkWidth, int32_t iShrinkHeight, int32_t iTargetWidth, int32_t iTargetHeight, bool bForceCopy) {
+void CWelsPreProcess::BuildMePyramid (SPicture* pSrc, SPicture** ppLevel, const int32_t kiLevels) {
+  SPicture* pUpper = pSrc;
+  for (int32_t i = 0; i < kiLevels; i++) {
+    const int32_t kiWidth  = ppLevel[i]->iWidthInPixel;
+    const int32_t kiHeight = ppLevel[i]->iHeightInPixel;
+    DownsamplePadding (m_pInterfaceVp, pUpper, ppLevel[i], kiWidth << 1, kiHeight << 1, kiWidth, kiHeight, kiWidth,
+                       kiHeight, false);
+    pUpper = ppLevel[i];
+  }
+}
+
+int32_t CWelsPreProcess::DownsamplePadding (IWelsVP* pInterfaceVp, SPicture* pSrc, SPicture* pDstPic,
+    int32_t iSrcWidth, int32_t iSrcHeight, int32_t iShrinkWidth, int32_t iShrinkHeight, int32_t iTargetWidth,
+    int32_t iTargetHeight, bool bForceCopy) {
   int32_t iRet = 0;
   SPixMap sSrcPixMap;
   SPixMap sDstPicMap;
@@ -654,7 +913,7 @@ int32_t CWelsPreProcess::DownsamplePadding (SPicture* pSrc, SPicture* pDstPic,
     sDstPicMap.eFormat     = VIDEO_FORMAT_I420;
 
     if (iSrcWidth != iShrinkWidth || iSrcHeight != iShrinkHeight) {
-      iRet = m_pInterfaceVp->Process (iMethodIdx, &sSrcPixMap, &sDstPicMap);
+      iRet = pInterfaceVp->Process (iMethodIdx, &sSrcPixMap, &sDstPicMap);
     } else {
       WelsMoveMemory_c (pDstPic->pData[0], pDstPic->pData[1], pDstPic->pData[2], pDstPic->iLineSize[0], pDstPic->iLineSize[1],
                         pSrc->pData[0], pSrc->pData[1], pSrc->pData[2], pSrc->iLineSize[0], pSrc->iLineSize[1],
@@ -76,7 +76,8 @@ class CWelsH264SVCEncoder : public ISVCEncoder {
    * return: 0 - success; otherwise - failed;
    */
   virtual int EXTAPI EncodeFrame (const SSourcePicture* kpSrcPic, SFrameBSInfo* pBsInfo);
-  virtual int        EncodeFrameInternal (const SSourcePicture* kpSrcPic, SFrameBSInfo* pBsInfo);
+  virtual int        EncodeFrameInternal (const SSourcePicture* kpSrcPic, SFrameBSInfo* pBsInfo,
+                                          const bool kbAsync = false);
 
   /*
    * return: 0 - success; otherwise - failed;
@@ -96,6 +97,12 @@ class CWelsH264SVCEncoder : public ISVCEncoder {
   virtual int EXTAPI SetOption (ENCODER_OPTION opt_id, void* option);
   virtual int EXTAPI GetOption (ENCODER_OPTION opt_id, void* option);
 
+  /*
+   * return: 0 - success; otherwise - failed;
+   */
+  virtual int EXTAPI EncodeFrameAsync (const SSourcePicture* kpSrcPic);
+  virtual int EXTAPI GetEncodedFrame (SFrameBSInfo* pBsInfo);
+
  private:
   int InitializeInternal (SWelsSvcCodingParam* argv);
   void TraceParamInfo(SEncParamExt *pParam);
@@ -111,6 +118,9 @@ class CWelsH264SVCEncoder : public ISVCEncoder {
   int32_t           m_iCspInternal;
   bool              m_bInitialFlag;
 
+  SFrameBSInfo      m_sAsyncBsInfo;     // output of the last EncodeFrameAsync()
+  bool              m_bAsyncBsReady;    // m_sAsyncBsInfo not fetched yet by GetEncodedFrame()
+
 #ifdef OUTPUT_BIT_STREAM
   FILE*             m_pFileBs;
   FILE*             m_pFileBsSize;
@@ -65,7 +65,9 @@ CWelsH264SVCEncoder::CWelsH264SVCEncoder()
     m_iMaxPicWidth (0),
     m_iMaxPicHeight (0),
     m_iCspInternal (0),
-    m_bInitialFlag (false) {
+    m_bInitialFlag (false),
+    m_bAsyncBsReady (false) {
+  memset (&m_sAsyncBsInfo, 0, sizeof (m_sAsyncBsInfo));
 #ifdef REC_FRAME_COUNT
   int32_t m_uiCountFrameNum = 0;
 #endif//REC_FRAME_COUNT
@@ -359,11 +361,15 @@ int32_t CWelsH264SVCEncoder::Uninitialize() {
            VERSION_NUMBER);
 
   if (NULL != m_pEncContext) {
+    if (WelsEncoderHasPendingFrame (m_pEncContext))
+      WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_WARNING,
+               "CWelsH264SVCEncoder::Uninitialize(), the frame pending in EncodeFrameAsync() is dropped.");
     WelsUninitEncoderExt (&m_pEncContext);
     m_pEncContext = NULL;
   }
 
   m_bInitialFlag = false;
+  m_bAsyncBsReady = false;
 
   return 0;
 }
@@ -382,6 +388,11 @@ int CWelsH264SVCEncoder::EncodeFrame (const SSourcePicture* kpSrcPic, SFrameBSIn
              kpSrcPic->iColorFormat);
     return cmInitParaError;
   }
+  if (WelsEncoderHasPendingFrame (m_pEncContext)) {
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_ERROR,
+             "CWelsH264SVCEncoder::EncodeFrame(), a frame is pending in EncodeFrameAsync(), flush it first.");
+    return cmInitExpected;
+  }
 
   const int32_t kiEncoderReturn = EncodeFrameInternal (kpSrcPic, pBsInfo);
 
@@ -401,16 +412,22 @@ int CWelsH264SVCEncoder::EncodeFrame (const SSourcePicture* kpSrcPic, SFrameBSIn
 }
 
 
-int CWelsH264SVCEncoder ::EncodeFrameInternal (const SSourcePicture*  pSrcPic, SFrameBSInfo* pBsInfo) {
+/*
+ *  kbAsync: pipelined encoding, pSrcPic is prepared while the frame pending from the former call is coded into
+ *  pBsInfo, it may be NULL to flush that frame
+ */
+int CWelsH264SVCEncoder ::EncodeFrameInternal (const SSourcePicture*  pSrcPic, SFrameBSInfo* pBsInfo,
+    const bool kbAsync) {
 
-  if ((pSrcPic->iPicWidth < 16) || ((pSrcPic->iPicHeight < 16))) {
+  if (pSrcPic != NULL && ((pSrcPic->iPicWidth < 16) || ((pSrcPic->iPicHeight < 16)))) {
     WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_ERROR, "Don't support width(%d) or height(%d) which is less than 16!",
              pSrcPic->iPicWidth, pSrcPic->iPicHeight);
     return cmUnsupportedData;
   }
 
   const int64_t kiBeforeFrameUs = WelsTime();
-  const int32_t kiEncoderReturn = WelsEncoderEncodeExt (m_pEncContext, pBsInfo, pSrcPic);
+  const int32_t kiEncoderReturn = kbAsync ? WelsEncoderEncodeAsync (m_pEncContext, pBsInfo, pSrcPic) :
+                                  WelsEncoderEncodeExt (m_pEncContext, pBsInfo, pSrcPic);
   const int64_t kiCurrentFrameMs = (WelsTime() - kiBeforeFrameUs) / 1000;
   if ((kiEncoderReturn == ENC_RETURN_MEMALLOCERR) || (kiEncoderReturn == ENC_RETURN_MEMOVERFLOWFOUND)
       || (kiEncoderReturn == ENC_RETURN_VLCOVERFLOWFOUND)) {
@@ -424,7 +441,8 @@ int CWelsH264SVCEncoder ::EncodeFrameInternal (const SSourcePicture*  pSrcPic, S
     return cmUnknownReason;
   }
 
-  UpdateStatistics (pBsInfo, kiCurrentFrameMs);
+  if (pBsInfo->eFrameType != videoFrameTypeInvalid) // nothing coded by the first EncodeFrameAsync()
+    UpdateStatistics (pBsInfo, kiCurrentFrameMs);
 
   ///////////////////for test
 #ifdef OUTPUT_BIT_STREAM
@@ -470,13 +488,64 @@ int CWelsH264SVCEncoder ::EncodeFrameInternal (const SSourcePicture*  pSrcPic, S
   }
 #endif //OUTPUT_BIT_STREAM
 #ifdef DUMP_SRC_PICTURE
-  DumpSrcPicture (pSrcPic, m_pEncContext->pSvcParam->iUsageType);
+  if (pSrcPic != NULL)
+    DumpSrcPicture (pSrcPic, m_pEncContext->pSvcParam->iUsageType);
 #endif // DUMP_SRC_PICTURE
 
   return cmResultSuccess;
 
 }
 
+/*
+ *  SVC pipelined encoding: prepare kpSrcPic on the thread pool while the frame of the former call is coded
+ */
+int CWelsH264SVCEncoder::EncodeFrameAsync (const SSourcePicture* kpSrcPic) {
+  if (! (m_bInitialFlag && m_pEncContext)) {
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_ERROR, "CWelsH264SVCEncoder::EncodeFrameAsync(), cmInitExpected.");
+    return cmInitExpected;
+  }
+  if (kpSrcPic != NULL && kpSrcPic->iColorFormat != videoFormatI420) {
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_ERROR, "CWelsH264SVCEncoder::EncodeFrameAsync(), wrong iColorFormat %d",
+             kpSrcPic->iColorFormat);
+    return cmInitParaError;
+  }
+
+  m_bAsyncBsReady = false;
+  const int32_t kiEncoderReturn = EncodeFrameInternal (kpSrcPic, &m_sAsyncBsInfo, true);
+
+  if (kiEncoderReturn != cmResultSuccess) {
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_ERROR, "CWelsH264SVCEncoder::EncodeFrameAsync(), kiEncoderReturn %d",
+             kiEncoderReturn);
+    return kiEncoderReturn;
+  }
+  m_bAsyncBsReady = (m_sAsyncBsInfo.eFrameType != videoFrameTypeInvalid);
+
+#ifdef REC_FRAME_COUNT
+  if (m_bAsyncBsReady) {
+    ++ m_uiCountFrameNum;
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_INFO,
+             "CWelsH264SVCEncoder::EncodeFrameAsync(), m_uiCountFrameNum= %d,", m_uiCountFrameNum);
+  }
+#endif//REC_FRAME_COUNT
+
+  return kiEncoderReturn;
+}
+
+int CWelsH264SVCEncoder::GetEncodedFrame (SFrameBSInfo* pBsInfo) {
+  if (NULL == pBsInfo) {
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_ERROR, "CWelsH264SVCEncoder::GetEncodedFrame(), cmInitParaError.");
+    return cmInitParaError;
+  }
+  if (m_bAsyncBsReady) {
+    *pBsInfo = m_sAsyncBsInfo;
+    m_bAsyncBsReady = false;
+  } else {
+    memset (pBsInfo, 0, sizeof (SFrameBSInfo));
+    pBsInfo->eFrameType = videoFrameTypeInvalid;
+  }
+  return cmResultSuccess;
+}
+
 int CWelsH264SVCEncoder::EncodeParameterSets (SFrameBSInfo* pBsInfo) {
   return WelsEncoderEncodeParameterSets (m_pEncContext, pBsInfo);
 }
@@ -502,7 +571,7 @@ void CWelsH264SVCEncoder::TraceParamInfo (SEncParamExt* pParam) {
   WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_INFO,
            "iUsageType = %d,iPicWidth= %d;iPicHeight= %d;iTargetBitrate= %d;iMaxBitrate= %d;iRCMode= %d;iPaddingFlag= %d;iTemporalLayerNum= %d;iSpatialLayerNum= %d;fFrameRate= %.6ff;uiIntraPeriod= %d;"
            "eSpsPpsIdStrategy = %d;bPrefixNalAddingCtrl = %d;bSimulcastAVC=%d;bEnableDenoise= %d;bEnableBackgroundDetection= %d;bEnableSceneChangeDetect = %d;bEnableAdaptiveQuant= %d;bEnableFrameSkip= %d;bEnableLongTermReference= %d;iLtrMarkPeriod= %d, bIsLosslessLink=%d;"
-           "iComplexityMode = %d;iNumRefFrame = %d;iEntropyCodingModeFlag = %d;uiMaxNalSize = %d;iLTRRefNum = %d;iMultipleThreadIdc = %d;iLoopFilterDisableIdc = %d (offset(alpha/beta): %d,%d;iComplexityMode = %d,iMaxQp = %d;iMinQp = %d)",
+           "iComplexityMode = %d;iNumRefFrame = %d;iEntropyCodingModeFlag = %d;uiMaxNalSize = %d;iLTRRefNum = %d;iMultipleThreadIdc = %d;bUseWavefront = %d;iHierarchicalMeLevels = %d;iLoopFilterDisableIdc = %d (offset(alpha/beta): %d,%d;iComplexityMode = %d,iMaxQp = %d;iMinQp = %d)",
            pParam->iUsageType,
            pParam->iPicWidth,
            pParam->iPicHeight,
@@ -531,6 +600,8 @@ void CWelsH264SVCEncoder::TraceParamInfo (SEncParamExt* pParam) {
            pParam->uiMaxNalSize,
            pParam->iLTRRefNum,
            pParam->iMultipleThreadIdc,
+           pParam->bUseWavefront,
+           pParam->iHierarchicalMeLevels,
            pParam->iLoopFilterDisableIdc,
            pParam->iLoopFilterAlphaC0Offset,
            pParam->iLoopFilterBetaOffset,
@@ -694,6 +765,15 @@ int CWelsH264SVCEncoder::SetOption (ENCODER_OPTION eOptionId, void* pOption) {
       && eOptionId != ENCODER_OPTION_TRACE_CALLBACK && eOptionId != ENCODER_OPTION_TRACE_CALLBACK_CONTEXT) {
     return cmInitExpected;
   }
+  // these may re-allocate the encoder, the frame pending in EncodeFrameAsync() would not be coded as prepared
+  if ((eOptionId == ENCODER_OPTION_SVC_ENCODE_PARAM_BASE || eOptionId == ENCODER_OPTION_SVC_ENCODE_PARAM_EXT
+       || eOptionId == ENCODER_OPTION_LTR || eOptionId == ENCODER_OPTION_SPS_PPS_ID_STRATEGY)
+      && WelsEncoderHasPendingFrame (m_pEncContext)) {
+    WelsLog (&m_pWelsTrace->m_sLogCtx, WELS_LOG_WARNING,
+             "CWelsH264SVCEncoder::SetOption(), option %d while a frame is pending in EncodeFrameAsync(), flush it first.",
+             eOptionId);
+    return cmInitExpected;
+  }
 
   switch (eOptionId) {
   case ENCODER_OPTION_INTER_SPATIAL_PRED: { // Inter spatial layer prediction flag
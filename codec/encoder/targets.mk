@@ -19,6 +19,7 @@ ENCODER_CPP_SRCS=\
 	$(ENCODER_SRCDIR)/core/src/set_mb_syn_cabac.cpp\
 	$(ENCODER_SRCDIR)/core/src/set_mb_syn_cavlc.cpp\
 	$(ENCODER_SRCDIR)/core/src/slice_multi_threading.cpp\
+	$(ENCODER_SRCDIR)/core/src/slice_wavefront.cpp\
 	$(ENCODER_SRCDIR)/core/src/svc_base_layer_md.cpp\
 	$(ENCODER_SRCDIR)/core/src/svc_enc_slice_segment.cpp\
 	$(ENCODER_SRCDIR)/core/src/svc_encode_mb.cpp\
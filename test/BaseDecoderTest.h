@@ -21,6 +21,7 @@ class BaseDecoderTest {
     Plane y;
     Plane u;
     Plane v;
+    void* buffer; // SBufferInfo::pFrameBuffer
   };
 
   struct Callback {
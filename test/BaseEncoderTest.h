@@ -14,8 +14,9 @@ class BaseEncoderTest {
   BaseEncoderTest();
   void SetUp();
   void TearDown();
-  void EncodeFile (const char* fileName, SEncParamExt* pEncParamExt, Callback* cbk);
-  void EncodeStream (InputStream* in,  SEncParamExt* pEncParamExt, Callback* cbk);
+  // bAsync: encode through EncodeFrameAsync() / GetEncodedFrame()
+  void EncodeFile (const char* fileName, SEncParamExt* pEncParamExt, Callback* cbk, bool bAsync = false);
+  void EncodeStream (InputStream* in,  SEncParamExt* pEncParamExt, Callback* cbk, bool bAsync = false);
 
   ISVCEncoder* encoder_;
  private:
@@ -105,6 +105,7 @@ void BaseDecoderTest::DecodeFrame (const uint8_t* src, size_t sliceSize, Callbac
         bufInfo.UsrData.sSystemBuffer.iHeight / 2,
         bufInfo.UsrData.sSystemBuffer.iStride[1]
       },
+      bufInfo.pFrameBuffer
     };
     cbk->onDecodeFrame (frame);
   }
@@ -133,6 +134,16 @@ void BaseDecoderTest::DecodeFile (const char* fileName, Callback* cbk) {
 
   // Get pending last frame
   DecodeFrame (NULL, 0, cbk);
+  // and the ones still held by the frame threads
+  int32_t iRemaining = 0;
+  decoder_->GetOption (DECODER_OPTION_NUM_OF_FRAMES_REMAINING_IN_BUFFER, &iRemaining);
+  while (iRemaining > 0) {
+    DecodeFrame (NULL, 0, cbk);
+    if (::testing::Test::HasFatalFailure()) {
+      return;
+    }
+    --iRemaining;
+  }
 }
 
 bool BaseDecoderTest::Open (const char* fileName) {
@@ -84,7 +84,7 @@ void BaseEncoderTest::TearDown() {
   }
 }
 
-void BaseEncoderTest::EncodeStream (InputStream* in, SEncParamExt* pEncParamExt, Callback* cbk) {
+void BaseEncoderTest::EncodeStream (InputStream* in, SEncParamExt* pEncParamExt, Callback* cbk, bool bAsync) {
 
   ASSERT_TRUE (NULL != pEncParamExt);
 
@@ -111,8 +111,21 @@ void BaseEncoderTest::EncodeStream (InputStream* in, SEncParamExt* pEncParamExt,
   pic.pData[0]     = buf.data();
   pic.pData[1]     = pic.pData[0] + pEncParamExt->iPicWidth * pEncParamExt->iPicHeight;
   pic.pData[2]     = pic.pData[1] + (pEncParamExt->iPicWidth * pEncParamExt->iPicHeight >> 2);
-  while (in->read (buf.data(), frameSize) == frameSize) {
-    rv = encoder_->EncodeFrame (&pic, &info);
+  bool bFlushed = false;
+  while (!bFlushed) {
+    if (in->read (buf.data(), frameSize) != frameSize) {
+      if (!bAsync)
+        break;
+      bFlushed = true;
+    }
+    if (bAsync) {
+      // buf is read again before the frame is coded, the encoder must not keep it
+      rv = encoder_->EncodeFrameAsync (bFlushed ? NULL : &pic);
+      ASSERT_TRUE (rv == cmResultSuccess);
+      rv = encoder_->GetEncodedFrame (&info);
+    } else {
+      rv = encoder_->EncodeFrame (&pic, &info);
+    }
     ASSERT_TRUE (rv == cmResultSuccess);
     if (info.eFrameType != videoFrameTypeSkip && cbk != NULL) {
       cbk->onEncodeFrame (info);
@@ -120,9 +133,9 @@ void BaseEncoderTest::EncodeStream (InputStream* in, SEncParamExt* pEncParamExt,
   }
 }
 
-void BaseEncoderTest::EncodeFile (const char* fileName, SEncParamExt* pEncParamExt, Callback* cbk) {
+void BaseEncoderTest::EncodeFile (const char* fileName, SEncParamExt* pEncParamExt, Callback* cbk, bool bAsync) {
   FileInputStream fileStream;
   ASSERT_TRUE (fileStream.Open (fileName));
   ASSERT_TRUE (NULL != pEncParamExt);
-  EncodeStream (&fileStream, pEncParamExt, cbk);
+  EncodeStream (&fileStream, pEncParamExt, cbk, bAsync);
 }
@@ -59,6 +59,14 @@ struct SVCEncoderImpl : public ISVCEncoder {
     EXPECT_TRUE (gThis == this);
     return 9;
   }
+  virtual int EXTAPI EncodeFrameAsync (const SSourcePicture* kpSrcPic) {
+    EXPECT_TRUE (gThis == this);
+    return 10;
+  }
+  virtual int EXTAPI GetEncodedFrame (SFrameBSInfo* pBsInfo) {
+    EXPECT_TRUE (gThis == this);
+    return 11;
+  }
 };
 
 struct SVCDecoderImpl : public ISVCDecoder {
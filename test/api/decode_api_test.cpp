@@ -6,6 +6,7 @@
 #include "BaseEncoderTest.h"
 #include "wels_common_defs.h"
 #include "utils/HashFunctions.h"
+#include "measure_time.h"
 #include <string>
 #include <vector>
 #include "encode_decode_api_test.h"
@@ -224,6 +225,624 @@ TEST_P(EncodeDecodeTestAPI, GetOptionIsRefPic) {
   (void)iSkipedBytes;
 }
 
+TEST_F (EncodeDecodeTestAPI, SetOptionSkipFrames) {
+  const int kiWidth = 160, kiHeight = 96;
+  prepareParamDefault (1, 1, kiWidth, kiHeight, 6.0f, &param_);
+  param_.iTemporalLayerNum = 2; //every other picture is not referred to
+  param_.uiIntraPeriod = 8;
+  encoder_->Uninitialize();
+  int rv = encoder_->InitializeExt (&param_);
+  ASSERT_TRUE (rv == cmResultSuccess);
+  ASSERT_TRUE (InitialEncDec (kiWidth, kiHeight));
+  int32_t iTraceLevel = WELS_LOG_QUIET;
+  encoder_->SetOption (ENCODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+  decoder_->SetOption (DECODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+
+  //decoder_ decodes everything, the others skip the non-reference or the non-IDR pictures
+  const int kiSkipModes[2] = {DECODER_SKIP_NON_REF, DECODER_SKIP_NON_IDR};
+  ISVCDecoder* pDecoder[3] = {decoder_, NULL, NULL};
+  for (int i = 1; i < 3; i++) {
+    ASSERT_EQ (0, WelsCreateDecoder (&pDecoder[i]));
+    ASSERT_TRUE (pDecoder[i] != NULL);
+    SDecodingParam decParam;
+    memset (&decParam, 0, sizeof (SDecodingParam));
+    decParam.uiTargetDqLayer = UCHAR_MAX;
+    decParam.eEcActiveIdc = ERROR_CON_SLICE_COPY;
+    decParam.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
+    ASSERT_EQ (0, pDecoder[i]->Initialize (&decParam));
+    pDecoder[i]->SetOption (DECODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+    int iSkipMode = kiSkipModes[i - 1];
+    EXPECT_EQ (0, pDecoder[i]->SetOption (DECODER_OPTION_SKIP_FRAMES, &iSkipMode));
+    iSkipMode = DECODER_SKIP_NONE;
+    pDecoder[i]->GetOption (DECODER_OPTION_SKIP_FRAMES, &iSkipMode);
+    EXPECT_EQ (kiSkipModes[i - 1], iSkipMode);
+  }
+  int iInvalidMode = DECODER_SKIP_NON_IDR + 1;
+  EXPECT_NE (0, pDecoder[1]->SetOption (DECODER_OPTION_SKIP_FRAMES, &iInvalidMode));
+
+  int iNonRefNum = 0, iNonIdrNum = 0;
+  for (int iIdx = 0; iIdx < 24; iIdx++) {
+    EncodeOneFrame (1);
+    int len = 0;
+    encToDecData (info, len);
+    unsigned char* pData[3][3];
+    SBufferInfo sBufInfo[3];
+    int iIsRefPic[3];
+    for (int i = 0; i < 3; i++) {
+      //the picture comes out of either the decoding or the flushing call
+      unsigned char* pDst[3] = { NULL };
+      SBufferInfo sDstInfo;
+      memset (&sBufInfo[i], 0, sizeof (SBufferInfo));
+      memset (&sDstInfo, 0, sizeof (SBufferInfo));
+      pDecoder[i]->DecodeFrame2 (info.sLayerInfo[0].pBsBuf, len, pDst, &sDstInfo);
+      if (sDstInfo.iBufferStatus == 1) {
+        memcpy (pData[i], pDst, sizeof (pDst));
+        sBufInfo[i] = sDstInfo;
+      }
+      memset (&sDstInfo, 0, sizeof (SBufferInfo));
+      pDecoder[i]->DecodeFrame2 (NULL, 0, pDst, &sDstInfo);
+      pDecoder[i]->GetOption (DECODER_OPTION_IS_REF_PIC, &iIsRefPic[i]);
+      if (sDstInfo.iBufferStatus == 1) {
+        memcpy (pData[i], pDst, sizeof (pDst));
+        sBufInfo[i] = sDstInfo;
+      }
+    }
+    const bool kbIdr = info.eFrameType == videoFrameTypeIDR;
+    iNonRefNum += (iIsRefPic[0] == 0);
+    iNonIdrNum += !kbIdr;
+    //the reference feedback is given for the skipped pictures too
+    EXPECT_EQ (iIsRefPic[0], iIsRefPic[1]) << "iIdx = " << iIdx;
+    EXPECT_EQ (iIsRefPic[0], iIsRefPic[2]) << "iIdx = " << iIdx;
+    EXPECT_EQ (1, sBufInfo[0].iBufferStatus) << "iIdx = " << iIdx;
+    EXPECT_EQ (iIsRefPic[0] == 1, sBufInfo[1].iBufferStatus == 1) << "iIdx = " << iIdx;
+    EXPECT_EQ (kbIdr, sBufInfo[2].iBufferStatus == 1) << "iIdx = " << iIdx;
+    for (int i = 1; i < 3; i++) {
+      if (sBufInfo[i].iBufferStatus == 1) {
+        EXPECT_TRUE (CompareDecodedFrames (pData[i], sBufInfo[i], pData[0], sBufInfo[0])) << "iIdx = " << iIdx;
+      }
+    }
+  }
+  EXPECT_GT (iNonRefNum, 0);
+
+  SDecoderStatistics sStatistics;
+  pDecoder[1]->GetOption (DECODER_OPTION_GET_STATISTICS, &sStatistics);
+  EXPECT_EQ ((unsigned int) iNonRefNum, sStatistics.uiSkippedFrameNum);
+  pDecoder[2]->GetOption (DECODER_OPTION_GET_STATISTICS, &sStatistics);
+  EXPECT_EQ ((unsigned int) iNonIdrNum, sStatistics.uiSkippedFrameNum);
+  for (int i = 1; i < 3; i++) {
+    pDecoder[i]->Uninitialize();
+    WelsDestroyDecoder (pDecoder[i]);
+  }
+}
+
+TEST_F (EncodeDecodeTestAPI, FastPreview) {
+  const int kiWidth = 320, kiHeight = 192;
+  prepareParamDefault (1, 1, kiWidth, kiHeight, 6.0f, &param_);
+  param_.iLoopFilterDisableIdc = 1; //the intra pictures of the preview are exact then
+  param_.uiIntraPeriod = 8;
+  encoder_->Uninitialize();
+  int rv = encoder_->InitializeExt (&param_);
+  ASSERT_TRUE (rv == cmResultSuccess);
+  ASSERT_TRUE (InitialEncDec (kiWidth, kiHeight));
+  int32_t iTraceLevel = WELS_LOG_QUIET;
+  encoder_->SetOption (ENCODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+  decoder_->SetOption (DECODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+
+  ISVCDecoder* pDecoder[2] = {decoder_, NULL};
+  ASSERT_EQ (0, WelsCreateDecoder (&pDecoder[1]));
+  ASSERT_TRUE (pDecoder[1] != NULL);
+  SDecodingParam decParam;
+  memset (&decParam, 0, sizeof (SDecodingParam));
+  decParam.uiTargetDqLayer = UCHAR_MAX;
+  decParam.eEcActiveIdc = ERROR_CON_SLICE_COPY;
+  decParam.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
+  decParam.bFastPreview = true;
+  ASSERT_EQ (0, pDecoder[1]->Initialize (&decParam));
+  pDecoder[1]->SetOption (DECODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+
+  for (int iIdx = 0; iIdx < 24; iIdx++) {
+    EncodeOneFrame (1);
+    int len = 0;
+    encToDecData (info, len);
+    unsigned char* pData[2][3];
+    SBufferInfo sBufInfo[2];
+    for (int i = 0; i < 2; i++) {
+      //the picture comes out of either the decoding or the flushing call
+      unsigned char* pDst[3] = { NULL };
+      SBufferInfo sDstInfo;
+      memset (&sBufInfo[i], 0, sizeof (SBufferInfo));
+      memset (&sDstInfo, 0, sizeof (SBufferInfo));
+      EXPECT_EQ (dsErrorFree, pDecoder[i]->DecodeFrame2 (info.sLayerInfo[0].pBsBuf, len, pDst, &sDstInfo));
+      if (sDstInfo.iBufferStatus == 1) {
+        memcpy (pData[i], pDst, sizeof (pDst));
+        sBufInfo[i] = sDstInfo;
+      }
+      memset (&sDstInfo, 0, sizeof (SBufferInfo));
+      pDecoder[i]->DecodeFrame2 (NULL, 0, pDst, &sDstInfo);
+      if (sDstInfo.iBufferStatus == 1) {
+        memcpy (pData[i], pDst, sizeof (pDst));
+        sBufInfo[i] = sDstInfo;
+      }
+    }
+    ASSERT_EQ (1, sBufInfo[0].iBufferStatus) << "iIdx = " << iIdx;
+    ASSERT_EQ (1, sBufInfo[1].iBufferStatus) << "iIdx = " << iIdx;
+    EXPECT_EQ (kiWidth, sBufInfo[1].UsrData.sSystemBuffer.iWidth);
+    EXPECT_EQ (kiHeight, sBufInfo[1].UsrData.sSystemBuffer.iHeight);
+    if (info.eFrameType == videoFrameTypeIDR) {
+      EXPECT_TRUE (CompareDecodedFrames (pData[1], sBufInfo[1], pData[0], sBufInfo[0])) << "iIdx = " << iIdx;
+    }
+  }
+  pDecoder[1]->Uninitialize();
+  WelsDestroyDecoder (pDecoder[1]);
+}
+
+//decode an access unit, the picture comes out of either the decoding or the flushing call
+static void DecodeAccessUnit (ISVCDecoder* pDecoder, const unsigned char* pSrc, int iLen, unsigned char* pData[3],
+                              SBufferInfo* pBufInfo) {
+  unsigned char* pDst[3] = { NULL };
+  SBufferInfo sDstInfo;
+  memset (pBufInfo, 0, sizeof (SBufferInfo));
+  memset (&sDstInfo, 0, sizeof (SBufferInfo));
+  pDecoder->DecodeFrame2 (pSrc, iLen, pDst, &sDstInfo);
+  if (sDstInfo.iBufferStatus == 1) {
+    memcpy (pData, pDst, sizeof (pDst));
+    *pBufInfo = sDstInfo;
+  }
+  memset (&sDstInfo, 0, sizeof (SBufferInfo));
+  pDecoder->DecodeFrame2 (NULL, 0, pDst, &sDstInfo);
+  if (sDstInfo.iBufferStatus == 1) {
+    memcpy (pData, pDst, sizeof (pDst));
+    *pBufInfo = sDstInfo;
+  }
+}
+
+TEST_F (EncodeDecodeTestAPI, IndexAccessUnits) {
+  const int kiWidth = 160, kiHeight = 96, kiFrameNum = 24;
+  prepareParamDefault (1, 1, kiWidth, kiHeight, 6.0f, &param_);
+  param_.iTemporalLayerNum = 2; //every other picture is not referred to
+  param_.uiIntraPeriod = 8;
+  encoder_->Uninitialize();
+  int rv = encoder_->InitializeExt (&param_);
+  ASSERT_TRUE (rv == cmResultSuccess);
+  ASSERT_TRUE (InitialEncDec (kiWidth, kiHeight));
+  int32_t iTraceLevel = WELS_LOG_QUIET;
+  encoder_->SetOption (ENCODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+  decoder_->SetOption (DECODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+
+  std::vector<unsigned char> vBs;
+  std::vector<int> vOffsets, vSizes;
+  std::vector<bool> vIdr;
+  for (int iIdx = 0; iIdx < kiFrameNum; iIdx++) {
+    EncodeOneFrame (1);
+    int len = 0;
+    encToDecData (info, len);
+    vOffsets.push_back ((int)vBs.size());
+    vSizes.push_back (len);
+    vIdr.push_back (info.eFrameType == videoFrameTypeIDR);
+    vBs.insert (vBs.end(), info.sLayerInfo[0].pBsBuf, info.sLayerInfo[0].pBsBuf + len);
+  }
+
+  EXPECT_GT (0, WelsIndexAccessUnits (NULL, (long long)vBs.size(), NULL, 0));
+  ASSERT_EQ (kiFrameNum, WelsIndexAccessUnits (&vBs[0], (long long)vBs.size(), NULL, 0));
+  std::vector<SAccessUnitIndex> vIndex (kiFrameNum + 1);
+  ASSERT_EQ (kiFrameNum, WelsIndexAccessUnits (&vBs[0], (long long)vBs.size(), &vIndex[0], kiFrameNum + 1));
+  int iNonRefNum = 0;
+  for (int i = 0; i < kiFrameNum; i++) {
+    EXPECT_EQ (vOffsets[i], vIndex[i].iOffset) << "i = " << i;
+    EXPECT_EQ (vSizes[i], vIndex[i].iSize) << "i = " << i;
+    EXPECT_EQ (vIdr[i], vIndex[i].bIdr) << "i = " << i;
+    if (vIndex[i].bIdr) {
+      EXPECT_EQ (0, vIndex[i].iFrameNum) << "i = " << i;
+      EXPECT_EQ (0, vIndex[i].iPoc) << "i = " << i;
+      EXPECT_TRUE (vIndex[i].bRef) << "i = " << i;
+    } else {
+      EXPECT_GT (vIndex[i].iPoc, vIndex[i - 1].iPoc) << "i = " << i;
+    }
+    iNonRefNum += !vIndex[i].bRef;
+  }
+  EXPECT_GT (iNonRefNum, 0);
+
+  //seek: decoding from an IDR access unit of the index gives the pictures of the whole decoding
+  int iSeekIdx = kiFrameNum - 1;
+  while (iSeekIdx > 0 && !vIndex[iSeekIdx].bIdr)
+    iSeekIdx--;
+  ASSERT_GT (iSeekIdx, 0);
+  ISVCDecoder* pDecoder = NULL;
+  ASSERT_EQ (0, WelsCreateDecoder (&pDecoder));
+  ASSERT_TRUE (pDecoder != NULL);
+  SDecodingParam decParam;
+  memset (&decParam, 0, sizeof (SDecodingParam));
+  decParam.uiTargetDqLayer = UCHAR_MAX;
+  decParam.eEcActiveIdc = ERROR_CON_SLICE_COPY;
+  decParam.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
+  ASSERT_EQ (0, pDecoder->Initialize (&decParam));
+  pDecoder->SetOption (DECODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+  for (int i = 0; i < kiFrameNum; i++) {
+    unsigned char* pData[2][3];
+    SBufferInfo sBufInfo[2];
+    DecodeAccessUnit (decoder_, &vBs[vIndex[i].iOffset], vIndex[i].iSize, pData[0], &sBufInfo[0]);
+    if (i < iSeekIdx)
+      continue;
+    DecodeAccessUnit (pDecoder, &vBs[vIndex[i].iOffset], vIndex[i].iSize, pData[1], &sBufInfo[1]);
+    EXPECT_EQ (1, sBufInfo[1].iBufferStatus) << "i = " << i;
+    EXPECT_TRUE (CompareDecodedFrames (pData[1], sBufInfo[1], pData[0], sBufInfo[0])) << "i = " << i;
+  }
+  pDecoder->Uninitialize();
+  WelsDestroyDecoder (pDecoder);
+}
+
+TEST_F (EncodeDecodeTestAPI, PicturePool) {
+  const int kiMaxWidth = 320, kiMaxHeight = 192, kiPoolSize = 16;
+  const int kiSizes[3][2] = {{kiMaxWidth, kiMaxHeight}, {160, 96}, {kiMaxWidth, kiMaxHeight}};
+  int32_t iTraceLevel = WELS_LOG_QUIET;
+  decoder_->SetOption (DECODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+
+  SPicturePool* pPool = NULL;
+  SPicturePoolParam sPoolParam = {kiMaxWidth, kiMaxHeight, kiPoolSize};
+  EXPECT_NE (0, WelsCreatePicturePool (&sPoolParam, NULL));
+  ASSERT_EQ (0, WelsCreatePicturePool (&sPoolParam, &pPool));
+  ASSERT_TRUE (pPool != NULL);
+
+  //two decoders share the pool, decoder_ uses its own memory
+  ISVCDecoder* pDecoder[3] = {decoder_, NULL, NULL};
+  SDecodingParam decParam;
+  memset (&decParam, 0, sizeof (SDecodingParam));
+  decParam.uiTargetDqLayer = UCHAR_MAX;
+  decParam.eEcActiveIdc = ERROR_CON_SLICE_COPY;
+  decParam.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
+  for (int i = 1; i < 3; i++) {
+    ASSERT_EQ (0, WelsCreateDecoder (&pDecoder[i]));
+    ASSERT_TRUE (pDecoder[i] != NULL);
+    ASSERT_EQ (0, pDecoder[i]->Initialize (&decParam));
+    pDecoder[i]->SetOption (DECODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+    EXPECT_EQ (0, pDecoder[i]->SetOption (DECODER_OPTION_PICTURE_POOL, &pPool));
+  }
+  WelsDestroyPicturePool (pPool); //the decoders keep it alive
+  SPicturePool* pUsedPool = NULL;
+  EXPECT_EQ (0, pDecoder[1]->GetOption (DECODER_OPTION_PICTURE_POOL, &pUsedPool));
+  EXPECT_EQ (pPool, pUsedPool);
+
+  for (int iSeg = 0; iSeg < 3; iSeg++) {
+    const int kiWidth = kiSizes[iSeg][0], kiHeight = kiSizes[iSeg][1];
+    prepareParamDefault (1, 1, kiWidth, kiHeight, 6.0f, &param_);
+    encoder_->Uninitialize();
+    ASSERT_EQ (cmResultSuccess, encoder_->InitializeExt (&param_));
+    ASSERT_TRUE (InitialEncDec (kiWidth, kiHeight));
+    encoder_->SetOption (ENCODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+    for (int iIdx = 0; iIdx < 6; iIdx++) {
+      EncodeOneFrame (1);
+      int len = 0;
+      encToDecData (info, len);
+      unsigned char* pData[3][3];
+      SBufferInfo sBufInfo[3];
+      for (int i = 0; i < 3; i++) {
+        DecodeAccessUnit (pDecoder[i], info.sLayerInfo[0].pBsBuf, len, pData[i], &sBufInfo[i]);
+        ASSERT_EQ (1, sBufInfo[i].iBufferStatus) << "iSeg = " << iSeg << ", iIdx = " << iIdx;
+        EXPECT_EQ (kiWidth, sBufInfo[i].UsrData.sSystemBuffer.iWidth);
+        EXPECT_TRUE (CompareDecodedFrames (pData[i], sBufInfo[i], pData[0], sBufInfo[0]))
+            << "iSeg = " << iSeg << ", iIdx = " << iIdx;
+      }
+    }
+  }
+
+  //every picture, also after the resolution switches, is carved out of a buffer of the pool
+  SPicturePoolStatistics sStats;
+  EXPECT_NE (0, WelsGetPicturePoolStatistics (pPool, NULL));
+  ASSERT_EQ (0, WelsGetPicturePoolStatistics (pPool, &sStats));
+  EXPECT_EQ (0u, sStats.uiMisses);
+  EXPECT_EQ (kiPoolSize, sStats.iNumBuffers);
+  EXPECT_GE (sStats.iPeakBuffersInUse, 2 * 2);
+  //both decoders carve their pictures again at each of the 2 resolution switches
+  EXPECT_GE (sStats.uiHits, 3 * (unsigned int) sStats.iPeakBuffersInUse);
+  for (int i = 1; i < 3; i++)
+    pDecoder[i]->Uninitialize();
+  ASSERT_EQ (0, WelsGetPicturePoolStatistics (pPool, &sStats));
+  EXPECT_EQ (kiPoolSize, sStats.iNumFreeBuffers);
+  for (int i = 1; i < 3; i++)
+    WelsDestroyDecoder (pDecoder[i]);
+}
+
+//output of a decoder scheduled on the shared workers, pfDecoded is called for one access unit at a time
+struct SScheduledOutput {
+  SHA1Context sCtx;
+  int iFrameNum;
+  unsigned long long uiNextTimeStamp;
+  bool bInOrder;
+};
+
+static void UpdateOutputHash (SHA1Context* pCtx, unsigned char** ppDst, const SBufferInfo* pBufInfo) {
+  for (int iPlane = 0; iPlane < 3; iPlane++) {
+    const int kiShift = iPlane ? 1 : 0;
+    const int kiStride = pBufInfo->UsrData.sSystemBuffer.iStride[kiShift];
+    for (int y = 0; y < pBufInfo->UsrData.sSystemBuffer.iHeight >> kiShift; y++)
+      SHA1Input (pCtx, ppDst[iPlane] + y * kiStride, pBufInfo->UsrData.sSystemBuffer.iWidth >> kiShift);
+  }
+}
+
+static void OnScheduledDecoded (void* pUserContext, unsigned char** ppDst, SBufferInfo* pDstInfo,
+                                DECODING_STATE eState) {
+  SScheduledOutput* pOutput = (SScheduledOutput*)pUserContext;
+  if (eState != dsErrorFree || pDstInfo->uiInBsTimeStamp != pOutput->uiNextTimeStamp)
+    pOutput->bInOrder = false;
+  pOutput->uiNextTimeStamp++;
+  if (pDstInfo->iBufferStatus == 1) {
+    UpdateOutputHash (&pOutput->sCtx, ppDst, pDstInfo);
+    pOutput->iFrameNum++;
+  }
+}
+
+TEST_F (EncodeDecodeTestAPI, DecoderScheduling) {
+  //a 720p stream decoded next to small ones, all of them on the shared workers
+  const int kiSizes[2][3] = {{1280, 720, 8}, {160, 96, 24}};
+  const int kiDecoderNum = 4;
+  int32_t iTraceLevel = WELS_LOG_QUIET;
+  std::vector<std::vector<unsigned char> > vAu[2];
+  for (int iStream = 0; iStream < 2; iStream++) {
+    prepareParamDefault (1, 1, kiSizes[iStream][0], kiSizes[iStream][1], 24.0f, &param_);
+    encoder_->Uninitialize();
+    ASSERT_EQ (cmResultSuccess, encoder_->InitializeExt (&param_));
+    ASSERT_TRUE (InitialEncDec (kiSizes[iStream][0], kiSizes[iStream][1]));
+    encoder_->SetOption (ENCODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+    for (int i = 0; i < kiSizes[iStream][2]; i++) {
+      EncodeOneFrame (1);
+      int len = 0;
+      encToDecData (info, len);
+      vAu[iStream].push_back (std::vector<unsigned char> (info.sLayerInfo[0].pBsBuf, info.sLayerInfo[0].pBsBuf + len));
+    }
+  }
+
+  SDecodingParam decParam;
+  memset (&decParam, 0, sizeof (SDecodingParam));
+  decParam.uiTargetDqLayer = UCHAR_MAX;
+  decParam.eEcActiveIdc = ERROR_CON_SLICE_COPY;
+  decParam.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
+
+  //reference output, decoded on the calling thread
+  unsigned char digest[2][SHA_DIGEST_LENGTH];
+  for (int iStream = 0; iStream < 2; iStream++) {
+    SHA1Context sCtx;
+    SHA1Reset (&sCtx);
+    ASSERT_EQ (0, decoder_->Initialize (&decParam));
+    decoder_->SetOption (DECODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+    for (size_t i = 0; i < vAu[iStream].size(); i++) {
+      unsigned char* pData[3] = { NULL };
+      SBufferInfo sBufInfo;
+      memset (&sBufInfo, 0, sizeof (SBufferInfo));
+      EXPECT_EQ (dsErrorFree, decoder_->DecodeFrameNoDelay (&vAu[iStream][i][0], vAu[iStream][i].size(), pData,
+                 &sBufInfo));
+      ASSERT_EQ (1, sBufInfo.iBufferStatus);
+      UpdateOutputHash (&sCtx, pData, &sBufInfo);
+    }
+    SHA1Result (&sCtx, digest[iStream]);
+  }
+
+  ISVCDecoder* pDecoder[kiDecoderNum];
+  SScheduledOutput sOutput[kiDecoderNum];
+  for (int d = 0; d < kiDecoderNum; d++) {
+    ASSERT_EQ (0, WelsCreateDecoder (&pDecoder[d]));
+    ASSERT_EQ (0, pDecoder[d]->Initialize (&decParam));
+    pDecoder[d]->SetOption (DECODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+    SHA1Reset (&sOutput[d].sCtx);
+    sOutput[d].iFrameNum = 0;
+    sOutput[d].uiNextTimeStamp = 0;
+    sOutput[d].bInOrder = true;
+    SDecoderScheduling sScheduling = {OnScheduledDecoded, &sOutput[d], 1};
+    ASSERT_EQ (0, pDecoder[d]->SetOption (DECODER_OPTION_SCHEDULING, &sScheduling));
+  }
+  int iThreadNum = 2;
+  EXPECT_NE (0, pDecoder[0]->SetOption (DECODER_OPTION_NUM_OF_THREADS, &iThreadNum));
+
+  //decoder 0 gets the 720p stream, the others the small one, the calls only queue the access units
+  for (size_t i = 0; i < vAu[1].size(); i++) {
+    for (int d = 0; d < kiDecoderNum; d++) {
+      std::vector<std::vector<unsigned char> >& vStream = vAu[d == 0 ? 0 : 1];
+      if (i >= vStream.size())
+        continue;
+      unsigned char* pData[3] = { NULL };
+      SBufferInfo sBufInfo;
+      memset (&sBufInfo, 0, sizeof (SBufferInfo));
+      sBufInfo.uiInBsTimeStamp = i;
+      if (d & 1)
+        EXPECT_EQ (dsErrorFree, pDecoder[d]->DecodeFrame2 (&vStream[i][0], vStream[i].size(), pData, &sBufInfo));
+      else
+        EXPECT_EQ (dsErrorFree, pDecoder[d]->DecodeFrameNoDelay (&vStream[i][0], vStream[i].size(), pData, &sBufInfo));
+      EXPECT_EQ (0, sBufInfo.iBufferStatus);
+    }
+  }
+
+  for (int d = 0; d < kiDecoderNum; d++) {
+    const size_t kuiAuNum = vAu[d == 0 ? 0 : 1].size();
+    SDecoderScheduling sScheduling;
+    EXPECT_EQ (0, pDecoder[d]->GetOption (DECODER_OPTION_SCHEDULING, &sScheduling)); //waits for the queued ones
+    EXPECT_EQ (&sOutput[d], sScheduling.pUserContext);
+    SDecoderSchedulingStatistics sStats;
+    EXPECT_EQ (0, pDecoder[d]->GetOption (DECODER_OPTION_GET_SCHEDULING_STATISTICS, &sStats));
+    EXPECT_EQ (kuiAuNum, sStats.uiDecodedNum);
+    EXPECT_EQ (0u, sStats.uiQueuedNum);
+    EXPECT_LE (sStats.uiMaxWaitUs, sStats.uiTotalWaitUs);
+    EXPECT_LE (sStats.uiMaxDecodeUs, sStats.uiTotalDecodeUs);
+    EXPECT_TRUE (sOutput[d].bInOrder) << "d = " << d;
+    EXPECT_EQ ((int)kuiAuNum, sOutput[d].iFrameNum) << "d = " << d;
+    unsigned char digestScheduled[SHA_DIGEST_LENGTH];
+    SHA1Result (&sOutput[d].sCtx, digestScheduled);
+    EXPECT_EQ (0, memcmp (digest[d == 0 ? 0 : 1], digestScheduled, SHA_DIGEST_LENGTH)) << "d = " << d;
+  }
+
+  //back to decoding on the calling thread
+  SDecoderScheduling sNoScheduling = {NULL, NULL, 0};
+  ASSERT_EQ (0, pDecoder[1]->SetOption (DECODER_OPTION_SCHEDULING, &sNoScheduling));
+  unsigned char* pData[3] = { NULL };
+  SBufferInfo sBufInfo;
+  memset (&sBufInfo, 0, sizeof (SBufferInfo));
+  pDecoder[1]->DecodeFrameNoDelay (&vAu[1][0][0], vAu[1][0].size(), pData, &sBufInfo);
+  EXPECT_EQ (1, sBufInfo.iBufferStatus);
+  EXPECT_EQ ((int)vAu[1].size(), sOutput[1].iFrameNum);
+
+  //the access units still queued are decoded before the decoders go
+  for (int d = 0; d < kiDecoderNum; d++) {
+    pDecoder[d]->DecodeFrame2 (&vAu[1][0][0], vAu[1][0].size(), pData, &sBufInfo);
+    WelsDestroyDecoder (pDecoder[d]);
+  }
+  EXPECT_EQ ((int)vAu[0].size() + 1, sOutput[0].iFrameNum);
+}
+
+static void FrameDigest (unsigned char** ppDst, const SBufferInfo* pBufInfo, unsigned char* pDigest) {
+  SHA1Context sCtx;
+  SHA1Reset (&sCtx);
+  UpdateOutputHash (&sCtx, ppDst, pBufInfo);
+  SHA1Result (&sCtx, pDigest);
+}
+
+TEST_F (EncodeDecodeTestAPI, DecodeBatch) {
+  const int kiWidth = 160, kiHeight = 96, kiFrameNum = 12, kiDecoderNum = 6;
+  int32_t iTraceLevel = WELS_LOG_QUIET;
+  prepareParamDefault (1, 1, kiWidth, kiHeight, 24.0f, &param_);
+  encoder_->Uninitialize();
+  ASSERT_EQ (cmResultSuccess, encoder_->InitializeExt (&param_));
+  ASSERT_TRUE (InitialEncDec (kiWidth, kiHeight));
+  encoder_->SetOption (ENCODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+  decoder_->SetOption (DECODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+  std::vector<std::vector<unsigned char> > vAu;
+  std::vector<std::vector<unsigned char> > vDigest;
+  for (int i = 0; i < kiFrameNum; i++) {
+    EncodeOneFrame (1);
+    int len = 0;
+    encToDecData (info, len);
+    vAu.push_back (std::vector<unsigned char> (info.sLayerInfo[0].pBsBuf, info.sLayerInfo[0].pBsBuf + len));
+    unsigned char* pData[3] = { NULL };
+    SBufferInfo sBufInfo;
+    memset (&sBufInfo, 0, sizeof (SBufferInfo));
+    decoder_->DecodeFrameNoDelay (&vAu[i][0], len, pData, &sBufInfo);
+    ASSERT_EQ (1, sBufInfo.iBufferStatus);
+    vDigest.push_back (std::vector<unsigned char> (SHA_DIGEST_LENGTH));
+    FrameDigest (pData, &sBufInfo, &vDigest[i][0]);
+  }
+
+  SDecodingParam decParam;
+  memset (&decParam, 0, sizeof (SDecodingParam));
+  decParam.uiTargetDqLayer = UCHAR_MAX;
+  decParam.eEcActiveIdc = ERROR_CON_SLICE_COPY;
+  decParam.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
+  ISVCDecoder* pDecoder[kiDecoderNum];
+  for (int d = 0; d < kiDecoderNum; d++) {
+    ASSERT_EQ (0, WelsCreateDecoder (&pDecoder[d]));
+    ASSERT_EQ (0, pDecoder[d]->Initialize (&decParam));
+    pDecoder[d]->SetOption (DECODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+  }
+  int iThreadNum = 2; //decoded on the calling thread
+  pDecoder[kiDecoderNum - 1]->SetOption (DECODER_OPTION_NUM_OF_THREADS, &iThreadNum);
+
+  SDecodeBatchItem sItems[kiDecoderNum + 1];
+  EXPECT_NE (0, WelsDecodeBatch (NULL, 1, 1));
+  memset (sItems, 0, sizeof (sItems));
+  EXPECT_NE (0, WelsDecodeBatch (sItems, 1, 4));
+  EXPECT_EQ (0, WelsDecodeBatch (sItems, 0, 4));
+
+  //one access unit of each decoder per batch, the first decoder gets two of them in a row from the middle on
+  const int kiBatchThreads[3] = {1, 4, 8};
+  int iFrame[kiDecoderNum] = {0};
+  for (int iBatch = 0; iFrame[1] < kiFrameNum; iBatch++) {
+    int iItemNum = 0;
+    for (int d = 0; d < kiDecoderNum; d++) {
+      const int kiRepeat = (d == 0 && iFrame[0] >= kiFrameNum / 2 && iFrame[0] + 1 < kiFrameNum) ? 2 : 1;
+      for (int r = 0; r < kiRepeat && iFrame[d] < kiFrameNum; r++, iItemNum++) {
+        memset (&sItems[iItemNum], 0, sizeof (SDecodeBatchItem));
+        sItems[iItemNum].pDecoder = pDecoder[d];
+        sItems[iItemNum].pSrc = &vAu[iFrame[d]][0];
+        sItems[iItemNum].iSrcLen = vAu[iFrame[d]].size();
+        sItems[iItemNum].sDstInfo.uiInBsTimeStamp = iFrame[d]++;
+      }
+    }
+    ASSERT_EQ (0, WelsDecodeBatch (sItems, iItemNum, kiBatchThreads[iBatch % 3]));
+    for (int i = 0; i < iItemNum; i++) {
+      int iIdx = (int)sItems[i].sDstInfo.uiInBsTimeStamp;
+      EXPECT_EQ (dsErrorFree, sItems[i].eState) << "iBatch = " << iBatch << ", i = " << i;
+      if (sItems[i].pDecoder == pDecoder[kiDecoderNum - 1]) { //frame threads may output a picture later
+        if (sItems[i].sDstInfo.iBufferStatus == 0)
+          continue;
+        iIdx = (int)sItems[i].sDstInfo.uiOutYuvTimeStamp;
+      }
+      ASSERT_EQ (1, sItems[i].sDstInfo.iBufferStatus) << "iBatch = " << iBatch << ", i = " << i;
+      EXPECT_EQ ((unsigned long long)iIdx, sItems[i].sDstInfo.uiOutYuvTimeStamp);
+      if (i + 1 < iItemNum && sItems[i + 1].pDecoder == sItems[i].pDecoder)
+        continue; //the picture was overwritten by the next access unit of the decoder
+      unsigned char digest[SHA_DIGEST_LENGTH];
+      FrameDigest (sItems[i].pDst, &sItems[i].sDstInfo, digest);
+      EXPECT_EQ (0, memcmp (&vDigest[iIdx][0], digest, SHA_DIGEST_LENGTH)) << "iBatch = " << iBatch << ", i = " << i;
+    }
+  }
+  EXPECT_EQ (kiFrameNum, iFrame[0]);
+
+  for (int d = 0; d < kiDecoderNum; d++)
+    WelsDestroyDecoder (pDecoder[d]);
+}
+
+// WelsDecodeBatch() against a DecodeFrameNoDelay() call per access unit, on the calling thread, two sets of decoders
+// taking turns on each access unit; disabled by default, run it with --gtest_also_run_disabled_tests
+TEST_F (EncodeDecodeTestAPI, DISABLED_DecodeBatchSpeed) {
+  const int kiWidth = 160, kiHeight = 96, kiFrameNum = 60, kiDecoderNum = 16, kiRunNum = 10;
+  int32_t iTraceLevel = WELS_LOG_QUIET;
+  prepareParamDefault (1, 1, kiWidth, kiHeight, 24.0f, &param_);
+  encoder_->Uninitialize();
+  ASSERT_EQ (cmResultSuccess, encoder_->InitializeExt (&param_));
+  ASSERT_TRUE (InitialEncDec (kiWidth, kiHeight));
+  encoder_->SetOption (ENCODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+  std::vector<std::vector<unsigned char> > vAu;
+  for (int i = 0; i < kiFrameNum; i++) {
+    EncodeOneFrame (1);
+    int len = 0;
+    encToDecData (info, len);
+    vAu.push_back (std::vector<unsigned char> (info.sLayerInfo[0].pBsBuf, info.sLayerInfo[0].pBsBuf + len));
+  }
+
+  SDecodingParam decParam;
+  memset (&decParam, 0, sizeof (SDecodingParam));
+  decParam.uiTargetDqLayer = UCHAR_MAX;
+  decParam.eEcActiveIdc = ERROR_CON_SLICE_COPY;
+  decParam.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
+  SDecodeBatchItem sItems[kiDecoderNum];
+  int64_t iTicks[2] = {0, 0};
+  for (int iRun = 0; iRun < kiRunNum; iRun++) {
+    ISVCDecoder* pDecoder[2][kiDecoderNum];
+    for (int b = 0; b < 2; b++) {
+      for (int d = 0; d < kiDecoderNum; d++) {
+        ASSERT_EQ (0, WelsCreateDecoder (&pDecoder[b][d]));
+        ASSERT_EQ (0, pDecoder[b][d]->Initialize (&decParam));
+        pDecoder[b][d]->SetOption (DECODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+      }
+    }
+    for (int i = 0; i < kiFrameNum; i++) {
+      for (int j = 0; j < 2; j++) {
+        const int b = (i + j) & 1; //1 for the batch
+        memset (sItems, 0, sizeof (sItems));
+        for (int d = 0; d < kiDecoderNum; d++) {
+          sItems[d].pDecoder = pDecoder[b][d];
+          sItems[d].pSrc = &vAu[i][0];
+          sItems[d].iSrcLen = vAu[i].size();
+        }
+        const int64_t kiStart = WelsTicks();
+        if (b) {
+          WelsDecodeBatch (sItems, kiDecoderNum, 1);
+        } else {
+          for (int d = 0; d < kiDecoderNum; d++)
+            sItems[d].eState = pDecoder[b][d]->DecodeFrameNoDelay (sItems[d].pSrc, sItems[d].iSrcLen, sItems[d].pDst,
+                               &sItems[d].sDstInfo);
+        }
+        iTicks[b] += WelsTicks() - kiStart;
+        for (int d = 0; d < kiDecoderNum; d++)
+          EXPECT_EQ (1, sItems[d].sDstInfo.iBufferStatus);
+      }
+    }
+    for (int b = 0; b < 2; b++) {
+      for (int d = 0; d < kiDecoderNum; d++)
+        WelsDestroyDecoder (pDecoder[b][d]);
+    }
+  }
+  const double kdAuNum = (double)kiRunNum * kiFrameNum * kiDecoderNum;
+  printf ("%dx%d, %d decoders: DecodeFrameNoDelay %.0f ticks/AU, WelsDecodeBatch %.0f ticks/AU\n", kiWidth, kiHeight,
+          kiDecoderNum, iTicks[0] / kdAuNum, iTicks[1] / kdAuNum);
+}
+
 TEST_P (EncodeDecodeTestAPI, GetOptionTid_AVC_NOPREFIX) {
   SLTRMarkingFeedback m_LTR_Marking_Feedback;
   SLTRRecoverRequest m_LTR_Recover_Request;
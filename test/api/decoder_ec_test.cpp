@@ -5,6 +5,7 @@
 #include "BaseDecoderTest.h"
 #include "BaseEncoderTest.h"
 #include "wels_common_defs.h"
+#include "measure_time.h"
 #include <string>
 #include <vector>
 #include "encode_decode_api_test.h"
@@ -134,6 +135,65 @@ TEST_P (EncodeDecodeTestAPI, SetOptionECFlag_ERROR_CON_SLICE_COPY) {
   (void) iSkipedBytes;
 }
 
+TEST_P (EncodeDecodeTestAPI, SetOptionECFlag_ERROR_CON_FRAME_COPY_CROSS_IDR_ALIAS) {
+  EncodeDecodeFileParamBase p = GetParam();
+  prepareParamDefault (1, p.slicenum,  p.width, p.height, p.frameRate, &param_);
+  encoder_->Uninitialize();
+  int rv = encoder_->InitializeExt (&param_);
+  ASSERT_TRUE (rv == cmResultSuccess);
+
+  //the concealed frames sharing planes must look the same as the copied ones
+  ISVCDecoder* pRefDecoder = NULL;
+  ASSERT_EQ (0, WelsCreateDecoder (&pRefDecoder));
+  ASSERT_TRUE (pRefDecoder != NULL);
+  SDecodingParam decParam;
+  memset (&decParam, 0, sizeof (SDecodingParam));
+  decParam.uiTargetDqLayer = UCHAR_MAX;
+  decParam.eEcActiveIdc = ERROR_CON_FRAME_COPY_CROSS_IDR;
+  decParam.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
+  ASSERT_EQ (0, pRefDecoder->Initialize (&decParam));
+  uint32_t uiEcIdc = ERROR_CON_FRAME_COPY_CROSS_IDR_ALIAS;
+  decoder_->SetOption (DECODER_OPTION_ERROR_CON_IDC, &uiEcIdc);
+  uint32_t uiGet;
+  decoder_->GetOption (DECODER_OPTION_ERROR_CON_IDC, &uiGet);
+  EXPECT_EQ (uiGet, uiEcIdc);
+
+  ASSERT_TRUE (InitialEncDec (p.width, p.height));
+  int32_t iTraceLevel = WELS_LOG_QUIET;
+  encoder_->SetOption (ENCODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+  decoder_->SetOption (DECODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+  pRefDecoder->SetOption (DECODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+  int iIdx = 0;
+  int iLossIdx = 0;
+  bool bVCLLoss = false;
+  SBufferInfo sRefBufInfo;
+  while (iIdx <= p.numframes) {
+    EncodeOneFrame (1);
+    int len = 0;
+    encToDecData (info, len);
+    unsigned char* pData[3] = { NULL };
+    unsigned char* pRefData[3] = { NULL };
+    SimulateNALLoss (info.sLayerInfo[0].pBsBuf, len, &m_SLostSim, p.pLossSequence, p.bLostPara, iLossIdx, bVCLLoss);
+    memset (&dstBufInfo_, 0, sizeof (SBufferInfo));
+    memset (&sRefBufInfo, 0, sizeof (SBufferInfo));
+    decoder_->DecodeFrame2 (info.sLayerInfo[0].pBsBuf, len, pData, &dstBufInfo_);
+    pRefDecoder->DecodeFrame2 (info.sLayerInfo[0].pBsBuf, len, pRefData, &sRefBufInfo);
+    EXPECT_TRUE (CompareDecodedFrames (pData, dstBufInfo_, pRefData, sRefBufInfo));
+    decoder_->DecodeFrame2 (NULL, 0, pData, &dstBufInfo_); //reconstruction
+    pRefDecoder->DecodeFrame2 (NULL, 0, pRefData, &sRefBufInfo);
+    EXPECT_TRUE (CompareDecodedFrames (pData, dstBufInfo_, pRefData, sRefBufInfo));
+    iIdx++;
+  }
+
+  SDecoderStatistics sStatistics;
+  decoder_->GetOption (DECODER_OPTION_GET_STATISTICS, &sStatistics);
+  // the loss pattern conceals frames, most of them only alias the planes of the previous picture
+  EXPECT_GT (sStatistics.uiEcFrameNum, 0u);
+  EXPECT_GT (sStatistics.uiEcAliasedBytes, sStatistics.uiEcMaterializedBytes);
+  pRefDecoder->Uninitialize();
+  WelsDestroyDecoder (pRefDecoder);
+}
+
 static const EncodeDecodeFileParamBase kFileParamArray[] = {
   {300, 160, 96, 6.0f, 2, 1, "000000000000001010101010101010101010101001101010100000010101000011"},
   {300, 140, 96, 6.0f, 4, 1, "000000000000001010101010101010101010101001101010100000010101000011"},
@@ -656,6 +716,83 @@ TEST_F (EncodeDecodeTestAPI, SetOptionECIDC_SpecificSliceChange_IDRNoLoss) {
 
 }
 
+TEST_F (EncodeDecodeTestAPI, SetOptionECIDC_SliceMVCopyHalfLoss) {
+  const int kiWidth = 640, kiHeight = 480, kiSliceNum = 8, kiFrameNum = 16;
+  prepareParamDefault (1, kiSliceNum, kiWidth, kiHeight, 30.0f, &param_);
+  encoder_->Uninitialize();
+  int rv = encoder_->InitializeExt (&param_);
+  ASSERT_TRUE (rv == cmResultSuccess);
+
+  uint32_t uiEcIdc = ERROR_CON_SLICE_MV_COPY_CROSS_IDR;
+  decoder_->SetOption (DECODER_OPTION_ERROR_CON_IDC, &uiEcIdc);
+  ASSERT_TRUE (InitialEncDec (kiWidth, kiHeight));
+
+  //the rows concealed by the worker threads must match the ones concealed by a single thread
+  ISVCDecoder* pThreadDecoder = NULL;
+  ASSERT_EQ (0, WelsCreateDecoder (&pThreadDecoder));
+  ASSERT_TRUE (pThreadDecoder != NULL);
+  int32_t iThreadNum = 4;
+  int32_t iSliceThreading = 1;
+  pThreadDecoder->SetOption (DECODER_OPTION_NUM_OF_THREADS, &iThreadNum);
+  pThreadDecoder->SetOption (DECODER_OPTION_SLICE_THREADING, &iSliceThreading);
+  SDecodingParam decParam;
+  memset (&decParam, 0, sizeof (SDecodingParam));
+  decParam.uiTargetDqLayer = UCHAR_MAX;
+  decParam.eEcActiveIdc = ERROR_CON_SLICE_MV_COPY_CROSS_IDR;
+  decParam.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
+  rv = pThreadDecoder->Initialize (&decParam);
+  EXPECT_EQ (0, rv);
+  if (rv != 0) {
+    WelsDestroyDecoder (pThreadDecoder);
+    return;
+  }
+  int32_t iTraceLevel = WELS_LOG_QUIET;
+  encoder_->SetOption (ENCODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+  decoder_->SetOption (DECODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+  pThreadDecoder->SetOption (DECODER_OPTION_TRACE_LEVEL, &iTraceLevel);
+
+  std::vector<unsigned char> vLossyBs;
+  int iOutputNum = 0;
+  for (int iIdx = 0; iIdx < kiFrameNum; iIdx++) {
+    EncodeOneFrame (1);
+    //keep the whole IDR, then drop every other slice of the following frames
+    vLossyBs.clear();
+    const unsigned char* pNal = info.sLayerInfo[0].pBsBuf;
+    int iVclIdx = 0;
+    for (int i = 0; i < info.iLayerNum; i++) {
+      const SLayerBSInfo& sLayerInfo = info.sLayerInfo[i];
+      for (int j = 0; j < sLayerInfo.iNalCount; j++) {
+        const bool bVcl = sLayerInfo.uiLayerType == VIDEO_CODING_LAYER;
+        if (iIdx == 0 || !bVcl || (iVclIdx & 1) == 0)
+          vLossyBs.insert (vLossyBs.end(), pNal, pNal + sLayerInfo.pNalLengthInByte[j]);
+        iVclIdx += bVcl;
+        pNal += sLayerInfo.pNalLengthInByte[j];
+      }
+    }
+    unsigned char* pData[3] = { NULL };
+    unsigned char* pThreadData[3] = { NULL };
+    SBufferInfo sThreadBufInfo;
+    memset (&dstBufInfo_, 0, sizeof (SBufferInfo));
+    memset (&sThreadBufInfo, 0, sizeof (SBufferInfo));
+    //the last slice being lost, a concealed frame only comes out once the next one starts
+    for (int iFlush = 0; iFlush < 2; iFlush++) {
+      const unsigned char* pSrc = iFlush ? NULL : &vLossyBs[0];
+      const int iSrcLen = iFlush ? 0 : (int) vLossyBs.size();
+      decoder_->DecodeFrame2 (pSrc, iSrcLen, pData, &dstBufInfo_);
+      pThreadDecoder->DecodeFrame2 (pSrc, iSrcLen, pThreadData, &sThreadBufInfo);
+      EXPECT_TRUE (CompareDecodedFrames (pData, dstBufInfo_, pThreadData, sThreadBufInfo)) << "iIdx = " << iIdx;
+      iOutputNum += dstBufInfo_.iBufferStatus;
+    }
+  }
+  EXPECT_EQ (iOutputNum, kiFrameNum - 1);
+
+  SDecoderStatistics sStatistics;
+  pThreadDecoder->GetOption (DECODER_OPTION_GET_STATISTICS, &sStatistics);
+  EXPECT_GT (sStatistics.uiEcFrameNum, 0u);
+  pThreadDecoder->Uninitialize();
+  WelsDestroyDecoder (pThreadDecoder);
+}
+
 static const EncodeDecodeFileParamBase kSVCSwitch[] = {
   {300, 160, 96, 6.0f, 2, 1, "120012130101012311201221323"},
 };
@@ -2,6 +2,8 @@
 #include "utils/HashFunctions.h"
 #include "BaseDecoderTest.h"
 #include <string>
+#include <map>
+#include <deque>
 
 static void UpdateHashFromPlane (SHA1Context* ctx, const uint8_t* plane,
                                  int width, int height, int stride) {
@@ -87,6 +89,46 @@ TEST_P (DecoderOutputTest, CompareOutput) {
     CompareHash (digest, p.hashStr);
   }
 }
+
+// the C functions have to decode as the optimized ones, timing the stages must not change the output
+TEST_P (DecoderOutputTest, CompareOutputWithoutSimd) {
+  FileParam p = GetParam();
+#if defined(ANDROID_NDK)
+  std::string filename = std::string ("/sdcard/") + p.fileName;
+#else
+  std::string filename = p.fileName;
+#endif
+  unsigned int uiCpuFlags = 0;
+  int iStageTiming = 1;
+  EXPECT_EQ (0, decoder_->SetOption (DECODER_OPTION_CPU_FLAGS, &uiCpuFlags));
+  EXPECT_EQ (0, decoder_->SetOption (DECODER_OPTION_STAGE_TIMING, &iStageTiming));
+  uiCpuFlags = 1;
+  EXPECT_EQ (0, decoder_->GetOption (DECODER_OPTION_CPU_FLAGS, &uiCpuFlags));
+  EXPECT_EQ (0u, uiCpuFlags);
+  DecodeFile (filename.c_str(), this);
+
+  unsigned char digest[SHA_DIGEST_LENGTH];
+  SHA1Result (&ctx_, digest);
+  if (!HasFatalFailure()) {
+    CompareHash (digest, p.hashStr);
+    SDecoderStageStatistics sStages;
+    EXPECT_EQ (0, decoder_->GetOption (DECODER_OPTION_GET_STAGE_STATISTICS, &sStages));
+    EXPECT_GT (sStages.uiParsedMbCount, 0u);
+    EXPECT_GT (sStages.uiElapsedNanoseconds, 0u);
+    unsigned long long uiStageNs = 0;
+    for (int i = 0; i < DECODER_STAGE_NUM; i++)
+      uiStageNs += sStages.sStage[i].uiNanoseconds;
+    EXPECT_GE (sStages.uiElapsedNanoseconds + 1000, uiStageNs);
+    EXPECT_GT (sStages.sStage[DECODER_STAGE_NAL_UNESCAPE].uiCount, 0u);
+    EXPECT_GT (sStages.sStage[DECODER_STAGE_HEADER_PARSE].uiCount, 0u);
+    EXPECT_GT (sStages.sStage[DECODER_STAGE_MB_PARSE].uiNanoseconds, 0u);
+    EXPECT_GT (sStages.sStage[DECODER_STAGE_RECONSTRUCTION].uiNanoseconds, 0u);
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+    EXPECT_GT (sStages.sStage[DECODER_STAGE_MB_PARSE].uiCycles, 0u);
+#endif
+  }
+}
+
 static const FileParam kFileParamArray[] = {
   {"res/Adobe_PDF_sample_a_1024x768_50Frms.264", "9aa9a4d9598eb3e1093311826844f37c43e4c521"},
   {"res/BA1_FT_C.264", "418d152fb85709b6f172799dcb239038df437cfa"},
@@ -134,3 +176,249 @@ static const FileParam kFileParamArray[] = {
 
 INSTANTIATE_TEST_CASE_P (DecodeFile, DecoderOutputTest,
                          ::testing::ValuesIn (kFileParamArray));
+
+class ThreadDecoderOutputTest : public ::testing::WithParamInterface<FileParam>,
+  public DecoderInitTest, public BaseDecoderTest::Callback {
+ public:
+  virtual void onDecodeFrame (const Frame& frame) {
+    const Plane& y = frame.y;
+    const Plane& u = frame.u;
+    const Plane& v = frame.v;
+    UpdateHashFromPlane (&ctx_, y.data, y.width, y.height, y.stride);
+    UpdateHashFromPlane (&ctx_, u.data, u.width, u.height, u.stride);
+    UpdateHashFromPlane (&ctx_, v.data, v.width, v.height, v.stride);
+    ++iFrameNum_;
+  }
+  void DecodeWithThreads (const char* fileName, int iThreadNum, unsigned char* digest, int* pFrameNum,
+                          int iSliceThreading = 0, bool bFastPreview = false) {
+    SHA1Reset (&ctx_);
+    iFrameNum_ = 0;
+    if (bFastPreview) {
+      SDecodingParam decParam;
+      memset (&decParam, 0, sizeof (SDecodingParam));
+      decParam.uiTargetDqLayer = UCHAR_MAX;
+      decParam.eEcActiveIdc = ERROR_CON_SLICE_COPY;
+      decParam.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
+      decParam.bFastPreview = true;
+      decoder_->Uninitialize();
+      EXPECT_EQ (0, decoder_->Initialize (&decParam));
+    }
+    EXPECT_EQ (0, decoder_->SetOption (DECODER_OPTION_SLICE_THREADING, &iSliceThreading));
+    EXPECT_EQ (0, decoder_->SetOption (DECODER_OPTION_NUM_OF_THREADS, &iThreadNum));
+    DecodeFile (fileName, this);
+    SHA1Result (&ctx_, digest);
+    *pFrameNum = iFrameNum_;
+  }
+ protected:
+  SHA1Context ctx_;
+  int iFrameNum_;
+};
+
+// frame threaded decoding has to output the same pictures as the single threaded one
+TEST_P (ThreadDecoderOutputTest, CompareOutput) {
+  FileParam p = GetParam();
+#if defined(ANDROID_NDK)
+  std::string filename = std::string ("/sdcard/") + p.fileName;
+#else
+  std::string filename = p.fileName;
+#endif
+  unsigned char digest[SHA_DIGEST_LENGTH], digestThread[SHA_DIGEST_LENGTH];
+  int iFrameNum = 0, iFrameNumThread = 0;
+
+  DecodeWithThreads (filename.c_str(), 1, digest, &iFrameNum);
+  ASSERT_FALSE (HasFatalFailure());
+  DecoderInitTest::TearDown();
+  DecoderInitTest::SetUp();
+  ASSERT_FALSE (HasFatalFailure());
+  DecodeWithThreads (filename.c_str(), 4, digestThread, &iFrameNumThread);
+  ASSERT_FALSE (HasFatalFailure());
+
+  int iRemaining = -1;
+  EXPECT_EQ (0, decoder_->GetOption (DECODER_OPTION_NUM_OF_FRAMES_REMAINING_IN_BUFFER, &iRemaining));
+  EXPECT_EQ (0, iRemaining);
+  EXPECT_EQ (iFrameNum, iFrameNumThread);
+  EXPECT_EQ (0, memcmp (digest, digestThread, SHA_DIGEST_LENGTH));
+}
+
+// so has slice threaded decoding, without any output delay
+TEST_P (ThreadDecoderOutputTest, CompareSliceThreadOutput) {
+  FileParam p = GetParam();
+#if defined(ANDROID_NDK)
+  std::string filename = std::string ("/sdcard/") + p.fileName;
+#else
+  std::string filename = p.fileName;
+#endif
+  unsigned char digest[SHA_DIGEST_LENGTH], digestThread[SHA_DIGEST_LENGTH];
+  int iFrameNum = 0, iFrameNumThread = 0;
+
+  DecodeWithThreads (filename.c_str(), 1, digest, &iFrameNum);
+  ASSERT_FALSE (HasFatalFailure());
+  DecoderInitTest::TearDown();
+  DecoderInitTest::SetUp();
+  ASSERT_FALSE (HasFatalFailure());
+  DecodeWithThreads (filename.c_str(), 4, digestThread, &iFrameNumThread, 1);
+  ASSERT_FALSE (HasFatalFailure());
+
+  int iSliceThreading = 0;
+  EXPECT_EQ (0, decoder_->GetOption (DECODER_OPTION_SLICE_THREADING, &iSliceThreading));
+  EXPECT_EQ (1, iSliceThreading);
+  EXPECT_EQ (iFrameNum, iFrameNumThread);
+  EXPECT_EQ (0, memcmp (digest, digestThread, SHA_DIGEST_LENGTH));
+}
+
+// frame threads pad the references fully, the calling thread only as far as the motion vectors read
+TEST_P (ThreadDecoderOutputTest, CompareFastPreviewOutput) {
+  FileParam p = GetParam();
+#if defined(ANDROID_NDK)
+  std::string filename = std::string ("/sdcard/") + p.fileName;
+#else
+  std::string filename = p.fileName;
+#endif
+  unsigned char digest[SHA_DIGEST_LENGTH], digestThread[SHA_DIGEST_LENGTH];
+  int iFrameNum = 0, iFrameNumThread = 0;
+
+  DecodeWithThreads (filename.c_str(), 1, digest, &iFrameNum, 0, true);
+  ASSERT_FALSE (HasFatalFailure());
+  DecoderInitTest::TearDown();
+  DecoderInitTest::SetUp();
+  ASSERT_FALSE (HasFatalFailure());
+  DecodeWithThreads (filename.c_str(), 4, digestThread, &iFrameNumThread, 0, true);
+  ASSERT_FALSE (HasFatalFailure());
+
+  EXPECT_EQ (iFrameNum, iFrameNumThread);
+  EXPECT_EQ (0, memcmp (digest, digestThread, SHA_DIGEST_LENGTH));
+}
+
+INSTANTIATE_TEST_CASE_P (DecodeFile, ThreadDecoderOutputTest,
+                         ::testing::ValuesIn (kFileParamArray));
+
+// reference counted buffers of the application, the decoder holds one reference from pfGetBuffer
+struct FrameBufferPool {
+  std::map<void*, int> refs;
+  int iGetNum;
+  static void* GetBuffer (void* pUserContext, int iSize) {
+    FrameBufferPool* pPool = static_cast<FrameBufferPool*> (pUserContext);
+    void* pBuffer = malloc (iSize);
+    if (pBuffer != NULL)
+      memset (pBuffer, 0x5a, iSize); // the output must not depend on what the buffers held before
+    pPool->refs[pBuffer] = 1;
+    ++pPool->iGetNum;
+    return pBuffer;
+  }
+  static void ReleaseBuffer (void* pUserContext, void* pBuffer) {
+    FrameBufferPool* pPool = static_cast<FrameBufferPool*> (pUserContext);
+    pPool->Unref (pBuffer);
+  }
+  void Unref (void* pBuffer) {
+    std::map<void*, int>::iterator it = refs.find (pBuffer);
+    ASSERT_TRUE (it != refs.end());
+    if (--it->second == 0) {
+      free (pBuffer);
+      refs.erase (it);
+    }
+  }
+};
+
+#define HELD_FRAME_NUM 8
+
+class FrameAllocatorDecoderTest : public ::testing::WithParamInterface<FileParam>,
+  public DecoderInitTest, public BaseDecoderTest::Callback {
+ public:
+  // keep the last output pictures without copying them, hash them only when they are dropped
+  virtual void onDecodeFrame (const Frame& frame) {
+    ASSERT_TRUE (frame.buffer != NULL);
+    if (!hold_) {
+      ASSERT_TRUE (pool_.refs.find (frame.buffer) != pool_.refs.end());
+      ++pool_.refs[frame.buffer];
+    }
+    heldFrames_.push_back (frame);
+    if (heldFrames_.size() > HELD_FRAME_NUM)
+      DropFrame();
+  }
+  void DropFrame() {
+    const Frame& frame = heldFrames_.front();
+    UpdateHashFromPlane (&ctx_, frame.y.data, frame.y.width, frame.y.height, frame.y.stride);
+    UpdateHashFromPlane (&ctx_, frame.u.data, frame.u.width, frame.u.height, frame.u.stride);
+    UpdateHashFromPlane (&ctx_, frame.v.data, frame.v.width, frame.v.height, frame.v.stride);
+    if (hold_)
+      EXPECT_EQ (0, decoder_->SetOption (DECODER_OPTION_RELEASE_OUTPUT, &heldFrames_.front().buffer));
+    else
+      pool_.Unref (frame.buffer);
+    heldFrames_.pop_front();
+  }
+  // with bHold, the pictures are held by the decoder itself instead of a frame allocator
+  void DecodeWithAllocator (const char* fileName, int iThreadNum, bool bHold, unsigned char* digest) {
+    SFrameAllocator sAllocator = {&pool_, FrameBufferPool::GetBuffer, FrameBufferPool::ReleaseBuffer};
+    int iHold = bHold;
+    SHA1Reset (&ctx_);
+    pool_.iGetNum = 0;
+    hold_ = bHold;
+    EXPECT_EQ (0, decoder_->SetOption (DECODER_OPTION_NUM_OF_THREADS, &iThreadNum));
+    if (bHold)
+      EXPECT_EQ (0, decoder_->SetOption (DECODER_OPTION_HOLD_OUTPUT, &iHold));
+    else
+      EXPECT_EQ (0, decoder_->SetOption (DECODER_OPTION_FRAME_ALLOCATOR, &sAllocator));
+    DecodeFile (fileName, this);
+    while (!heldFrames_.empty())
+      DropFrame();
+    SHA1Result (&ctx_, digest);
+    // all buffers are given back when the decoder is closed
+    DecoderInitTest::TearDown();
+    EXPECT_TRUE (pool_.refs.empty());
+    EXPECT_EQ (!bHold, pool_.iGetNum > 0);
+    DecoderInitTest::SetUp();
+  }
+ protected:
+  bool hold_;
+  SHA1Context ctx_;
+  FrameBufferPool pool_;
+  std::deque<Frame> heldFrames_;
+};
+
+TEST_P (FrameAllocatorDecoderTest, CompareOutput) {
+  FileParam p = GetParam();
+#if defined(ANDROID_NDK)
+  std::string filename = std::string ("/sdcard/") + p.fileName;
+#else
+  std::string filename = p.fileName;
+#endif
+  unsigned char digest[SHA_DIGEST_LENGTH];
+
+  DecodeWithAllocator (filename.c_str(), 1, false, digest);
+  if (!HasFatalFailure()) {
+    CompareHash (digest, p.hashStr);
+  }
+}
+
+TEST_P (FrameAllocatorDecoderTest, CompareThreadOutput) {
+  FileParam p = GetParam();
+#if defined(ANDROID_NDK)
+  std::string filename = std::string ("/sdcard/") + p.fileName;
+#else
+  std::string filename = p.fileName;
+#endif
+  unsigned char digest[SHA_DIGEST_LENGTH];
+
+  DecodeWithAllocator (filename.c_str(), 4, false, digest);
+  if (!HasFatalFailure()) {
+    CompareHash (digest, p.hashStr);
+  }
+}
+
+TEST_P (FrameAllocatorDecoderTest, CompareHeldOutput) {
+  FileParam p = GetParam();
+#if defined(ANDROID_NDK)
+  std::string filename = std::string ("/sdcard/") + p.fileName;
+#else
+  std::string filename = p.fileName;
+#endif
+  unsigned char digest[SHA_DIGEST_LENGTH];
+
+  DecodeWithAllocator (filename.c_str(), 1, true, digest);
+  if (!HasFatalFailure()) {
+    CompareHash (digest, p.hashStr);
+  }
+}
+
+INSTANTIATE_TEST_CASE_P (DecodeFile, FrameAllocatorDecoderTest,
+                         ::testing::ValuesIn (kFileParamArray));
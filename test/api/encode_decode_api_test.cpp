@@ -276,6 +276,30 @@ bool ToRemainDidNal (const unsigned char* pSrc, EWelsNalUnitType eNalType, int i
   }
 }
 
+//whether two decoders output the same picture, or both no picture
+bool CompareDecodedFrames (unsigned char* pData[3], const SBufferInfo& sInfo, unsigned char* pRefData[3],
+                           const SBufferInfo& sRefInfo) {
+  if (sInfo.iBufferStatus != sRefInfo.iBufferStatus)
+    return false;
+  if (sInfo.iBufferStatus != 1)
+    return true;
+  const SSysMEMBuffer& sBuf = sInfo.UsrData.sSystemBuffer;
+  const SSysMEMBuffer& sRefBuf = sRefInfo.UsrData.sSystemBuffer;
+  if (sBuf.iWidth != sRefBuf.iWidth || sBuf.iHeight != sRefBuf.iHeight)
+    return false;
+  for (int i = 0; i < 3; i++) {
+    const int iWidth = i ? sBuf.iWidth >> 1 : sBuf.iWidth;
+    const int iHeight = i ? sBuf.iHeight >> 1 : sBuf.iHeight;
+    const int iStride = sBuf.iStride[i ? 1 : 0];
+    const int iRefStride = sRefBuf.iStride[i ? 1 : 0];
+    for (int y = 0; y < iHeight; y++) {
+      if (memcmp (pData[i] + y * iStride, pRefData[i] + y * iRefStride, iWidth))
+        return false;
+    }
+  }
+  return true;
+}
+
 void ExtractDidNal (SFrameBSInfo* pBsInfo, int& iSrcLen, std::vector<SLostSim>* p_SLostSim, int iTarDid) {
   unsigned char* pDst = new unsigned char[iSrcLen];
   const unsigned char* pSrc = pBsInfo->sLayerInfo[0].pBsBuf;
@@ -158,6 +158,8 @@ bool ToRemainDidNal (const unsigned char* pSrc, EWelsNalUnitType eNalType, int i
 void ExtractDidNal (SFrameBSInfo* pBsInfo, int& iSrcLen, std::vector<SLostSim>* p_SLostSim, int iTarDid);
 int SimulateNALLoss (const unsigned char* pSrc,  int& iSrcLen, std::vector<SLostSim>* p_SLostSim,
                      const char* pLossChars, bool bLossPara, int& iLossIdx, bool& bVCLLoss);
+bool CompareDecodedFrames (unsigned char* pData[3], const SBufferInfo& sInfo, unsigned char* pRefData[3],
+                           const SBufferInfo& sRefInfo);
 
 long IsKeyFrameLost (ISVCDecoder* pDecoder, SLTRRecoverRequest* p_LTR_Recover_Request, long hr);
 bool IsLTRMarking (ISVCDecoder* pDecoder);
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include "utils/HashFunctions.h"
 #include "BaseEncoderTest.h"
+#include "utils/BufferedData.h"
+#include "utils/FileInputStream.h"
 #include <string>
 
 static void UpdateHashFromFrame (const SFrameBSInfo& info, SHA1Context* ctx) {
@@ -100,6 +102,208 @@ TEST_P (EncoderOutputTest, CompareOutput) {
     CompareHashAnyOf (digest, p.pkcHashStr, sizeof p.pkcHashStr / sizeof *p.pkcHashStr);
   }
 }
+// the pipelined encoding codes the same frames as EncodeFrame(), one call later
+TEST_P (EncoderOutputTest, CompareOutputAsync) {
+  EncodeFileParam p = GetParam();
+  SEncParamExt EnxParamExt;
+
+  EncFileParamToParamExt (&p, &EnxParamExt);
+  EncodeFile (p.pkcFileName, &EnxParamExt, this, true);
+  unsigned char digest[SHA_DIGEST_LENGTH];
+  SHA1Result (&ctx_, digest);
+  if (!HasFatalFailure()) {
+    CompareHashAnyOf (digest, p.pkcHashStr, sizeof p.pkcHashStr / sizeof *p.pkcHashStr);
+  }
+}
+
+/*
+ *  downscaled input, temporal layers and slice threads: hash of the output of EncodeFrame() or EncodeFrameAsync()
+ */
+static void EncodeDownscaledFile (ISVCEncoder* pEncoder, bool bAsync, unsigned char* pDigest) {
+  const int kiWidth = 320, kiHeight = 192;
+  SEncParamExt sParam;
+  pEncoder->GetDefaultParams (&sParam);
+  sParam.iUsageType         = CAMERA_VIDEO_REAL_TIME;
+  sParam.iPicWidth          = kiWidth >> 1;
+  sParam.iPicHeight         = kiHeight >> 1;
+  sParam.fMaxFrameRate      = 12.0f;
+  sParam.iTargetBitrate     = 400000;
+  sParam.iTemporalLayerNum  = 3;
+  sParam.iSpatialLayerNum   = 2;
+  sParam.bEnableDenoise     = true;
+  sParam.iMultipleThreadIdc = 2;
+  sParam.bUseLoadBalancing  = false; // slices are balanced after the coding times, which vary
+  for (int i = 0; i < sParam.iSpatialLayerNum; i++) {
+    sParam.sSpatialLayers[i].iVideoWidth     = sParam.iPicWidth >> (sParam.iSpatialLayerNum - 1 - i);
+    sParam.sSpatialLayers[i].iVideoHeight    = sParam.iPicHeight >> (sParam.iSpatialLayerNum - 1 - i);
+    sParam.sSpatialLayers[i].fFrameRate      = sParam.fMaxFrameRate;
+    sParam.sSpatialLayers[i].iSpatialBitrate = sParam.iTargetBitrate >> 1;
+    sParam.sSpatialLayers[i].sSliceArgument.uiSliceMode = SM_FIXEDSLCNUM_SLICE;
+    sParam.sSpatialLayers[i].sSliceArgument.uiSliceNum  = 2;
+  }
+  ASSERT_EQ (cmResultSuccess, pEncoder->InitializeExt (&sParam));
+
+  FileInputStream fileStream;
+  ASSERT_TRUE (fileStream.Open ("res/CiscoVT2people_320x192_12fps.yuv"));
+  const int kiFrameSize = kiWidth * kiHeight * 3 / 2;
+  BufferedData buf;
+  buf.SetLength (kiFrameSize);
+
+  SSourcePicture sPic;
+  memset (&sPic, 0, sizeof (SSourcePicture));
+  sPic.iPicWidth    = kiWidth;
+  sPic.iPicHeight   = kiHeight;
+  sPic.iColorFormat = videoFormatI420;
+  sPic.iStride[0]   = kiWidth;
+  sPic.iStride[1]   = sPic.iStride[2] = kiWidth >> 1;
+  sPic.pData[0]     = buf.data();
+  sPic.pData[1]     = sPic.pData[0] + kiWidth * kiHeight;
+  sPic.pData[2]     = sPic.pData[1] + (kiWidth * kiHeight >> 2);
+
+  SFrameBSInfo sInfo;
+  SHA1Context ctx;
+  SHA1Reset (&ctx);
+  for (int iFrame = 0; ; ++iFrame) {
+    const bool kbEnd = (fileStream.read (buf.data(), kiFrameSize) != kiFrameSize);
+    sPic.uiTimeStamp = iFrame * 1000 / 12;
+    if (bAsync) {
+      if (kbEnd) {
+        EXPECT_EQ (cmResultSuccess, pEncoder->EncodeFrameAsync (NULL)); // flush
+      } else {
+        EXPECT_EQ (cmResultSuccess, pEncoder->EncodeFrameAsync (&sPic));
+        EXPECT_EQ (cmInitExpected, pEncoder->EncodeFrame (&sPic, &sInfo)); // a frame is pending
+      }
+      EXPECT_EQ (cmResultSuccess, pEncoder->GetEncodedFrame (&sInfo));
+      EXPECT_EQ (iFrame == 0, sInfo.eFrameType == videoFrameTypeInvalid);
+    } else if (!kbEnd) {
+      EXPECT_EQ (cmResultSuccess, pEncoder->EncodeFrame (&sPic, &sInfo));
+    }
+    if (kbEnd && !bAsync)
+      break;
+    UpdateHashFromFrame (sInfo, &ctx);
+    if (kbEnd)
+      break;
+  }
+  EXPECT_EQ (cmResultSuccess, pEncoder->GetEncodedFrame (&sInfo));
+  EXPECT_EQ (videoFrameTypeInvalid, sInfo.eFrameType); // already fetched
+  SHA1Result (&ctx, pDigest);
+  pEncoder->Uninitialize();
+}
+
+TEST_F (EncoderInitTest, EncodeFrameAsyncDownscaled) {
+  unsigned char digest[2][SHA_DIGEST_LENGTH];
+  EncodeDownscaledFile (encoder_, false, digest[0]);
+  ASSERT_FALSE (HasFatalFailure());
+  EncodeDownscaledFile (encoder_, true, digest[1]);
+  ASSERT_FALSE (HasFatalFailure());
+  EXPECT_EQ (0, memcmp (digest[0], digest[1], SHA_DIGEST_LENGTH));
+}
+
+struct WavefrontParam {
+  const char* pkcFileName;
+  int iWidth;
+  int iHeight;
+  EUsageType eUsageType;
+  RC_MODES eRcMode;
+  int iLayerNum;
+  int iQp;
+  bool bCabac;
+  bool bBgdAq;
+  int iHierarchicalMeLevels;
+};
+
+/*
+ *  hash of a single slice coding, the MB rows being decided by 4 threads with bWavefront
+ */
+static void EncodeWavefrontFile (ISVCEncoder* pEncoder, const WavefrontParam& kP, bool bWavefront,
+                                 unsigned char* pDigest) {
+  SEncParamExt sParam;
+  pEncoder->GetDefaultParams (&sParam);
+  sParam.iUsageType         = kP.eUsageType;
+  sParam.iPicWidth          = kP.iWidth;
+  sParam.iPicHeight         = kP.iHeight;
+  sParam.fMaxFrameRate      = 12.0f;
+  sParam.iTargetBitrate     = 600000;
+  sParam.iRCMode            = kP.eRcMode;
+  sParam.iSpatialLayerNum   = kP.iLayerNum;
+  sParam.iEntropyCodingModeFlag     = kP.bCabac ? 1 : 0;
+  sParam.bEnableBackgroundDetection = kP.bBgdAq;
+  sParam.bEnableAdaptiveQuant       = kP.bBgdAq;
+  sParam.iMultipleThreadIdc = bWavefront ? 4 : 1;
+  sParam.bUseWavefront      = bWavefront;
+  sParam.iHierarchicalMeLevels = kP.iHierarchicalMeLevels;
+  for (int i = 0; i < sParam.iSpatialLayerNum; i++) {
+    sParam.sSpatialLayers[i].iVideoWidth     = sParam.iPicWidth >> (sParam.iSpatialLayerNum - 1 - i);
+    sParam.sSpatialLayers[i].iVideoHeight    = sParam.iPicHeight >> (sParam.iSpatialLayerNum - 1 - i);
+    sParam.sSpatialLayers[i].fFrameRate      = sParam.fMaxFrameRate;
+    sParam.sSpatialLayers[i].iSpatialBitrate = sParam.iTargetBitrate / sParam.iSpatialLayerNum;
+    sParam.sSpatialLayers[i].iDLayerQp       = kP.iQp;
+    sParam.sSpatialLayers[i].sSliceArgument.uiSliceMode = SM_SINGLE_SLICE;
+  }
+  ASSERT_EQ (cmResultSuccess, pEncoder->InitializeExt (&sParam));
+
+  FileInputStream fileStream;
+  ASSERT_TRUE (fileStream.Open (kP.pkcFileName));
+  const int kiFrameSize = kP.iWidth * kP.iHeight * 3 / 2;
+  BufferedData buf;
+  buf.SetLength (kiFrameSize);
+
+  SSourcePicture sPic;
+  memset (&sPic, 0, sizeof (SSourcePicture));
+  sPic.iPicWidth    = kP.iWidth;
+  sPic.iPicHeight   = kP.iHeight;
+  sPic.iColorFormat = videoFormatI420;
+  sPic.iStride[0]   = kP.iWidth;
+  sPic.iStride[1]   = sPic.iStride[2] = kP.iWidth >> 1;
+  sPic.pData[0]     = buf.data();
+  sPic.pData[1]     = sPic.pData[0] + kP.iWidth * kP.iHeight;
+  sPic.pData[2]     = sPic.pData[1] + (kP.iWidth * kP.iHeight >> 2);
+
+  SFrameBSInfo sInfo;
+  SHA1Context ctx;
+  SHA1Reset (&ctx);
+  for (int iFrame = 0; fileStream.read (buf.data(), kiFrameSize) == kiFrameSize; ++iFrame) {
+    sPic.uiTimeStamp = iFrame * 1000 / 12;
+    EXPECT_EQ (cmResultSuccess, pEncoder->EncodeFrame (&sPic, &sInfo));
+    UpdateHashFromFrame (sInfo, &ctx);
+  }
+  SHA1Result (&ctx, pDigest);
+  pEncoder->Uninitialize();
+}
+
+class EncoderWavefrontTest : public ::testing::WithParamInterface<WavefrontParam>, public EncoderInitTest {
+};
+
+// the rows are decided out of order but coded in order, the output is the one of a single thread
+TEST_P (EncoderWavefrontTest, SameOutputAsOneThread) {
+  const WavefrontParam kP = GetParam();
+  unsigned char digest[2][SHA_DIGEST_LENGTH];
+  EncodeWavefrontFile (encoder_, kP, false, digest[0]);
+  ASSERT_FALSE (HasFatalFailure());
+  EncodeWavefrontFile (encoder_, kP, true, digest[1]);
+  ASSERT_FALSE (HasFatalFailure());
+  EXPECT_EQ (0, memcmp (digest[0], digest[1], SHA_DIGEST_LENGTH));
+}
+
+static const WavefrontParam kWavefrontParamArray[] = {
+  {"res/CiscoVT2people_320x192_12fps.yuv", 320, 192, CAMERA_VIDEO_REAL_TIME, RC_OFF_MODE, 1, 26, false, false},
+  {"res/CiscoVT2people_320x192_12fps.yuv", 320, 192, CAMERA_VIDEO_REAL_TIME, RC_OFF_MODE, 1, 26, true, false},
+  {"res/CiscoVT2people_320x192_12fps.yuv", 320, 192, CAMERA_VIDEO_REAL_TIME, RC_OFF_MODE, 2, 30, false, true},
+  {"res/CiscoVT2people_320x192_12fps.yuv", 320, 192, CAMERA_VIDEO_REAL_TIME, RC_BUFFERBASED_MODE, 1, 26, false, true},
+  {"res/CiscoVT2people_320x192_12fps.yuv", 320, 192, SCREEN_CONTENT_REAL_TIME, RC_OFF_MODE, 1, 26, false, true},
+  {"res/Static_152_100.yuv", 152, 100, CAMERA_VIDEO_REAL_TIME, RC_OFF_MODE, 1, 24, true, true},
+  // residuals overflowing the CAVLC tables make MBs coded again with a higher QP
+  {"res/CiscoVT2people_320x192_12fps.yuv", 320, 192, CAMERA_VIDEO_REAL_TIME, RC_OFF_MODE, 1, 0, false, false},
+  {"res/CiscoVT2people_320x192_12fps.yuv", 320, 192, CAMERA_VIDEO_REAL_TIME, RC_OFF_MODE, 1, 0, false, true},
+  // the coarse motion of the MBs is found before their rows are decided
+  {"res/CiscoVT2people_320x192_12fps.yuv", 320, 192, CAMERA_VIDEO_REAL_TIME, RC_OFF_MODE, 2, 26, false, true, 2},
+  {"res/Static_152_100.yuv", 152, 100, CAMERA_VIDEO_REAL_TIME, RC_BUFFERBASED_MODE, 1, 24, true, false, 1},
+  {"res/CiscoVT2people_320x192_12fps.yuv", 320, 192, SCREEN_CONTENT_REAL_TIME, RC_OFF_MODE, 1, 26, false, true, 2},
+};
+
+INSTANTIATE_TEST_CASE_P (EncodeFile, EncoderWavefrontTest,
+                         ::testing::ValuesIn (kWavefrontParamArray));
+
 static const EncodeFileParam kFileParamArray[] = {
   {
     "res/CiscoVT2people_320x192_12fps.yuv",
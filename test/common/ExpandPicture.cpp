@@ -272,3 +272,118 @@ TEST (ExpandPicture, ExpandPicForMotion) {
   }
 }
 
+
+TEST (ExpandPicture, ExpandPictureLines) {
+  SExpandPicFunc sExpandPicFunc;
+  int32_t iCpuCores = 1;
+  uint32_t uiCpuFlag = 0;
+  for (int32_t k = 0; k < 2; k++) {
+    if (k == 0) {
+      uiCpuFlag = 0;
+    } else {
+      uiCpuFlag = WelsCPUFeatureDetect (&iCpuCores);
+    }
+    InitExpandPictureFunc (&sExpandPicFunc, uiCpuFlag);
+    for (int32_t iTestIdx = 0; iTestIdx < EXPAND_PIC_TEST_NUM; iTestIdx++) {
+      int32_t iPicWidth = 1 + rand() % 400;
+      int32_t iLines = rand() % 40;
+      int32_t iPaddingLen = 8 + (rand() % 4) * 8;
+
+      int32_t iStride = iPicWidth + H264_PADDING_LENGTH_LUMA * 2 + rand() % 16;
+      int32_t iBuffSize = (iLines + 1) * iStride * sizeof (uint8_t);
+      uint8_t* pAnchorDstBuff = static_cast<uint8_t*> (WelsMallocz (iBuffSize, "pAnchorDstBuff"));
+      ASSERT_TRUE (pAnchorDstBuff != NULL) << "pAnchorDstBuff alloc failed for size:" << iBuffSize;
+      uint8_t* pAnchorDst = pAnchorDstBuff + H264_PADDING_LENGTH_LUMA;
+
+      uint8_t* pTestDstBuff = static_cast<uint8_t*> (WelsMallocz (iBuffSize, "pTestDstBuff"));
+      ASSERT_TRUE (pTestDstBuff != NULL) << "pTestDstBuff alloc failed for size:" << iBuffSize;
+      uint8_t* pTestDst = pTestDstBuff + H264_PADDING_LENGTH_LUMA;
+
+      // Generate Src
+      for (int32_t j = 0; j < iLines; j++) {
+        for (int32_t i = 0; i < iPicWidth; i++) {
+          pAnchorDst[i + j * iStride] = pTestDst[i + j * iStride] = rand() % 256;
+        }
+      }
+      for (int32_t j = 0; j < iLines; j++) {
+        memset (pAnchorDst + j * iStride - iPaddingLen, pAnchorDst[j * iStride], iPaddingLen);
+        memset (pAnchorDst + j * iStride + iPicWidth, pAnchorDst[j * iStride + iPicWidth - 1], iPaddingLen);
+      }
+      sExpandPicFunc.pfExpandPictureLines (pTestDst, iStride, iPicWidth, iLines, iPaddingLen);
+      EXPECT_EQ (CompareImage (pAnchorDstBuff, pTestDstBuff, iBuffSize), true);
+
+      WELS_SAFE_FREE (pAnchorDstBuff, "pAnchorDstBuff");
+      WELS_SAFE_FREE (pTestDstBuff, "pTestDstBuff");
+    }
+  }
+}
+
+TEST (ExpandPicture, ExpandPicForMotionRows) {
+  SExpandPicFunc sExpandPicFunc;
+  int32_t iCpuCores = 1;
+  uint32_t uiCpuFlag = 0;
+  for (int32_t k = 0; k < 2; k++) {
+    if (k == 0) {
+      uiCpuFlag = 0;
+    } else {
+      uiCpuFlag = WelsCPUFeatureDetect (&iCpuCores);
+    }
+    InitExpandPictureFunc (&sExpandPicFunc, uiCpuFlag);
+    uint8_t* pPicAnchor[3] = {NULL, NULL, NULL};
+    uint8_t* pPicTest[3] = {NULL, NULL, NULL};
+    int32_t iStride[3];
+    for (int32_t iTestIdx = 0; iTestIdx < EXPAND_PIC_TEST_NUM; iTestIdx++) {
+      int32_t iMbWidth = 1 + rand() % 120;
+      int32_t iMbHeight = 1 + rand() % 68;
+      int32_t iPicWidth = iMbWidth << 4;
+      int32_t iPicHeight = iMbHeight << 4;
+      iStride[0]                  = iPicWidth + (PADDING_LENGTH << 1);
+      int32_t iPicHeightExt       = iPicHeight + (PADDING_LENGTH << 1);
+      iStride[1]                  = iStride[0] >> 1;
+      iStride[2]                  = iStride[1];
+      int32_t iLumaSize           = iStride[0] * iPicHeightExt;
+      int32_t iChromaSize         = iStride[1] * (iPicHeightExt >> 1);
+
+      uint8_t* pPicAnchorBuffer = static_cast<uint8_t*> (WelsMallocz (iLumaSize + (iChromaSize << 1), "pPicAnchor"));
+      ASSERT_TRUE (pPicAnchorBuffer != NULL) << "pPicAnchorBuffer alloc failed for size:" << (iLumaSize + (iChromaSize << 1));
+      pPicAnchor[0]     = pPicAnchorBuffer + (1 + iStride[0]) * PADDING_LENGTH;
+      pPicAnchor[1]     = pPicAnchorBuffer + iLumaSize + (((1 + iStride[1]) * PADDING_LENGTH) >> 1);
+      pPicAnchor[2]     = pPicAnchorBuffer + iLumaSize + iChromaSize + (((1 + iStride[2]) * PADDING_LENGTH) >> 1);
+
+      uint8_t* pPicTestBuffer = static_cast<uint8_t*> (WelsMallocz (iLumaSize + (iChromaSize << 1), "pPicTest"));
+      ASSERT_TRUE (pPicTestBuffer != NULL) << "pPicTestBuffer alloc failed for size:" << (iLumaSize + (iChromaSize << 1));
+      pPicTest[0]       = pPicTestBuffer + (1 + iStride[0]) * PADDING_LENGTH;
+      pPicTest[1]       = pPicTestBuffer + iLumaSize + (((1 + iStride[1]) * PADDING_LENGTH) >> 1);
+      pPicTest[2]       = pPicTestBuffer + iLumaSize + iChromaSize + (((1 + iStride[2]) * PADDING_LENGTH) >> 1);
+
+      // Generate Src
+      for (int32_t j = 0; j < iPicHeight; j++) {
+        for (int32_t i = 0; i < iPicWidth; i++) {
+          pPicAnchor[0][i + j * iStride[0]] =  pPicTest[0][i + j * iStride[0]] = rand() % 256;
+        }
+      }
+      for (int32_t j = 0; j < iPicHeight / 2; j++) {
+        for (int32_t i = 0; i < iPicWidth / 2; i++) {
+          pPicAnchor[1][i + j * iStride[1]] =  pPicTest[1][i + j * iStride[1]] = rand() % 256;
+          pPicAnchor[2][i + j * iStride[2]] =  pPicTest[2][i + j * iStride[2]] = rand() % 256;
+        }
+      }
+      H264ExpandPictureLumaAnchor_c (pPicAnchor[0], iStride[0], iPicWidth, iPicHeight);
+      H264ExpandPictureChromaAnchor_c (pPicAnchor[1], iStride[1], iPicWidth / 2, iPicHeight / 2);
+      H264ExpandPictureChromaAnchor_c (pPicAnchor[2], iStride[2], iPicWidth / 2, iPicHeight / 2);
+      // pad in random bands of MB rows, bottom up: the result must not depend on the order
+      int32_t iBandEnd = iMbHeight;
+      while (iBandEnd > 0) {
+        const int32_t kiBandRows = 1 + rand() % 4;
+        const int32_t kiBandFirst = WELS_MAX (iBandEnd - kiBandRows, 0);
+        ExpandReferencingPictureRows (pPicTest, iPicWidth, iPicHeight, iStride, kiBandFirst, iBandEnd, PADDING_LENGTH,
+                                      sExpandPicFunc.pfExpandPictureLines);
+        iBandEnd = kiBandFirst;
+      }
+      EXPECT_EQ (CompareImage (pPicAnchorBuffer, pPicTestBuffer, (iLumaSize + (iChromaSize << 1))), true);
+
+      WELS_SAFE_FREE (pPicAnchorBuffer, "pPicAnchor");
+      WELS_SAFE_FREE (pPicTestBuffer, "pPicTest");
+    }
+  }
+}
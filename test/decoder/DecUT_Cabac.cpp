@@ -0,0 +1,310 @@
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "codec_api.h"
+#include "typedefs.h"
+#include "macros.h"
+#include "cabac_decoder.h"
+#include "wels_common_basis.h"
+#include "measure_time.h"
+#include "utils/ParseOnlyStream.h"
+
+using namespace WelsDec;
+
+#define CABAC_TEST_BUF_SIZE  4096
+#define CABAC_TEST_CTX_NUM   64
+
+static const char* kpCabacStreams[] = {
+  "res/test_cif_I_CABAC_slice.264",
+  "res/test_cif_P_CABAC_slice.264",
+  "res/test_qcif_cabac.264",
+};
+
+// the engine as it was before the table driven renormalization and the 48 bit refill
+static int32_t DecodeBinCabac_ref (PWelsCabacDecEngine pDecEngine, PWelsCabacCtx pBinCtx, uint32_t& uiBinVal) {
+  int32_t iErrorInfo = ERR_NONE;
+  uint32_t uiState = pBinCtx->uiState;
+  uiBinVal = pBinCtx->uiMPS;
+  uint64_t uiOffset = pDecEngine->uiOffset;
+  uint64_t uiRange = pDecEngine->uiRange;
+
+  int32_t iRenorm = 1;
+  uint32_t uiRangeLPS = g_kuiCabacRangeLps[uiState][ (uiRange >> 6) & 0x03];
+  uiRange -= uiRangeLPS;
+  if (uiOffset >= (uiRange << pDecEngine->iBitsLeft)) { //LPS
+    uiOffset -= (uiRange << pDecEngine->iBitsLeft);
+    uiBinVal ^= 0x0001;
+    if (!uiState)
+      pBinCtx->uiMPS ^= 0x01;
+    pBinCtx->uiState = g_kuiStateTransTable[uiState][0];
+    iRenorm = g_kRenormTable256[uiRangeLPS];
+    uiRange = (uiRangeLPS << iRenorm);
+  } else {  //MPS
+    pBinCtx->uiState = g_kuiStateTransTable[uiState][1];
+    if (uiRange >= WELS_CABAC_QUARTER) {
+      pDecEngine->uiRange = uiRange;
+      return ERR_NONE;
+    } else {
+      uiRange <<= 1;
+    }
+  }
+  pDecEngine->uiRange = uiRange;
+  pDecEngine->iBitsLeft -= iRenorm;
+  if (pDecEngine->iBitsLeft > 0) {
+    pDecEngine->uiOffset = uiOffset;
+    return ERR_NONE;
+  }
+  uint32_t uiVal = 0;
+  int32_t iNumBitsRead = 0;
+  iErrorInfo = Read32BitsCabac (pDecEngine, uiVal, iNumBitsRead);
+  pDecEngine->uiOffset = (uiOffset << iNumBitsRead) | uiVal;
+  pDecEngine->iBitsLeft += iNumBitsRead;
+  if (iErrorInfo && pDecEngine->iBitsLeft < 0) {
+    return iErrorInfo;
+  }
+  return ERR_NONE;
+}
+
+static int32_t DecodeBypassCabac_ref (PWelsCabacDecEngine pDecEngine, uint32_t& uiBinVal) {
+  int32_t iErrorInfo = ERR_NONE;
+  int32_t iBitsLeft = pDecEngine->iBitsLeft;
+  uint64_t uiOffset = pDecEngine->uiOffset;
+  uint64_t uiRangeValue;
+
+  if (iBitsLeft <= 0) {
+    uint32_t uiVal = 0;
+    int32_t iNumBitsRead = 0;
+    iErrorInfo = Read32BitsCabac (pDecEngine, uiVal, iNumBitsRead);
+    uiOffset = (uiOffset << iNumBitsRead) | uiVal;
+    iBitsLeft = iNumBitsRead;
+    if (iErrorInfo && iBitsLeft == 0) {
+      return iErrorInfo;
+    }
+  }
+  iBitsLeft--;
+  uiRangeValue = (pDecEngine->uiRange << iBitsLeft);
+  pDecEngine->iBitsLeft = iBitsLeft;
+  if (uiOffset >= uiRangeValue) {
+    pDecEngine->uiOffset = uiOffset - uiRangeValue;
+    uiBinVal = 1;
+    return ERR_NONE;
+  }
+  pDecEngine->uiOffset = uiOffset;
+  uiBinVal = 0;
+  return ERR_NONE;
+}
+
+static int32_t DecodeUEGLevelCabac_ref (PWelsCabacDecEngine pDecEngine, PWelsCabacCtx pBinCtx, uint32_t& uiCode) {
+  uiCode = 0;
+  WELS_READ_VERIFY (DecodeBinCabac_ref (pDecEngine, pBinCtx, uiCode));
+  if (uiCode == 0)
+    return ERR_NONE;
+  uint32_t uiTmp, uiCount = 1;
+  uiCode = 0;
+  do {
+    WELS_READ_VERIFY (DecodeBinCabac_ref (pDecEngine, pBinCtx, uiTmp));
+    ++uiCode;
+    ++uiCount;
+  } while (uiTmp != 0 && uiCount != 13);
+  if (uiTmp != 0) {
+    int32_t iCount = 0, iSymTmp = 0, iSymTmp2 = 0;
+    do {
+      WELS_READ_VERIFY (DecodeBypassCabac_ref (pDecEngine, uiTmp));
+      if (uiTmp == 1) {
+        iSymTmp += (1 << iCount);
+        ++iCount;
+      }
+    } while (uiTmp != 0 && iCount != 16);
+    if (iCount == 16)
+      return GENERATE_ERROR_NO (ERR_LEVEL_MB_DATA, ERR_CABAC_UNEXPECTED_VALUE);
+    while (iCount--) {
+      WELS_READ_VERIFY (DecodeBypassCabac_ref (pDecEngine, uiTmp));
+      if (uiTmp == 1)
+        iSymTmp2 |= (1 << iCount);
+    }
+    uiCode += iSymTmp + iSymTmp2 + 1;
+  }
+  return ERR_NONE;
+}
+
+// significance map and levels of one block bin by bin, as ParseSignificantMapCabac() and
+// ParseSignificantCoeffCabac() did it
+static int32_t DecodeResidualBlock_ref (PWelsCabacDecEngine pDecEngine, PWelsCabacCtx pMapCtx, PWelsCabacCtx pLastCtx,
+                                        PWelsCabacCtx pOneCtx, PWelsCabacCtx pAbsCtx, bool b8x8, int32_t iMaxPos, int32_t iMaxC2,
+                                        int32_t* pSignificantMap, uint32_t& uiCoeffNum) {
+  uint32_t uiCode;
+  int32_t i;
+  uiCoeffNum = 0;
+  for (i = 0; i < iMaxPos; ++i) {
+    WELS_READ_VERIFY (DecodeBinCabac_ref (pDecEngine, pMapCtx + (b8x8 ? g_kuiIdx2CtxSignificantCoeffFlag8x8[i] : i),
+                                          uiCode));
+    pSignificantMap[i] = uiCode;
+    if (uiCode) {
+      ++uiCoeffNum;
+      WELS_READ_VERIFY (DecodeBinCabac_ref (pDecEngine, pLastCtx + (b8x8 ? g_kuiIdx2CtxLastSignificantCoeffFlag8x8[i] : i),
+                                            uiCode));
+      if (uiCode) {
+        memset (pSignificantMap + i + 1, 0, (iMaxPos - i) * sizeof (int32_t));
+        break;
+      }
+    }
+  }
+  if (i == iMaxPos) {
+    pSignificantMap[iMaxPos] = 1;
+    ++uiCoeffNum;
+  }
+
+  int32_t c1 = 1, c2 = 0;
+  for (i = iMaxPos; i >= 0; --i) {
+    int32_t* pCoff = pSignificantMap + i;
+    if (*pCoff != 0) {
+      WELS_READ_VERIFY (DecodeBinCabac_ref (pDecEngine, pOneCtx + c1, uiCode));
+      *pCoff += uiCode;
+      if (*pCoff == 2) {
+        WELS_READ_VERIFY (DecodeUEGLevelCabac_ref (pDecEngine, pAbsCtx + c2, uiCode));
+        *pCoff += uiCode;
+        c2 = WELS_MIN (c2 + 1, iMaxC2);
+        c1 = 0;
+      } else if (c1) {
+        c1 = WELS_MIN (c1 + 1, 4);
+      }
+      WELS_READ_VERIFY (DecodeBypassCabac_ref (pDecEngine, uiCode));
+      if (uiCode)
+        *pCoff = - *pCoff;
+    }
+  }
+  return ERR_NONE;
+}
+
+static int32_t DecodeResidualBlock (PWelsCabacDecEngine pDecEngine, PWelsCabacCtx pMapCtx, PWelsCabacCtx pLastCtx,
+                                    PWelsCabacCtx pOneCtx, PWelsCabacCtx pAbsCtx, bool b8x8, int32_t iMaxPos, int32_t iMaxC2,
+                                    int32_t* pSignificantMap, uint32_t& uiCoeffNum) {
+  static const uint8_t kuiIdx2Ctx4x4[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+  memset (pSignificantMap, 0, (iMaxPos + 1) * sizeof (int32_t));
+  return DecodeResidualCoeffsCabac (pDecEngine, pMapCtx, pLastCtx, pOneCtx, pAbsCtx,
+                                    b8x8 ? g_kuiIdx2CtxSignificantCoeffFlag8x8 : kuiIdx2Ctx4x4,
+                                    b8x8 ? g_kuiIdx2CtxLastSignificantCoeffFlag8x8 : kuiIdx2Ctx4x4, iMaxPos, iMaxC2, pSignificantMap, uiCoeffNum);
+}
+
+// same state as InitCabacDecEngineFromBS() sets up at the start of slice data, the top bit is
+// dropped as a valid slice never starts with an offset of 510 or 511
+static void InitTestEngine (PWelsCabacDecEngine pDecEngine, uint8_t* pBuf, int32_t iSize) {
+  pDecEngine->uiOffset = ((uint64_t) (pBuf[0] & 0x7f) << 32) | ((uint64_t)pBuf[1] << 24) | ((uint64_t)pBuf[2] << 16) |
+                         ((uint64_t)pBuf[3] << 8) | pBuf[4];
+  pDecEngine->iBitsLeft = 31;
+  pDecEngine->uiRange = WELS_CABAC_HALF;
+  pDecEngine->pBuffStart = pBuf;
+  pDecEngine->pBuffCurr = pBuf + 5;
+  pDecEngine->pBuffEnd = pBuf + iSize;
+}
+
+static void InitTestCtx (PWelsCabacCtx pCtx, int32_t iNum) {
+  for (int32_t i = 0; i < iNum; ++ i) {
+    pCtx[i].uiState = (uint8_t) (rand() % 63);
+    pCtx[i].uiMPS = (uint8_t) (rand() & 1);
+  }
+}
+
+// the engines refill differently, compare the bit position and the offset bits in use
+static void ExpectSameEngineState (const SWelsCabacDecEngine& sRef, const SWelsCabacDecEngine& sDec) {
+  EXPECT_EQ (sRef.uiRange, sDec.uiRange);
+  EXPECT_EQ ((sRef.pBuffCurr - sRef.pBuffStart) * 8 - sRef.iBitsLeft, (sDec.pBuffCurr - sDec.pBuffStart) * 8 - sDec.iBitsLeft);
+  if (sRef.iBitsLeft >= 0 && sDec.iBitsLeft >= 0) {
+    EXPECT_EQ (sRef.uiOffset >> sRef.iBitsLeft, sDec.uiOffset >> sDec.iBitsLeft);
+  }
+}
+
+TEST (DecoderCabacTest, DecodeBinBitExact) {
+  uint8_t uiBuf[CABAC_TEST_BUF_SIZE];
+  SWelsCabacCtx sCtxRef[CABAC_TEST_CTX_NUM], sCtx[CABAC_TEST_CTX_NUM];
+  SWelsCabacDecEngine sEngineRef, sEngine;
+  srand ((unsigned int)time (NULL));
+  for (int32_t iTimes = 0; iTimes < 200; ++ iTimes) {
+    const int32_t kiSize = 5 + rand() % (CABAC_TEST_BUF_SIZE - 5);
+    for (int32_t i = 0; i < kiSize; ++ i)
+      uiBuf[i] = (uint8_t)rand();
+    InitTestCtx (sCtxRef, CABAC_TEST_CTX_NUM);
+    memcpy (sCtx, sCtxRef, sizeof (sCtx));
+    InitTestEngine (&sEngineRef, uiBuf, kiSize);
+    InitTestEngine (&sEngine, uiBuf, kiSize);
+    // run until the end of the buffer is hit, the tail is refilled byte wise
+    for (;;) {
+      uint32_t uiBinRef = 0, uiBin = 0;
+      int32_t iRetRef, iRet;
+      if (rand() % 4) {
+        const int32_t kiCtx = rand() % CABAC_TEST_CTX_NUM;
+        iRetRef = DecodeBinCabac_ref (&sEngineRef, sCtxRef + kiCtx, uiBinRef);
+        iRet = DecodeBinCabac (&sEngine, sCtx + kiCtx, uiBin);
+      } else {
+        iRetRef = DecodeBypassCabac_ref (&sEngineRef, uiBinRef);
+        iRet = DecodeBypassCabac (&sEngine, uiBin);
+      }
+      ASSERT_EQ (iRetRef, iRet);
+      if (iRet)
+        break;
+      ASSERT_EQ (uiBinRef, uiBin);
+    }
+    EXPECT_EQ (0, memcmp (sCtxRef, sCtx, sizeof (sCtx)));
+  }
+}
+
+TEST (DecoderCabacTest, DecodeResidualBlockBitExact) {
+  static const int32_t kiMaxPos[4] = {15, 14, 3, 63};
+  uint8_t uiBuf[CABAC_TEST_BUF_SIZE];
+  SWelsCabacCtx sCtxRef[4][CABAC_TEST_CTX_NUM], sCtx[4][CABAC_TEST_CTX_NUM];
+  SWelsCabacDecEngine sEngineRef, sEngine;
+  int32_t iMapRef[64], iMap[64];
+  srand ((unsigned int)time (NULL));
+  for (int32_t iTimes = 0; iTimes < 200; ++ iTimes) {
+    const int32_t kiSize = 5 + rand() % (CABAC_TEST_BUF_SIZE - 5);
+    for (int32_t i = 0; i < kiSize; ++ i)
+      uiBuf[i] = (uint8_t)rand();
+    InitTestCtx (&sCtxRef[0][0], 4 * CABAC_TEST_CTX_NUM);
+    memcpy (sCtx, sCtxRef, sizeof (sCtx));
+    InitTestEngine (&sEngineRef, uiBuf, kiSize);
+    InitTestEngine (&sEngine, uiBuf, kiSize);
+    for (;;) {
+      const int32_t kiMaxPosIdx = rand() % 4;
+      const int32_t kiMaxC2 = 3 + (rand() & 1);
+      uint32_t uiNumRef = 0, uiNum = 0;
+      int32_t iRetRef = DecodeResidualBlock_ref (&sEngineRef, sCtxRef[0], sCtxRef[1], sCtxRef[2], sCtxRef[3],
+                        kiMaxPosIdx == 3, kiMaxPos[kiMaxPosIdx], kiMaxC2, iMapRef, uiNumRef);
+      int32_t iRet = DecodeResidualBlock (&sEngine, sCtx[0], sCtx[1], sCtx[2], sCtx[3], kiMaxPosIdx == 3,
+                                          kiMaxPos[kiMaxPosIdx], kiMaxC2, iMap, uiNum);
+      ASSERT_EQ (iRetRef != ERR_NONE, iRet != ERR_NONE);
+      if (iRet)
+        break;
+      ASSERT_EQ (uiNumRef, uiNum);
+      ASSERT_EQ (0, memcmp (iMapRef, iMap, (kiMaxPos[kiMaxPosIdx] + 1) * sizeof (int32_t)));
+      ExpectSameEngineState (sEngineRef, sEngine);
+    }
+    EXPECT_EQ (0, memcmp (sCtxRef, sCtx, sizeof (sCtx)));
+  }
+}
+
+// parse only decoding of the CABAC streams in res/, no reconstruction
+TEST (DecoderCabacTest, ParseOnly) {
+  for (uint32_t iStream = 0; iStream < sizeof (kpCabacStreams) / sizeof (kpCabacStreams[0]); ++ iStream) {
+    int64_t iTime;
+    const int32_t kiFrameNum = ParseOnlyStream (kpCabacStreams[iStream], &iTime);
+    ASSERT_GE (kiFrameNum, 0) << kpCabacStreams[iStream];
+    EXPECT_GT (kiFrameNum, 0) << kpCabacStreams[iStream];
+  }
+}
+
+// CABAC parse only throughput, disabled by default, run it with --gtest_also_run_disabled_tests
+TEST (DecoderCabacTest, DISABLED_ParseOnlySpeed) {
+  for (uint32_t iStream = 0; iStream < sizeof (kpCabacStreams) / sizeof (kpCabacStreams[0]); ++ iStream) {
+    FILE* pFile = fopen (kpCabacStreams[iStream], "rb");
+    if (pFile == NULL)
+      continue;
+    fseek (pFile, 0, SEEK_END);
+    const int64_t kiBits = (int64_t)ftell (pFile) * 8;
+    fclose (pFile);
+    int64_t iTime;
+    const int32_t kiFrameNum = ParseOnlyStream (kpCabacStreams[iStream], &iTime);
+    printf ("%s: CABAC parse only %d frames, %.1f Mbit/s\n", kpCabacStreams[iStream], kiFrameNum,
+            (double)kiBits / WELS_MAX (iTime, 1));
+  }
+}
@@ -0,0 +1,315 @@
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "codec_api.h"
+#include "typedefs.h"
+#include "macros.h"
+#include "decoder_context.h"
+#include "parse_mb_syn_cavlc.h"
+#include "vlc_decoder.h"
+#include "error_code.h"
+#include "measure_time.h"
+#include "utils/ParseOnlyStream.h"
+
+using namespace WelsDec;
+
+#define CAVLC_TEST_BUF_SIZE  4096
+#define CAVLC_TEST_BUF_PAD   16
+
+static const char* kpCavlcStreams[] = {
+  "res/BA1_FT_C.264",
+  "res/LS_SVA_D.264",
+  "res/MR2_TANDBERG_E.264",
+};
+
+// the residual parsing as it was before the 64 bit cache and the multi symbol tables
+typedef struct TagReadBitsCacheRef {
+  uint32_t uiCache32Bit;
+  uint8_t  uiRemainBits;
+  uint8_t*  pBuf;
+} SReadBitsCacheRef;
+
+#define SHIFT_BUFFER_REF(pBitsCache)        { pBitsCache->pBuf+=2; pBitsCache->uiRemainBits += 16; pBitsCache->uiCache32Bit |= (((pBitsCache->pBuf[2] << 8) | pBitsCache->pBuf[3]) << (32 - pBitsCache->uiRemainBits)); }
+#define POP_BUFFER_REF(pBitsCache, iCount)  { pBitsCache->uiCache32Bit <<= iCount;  pBitsCache->uiRemainBits -= iCount; }
+
+static int32_t CavlcGetTrailingOnesAndTotalCoeff_ref (uint8_t& uiTotalCoeff, uint8_t& uiTrailingOnes,
+    SReadBitsCacheRef* pBitsCache, SVlcTable* pVlcTable, bool bChromaDc, int8_t nC) {
+  const uint8_t* kpVlcTableMoreBitsCountList[3] = {g_kuiVlcTableMoreBitsCount0, g_kuiVlcTableMoreBitsCount1, g_kuiVlcTableMoreBitsCount2};
+  int32_t iUsedBits = 0;
+  int32_t iIndexVlc, iIndexValue, iNcMapIdx;
+  uint32_t uiCount;
+  uint32_t uiValue;
+
+  if (bChromaDc) {
+    uiValue        = pBitsCache->uiCache32Bit >> 24;
+    iIndexVlc      = pVlcTable->kpChromaCoeffTokenVlcTable[uiValue][0];
+    uiCount        = pVlcTable->kpChromaCoeffTokenVlcTable[uiValue][1];
+    POP_BUFFER_REF (pBitsCache, uiCount);
+    iUsedBits     += uiCount;
+    uiTrailingOnes = g_kuiVlcTrailingOneTotalCoeffTable[iIndexVlc][0];
+    uiTotalCoeff   = g_kuiVlcTrailingOneTotalCoeffTable[iIndexVlc][1];
+  } else {
+    iNcMapIdx = g_kuiNcMapTable[nC];
+    if (iNcMapIdx <= 2) {
+      uiValue = pBitsCache->uiCache32Bit >> 24;
+      if (uiValue < g_kuiVlcTableNeedMoreBitsThread[iNcMapIdx]) {
+        POP_BUFFER_REF (pBitsCache, 8);
+        iUsedBits  += 8;
+        iIndexValue = pBitsCache->uiCache32Bit >> (32 - kpVlcTableMoreBitsCountList[iNcMapIdx][uiValue]);
+        iIndexVlc   = pVlcTable->kpCoeffTokenVlcTable[iNcMapIdx + 1][uiValue][iIndexValue][0];
+        uiCount     = pVlcTable->kpCoeffTokenVlcTable[iNcMapIdx + 1][uiValue][iIndexValue][1];
+        POP_BUFFER_REF (pBitsCache, uiCount);
+        iUsedBits  += uiCount;
+      } else {
+        iIndexVlc  = pVlcTable->kpCoeffTokenVlcTable[0][iNcMapIdx][uiValue][0];
+        uiCount    = pVlcTable->kpCoeffTokenVlcTable[0][iNcMapIdx][uiValue][1];
+        POP_BUFFER_REF (pBitsCache, uiCount);
+        iUsedBits += uiCount;
+      }
+    } else {
+      uiValue    = pBitsCache->uiCache32Bit >> (32 - 6);
+      POP_BUFFER_REF (pBitsCache, 6);
+      iUsedBits += 6;
+      iIndexVlc  = pVlcTable->kpCoeffTokenVlcTable[0][3][uiValue][0];
+    }
+    uiTrailingOnes = g_kuiVlcTrailingOneTotalCoeffTable[iIndexVlc][0];
+    uiTotalCoeff  = g_kuiVlcTrailingOneTotalCoeffTable[iIndexVlc][1];
+  }
+  return iUsedBits;
+}
+
+static int32_t CavlcGetLevelVal_ref (int32_t iLevel[16], SReadBitsCacheRef* pBitsCache, uint8_t uiTotalCoeff,
+                                     uint8_t uiTrailingOnes) {
+  int32_t i, iUsedBits = 0;
+  int32_t iSuffixLength, iSuffixLengthSize, iLevelPrefix, iPrefixBits, iLevelCode, iThreshold;
+  for (i = 0; i < uiTrailingOnes; i++) {
+    iLevel[i] = 1 - ((pBitsCache->uiCache32Bit >> (30 - i)) & 0x02);
+  }
+  POP_BUFFER_REF (pBitsCache, uiTrailingOnes);
+  iUsedBits += uiTrailingOnes;
+
+  iSuffixLength = (uiTotalCoeff > 10 && uiTrailingOnes < 3);
+
+  for (; i < uiTotalCoeff; i++) {
+    if (pBitsCache->uiRemainBits <= 16) SHIFT_BUFFER_REF (pBitsCache);
+    WELS_GET_PREFIX_BITS (pBitsCache->uiCache32Bit, iPrefixBits);
+    if (iPrefixBits > 15 + 1)
+      return -1;
+    POP_BUFFER_REF (pBitsCache, iPrefixBits);
+    iUsedBits   += iPrefixBits;
+    iLevelPrefix = iPrefixBits - 1;
+
+    iLevelCode = iLevelPrefix << iSuffixLength;
+    iSuffixLengthSize = iSuffixLength;
+
+    if (iLevelPrefix >= 14) {
+      if (14 == iLevelPrefix && 0 == iSuffixLength)
+        iSuffixLengthSize = 4;
+      else if (15 == iLevelPrefix) {
+        iSuffixLengthSize = 12;
+        if (iSuffixLength == 0)
+          iLevelCode += 15;
+      }
+    }
+
+    if (iSuffixLengthSize > 0) {
+      if (pBitsCache->uiRemainBits <= iSuffixLengthSize) SHIFT_BUFFER_REF (pBitsCache);
+      iLevelCode += (pBitsCache->uiCache32Bit >> (32 - iSuffixLengthSize));
+      POP_BUFFER_REF (pBitsCache, iSuffixLengthSize);
+      iUsedBits  += iSuffixLengthSize;
+    }
+
+    iLevelCode += ((i == uiTrailingOnes) && (uiTrailingOnes < 3)) << 1;
+    iLevel[i]   = ((iLevelCode + 2) >> 1);
+    iLevel[i]  -= (iLevel[i] << 1) & (- (iLevelCode & 0x01));
+
+    iSuffixLength += !iSuffixLength;
+    iThreshold     = 3 << (iSuffixLength - 1);
+    iSuffixLength += ((iLevel[i] > iThreshold) || (iLevel[i] < -iThreshold)) && (iSuffixLength < 6);
+  }
+  return iUsedBits;
+}
+
+static int32_t CavlcGetTotalZeros_ref (int32_t& iZerosLeft, SReadBitsCacheRef* pBitsCache, uint8_t uiTotalCoeff,
+                                       SVlcTable* pVlcTable, bool bChromaDc) {
+  const uint8_t* kpBitNumMap = bChromaDc ? g_kuiTotalZerosBitNumChromaMap : g_kuiTotalZerosBitNumMap;
+  int32_t iCount = kpBitNumMap[uiTotalCoeff - 1];
+  if (pBitsCache->uiRemainBits < iCount) SHIFT_BUFFER_REF (pBitsCache);
+  uint32_t uiValue = pBitsCache->uiCache32Bit >> (32 - iCount);
+  iCount     = pVlcTable->kpTotalZerosTable[bChromaDc][uiTotalCoeff - 1][uiValue][1];
+  POP_BUFFER_REF (pBitsCache, iCount);
+  iZerosLeft = pVlcTable->kpTotalZerosTable[bChromaDc][uiTotalCoeff - 1][uiValue][0];
+  return iCount;
+}
+
+static int32_t CavlcGetRunBefore_ref (int32_t iRun[16], SReadBitsCacheRef* pBitsCache, uint8_t uiTotalCoeff,
+                                      SVlcTable* pVlcTable, int32_t iZerosLeft) {
+  int32_t i, iUsedBits = 0;
+  uint32_t uiCount, uiValue, iPrefixBits;
+
+  for (i = 0; i < uiTotalCoeff - 1; i++) {
+    if (iZerosLeft > 0) {
+      uiCount = g_kuiZeroLeftBitNumMap[iZerosLeft];
+      if (pBitsCache->uiRemainBits < uiCount) SHIFT_BUFFER_REF (pBitsCache);
+      uiValue = pBitsCache->uiCache32Bit >> (32 - uiCount);
+      if (iZerosLeft < 7) {
+        uiCount = pVlcTable->kpZeroTable[iZerosLeft - 1][uiValue][1];
+        POP_BUFFER_REF (pBitsCache, uiCount);
+        iUsedBits += uiCount;
+        iRun[i] = pVlcTable->kpZeroTable[iZerosLeft - 1][uiValue][0];
+      } else {
+        POP_BUFFER_REF (pBitsCache, uiCount);
+        iUsedBits += uiCount;
+        if (pVlcTable->kpZeroTable[6][uiValue][0] < 7) {
+          iRun[i] = pVlcTable->kpZeroTable[6][uiValue][0];
+        } else {
+          if (pBitsCache->uiRemainBits < 16) SHIFT_BUFFER_REF (pBitsCache);
+          WELS_GET_PREFIX_BITS (pBitsCache->uiCache32Bit, iPrefixBits);
+          iRun[i] = iPrefixBits + 6;
+          if (iRun[i] > iZerosLeft)
+            return -1;
+          POP_BUFFER_REF (pBitsCache, iPrefixBits);
+          iUsedBits += iPrefixBits;
+        }
+      }
+    } else {
+      for (int j = i; j < uiTotalCoeff; j++) {
+        iRun[j] = 0;
+      }
+      return iUsedBits;
+    }
+    iZerosLeft -= iRun[i];
+  }
+  iRun[uiTotalCoeff - 1] = iZerosLeft;
+  return iUsedBits;
+}
+
+// levels in scan order, without dequantization; return: used bits, -1 on error
+static int32_t ResidualBlockCavlc_ref (SVlcTable* pVlcTable, uint8_t* pBuf, int32_t iIndex, int8_t nC, bool bChromaDc,
+                                       int32_t iMaxNumCoeff, int32_t iCoeff[16], uint8_t& uiTotalCoeff) {
+  int32_t iLevel[16], iRun[16], iZerosLeft, i;
+  uint8_t uiTrailingOnes;
+  int32_t iUsedBits = 0;
+  uint8_t* pCur = pBuf + (iIndex >> 3);
+  SReadBitsCacheRef sReadBitsCache;
+  sReadBitsCache.uiCache32Bit = ((pCur[0] << 24) | (pCur[1] << 16) | (pCur[2] << 8) | pCur[3]) << (iIndex & 0x07);
+  sReadBitsCache.uiRemainBits = 32 - (iIndex & 0x07);
+  sReadBitsCache.pBuf = pCur;
+
+  iUsedBits += CavlcGetTrailingOnesAndTotalCoeff_ref (uiTotalCoeff, uiTrailingOnes, &sReadBitsCache, pVlcTable,
+               bChromaDc, nC);
+  if (0 == uiTotalCoeff)
+    return iUsedBits;
+  if ((uiTrailingOnes > 3) || (uiTotalCoeff > 16))
+    return -1;
+  if ((i = CavlcGetLevelVal_ref (iLevel, &sReadBitsCache, uiTotalCoeff, uiTrailingOnes)) == -1)
+    return -1;
+  iUsedBits += i;
+  iZerosLeft = 0;
+  if (uiTotalCoeff < iMaxNumCoeff)
+    iUsedBits += CavlcGetTotalZeros_ref (iZerosLeft, &sReadBitsCache, uiTotalCoeff, pVlcTable, bChromaDc);
+  if ((iZerosLeft < 0) || ((iZerosLeft + uiTotalCoeff) > iMaxNumCoeff))
+    return -1;
+  if ((i = CavlcGetRunBefore_ref (iRun, &sReadBitsCache, uiTotalCoeff, pVlcTable, iZerosLeft)) == -1)
+    return -1;
+  iUsedBits += i;
+
+  int32_t iCoeffNum = -1;
+  for (i = uiTotalCoeff - 1; i >= 0; --i) {
+    iCoeffNum += iRun[i] + 1;
+    iCoeff[iCoeffNum] = iLevel[i];
+  }
+  return iUsedBits;
+}
+
+static void FillCavlcBuf (uint8_t* pBuf, int32_t iSize) {
+  // mostly short codes: small levels and runs as in a typical block, sometimes anything
+  const int32_t kiZeroRate = rand() % 80;
+  for (int32_t i = 0; i < iSize; ++ i) {
+    pBuf[i] = 0;
+    for (int32_t j = 0; j < 8; ++ j)
+      pBuf[i] = (uint8_t) ((pBuf[i] << 1) | (rand() % 100 >= kiZeroRate));
+  }
+  memset (pBuf + iSize, 0, CAVLC_TEST_BUF_PAD);
+}
+
+TEST (DecoderCavlcTest, ResidualBlockBitExact) {
+  static const int32_t kiProperty[4] = {LUMA_DC_AC_INTRA, I16_LUMA_AC, CHROMA_AC_U, CHROMA_DC_U};
+  static const int32_t kiMaxNumCoeff[4] = {16, 15, 15, 4};
+  uint8_t uiBuf[CAVLC_TEST_BUF_SIZE + CAVLC_TEST_BUF_PAD];
+  uint8_t uiNzc[48];
+  ENFORCE_STACK_ALIGN_1D (int16_t, iTCoeff, 16, 16);
+  int32_t iCoeffRef[16];
+  SVlcTable sVlcTable;
+  SBitStringAux sBs;
+  PWelsDecoderContext pCtx = (PWelsDecoderContext)calloc (1, sizeof (SWelsDecoderContext));
+  ASSERT_TRUE (pCtx != NULL);
+  InitVlcTable (&sVlcTable);
+  srand ((unsigned int)time (NULL));
+  for (int32_t iTimes = 0; iTimes < 1000; ++ iTimes) {
+    const int32_t kiSize = 1 + rand() % CAVLC_TEST_BUF_SIZE;
+    FillCavlcBuf (uiBuf, kiSize);
+    memset (&sBs, 0, sizeof (sBs));
+    sBs.pStartBuf = uiBuf;
+    sBs.pEndBuf = uiBuf + kiSize;
+    sBs.iBits = kiSize << 3;
+    sBs.iIndex = rand() % 8;
+    // a residual block per call, until the first invalid code or the end of the buffer
+    while (sBs.iIndex < sBs.iBits) {
+      const int32_t kiType = rand() % 4;
+      const uint8_t kuiQp = (uint8_t) (rand() % 52);
+      const int8_t kiNc = (int8_t) (rand() % 17);
+      uint8_t uiTotalCoeffRef = 0;
+      memset (iCoeffRef, 0, sizeof (iCoeffRef));
+      const int32_t kiUsedBitsRef = ResidualBlockCavlc_ref (&sVlcTable, uiBuf, (int32_t)sBs.iIndex, kiNc,
+                                    kiProperty[kiType] == CHROMA_DC_U, kiMaxNumCoeff[kiType], iCoeffRef, uiTotalCoeffRef);
+
+      // nC of the block at index 0 is the average of the left and top neighbours
+      memset (uiNzc, kiNc, sizeof (uiNzc));
+      memset (iTCoeff, 0, 16 * sizeof (int16_t));
+      const intX_t kiIndex = sBs.iIndex;
+      int32_t iRet = WelsResidualBlockCavlc (&sVlcTable, uiNzc, &sBs, 0, kiMaxNumCoeff[kiType], g_kuiZigzagScan,
+                                             kiProperty[kiType], iTCoeff, kuiQp, pCtx);
+      ASSERT_EQ (kiUsedBitsRef < 0, iRet != ERR_NONE);
+      if (iRet != ERR_NONE)
+        break;
+      ASSERT_EQ (kiIndex + kiUsedBitsRef, sBs.iIndex);
+      if (kiProperty[kiType] == CHROMA_DC_U)
+        continue;
+      EXPECT_EQ (uiTotalCoeffRef, uiNzc[g_kuiCache48CountScan4Idx[0]]);
+      for (int32_t i = 0; i < 16; ++ i) {
+        const int32_t j = g_kuiZigzagScan[i];
+        EXPECT_EQ ((int16_t) (iCoeffRef[i] * g_kuiDequantCoeff[kuiQp][j & 0x07]), iTCoeff[j]);
+      }
+    }
+  }
+  free (pCtx);
+}
+
+// parse only decoding of the CAVLC streams in res/, no reconstruction
+TEST (DecoderCavlcTest, ParseOnly) {
+  for (uint32_t iStream = 0; iStream < sizeof (kpCavlcStreams) / sizeof (kpCavlcStreams[0]); ++ iStream) {
+    int64_t iTime;
+    const int32_t kiFrameNum = ParseOnlyStream (kpCavlcStreams[iStream], &iTime);
+    ASSERT_GE (kiFrameNum, 0) << kpCavlcStreams[iStream];
+    EXPECT_GT (kiFrameNum, 0) << kpCavlcStreams[iStream];
+  }
+}
+
+// CAVLC parse only throughput, disabled by default, run it with --gtest_also_run_disabled_tests
+TEST (DecoderCavlcTest, DISABLED_ParseOnlySpeed) {
+  for (uint32_t iStream = 0; iStream < sizeof (kpCavlcStreams) / sizeof (kpCavlcStreams[0]); ++ iStream) {
+    FILE* pFile = fopen (kpCavlcStreams[iStream], "rb");
+    if (pFile == NULL)
+      continue;
+    fseek (pFile, 0, SEEK_END);
+    const int64_t kiBits = (int64_t)ftell (pFile) * 8;
+    fclose (pFile);
+    int64_t iTime;
+    const int32_t kiFrameNum = ParseOnlyStream (kpCavlcStreams[iStream], &iTime);
+    printf ("%s: CAVLC parse only %d frames, %.1f Mbit/s\n", kpCavlcStreams[iStream], kiFrameNum,
+            (double)kiBits / WELS_MAX (iTime, 1));
+  }
+}
@@ -3,6 +3,7 @@
 #include "cpu_core.h"
 #include "deblocking_common.h"
 #include "macros.h"
+#include "measure_time.h"
 
 #define WRAP_LUMA_FUNC(func) \
 void func ## _wrap (uint8_t* pPixY, int32_t iStride, int32_t iAlpha, int32_t iBeta, int8_t* pTc) { \
@@ -109,6 +110,64 @@ GENERATE_CHROMA_UT (ChromaLt4V_ssse3, DeblockChromaLt4V_ssse3, DeblockChromaLt4V
 GENERATE_CHROMA_UT (ChromaLt4H_ssse3, DeblockChromaLt4H_ssse3, DeblockChromaLt4H_c, WELS_CPU_SSSE3, 1)
 GENERATE_CHROMA_UT (ChromaEq4V_ssse3, DeblockChromaEq4V_ssse3_wrap, DeblockChromaEq4V_c_wrap, WELS_CPU_SSSE3, 0)
 GENERATE_CHROMA_UT (ChromaEq4H_ssse3, DeblockChromaEq4H_ssse3_wrap, DeblockChromaEq4H_c_wrap, WELS_CPU_SSSE3, 1)
+
+#if defined(HAVE_AVX2)
+WRAP_LUMA_FUNC (DeblockLumaEq4V_avx2)
+WRAP_LUMA_FUNC (DeblockLumaEq4H_avx2)
+
+GENERATE_LUMA_UT (LumaLt4V_avx2, DeblockLumaLt4V_avx2, DeblockLumaLt4V_c, WELS_CPU_AVX2, 0)
+GENERATE_LUMA_UT (LumaLt4H_avx2, DeblockLumaLt4H_avx2, DeblockLumaLt4H_c, WELS_CPU_AVX2, 1)
+GENERATE_LUMA_UT (LumaEq4V_avx2, DeblockLumaEq4V_avx2_wrap, DeblockLumaEq4V_c_wrap, WELS_CPU_AVX2, 0)
+GENERATE_LUMA_UT (LumaEq4H_avx2, DeblockLumaEq4H_avx2_wrap, DeblockLumaEq4H_c_wrap, WELS_CPU_AVX2, 1)
+
+typedef void (*PLumaDeblockFunc) (uint8_t* pPixY, int32_t iStride, int32_t iAlpha, int32_t iBeta, int8_t* pTc);
+
+#define DEBLOCK_SPEED_LOOP_NUM 200000
+
+// filters a 16x16 block over and over, the pixels are refreshed from pSrc each time so that the
+// filter decisions stay the same for all the implementations
+static int64_t TimeLumaDeblock (PLumaDeblockFunc pFunc, const uint8_t* pSrc, int32_t iHoriz, int8_t* pTc) {
+  ENFORCE_STACK_ALIGN_1D (uint8_t, pBuffer, 16 * 17, 16);
+  uint8_t* pStart = iHoriz ? pBuffer + 16 + 8 : pBuffer + 16 * 8;
+  int64_t iTime = WelsTime();
+  for (int32_t i = 0; i < DEBLOCK_SPEED_LOOP_NUM; i++) {
+    memcpy (pBuffer, pSrc, 16 * 17);
+    pFunc (pStart, 16, 40, 12, pTc);
+  }
+  return WelsTime() - iTime;
+}
+
+// luma edge throughput of the C, SSSE3 and AVX2 filters, disabled by default, run it with
+// --gtest_also_run_disabled_tests
+TEST (DeblockTest, DISABLED_LumaSpeed_avx2) {
+  int32_t iNumberofCPUCore = 1;
+  uint32_t uiCPUFlags = WelsCPUFeatureDetect (&iNumberofCPUCore);
+  if ((uiCPUFlags & WELS_CPU_AVX2) == 0)
+    return;
+  ENFORCE_STACK_ALIGN_1D (uint8_t, pSrc, 16 * 17, 16);
+  ENFORCE_STACK_ALIGN_1D (int8_t, iTc, 4, 16);
+  // smooth area with some noise, so that most pixels get filtered
+  for (int32_t i = 0; i < 16 * 17; i++)
+    pSrc[i] = (uint8_t) (128 + (rand() % 9) - 4);
+  for (int32_t i = 0; i < 4; i++)
+    iTc[i] = (int8_t) (i + 1);
+
+  const PLumaDeblockFunc kpFuncs[3][4] = {
+    {DeblockLumaLt4V_c, DeblockLumaLt4H_c, DeblockLumaEq4V_c_wrap, DeblockLumaEq4H_c_wrap},
+    {DeblockLumaLt4V_ssse3, DeblockLumaLt4H_ssse3, DeblockLumaEq4V_ssse3_wrap, DeblockLumaEq4H_ssse3_wrap},
+    {DeblockLumaLt4V_avx2, DeblockLumaLt4H_avx2, DeblockLumaEq4V_avx2_wrap, DeblockLumaEq4H_avx2_wrap},
+  };
+  const char* kpNames[4] = {"Lt4V", "Lt4H", "Eq4V", "Eq4H"};
+  for (int32_t iFunc = 0; iFunc < 4; iFunc++) {
+    int64_t iTime[3];
+    for (int32_t iImpl = 0; iImpl < 3; iImpl++)
+      iTime[iImpl] = TimeLumaDeblock (kpFuncs[iImpl][iFunc], pSrc, iFunc & 1, iTc);
+    printf ("luma %s edges: c %.1f, ssse3 %.1f, avx2 %.1f Medges/s\n", kpNames[iFunc],
+            (double)DEBLOCK_SPEED_LOOP_NUM / WELS_MAX (iTime[0], 1), (double)DEBLOCK_SPEED_LOOP_NUM / WELS_MAX (iTime[1], 1),
+            (double)DEBLOCK_SPEED_LOOP_NUM / WELS_MAX (iTime[2], 1));
+  }
+}
+#endif
 #endif
 
 #if defined(HAVE_NEON)
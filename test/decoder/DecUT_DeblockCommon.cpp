@@ -519,6 +519,19 @@ TEST (DecoderDeblocking, DeblockingInit) {
   // SSE3
   DeblockingInit (&sDBFunc, 0x00000200);
   DB_FUNC_CPUFLAG (ssse3)
+
+#ifdef HAVE_AVX2
+  // AVX2 luma, SSSE3 chroma
+  DeblockingInit (&sDBFunc, 0x00040200);
+  EXPECT_TRUE (sDBFunc.pfLumaDeblockingLT4Ver == &DeblockLumaLt4V_avx2);
+  EXPECT_TRUE (sDBFunc.pfLumaDeblockingEQ4Ver == &DeblockLumaEq4V_avx2);
+  EXPECT_TRUE (sDBFunc.pfLumaDeblockingLT4Hor == &DeblockLumaLt4H_avx2);
+  EXPECT_TRUE (sDBFunc.pfLumaDeblockingEQ4Hor == &DeblockLumaEq4H_avx2);
+  EXPECT_TRUE (sDBFunc.pfChromaDeblockingLT4Ver == &DeblockChromaLt4V_ssse3);
+  EXPECT_TRUE (sDBFunc.pfChromaDeblockingEQ4Ver == &DeblockChromaEq4V_ssse3);
+  EXPECT_TRUE (sDBFunc.pfChromaDeblockingLT4Hor == &DeblockChromaLt4H_ssse3);
+  EXPECT_TRUE (sDBFunc.pfChromaDeblockingEQ4Hor == &DeblockChromaEq4H_ssse3);
+#endif
 #endif
 
 #ifdef HAVE_NEON
@@ -3,6 +3,7 @@
 #include "wels_common_basis.h"
 #include "memory_align.h"
 #include "error_concealment.h"
+#include "pic_queue.h"
 #include "ls_defines.h"
 #include "cpu.h"
 
@@ -296,3 +297,106 @@ TEST (ErrorConTest, DoErrorConSliceCopy) {
 
   FreeInputData (pECCtx);
 }
+
+namespace WelsDec {
+extern PPicture AllocPicture (PWelsDecoderContext pCtx, const int32_t kiPicWidth, const int32_t kiPicHeight);
+extern void FreePicture (PPicture pPic, CMemoryAlign* pMa);
+}
+
+static bool ComparePicturePlanes (PPicture pAncPic, PPicture pPic) {
+  for (int32_t i = 0; i < 3; ++ i) {
+    const int32_t kiWidth = i ? pPic->iWidthInPixel >> 1 : pPic->iWidthInPixel;
+    const int32_t kiHeight = i ? pPic->iHeightInPixel >> 1 : pPic->iHeightInPixel;
+    for (int32_t y = 0; y < kiHeight; ++ y) {
+      if (memcmp (pAncPic->pData[i] + y * pAncPic->iLinesize[i], pPic->pData[i] + y * pPic->iLinesize[i], kiWidth))
+        return false;
+    }
+  }
+  return true;
+}
+
+TEST (ErrorConTest, DoErrorConFrameCopyAlias) {
+  const int32_t kiMbWidth = rand() % 16 + 1;
+  const int32_t kiMbHeight = rand() % 16 + 1;
+  PWelsDecoderContext pCtx = (PWelsDecoderContext) WelsMallocz (sizeof (SWelsDecoderContext), "pCtx");
+  ASSERT_TRUE (pCtx != NULL);
+  SDecodingParam sParam;
+  SSps sSps;
+  SDqLayer sDqLayer;
+  SPicBuff sPicBuff;
+  PPicture pPic[3];
+  memset (&sParam, 0, sizeof (sParam));
+  memset (&sSps, 0, sizeof (sSps));
+  memset (&sDqLayer, 0, sizeof (sDqLayer));
+  sParam.eEcActiveIdc = ERROR_CON_FRAME_COPY_CROSS_IDR_ALIAS;
+  sSps.iMbWidth = kiMbWidth;
+  sSps.iMbHeight = kiMbHeight;
+  pCtx->pParam = &sParam;
+  pCtx->pSps = &sSps;
+  pCtx->pCurDqLayer = &sDqLayer;
+  pCtx->pMemAlign = new CMemoryAlign (16);
+  for (int32_t i = 0; i < 3; ++ i)
+    pPic[i] = AllocPicture (pCtx, kiMbWidth << 4, kiMbHeight << 4);
+  PPicture pAncPic = AllocPicture (pCtx, kiMbWidth << 4, kiMbHeight << 4);
+  sPicBuff.ppPic = pPic;
+  sPicBuff.iCapacity = 3;
+  sPicBuff.iCurrentIdx = 0;
+  pCtx->pPicBuff[LIST_0] = &sPicBuff;
+
+  for (int32_t i = 0; i < 3; ++ i) {
+    for (int32_t y = 0; y < (i ? kiMbHeight << 3 : kiMbHeight << 4); ++ y) {
+      for (int32_t x = 0; x < (i ? kiMbWidth << 3 : kiMbWidth << 4); ++ x)
+        pAncPic->pData[i][y * pAncPic->iLinesize[i] + x] = pPic[0]->pData[i][y * pPic[0]->iLinesize[i] + x] = rand() & 0xff;
+    }
+  }
+  const unsigned long long kuiPlaneBytes = pPic[0]->iLinesize[0] * (kiMbHeight << 4) * 3 / 2;
+  const unsigned long long kuiBufferBytes = (pPic[0]->pBuffer[1] - pPic[0]->pBuffer[0]) * 3 / 2;
+
+  //conceal pPic[1] from pPic[0], then pPic[2] from pPic[1]: both share the planes of pPic[0]
+  pCtx->pPreviousDecodedPictureInDpb = pPic[0];
+  pCtx->pDec = pPic[1];
+  DoErrorConFrameCopy (pCtx);
+  pCtx->pPreviousDecodedPictureInDpb = pPic[1];
+  pCtx->pDec = pPic[2];
+  DoErrorConFrameCopy (pCtx);
+  EXPECT_EQ (pPic[1]->pData[0], pPic[0]->pData[0]);
+  EXPECT_EQ (pPic[2]->pData[0], pPic[0]->pData[0]);
+  EXPECT_EQ (pPic[0]->iAliasNum, 2);
+  EXPECT_EQ (pCtx->sDecoderStatistics.uiEcAliasedBytes, 2 * kuiPlaneBytes);
+  EXPECT_EQ (pCtx->sDecoderStatistics.uiEcMaterializedBytes, 0u);
+
+  //renewing pPic[0] hands its planes over to pPic[1], which pPic[2] shares from now on
+  pCtx->pPreviousDecodedPictureInDpb = pPic[2];
+  EXPECT_EQ (RenewPicBuffer (pCtx, pPic[0]), ERR_NONE);
+  memset (pPic[0]->pBuffer[0], 0, kuiBufferBytes);
+  EXPECT_EQ (pPic[0]->iAliasNum, 0);
+  EXPECT_TRUE (pPic[1]->pAliasSrc == NULL);
+  EXPECT_TRUE (pPic[2]->pAliasSrc == pPic[1]);
+  EXPECT_EQ (pCtx->sDecoderStatistics.uiEcMaterializedBytes, 0u);
+  EXPECT_TRUE (ComparePicturePlanes (pAncPic, pPic[1]));
+  EXPECT_TRUE (ComparePicturePlanes (pAncPic, pPic[2]));
+
+  //renewing pPic[2], the previous picture, copies the planes it shares for the next concealment
+  EXPECT_EQ (RenewPicBuffer (pCtx, pPic[2]), ERR_NONE);
+  EXPECT_EQ (pPic[1]->iAliasNum, 0);
+  EXPECT_TRUE (pPic[2]->pAliasSrc == NULL);
+  EXPECT_NE (pPic[2]->pData[0], pPic[1]->pData[0]);
+  EXPECT_EQ (pCtx->sDecoderStatistics.uiEcMaterializedBytes, kuiBufferBytes);
+  EXPECT_TRUE (ComparePicturePlanes (pAncPic, pPic[2]));
+
+  //a renewed picture that is not the previous one drops the shared planes without copying
+  pCtx->pPreviousDecodedPictureInDpb = pPic[1];
+  pCtx->pDec = pPic[0];
+  DoErrorConFrameCopy (pCtx);
+  EXPECT_EQ (pPic[0]->pData[0], pPic[1]->pData[0]);
+  EXPECT_EQ (RenewPicBuffer (pCtx, pPic[0]), ERR_NONE);
+  EXPECT_NE (pPic[0]->pData[0], pPic[1]->pData[0]);
+  EXPECT_EQ (pCtx->sDecoderStatistics.uiEcMaterializedBytes, kuiBufferBytes);
+  EXPECT_EQ (pCtx->sDecoderStatistics.uiEcAliasedBytes, 3 * kuiPlaneBytes);
+
+  for (int32_t i = 0; i < 3; ++ i)
+    FreePicture (pPic[i], pCtx->pMemAlign);
+  FreePicture (pAncPic, pCtx->pMemAlign);
+  delete pCtx->pMemAlign;
+  WELS_SAFE_FREE (pCtx, "pCtx");
+}
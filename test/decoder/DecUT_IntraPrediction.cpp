@@ -2,6 +2,8 @@
 #include "cpu.h"
 #include "cpu_core.h"
 #include "get_intra_predictor.h"
+#include "decode_mb_aux.h"
+#include "wels_common_defs.h"
 #include "typedefs.h"
 #include "ls_defines.h"
 #include "macros.h"
@@ -580,6 +582,72 @@ GENERATE_16x16_UT (WelsI16x16LumaPredDcTop_c, LumaI16x16PredDCTop, 0, 0)
 GENERATE_16x16_UT (WelsI16x16LumaPredDc_c, LumaI16x16PredDC, 0, 0)
 GENERATE_16x16_UT (WelsI16x16LumaPredH_c, LumaI16x16PredH, 0, 0)
 GENERATE_16x16_UT (WelsI16x16LumaPredV_c, LumaI16x16PredV, 0, 0)
+
+void IdctFourRec_ref (uint8_t* pRec, int32_t iStride, uint8_t* pPred, int32_t iPredStride, int16_t* pRs) {
+  for (int i = 0; i < 8; i++)
+    memcpy (&pRec[i * iStride], &pPred[i * iPredStride], 8);
+  IdctResAddPred_c (pRec + 0 * iStride + 0, iStride, pRs + 0 * 16);
+  IdctResAddPred_c (pRec + 0 * iStride + 4, iStride, pRs + 1 * 16);
+  IdctResAddPred_c (pRec + 4 * iStride + 0, iStride, pRs + 2 * 16);
+  IdctResAddPred_c (pRec + 4 * iStride + 4, iStride, pRs + 3 * 16);
+}
+
+// I16x16 reconstruction from WelsI16x16LumaPredRow() against prediction followed by the idct
+#define GENERATE_I16x16_REC_UT(rec, ASM, CPUFLAGS) \
+TEST(DecoderIntraPredictionTest, rec) {\
+const int32_t kiStride = 32; \
+const int iBits = 12; \
+const int iMask = (1 << iBits) - 1; \
+const int iOffset = 1 << (iBits - 1); \
+void (*const kpPredFunc[7]) (uint8_t*, const int32_t) = { WelsI16x16LumaPredV_c, WelsI16x16LumaPredH_c, WelsI16x16LumaPredDc_c, \
+    WelsI16x16LumaPredPlane_c, WelsI16x16LumaPredDcLeft_c, WelsI16x16LumaPredDcTop_c, WelsI16x16LumaPredDcNA_c }; \
+int32_t iRunTimes = 1000; \
+ENFORCE_STACK_ALIGN_1D (uint8_t, pRefBuffer, 18 * kiStride, 16); \
+ENFORCE_STACK_ALIGN_1D (uint8_t, pRecBuffer, 18 * kiStride, 16); \
+ENFORCE_STACK_ALIGN_1D (uint8_t, uiPredRow, 16, 16); \
+ENFORCE_STACK_ALIGN_1D (int16_t, iRS, 256, 16); \
+if (ASM) { \
+  int32_t iTmp = 1; \
+  uint32_t uiCPUFlags = WelsCPUFeatureDetect( &iTmp); \
+  if ((uiCPUFlags & CPUFLAGS) == 0) {\
+    return ; \
+  } \
+}\
+while(iRunTimes--) {\
+const int8_t kiMode = iRunTimes % 7; \
+for (int i = 0; i < 17; i ++) {\
+  pRefBuffer[kiStride + i] = pRecBuffer[kiStride + i] = rand() & 255; \
+  pRefBuffer[(i+1) * kiStride - 1] = pRecBuffer[(i+1) * kiStride - 1] = rand() & 255; \
+}\
+for (int i = 0; i < 256; i ++) \
+  iRS[i] = (rand() & iMask) - iOffset; \
+uint8_t* pPredRow = WelsI16x16LumaPredRow (&pRecBuffer[2*kiStride], kiStride, kiMode, uiPredRow); \
+if (pPredRow == NULL) { \
+  EXPECT_TRUE (kiMode == I16_PRED_H || kiMode == I16_PRED_P); \
+  continue; \
+} \
+uint8_t* pRec = &pRecBuffer[2*kiStride]; \
+rec (pRec + 0 * kiStride + 0, kiStride, pPredRow + 0, 0, iRS + 0 * 64); \
+rec (pRec + 0 * kiStride + 8, kiStride, pPredRow + 8, 0, iRS + 1 * 64); \
+rec (pRec + 8 * kiStride + 0, kiStride, pPredRow + 0, 0, iRS + 2 * 64); \
+rec (pRec + 8 * kiStride + 8, kiStride, pPredRow + 8, 0, iRS + 3 * 64); \
+uint8_t* pRef = &pRefBuffer[2*kiStride]; \
+kpPredFunc[kiMode] (pRef, kiStride); \
+for (int i = 0; i < 16; i ++) \
+  IdctResAddPred_c (pRef + (i >> 3 << 3) * kiStride + (i >> 2 & 1) * 8 + (i >> 1 & 1) * 4 * kiStride + (i & 1) * 4, \
+                    kiStride, iRS + i * 16); \
+bool ok = true; \
+for (int i = 0; i < 16; i ++)\
+  for(int j = 0; j < 16; j ++)\
+    if (pRecBuffer[(i+2) * kiStride + j] != pRefBuffer[(i+2) * kiStride + j]) {\
+      ok = false; \
+      break; \
+    } \
+    EXPECT_EQ(ok, true); \
+} \
+}
+
+GENERATE_I16x16_REC_UT (IdctFourRec_ref, 0, 0)
 #if defined(X86_ASM)
 GENERATE_4x4_UT (WelsDecoderI4x4LumaPredH_sse2, LumaI4x4PredH, 1, WELS_CPU_SSE2)
 GENERATE_4x4_UT (WelsDecoderI4x4LumaPredDDR_mmx, WelsI4x4LumaPredDDR_ref, 1, WELS_CPU_MMX)
@@ -601,6 +669,17 @@ GENERATE_16x16_UT (WelsDecoderI16x16LumaPredV_sse2, LumaI16x16PredV, 1, WELS_CPU
 GENERATE_16x16_UT (WelsDecoderI16x16LumaPredDc_sse2, LumaI16x16PredDC, 1, WELS_CPU_SSE2)
 GENERATE_16x16_UT (WelsDecoderI16x16LumaPredDcTop_sse2, LumaI16x16PredDCTop, 1, WELS_CPU_SSE2)
 GENERATE_16x16_UT (WelsDecoderI16x16LumaPredDcNA_sse2, LumaI16x16PredDCNone, 1, WELS_CPU_SSE2)
+GENERATE_I16x16_REC_UT (WelsIDctFourT4Rec_sse2, 1, WELS_CPU_SSE2)
+#if defined(HAVE_AVX2)
+GENERATE_8x8_UT (WelsDecoderIChromaPredDc_avx2, WelsIChromaPredDc_ref, 1, WELS_CPU_AVX2)
+GENERATE_8x8_UT (WelsDecoderIChromaPredPlane_avx2, WelsIChromaPredPlane_ref, 1, WELS_CPU_AVX2)
+GENERATE_8x8_UT (WelsDecoderIChromaPredH_avx2, LumaI8x8PredH, 1, WELS_CPU_AVX2)
+GENERATE_16x16_UT (WelsDecoderI16x16LumaPredPlane_avx2, WelsI16x16LumaPredPlane_ref, 1, WELS_CPU_AVX2)
+GENERATE_16x16_UT (WelsDecoderI16x16LumaPredH_avx2, LumaI16x16PredH, 1, WELS_CPU_AVX2)
+GENERATE_16x16_UT (WelsDecoderI16x16LumaPredDc_avx2, LumaI16x16PredDC, 1, WELS_CPU_AVX2)
+GENERATE_16x16_UT (WelsDecoderI16x16LumaPredDcTop_avx2, LumaI16x16PredDCTop, 1, WELS_CPU_AVX2)
+GENERATE_I16x16_REC_UT (WelsIDctFourT4Rec_avx2, 1, WELS_CPU_AVX2)
+#endif
 #endif
 
 #if defined(HAVE_NEON)
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "codec_api.h"
+#include "typedefs.h"
+#include "macros.h"
+#include "au_parser.h"
+#include "measure_time.h"
+
+using namespace WelsDec;
+
+#define NAL_SCAN_BUF_SIZE  (256 * 1024)
+#define NAL_SCAN_LOOP_NUM  64
+
+static int32_t DetectStartCodeOrEscape_ref (const uint8_t* kpBuf, int32_t iBufSize) {
+  for (int32_t i = 0; i + 2 < iBufSize; ++ i) {
+    if (kpBuf[i] == 0 && kpBuf[i + 1] == 0 && kpBuf[i + 2] <= 0x03)
+      return i;
+  }
+  return iBufSize;
+}
+
+// random payload as entropy coded data looks like, with some zero bytes, escapes and start codes in it
+static void FillNalPayload (uint8_t* pBuf, int32_t iSize, int32_t iZeroRate) {
+  for (int32_t i = 0; i < iSize; ++ i) {
+    pBuf[i] = (rand() % 100 < iZeroRate) ? 0 : (uint8_t) (1 + rand() % 255);
+    if (i >= 2 && pBuf[i - 1] == 0 && pBuf[i - 2] == 0 && pBuf[i] > 0x03)
+      pBuf[i] = (uint8_t) (rand() % 4);
+  }
+}
+
+TEST (DecoderNalScanTest, DetectStartCodeOrEscape) {
+  uint8_t uiBuf[256 + 8];
+  srand ((unsigned int)time (NULL));
+  for (int32_t iTimes = 0; iTimes < 2000; ++ iTimes) {
+    const int32_t kiOffset = rand() % 8;
+    const int32_t kiSize   = rand() % 256;
+    FillNalPayload (uiBuf + kiOffset, kiSize, rand() % 20);
+    EXPECT_EQ (DetectStartCodeOrEscape_ref (uiBuf + kiOffset, kiSize), DetectStartCodeOrEscape (uiBuf + kiOffset, kiSize));
+  }
+  // sequences crossing the scanned words and the end of the buffer
+  for (int32_t iSize = 3; iSize <= 32; ++ iSize) {
+    for (int32_t iPos = 0; iPos < iSize; ++ iPos) {
+      memset (uiBuf, 0xff, sizeof (uiBuf));
+      uiBuf[iPos] = uiBuf[iPos + 1] = 0;
+      uiBuf[iPos + 2] = 0x03;
+      EXPECT_EQ (DetectStartCodeOrEscape_ref (uiBuf, iSize), DetectStartCodeOrEscape (uiBuf, iSize));
+    }
+  }
+}
+
+// scans the whole buffer as WelsDecodeBs() does, restarting behind each found sequence
+static int32_t ScanNalPayload (int32_t (*pfDetect) (const uint8_t*, int32_t), const uint8_t* kpBuf, int32_t iBufSize) {
+  int32_t iFound = 0;
+  for (int32_t iPos = 0; iPos < iBufSize; ++ iFound)
+    iPos += 1 + pfDetect (kpBuf + iPos, iBufSize - iPos);
+  return iFound;
+}
+
+// start code and escape search throughput in bytes per tick (cpu cycle on x86),
+// disabled by default, run it with --gtest_also_run_disabled_tests
+TEST (DecoderNalScanTest, DISABLED_DetectStartCodeOrEscapeSpeed) {
+  static const int32_t kiZeroRates[] = {0, 1, 5, 20};
+  uint8_t* pBuf = new uint8_t[NAL_SCAN_BUF_SIZE];
+  srand ((unsigned int)time (NULL));
+  for (uint32_t iRate = 0; iRate < sizeof (kiZeroRates) / sizeof (kiZeroRates[0]); ++ iRate) {
+    FillNalPayload (pBuf, NAL_SCAN_BUF_SIZE, kiZeroRates[iRate]);
+    int32_t iFoundRef = 0, iFound = 0;
+    int64_t iTicksRef = WelsTicks();
+    for (int32_t i = 0; i < NAL_SCAN_LOOP_NUM; ++ i)
+      iFoundRef = ScanNalPayload (DetectStartCodeOrEscape_ref, pBuf, NAL_SCAN_BUF_SIZE);
+    iTicksRef = WelsTicks() - iTicksRef;
+    int64_t iTicks = WelsTicks();
+    for (int32_t i = 0; i < NAL_SCAN_LOOP_NUM; ++ i)
+      iFound = ScanNalPayload (DetectStartCodeOrEscape, pBuf, NAL_SCAN_BUF_SIZE);
+    iTicks = WelsTicks() - iTicks;
+
+    EXPECT_EQ (iFoundRef, iFound);
+    const double kdBytes = (double)NAL_SCAN_BUF_SIZE * NAL_SCAN_LOOP_NUM;
+    printf ("zero bytes %2d%%, %6d sequences: byte loop %.3f, DetectStartCodeOrEscape %.3f bytes/tick\n",
+            kiZeroRates[iRate], iFound - 1, kdBytes / WELS_MAX (iTicksRef, 1), kdBytes / WELS_MAX (iTicks, 1));
+  }
+  delete[] pBuf;
+}
+
+// the escape removal stage of WelsDecodeBs() on conformance streams, from the decoder stage statistics
+TEST (DecoderNalScanTest, DISABLED_UnescapeStageSpeed) {
+  static const char* kpStreams[] = {
+    "res/BA_MW_D.264",
+    "res/test_cif_P_CABAC_slice.264",
+    "res/Zhling_1280x720.264",
+    "res/jm_1080p_allslice.264",
+  };
+  for (uint32_t iStream = 0; iStream < sizeof (kpStreams) / sizeof (kpStreams[0]); ++ iStream) {
+    FILE* pFile = fopen (kpStreams[iStream], "rb");
+    if (pFile == NULL)
+      continue;
+    fseek (pFile, 0, SEEK_END);
+    const int32_t kiSize = (int32_t)ftell (pFile);
+    fseek (pFile, 0, SEEK_SET);
+    uint8_t* pBuf = new uint8_t[kiSize];
+    EXPECT_EQ ((size_t)kiSize, fread (pBuf, 1, kiSize, pFile));
+    fclose (pFile);
+
+    ISVCDecoder* pDecoder = NULL;
+    EXPECT_EQ (0, WelsCreateDecoder (&pDecoder));
+    if (pDecoder == NULL) {
+      delete[] pBuf;
+      return;
+    }
+    SDecodingParam sDecParam;
+    memset (&sDecParam, 0, sizeof (sDecParam));
+    sDecParam.uiTargetDqLayer = UCHAR_MAX;
+    sDecParam.eEcActiveIdc = ERROR_CON_DISABLE;
+    sDecParam.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
+    EXPECT_EQ (0, pDecoder->Initialize (&sDecParam));
+    int32_t iStageTiming = 1;
+    EXPECT_EQ (0, pDecoder->SetOption (DECODER_OPTION_STAGE_TIMING, &iStageTiming));
+
+    uint8_t* pData[3];
+    SBufferInfo sDstBufInfo;
+    memset (&sDstBufInfo, 0, sizeof (sDstBufInfo));
+    pDecoder->DecodeFrameNoDelay (pBuf, kiSize, pData, &sDstBufInfo);
+
+    SDecoderStageStatistics sStages;
+    EXPECT_EQ (0, pDecoder->GetOption (DECODER_OPTION_GET_STAGE_STATISTICS, &sStages));
+    uint64_t uiTotalCycles = 0;
+    for (int32_t i = 0; i < DECODER_STAGE_NUM; ++ i)
+      uiTotalCycles += sStages.sStage[i].uiCycles;
+    const uint64_t kuiUnescapeCycles = sStages.sStage[DECODER_STAGE_NAL_UNESCAPE].uiCycles;
+    printf ("%s: %d bytes, unescape %.3f bytes/cycle, %.2f%% of the decoding cycles\n", kpStreams[iStream], kiSize,
+            (double)kiSize / WELS_MAX (kuiUnescapeCycles, 1), 100.0 * kuiUnescapeCycles / WELS_MAX (uiTotalCycles, 1));
+
+    pDecoder->Uninitialize();
+    WelsDestroyDecoder (pDecoder);
+    delete[] pBuf;
+  }
+}
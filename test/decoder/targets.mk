@@ -1,11 +1,14 @@
 DECODER_UNITTEST_SRCDIR=test/decoder
 DECODER_UNITTEST_CPP_SRCS=\
+	$(DECODER_UNITTEST_SRCDIR)/DecUT_Cabac.cpp\
+	$(DECODER_UNITTEST_SRCDIR)/DecUT_Cavlc.cpp\
 	$(DECODER_UNITTEST_SRCDIR)/DecUT_Deblock.cpp\
 	$(DECODER_UNITTEST_SRCDIR)/DecUT_DeblockCommon.cpp\
 	$(DECODER_UNITTEST_SRCDIR)/DecUT_DecExt.cpp\
 	$(DECODER_UNITTEST_SRCDIR)/DecUT_ErrorConcealment.cpp\
 	$(DECODER_UNITTEST_SRCDIR)/DecUT_IdctResAddPred.cpp\
 	$(DECODER_UNITTEST_SRCDIR)/DecUT_IntraPrediction.cpp\
+	$(DECODER_UNITTEST_SRCDIR)/DecUT_NalScan.cpp\
 	$(DECODER_UNITTEST_SRCDIR)/DecUT_ParseSyntax.cpp\
 	$(DECODER_UNITTEST_SRCDIR)/DecUT_PredMv.cpp\
 
@@ -126,6 +126,123 @@ TEST_F (MotionEstimateTest, TestDiamondSearch) {
   }
 }
 
+TEST_F (MotionEstimateTest, TestCandidatesSearch) {
+  SWelsFuncPtrList sFuncListC, sFuncList;
+  SMeCandidates sCands;
+  WelsInitSampleSadFunc (&sFuncListC, 0);
+  WelsInitSampleSadFunc (&sFuncList, WelsCPUFeatureDetect (NULL));
+
+  RandomPixelDataGenerator (m_pRefData, m_iWidth, m_iHeight, m_iWidth);
+  RandomPixelDataGenerator (m_pSrcBlock, m_iMaxSearchBlock, m_iMaxSearchBlock, m_iMaxSearchBlock);
+
+  for (int32_t iTest = 0; iTest < 200; iTest++) {
+    const uint8_t kuiBlockSize = rand() % BLOCK_SIZE_ALL;
+    const int32_t kiStopCost = (iTest & 1) ? (rand() % 4096) : 0;
+    PSampleSadSatdCostFunc pSad = sFuncListC.sSampleDealingFuncs.pfSampleSad[kuiBlockSize];
+    int32_t iCost[ME_MAX_CANDIDATES];
+
+    sCands.iNum = 0;
+    const int32_t kiNum = 1 + rand() % ME_MAX_CANDIDATES;
+    for (int32_t i = 0; i < kiNum; i++) {
+      const int32_t kiX = rand() % (m_iWidth - 16);
+      const int32_t kiY = rand() % (m_iHeight - 16);
+      uint8_t* pRef = m_pRefData + kiY * m_iWidth + kiX;
+      const int32_t kiMvdCost = rand() % 256;
+      WelsMeCandidatesAdd (&sCands, kiX, kiY, pRef, kiMvdCost);
+      iCost[i] = kiMvdCost + pSad (m_pSrcBlock, m_iMaxSearchBlock, pRef, m_iWidth);
+    }
+    const int32_t kiInitialCost = (iTest & 2) ? INT_MAX : (1024 + rand() % 8192);
+    int32_t iRefBestCost = kiInitialCost;
+    int32_t iRefBestIdx = -1;
+    for (int32_t i = 0; i < kiNum; i++) {
+      if (iCost[i] < iRefBestCost) {
+        iRefBestCost = iCost[i];
+        iRefBestIdx = i;
+        if (iRefBestCost < kiStopCost)
+          break;
+      }
+    }
+
+    SMeCandidates sCandsC = sCands;
+    int32_t iBestCostC = kiInitialCost;
+    int32_t iBestIdxC = WelsMeCandidatesSearch (sFuncListC.sSampleDealingFuncs.pfSample4SadRef[kuiBlockSize],
+                        m_pSrcBlock, m_iMaxSearchBlock, m_iWidth, &sCandsC, &iBestCostC, kiStopCost);
+    EXPECT_EQ (iRefBestIdx, iBestIdxC);
+    EXPECT_EQ (iRefBestCost, iBestCostC);
+
+    int32_t iBestCost = kiInitialCost;
+    int32_t iBestIdx = WelsMeCandidatesSearch (sFuncList.sSampleDealingFuncs.pfSample4SadRef[kuiBlockSize],
+                       m_pSrcBlock, m_iMaxSearchBlock, m_iWidth, &sCands, &iBestCost, kiStopCost);
+    EXPECT_EQ (iRefBestIdx, iBestIdx);
+    EXPECT_EQ (iRefBestCost, iBestCost);
+  }
+}
+
+// a random texture and its copy moved by (iDx, iDy), both at 1/2 and at 1/4 of the layer size
+static void SetHierarchicalPictures (SHierarchicalMe* pHme, const int32_t kiDx, const int32_t kiDy) {
+  SPicture* pEnc = pHme->pEncLevel[0];
+  SPicture* pRef = pHme->pRefLevel[0];
+  const int32_t kiWidth = pEnc->iWidthInPixel;
+  const int32_t kiHeight = pEnc->iHeightInPixel;
+  const int32_t kiTexStride = kiWidth + 2 * 16;
+  uint8_t* pTexture = new uint8_t[kiTexStride * (kiHeight + 2 * 16)];
+  uint8_t* pTexOrigin = pTexture + 16 * kiTexStride + 16;
+  RandomPixelDataGenerator (pTexture, kiTexStride, kiHeight + 2 * 16, kiTexStride);
+  for (int32_t y = 0; y < kiHeight; y++) {
+    for (int32_t x = 0; x < kiWidth; x++) {
+      pRef->pData[0][y * pRef->iLineSize[0] + x] = pTexOrigin[y * kiTexStride + x];
+      pEnc->pData[0][y * pEnc->iLineSize[0] + x] = pTexOrigin[(y + kiDy) * kiTexStride + x + kiDx];
+    }
+  }
+  delete [] pTexture;
+  for (int32_t i = 0; i < 2; i++) {
+    SPicture* pUpper = (0 == i) ? pEnc : pRef;
+    SPicture* pLower = (0 == i) ? pHme->pEncLevel[1] : pHme->pRefLevel[1];
+    for (int32_t y = 0; y < pLower->iHeightInPixel; y++) {
+      for (int32_t x = 0; x < pLower->iWidthInPixel; x++) {
+        const uint8_t* kpSrc = &pUpper->pData[0][2 * y * pUpper->iLineSize[0] + 2 * x];
+        pLower->pData[0][y * pLower->iLineSize[0] + x] = (kpSrc[0] + kpSrc[1] + kpSrc[pUpper->iLineSize[0]] +
+            kpSrc[pUpper->iLineSize[0] + 1] + 2) >> 2;
+      }
+    }
+  }
+}
+
+TEST_F (MotionEstimateTest, TestHierarchicalSearch) {
+  const int32_t kiMbWidth = 8;
+  const int32_t kiMbHeight = 6;
+  const int32_t kiMvRange = 64;
+  SWelsFuncPtrList sFuncList;
+  SHierarchicalMe sHme;
+  memset (&sHme, 0, sizeof (sHme));
+  WelsInitSampleSadFunc (&sFuncList, WelsCPUFeatureDetect (NULL));
+  MvdCostInit (m_pMvdCostTable, m_uiMvdTableSize);
+  const uint16_t* kpMvdCost = &m_pMvdCostTable[26 * m_uiMvdTableSize + 648];
+
+  ASSERT_EQ (ENC_RETURN_SUCCESS, RequestHierarchicalMe (pMa, kiMbWidth, kiMbHeight, MAX_HME_LEVELS, &sHme));
+  for (int32_t iTest = 0; iTest < 8; iTest++) {
+    // in pixels of the 1/2 level, even so that the 1/4 level moves by whole pixels within HME_SEARCH_RANGE
+    const int32_t kiDx = 2 * ((rand() % (2 * HME_SEARCH_RANGE + 1)) - HME_SEARCH_RANGE);
+    const int32_t kiDy = 2 * ((rand() % (2 * HME_SEARCH_RANGE + 1)) - HME_SEARCH_RANGE);
+    SetHierarchicalPictures (&sHme, kiDx, kiDy);
+    WelsHierarchicalMeSearch (&sFuncList, &sHme, kpMvdCost, kiMbWidth, kiMbHeight, kiMvRange);
+
+    // MBs whose moved block lies in the pictures of both levels
+    for (int32_t iMbY = 0; iMbY < kiMbHeight; iMbY++) {
+      for (int32_t iMbX = 0; iMbX < kiMbWidth; iMbX++) {
+        const int32_t kiX = iMbX * 8 + kiDx;
+        const int32_t kiY = iMbY * 8 + kiDy;
+        if (kiX < 0 || kiY < 0 || kiX > (kiMbWidth - 1) * 8 || kiY > (kiMbHeight - 1) * 8)
+          continue;
+        const SMVUnitXY sMv = sHme.pMbMv[iMbY * kiMbWidth + iMbX];
+        EXPECT_EQ (kiDx * 8, sMv.iMvX) << "MB " << iMbX << "," << iMbY;
+        EXPECT_EQ (kiDy * 8, sMv.iMvY) << "MB " << iMbX << "," << iMbY;
+      }
+    }
+  }
+  ReleaseHierarchicalMe (pMa, &sHme);
+}
+
 class MotionEstimateRangeTest : public ::testing::Test {
  public:
   virtual void SetUp() {
@@ -682,19 +682,20 @@ TEST_F (SadSatdAssemblyFuncTest, func) { \
     m_pPixSrcB[i] = rand() % 256; \
   uint8_t* pPixA = m_pPixSrcA; \
   uint8_t* pPixB = m_pPixSrcB + m_iStrideB; \
-  int32_t iSumSad = 0; \
+  int32_t iSad[4] = {0, 0, 0, 0}; \
   for (int i = 0; i < height; i++) { \
     for (int j = 0; j < width; j++) { \
-      iSumSad += abs (pPixA[j] - pPixB[j - 1]); \
-      iSumSad += abs (pPixA[j] - pPixB[j + 1]); \
-      iSumSad += abs (pPixA[j] - pPixB[j - m_iStrideB]); \
-      iSumSad += abs (pPixA[j] - pPixB[j + m_iStrideB]); \
+      iSad[0] += abs (pPixA[j] - pPixB[j - m_iStrideB]); \
+      iSad[1] += abs (pPixA[j] - pPixB[j + m_iStrideB]); \
+      iSad[2] += abs (pPixA[j] - pPixB[j - 1]); \
+      iSad[3] += abs (pPixA[j] - pPixB[j + 1]); \
     } \
     pPixA += m_iStrideA; \
     pPixB += m_iStrideB; \
   } \
   func (m_pPixSrcA, m_iStrideA, m_pPixSrcB + m_iStrideB, m_iStrideB, m_pSad); \
-  EXPECT_EQ (m_pSad[0] + m_pSad[1] + m_pSad[2] + m_pSad[3], iSumSad); \
+  for (int i = 0; i < 4; i++) \
+    EXPECT_EQ (m_pSad[i], iSad[i]); \
 }
 
 #ifdef X86_ASM
@@ -703,6 +704,10 @@ GENERATE_SadFour_UT (WelsSampleSadFour8x8_sse2, WELS_CPU_SSE2, 8, 8)
 GENERATE_SadFour_UT (WelsSampleSadFour8x16_sse2, WELS_CPU_SSE2, 8, 16)
 GENERATE_SadFour_UT (WelsSampleSadFour16x8_sse2, WELS_CPU_SSE2, 16, 8)
 GENERATE_SadFour_UT (WelsSampleSadFour16x16_sse2, WELS_CPU_SSE2, 16, 16)
+#ifdef HAVE_AVX2
+GENERATE_SadFour_UT (WelsSampleSadFour16x8_avx2, WELS_CPU_AVX2, 16, 8)
+GENERATE_SadFour_UT (WelsSampleSadFour16x16_avx2, WELS_CPU_AVX2, 16, 16)
+#endif //HAVE_AVX2
 #endif
 
 #ifdef HAVE_NEON
@@ -720,3 +725,38 @@ GENERATE_SadFour_UT (WelsSampleSadFour8x16_AArch64_neon, WELS_CPU_NEON, 8, 16)
 GENERATE_SadFour_UT (WelsSampleSadFour16x8_AArch64_neon, WELS_CPU_NEON, 16, 8)
 GENERATE_SadFour_UT (WelsSampleSadFour16x16_AArch64_neon, WELS_CPU_NEON, 16, 16)
 #endif
+
+#define GENERATE_SadFourRef_UT(func, ref, CPUFLAGS, width, height) \
+TEST_F (SadSatdAssemblyFuncTest, func) { \
+  if (0 != CPUFLAGS && 0 == (m_uiCpuFeatureFlag & CPUFLAGS)) \
+    return; \
+  for (int i = 0; i < (m_iStrideA << 5); i++) \
+    m_pPixSrcA[i] = rand() % 256; \
+  for (int i = 0; i < (m_iStrideB << 5); i++) \
+    m_pPixSrcB[i] = rand() % 256; \
+  uint8_t* pRef[4]; \
+  for (int i = 0; i < 4; i++) \
+    pRef[i] = m_pPixSrcB + (rand() % (33 - height)) * m_iStrideB + rand() % (m_iStrideB - width + 1); \
+  func (m_pPixSrcA, m_iStrideA, pRef, m_iStrideB, m_pSad); \
+  for (int i = 0; i < 4; i++) \
+    EXPECT_EQ (m_pSad[i], ref (m_pPixSrcA, m_iStrideA, pRef[i], m_iStrideB)); \
+}
+
+GENERATE_SadFourRef_UT (WelsSampleSadFourRef4x4_c, WelsSampleSad4x4_c, 0, 4, 4)
+GENERATE_SadFourRef_UT (WelsSampleSadFourRef8x4_c, WelsSampleSad8x4_c, 0, 8, 4)
+GENERATE_SadFourRef_UT (WelsSampleSadFourRef4x8_c, WelsSampleSad4x8_c, 0, 4, 8)
+GENERATE_SadFourRef_UT (WelsSampleSadFourRef8x8_c, WelsSampleSad8x8_c, 0, 8, 8)
+GENERATE_SadFourRef_UT (WelsSampleSadFourRef8x16_c, WelsSampleSad8x16_c, 0, 8, 16)
+GENERATE_SadFourRef_UT (WelsSampleSadFourRef16x8_c, WelsSampleSad16x8_c, 0, 16, 8)
+GENERATE_SadFourRef_UT (WelsSampleSadFourRef16x16_c, WelsSampleSad16x16_c, 0, 16, 16)
+
+#ifdef X86_ASM
+GENERATE_SadFourRef_UT (WelsSampleSadFourRef8x8_sse2, WelsSampleSad8x8_c, WELS_CPU_SSE2, 8, 8)
+GENERATE_SadFourRef_UT (WelsSampleSadFourRef8x16_sse2, WelsSampleSad8x16_c, WELS_CPU_SSE2, 8, 16)
+GENERATE_SadFourRef_UT (WelsSampleSadFourRef16x8_sse2, WelsSampleSad16x8_c, WELS_CPU_SSE2, 16, 8)
+GENERATE_SadFourRef_UT (WelsSampleSadFourRef16x16_sse2, WelsSampleSad16x16_c, WELS_CPU_SSE2, 16, 16)
+#ifdef HAVE_AVX2
+GENERATE_SadFourRef_UT (WelsSampleSadFourRef16x8_avx2, WelsSampleSad16x8_c, WELS_CPU_AVX2, 16, 8)
+GENERATE_SadFourRef_UT (WelsSampleSadFourRef16x16_avx2, WelsSampleSad16x16_c, WELS_CPU_AVX2, 16, 16)
+#endif //HAVE_AVX2
+#endif
@@ -0,0 +1,68 @@
+#ifndef __PARSEONLYSTREAM_H__
+#define __PARSEONLYSTREAM_H__
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include "codec_api.h"
+#include "measure_time.h"
+
+/*
+ *  parse only decoding of a stream, one NAL per call as h264dec feeds the decoder,
+ *  returns the number of frames and the decoding time in us, -1 if the stream cannot be opened
+ */
+static int32_t ParseOnlyStream (const char* kpFileName, int64_t* pTime) {
+  int32_t iFrameNum = 0;
+  *pTime = 0;
+  FILE* pFile = fopen (kpFileName, "rb");
+  if (pFile == NULL)
+    return -1;
+  fseek (pFile, 0, SEEK_END);
+  const int32_t kiSize = (int32_t)ftell (pFile);
+  fseek (pFile, 0, SEEK_SET);
+  uint8_t* pBuf = new uint8_t[kiSize];
+  EXPECT_EQ ((size_t)kiSize, fread (pBuf, 1, kiSize, pFile));
+  fclose (pFile);
+
+  ISVCDecoder* pDecoder = NULL;
+  EXPECT_EQ (0, WelsCreateDecoder (&pDecoder));
+  if (pDecoder == NULL) {
+    delete[] pBuf;
+    return 0;
+  }
+  SDecodingParam sDecParam;
+  memset (&sDecParam, 0, sizeof (sDecParam));
+  sDecParam.uiTargetDqLayer = UCHAR_MAX;
+  sDecParam.eEcActiveIdc = ERROR_CON_DISABLE;
+  sDecParam.bParseOnly = true;
+  sDecParam.sVideoProperty.eVideoBsType = VIDEO_BITSTREAM_DEFAULT;
+  EXPECT_EQ (0, pDecoder->Initialize (&sDecParam));
+
+  SParserBsInfo sParserInfo;
+  int64_t iTime = WelsTime();
+  for (int32_t iPos = 0; iPos < kiSize;) {
+    int32_t iEnd = iPos + 4;
+    while (iEnd + 3 < kiSize && ! (pBuf[iEnd] == 0 && pBuf[iEnd + 1] == 0 && pBuf[iEnd + 2] == 1))
+      ++ iEnd;
+    if (iEnd + 3 >= kiSize)
+      iEnd = kiSize;
+    else if (pBuf[iEnd - 1] == 0)
+      -- iEnd;
+    memset (&sParserInfo, 0, sizeof (sParserInfo));
+    EXPECT_EQ (dsErrorFree, pDecoder->DecodeParser (pBuf + iPos, iEnd - iPos, &sParserInfo));
+    iFrameNum += (sParserInfo.iNalNum > 0);
+    iPos = iEnd;
+  }
+  memset (&sParserInfo, 0, sizeof (sParserInfo));
+  pDecoder->DecodeParser (NULL, 0, &sParserInfo);
+  iFrameNum += (sParserInfo.iNalNum > 0);
+  *pTime = WelsTime() - iTime;
+
+  pDecoder->Uninitialize();
+  WelsDestroyDecoder (pDecoder);
+  delete[] pBuf;
+  return iFrameNum;
+}
+
+#endif //__PARSEONLYSTREAM_H__